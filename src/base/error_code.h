@@ -1571,7 +1571,7 @@
 #define ER_STREAM_FILE_CANNOT_READ                  -1219
 #define ER_STREAM_FILE_CANNOT_WRITE                 -1220
 #define ER_STREAM_CONNECTION_SETUP                  -1221
-#define ER_STREAM_RESERVED_6                        -1222
+#define ER_STREAM_INVALID_COMPRESSED_BLOCK          -1222
 #define ER_STREAM_RESERVED_7                        -1223
 #define ER_STREAM_RESERVED_8                        -1224
 #define ER_STREAM_RESERVED_9                        -1225
@@ -1599,8 +1599,11 @@
 
 #define ER_IB_ERROR_ABORT                           -1243
 
+#define ER_LOG_RECOVERY_REDO_STATS                  -1244
 
-#define ER_LAST_ERROR                               -1244
+#define ER_PARALLEL_WORKER_CHANGES_TRAN             -1245
+
+#define ER_LAST_ERROR                               -1246
 
 /*
  * CAUTION!
@@ -203,9 +203,7 @@ orc_diskrep_from_record (THREAD_ENTRY * thread_p, RECDES * record)
   rep->n_fixed = 0;
   rep->n_variable = 0;
   rep->fixed_length = or_rep->fixed_length;
-#if 0				/* reserved for future use */
-  rep->repr_reserved_1 = 0;
-#endif
+  rep->flags = 0;
   rep->fixed = NULL;
   rep->variable = NULL;
 
@@ -435,6 +433,11 @@ orc_free_diskrep (DISK_REPR * rep)
 		  free_and_init (rep->fixed[i].value);
 		}
 
+	      if (rep->fixed[i].bounds != NULL)
+		{
+		  free_and_init (rep->fixed[i].bounds);
+		}
+
 	      if (rep->fixed[i].bt_stats != NULL)
 		{
 		  for (j = 0; j < rep->fixed[i].n_btstats; j++)
@@ -462,6 +465,11 @@ orc_free_diskrep (DISK_REPR * rep)
 		  free_and_init (rep->variable[i].value);
 		}
 
+	      if (rep->variable[i].bounds != NULL)
+		{
+		  free_and_init (rep->variable[i].bounds);
+		}
+
 	      if (rep->variable[i].bt_stats != NULL)
 		{
 		  for (j = 0; j < rep->variable[i].n_btstats; j++)
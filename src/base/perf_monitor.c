@@ -40,6 +40,7 @@
 #endif /* !SERVER_MODE */
 #include "thread_worker_pool.hpp"
 #if defined (SERVER_MODE)
+#include "monitor_sharded.hpp"
 #include "thread_daemon.hpp"
 #endif // SERVER_MODE
 #if defined (SERVER_MODE) || defined (SA_MODE)
@@ -185,10 +186,20 @@ STATIC_INLINE size_t thread_stats_count (void) __attribute__ ((ALWAYS_INLINE));
 STATIC_INLINE size_t perfmon_thread_daemon_stats_count (void) __attribute__ ((ALWAYS_INLINE));
 #if defined (SERVER_MODE)
 static void perfmon_peek_thread_daemon_stats (UINT64 * stats);
+static void perfmon_peek_latency_stats (UINT64 * stats);
+static void perfmon_register_latency_histograms (void);
 #endif // SERVER_MODE
 
 PSTAT_GLOBAL pstat_Global;
 
+#if defined (SERVER_MODE)
+// *INDENT-OFF*
+/* collected only while statistics are tracked, like the other statistics. sharded, so that collecting them does not
+ * make all workers write the same cache lines. */
+static cubmonitor::latency_histogram_statistic perfmon_Latency_histograms[PERFMON_LATENCY_COUNT];
+// *INDENT-ON*
+#endif // SERVER_MODE
+
 PSTAT_METADATA pstat_Metadata[] = {
   /* Execution statistics for the file io */
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_FILE_NUM_CREATES, "Num_file_creates"),
@@ -207,6 +218,13 @@ PSTAT_METADATA pstat_Metadata[] = {
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PB_NUM_IOREADS, "Num_data_page_ioreads"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PB_NUM_IOWRITES, "Num_data_page_iowrites"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PB_NUM_FLUSHED, "Num_data_page_flushed"),
+  PSTAT_METADATA_INIT_COUNTER_TIMER (PSTAT_PB_READ_AHEAD_IO, "data_page_read_ahead_io"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PB_READ_AHEAD_NUM_PAGES, "Num_data_page_read_ahead_pages"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PB_READ_AHEAD_NUM_HITS, "Num_data_page_read_ahead_hits"),
+  PSTAT_METADATA_INIT_COUNTER_TIMER (PSTAT_PB_WARMUP_IO, "data_page_warmup_io"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PB_WARMUP_NUM_PAGES, "Num_data_page_warmup_pages"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PB_NUM_OPTIMISTIC_FIXES, "Num_data_page_optimistic_fixes"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PB_NUM_OPTIMISTIC_UNFIXES, "Num_data_page_optimistic_unfixes"),
   /* peeked stats */
   PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_PB_PRIVATE_QUOTA, "Num_data_page_private_quota"),
   PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_PB_PRIVATE_COUNT, "Num_data_page_private_count"),
@@ -216,6 +234,7 @@ PSTAT_METADATA pstat_Metadata[] = {
   PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_PB_LRU2_CNT, "Num_data_page_lru2"),
   PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_PB_LRU3_CNT, "Num_data_page_lru3"),
   PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_PB_VICT_CAND, "Num_data_page_victim_candidate"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_PB_WARMUP_REMAINING, "Num_data_page_warmup_remaining"),
 
   /* Execution statistics for the log manager */
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_LOG_NUM_FETCHES, "Num_log_page_fetches"),
@@ -241,6 +260,8 @@ PSTAT_METADATA pstat_Metadata[] = {
   /* TODO: Count and timer */
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_LK_NUM_WAITED_ON_OBJECTS, "Num_object_locks_waits"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_LK_NUM_WAITED_TIME_ON_OBJECTS, "Num_object_locks_time_waited_usec"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_LK_NUM_FASTPATH_ON_CLASSES, "Num_class_locks_fastpath"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_LK_NUM_FASTPATH_TRANSFERRED, "Num_class_locks_fastpath_transferred"),
 
   /* Execution statistics for transactions */
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_TRAN_NUM_COMMITS, "Num_tran_commits"),
@@ -297,6 +318,20 @@ PSTAT_METADATA pstat_Metadata[] = {
   /* HA replication delay */
   PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_HA_REPL_DELAY, "Time_ha_replication_delay"),
 
+  /* replication apply on slave */
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_REPL_APPLY_NUM_TRANS, "Num_repl_apply_transactions"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_REPL_APPLY_NUM_DEPENDENT_TRANS, "Num_repl_apply_dependent_transactions"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_REPL_APPLY_NUM_BARRIER_TRANS, "Num_repl_apply_barrier_transactions"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_REPL_APPLY_PENDING_TRANS, "Num_repl_apply_pending_transactions"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_REPL_APPLY_RUNNING_TRANS, "Num_repl_apply_running_transactions"),
+
+  /* replication stream compression */
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_STREAM_COMPRESS_RAW_BYTES, "Num_stream_compress_raw_bytes"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_STREAM_COMPRESS_STORED_BYTES, "Num_stream_compress_stored_bytes"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_STREAM_COMPRESS_TIME, "Time_stream_compress"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_STREAM_DECOMPRESS_BYTES, "Num_stream_decompress_bytes"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_STREAM_DECOMPRESS_TIME, "Time_stream_decompress"),
+
   /* Execution statistics for Plan cache */
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PC_NUM_ADD, "Num_plan_cache_add"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PC_NUM_LOOKUP, "Num_plan_cache_lookup"),
@@ -305,8 +340,17 @@ PSTAT_METADATA pstat_Metadata[] = {
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PC_NUM_FULL, "Num_plan_cache_full"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PC_NUM_DELETE, "Num_plan_cache_delete"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PC_NUM_INVALID_XASL_ID, "Num_plan_cache_invalid_xasl_id"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PC_NUM_LOADED, "Num_plan_cache_loaded"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PC_NUM_LOAD_DISCARDED, "Num_plan_cache_load_discarded"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_PC_NUM_LOADED_HIT, "Num_plan_cache_loaded_hit"),
   PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_PC_NUM_CACHE_ENTRIES, "Num_plan_cache_entries"),
 
+  /* Execution statistics for query result cache */
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_QRC_NUM_HIT, "Num_query_result_cache_hit"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_QRC_NUM_MISS, "Num_query_result_cache_miss"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_QRC_NUM_EVICT, "Num_query_result_cache_evict"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_QRC_NUM_INVALIDATE, "Num_query_result_cache_invalidate"),
+
   /* Vacuum process log section. */
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_VAC_NUM_VACUUMED_LOG_PAGES, "Num_vacuum_log_pages_vacuumed"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_VAC_NUM_TO_VACUUM_LOG_PAGES, "Num_vacuum_log_pages_to_vacuum"),
@@ -437,6 +481,7 @@ PSTAT_METADATA pstat_Metadata[] = {
   PSTAT_METADATA_INIT_COMPUTED_RATIO (PSTAT_PB_PAGE_PROMOTE_SUCCESS, "Data_page_total_promote_success"),
   PSTAT_METADATA_INIT_COMPUTED_RATIO (PSTAT_PB_PAGE_PROMOTE_FAILED, "Data_page_total_promote_fail"),
   PSTAT_METADATA_INIT_COMPUTED_RATIO (PSTAT_PB_PAGE_PROMOTE_TOTAL_TIME_10USEC, "Data_page_total_promote_time_msec"),
+  PSTAT_METADATA_INIT_COMPUTED_RATIO (PSTAT_STREAM_COMPRESS_RATIO, "Stream_compression_ratio"),
 
   /* Page buffer extended */
   /* detailed unfix module */
@@ -545,6 +590,21 @@ PSTAT_METADATA pstat_Metadata[] = {
   PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_PB_LFCQ_SHR_NUM, "Num_lfcq_shared_lists"),
   PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_PB_AVOID_DEALLOC_CNT, "Num_data_page_avoid_dealloc"),
   PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_PB_AVOID_VICTIM_CNT, "Num_data_page_avoid_victim"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_NET_REQUEST_TIME_P50, "Time_network_request_p50"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_NET_REQUEST_TIME_P99, "Time_network_request_p99"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_NET_REQUEST_TIME_P999, "Time_network_request_p999"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_PB_FIX_WAIT_TIME_P50, "Time_data_page_fix_wait_p50"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_PB_FIX_WAIT_TIME_P99, "Time_data_page_fix_wait_p99"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_PB_FIX_WAIT_TIME_P999, "Time_data_page_fix_wait_p999"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_LK_WAIT_TIME_P50, "Time_object_lock_wait_p50"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_LK_WAIT_TIME_P99, "Time_object_lock_wait_p99"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_LK_WAIT_TIME_P999, "Time_object_lock_wait_p999"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_LOG_FLUSH_WAIT_TIME_P50, "Time_log_flush_wait_p50"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_LOG_FLUSH_WAIT_TIME_P99, "Time_log_flush_wait_p99"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_LOG_FLUSH_WAIT_TIME_P999, "Time_log_flush_wait_p999"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_REPL_APPLY_LAG_TIME_P50, "Time_repl_apply_lag_p50"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_REPL_APPLY_LAG_TIME_P99, "Time_repl_apply_lag_p99"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_REPL_APPLY_LAG_TIME_P999, "Time_repl_apply_lag_p999"),
 
   /* Array type statistics */
   PSTAT_METADATA_INIT_COMPLEX (PSTAT_PBX_FIX_COUNTERS, "Num_data_page_fix_ext", &f_dump_in_file_Num_data_page_fix_ext,
@@ -1029,6 +1089,24 @@ perfmon_lk_waited_time_on_objects (THREAD_ENTRY * thread_p, int lock_mode, UINT6
   perfmon_add_stat_at_offset (thread_p, PSTAT_OBJ_LOCK_TIME_COUNTERS, lock_mode, amount);
 }
 
+/*
+ * perfmon_collect_latency - Add a duration to a latency histogram
+ *   return: none
+ *   type(in): histogram
+ *   amount(in): duration in microseconds
+ *
+ * Note: callers measure the duration only when perfmon_is_perf_tracking ().
+ */
+void
+perfmon_collect_latency (PERFMON_LATENCY_TYPE type, UINT64 amount)
+{
+  assert (type >= 0 && type < PERFMON_LATENCY_COUNT);
+
+#if defined (SERVER_MODE)
+  perfmon_Latency_histograms[type].collect (std::chrono::microseconds (amount));
+#endif /* SERVER_MODE */
+}
+
 UINT64
 perfmon_get_stats_and_clear (THREAD_ENTRY * thread_p, const char *stat_name)
 {
@@ -1708,6 +1786,11 @@ perfmon_server_calc_stats (UINT64 * stats)
 	       - stats[pstat_Metadata[PSTAT_LOG_NUM_IOREADS].start_offset]) * 100 * 100,
 	      stats[pstat_Metadata[PSTAT_LOG_NUM_FETCHES].start_offset]);
 
+  /* stored size in percent of raw size */
+  stats[pstat_Metadata[PSTAT_STREAM_COMPRESS_RATIO].start_offset] =
+    SAFE_DIV (stats[pstat_Metadata[PSTAT_STREAM_COMPRESS_STORED_BYTES].start_offset] * 100 * 100,
+	      stats[pstat_Metadata[PSTAT_STREAM_COMPRESS_RAW_BYTES].start_offset]);
+
   stats[pstat_Metadata[PSTAT_PB_PAGE_LOCK_ACQUIRE_TIME_10USEC].start_offset] = 100 * lock_time_usec / 1000;
   stats[pstat_Metadata[PSTAT_PB_PAGE_HOLD_ACQUIRE_TIME_10USEC].start_offset] = 100 * hold_time_usec / 1000;
   stats[pstat_Metadata[PSTAT_PB_PAGE_FIX_ACQUIRE_TIME_10USEC].start_offset] = 100 * fix_time_usec / 1000;
@@ -1776,9 +1859,11 @@ perfmon_server_calc_stats (UINT64 * stats)
 		    &(stats[pstat_Metadata[PSTAT_PB_LFCQ_BIG_PRV_NUM].start_offset]),
 		    &(stats[pstat_Metadata[PSTAT_PB_LFCQ_PRV_NUM].start_offset]),
 		    &(stats[pstat_Metadata[PSTAT_PB_LFCQ_SHR_NUM].start_offset]));
+  pgbuf_peek_warmup_stats (&(stats[pstat_Metadata[PSTAT_PB_WARMUP_REMAINING].start_offset]));
 
   css_get_thread_stats (&stats[pstat_Metadata[PSTAT_THREAD_STATS].start_offset]);
   perfmon_peek_thread_daemon_stats (stats);
+  perfmon_peek_latency_stats (stats);
 #endif // SERVER_MODE
 
   for (i = 0; i < PSTAT_COUNT; i++)
@@ -3080,6 +3165,10 @@ perfmon_initialize (int num_trans)
 
   pstat_Global.n_watchers = 0;
   pstat_Global.initialized = true;
+
+#if defined (SERVER_MODE)
+  perfmon_register_latency_histograms ();
+#endif /* SERVER_MODE */
   return NO_ERROR;
 
 error:
@@ -4220,6 +4309,63 @@ perfmon_peek_thread_daemon_stats (UINT64 * stats)
   log_flush_daemon_get_stats (statsp);
   statsp += perfmon_per_daemon_stat_count ();
 }
+
+/*
+ * perfmon_peek_latency_stats - Peek p50, p99 and p999 of latency histograms, in microseconds
+ *   return: none
+ *   stats(out): statistics array
+ */
+static void
+perfmon_peek_latency_stats (UINT64 * stats)
+{
+  static const PERF_STAT_ID first_psid[PERFMON_LATENCY_COUNT] = {
+    PSTAT_NET_REQUEST_TIME_P50, PSTAT_PB_FIX_WAIT_TIME_P50, PSTAT_LK_WAIT_TIME_P50, PSTAT_LOG_FLUSH_WAIT_TIME_P50,
+    PSTAT_REPL_APPLY_LAG_TIME_P50
+  };
+  // *INDENT-OFF*
+  cubmonitor::statistic_value values[6];	// count, total, p50, p99, p999, max
+  // *INDENT-ON*
+  int type;
+  int offset;
+
+  for (type = 0; type < PERFMON_LATENCY_COUNT; type++)
+    {
+      assert (perfmon_Latency_histograms[type].get_statistics_count () == 6);
+      perfmon_Latency_histograms[type].fetch (values);
+
+      /* P50, P99 and P999 are consecutive */
+      offset = pstat_Metadata[first_psid[type]].start_offset;
+      stats[offset] = values[2];
+      stats[offset + 1] = values[3];
+      stats[offset + 2] = values[4];
+    }
+}
+
+/*
+ * perfmon_register_latency_histograms - Register latency histograms to global monitor
+ *   return: none
+ */
+static void
+perfmon_register_latency_histograms (void)
+{
+  static const char *names[PERFMON_LATENCY_COUNT] = {
+    "network_request", "data_page_fix_wait", "object_lock_wait", "log_flush_wait", "repl_apply_lag"
+  };
+  static bool is_registered = false;
+  int type;
+
+  if (is_registered)
+    {
+      /* server was restarted in same process */
+      return;
+    }
+
+  for (type = 0; type < PERFMON_LATENCY_COUNT; type++)
+    {
+      perfmon_Latency_histograms[type].register_to_monitor (cubmonitor::get_global_monitor (), names[type]);
+    }
+  is_registered = true;
+}
 #endif // SERVER_MODE
 
 #if defined (SERVER_MODE) || defined (SA_MODE)
@@ -287,6 +287,13 @@ typedef enum
   PSTAT_PB_NUM_IOREADS,
   PSTAT_PB_NUM_IOWRITES,
   PSTAT_PB_NUM_FLUSHED,
+  PSTAT_PB_READ_AHEAD_IO,
+  PSTAT_PB_READ_AHEAD_NUM_PAGES,
+  PSTAT_PB_READ_AHEAD_NUM_HITS,
+  PSTAT_PB_WARMUP_IO,
+  PSTAT_PB_WARMUP_NUM_PAGES,
+  PSTAT_PB_NUM_OPTIMISTIC_FIXES,
+  PSTAT_PB_NUM_OPTIMISTIC_UNFIXES,
   /* peeked stats */
   PSTAT_PB_PRIVATE_QUOTA,
   PSTAT_PB_PRIVATE_COUNT,
@@ -296,6 +303,7 @@ typedef enum
   PSTAT_PB_LRU2_CNT,
   PSTAT_PB_LRU3_CNT,
   PSTAT_PB_VICT_CAND,
+  PSTAT_PB_WARMUP_REMAINING,
 
   /* Execution statistics for the log manager */
   PSTAT_LOG_NUM_FETCHES,
@@ -320,6 +328,8 @@ typedef enum
   PSTAT_LK_NUM_WAITED_ON_OBJECTS,
   PSTAT_LK_NUM_WAITED_TIME_ON_OBJECTS,	/* include this to avoid client-server compat issue even if extended stats are
 					 * disabled */
+  PSTAT_LK_NUM_FASTPATH_ON_CLASSES,
+  PSTAT_LK_NUM_FASTPATH_TRANSFERRED,
 
   /* Execution statistics for transactions */
   PSTAT_TRAN_NUM_COMMITS,
@@ -376,6 +386,20 @@ typedef enum
   /* HA replication delay */
   PSTAT_HA_REPL_DELAY,
 
+  /* replication apply on slave */
+  PSTAT_REPL_APPLY_NUM_TRANS,
+  PSTAT_REPL_APPLY_NUM_DEPENDENT_TRANS,
+  PSTAT_REPL_APPLY_NUM_BARRIER_TRANS,
+  PSTAT_REPL_APPLY_PENDING_TRANS,
+  PSTAT_REPL_APPLY_RUNNING_TRANS,
+
+  /* replication stream compression */
+  PSTAT_STREAM_COMPRESS_RAW_BYTES,
+  PSTAT_STREAM_COMPRESS_STORED_BYTES,
+  PSTAT_STREAM_COMPRESS_TIME,
+  PSTAT_STREAM_DECOMPRESS_BYTES,
+  PSTAT_STREAM_DECOMPRESS_TIME,
+
   /* Execution statistics for Plan cache */
   PSTAT_PC_NUM_ADD,
   PSTAT_PC_NUM_LOOKUP,
@@ -384,8 +408,17 @@ typedef enum
   PSTAT_PC_NUM_FULL,
   PSTAT_PC_NUM_DELETE,
   PSTAT_PC_NUM_INVALID_XASL_ID,
+  PSTAT_PC_NUM_LOADED,
+  PSTAT_PC_NUM_LOAD_DISCARDED,
+  PSTAT_PC_NUM_LOADED_HIT,
   PSTAT_PC_NUM_CACHE_ENTRIES,
 
+  /* Execution statistics for query result cache */
+  PSTAT_QRC_NUM_HIT,
+  PSTAT_QRC_NUM_MISS,
+  PSTAT_QRC_NUM_EVICT,
+  PSTAT_QRC_NUM_INVALIDATE,
+
   PSTAT_VAC_NUM_VACUUMED_LOG_PAGES,
   PSTAT_VAC_NUM_TO_VACUUM_LOG_PAGES,
   PSTAT_VAC_NUM_PREFETCH_REQUESTS_LOG_PAGES,
@@ -514,6 +547,7 @@ typedef enum
   PSTAT_PB_PAGE_PROMOTE_FAILED,
   /* total promotion time */
   PSTAT_PB_PAGE_PROMOTE_TOTAL_TIME_10USEC,
+  PSTAT_STREAM_COMPRESS_RATIO,
 
   /* Page buffer extended */
   /* detailed unfix module */
@@ -618,6 +652,22 @@ typedef enum
   PSTAT_PB_LFCQ_SHR_NUM,
   PSTAT_PB_AVOID_DEALLOC_CNT,
   PSTAT_PB_AVOID_VICTIM_CNT,
+  /* percentiles of latency histograms */
+  PSTAT_NET_REQUEST_TIME_P50,
+  PSTAT_NET_REQUEST_TIME_P99,
+  PSTAT_NET_REQUEST_TIME_P999,
+  PSTAT_PB_FIX_WAIT_TIME_P50,
+  PSTAT_PB_FIX_WAIT_TIME_P99,
+  PSTAT_PB_FIX_WAIT_TIME_P999,
+  PSTAT_LK_WAIT_TIME_P50,
+  PSTAT_LK_WAIT_TIME_P99,
+  PSTAT_LK_WAIT_TIME_P999,
+  PSTAT_LOG_FLUSH_WAIT_TIME_P50,
+  PSTAT_LOG_FLUSH_WAIT_TIME_P99,
+  PSTAT_LOG_FLUSH_WAIT_TIME_P999,
+  PSTAT_REPL_APPLY_LAG_TIME_P50,
+  PSTAT_REPL_APPLY_LAG_TIME_P99,
+  PSTAT_REPL_APPLY_LAG_TIME_P999,
 
   /* Complex statistics */
   PSTAT_PBX_FIX_COUNTERS,
@@ -1432,6 +1482,15 @@ struct perf_utime_tracker
       (track)->start_tick = (track)->end_tick; \
     } \
   while (false)
+/* Latency trackers - perfmon_collect_latency is called. */
+#define PERF_UTIME_TRACKER_LATENCY(thread_p, track, type) \
+  do \
+    { \
+      if (!(track)->is_perf_tracking) break; \
+      tsc_getticks (&(track)->end_tick); \
+      perfmon_collect_latency (type, tsc_elapsed_utime ((track)->end_tick, (track)->start_tick)); \
+    } \
+  while (false)
 #endif /* defined (SERVER_MODE) || defined (SA_MODE) */
 
 #if defined(SERVER_MODE) || defined (SA_MODE)
@@ -1444,6 +1503,20 @@ extern UINT64 perfmon_get_from_statistic (THREAD_ENTRY * thread_p, const int sta
 
 extern void perfmon_lk_waited_time_on_objects (THREAD_ENTRY * thread_p, int lock_mode, UINT64 amount);
 
+/* latency histograms; their percentiles are peeked as PSTAT_*_TIME_P50/P99/P999 */
+typedef enum
+{
+  PERFMON_LATENCY_NET_REQUEST,	/* execution of a client request */
+  PERFMON_LATENCY_PB_FIX_WAIT,	/* page fix that waited for latch or for page read by another thread */
+  PERFMON_LATENCY_LK_WAIT,	/* object lock wait */
+  PERFMON_LATENCY_LOG_FLUSH_WAIT,	/* commit waiting for log flush */
+  PERFMON_LATENCY_REPL_APPLY_LAG,	/* replicated transaction, from its group commit until it is applied */
+
+  PERFMON_LATENCY_COUNT
+} PERFMON_LATENCY_TYPE;
+
+extern void perfmon_collect_latency (PERFMON_LATENCY_TYPE type, UINT64 amount);
+
 extern UINT64 perfmon_get_stats_and_clear (THREAD_ENTRY * thread_p, const char *stat_name);
 
 extern void perfmon_pbx_fix (THREAD_ENTRY * thread_p, int page_type, int page_found_mode, int latch_mode,
@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// stream_compression.cpp - block compression of stream contents
+//
+
+#include "stream_compression.hpp"
+
+#include "lzo/lzoconf.h"
+#include "lzo/lzo1x.h"
+#include "perf_monitor.h"
+
+#include <chrono>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace cubstream
+{
+  static const std::uint16_t COMPRESSED_BLOCK_MAGIC = 0xCB5C;
+
+  static bool
+  init_lzo (void)
+  {
+    // once per process; lzo_init only checks the library configuration
+    static const bool is_lzo_ok = lzo_init () == LZO_E_OK;
+
+    assert (is_lzo_ok);
+    return is_lzo_ok;
+  }
+
+  static void
+  put_uint16 (char *ptr, std::uint16_t value)
+  {
+    ptr[0] = (char) (value >> 8);
+    ptr[1] = (char) value;
+  }
+
+  static void
+  put_uint32 (char *ptr, std::uint32_t value)
+  {
+    ptr[0] = (char) (value >> 24);
+    ptr[1] = (char) (value >> 16);
+    ptr[2] = (char) (value >> 8);
+    ptr[3] = (char) value;
+  }
+
+  static std::uint16_t
+  get_uint16 (const char *ptr)
+  {
+    const unsigned char *uptr = (const unsigned char *) ptr;
+
+    return (std::uint16_t) ((uptr[0] << 8) | uptr[1]);
+  }
+
+  static std::uint32_t
+  get_uint32 (const char *ptr)
+  {
+    const unsigned char *uptr = (const unsigned char *) ptr;
+
+    return ((std::uint32_t) uptr[0] << 24) | ((std::uint32_t) uptr[1] << 16) | ((std::uint32_t) uptr[2] << 8)
+	   | (std::uint32_t) uptr[3];
+  }
+
+  static void
+  write_header (char *block, compression_codec codec, std::size_t raw_size, std::size_t stored_size)
+  {
+    put_uint16 (block, COMPRESSED_BLOCK_MAGIC);
+    block[2] = (char) codec;
+    block[3] = 0;
+    put_uint32 (block + 4, (std::uint32_t) raw_size);
+    put_uint32 (block + 8, (std::uint32_t) stored_size);
+  }
+
+  // LZO output may exceed input for incompressible data
+  static std::size_t
+  get_max_payload_size (std::size_t raw_size)
+  {
+    return raw_size + raw_size / 16 + 64 + 3;
+  }
+
+  static std::uint64_t
+  get_elapsed_usec (const std::chrono::steady_clock::time_point &start)
+  {
+    return (std::uint64_t) std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now ()
+	   - start).count ();
+  }
+
+  std::size_t
+  get_compressed_block_max_size (std::size_t raw_size)
+  {
+    return COMPRESSED_BLOCK_HEADER_SIZE + get_max_payload_size (raw_size);
+  }
+
+  block_compressor::block_compressor (compression_codec codec)
+    : m_codec (COMPRESSION_NONE)
+    , m_work_memory (NULL)
+  {
+    set_codec (codec);
+  }
+
+  block_compressor::~block_compressor ()
+  {
+    free (m_work_memory);
+  }
+
+  void
+  block_compressor::set_codec (compression_codec codec)
+  {
+    std::size_t work_memory_size = 0;
+
+    free (m_work_memory);
+    m_work_memory = NULL;
+    m_codec = COMPRESSION_NONE;
+
+    switch (codec)
+      {
+      case COMPRESSION_LZO1X_1:
+	work_memory_size = LZO1X_1_MEM_COMPRESS;
+	break;
+      case COMPRESSION_LZO1X_999:
+	work_memory_size = LZO1X_999_MEM_COMPRESS;
+	break;
+      default:
+	assert (codec == COMPRESSION_NONE);
+	return;
+      }
+
+    if (!init_lzo ())
+      {
+	return;
+      }
+
+    m_work_memory = (char *) malloc (work_memory_size);
+    if (m_work_memory == NULL)
+      {
+	// blocks are stored uncompressed
+	return;
+      }
+    m_codec = codec;
+  }
+
+  std::size_t
+  block_compressor::compress (const char *raw, std::size_t raw_size, char *block)
+  {
+    std::chrono::steady_clock::time_point start;
+    char *payload = block + COMPRESSED_BLOCK_HEADER_SIZE;
+    lzo_uint stored_size = 0;
+    int rc = LZO_E_ERROR;
+
+    assert (raw_size <= COMPRESSED_BLOCK_MAX_RAW_SIZE);
+
+    if (m_codec != COMPRESSION_NONE && raw_size > 0)
+      {
+	start = std::chrono::steady_clock::now ();
+	if (m_codec == COMPRESSION_LZO1X_1)
+	  {
+	    rc = lzo1x_1_compress ((lzo_bytep) raw, (lzo_uint) raw_size, (lzo_bytep) payload, &stored_size,
+				   (lzo_voidp) m_work_memory);
+	  }
+	else
+	  {
+	    rc = lzo1x_999_compress ((lzo_bytep) raw, (lzo_uint) raw_size, (lzo_bytep) payload, &stored_size,
+				     (lzo_voidp) m_work_memory);
+	  }
+	perfmon_add_stat_to_global (PSTAT_STREAM_COMPRESS_TIME, get_elapsed_usec (start));
+
+	if (rc == LZO_E_OK && stored_size < raw_size)
+	  {
+	    write_header (block, m_codec, raw_size, stored_size);
+
+	    perfmon_add_stat_to_global (PSTAT_STREAM_COMPRESS_RAW_BYTES, raw_size);
+	    perfmon_add_stat_to_global (PSTAT_STREAM_COMPRESS_STORED_BYTES, stored_size);
+	    return COMPRESSED_BLOCK_HEADER_SIZE + stored_size;
+	  }
+	// did not shrink; store as is
+      }
+
+    write_header (block, COMPRESSION_NONE, raw_size, raw_size);
+    std::memcpy (payload, raw, raw_size);
+
+    if (m_codec != COMPRESSION_NONE)
+      {
+	perfmon_add_stat_to_global (PSTAT_STREAM_COMPRESS_RAW_BYTES, raw_size);
+	perfmon_add_stat_to_global (PSTAT_STREAM_COMPRESS_STORED_BYTES, raw_size);
+      }
+    return COMPRESSED_BLOCK_HEADER_SIZE + raw_size;
+  }
+
+  bool
+  read_compressed_block_header (const char *block, std::size_t block_size, compressed_block_header &header)
+  {
+    std::uint8_t codec;
+
+    if (block_size < COMPRESSED_BLOCK_HEADER_SIZE || get_uint16 (block) != COMPRESSED_BLOCK_MAGIC)
+      {
+	return false;
+      }
+
+    codec = (std::uint8_t) block[2];
+    if (codec >= COMPRESSION_CODEC_COUNT)
+      {
+	return false;
+      }
+
+    header.m_codec = (compression_codec) codec;
+    header.m_raw_size = get_uint32 (block + 4);
+    header.m_stored_size = get_uint32 (block + 8);
+
+    if (header.m_raw_size > COMPRESSED_BLOCK_MAX_RAW_SIZE)
+      {
+	return false;
+      }
+    if (header.m_codec == COMPRESSION_NONE ? header.m_stored_size != header.m_raw_size
+	: header.m_stored_size > get_max_payload_size (header.m_raw_size))
+      {
+	return false;
+      }
+    return true;
+  }
+
+  bool
+  decompress_block (const compressed_block_header &header, const char *payload, char *raw)
+  {
+    std::chrono::steady_clock::time_point start;
+    lzo_uint raw_size = (lzo_uint) header.m_raw_size;
+    int rc;
+
+    if (header.m_codec == COMPRESSION_NONE)
+      {
+	std::memcpy (raw, payload, header.m_raw_size);
+	return true;
+      }
+
+    if (!init_lzo ())
+      {
+	return false;
+      }
+
+    // both LZO1X codecs have the same decompressor
+    start = std::chrono::steady_clock::now ();
+    rc = lzo1x_decompress_safe ((lzo_bytep) payload, (lzo_uint) header.m_stored_size, (lzo_bytep) raw,
+				&raw_size, NULL);
+    perfmon_add_stat_to_global (PSTAT_STREAM_DECOMPRESS_TIME, get_elapsed_usec (start));
+
+    if (rc != LZO_E_OK || raw_size != (lzo_uint) header.m_raw_size)
+      {
+	return false;
+      }
+
+    perfmon_add_stat_to_global (PSTAT_STREAM_DECOMPRESS_BYTES, raw_size);
+    return true;
+  }
+
+} // namespace cubstream
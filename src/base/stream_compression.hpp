@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// stream_compression.hpp - block compression of stream contents
+//
+//  Stream contents are compressed in blocks of at most COMPRESSED_BLOCK_MAX_RAW_SIZE bytes. Each block starts with a
+//  header, in network byte order:
+//
+//      magic (2 bytes) | codec (1 byte) | reserved (1 byte) | raw size (4 bytes) | stored size (4 bytes)
+//
+//  followed by stored size bytes of payload. The codec is the one used for the block, so a reader decompresses any
+//  block without knowing how the writer was configured. Data that does not shrink is stored as is, with codec
+//  COMPRESSION_NONE.
+//
+//  The format is used by transfer_sender/transfer_receiver, one block per message, and by stream_file volumes, when
+//  compression is enabled.
+//
+//  Compressed and stored bytes and compression and decompression times are added to performance statistics.
+//
+//  How to use:
+//
+//          cubstream::block_compressor compressor (cubstream::COMPRESSION_LZO1X_1);
+//          std::vector<char> block (cubstream::get_compressed_block_max_size (raw_size));
+//
+//          std::size_t block_size = compressor.compress (raw, raw_size, block.data ());
+//
+//          cubstream::compressed_block_header header;
+//          if (!cubstream::read_compressed_block_header (block.data (), block_size, header)
+//              || !cubstream::decompress_block (header, block.data () + cubstream::COMPRESSED_BLOCK_HEADER_SIZE, raw))
+//            {
+//              // corrupted block
+//            }
+//
+
+#ifndef _STREAM_COMPRESSION_HPP_
+#define _STREAM_COMPRESSION_HPP_
+
+#include <cstddef>
+
+namespace cubstream
+{
+  // codecs; values are stored in block headers and must not change
+  enum compression_codec
+  {
+    COMPRESSION_NONE = 0,
+    COMPRESSION_LZO1X_1 = 1,            // fast compression
+    COMPRESSION_LZO1X_999 = 2,          // better ratio, slower compression; decompression is as fast as LZO1X_1
+
+    COMPRESSION_CODEC_COUNT
+  };
+
+  const std::size_t COMPRESSED_BLOCK_HEADER_SIZE = 12;
+  const std::size_t COMPRESSED_BLOCK_MAX_RAW_SIZE = 64 * 1024;
+
+  struct compressed_block_header
+  {
+    compression_codec m_codec;
+    std::size_t m_raw_size;
+    std::size_t m_stored_size;          // payload size, without header
+  };
+
+  // size of header and payload of a block of raw_size bytes, in the worst case
+  std::size_t get_compressed_block_max_size (std::size_t raw_size);
+
+  class block_compressor
+  {
+    public:
+      block_compressor (compression_codec codec = COMPRESSION_NONE);
+      ~block_compressor ();
+
+      block_compressor (const block_compressor &) = delete;
+      block_compressor &operator= (const block_compressor &) = delete;
+
+      void set_codec (compression_codec codec);
+      compression_codec get_codec () const
+      {
+	return m_codec;
+      }
+
+      // compress raw_size bytes, at most COMPRESSED_BLOCK_MAX_RAW_SIZE, into block, header included;
+      // block must have get_compressed_block_max_size (raw_size) bytes. returns block size
+      std::size_t compress (const char *raw, std::size_t raw_size, char *block);
+
+    private:
+      compression_codec m_codec;
+      char *m_work_memory;
+  };
+
+  // read header at start of block; block_size is the number of bytes available, at least the header size.
+  // returns false if header is not valid
+  bool read_compressed_block_header (const char *block, std::size_t block_size, compressed_block_header &header);
+
+  // decompress payload of block into raw, which must have header.m_raw_size bytes. returns false if payload is not
+  // valid
+  bool decompress_block (const compressed_block_header &header, const char *payload, char *raw);
+
+} // namespace cubstream
+
+#endif // _STREAM_COMPRESSION_HPP_
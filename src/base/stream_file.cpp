@@ -32,6 +32,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #endif
+#include <sys/stat.h>
 #include "stream_file.hpp"
 #include "error_manager.h"
 #include "thread_entry_task.hpp"
@@ -40,7 +41,9 @@
 #include "porting.h"
 #include "system_parameter.h" /* er_log_debug */
 
+#include <algorithm>  /* for std::upper_bound */
 #include <cstdio>     /* for std::remove */
+#include <cstring>    /* for std::memcpy */
 #include <limits>     /* for std::numeric_limits */
 #include <queue>
 
@@ -179,6 +182,21 @@ namespace cubstream
 	close (it->second);
       }
     m_file_descriptors.clear ();
+    ulock.unlock ();
+
+    std::unique_lock<std::mutex> compressed_lock (m_compressed_volumes_mutex);
+    m_compressed_volumes.clear ();
+    m_cached_vol_seqno = -1;
+  }
+
+  void stream_file::set_compression (compression_codec codec)
+  {
+    m_is_compressed = codec != COMPRESSION_NONE;
+    m_compressor.set_codec (codec);
+    if (m_is_compressed)
+      {
+	m_compress_buffer.resize (get_compressed_block_max_size (COMPRESSED_BLOCK_MAX_RAW_SIZE));
+      }
   }
 
   int stream_file::get_file_desc_from_vol_seqno (const int vol_seqno)
@@ -310,7 +328,7 @@ namespace cubstream
 	while (rem_amount_this_volume > 0)
 	  {
 	    size_t amount_to_write = std::min (BUFFER_SIZE, rem_amount_this_volume);
-	    size_t written_bytes = write_buffer (vol_seqno, volume_offset, zero_buffer, amount_to_write);
+	    size_t written_bytes = write_volume_data (vol_seqno, volume_offset, zero_buffer, amount_to_write);
 	    if (written_bytes != amount_to_write)
 	      {
 		ASSERT_ERROR_AND_SET (err);
@@ -501,6 +519,11 @@ namespace cubstream
     m_file_descriptors.erase (it);
     ulock.unlock ();
 
+    if (m_is_compressed)
+      {
+	drop_compressed_volume (vol_seqno);
+      }
+
     if (close (fd) != 0)
       {
 	er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_BO_TRYING_TO_REMOVE_PERMANENT_VOLUME, 1, file_name);
@@ -685,6 +708,354 @@ namespace cubstream
     return NO_ERROR;
   }
 
+  /*
+   * read_volume_data : reads from volume "vol_seqno" the data at offset "volume_offset", as if volume was not
+   *                    compressed
+   * return : number of bytes actually read
+   */
+  size_t stream_file::read_volume_data (const int vol_seqno, const size_t volume_offset, char *buf,
+					const size_t amount)
+  {
+    if (m_is_compressed)
+      {
+	return read_compressed (vol_seqno, volume_offset, buf, amount);
+      }
+    return read_buffer (vol_seqno, volume_offset, buf, amount);
+  }
+
+  /*
+   * write_volume_data : writes in volume "vol_seqno" the data at offset "volume_offset", as if volume was not
+   *                     compressed
+   * return : number of bytes actually written
+   */
+  size_t stream_file::write_volume_data (const int vol_seqno, const size_t volume_offset, const char *buf,
+					 const size_t amount)
+  {
+    if (m_is_compressed)
+      {
+	return write_compressed (vol_seqno, volume_offset, buf, amount);
+      }
+    return write_buffer (vol_seqno, volume_offset, buf, amount);
+  }
+
+  /*
+   * read_compressed : reads from compressed volume "vol_seqno" the data at offset "volume_offset"
+   * return : number of bytes actually read
+   */
+  size_t stream_file::read_compressed (const int vol_seqno, const size_t volume_offset, char *buf,
+				       const size_t amount)
+  {
+    std::vector<char> block;
+    std::vector<char> raw;
+    compressed_block_header header;
+    compressed_frame frame;
+    size_t actual_read = 0;
+
+    while (actual_read < amount)
+      {
+	size_t curr_offset = volume_offset + actual_read;
+	size_t frame_offset;
+	size_t to_copy;
+
+	std::unique_lock<std::mutex> ulock (m_compressed_volumes_mutex);
+	compressed_volume *volume = get_compressed_volume (vol_seqno);
+	if (volume == NULL)
+	  {
+	    return actual_read;
+	  }
+
+	/* last frame starting before or at current offset */
+	auto found = std::upper_bound (volume->m_frames.begin (), volume->m_frames.end (), curr_offset,
+				       [] (size_t offset, const compressed_frame &f)
+	{
+	  return offset < f.m_volume_offset;
+	});
+	if (found == volume->m_frames.begin ()
+	    || curr_offset >= (found - 1)->m_volume_offset + (found - 1)->m_raw_size)
+	  {
+	    char filename[PATH_MAX] = {0};
+	    get_vol_filename_with_vol_seqno (filename, sizeof (filename), vol_seqno);
+	    er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_STREAM_FILE_CANNOT_READ, 3, filename, curr_offset,
+		    amount - actual_read);
+	    return actual_read;
+	  }
+	frame = * (found - 1);
+
+	frame_offset = curr_offset - frame.m_volume_offset;
+	to_copy = std::min (frame.m_raw_size - frame_offset, amount - actual_read);
+
+	if (m_cached_vol_seqno == vol_seqno && m_cached_volume_offset == frame.m_volume_offset)
+	  {
+	    std::memcpy (buf + actual_read, m_cached_block.data () + frame_offset, to_copy);
+	    actual_read += to_copy;
+	    continue;
+	  }
+	ulock.unlock ();
+
+	block.resize (frame.m_block_size);
+	if (read_buffer (vol_seqno, frame.m_physical_offset, block.data (), frame.m_block_size) < frame.m_block_size)
+	  {
+	    return actual_read;
+	  }
+
+	raw.resize (frame.m_raw_size);
+	if (!read_compressed_block_header (block.data (), block.size (), header)
+	    || header.m_raw_size != frame.m_raw_size
+	    || COMPRESSED_BLOCK_HEADER_SIZE + header.m_stored_size != frame.m_block_size
+	    || !decompress_block (header, block.data () + COMPRESSED_BLOCK_HEADER_SIZE, raw.data ()))
+	  {
+	    er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_STREAM_INVALID_COMPRESSED_BLOCK, 2, m_stream.name ().c_str (),
+		    vol_seqno * m_desired_volume_size + frame.m_volume_offset);
+	    return actual_read;
+	  }
+
+	std::memcpy (buf + actual_read, raw.data () + frame_offset, to_copy);
+	actual_read += to_copy;
+
+	ulock.lock ();
+	m_cached_vol_seqno = vol_seqno;
+	m_cached_volume_offset = frame.m_volume_offset;
+	m_cached_block.swap (raw);
+      }
+
+    return actual_read;
+  }
+
+  /*
+   * write_compressed : appends to compressed volume "vol_seqno" the data of offset "volume_offset"
+   *                    a gap after volume end is filled with zeros; writing before volume end is allowed only at the
+   *                    start of a block, and drops the blocks from there
+   * return : number of bytes actually written
+   */
+  size_t stream_file::write_compressed (const int vol_seqno, const size_t volume_offset, const char *buf,
+					const size_t amount)
+  {
+    static const char zero_buffer[COMPRESSED_BLOCK_MAX_RAW_SIZE] = { 0 };
+    size_t physical_offset;
+    size_t raw_end;
+    bool is_truncated = false;
+
+    std::unique_lock<std::mutex> ulock (m_compressed_volumes_mutex);
+    compressed_volume *volume;
+
+    if (volume_offset == 0)
+      {
+	/* new volume; it may exist from a previous use */
+	m_compressed_volumes.erase (vol_seqno);
+	volume = &m_compressed_volumes[vol_seqno];
+	volume->m_raw_end = 0;
+	volume->m_physical_end = 0;
+	is_truncated = true;
+      }
+    else
+      {
+	volume = get_compressed_volume (vol_seqno);
+	if (volume == NULL)
+	  {
+	    return 0;
+	  }
+
+	if (volume_offset < volume->m_raw_end)
+	  {
+	    auto found = std::find_if (volume->m_frames.begin (), volume->m_frames.end (),
+				       [volume_offset] (const compressed_frame &f)
+	    {
+	      return f.m_volume_offset == volume_offset;
+	    });
+	    if (found == volume->m_frames.end ())
+	      {
+		er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_STREAM_FILE_INVALID_WRITE, 3, m_stream.name ().c_str (),
+			vol_seqno * m_desired_volume_size + volume_offset, amount);
+		return 0;
+	      }
+	    volume->m_physical_end = found->m_physical_offset;
+	    volume->m_raw_end = volume_offset;
+	    volume->m_frames.erase (found, volume->m_frames.end ());
+	    is_truncated = true;
+	  }
+      }
+
+    if (is_truncated && m_cached_vol_seqno == vol_seqno)
+      {
+	m_cached_vol_seqno = -1;
+      }
+    physical_offset = volume->m_physical_end;
+    raw_end = volume->m_raw_end;
+    ulock.unlock ();
+
+    if (is_truncated)
+      {
+	int fd = open_vol_seqno (vol_seqno);
+	if (fd < 0 || ftruncate (fd, (off_t) physical_offset) != 0)
+	  {
+	    char filename[PATH_MAX] = {0};
+	    get_vol_filename_with_vol_seqno (filename, sizeof (filename), vol_seqno);
+	    er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_STREAM_FILE_CANNOT_WRITE, 3, filename,
+				 physical_offset, amount);
+	    return 0;
+	  }
+      }
+
+    while (raw_end < volume_offset)
+      {
+	size_t zero_amount = std::min (volume_offset - raw_end, sizeof (zero_buffer));
+	size_t block_size = append_compressed (vol_seqno, physical_offset, zero_buffer, zero_amount);
+	if (block_size == 0)
+	  {
+	    return 0;
+	  }
+	physical_offset += block_size;
+	raw_end += zero_amount;
+      }
+
+    for (size_t actual_write = 0; actual_write < amount;)
+      {
+	size_t raw_size = std::min (amount - actual_write, COMPRESSED_BLOCK_MAX_RAW_SIZE);
+	size_t block_size = append_compressed (vol_seqno, physical_offset, buf + actual_write, raw_size);
+	if (block_size == 0)
+	  {
+	    return actual_write;
+	  }
+	physical_offset += block_size;
+	actual_write += raw_size;
+      }
+
+    return amount;
+  }
+
+  /*
+   * append_compressed : compresses amount bytes of buf in one block, writes it at end of volume and adds it to index
+   * return : size of block, or zero if it could not be written
+   */
+  size_t stream_file::append_compressed (const int vol_seqno, size_t physical_offset, const char *buf,
+					 const size_t amount)
+  {
+    compressed_frame frame;
+
+    frame.m_block_size = m_compressor.compress (buf, amount, m_compress_buffer.data ());
+    if (write_buffer (vol_seqno, physical_offset, m_compress_buffer.data (), frame.m_block_size) < frame.m_block_size)
+      {
+	return 0;
+      }
+
+    std::unique_lock<std::mutex> ulock (m_compressed_volumes_mutex);
+    auto found = m_compressed_volumes.find (vol_seqno);
+    if (found == m_compressed_volumes.end () || found->second.m_physical_end != physical_offset)
+      {
+	/* dropped meanwhile */
+	er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_STREAM_FILE_INVALID_WRITE, 3, m_stream.name ().c_str (),
+		vol_seqno * m_desired_volume_size, amount);
+	return 0;
+      }
+
+    compressed_volume &volume = found->second;
+    frame.m_volume_offset = volume.m_raw_end;
+    frame.m_physical_offset = physical_offset;
+    frame.m_raw_size = amount;
+    volume.m_frames.push_back (frame);
+    volume.m_raw_end += amount;
+    volume.m_physical_end += frame.m_block_size;
+
+    return frame.m_block_size;
+  }
+
+  /*
+   * get_compressed_volume : index of volume blocks; loads it if needed
+   *                         caller must hold m_compressed_volumes_mutex
+   * return : index or NULL on error
+   */
+  stream_file::compressed_volume *stream_file::get_compressed_volume (const int vol_seqno)
+  {
+    auto found = m_compressed_volumes.find (vol_seqno);
+
+    if (found != m_compressed_volumes.end ())
+      {
+	return &found->second;
+      }
+
+    compressed_volume volume;
+    if (load_compressed_volume (vol_seqno, volume) != NO_ERROR)
+      {
+	return NULL;
+      }
+    return &(m_compressed_volumes[vol_seqno] = std::move (volume));
+  }
+
+  /*
+   * load_compressed_volume : builds index of volume blocks by scanning their headers
+   *                          scan stops at the first block which is not entirely written
+   * return : error code
+   */
+  int stream_file::load_compressed_volume (const int vol_seqno, compressed_volume &volume)
+  {
+    char header_buffer[COMPRESSED_BLOCK_HEADER_SIZE];
+    compressed_block_header header;
+    struct stat stat_buf;
+    size_t file_size;
+    int fd;
+    int err = NO_ERROR;
+
+    volume.m_frames.clear ();
+    volume.m_raw_end = 0;
+    volume.m_physical_end = 0;
+
+    fd = open_vol_seqno (vol_seqno);
+    if (fd < 0)
+      {
+	ASSERT_ERROR_AND_SET (err);
+	return err;
+      }
+
+    if (fstat (fd, &stat_buf) != 0)
+      {
+	char filename[PATH_MAX] = {0};
+	get_vol_filename_with_vol_seqno (filename, sizeof (filename), vol_seqno);
+	er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_STREAM_FILE_CANNOT_READ, 3, filename, 0, 0);
+	return ER_STREAM_FILE_CANNOT_READ;
+      }
+    file_size = (size_t) stat_buf.st_size;
+
+    while (volume.m_physical_end + COMPRESSED_BLOCK_HEADER_SIZE <= file_size)
+      {
+	compressed_frame frame;
+
+	if (read_buffer (vol_seqno, volume.m_physical_end, header_buffer, COMPRESSED_BLOCK_HEADER_SIZE)
+	    < COMPRESSED_BLOCK_HEADER_SIZE)
+	  {
+	    ASSERT_ERROR_AND_SET (err);
+	    return err;
+	  }
+	if (!read_compressed_block_header (header_buffer, COMPRESSED_BLOCK_HEADER_SIZE, header)
+	    || volume.m_physical_end + COMPRESSED_BLOCK_HEADER_SIZE + header.m_stored_size > file_size
+	    || volume.m_raw_end + header.m_raw_size > m_desired_volume_size)
+	  {
+	    break;
+	  }
+
+	frame.m_volume_offset = volume.m_raw_end;
+	frame.m_physical_offset = volume.m_physical_end;
+	frame.m_raw_size = header.m_raw_size;
+	frame.m_block_size = COMPRESSED_BLOCK_HEADER_SIZE + header.m_stored_size;
+	volume.m_frames.push_back (frame);
+
+	volume.m_raw_end += frame.m_raw_size;
+	volume.m_physical_end += frame.m_block_size;
+      }
+
+    return NO_ERROR;
+  }
+
+  void stream_file::drop_compressed_volume (const int vol_seqno)
+  {
+    std::unique_lock<std::mutex> ulock (m_compressed_volumes_mutex);
+
+    m_compressed_volumes.erase (vol_seqno);
+    if (m_cached_vol_seqno == vol_seqno)
+      {
+	m_cached_vol_seqno = -1;
+      }
+  }
+
   /*
    * write
    *
@@ -768,7 +1139,7 @@ namespace cubstream
 
 	current_to_write = std::min (available_amount_in_volume, rem_amount);
 
-	actual_write = write_buffer (vol_seqno, vol_offset, buf, current_to_write);
+	actual_write = write_volume_data (vol_seqno, vol_offset, buf, current_to_write);
 	if (actual_write < current_to_write)
 	  {
 	    ASSERT_ERROR_AND_SET (err);
@@ -849,7 +1220,7 @@ namespace cubstream
 
 	current_to_read = MIN (available_amount_in_volume, rem_amount);
 
-	actual_read = read_buffer (vol_seqno, volume_offset, buf, current_to_read);
+	actual_read = read_volume_data (vol_seqno, volume_offset, buf, current_to_read);
 	if (actual_read < current_to_read)
 	  {
 	    ASSERT_ERROR_AND_SET (err);
@@ -27,8 +27,10 @@
 #define _STREAM_FILE_HPP_
 
 #include "multi_thread_stream.hpp"
+#include "stream_compression.hpp"
 #include <map>
 #include <queue>
+#include <vector>
 
 namespace cubthread
 {
@@ -55,6 +57,15 @@ namespace cubstream
    * - active range is considered between a dropped position and append position; the active range is contiguous
    * - read range must entirely be inside the active range
    *
+   * Compression (set_compression):
+   * - volumes are written as sequences of compressed blocks (see stream_compression.hpp); a volume still covers the
+   *   same range of stream positions, but its file is smaller
+   * - an index of blocks is kept in memory for each volume; it is built by scanning the block headers when a volume
+   *   is first accessed, so volumes written by a previous run can be read. blocks incompletely written are ignored
+   * - data is only appended to a volume; a write may start at the end of a block, the following blocks are dropped
+   * - a read decompresses the blocks it covers; the last decompressed block is kept for following reads
+   * - the setting must not change for existing volumes
+   *
    * TODOs:
    * - resizing of physical files (should be entirely off-line)
    */
@@ -126,6 +137,34 @@ namespace cubstream
 
       bool m_is_stopped;
 
+      /* compressed volumes */
+      struct compressed_frame
+      {
+	size_t m_volume_offset;       /* offset of data in volume, as if not compressed */
+	size_t m_physical_offset;     /* offset of block in volume file */
+	size_t m_raw_size;
+	size_t m_block_size;          /* header and payload */
+      };
+
+      struct compressed_volume
+      {
+	std::vector<compressed_frame> m_frames;
+	size_t m_raw_end;
+	size_t m_physical_end;
+      };
+
+      bool m_is_compressed;
+      /* used by writer only */
+      block_compressor m_compressor;
+      std::vector<char> m_compress_buffer;
+
+      /* index of volume blocks and last decompressed block */
+      std::map<int, compressed_volume> m_compressed_volumes;
+      int m_cached_vol_seqno;
+      size_t m_cached_volume_offset;
+      std::vector<char> m_cached_block;
+      std::mutex m_compressed_volumes_mutex;
+
       static const int FILE_CREATE_FLAG;
 
 #if defined (WINDOWS)
@@ -152,6 +191,16 @@ namespace cubstream
       size_t write_buffer (const int vol_seqno, const size_t volume_offset, const char *buf, const size_t amount);
       int fsync_writes ();
 
+      size_t read_volume_data (const int vol_seqno, const size_t volume_offset, char *buf, const size_t amount);
+      size_t write_volume_data (const int vol_seqno, const size_t volume_offset, const char *buf, const size_t amount);
+
+      size_t read_compressed (const int vol_seqno, const size_t volume_offset, char *buf, const size_t amount);
+      size_t write_compressed (const int vol_seqno, const size_t volume_offset, const char *buf, const size_t amount);
+      size_t append_compressed (const int vol_seqno, size_t physical_offset, const char *buf, const size_t amount);
+      compressed_volume *get_compressed_volume (const int vol_seqno);
+      int load_compressed_volume (const int vol_seqno, compressed_volume &volume);
+      void drop_compressed_volume (const int vol_seqno);
+
     public:
       stream_file () = delete;
 
@@ -160,6 +209,9 @@ namespace cubstream
 	: m_stream (stream_arg)
 	, m_notify_on_sync (false)
 	, m_to_be_synced (std::numeric_limits<stream_position>::min ())
+	, m_is_compressed (false)
+	, m_cached_vol_seqno (-1)
+	, m_cached_volume_offset (0)
       {
 	init (path, 0, file_size, print_digits);
       };
@@ -178,6 +230,13 @@ namespace cubstream
       {
 	m_strict_append_mode = mode;
       }
+
+      /* must be called before accessing volumes; COMPRESSION_NONE writes raw volumes */
+      void set_compression (compression_codec codec);
+      bool is_compressed (void) const
+      {
+	return m_is_compressed;
+      }
       void finalize ();
 
       int write (const stream_position &pos, const char *buf, const size_t amount);
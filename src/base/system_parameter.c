@@ -85,6 +85,7 @@
 #include "perf_monitor.h"
 #include "fault_injection.h"
 #include "replication_common.hpp"
+#include "stream_compression.hpp"
 #if defined (SERVER_MODE)
 #include "thread_manager.hpp"	// for thread_get_thread_entry_info
 #endif // SERVER_MODE
@@ -677,6 +678,50 @@ static const char sysprm_ha_conf_file_name[] = "cubrid_ha.conf";
 
 #define PRM_NAME_GROUP_COMPLETE_DEBUG "group_complete_debug"
 
+#define PRM_NAME_SORT_PARALLEL_DEGREE "sort_parallel_degree"
+
+#define PRM_NAME_RECOVERY_REDO_PARALLEL_COUNT "recovery_redo_parallel_count"
+
+#define PRM_NAME_OPTIMIZER_ENABLE_HASH_JOIN "optimizer_enable_hash_join"
+
+#define PRM_NAME_MAX_HASH_JOIN_SIZE "max_hash_join_size"
+
+#define PRM_NAME_STATS_SAMPLING_PAGES "stats_sampling_pages"
+
+#define PRM_NAME_PB_READ_AHEAD_PAGES "data_buffer_read_ahead_pages"
+
+#define PRM_NAME_PARALLEL_SCAN_DEGREE "parallel_scan_degree"
+
+#define PRM_NAME_VECTORIZED_SCAN "vectorized_scan"
+
+#define PRM_NAME_IO_BACKEND "io_backend"
+
+#define PRM_NAME_IO_QUEUE_DEPTH "io_queue_depth"
+
+#define PRM_NAME_PB_WARMUP "data_buffer_warmup"
+
+#define PRM_NAME_PB_WARMUP_RATE "data_buffer_warmup_rate"
+
+#define PRM_NAME_PB_WARMUP_SAVE_INTERVAL "data_buffer_warmup_save_interval_in_secs"
+
+#define PRM_NAME_PB_OPTIMISTIC_FIX "data_buffer_optimistic_fix"
+
+#define PRM_NAME_MAX_HASH_SET_OP_SIZE "max_hash_set_op_size"
+
+#define PRM_NAME_XASL_CACHE_PERSIST "xasl_cache_persist"
+
+#define PRM_NAME_BTREE_INSERT_BUFFER_SIZE "btree_insert_buffer_size"
+
+#define PRM_NAME_LK_FASTPATH "lock_fastpath"
+
+#define PRM_NAME_CSS_IO_THREADS "connection_io_threads"
+
+#define PRM_NAME_THREAD_WORKER_STEALING "thread_worker_stealing"
+
+#define PRM_NAME_REPL_STREAM_COMPRESSION "replication_stream_compression"
+
+#define PRM_NAME_REPL_STREAM_FILE_COMPRESSION "replication_stream_file_compression"
+
 #define PRM_VALUE_DEFAULT "DEFAULT"
 #define PRM_VALUE_MAX "MAX"
 #define PRM_VALUE_MIN "MIN"
@@ -2276,6 +2321,124 @@ bool PRM_GROUP_COMPLETE_DEBUG = false;
 static bool prm_group_complete_debug_default = true;	/* TODO - false, after stabilizing group complete issues. */
 static unsigned int prm_group_complete_debug_flag = false;
 
+int PRM_SORT_PARALLEL_DEGREE = 4;
+static int prm_sort_parallel_degree_default = 4;
+static int prm_sort_parallel_degree_upper = 64;
+static int prm_sort_parallel_degree_lower = 1;
+static unsigned int prm_sort_parallel_degree_flag = 0;
+
+int PRM_RECOVERY_REDO_PARALLEL_COUNT = 0;
+static int prm_recovery_redo_parallel_count_default = 0;
+static int prm_recovery_redo_parallel_count_upper = 64;
+static int prm_recovery_redo_parallel_count_lower = 0;
+static unsigned int prm_recovery_redo_parallel_count_flag = 0;
+
+bool PRM_OPTIMIZER_ENABLE_HASH_JOIN = false;
+static bool prm_optimizer_enable_hash_join_default = false;
+static unsigned int prm_optimizer_enable_hash_join_flag = 0;
+
+UINT64 PRM_MAX_HASH_JOIN_SIZE = 8 * 1024 * 1024;
+static UINT64 prm_max_hash_join_size_default = 8 * 1024 * 1024;
+static UINT64 prm_max_hash_join_size_upper = 1024 * 1024 * 1024;
+static UINT64 prm_max_hash_join_size_lower = 32 * 1024;
+static unsigned int prm_max_hash_join_size_flag = 0;
+
+int PRM_STATS_SAMPLING_PAGES = 1024;
+static int prm_stats_sampling_pages_default = 1024;
+static int prm_stats_sampling_pages_upper = 65536;
+static int prm_stats_sampling_pages_lower = 16;
+static unsigned int prm_stats_sampling_pages_flag = 0;
+
+int PRM_PB_READ_AHEAD_PAGES = 32;
+static int prm_pb_read_ahead_pages_default = 32;
+static int prm_pb_read_ahead_pages_upper = 64;
+static int prm_pb_read_ahead_pages_lower = 0;
+static unsigned int prm_pb_read_ahead_pages_flag = 0;
+
+int PRM_PARALLEL_SCAN_DEGREE = 4;
+static int prm_parallel_scan_degree_default = 4;
+static int prm_parallel_scan_degree_upper = 64;
+static int prm_parallel_scan_degree_lower = 1;
+static unsigned int prm_parallel_scan_degree_flag = 0;
+
+bool PRM_VECTORIZED_SCAN = true;
+static bool prm_vectorized_scan_default = true;
+static unsigned int prm_vectorized_scan_flag = 0;
+
+int PRM_IO_BACKEND = IO_BACKEND_PREAD;
+static int prm_io_backend_default = IO_BACKEND_PREAD;
+static int prm_io_backend_upper = IO_BACKEND_IO_URING;
+static int prm_io_backend_lower = IO_BACKEND_PREAD;
+static unsigned int prm_io_backend_flag = 0;
+
+int PRM_IO_QUEUE_DEPTH = 64;
+static int prm_io_queue_depth_default = 64;
+static int prm_io_queue_depth_upper = 1024;
+static int prm_io_queue_depth_lower = 1;
+static unsigned int prm_io_queue_depth_flag = 0;
+
+bool PRM_PB_WARMUP = true;
+static bool prm_pb_warmup_default = true;
+static unsigned int prm_pb_warmup_flag = 0;
+
+int PRM_PB_WARMUP_RATE = 10000;
+static int prm_pb_warmup_rate_default = 10000;
+static int prm_pb_warmup_rate_upper = 1000000;
+static int prm_pb_warmup_rate_lower = 1;
+static unsigned int prm_pb_warmup_rate_flag = 0;
+
+int PRM_PB_WARMUP_SAVE_INTERVAL = 0;
+static int prm_pb_warmup_save_interval_default = 0;
+static int prm_pb_warmup_save_interval_upper = 86400;
+static int prm_pb_warmup_save_interval_lower = 0;
+static unsigned int prm_pb_warmup_save_interval_flag = 0;
+
+bool PRM_PB_OPTIMISTIC_FIX = true;
+static bool prm_pb_optimistic_fix_default = true;
+static unsigned int prm_pb_optimistic_fix_flag = 0;
+
+UINT64 PRM_MAX_HASH_SET_OP_SIZE = 8 * 1024 * 1024;
+static UINT64 prm_max_hash_set_op_size_default = 8 * 1024 * 1024;
+static UINT64 prm_max_hash_set_op_size_upper = 1024 * 1024 * 1024;
+static UINT64 prm_max_hash_set_op_size_lower = 0;
+static unsigned int prm_max_hash_set_op_size_flag = 0;
+
+bool PRM_XASL_CACHE_PERSIST = false;
+static bool prm_xasl_cache_persist_default = false;
+static unsigned int prm_xasl_cache_persist_flag = 0;
+
+int PRM_BTREE_INSERT_BUFFER_SIZE = 100000;
+static int prm_btree_insert_buffer_size_default = 100000;
+static int prm_btree_insert_buffer_size_upper = 10000000;
+static int prm_btree_insert_buffer_size_lower = 0;
+static unsigned int prm_btree_insert_buffer_size_flag = 0;
+
+bool PRM_LK_FASTPATH = true;
+static bool prm_lk_fastpath_default = true;
+static unsigned int prm_lk_fastpath_flag = 0;
+
+int PRM_CSS_IO_THREADS = 4;
+static int prm_css_io_threads_default = 4;
+static int prm_css_io_threads_upper = 16;
+static int prm_css_io_threads_lower = 0;
+static unsigned int prm_css_io_threads_flag = 0;
+
+bool PRM_THREAD_WORKER_STEALING = true;
+static bool prm_thread_worker_stealing_default = true;
+static unsigned int prm_thread_worker_stealing_flag = 0;
+
+int PRM_REPL_STREAM_COMPRESSION = cubstream::COMPRESSION_NONE;
+static int prm_repl_stream_compression_default = cubstream::COMPRESSION_NONE;
+static int prm_repl_stream_compression_upper = cubstream::COMPRESSION_LZO1X_999;
+static int prm_repl_stream_compression_lower = cubstream::COMPRESSION_NONE;
+static unsigned int prm_repl_stream_compression_flag = 0;
+
+int PRM_REPL_STREAM_FILE_COMPRESSION = cubstream::COMPRESSION_NONE;
+static int prm_repl_stream_file_compression_default = cubstream::COMPRESSION_NONE;
+static int prm_repl_stream_file_compression_upper = cubstream::COMPRESSION_LZO1X_999;
+static int prm_repl_stream_file_compression_lower = cubstream::COMPRESSION_NONE;
+static unsigned int prm_repl_stream_file_compression_flag = 0;
+
 typedef int (*DUP_PRM_FUNC) (void *, SYSPRM_DATATYPE, void *, SYSPRM_DATATYPE);
 
 static int prm_size_to_io_pages (void *out_val, SYSPRM_DATATYPE out_type, void *in_val, SYSPRM_DATATYPE in_type);
@@ -5853,6 +6016,270 @@ static SYSPRM_PARAM prm_Def[] = {
    (void *) NULL, (void *) NULL,
    (char *) NULL,
    (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_SORT_PARALLEL_DEGREE,
+   PRM_NAME_SORT_PARALLEL_DEGREE,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE | PRM_FOR_SESSION | PRM_FOR_CLIENT),
+   PRM_INTEGER,
+   &prm_sort_parallel_degree_flag,
+   (void *) &prm_sort_parallel_degree_default,
+   (void *) &PRM_SORT_PARALLEL_DEGREE,
+   (void *) &prm_sort_parallel_degree_upper,
+   (void *) &prm_sort_parallel_degree_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_RECOVERY_REDO_PARALLEL_COUNT,
+   PRM_NAME_RECOVERY_REDO_PARALLEL_COUNT,
+   (PRM_FOR_SERVER),
+   PRM_INTEGER,
+   &prm_recovery_redo_parallel_count_flag,
+   (void *) &prm_recovery_redo_parallel_count_default,
+   (void *) &PRM_RECOVERY_REDO_PARALLEL_COUNT,
+   (void *) &prm_recovery_redo_parallel_count_upper,
+   (void *) &prm_recovery_redo_parallel_count_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_OPTIMIZER_ENABLE_HASH_JOIN,
+   PRM_NAME_OPTIMIZER_ENABLE_HASH_JOIN,
+   (PRM_FOR_CLIENT | PRM_USER_CHANGE),
+   PRM_BOOLEAN,
+   &prm_optimizer_enable_hash_join_flag,
+   (void *) &prm_optimizer_enable_hash_join_default,
+   (void *) &PRM_OPTIMIZER_ENABLE_HASH_JOIN,
+   (void *) NULL,
+   (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_MAX_HASH_JOIN_SIZE,
+   PRM_NAME_MAX_HASH_JOIN_SIZE,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE | PRM_SIZE_UNIT),
+   PRM_BIGINT,
+   &prm_max_hash_join_size_flag,
+   (void *) &prm_max_hash_join_size_default,
+   (void *) &PRM_MAX_HASH_JOIN_SIZE,
+   (void *) &prm_max_hash_join_size_upper,
+   (void *) &prm_max_hash_join_size_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_STATS_SAMPLING_PAGES,
+   PRM_NAME_STATS_SAMPLING_PAGES,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_stats_sampling_pages_flag,
+   (void *) &prm_stats_sampling_pages_default,
+   (void *) &PRM_STATS_SAMPLING_PAGES,
+   (void *) &prm_stats_sampling_pages_upper,
+   (void *) &prm_stats_sampling_pages_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_PB_READ_AHEAD_PAGES,
+   PRM_NAME_PB_READ_AHEAD_PAGES,
+   (PRM_USER_CHANGE | PRM_FOR_SERVER),
+   PRM_INTEGER,
+   &prm_pb_read_ahead_pages_flag,
+   (void *) &prm_pb_read_ahead_pages_default,
+   (void *) &PRM_PB_READ_AHEAD_PAGES,
+   (void *) &prm_pb_read_ahead_pages_upper,
+   (void *) &prm_pb_read_ahead_pages_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_PARALLEL_SCAN_DEGREE,
+   PRM_NAME_PARALLEL_SCAN_DEGREE,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE | PRM_FOR_SESSION | PRM_FOR_CLIENT),
+   PRM_INTEGER,
+   &prm_parallel_scan_degree_flag,
+   (void *) &prm_parallel_scan_degree_default,
+   (void *) &PRM_PARALLEL_SCAN_DEGREE,
+   (void *) &prm_parallel_scan_degree_upper,
+   (void *) &prm_parallel_scan_degree_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_VECTORIZED_SCAN,
+   PRM_NAME_VECTORIZED_SCAN,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE | PRM_FOR_SESSION | PRM_FOR_CLIENT),
+   PRM_BOOLEAN,
+   &prm_vectorized_scan_flag,
+   (void *) &prm_vectorized_scan_default,
+   (void *) &PRM_VECTORIZED_SCAN,
+   (void *) NULL,
+   (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_IO_BACKEND,
+   PRM_NAME_IO_BACKEND,
+   (PRM_FOR_SERVER),
+   PRM_KEYWORD,
+   &prm_io_backend_flag,
+   (void *) &prm_io_backend_default,
+   (void *) &PRM_IO_BACKEND,
+   (void *) &prm_io_backend_upper,
+   (void *) &prm_io_backend_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_IO_QUEUE_DEPTH,
+   PRM_NAME_IO_QUEUE_DEPTH,
+   (PRM_FOR_SERVER),
+   PRM_INTEGER,
+   &prm_io_queue_depth_flag,
+   (void *) &prm_io_queue_depth_default,
+   (void *) &PRM_IO_QUEUE_DEPTH,
+   (void *) &prm_io_queue_depth_upper,
+   (void *) &prm_io_queue_depth_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_PB_WARMUP,
+   PRM_NAME_PB_WARMUP,
+   (PRM_FOR_SERVER),
+   PRM_BOOLEAN,
+   &prm_pb_warmup_flag,
+   (void *) &prm_pb_warmup_default,
+   (void *) &PRM_PB_WARMUP,
+   (void *) NULL,
+   (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_PB_WARMUP_RATE,
+   PRM_NAME_PB_WARMUP_RATE,
+   (PRM_USER_CHANGE | PRM_FOR_SERVER),
+   PRM_INTEGER,
+   &prm_pb_warmup_rate_flag,
+   (void *) &prm_pb_warmup_rate_default,
+   (void *) &PRM_PB_WARMUP_RATE,
+   (void *) &prm_pb_warmup_rate_upper,
+   (void *) &prm_pb_warmup_rate_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_PB_WARMUP_SAVE_INTERVAL,
+   PRM_NAME_PB_WARMUP_SAVE_INTERVAL,
+   (PRM_USER_CHANGE | PRM_FOR_SERVER),
+   PRM_INTEGER,
+   &prm_pb_warmup_save_interval_flag,
+   (void *) &prm_pb_warmup_save_interval_default,
+   (void *) &PRM_PB_WARMUP_SAVE_INTERVAL,
+   (void *) &prm_pb_warmup_save_interval_upper,
+   (void *) &prm_pb_warmup_save_interval_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_PB_OPTIMISTIC_FIX,
+   PRM_NAME_PB_OPTIMISTIC_FIX,
+   ((PRM_FOR_SERVER | PRM_HIDDEN)),
+   PRM_BOOLEAN,
+   &prm_pb_optimistic_fix_flag,
+   (void *) &prm_pb_optimistic_fix_default,
+   (void *) &PRM_PB_OPTIMISTIC_FIX,
+   (void *) NULL,
+   (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_MAX_HASH_SET_OP_SIZE,
+   PRM_NAME_MAX_HASH_SET_OP_SIZE,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE | PRM_SIZE_UNIT),
+   PRM_BIGINT,
+   &prm_max_hash_set_op_size_flag,
+   (void *) &prm_max_hash_set_op_size_default,
+   (void *) &PRM_MAX_HASH_SET_OP_SIZE,
+   (void *) &prm_max_hash_set_op_size_upper,
+   (void *) &prm_max_hash_set_op_size_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_XASL_CACHE_PERSIST,
+   PRM_NAME_XASL_CACHE_PERSIST,
+   (PRM_FOR_SERVER),
+   PRM_BOOLEAN,
+   &prm_xasl_cache_persist_flag,
+   (void *) &prm_xasl_cache_persist_default,
+   (void *) &PRM_XASL_CACHE_PERSIST,
+   (void *) NULL,
+   (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_BTREE_INSERT_BUFFER_SIZE,
+   PRM_NAME_BTREE_INSERT_BUFFER_SIZE,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_btree_insert_buffer_size_flag,
+   (void *) &prm_btree_insert_buffer_size_default,
+   (void *) &PRM_BTREE_INSERT_BUFFER_SIZE,
+   (void *) &prm_btree_insert_buffer_size_upper,
+   (void *) &prm_btree_insert_buffer_size_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_LK_FASTPATH,
+   PRM_NAME_LK_FASTPATH,
+   (PRM_FOR_SERVER | PRM_HIDDEN),
+   PRM_BOOLEAN,
+   &prm_lk_fastpath_flag,
+   (void *) &prm_lk_fastpath_default,
+   (void *) &PRM_LK_FASTPATH,
+   (void *) NULL,
+   (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_CSS_IO_THREADS,
+   PRM_NAME_CSS_IO_THREADS,
+   (PRM_FOR_SERVER),
+   PRM_INTEGER,
+   &prm_css_io_threads_flag,
+   (void *) &prm_css_io_threads_default,
+   (void *) &PRM_CSS_IO_THREADS,
+   (void *) &prm_css_io_threads_upper,
+   (void *) &prm_css_io_threads_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_THREAD_WORKER_STEALING,
+   PRM_NAME_THREAD_WORKER_STEALING,
+   (PRM_FOR_SERVER | PRM_HIDDEN),
+   PRM_BOOLEAN,
+   &prm_thread_worker_stealing_flag,
+   (void *) &prm_thread_worker_stealing_default,
+   (void *) &PRM_THREAD_WORKER_STEALING,
+   (void *) NULL,
+   (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_REPL_STREAM_COMPRESSION,
+   PRM_NAME_REPL_STREAM_COMPRESSION,
+   (PRM_FOR_SERVER),
+   PRM_KEYWORD,
+   &prm_repl_stream_compression_flag,
+   (void *) &prm_repl_stream_compression_default,
+   (void *) &PRM_REPL_STREAM_COMPRESSION,
+   (void *) &prm_repl_stream_compression_upper,
+   (void *) &prm_repl_stream_compression_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_REPL_STREAM_FILE_COMPRESSION,
+   PRM_NAME_REPL_STREAM_FILE_COMPRESSION,
+   (PRM_FOR_SERVER),
+   PRM_KEYWORD,
+   &prm_repl_stream_file_compression_flag,
+   (void *) &prm_repl_stream_file_compression_default,
+   (void *) &PRM_REPL_STREAM_FILE_COMPRESSION,
+   (void *) &prm_repl_stream_file_compression_upper,
+   (void *) &prm_repl_stream_file_compression_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
    (DUP_PRM_FUNC) NULL}
 };
 
@@ -6011,6 +6438,11 @@ static KEYVAL query_trace_format_words[] = {
   {"json", QUERY_TRACE_JSON},
 };
 
+static KEYVAL io_backend_words[] = {
+  {"pread", IO_BACKEND_PREAD},
+  {"io_uring", IO_BACKEND_IO_URING},
+};
+
 static KEYVAL fi_test_words[] = {
   {"recovery", FI_GROUP_RECOVERY},
 };
@@ -6026,6 +6458,12 @@ static KEYVAL ha_repl_semisync_ack_mode_words[] = {
   {"on_receive", cubreplication::REPL_SEMISYNC_ACK_ON_CONSUME},
   {"on_flush", cubreplication::REPL_SEMISYNC_ACK_ON_FLUSH}
 };
+
+static KEYVAL repl_stream_compression_words[] = {
+  {"none", cubstream::COMPRESSION_NONE},
+  {"lzo1x_1", cubstream::COMPRESSION_LZO1X_1},
+  {"lzo1x_999", cubstream::COMPRESSION_LZO1X_999}
+};
 /* *INDENT-ON* */
 
 static const char *compat_mode_values_PRM_ANSI_QUOTES[COMPAT_ORACLE + 2] = {
@@ -7956,6 +8394,10 @@ prm_print (const SYSPRM_PARAM * prm, char *buf, size_t len, PRM_PRINT_MODE print
 	  keyvalp =
 	    prm_keyword (PRM_GET_INT (prm_value), NULL, query_trace_format_words, DIM (query_trace_format_words));
 	}
+      else if (intl_mbs_casecmp (prm->name, PRM_NAME_IO_BACKEND) == 0)
+	{
+	  keyvalp = prm_keyword (PRM_GET_INT (prm_value), NULL, io_backend_words, DIM (io_backend_words));
+	}
       else if (intl_mbs_casecmp (prm->name, PRM_NAME_FAULT_INJECTION_TEST) == 0)
 	{
 	  keyvalp = prm_keyword (PRM_GET_INT (prm_value), NULL, fi_test_words, DIM (fi_test_words));
@@ -7971,6 +8413,13 @@ prm_print (const SYSPRM_PARAM * prm, char *buf, size_t len, PRM_PRINT_MODE print
 	    prm_keyword (PRM_GET_INT (prm_value), NULL, ha_repl_semisync_ack_mode_words,
 			 DIM (ha_repl_semisync_ack_mode_words));
 	}
+      else if (intl_mbs_casecmp (prm->name, PRM_NAME_REPL_STREAM_COMPRESSION) == 0
+	       || intl_mbs_casecmp (prm->name, PRM_NAME_REPL_STREAM_FILE_COMPRESSION) == 0)
+	{
+	  keyvalp =
+	    prm_keyword (PRM_GET_INT (prm_value), NULL, repl_stream_compression_words,
+			 DIM (repl_stream_compression_words));
+	}
       else
 	{
 	  assert (false);
@@ -8259,6 +8708,10 @@ sysprm_print_sysprm_value (PARAM_ID prm_id, SYSPRM_VALUE value, char *buf, size_
 	{
 	  keyvalp = prm_keyword (value.i, NULL, query_trace_format_words, DIM (query_trace_format_words));
 	}
+      else if (intl_mbs_casecmp (prm->name, PRM_NAME_IO_BACKEND) == 0)
+	{
+	  keyvalp = prm_keyword (value.i, NULL, io_backend_words, DIM (io_backend_words));
+	}
       else if (intl_mbs_casecmp (prm->name, PRM_NAME_FAULT_INJECTION_TEST) == 0)
 	{
 	  keyvalp = prm_keyword (value.i, NULL, fi_test_words, DIM (fi_test_words));
@@ -8271,6 +8724,11 @@ sysprm_print_sysprm_value (PARAM_ID prm_id, SYSPRM_VALUE value, char *buf, size_
 	{
 	  keyvalp = prm_keyword (value.i, NULL, ha_repl_semisync_ack_mode_words, DIM (ha_repl_semisync_ack_mode_words));
 	}
+      else if (intl_mbs_casecmp (prm->name, PRM_NAME_REPL_STREAM_COMPRESSION) == 0
+	       || intl_mbs_casecmp (prm->name, PRM_NAME_REPL_STREAM_FILE_COMPRESSION) == 0)
+	{
+	  keyvalp = prm_keyword (value.i, NULL, repl_stream_compression_words, DIM (repl_stream_compression_words));
+	}
       else
 	{
 	  assert (false);
@@ -9466,6 +9924,10 @@ sysprm_generate_new_value (SYSPRM_PARAM * prm, const char *value, bool check, SY
 	  {
 	    keyvalp = prm_keyword (-1, value, query_trace_format_words, DIM (query_trace_format_words));
 	  }
+	else if (intl_mbs_casecmp (prm->name, PRM_NAME_IO_BACKEND) == 0)
+	  {
+	    keyvalp = prm_keyword (-1, value, io_backend_words, DIM (io_backend_words));
+	  }
 	else if (intl_mbs_casecmp (prm->name, PRM_NAME_FAULT_INJECTION_TEST) == 0)
 	  {
 	    keyvalp = prm_keyword (-1, value, fi_test_words, DIM (fi_test_words));
@@ -9478,6 +9940,11 @@ sysprm_generate_new_value (SYSPRM_PARAM * prm, const char *value, bool check, SY
 	  {
 	    keyvalp = prm_keyword (-1, value, ha_repl_semisync_ack_mode_words, DIM (ha_repl_semisync_ack_mode_words));
 	  }
+	else if (intl_mbs_casecmp (prm->name, PRM_NAME_REPL_STREAM_COMPRESSION) == 0
+		 || intl_mbs_casecmp (prm->name, PRM_NAME_REPL_STREAM_FILE_COMPRESSION) == 0)
+	  {
+	    keyvalp = prm_keyword (-1, value, repl_stream_compression_words, DIM (repl_stream_compression_words));
+	  }
 	else
 	  {
 	    assert (false);
@@ -86,6 +86,13 @@ enum query_trace_format
 };
 typedef enum query_trace_format QUERY_TRACE_FORMAT;
 
+enum io_backend
+{
+  IO_BACKEND_PREAD,
+  IO_BACKEND_IO_URING
+};
+typedef enum io_backend IO_BACKEND;
+
 /* NOTE:
  * System parameter ids must respect the order in prm_Def array
  */
@@ -442,8 +449,31 @@ enum param_id
   PRM_ID_REPL_SEMISYNC_ACK_MODE,
   PRM_ID_GROUP_COMPLETE_DEBUG,
 
+  PRM_ID_SORT_PARALLEL_DEGREE,
+  PRM_ID_RECOVERY_REDO_PARALLEL_COUNT,
+  PRM_ID_OPTIMIZER_ENABLE_HASH_JOIN,
+  PRM_ID_MAX_HASH_JOIN_SIZE,
+  PRM_ID_STATS_SAMPLING_PAGES,
+  PRM_ID_PB_READ_AHEAD_PAGES,
+  PRM_ID_PARALLEL_SCAN_DEGREE,
+  PRM_ID_VECTORIZED_SCAN,
+  PRM_ID_IO_BACKEND,
+  PRM_ID_IO_QUEUE_DEPTH,
+  PRM_ID_PB_WARMUP,
+  PRM_ID_PB_WARMUP_RATE,
+  PRM_ID_PB_WARMUP_SAVE_INTERVAL,
+  PRM_ID_PB_OPTIMISTIC_FIX,
+  PRM_ID_MAX_HASH_SET_OP_SIZE,
+  PRM_ID_XASL_CACHE_PERSIST,
+  PRM_ID_BTREE_INSERT_BUFFER_SIZE,
+  PRM_ID_LK_FASTPATH,
+  PRM_ID_CSS_IO_THREADS,
+  PRM_ID_THREAD_WORKER_STEALING,
+  PRM_ID_REPL_STREAM_COMPRESSION,
+  PRM_ID_REPL_STREAM_FILE_COMPRESSION,
+
   /* change PRM_LAST_ID when adding new system parameters */
-  PRM_LAST_ID = PRM_ID_GROUP_COMPLETE_DEBUG
+  PRM_LAST_ID = PRM_ID_REPL_STREAM_FILE_COMPRESSION
 };
 typedef enum param_id PARAM_ID;
 
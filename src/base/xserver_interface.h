@@ -96,7 +96,7 @@ extern int xlocator_get_class (THREAD_ENTRY * thread_p, OID * class_oid, int cla
 			       int prefetching, LC_COPYAREA ** fetch_area);
 extern int xlocator_fetch_all (THREAD_ENTRY * thread_p, const HFID * hfid, LOCK * lock,
 			       LC_FETCH_VERSION_TYPE fetch_type, OID * class_oid, int *nobjects, int *nfetched,
-			       OID * last_oid, LC_COPYAREA ** fetch_area);
+			       OID * last_oid, LC_COPYAREA ** fetch_area, const VPID * page_set, int n_page_set);
 extern int xlocator_lock_and_fetch_all (THREAD_ENTRY * thread_p, const HFID * hfid, LOCK * instance_lock,
 					int *instance_lock_timeout, OID * class_oid, LOCK * class_lock, int *nobjects,
 					int *nfetched, int *nfailed_instance_locks, OID * last_oid,
@@ -217,8 +217,12 @@ extern QFILE_LIST_ID *xqmgr_execute_query (THREAD_ENTRY * thrd, const XASL_ID *
 extern QFILE_LIST_ID *xqmgr_prepare_and_execute_query (THREAD_ENTRY * thrd, char *xasl_stream, int xasl_stream_size,
 						       QUERY_ID * query_id, int dbval_cnt, void *data,
 						       QUERY_FLAG * flag, int query_timeout);
+extern int xqmgr_execute_query_array (THREAD_ENTRY * thread_p, const XASL_ID * xasl_id, int n_rows, int dbval_count,
+				      void **row_data, QUERY_FLAG flag, int query_timeout, int *row_results,
+				      char **row_messages);
 extern int xqmgr_end_query (THREAD_ENTRY * thrd, QUERY_ID query_id);
 extern int xqmgr_drop_all_query_plans (THREAD_ENTRY * thread_p);
+extern int xqmgr_save_all_query_plans (THREAD_ENTRY * thread_p);
 extern void xqmgr_dump_query_plans (THREAD_ENTRY * thread_p, FILE * outfp);
 extern void xqmgr_dump_query_cache (THREAD_ENTRY * thread_p, FILE * outfp);
 
@@ -258,6 +258,13 @@ static char *consume_tokens (char *stmt, STATEMENT_STATUS stmt_status);
 static char get_stmt_type (char *stmt);
 static int execute_info_set (T_SRV_HANDLE * srv_handle, T_NET_BUF * net_buf, T_BROKER_VERSION client_version,
 			     char exec_flag);
+static int execute_array_on_server (T_SRV_HANDLE * srv_handle, DB_SESSION * session, int stmt_id,
+				    DB_VALUE * value_list, int num_rows, T_NET_BUF * net_buf,
+				    T_BROKER_VERSION client_version, int *num_done, bool * is_stopped);
+static int execute_batch_array_on_server (DB_SESSION * session, int stmt_id, int query_index, int argc, void **argv,
+					  T_NET_BUF * net_buf, T_BROKER_VERSION client_version, char auto_commit_mode,
+					  int *num_done, bool * is_stopped, DB_SESSION ** next_session,
+					  int *next_stmt_id);
 static char get_attr_type (DB_OBJECT * obj_p, char *attr_name);
 
 static char *get_domain_str (DB_DOMAIN * domain);
@@ -2004,6 +2011,10 @@ ux_execute_batch (int argc, void **argv, T_NET_BUF * net_buf, T_REQ_INFO * req_i
   DB_OBJECT *ins_obj_p;
   T_OBJECT ins_oid;
   T_BROKER_VERSION client_version = req_info->client_version;
+  DB_SESSION *next_session = NULL;
+  int next_stmt_id = -1;
+  int num_done;
+  bool is_stopped;
 
   net_buf_cp_int (net_buf, 0, NULL);	/* result code */
   net_buf_cp_int (net_buf, argc, &num_query_offset);	/* result msg. num_query */
@@ -2020,20 +2031,30 @@ ux_execute_batch (int argc, void **argv, T_NET_BUF * net_buf, T_REQ_INFO * req_i
 	  cas_log_write_query_string_nonl (sql_stmt, strlen (sql_stmt));
 	}
 
-      session = db_open_buffer (sql_stmt);
-      if (!session)
+      if (next_session != NULL)
 	{
-	  cas_log_write2 ("");
-	  goto batch_error;
+	  /* compiled while the entries of the previous array were looked for */
+	  session = next_session;
+	  stmt_id = next_stmt_id;
+	  next_session = NULL;
 	}
+      else
+	{
+	  session = db_open_buffer (sql_stmt);
+	  if (!session)
+	    {
+	      cas_log_write2 ("");
+	      goto batch_error;
+	    }
 
-      SQL_LOG2_COMPILE_BEGIN (as_info->cur_sql_log2, sql_stmt);
+	  SQL_LOG2_COMPILE_BEGIN (as_info->cur_sql_log2, sql_stmt);
 
-      stmt_id = db_compile_statement (session);
-      if (stmt_id < 0)
-	{
-	  cas_log_write2 ("");
-	  goto batch_error;
+	  stmt_id = db_compile_statement (session);
+	  if (stmt_id < 0)
+	    {
+	      cas_log_write2 ("");
+	      goto batch_error;
+	    }
 	}
 
       stmt_type = db_get_statement_type (session, stmt_id);
@@ -2043,6 +2064,30 @@ ux_execute_batch (int argc, void **argv, T_NET_BUF * net_buf, T_REQ_INFO * req_i
 	  goto batch_error;
 	}
 
+      if (stmt_type == CUBRID_STMT_INSERT && query_index + 1 < argc
+	  && db_can_execute_batch_array (session, stmt_id, session, stmt_id))
+	{
+	  err_code = execute_batch_array_on_server (session, stmt_id, query_index, argc, argv, net_buf, client_version,
+						    auto_commit_mode, &num_done, &is_stopped, &next_session,
+						    &next_stmt_id);
+	  if (err_code < 0)
+	    {
+	      goto execute_batch_error;
+	    }
+
+	  if (num_done > 0)
+	    {
+	      query_index += num_done - 1;
+	      if (is_stopped)
+		{
+		  net_buf_overwrite_int (net_buf, num_query_offset, query_index + 1);
+		  break;
+		}
+	      continue;
+	    }
+	  /* no entry that follows shares the plan; the entry is executed alone */
+	}
+
       SQL_LOG2_EXEC_BEGIN (as_info->cur_sql_log2, stmt_id);
       db_get_cacheinfo (session, stmt_id, &use_plan_cache, &use_query_cache);
       cas_log_write2_nonl (" %s\n", use_plan_cache ? "(PC)" : "");
@@ -2153,6 +2198,12 @@ ux_execute_batch (int argc, void **argv, T_NET_BUF * net_buf, T_REQ_INFO * req_i
 	}
     }
 
+  if (next_session != NULL)
+    {
+      /* the batch was interrupted */
+      db_close_session (next_session);
+    }
+
   if (DOES_CLIENT_UNDERSTAND_THE_PROTOCOL (client_version, PROTOCOL_V5))
     {
       net_buf_cp_int (net_buf, shm_shard_id, NULL);
@@ -2161,6 +2212,10 @@ ux_execute_batch (int argc, void **argv, T_NET_BUF * net_buf, T_REQ_INFO * req_i
   return 0;
 
 execute_batch_error:
+  if (next_session != NULL)
+    {
+      db_close_session (next_session);
+    }
   NET_BUF_ERR_SET (net_buf);
   errors_in_transaction++;
 
@@ -2242,6 +2297,30 @@ ux_execute_array (T_SRV_HANDLE * srv_handle, int argc, void **argv, T_NET_BUF *
 
   first_value = 0;
 
+  if (is_prepared == TRUE && num_bind >= num_markers && db_can_execute_array (session, stmt_id))
+    {
+      int num_rows = num_bind / num_markers;
+      int num_done;
+      bool is_stopped;
+
+      err_code = execute_array_on_server (srv_handle, session, stmt_id, value_list, num_rows, net_buf,
+					  client_version, &num_done, &is_stopped);
+      if (err_code < 0)
+	{
+	  goto execute_array_error;
+	}
+
+      num_query += num_done;
+      num_bind -= num_done * num_markers;
+      first_value += num_done * num_markers;
+      if (is_stopped)
+	{
+	  /* interrupted; like the execution of each row, stop the array */
+	  num_bind = 0;
+	}
+      /* left rows, if any, are executed one by one; e.g. the statement must be recompiled */
+    }
+
   while (num_bind >= num_markers)
     {
       num_query++;
@@ -2443,6 +2522,427 @@ execute_array_error:
   return err_code;
 }
 
+/*
+ * execute_array_on_server () - execute the prepared INSERT for the rows of an array in one request to the server
+ *   return: 0, or error code if the array cannot go on
+ *   srv_handle(in):
+ *   session(in): session of the prepared statement
+ *   stmt_id(in):
+ *   value_list(in): bind values of the rows
+ *   num_rows(in): number of rows
+ *   net_buf(in/out): the result of each done row is appended, like the execution of each row would
+ *   client_version(in):
+ *   num_done(out): number of rows done; the rows from num_done on are left to the execution of each row
+ *   is_stopped(out): true if the rest of the array must not be executed
+ *
+ * Note: Each row is executed as a statement by the server; an error undoes the row and the next row is executed.
+ *	 In auto-commit mode, the rows are committed together when the array ends.
+ */
+static int
+execute_array_on_server (T_SRV_HANDLE * srv_handle, DB_SESSION * session, int stmt_id, DB_VALUE * value_list,
+			 int num_rows, T_NET_BUF * net_buf, T_BROKER_VERSION client_version, int *num_done,
+			 bool * is_stopped)
+{
+  int *row_results = NULL;
+  char **row_messages = NULL;
+  int num_executed = 0;
+  int err_code;
+  int stop_err_code = NO_ERROR;
+  char *stop_err_msg = NULL;
+  bool is_aborted = false;
+  T_OBJECT ins_oid;
+  int i;
+
+  *num_done = 0;
+  *is_stopped = false;
+
+  row_results = (int *) MALLOC (sizeof (int) * num_rows);
+  row_messages = (char **) MALLOC (sizeof (char *) * num_rows);
+  if (row_results == NULL || row_messages == NULL)
+    {
+      err_code = ERROR_INFO_SET (CAS_ER_NO_MORE_MEMORY, CAS_ERROR_INDICATOR);
+      goto end;
+    }
+
+#if !defined (LIBCAS_FOR_JSP) && !defined(CAS_FOR_ORACLE) && !defined(CAS_FOR_MYSQL)
+  err_code = db_set_statement_auto_commit (session, srv_handle->auto_commit_mode);
+  if (err_code != NO_ERROR)
+    {
+      err_code = ERROR_INFO_SET (err_code, DBMS_ERROR_INDICATOR);
+      goto end;
+    }
+#endif /* !LIBCAS_FOR_JSP && !CAS_FOR_ORACLE && !CAS_FOR_MYSQL */
+
+  SQL_LOG2_EXEC_BEGIN (as_info->cur_sql_log2, stmt_id);
+  err_code = db_execute_array (session, stmt_id, num_rows, value_list, row_results, row_messages, &num_executed);
+  SQL_LOG2_EXEC_END (as_info->cur_sql_log2, stmt_id, num_executed);
+
+  if (num_executed < num_rows)
+    {
+      stop_err_code = db_error_code ();
+      if (stop_err_code >= 0)
+	{
+	  stop_err_code = err_code;
+	}
+      is_aborted = ER_IS_ABORTED_DUE_TO_DEADLOCK (stop_err_code) || ER_IS_SERVER_DOWN_ERROR (stop_err_code);
+
+      if (is_aborted && srv_handle->auto_commit_mode == FALSE)
+	{
+	  err_code = ERROR_INFO_SET (stop_err_code, DBMS_ERROR_INDICATOR);
+	  goto end;
+	}
+      stop_err_msg = (char *) db_error_string (1);
+    }
+  err_code = 0;
+
+  db_get_cacheinfo (session, stmt_id, &srv_handle->use_plan_cache, &srv_handle->use_query_cache);
+
+  memset (&ins_oid, 0, sizeof (T_OBJECT));
+  for (i = 0; i < num_executed; i++)
+    {
+#ifndef LIBCAS_FOR_JSP
+      update_query_execution_count (as_info, CUBRID_STMT_INSERT);
+#endif /* LIBCAS_FOR_JSP */
+
+      if (is_aborted)
+	{
+	  /* the transaction of the array was rolled back; so was the row */
+	  row_results[i] = stop_err_code;
+	}
+
+      if (row_results[i] >= 0)
+	{
+	  net_buf_cp_int (net_buf, row_results[i], NULL);
+	  net_buf_cp_object (net_buf, &ins_oid);
+	}
+      else
+	{
+	  const char *err_msg = is_aborted ? stop_err_msg : (row_messages[i] != NULL ? row_messages[i] : "");
+
+	  if (DOES_CLIENT_UNDERSTAND_THE_PROTOCOL (client_version, PROTOCOL_V3))
+	    {
+	      net_buf_cp_int (net_buf, DBMS_ERROR_INDICATOR, NULL);
+	    }
+	  net_buf_cp_int (net_buf, row_results[i], NULL);
+	  net_buf_cp_int (net_buf, strlen (err_msg) + 1, NULL);
+	  net_buf_cp_str (net_buf, err_msg, strlen (err_msg) + 1);
+	  errors_in_transaction++;
+	}
+    }
+  *num_done = num_executed;
+
+  if (num_executed < num_rows && stop_err_code != ER_QPROC_XASLNODE_RECOMPILE_REQUESTED
+      && stop_err_code != ER_QPROC_INVALID_XASLNODE)
+    {
+      /* the row that stopped the array failed; the rows after it are executed one by one, unless interrupted */
+#ifndef LIBCAS_FOR_JSP
+      update_query_execution_count (as_info, CUBRID_STMT_INSERT);
+#endif /* LIBCAS_FOR_JSP */
+
+      if (DOES_CLIENT_UNDERSTAND_THE_PROTOCOL (client_version, PROTOCOL_V3))
+	{
+	  net_buf_cp_int (net_buf, DBMS_ERROR_INDICATOR, NULL);
+	}
+      net_buf_cp_int (net_buf, stop_err_code, NULL);
+      net_buf_cp_int (net_buf, strlen (stop_err_msg) + 1, NULL);
+      net_buf_cp_str (net_buf, stop_err_msg, strlen (stop_err_msg) + 1);
+      errors_in_transaction++;
+
+      (*num_done)++;
+      *is_stopped = (stop_err_code == ER_INTERRUPTED);
+    }
+
+  if (srv_handle->auto_commit_mode == TRUE)
+    {
+      if (is_aborted)
+	{
+	  db_abort_transaction ();
+	}
+      else
+	{
+	  db_commit_transaction ();
+	}
+    }
+
+end:
+  if (row_messages != NULL)
+    {
+      for (i = 0; i < num_executed; i++)
+	{
+	  if (row_messages[i] != NULL)
+	    {
+	      free (row_messages[i]);
+	    }
+	}
+      FREE_MEM (row_messages);
+    }
+  if (row_results != NULL)
+    {
+      FREE_MEM (row_results);
+    }
+
+  return err_code;
+}
+
+/*
+ * execute_batch_array_on_server () - execute the entries of a batch that share the prepared INSERT of an entry in one
+ *				      request to the server
+ *   return: 0, or error code if the batch cannot go on
+ *   session(in): the compiled entry the array starts with
+ *   stmt_id(in):
+ *   query_index(in): index of the entry in the batch
+ *   argc(in): number of entries in the batch
+ *   argv(in): SQL texts of the entries
+ *   net_buf(in/out): the result of each done entry is appended, like the execution of each entry would
+ *   client_version(in):
+ *   auto_commit_mode(in):
+ *   num_done(out): number of entries done from query_index on; 0 if nothing was executed, the entry is then left to
+ *		    the caller
+ *   is_stopped(out): true if the rest of the batch must not be executed
+ *   next_session(out): the entry that follows the done entries, if it was compiled while the array was looked for
+ *   next_stmt_id(out):
+ *
+ * Note: The INSERT entries that follow and differ only by their values make the array. Each entry is executed as a
+ *	 statement by the server; an error undoes the entry and the next entry is executed. In auto-commit mode, the
+ *	 entries are committed together when the array ends. The sessions of the array are closed unless nothing was
+ *	 executed; then only the one of the first entry is left open.
+ */
+static int
+execute_batch_array_on_server (DB_SESSION * session, int stmt_id, int query_index, int argc, void **argv,
+			       T_NET_BUF * net_buf, T_BROKER_VERSION client_version, char auto_commit_mode,
+			       int *num_done, bool * is_stopped, DB_SESSION ** next_session, int *next_stmt_id)
+{
+  DB_SESSION **sessions = NULL;
+  DB_SESSION *row_session;
+  int *stmt_ids = NULL;
+  int *row_results = NULL;
+  char **row_messages = NULL;
+  int num_rows = 1;
+  int num_executed = 0;
+  int row_stmt_id;
+  int sql_size;
+  int err_code = 0;
+  int stop_err_code = NO_ERROR;
+  char *stop_err_msg = NULL;
+  char *sql_stmt;
+  bool use_plan_cache, use_query_cache;
+  bool is_aborted = false;
+  T_OBJECT ins_oid;
+  int i;
+
+  *num_done = 0;
+  *is_stopped = false;
+  *next_session = NULL;
+  *next_stmt_id = -1;
+
+  sessions = (DB_SESSION **) MALLOC (sizeof (DB_SESSION *) * (argc - query_index));
+  stmt_ids = (int *) MALLOC (sizeof (int) * (argc - query_index));
+  if (sessions == NULL || stmt_ids == NULL)
+    {
+      /* the entries are executed one by one */
+      goto end;
+    }
+  sessions[0] = session;
+  stmt_ids[0] = stmt_id;
+
+  for (i = query_index + 1; i < argc; i++)
+    {
+      net_arg_get_str (&sql_stmt, &sql_size, argv[i]);
+      if (sql_stmt == NULL || get_stmt_type (sql_stmt) != CUBRID_STMT_INSERT)
+	{
+	  break;
+	}
+
+      row_session = db_open_buffer (sql_stmt);
+      if (row_session == NULL)
+	{
+	  break;
+	}
+
+      SQL_LOG2_COMPILE_BEGIN (as_info->cur_sql_log2, sql_stmt);
+
+      row_stmt_id = db_compile_statement (row_session);
+      if (row_stmt_id < 0)
+	{
+	  /* the entry is compiled again when it is executed, and its error is reported then */
+	  db_close_session (row_session);
+	  break;
+	}
+
+      if (!db_can_execute_batch_array (session, stmt_id, row_session, row_stmt_id))
+	{
+	  *next_session = row_session;
+	  *next_stmt_id = row_stmt_id;
+	  break;
+	}
+
+      sessions[num_rows] = row_session;
+      stmt_ids[num_rows] = row_stmt_id;
+      num_rows++;
+    }
+
+  if (num_rows == 1)
+    {
+      goto end;
+    }
+
+  row_results = (int *) MALLOC (sizeof (int) * num_rows);
+  row_messages = (char **) MALLOC (sizeof (char *) * num_rows);
+  if (row_results == NULL || row_messages == NULL)
+    {
+      goto end;
+    }
+
+#if !defined (LIBCAS_FOR_JSP) && !defined(CAS_FOR_ORACLE) && !defined(CAS_FOR_MYSQL)
+  if (db_set_statement_auto_commit (session, auto_commit_mode) != NO_ERROR)
+    {
+      /* the entries are executed one by one, and the error is reported by the first one */
+      goto end;
+    }
+#endif /* !LIBCAS_FOR_JSP && !CAS_FOR_ORACLE && !CAS_FOR_MYSQL */
+
+  for (i = 0; i < num_rows; i++)
+    {
+      if (i > 0)
+	{
+	  net_arg_get_str (&sql_stmt, &sql_size, argv[query_index + i]);
+	  cas_log_write_nonl (0, false, "batch %d : ", query_index + i + 1);
+	  cas_log_write_query_string_nonl (sql_stmt, strlen (sql_stmt));
+	}
+      db_get_cacheinfo (sessions[i], stmt_ids[i], &use_plan_cache, &use_query_cache);
+      cas_log_write2_nonl (" %s\n", use_plan_cache ? "(PC)" : "");
+    }
+
+  SQL_LOG2_EXEC_BEGIN (as_info->cur_sql_log2, stmt_id);
+  err_code = db_execute_batch_array (sessions, stmt_ids, num_rows, row_results, row_messages, &num_executed);
+  SQL_LOG2_EXEC_END (as_info->cur_sql_log2, stmt_id, num_executed);
+
+  if (num_executed < num_rows)
+    {
+      stop_err_code = db_error_code ();
+      if (stop_err_code >= 0)
+	{
+	  stop_err_code = err_code;
+	}
+      is_aborted = ER_IS_ABORTED_DUE_TO_DEADLOCK (stop_err_code) || ER_IS_SERVER_DOWN_ERROR (stop_err_code);
+
+      if (is_aborted && auto_commit_mode == FALSE)
+	{
+	  err_code = ERROR_INFO_SET (stop_err_code, DBMS_ERROR_INDICATOR);
+	  goto end;
+	}
+      stop_err_msg = (char *) db_error_string (1);
+    }
+  err_code = 0;
+
+  memset (&ins_oid, 0, sizeof (T_OBJECT));
+  for (i = 0; i < num_executed; i++)
+    {
+#ifndef LIBCAS_FOR_JSP
+      update_query_execution_count (as_info, CUBRID_STMT_INSERT);
+#endif /* LIBCAS_FOR_JSP */
+
+      if (is_aborted)
+	{
+	  /* the transaction of the array was rolled back; so was the entry */
+	  row_results[i] = stop_err_code;
+	}
+
+      if (row_results[i] >= 0)
+	{
+	  net_buf_cp_byte (net_buf, CUBRID_STMT_INSERT);
+	  net_buf_cp_int (net_buf, row_results[i], NULL);
+	  net_buf_cp_object (net_buf, &ins_oid);
+	}
+      else
+	{
+	  const char *err_msg = is_aborted ? stop_err_msg : (row_messages[i] != NULL ? row_messages[i] : "");
+
+	  net_buf_cp_byte (net_buf, CUBRID_MAX_STMT_TYPE);
+	  if (DOES_CLIENT_UNDERSTAND_THE_PROTOCOL (client_version, PROTOCOL_V3))
+	    {
+	      net_buf_cp_int (net_buf, DBMS_ERROR_INDICATOR, NULL);
+	    }
+	  net_buf_cp_int (net_buf, row_results[i], NULL);
+	  net_buf_cp_int (net_buf, strlen (err_msg) + 1, NULL);
+	  net_buf_cp_str (net_buf, err_msg, strlen (err_msg) + 1);
+	  errors_in_transaction++;
+	}
+    }
+  *num_done = num_executed;
+
+  if (num_executed < num_rows && stop_err_code != ER_QPROC_XASLNODE_RECOMPILE_REQUESTED
+      && stop_err_code != ER_QPROC_INVALID_XASLNODE)
+    {
+      /* the entry that stopped the array failed; the entries after it are executed one by one, unless interrupted */
+#ifndef LIBCAS_FOR_JSP
+      update_query_execution_count (as_info, CUBRID_STMT_INSERT);
+#endif /* LIBCAS_FOR_JSP */
+
+      net_buf_cp_byte (net_buf, CUBRID_MAX_STMT_TYPE);
+      if (DOES_CLIENT_UNDERSTAND_THE_PROTOCOL (client_version, PROTOCOL_V3))
+	{
+	  net_buf_cp_int (net_buf, DBMS_ERROR_INDICATOR, NULL);
+	}
+      net_buf_cp_int (net_buf, stop_err_code, NULL);
+      net_buf_cp_int (net_buf, strlen (stop_err_msg) + 1, NULL);
+      net_buf_cp_str (net_buf, stop_err_msg, strlen (stop_err_msg) + 1);
+      errors_in_transaction++;
+
+      (*num_done)++;
+      *is_stopped = (stop_err_code == ER_INTERRUPTED);
+    }
+
+  if (auto_commit_mode == TRUE)
+    {
+      if (is_aborted)
+	{
+	  db_abort_transaction ();
+	}
+      else
+	{
+	  db_commit_transaction ();
+	}
+    }
+
+end:
+  if (*next_session != NULL && (err_code < 0 || (num_rows > 1 && *num_done < num_rows)))
+    {
+      /* the entries before it are left to the caller */
+      db_close_session (*next_session);
+      *next_session = NULL;
+    }
+  if (sessions != NULL)
+    {
+      for (i = (err_code < 0 || *num_done > 0) ? 0 : 1; i < num_rows; i++)
+	{
+	  db_close_session (sessions[i]);
+	}
+      FREE_MEM (sessions);
+    }
+  if (stmt_ids != NULL)
+    {
+      FREE_MEM (stmt_ids);
+    }
+  if (row_messages != NULL)
+    {
+      for (i = 0; i < num_executed; i++)
+	{
+	  if (row_messages[i] != NULL)
+	    {
+	      free (row_messages[i]);
+	    }
+	}
+      FREE_MEM (row_messages);
+    }
+  if (row_results != NULL)
+    {
+      FREE_MEM (row_results);
+    }
+
+  return err_code;
+}
+
 void
 ux_get_tran_setting (int *lock_wait, int *isol_level)
 {
@@ -236,6 +236,12 @@ enum net_server_request
 
   NET_SERVER_LC_SEND_PROXY_BUFFER,
 
+  NET_SERVER_QM_QUERY_SAVE_ALL_PLANS,
+
+  NET_SERVER_QM_QUERY_EXECUTE_ARRAY,
+
+  NET_SERVER_HEAP_GET_PAGES,
+
   /*
    * This is the last entry. It is also used for the end of an
    * array of statistics information on client/server communication.
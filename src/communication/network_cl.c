@@ -535,6 +535,7 @@ net_histo_setup_names (void)
   net_Req_buffer[NET_SERVER_HEAP_DESTROY].name = "NET_SERVER_HEAP_DESTROY";
   net_Req_buffer[NET_SERVER_HEAP_DESTROY_WHEN_NEW].name = "NET_SERVER_HEAP_DESTROY_WHEN_NEW";
   net_Req_buffer[NET_SERVER_HEAP_GET_CLASS_NOBJS_AND_NPAGES].name = "NET_SERVER_HEAP_GET_CLASS_NOBJS_AND_NPAGES";
+  net_Req_buffer[NET_SERVER_HEAP_GET_PAGES].name = "NET_SERVER_HEAP_GET_PAGES";
   net_Req_buffer[NET_SERVER_HEAP_HAS_INSTANCE].name = "NET_SERVER_HEAP_HAS_INSTANCE";
   net_Req_buffer[NET_SERVER_HEAP_RECLAIM_ADDRESSES].name = "NET_SERVER_HEAP_RECLAIM_ADDRESSES";
 
@@ -576,6 +577,8 @@ net_histo_setup_names (void)
   net_Req_buffer[NET_SERVER_QM_QUERY_PREPARE_AND_EXECUTE].name = "NET_SERVER_QM_QUERY_PREPARE_AND_EXECUTE";
   net_Req_buffer[NET_SERVER_QM_QUERY_END].name = "NET_SERVER_QM_QUERY_END";
   net_Req_buffer[NET_SERVER_QM_QUERY_DROP_ALL_PLANS].name = "NET_SERVER_QM_QUERY_DROP_ALL_PLANS";
+  net_Req_buffer[NET_SERVER_QM_QUERY_SAVE_ALL_PLANS].name = "NET_SERVER_QM_QUERY_SAVE_ALL_PLANS";
+  net_Req_buffer[NET_SERVER_QM_QUERY_EXECUTE_ARRAY].name = "NET_SERVER_QM_QUERY_EXECUTE_ARRAY";
   net_Req_buffer[NET_SERVER_QM_QUERY_DUMP_PLANS].name = "NET_SERVER_QM_QUERY_DUMP_PLANS";
   net_Req_buffer[NET_SERVER_QM_QUERY_DUMP_CACHE].name = "NET_SERVER_QM_QUERY_DUMP_CACHE";
 
@@ -396,17 +396,61 @@ locator_get_class (OID * class_oid, int class_chn, const OID * oid, LOCK lock, i
 int
 locator_fetch_all (const HFID * hfid, LOCK * lock, LC_FETCH_VERSION_TYPE fetch_version_type, OID * class_oidp,
 		   int *nobjects, int *nfetched, OID * last_oidp, LC_COPYAREA ** fetch_copyarea)
+{
+  return locator_fetch_all_pages (hfid, lock, fetch_version_type, class_oidp, NULL, 0, nobjects, nfetched, last_oidp,
+				  fetch_copyarea);
+}
+
+/*
+ * locator_fetch_all_pages -
+ *
+ * return:
+ *
+ *   hfid(in):
+ *   lock(in):
+ *   fetch_version_type(in): fetch version type
+ *   class_oidp(in):
+ *   pages(in): pages of the heap to fetch from, sorted by VPID; NULL for the whole heap
+ *   n_pages(in): number of pages
+ *   nobjects(in):
+ *   nfetched(in):
+ *   last_oidp(in):
+ *   fetch_copyarea(in):
+ *
+ * NOTE: the same pages must be given until the fetch of all their objects ends (nobjects == nfetched).
+ */
+int
+locator_fetch_all_pages (const HFID * hfid, LOCK * lock, LC_FETCH_VERSION_TYPE fetch_version_type, OID * class_oidp,
+			 const VPID * pages, int n_pages, int *nobjects, int *nfetched, OID * last_oidp,
+			 LC_COPYAREA ** fetch_copyarea)
 {
 #if defined(CS_MODE)
   int req_error;
   char *ptr;
   int return_value = ER_FAILED;
-  OR_ALIGNED_BUF (OR_HFID_SIZE + (OR_INT_SIZE * 4) + (OR_OID_SIZE * 2)) a_request;
+  OR_ALIGNED_BUF (OR_HFID_SIZE + (OR_INT_SIZE * 5) + (OR_OID_SIZE * 2)) a_request;
   char *request;
+  int request_size;
   OR_ALIGNED_BUF (NET_COPY_AREA_SENDRECV_SIZE + (OR_INT_SIZE * 4) + OR_OID_SIZE) a_reply;
   char *reply;
+  int i;
 
-  request = OR_ALIGNED_BUF_START (a_request);
+  request_size = OR_ALIGNED_BUF_SIZE (a_request);
+  if (n_pages > 0)
+    {
+      request_size += n_pages * OR_INT_SIZE * 2;
+      request = (char *) malloc (request_size);
+      if (request == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) request_size);
+	  *fetch_copyarea = NULL;
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
+	}
+    }
+  else
+    {
+      request = OR_ALIGNED_BUF_START (a_request);
+    }
   reply = OR_ALIGNED_BUF_START (a_reply);
 
   ptr = or_pack_hfid (request, hfid);
@@ -416,10 +460,16 @@ locator_fetch_all (const HFID * hfid, LOCK * lock, LC_FETCH_VERSION_TYPE fetch_v
   ptr = or_pack_int (ptr, *nobjects);
   ptr = or_pack_int (ptr, *nfetched);
   ptr = or_pack_oid (ptr, last_oidp);
+  ptr = or_pack_int (ptr, n_pages);
+  for (i = 0; i < n_pages; i++)
+    {
+      ptr = or_pack_int (ptr, pages[i].pageid);
+      ptr = or_pack_int (ptr, pages[i].volid);
+    }
   *fetch_copyarea = NULL;
 
   req_error =
-    net_client_request_recv_copyarea (NET_SERVER_LC_FETCHALL, request, OR_ALIGNED_BUF_SIZE (a_request), reply,
+    net_client_request_recv_copyarea (NET_SERVER_LC_FETCHALL, request, request_size, reply,
 				      OR_ALIGNED_BUF_SIZE (a_reply), fetch_copyarea);
   if (req_error == NO_ERROR)
     {
@@ -435,6 +485,11 @@ locator_fetch_all (const HFID * hfid, LOCK * lock, LC_FETCH_VERSION_TYPE fetch_v
       *fetch_copyarea = NULL;
     }
 
+  if (request != OR_ALIGNED_BUF_START (a_request))
+    {
+      free_and_init (request);
+    }
+
   return return_value;
 #else /* CS_MODE */
   int success = ER_FAILED;
@@ -443,7 +498,7 @@ locator_fetch_all (const HFID * hfid, LOCK * lock, LC_FETCH_VERSION_TYPE fetch_v
 
   success =
     xlocator_fetch_all (thread_p, hfid, lock, fetch_version_type, class_oidp, nobjects, nfetched, last_oidp,
-			fetch_copyarea);
+			fetch_copyarea, pages, n_pages);
 
   exit_server (*thread_p);
 
@@ -675,7 +730,7 @@ locator_force (LC_COPYAREA * copy_area, int num_ignore_error_list, int *ignore_e
 
   mobjs = LC_MANYOBJS_PTR_IN_COPYAREA (copy_area);
 
-  request_size = OR_INT_SIZE * (6 + num_ignore_error_list);
+  request_size = OR_INT_SIZE * (7 + num_ignore_error_list);
   request = (char *) malloc (request_size);
 
   if (request == NULL)
@@ -691,6 +746,7 @@ locator_force (LC_COPYAREA * copy_area, int num_ignore_error_list, int *ignore_e
   request_ptr = or_pack_int (request, num_objs);
   request_ptr = or_pack_int (request_ptr, mobjs->start_multi_update);
   request_ptr = or_pack_int (request_ptr, mobjs->end_multi_update);
+  request_ptr = or_pack_int (request_ptr, mobjs->sort_index_keys);
   request_ptr = or_pack_int (request_ptr, desc_size);
   request_ptr = or_pack_int (request_ptr, content_size);
 
@@ -6552,6 +6608,198 @@ cleanup:
 #endif /* !CS_MODE */
 }
 
+/*
+ * qmgr_execute_query_array - Send a SERVER_QM_QUERY_EXECUTE_ARRAY request to the server
+ *
+ * return: error code
+ *
+ *   xasl_id(in): XASL file id of the prepared query
+ *   n_rows(in): number of rows
+ *   dbval_cnt(in): number of parameter values of each row
+ *   dbvals(in): parameter values of all rows, row after row
+ *   flag(in): query execution flag
+ *   query_timeout(in):
+ *   row_results(out): per row, number of affected objects or error code
+ *   row_messages(out): per row, error message allocated with malloc, or NULL
+ *   n_executed(out): number of rows executed
+ *
+ * NOTE:
+ * Execute the query once for each row, in one request. When less than n_rows are executed, the error that stopped the
+ * execution is returned. This function is a counter part to sqmgr_execute_query_array().
+ */
+int
+qmgr_execute_query_array (const XASL_ID * xasl_id, int n_rows, int dbval_cnt, const DB_VALUE * dbvals,
+			  QUERY_FLAG flag, int query_timeout, int *row_results, char **row_messages, int *n_executed)
+{
+#if defined(CS_MODE)
+  int error = NO_ERROR;
+  int req_error, senddata_size, replydata_size, row_size;
+  int i, row, n_values;
+  char *request, *reply, *senddata = NULL, *replydata = NULL, *ptr, *row_ptr;
+  const char *message;
+  OR_ALIGNED_BUF (OR_XASL_ID_SIZE + OR_INT_SIZE * 5) a_request;
+  OR_ALIGNED_BUF (OR_INT_SIZE * 2) a_reply;
+
+  request = OR_ALIGNED_BUF_START (a_request);
+  reply = OR_ALIGNED_BUF_START (a_reply);
+  *n_executed = 0;
+
+  /* send data is the size and the packed values of each row */
+  n_values = n_rows * dbval_cnt;
+  senddata_size = n_rows * OR_INT_SIZE;
+  for (i = 0; i < n_values; i++)
+    {
+      senddata_size += OR_VALUE_ALIGNED_SIZE ((DB_VALUE *) & dbvals[i]);
+    }
+
+  senddata = (char *) malloc (senddata_size);
+  if (senddata == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) senddata_size);
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  ptr = senddata;
+  for (row = 0; row < n_rows; row++)
+    {
+      row_ptr = ptr + OR_INT_SIZE;
+      for (i = 0, ptr = row_ptr; i < dbval_cnt; i++)
+	{
+	  ptr = or_pack_db_value (ptr, (DB_VALUE *) & dbvals[row * dbval_cnt + i]);
+	}
+      row_size = CAST_BUFLEN (ptr - row_ptr);
+      (void) or_pack_int (row_ptr - OR_INT_SIZE, row_size);
+    }
+  senddata_size = CAST_BUFLEN (ptr - senddata);
+
+  ptr = request;
+  OR_PACK_XASL_ID (ptr, xasl_id);
+  ptr = or_pack_int (ptr, n_rows);
+  ptr = or_pack_int (ptr, dbval_cnt);
+  ptr = or_pack_int (ptr, senddata_size);
+  ptr = or_pack_int (ptr, flag);
+  ptr = or_pack_int (ptr, query_timeout);
+
+  req_error = net_client_request2 (NET_SERVER_QM_QUERY_EXECUTE_ARRAY, request, OR_ALIGNED_BUF_SIZE (a_request), reply,
+				   OR_ALIGNED_BUF_SIZE (a_reply), senddata, senddata_size, &replydata,
+				   &replydata_size);
+  free_and_init (senddata);
+
+  if (req_error)
+    {
+      ASSERT_ERROR_AND_SET (error);
+      return (error == NO_ERROR) ? ER_FAILED : error;
+    }
+
+  ptr = or_unpack_int (reply, &replydata_size);
+  (void) or_unpack_int (ptr, n_executed);
+  if (replydata == NULL)
+    {
+      *n_executed = 0;
+    }
+
+  ptr = replydata;
+  for (row = 0; row < *n_executed; row++)
+    {
+      ptr = or_unpack_int (ptr, &row_results[row]);
+      row_messages[row] = NULL;
+      if (row_results[row] < 0)
+	{
+	  ptr = or_unpack_string_nocopy (ptr, (char **) &message);
+	  row_messages[row] = strdup (message != NULL ? message : "");
+	}
+    }
+
+  if (replydata != NULL)
+    {
+      free_and_init (replydata);
+    }
+
+  if (*n_executed < n_rows)
+    {
+      /* the error that stopped the execution was sent by the server */
+      error = er_errid ();
+      if (error == NO_ERROR)
+	{
+	  error = ER_FAILED;
+	}
+    }
+  return error;
+#else /* CS_MODE */
+  int error = NO_ERROR;
+  int i, row, n_values;
+  DB_VALUE *server_db_values = NULL;
+  void **row_data = NULL;
+  OID *oid;
+
+  THREAD_ENTRY *thread_p = enter_server ();
+
+  *n_executed = 0;
+
+  /* reallocate dbvals to use server allocation */
+  n_values = n_rows * dbval_cnt;
+  server_db_values = (DB_VALUE *) db_private_alloc (thread_p, MAX (n_values, 1) * sizeof (DB_VALUE));
+  row_data = (void **) malloc (n_rows * sizeof (void *));
+  if (server_db_values == NULL || row_data == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, n_rows * sizeof (void *));
+      error = ER_OUT_OF_VIRTUAL_MEMORY;
+      n_values = 0;
+      goto cleanup;
+    }
+  for (i = 0; i < n_values; i++)
+    {
+      db_make_null (&server_db_values[i]);
+    }
+  for (i = 0; i < n_values; i++)
+    {
+      if (DB_VALUE_TYPE (&dbvals[i]) == DB_TYPE_OBJECT)
+	{
+	  /* server cannot handle objects, convert to OID instead */
+	  oid = ws_identifier (db_get_object (&dbvals[i]));
+	  if (oid != NULL)
+	    {
+	      db_make_oid (&server_db_values[i], oid);
+	    }
+	}
+      else if (db_value_clone ((DB_VALUE *) (&dbvals[i]), &server_db_values[i]) != NO_ERROR)
+	{
+	  ASSERT_ERROR_AND_SET (error);
+	  goto cleanup;
+	}
+    }
+  for (row = 0; row < n_rows; row++)
+    {
+      row_data[row] = &server_db_values[row * dbval_cnt];
+    }
+
+  *n_executed = xqmgr_execute_query_array (thread_p, xasl_id, n_rows, dbval_cnt, row_data, flag, query_timeout,
+					   row_results, row_messages);
+  if (*n_executed < n_rows)
+    {
+      ASSERT_ERROR_AND_SET (error);
+    }
+
+cleanup:
+  if (server_db_values != NULL)
+    {
+      for (i = 0; i < n_values; i++)
+	{
+	  db_value_clear (&server_db_values[i]);
+	}
+      db_private_free (thread_p, server_db_values);
+    }
+  if (row_data != NULL)
+    {
+      free_and_init (row_data);
+    }
+
+  exit_server (*thread_p);
+
+  return error;
+#endif /* !CS_MODE */
+}
+
 /*
  * qmgr_prepare_and_execute_query -
  *
@@ -6790,6 +7038,56 @@ qmgr_drop_all_query_plans (void)
 #endif /* !CS_MODE */
 }
 
+/*
+ * qmgr_save_all_query_plans - Send a SERVER_QM_SAVE_ALL_PLANS request to the server
+ *
+ * return:
+ *
+ * NOTE:
+ * Request the server to save all XASL cache entries, to load them back after restart.
+ * This function is a counter part to sqmgr_save_all_query_plans().
+ */
+int
+qmgr_save_all_query_plans (void)
+{
+#if defined(CS_MODE)
+  int status = ER_FAILED;
+  int req_error, request_size;
+  char *request, *reply;
+  OR_ALIGNED_BUF (OR_INT_SIZE) a_request;
+  OR_ALIGNED_BUF (OR_INT_SIZE) a_reply;
+
+  request = OR_ALIGNED_BUF_START (a_request);
+  request_size = OR_INT_SIZE;
+  reply = OR_ALIGNED_BUF_START (a_reply);
+
+  or_pack_int (request, 0);	/* dummy parameter */
+
+  /* send SERVER_QM_QUERY_SAVE_ALL_PLANS request with request data; receive status code (int) as a reply */
+  req_error =
+    net_client_request (NET_SERVER_QM_QUERY_SAVE_ALL_PLANS, request, request_size, reply, OR_ALIGNED_BUF_SIZE (a_reply),
+			NULL, 0, NULL, 0);
+  if (!req_error)
+    {
+      /* first argument should be status code (int) */
+      (void) or_unpack_int (reply, &status);
+    }
+
+  return status;
+#else /* CS_MODE */
+  int status;
+
+  THREAD_ENTRY *thread_p = enter_server ();
+
+  /* call the server routine of query save plan */
+  status = xqmgr_save_all_query_plans (thread_p);
+
+  exit_server (*thread_p);
+
+  return status;
+#endif /* !CS_MODE */
+}
+
 /*
  * qmgr_dump_query_plans -
  *
@@ -7735,6 +8033,96 @@ heap_get_class_num_objects_pages (HFID * hfid, int approximation, int *nobjs, in
 #endif /* !CS_MODE */
 }
 
+/*
+ * heap_get_pages -
+ *
+ * return:
+ *
+ *   hfid(in):
+ *   lower(in): pages before this one are skipped; NULL VPID to start with the first page
+ *   upper(in): pages from this one on are skipped; NULL VPID to go on to the last page
+ *   step(in): every step-th page of the range is returned
+ *   pages(out): the pages in VPID order, allocated with malloc; NULL when there are none
+ *   n_pages(out): number of pages
+ *
+ * NOTE:
+ */
+int
+heap_get_pages (const HFID * hfid, const VPID * lower, const VPID * upper, int step, VPID ** pages, int *n_pages)
+{
+#if defined(CS_MODE)
+  int req_error, status = ER_FAILED;
+  OR_ALIGNED_BUF (OR_HFID_SIZE + OR_INT_SIZE * 5) a_request;
+  char *request;
+  OR_ALIGNED_BUF (OR_INT_SIZE * 2) a_reply;
+  char *reply;
+  char *area = NULL;
+  int area_size = 0;
+  int i, n, volid;
+  char *ptr;
+
+  request = OR_ALIGNED_BUF_START (a_request);
+  reply = OR_ALIGNED_BUF_START (a_reply);
+
+  *pages = NULL;
+  *n_pages = 0;
+
+  ptr = or_pack_hfid (request, hfid);
+  ptr = or_pack_int (ptr, lower->pageid);
+  ptr = or_pack_int (ptr, lower->volid);
+  ptr = or_pack_int (ptr, upper->pageid);
+  ptr = or_pack_int (ptr, upper->volid);
+  ptr = or_pack_int (ptr, step);
+
+  req_error =
+    net_client_request2 (NET_SERVER_HEAP_GET_PAGES, request, OR_ALIGNED_BUF_SIZE (a_request), reply,
+			 OR_ALIGNED_BUF_SIZE (a_reply), NULL, 0, &area, &area_size);
+  if (!req_error)
+    {
+      ptr = or_unpack_int (reply, &area_size);
+      ptr = or_unpack_int (ptr, &status);
+
+      n = area_size / (OR_INT_SIZE * 2);
+      if (status == NO_ERROR && n > 0)
+	{
+	  *pages = (VPID *) malloc (n * sizeof (VPID));
+	  if (*pages == NULL)
+	    {
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) (n * sizeof (VPID)));
+	      status = ER_OUT_OF_VIRTUAL_MEMORY;
+	    }
+	  else
+	    {
+	      ptr = area;
+	      for (i = 0; i < n; i++)
+		{
+		  ptr = or_unpack_int (ptr, &(*pages)[i].pageid);
+		  ptr = or_unpack_int (ptr, &volid);
+		  (*pages)[i].volid = (VOLID) volid;
+		}
+	      *n_pages = n;
+	    }
+	}
+    }
+  if (area != NULL)
+    {
+      free_and_init (area);
+    }
+
+  return status;
+#else /* CS_MODE */
+  int success = ER_FAILED;
+
+  THREAD_ENTRY *thread_p = enter_server ();
+
+  success = xheap_get_pages (thread_p, hfid, lower, upper, step, pages, n_pages);
+
+  exit_server (*thread_p);
+
+  return success;
+#endif /* !CS_MODE */
+}
+
 /*
  * btree_get_statistics -
  *
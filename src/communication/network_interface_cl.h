@@ -87,6 +87,9 @@ extern int locator_get_class (OID * class_oid, int class_chn, const OID * oid, L
 extern int locator_fetch_all (const HFID * hfid, LOCK * lock, LC_FETCH_VERSION_TYPE fetch_version_type,
 			      OID * class_oidp, int *nobjects, int *nfetched, OID * last_oidp,
 			      LC_COPYAREA ** fetch_copyarea);
+extern int locator_fetch_all_pages (const HFID * hfid, LOCK * lock, LC_FETCH_VERSION_TYPE fetch_version_type,
+				    OID * class_oidp, const VPID * pages, int n_pages, int *nobjects, int *nfetched,
+				    OID * last_oidp, LC_COPYAREA ** fetch_copyarea);
 extern int locator_does_exist (OID * oidp, int chn, LOCK lock, OID * class_oid, int class_chn, int need_fetching,
 			       int prefetch, LC_COPYAREA ** fetch_copyarea, LC_FETCH_VERSION_TYPE fetch_version_type);
 extern int locator_notify_isolation_incons (LC_COPYAREA ** synch_copyarea);
@@ -236,11 +239,15 @@ extern int qmgr_prepare_query (struct compile_context *context, xasl_stream * st
 extern QFILE_LIST_ID *qmgr_execute_query (const XASL_ID * xasl_id, QUERY_ID * query_idp, int dbval_cnt,
 					  const DB_VALUE * dbvals, QUERY_FLAG flag, CACHE_TIME * clt_cache_time,
 					  CACHE_TIME * srv_cache_time, int query_timeout);
+extern int qmgr_execute_query_array (const XASL_ID * xasl_id, int n_rows, int dbval_cnt, const DB_VALUE * dbvals,
+				     QUERY_FLAG flag, int query_timeout, int *row_results, char **row_messages,
+				     int *n_executed);
 extern QFILE_LIST_ID *qmgr_prepare_and_execute_query (char *xasl_stream, int xasl_stream_size, QUERY_ID * query_id,
 						      int dbval_cnt, DB_VALUE * dbval_ptr, QUERY_FLAG flag,
 						      int query_timeout);
 extern int qmgr_end_query (QUERY_ID query_id);
 extern int qmgr_drop_all_query_plans (void);
+extern int qmgr_save_all_query_plans (void);
 extern void qmgr_dump_query_plans (FILE * outfp);
 extern void qmgr_dump_query_cache (FILE * outfp);
 #if defined(ENABLE_UNUSED_FUNCTION)
@@ -266,6 +273,8 @@ extern TRANS_INFO *logtb_get_trans_info (bool include_query_exec_info);
 extern void logtb_dump_trantable (FILE * outfp);
 
 extern int heap_get_class_num_objects_pages (HFID * hfid, int approximation, int *nobjs, int *npages);
+extern int heap_get_pages (const HFID * hfid, const VPID * lower, const VPID * upper, int step, VPID ** pages,
+			   int *n_pages);
 
 extern int btree_get_statistics (BTID * btid, BTREE_STATS * stat_info);
 extern int btree_get_index_key_type (BTID btid, TP_DOMAIN ** key_type_p);
@@ -826,6 +826,9 @@ slocator_fetch_all (THREAD_ENTRY * thread_p, unsigned int rid, char *request, in
   char *content_ptr;
   int content_size;
   int num_objs = 0;
+  VPID *page_set = NULL;
+  int n_page_set;
+  int i, volid;
 
   ptr = or_unpack_hfid (request, &hfid);
   ptr = or_unpack_lock (ptr, &lock);
@@ -834,12 +837,35 @@ slocator_fetch_all (THREAD_ENTRY * thread_p, unsigned int rid, char *request, in
   ptr = or_unpack_int (ptr, &nobjects);
   ptr = or_unpack_int (ptr, &nfetched);
   ptr = or_unpack_oid (ptr, &last_oid);
+  ptr = or_unpack_int (ptr, &n_page_set);
 
   copy_area = NULL;
+  if (n_page_set > 0)
+    {
+      page_set = (VPID *) db_private_alloc (thread_p, n_page_set * sizeof (VPID));
+      if (page_set == NULL)
+	{
+	  success = ER_OUT_OF_VIRTUAL_MEMORY;
+	  goto end;
+	}
+      for (i = 0; i < n_page_set; i++)
+	{
+	  ptr = or_unpack_int (ptr, &page_set[i].pageid);
+	  ptr = or_unpack_int (ptr, &volid);
+	  page_set[i].volid = (VOLID) volid;
+	}
+    }
+
   success =
     xlocator_fetch_all (thread_p, &hfid, &lock, (LC_FETCH_VERSION_TYPE) fetch_version_type, &class_oid, &nobjects,
-			&nfetched, &last_oid, &copy_area);
+			&nfetched, &last_oid, &copy_area, page_set, n_page_set);
+
+  if (page_set != NULL)
+    {
+      db_private_free_and_init (thread_p, page_set);
+    }
 
+end:
   if (success != NO_ERROR)
     {
       (void) return_error_to_client (thread_p, rid);
@@ -1190,6 +1216,7 @@ slocator_force (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int re
   int packed_desc_size;
   int start_multi_update;
   int end_multi_update;
+  int sort_index_keys;
   LC_COPYAREA_MANYOBJS *mobjs;
   int i, num_ignore_error_list;
   int ignore_error_list[-ER_LAST_ERROR];
@@ -1197,6 +1224,7 @@ slocator_force (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int re
   ptr = or_unpack_int (request, &num_objs);
   ptr = or_unpack_int (ptr, &start_multi_update);
   ptr = or_unpack_int (ptr, &end_multi_update);
+  ptr = or_unpack_int (ptr, &sort_index_keys);
   ptr = or_unpack_int (ptr, &packed_desc_size);
   ptr = or_unpack_int (ptr, &content_size);
 
@@ -1229,6 +1257,7 @@ slocator_force (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int re
 	  mobjs = LC_MANYOBJS_PTR_IN_COPYAREA (copy_area);
 	  mobjs->start_multi_update = start_multi_update;
 	  mobjs->end_multi_update = end_multi_update;
+	  mobjs->sort_index_keys = sort_index_keys;
 
 	  if (content_size > 0)
 	    {
@@ -5178,6 +5207,160 @@ exit:
     }
 }
 
+/*
+ * sqmgr_execute_query_array - Process a SERVER_QM_QUERY_EXECUTE_ARRAY request
+ *
+ * return:
+ *
+ *   thread_p(in):
+ *   rid(in):
+ *   request(in):
+ *   reqlen(in):
+ *
+ * NOTE:
+ * Execute a prepared query once for each row of parameter values received from the client, and reply the number of
+ * affected objects or the error of each row executed.
+ * This function is a counter part to qmgr_execute_query_array().
+ */
+void
+sqmgr_execute_query_array (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen)
+{
+  XASL_ID xasl_id;
+  QUERY_FLAG query_flag;
+  int n_rows, dbval_cnt, data_size, query_timeout;
+  int n_executed = 0, row, row_size, csserror, length;
+  int replydata_size = 0;
+  char *ptr, *data = NULL, *reply, *replydata = NULL;
+  void **row_data = NULL;
+  int *row_results = NULL;
+  char **row_messages = NULL;
+  OR_ALIGNED_BUF (OR_INT_SIZE * 2) a_reply;
+
+  reply = OR_ALIGNED_BUF_START (a_reply);
+
+  ptr = request;
+  OR_UNPACK_XASL_ID (ptr, &xasl_id);
+  ptr = or_unpack_int (ptr, &n_rows);
+  ptr = or_unpack_int (ptr, &dbval_cnt);
+  ptr = or_unpack_int (ptr, &data_size);
+  ptr = or_unpack_int (ptr, &query_flag);
+  ptr = or_unpack_int (ptr, &query_timeout);
+
+  xsession_set_tran_auto_commit (thread_p, IS_TRAN_AUTO_COMMIT (query_flag));
+
+  if (n_rows <= 0)
+    {
+      goto send_reply;
+    }
+
+  if (0 < data_size)
+    {
+      /* receive parameter values of all rows from the client */
+      csserror = css_receive_data_from_client (thread_p->conn_entry, rid, &data, &data_size);
+      if (csserror || data == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_NET_SERVER_DATA_RECEIVE, 0);
+	  css_send_abort_to_client (thread_p->conn_entry, rid);
+	  goto exit;
+	}
+    }
+
+  row_data = (void **) malloc (n_rows * sizeof (void *));
+  row_results = (int *) malloc (n_rows * sizeof (int));
+  row_messages = (char **) calloc (n_rows, sizeof (char *));
+  if (row_data == NULL || row_results == NULL || row_messages == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, n_rows * sizeof (void *));
+      (void) return_error_to_client (thread_p, rid);
+      goto send_reply;
+    }
+
+  /* each row is its size followed by its packed values */
+  ptr = data;
+  for (row = 0; row < n_rows; row++)
+    {
+      ptr = or_unpack_int (ptr, &row_size);
+      row_data[row] = ptr;
+      ptr += row_size;
+    }
+
+  n_executed = xqmgr_execute_query_array (thread_p, &xasl_id, n_rows, dbval_cnt, row_data, query_flag, query_timeout,
+					  row_results, row_messages);
+  if (n_executed < n_rows)
+    {
+      /* the error that stopped the execution; the transaction may be aborted */
+      (void) return_error_to_client (thread_p, rid);
+    }
+
+  /* pack the result of each row executed, with its error message if it failed */
+  for (row = 0; row < n_executed; row++)
+    {
+      replydata_size += OR_INT_SIZE;
+      if (row_results[row] < 0)
+	{
+	  replydata_size += or_packed_string_length (row_messages[row], &length);
+	}
+    }
+  if (0 < replydata_size)
+    {
+      replydata = (char *) db_private_alloc (thread_p, replydata_size);
+      if (replydata == NULL)
+	{
+	  replydata_size = 0;
+	  n_executed = 0;
+	  (void) return_error_to_client (thread_p, rid);
+	}
+      else
+	{
+	  ptr = replydata;
+	  for (row = 0; row < n_executed; row++)
+	    {
+	      ptr = or_pack_int (ptr, row_results[row]);
+	      if (row_results[row] < 0)
+		{
+		  ptr = or_pack_string (ptr, row_messages[row]);
+		}
+	    }
+	}
+    }
+
+send_reply:
+  ptr = or_pack_int (reply, replydata_size);
+  ptr = or_pack_int (ptr, n_executed);
+
+  css_send_reply_and_data_to_client (thread_p->conn_entry, rid, reply, OR_ALIGNED_BUF_SIZE (a_reply), replydata,
+				     replydata_size);
+
+exit:
+  if (row_messages != NULL)
+    {
+      for (row = 0; row < n_rows; row++)
+	{
+	  if (row_messages[row] != NULL)
+	    {
+	      free (row_messages[row]);
+	    }
+	}
+      free_and_init (row_messages);
+    }
+  if (row_results != NULL)
+    {
+      free_and_init (row_results);
+    }
+  if (row_data != NULL)
+    {
+      free_and_init (row_data);
+    }
+  if (replydata != NULL)
+    {
+      db_private_free_and_init (thread_p, replydata);
+    }
+  if (data != NULL)
+    {
+      free_and_init (data);
+    }
+}
+
 /*
  * er_log_slow_query - log slow query to error log file
  * return:
@@ -5653,6 +5836,42 @@ sqmgr_drop_all_query_plans (THREAD_ENTRY * thread_p, unsigned int rid, char *req
   css_send_data_to_client (thread_p->conn_entry, rid, reply, OR_ALIGNED_BUF_SIZE (a_reply));
 }
 
+/*
+ * sqmgr_save_all_query_plans - Process a SERVER_QM_SAVE_ALL_PLANS request
+ *
+ * return:
+ *
+ *   rid(in):
+ *   request(in):
+ *   reqlen(in):
+ *
+ * NOTE:
+ * Save all XASL cache entries to be loaded back after restart, upon request of the client.
+ * This function is a counter part to qmgr_save_all_query_plans().
+ */
+void
+sqmgr_save_all_query_plans (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen)
+{
+  int status;
+  char *reply;
+  OR_ALIGNED_BUF (OR_INT_SIZE) a_reply;
+
+  reply = OR_ALIGNED_BUF_START (a_reply);
+
+  /* call the server routine of query save plan */
+  status = xqmgr_save_all_query_plans (thread_p);
+  if (status != NO_ERROR)
+    {
+      (void) return_error_to_client (thread_p, rid);
+    }
+
+  /* pack status (DB_IN32) as a reply */
+  (void) or_pack_int (reply, status);
+
+  /* send reply and data to the client */
+  css_send_data_to_client (thread_p->conn_entry, rid, reply, OR_ALIGNED_BUF_SIZE (a_reply));
+}
+
 /*
  * sqmgr_dump_query_plans -
  *
@@ -7164,6 +7383,83 @@ shf_get_class_num_objs_and_pages (THREAD_ENTRY * thread_p, unsigned int rid, cha
   css_send_data_to_client (thread_p->conn_entry, rid, reply, OR_ALIGNED_BUF_SIZE (a_reply));
 }
 
+/*
+ * shf_get_pages -
+ *
+ * return:
+ *
+ *   rid(in):
+ *   request(in):
+ *   reqlen(in):
+ *
+ * NOTE:
+ */
+void
+shf_get_pages (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen)
+{
+  HFID hfid;
+  VPID lower, upper;
+  VPID *pages = NULL;
+  int step, n_pages = 0, volid;
+  int success;
+  char *buffer = NULL;
+  int buffer_length = 0;
+  int i;
+  OR_ALIGNED_BUF (OR_INT_SIZE * 2) a_reply;
+  char *reply = OR_ALIGNED_BUF_START (a_reply);
+  char *ptr;
+
+  ptr = or_unpack_hfid (request, &hfid);
+  ptr = or_unpack_int (ptr, &lower.pageid);
+  ptr = or_unpack_int (ptr, &volid);
+  lower.volid = (VOLID) volid;
+  ptr = or_unpack_int (ptr, &upper.pageid);
+  ptr = or_unpack_int (ptr, &volid);
+  upper.volid = (VOLID) volid;
+  ptr = or_unpack_int (ptr, &step);
+
+  success = xheap_get_pages (thread_p, &hfid, &lower, &upper, step, &pages, &n_pages);
+  if (success == NO_ERROR && n_pages > 0)
+    {
+      buffer_length = n_pages * OR_INT_SIZE * 2;
+      buffer = (char *) malloc (buffer_length);
+      if (buffer == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) buffer_length);
+	  success = ER_OUT_OF_VIRTUAL_MEMORY;
+	  buffer_length = 0;
+	}
+      else
+	{
+	  ptr = buffer;
+	  for (i = 0; i < n_pages; i++)
+	    {
+	      ptr = or_pack_int (ptr, pages[i].pageid);
+	      ptr = or_pack_int (ptr, pages[i].volid);
+	    }
+	}
+    }
+  if (pages != NULL)
+    {
+      free_and_init (pages);
+    }
+
+  if (success != NO_ERROR)
+    {
+      (void) return_error_to_client (thread_p, rid);
+    }
+
+  ptr = or_pack_int (reply, buffer_length);
+  ptr = or_pack_int (ptr, success);
+
+  css_send_reply_and_data_to_client (thread_p->conn_entry, rid, reply, OR_ALIGNED_BUF_SIZE (a_reply), buffer,
+				     buffer_length);
+  if (buffer != NULL)
+    {
+      free_and_init (buffer);
+    }
+}
+
 /*
  * sbtree_get_statistics -
  *
@@ -434,6 +434,11 @@ net_server_init (void)
   req_p->processing_function = shf_get_class_num_objs_and_pages;
   req_p->name = "NET_SERVER_HEAP_GET_CLASS_NOBJS_AND_NPAGES";
 
+  req_p = &net_Requests[NET_SERVER_HEAP_GET_PAGES];
+  req_p->action_attribute = IN_TRANSACTION;
+  req_p->processing_function = shf_get_pages;
+  req_p->name = "NET_SERVER_HEAP_GET_PAGES";
+
   req_p = &net_Requests[NET_SERVER_HEAP_HAS_INSTANCE];
   req_p->action_attribute = IN_TRANSACTION;
   req_p->processing_function = shf_has_instance;
@@ -580,6 +585,11 @@ net_server_init (void)
   req_p->processing_function = sqmgr_execute_query;
   req_p->name = "NET_SERVER_QM_QUERY_EXECUTE";
 
+  req_p = &net_Requests[NET_SERVER_QM_QUERY_EXECUTE_ARRAY];
+  req_p->action_attribute = (SET_DIAGNOSTICS_INFO | IN_TRANSACTION);
+  req_p->processing_function = sqmgr_execute_query_array;
+  req_p->name = "NET_SERVER_QM_QUERY_EXECUTE_ARRAY";
+
   req_p = &net_Requests[NET_SERVER_QM_QUERY_PREPARE_AND_EXECUTE];
   req_p->action_attribute = (SET_DIAGNOSTICS_INFO | IN_TRANSACTION);
   req_p->processing_function = sqmgr_prepare_and_execute_query;
@@ -594,6 +604,10 @@ net_server_init (void)
   req_p->processing_function = sqmgr_drop_all_query_plans;
   req_p->name = "NET_SERVER_QM_QUERY_DROP_ALL_PLANS";
 
+  req_p = &net_Requests[NET_SERVER_QM_QUERY_SAVE_ALL_PLANS];
+  req_p->processing_function = sqmgr_save_all_query_plans;
+  req_p->name = "NET_SERVER_QM_QUERY_SAVE_ALL_PLANS";
+
   req_p = &net_Requests[NET_SERVER_QM_QUERY_DUMP_PLANS];
   req_p->processing_function = sqmgr_dump_query_plans;
   req_p->name = "NET_SERVER_QM_QUERY_DUMP_PLANS";
@@ -937,6 +951,7 @@ net_server_request (THREAD_ENTRY * thread_p, unsigned int rid, int request, int
   int status = CSS_NO_ERRORS;
   int error_code;
   CSS_CONN_ENTRY *conn;
+  PERF_UTIME_TRACKER time_track = PERF_UTIME_TRACKER_INITIALIZER;
 
   if (buffer == NULL && size > 0)
     {
@@ -1043,7 +1058,9 @@ net_server_request (THREAD_ENTRY * thread_p, unsigned int rid, int request, int
 	{
 	  logtb_invalidate_snapshot_data (thread_p);
 	}
+      PERF_UTIME_TRACKER_START (thread_p, &time_track);
       (*func) (thread_p, rid, buffer, size);
+      PERF_UTIME_TRACKER_LATENCY (thread_p, &time_track, PERFMON_LATENCY_NET_REQUEST);
 
       thread_p->pop_resource_tracks ();
 
@@ -25,6 +25,8 @@
 #include "stream_transfer_receiver.hpp"
 
 #include "byte_order.h"
+#include "error_manager.h"
+#include "stream_compression.hpp"
 #include "system_parameter.h" /* for er_log_debug */
 #include "thread_manager.hpp"
 #include "thread_daemon.hpp"
@@ -35,6 +37,7 @@
 namespace cubstream
 {
 
+  /* receives blocks and queues them for transfer_receiver_decompress_task */
   class transfer_receiver_task : public cubthread::entry_task
   {
     public:
@@ -47,7 +50,8 @@ namespace cubstream
       void execute (cubthread::entry &thread_ref) override
       {
 	css_error_code rc = NO_ERRORS;
-	std::size_t max_len = DB_ALIGN_BELOW (cubcomm::MTU, MAX_ALIGNMENT);
+	transfer_receiver::block_buffer block;
+	std::size_t max_len;
 
 	if (m_first_loop)
 	  {
@@ -78,18 +82,23 @@ namespace cubstream
 	  {
 	    return;
 	  }
-	rc = this_consumer_channel.m_channel.recv (this_consumer_channel.m_buffer, max_len);
+
+	this_consumer_channel.get_free_block (block);
+	max_len = block.size ();
+	rc = this_consumer_channel.m_channel.recv (block.data (), max_len);
 	if (rc != NO_ERRORS)
 	  {
+	    this_consumer_channel.release_block (block);
 	    this_consumer_channel.terminate_connection ();
 	    return;
 	  }
 
-	cubcomm::er_log_debug_buffer ("transfer_receiver_task receiving", this_consumer_channel.m_buffer, max_len);
+	cubcomm::er_log_debug_buffer ("transfer_receiver_task receiving", block.data (), max_len);
 
-	if (this_consumer_channel.m_stream.write (max_len, this_consumer_channel.m_write_action_function))
+	block.resize (max_len);
+	if (!this_consumer_channel.push_received_block (block))
 	  {
-	    this_consumer_channel.terminate_connection ();
+	    /* receiver is destroyed */
 	    return;
 	  }
       }
@@ -99,12 +108,48 @@ namespace cubstream
       bool m_first_loop; /* TODO[replication] may be a good idea to use create_context instead */
   };
 
+  /* decompresses received blocks and writes them to stream */
+  class transfer_receiver_decompress_task : public cubthread::entry_task
+  {
+    public:
+      transfer_receiver_decompress_task (cubstream::transfer_receiver &consumer_channel)
+	: this_consumer_channel (consumer_channel),
+	  m_is_write_failed (false)
+      {
+      }
+
+      void execute (cubthread::entry &thread_ref) override
+      {
+	transfer_receiver::block_buffer block;
+
+	if (!this_consumer_channel.pop_received_block (block))
+	  {
+	    return;
+	  }
+
+	/* after a failed block, the following ones are dropped until connection is closed */
+	if (!m_is_write_failed && this_consumer_channel.write_block (block) != NO_ERROR)
+	  {
+	    m_is_write_failed = true;
+	    this_consumer_channel.terminate_connection ();
+	  }
+	this_consumer_channel.release_block (block);
+      }
+
+    private:
+      cubstream::transfer_receiver &this_consumer_channel;
+      bool m_is_write_failed;
+  };
+
   transfer_receiver::transfer_receiver (cubcomm::channel &&chn,
 					stream &stream,
 					stream_position received_from_position)
     : m_channel (std::move (chn)),
       m_stream (stream),
-      m_last_received_position (received_from_position)
+      m_last_received_position (received_from_position),
+      m_is_pipeline_stopped (false),
+      m_raw_buffer (COMPRESSED_BLOCK_MAX_RAW_SIZE),
+      m_write_source (NULL)
   {
     m_write_action_function = std::bind (&transfer_receiver::write_action,
 					 std::ref (*this),
@@ -113,6 +158,8 @@ namespace cubstream
 					 std::placeholders::_3);
 
     std::string daemon_name = "stream_transfer_receiver_" + chn.get_channel_id ();
+    m_decompress_daemon = cubthread::get_manager ()->create_daemon (cubthread::delta_time (0),
+			  new transfer_receiver_decompress_task (*this), (daemon_name + "_decompress").c_str ());
     m_receiver_daemon = cubthread::get_manager ()->create_daemon (cubthread::delta_time (0),
 			new transfer_receiver_task (*this), daemon_name.c_str ());
   }
@@ -120,17 +167,131 @@ namespace cubstream
   transfer_receiver::~transfer_receiver ()
   {
     terminate_connection ();
+    stop_pipeline ();
     cubthread::get_manager ()->destroy_daemon (m_receiver_daemon);
+    cubthread::get_manager ()->destroy_daemon (m_decompress_daemon);
   }
 
   int transfer_receiver::write_action (const stream_position pos, char *ptr, const size_t byte_count)
   {
-    std::memcpy (ptr, m_buffer, byte_count);
+    std::memcpy (ptr, m_write_source, byte_count);
     m_last_received_position += byte_count;
 
     return NO_ERROR;
   }
 
+  /*
+   * write_block - decompress a received block and write it to stream
+   *
+   * return : error code
+   */
+  int transfer_receiver::write_block (const block_buffer &block)
+  {
+    compressed_block_header header;
+    const char *payload = block.data () + COMPRESSED_BLOCK_HEADER_SIZE;
+
+    if (!read_compressed_block_header (block.data (), block.size (), header)
+	|| header.m_stored_size != block.size () - COMPRESSED_BLOCK_HEADER_SIZE
+	|| (header.m_codec != COMPRESSION_NONE && !decompress_block (header, payload, m_raw_buffer.data ())))
+      {
+	er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_STREAM_INVALID_COMPRESSED_BLOCK, 2, m_stream.name ().c_str (),
+		m_last_received_position);
+	return ER_STREAM_INVALID_COMPRESSED_BLOCK;
+      }
+
+    if (header.m_raw_size == 0)
+      {
+	return NO_ERROR;
+      }
+
+    /* uncompressed blocks are written from received buffer */
+    m_write_source = header.m_codec == COMPRESSION_NONE ? payload : m_raw_buffer.data ();
+    if (m_stream.write (header.m_raw_size, m_write_action_function))
+      {
+	return ER_FAILED;
+      }
+    return NO_ERROR;
+  }
+
+  void transfer_receiver::get_free_block (block_buffer &block)
+  {
+    std::unique_lock<std::mutex> ul (m_blocks_mtx);
+
+    if (!m_free_blocks.empty ())
+      {
+	block.swap (m_free_blocks.back ());
+	m_free_blocks.pop_back ();
+      }
+    ul.unlock ();
+
+    block.resize (get_compressed_block_max_size (COMPRESSED_BLOCK_MAX_RAW_SIZE));
+  }
+
+  /*
+   * push_received_block - queue block for decompress daemon; waits while queue is full
+   *
+   * return : false if receiver is destroyed
+   */
+  bool transfer_receiver::push_received_block (block_buffer &block)
+  {
+    std::unique_lock<std::mutex> ul (m_blocks_mtx);
+
+    m_blocks_cv.wait (ul, [this] { return m_is_pipeline_stopped || m_received_blocks.size () < MAX_RECEIVED_BLOCKS; });
+    if (m_is_pipeline_stopped)
+      {
+	return false;
+      }
+
+    m_received_blocks.emplace_back (std::move (block));
+    ul.unlock ();
+
+    m_blocks_cv.notify_all ();
+    return true;
+  }
+
+  /*
+   * pop_received_block - get next received block; waits while queue is empty
+   *
+   * return : false if receiver is destroyed
+   */
+  bool transfer_receiver::pop_received_block (block_buffer &block)
+  {
+    std::unique_lock<std::mutex> ul (m_blocks_mtx);
+
+    m_blocks_cv.wait (ul, [this] { return m_is_pipeline_stopped || !m_received_blocks.empty (); });
+    if (m_is_pipeline_stopped)
+      {
+	return false;
+      }
+
+    block.swap (m_received_blocks.front ());
+    m_received_blocks.pop_front ();
+    ul.unlock ();
+
+    m_blocks_cv.notify_all ();
+    return true;
+  }
+
+  void transfer_receiver::release_block (block_buffer &block)
+  {
+    std::unique_lock<std::mutex> ul (m_blocks_mtx);
+
+    if (m_free_blocks.size () < MAX_RECEIVED_BLOCKS)
+      {
+	m_free_blocks.emplace_back (std::move (block));
+      }
+  }
+
+  void transfer_receiver::stop_pipeline ()
+  {
+    std::unique_lock<std::mutex> ul (m_blocks_mtx);
+
+    m_is_pipeline_stopped = true;
+    ul.unlock ();
+
+    m_blocks_cv.notify_all ();
+  }
+
   void transfer_receiver::wait_disconnect ()
   {
     std::unique_lock<std::mutex> ul (m_sender_disconnect_mtx);
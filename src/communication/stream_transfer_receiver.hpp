@@ -29,7 +29,9 @@
 #include "cubstream.hpp"
 
 #include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <vector>
 
 namespace cubthread
 {
@@ -56,21 +58,44 @@ namespace cubstream
       }
 
     private:
+      using block_buffer = std::vector<char>;
+
+      /* received blocks waiting to be decompressed; receiving stops while the queue is full */
+      static const std::size_t MAX_RECEIVED_BLOCKS = 8;
 
       int write_action (const stream_position pos, char *ptr, const size_t byte_count);
       void terminate_connection ();
 
+      /* pipeline between receive daemon and decompress daemon */
+      void get_free_block (block_buffer &block);
+      bool push_received_block (block_buffer &block);
+      bool pop_received_block (block_buffer &block);
+      void release_block (block_buffer &block);
+      void stop_pipeline ();
+
+      int write_block (const block_buffer &block);
+
       friend class transfer_receiver_task;
+      friend class transfer_receiver_decompress_task;
 
       cubcomm::channel m_channel;
       cubstream::stream &m_stream;
       cubstream::stream_position m_last_received_position;
       cubthread::daemon *m_receiver_daemon;
+      cubthread::daemon *m_decompress_daemon;
 
       std::mutex m_sender_disconnect_mtx;
       std::condition_variable m_sender_disconnect_cv;
 
-      char m_buffer[cubcomm::MTU];
+      std::mutex m_blocks_mtx;
+      std::condition_variable m_blocks_cv;
+      std::deque<block_buffer> m_received_blocks;
+      std::vector<block_buffer> m_free_blocks;
+      bool m_is_pipeline_stopped;
+
+      /* used by decompress daemon only */
+      std::vector<char> m_raw_buffer;
+      const char *m_write_source;
 
     protected:
       cubstream::stream::write_func_t m_write_action_function;
@@ -20,9 +20,12 @@
 /*
  * stream_transfer_[sender/receiver].cpp
  *
- * - sends or receives chunks(usually MTU bytes) from cubstream::stream
- * - the sender interogates the respective stream and tries to send the minimum between MTU and what is left of
- *   the stream
+ * - sends or receives chunks(usually COMPRESSED_BLOCK_MAX_RAW_SIZE bytes) from cubstream::stream
+ * - the sender interogates the respective stream and tries to send the minimum between chunk size and what is left
+ *   of the stream
+ * - each chunk is sent as one message holding a compressed block (see stream_compression.hpp); the codec is given by
+ *   replication_stream_compression parameter and the receiver finds it in block header. the receiver decompresses
+ *   and writes to stream in a separate daemon, while next blocks are received
  * - it contains a daemon that is started automatically at creation, that does the task of sending/receiving bytes
  * - usage can be found in transfer_channel/test_main.cpp;
  *   on one machine will exist a transfer_sender instance and on the other a transfer_receiver.
@@ -106,7 +109,7 @@ namespace cubstream
 
 	while (this_producer_channel.m_last_sent_position < last_reported_ready_pos)
 	  {
-	    std::size_t byte_count = std::min ((stream_position) cubcomm::MTU,
+	    std::size_t byte_count = std::min ((stream_position) COMPRESSED_BLOCK_MAX_RAW_SIZE,
 					       last_reported_ready_pos - this_producer_channel.m_last_sent_position);
 	    int error_code = NO_ERROR;
 
@@ -152,6 +155,8 @@ namespace cubstream
     : m_channel (std::move (chn))
     , m_stream (stream)
     , m_last_sent_position (begin_sending_position)
+    , m_compressor ((compression_codec) prm_get_integer_value (PRM_ID_REPL_STREAM_COMPRESSION))
+    , m_block (get_compressed_block_max_size (COMPRESSED_BLOCK_MAX_RAW_SIZE))
     , m_is_termination_phase (false)
     , m_p_stream_ack (NULL)
   {
@@ -185,7 +190,9 @@ namespace cubstream
 
   int transfer_sender::read_action (char *ptr, const size_t byte_count)
   {
-    if (m_channel.send (ptr, byte_count) == NO_ERRORS)
+    std::size_t block_size = m_compressor.compress (ptr, byte_count, m_block.data ());
+
+    if (m_channel.send (m_block.data (), block_size) == NO_ERRORS)
       {
 	cubcomm::er_log_debug_buffer ("transfer_sender::read_action", ptr, byte_count);
 
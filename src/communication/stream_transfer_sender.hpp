@@ -27,8 +27,10 @@
 
 #include "communication_channel.hpp"
 #include "cubstream.hpp"
+#include "stream_compression.hpp"
 
 #include <atomic>     // for atomic_bool
+#include <vector>
 
 namespace cubthread
 {
@@ -87,7 +89,8 @@ namespace cubstream
       cubstream::stream &m_stream;
       stream_position m_last_sent_position;
       cubthread::daemon *m_sender_daemon;
-      char m_buffer[cubcomm::MTU];
+      block_compressor m_compressor;
+      std::vector<char> m_block;      /* compressed block of last read chunk */
 
       std::atomic_bool m_is_termination_phase;
 
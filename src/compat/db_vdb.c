@@ -97,6 +97,7 @@ static bool db_check_limit_need_recompile (PARSER_CONTEXT * parser, PT_NODE * st
 static DB_CLASS_MODIFICATION_STATUS pt_has_modified_class (PARSER_CONTEXT * parser, PT_NODE * statement);
 static PT_NODE *pt_has_modified_class_helper (PARSER_CONTEXT * parser, PT_NODE * tree, void *arg, int *continue_walk);
 static bool db_can_execute_statement_with_autocommit (PARSER_CONTEXT * parser, PT_NODE * statement);
+static PT_NODE *db_get_array_insert (DB_SESSION * session, int stmt_ndx);
 
 /*
  * get_dimemsion_of() - returns the number of elements of a null-terminated
@@ -2860,6 +2861,347 @@ db_execute_and_keep_statement (DB_SESSION * session, int stmt_ndx, DB_QUERY_RESU
   return err;
 }
 
+/*
+ * db_get_array_insert() - Get the statement if it is an INSERT that can be executed for an array of rows in one
+ *			   request to the server
+ * return : the INSERT statement, or NULL
+ * session(in) : contains the SQL query that has been compiled
+ * stmt_ndx(in) : int returned by a successful compilation
+ */
+static PT_NODE *
+db_get_array_insert (DB_SESSION * session, int stmt_ndx)
+{
+  PARSER_CONTEXT *parser;
+  PT_NODE *statement;
+
+  if (session == NULL || session->parser == NULL)
+    {
+      return NULL;
+    }
+
+  stmt_ndx--;
+  if (stmt_ndx < 0 || stmt_ndx >= session->dimension || session->statements[stmt_ndx] == NULL
+      || session->stage[stmt_ndx] < StatementPreparedStage)
+    {
+      return NULL;
+    }
+
+  parser = session->parser;
+  statement = session->statements[stmt_ndx];
+
+  if (statement->node_type != PT_INSERT || statement->xasl_id == NULL || statement->cannot_prepare
+      || prm_get_integer_value (PRM_ID_XASL_CACHE_MAX_ENTRIES) <= 0)
+    {
+      return NULL;
+    }
+
+  /* values fetched from the server before each execution, and results fetched after it, need a request per row */
+  if (statement->si_datetime || statement->si_tran_id || parser->return_generated_keys)
+    {
+      return NULL;
+    }
+
+  if (statement->info.insert.server_allowed != SERVER_INSERT_IS_ALLOWED)
+    {
+      return NULL;
+    }
+
+  return statement;
+}
+
+/*
+ * db_can_execute_array() - Can the statement be executed for an array of host variable rows in one request to the
+ *			    server?
+ * return : true if db_execute_array() can be used
+ * session(in) : contains the SQL query that has been compiled
+ * stmt_ndx(in) : int returned by a successful compilation
+ *
+ * note : only INSERT statements prepared in XASL cache and executed on the server are executed as arrays; for others,
+ *	  the statement is executed once for each row.
+ */
+bool
+db_can_execute_array (DB_SESSION * session, int stmt_ndx)
+{
+  return (db_get_array_insert (session, stmt_ndx) != NULL && session->parser->host_var_count > 0);
+}
+
+/*
+ * db_execute_array() - This function executes the statement once for each row of host variables, in one request to
+ *			the server. Each row is executed as a separate statement.
+ * return : error status, if the execution of the array stopped before the last row
+ * session(in) : contains the SQL query that has been compiled
+ * stmt_ndx(in) : int returned by a successful compilation
+ * n_rows(in) : number of rows
+ * values(in) : host variables of all rows, row after row
+ * row_results(out) : per row, number of affected objects or error code
+ * row_messages(out) : per row, error message or NULL; free it with free ()
+ * n_executed(out) : number of rows executed; the rows from n_executed on were not executed, the returned error
+ *		     stopped the execution at that row
+ *
+ * note : db_can_execute_array() must be true for the statement. The caller commits in auto-commit mode.
+ */
+int
+db_execute_array (DB_SESSION * session, int stmt_ndx, int n_rows, DB_VALUE * values, int *row_results,
+		  char **row_messages, int *n_executed)
+{
+  PARSER_CONTEXT *parser;
+  PT_NODE *statement;
+  DB_VALUE *row_values = NULL;
+  int *row_map = NULL;
+  int *packed_results = NULL;
+  char **packed_messages = NULL;
+  int host_var_count, value_count;
+  int n_packed = 0, n_packed_executed = 0;
+  int row, i;
+  int err = NO_ERROR;
+
+  CHECK_CONNECT_MINUSONE ();
+
+  assert (db_can_execute_array (session, stmt_ndx));
+
+  *n_executed = 0;
+  if (n_rows <= 0)
+    {
+      return NO_ERROR;
+    }
+
+  parser = session->parser;
+  statement = session->statements[stmt_ndx - 1];
+  host_var_count = parser->host_var_count;
+  value_count = parser->host_var_count + parser->auto_param_count;
+
+  row_values = (DB_VALUE *) malloc (n_rows * value_count * sizeof (DB_VALUE));
+  row_map = (int *) malloc (n_rows * sizeof (int));
+  packed_results = (int *) malloc (n_rows * sizeof (int));
+  packed_messages = (char **) malloc (n_rows * sizeof (char *));
+  if (row_values == NULL || row_map == NULL || packed_results == NULL || packed_messages == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, n_rows * value_count * sizeof (DB_VALUE));
+      err = ER_OUT_OF_VIRTUAL_MEMORY;
+      goto end;
+    }
+
+  /* coerce the host variables of each row; the rows that fail are not sent to the server */
+  for (row = 0; row < n_rows; row++)
+    {
+      row_messages[row] = NULL;
+
+      err = db_push_values (session, host_var_count, values + row * host_var_count);
+      if (err == NO_ERROR && parser->set_host_var == 0)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_UCI_TOO_FEW_HOST_VARS, 0);
+	  err = ER_UCI_TOO_FEW_HOST_VARS;
+	}
+      if (err != NO_ERROR)
+	{
+	  row_results[row] = err;
+	  row_messages[row] = strdup (er_msg ());
+	  er_clear ();
+	  pt_reset_error (parser);
+	  err = NO_ERROR;
+	  continue;
+	}
+
+      for (i = 0; i < value_count; i++)
+	{
+	  pr_clone_value (&parser->host_variables[i], &row_values[n_packed * value_count + i]);
+	}
+      row_map[n_packed++] = row;
+    }
+
+  if (n_packed > 0)
+    {
+      er_clear ();
+      assert (parser->query_id == NULL_QUERY_ID);
+      parser->is_in_and_list = false;
+
+      db_invalidate_mvcc_snapshot_before_statement ();
+
+      err = do_execute_insert_array (parser, statement, n_packed, row_values, packed_results, packed_messages,
+				     &n_packed_executed);
+
+      db_set_read_fetch_instance_version (LC_FETCH_MVCC_VERSION);
+
+      session->stage[stmt_ndx - 1] = StatementExecutedStage;
+    }
+
+  for (i = 0; i < n_packed_executed; i++)
+    {
+      row_results[row_map[i]] = packed_results[i];
+      row_messages[row_map[i]] = packed_messages[i];
+    }
+
+  if (n_packed_executed < n_packed)
+    {
+      assert (err != NO_ERROR);
+
+      /* rows from the one that stopped the execution were not executed */
+      *n_executed = row_map[n_packed_executed];
+      for (row = *n_executed; row < n_rows; row++)
+	{
+	  if (row_messages[row] != NULL)
+	    {
+	      free (row_messages[row]);
+	      row_messages[row] = NULL;
+	    }
+	}
+    }
+  else
+    {
+      *n_executed = n_rows;
+      err = NO_ERROR;
+    }
+
+end:
+  if (row_values != NULL)
+    {
+      for (i = 0; i < n_packed * value_count; i++)
+	{
+	  pr_clear_value (&row_values[i]);
+	}
+      free (row_values);
+    }
+  if (row_map != NULL)
+    {
+      free (row_map);
+    }
+  if (packed_results != NULL)
+    {
+      free (packed_results);
+    }
+  if (packed_messages != NULL)
+    {
+      free (packed_messages);
+    }
+
+  return err;
+}
+
+/*
+ * db_can_execute_batch_array() - Can the statement of a batch entry be executed in one request to the server, with
+ *				  the statement of the first entry of an array?
+ * return : true if db_execute_batch_array() can execute the two statements together
+ * first_session(in) : the first entry of the array
+ * first_stmt_ndx(in) : int returned by the compilation of the first entry
+ * session(in) : the entry to add to the array; the first entry itself to check if it can start an array
+ * stmt_ndx(in) : int returned by a successful compilation
+ *
+ * note : batch entries have no host variables. The values of an INSERT are auto-parameterized, so INSERT entries
+ *	  that differ only by their values share the XASL of the first entry; the rows of the array are their auto
+ *	  parameters.
+ */
+bool
+db_can_execute_batch_array (DB_SESSION * first_session, int first_stmt_ndx, DB_SESSION * session, int stmt_ndx)
+{
+  PT_NODE *first_statement, *statement;
+
+  first_statement = db_get_array_insert (first_session, first_stmt_ndx);
+  statement = db_get_array_insert (session, stmt_ndx);
+  if (first_statement == NULL || statement == NULL)
+    {
+      return false;
+    }
+
+  if (first_session->parser->host_var_count > 0 || session->parser->host_var_count > 0
+      || first_session->parser->auto_param_count <= 0
+      || session->parser->auto_param_count != first_session->parser->auto_param_count)
+    {
+      return false;
+    }
+
+  return XASL_ID_EQ (statement->xasl_id, first_statement->xasl_id);
+}
+
+/*
+ * db_execute_batch_array() - This function executes the statements of an array of batch entries in one request to
+ *			      the server. Each entry is executed as a separate statement.
+ * return : error status, if the execution of the array stopped before the last entry
+ * sessions(in) : the compiled entries; db_can_execute_batch_array() is true for each of them with the first one
+ * stmt_ndxs(in) : int returned by the compilation of each entry
+ * n_rows(in) : number of entries
+ * row_results(out) : per entry, number of affected objects or error code
+ * row_messages(out) : per entry, error message or NULL; free it with free ()
+ * n_executed(out) : number of entries executed; the entries from n_executed on were not executed, the returned
+ *		     error stopped the execution at that entry
+ *
+ * note : The XASL of the first entry is executed with the auto parameters of each entry. The caller commits in
+ *	  auto-commit mode.
+ */
+int
+db_execute_batch_array (DB_SESSION ** sessions, const int *stmt_ndxs, int n_rows, int *row_results,
+			char **row_messages, int *n_executed)
+{
+  PARSER_CONTEXT *parser;
+  PT_NODE *statement;
+  DB_VALUE *row_values = NULL;
+  int value_count;
+  int row, i;
+  int err = NO_ERROR;
+
+  CHECK_CONNECT_MINUSONE ();
+
+  *n_executed = 0;
+  if (n_rows <= 0)
+    {
+      return NO_ERROR;
+    }
+
+  parser = sessions[0]->parser;
+  statement = sessions[0]->statements[stmt_ndxs[0] - 1];
+  value_count = parser->auto_param_count;
+
+  row_values = (DB_VALUE *) malloc (n_rows * value_count * sizeof (DB_VALUE));
+  if (row_values == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, n_rows * value_count * sizeof (DB_VALUE));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  /* the auto parameters of each entry are its row */
+  for (row = 0; row < n_rows; row++)
+    {
+      assert (db_can_execute_batch_array (sessions[0], stmt_ndxs[0], sessions[row], stmt_ndxs[row]));
+
+      for (i = 0; i < value_count; i++)
+	{
+	  pr_clone_value (&sessions[row]->parser->host_variables[i], &row_values[row * value_count + i]);
+	}
+      row_messages[row] = NULL;
+    }
+
+  er_clear ();
+  assert (parser->query_id == NULL_QUERY_ID);
+  parser->is_in_and_list = false;
+
+  db_invalidate_mvcc_snapshot_before_statement ();
+
+  err = do_execute_insert_array (parser, statement, n_rows, row_values, row_results, row_messages, n_executed);
+
+  db_set_read_fetch_instance_version (LC_FETCH_MVCC_VERSION);
+
+  for (row = 0; row < n_rows; row++)
+    {
+      sessions[row]->stage[stmt_ndxs[row] - 1] = StatementExecutedStage;
+    }
+
+  if (*n_executed == n_rows)
+    {
+      err = NO_ERROR;
+    }
+  else
+    {
+      assert (err != NO_ERROR);
+    }
+
+  for (i = 0; i < n_rows * value_count; i++)
+    {
+      pr_clear_value (&row_values[i]);
+    }
+  free (row_values);
+
+  return err;
+}
+
 /*
  * db_execute_statement_local() - This function executes the SQL statement
  *    identified by the stmt argument and returns the result. The
@@ -618,6 +618,12 @@ extern "C"
   extern int db_execute_statement (DB_SESSION * session, int stmt, DB_QUERY_RESULT ** result);
 
   extern int db_execute_and_keep_statement (DB_SESSION * session, int stmt, DB_QUERY_RESULT ** result);
+  extern bool db_can_execute_array (DB_SESSION * session, int stmt);
+  extern int db_execute_array (DB_SESSION * session, int stmt, int n_rows, DB_VALUE * values, int *row_results,
+			       char **row_messages, int *n_executed);
+  extern bool db_can_execute_batch_array (DB_SESSION * first_session, int first_stmt, DB_SESSION * session, int stmt);
+  extern int db_execute_batch_array (DB_SESSION ** sessions, const int *stmts, int n_rows, int *row_results,
+				     char **row_messages, int *n_executed);
   extern DB_CLASS_MODIFICATION_STATUS db_has_modified_class (DB_SESSION * session, int stmt_id);
 
   extern void db_invalidate_mvcc_snapshot_before_statement (void);
@@ -0,0 +1,453 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// connection_multiplexer - watch many sockets with a few epoll threads
+//
+
+#if defined (LINUX)
+
+#include "connection_multiplexer.hpp"
+
+#include "thread_daemon.hpp"
+#include "thread_entry_task.hpp"
+#include "thread_looper.hpp"
+#include "thread_manager.hpp"
+
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace cubconn
+{
+  // events returned by one epoll_wait
+  static const int MULTIPLEXER_MAX_EVENTS = 256;
+
+  struct multiplexer::watch
+  {
+    int m_fd;			// duplicate of socket
+    void *m_arg;
+    clock_type::time_point m_last_active;
+    std::size_t m_index;	// in m_watches of thread
+    io_thread *m_thread;
+    bool m_is_handed_off;	// accessed only by I/O thread
+  };
+
+  // io_task - one round of an I/O thread: wait for events until next tick, handle them and run the timers if it is time
+  class multiplexer::io_task : public cubthread::entry_task
+  {
+    public:
+      io_task (multiplexer &mux, io_thread &thread)
+	: m_mux (mux)
+	, m_thread (thread)
+      {
+      }
+
+      void execute (cubthread::entry &thread_ref) override
+      {
+	(void) thread_ref;	// unused
+
+	m_mux.execute (m_thread);
+      }
+
+    private:
+      multiplexer &m_mux;
+      io_thread &m_thread;
+  };
+
+  multiplexer::io_thread::io_thread ()
+    : m_epoll_fd (-1)
+    , m_wakeup_fd (-1)
+    , m_added_mutex ()
+    , m_added ()
+    , m_handed_back ()
+    , m_watches ()
+    , m_next_tick ()
+    , m_daemon (NULL)
+  {
+  }
+
+  multiplexer::multiplexer (std::size_t thread_count, std::chrono::milliseconds tick,
+			    std::chrono::milliseconds idle_interval, const handlers &handlers_arg)
+    : m_threads ()
+    , m_tick (tick)
+    , m_idle_interval (idle_interval)
+    , m_handlers (handlers_arg)
+    , m_next_thread (0)
+    , m_watched_count (0)
+    , m_handoff_mutex ()
+    , m_handoff_cond ()
+    , m_handoff_count (0)
+    , m_is_started (false)
+  {
+    assert (thread_count > 0);
+    assert (m_handlers.on_readable && m_handlers.on_timer && m_handlers.on_removed);
+
+    for (std::size_t i = 0; i < thread_count; i++)
+      {
+	m_threads.push_back (new io_thread ());
+      }
+  }
+
+  multiplexer::~multiplexer ()
+  {
+    stop ();
+
+    for (io_thread *thread : m_threads)
+      {
+	delete thread;
+      }
+  }
+
+  bool
+  multiplexer::start ()
+  {
+    assert (!m_is_started);
+    m_is_started = true;
+
+    for (io_thread *thread : m_threads)
+      {
+	epoll_event ev;
+
+	thread->m_epoll_fd = epoll_create1 (EPOLL_CLOEXEC);
+	if (thread->m_epoll_fd < 0)
+	  {
+	    stop ();
+	    return false;
+	  }
+
+	// level-triggered; cleared by the I/O thread. data.ptr is NULL to tell it from sockets
+	thread->m_wakeup_fd = eventfd (0, EFD_CLOEXEC | EFD_NONBLOCK);
+	ev.events = EPOLLIN;
+	ev.data.ptr = NULL;
+	if (thread->m_wakeup_fd < 0 || epoll_ctl (thread->m_epoll_fd, EPOLL_CTL_ADD, thread->m_wakeup_fd, &ev) != 0)
+	  {
+	    stop ();
+	    return false;
+	  }
+      }
+
+    for (io_thread *thread : m_threads)
+      {
+	thread->m_next_tick = clock_type::now () + m_tick;
+	// each round waits in epoll_wait; the looper must not wait more
+	thread->m_daemon =
+		cubthread::get_manager ()->create_daemon (cubthread::looper (std::chrono::milliseconds (0)),
+		    new io_task (*this, *thread), "connection_io");
+	if (thread->m_daemon == NULL)
+	  {
+	    stop ();
+	    return false;
+	  }
+      }
+
+    return true;
+  }
+
+  void
+  multiplexer::stop ()
+  {
+    if (!m_is_started)
+      {
+	return;
+      }
+
+    // a daemon stops after its current round, which is at most one tick
+    for (io_thread *thread : m_threads)
+      {
+	if (thread->m_daemon != NULL)
+	  {
+	    cubthread::get_manager ()->destroy_daemon (thread->m_daemon);
+	  }
+      }
+
+    // sockets handed off are still used by other threads
+    std::unique_lock<std::mutex> ulock (m_handoff_mutex);
+    m_handoff_cond.wait (ulock, [this] { return m_handoff_count == 0; });
+    ulock.unlock ();
+
+    for (io_thread *thread : m_threads)
+      {
+	take_added (*thread);
+	take_handed_back (*thread);
+	while (!thread->m_watches.empty ())
+	  {
+	    remove (*thread, thread->m_watches.back ());
+	  }
+
+	if (thread->m_wakeup_fd >= 0)
+	  {
+	    close (thread->m_wakeup_fd);
+	    thread->m_wakeup_fd = -1;
+	  }
+	if (thread->m_epoll_fd >= 0)
+	  {
+	    close (thread->m_epoll_fd);
+	    thread->m_epoll_fd = -1;
+	  }
+      }
+
+    m_is_started = false;
+  }
+
+  bool
+  multiplexer::add (int fd, void *arg)
+  {
+    io_thread &thread = *m_threads[m_next_thread++ % m_threads.size ()];
+    watch *w;
+    int dup_fd;
+
+    assert (m_is_started);
+
+    dup_fd = fcntl (fd, F_DUPFD_CLOEXEC, 0);
+    if (dup_fd < 0)
+      {
+	return false;
+      }
+
+    w = new watch ();
+    w->m_fd = dup_fd;
+    w->m_arg = arg;
+    w->m_last_active = clock_type::now ();
+    w->m_index = 0;
+    w->m_thread = &thread;
+    w->m_is_handed_off = false;
+
+    // register and publish under mutex; the I/O thread takes published watches before it handles their events
+    std::unique_lock<std::mutex> ulock (thread.m_added_mutex);
+    if (!arm (thread, w, EPOLL_CTL_ADD))
+      {
+	ulock.unlock ();
+	close (dup_fd);
+	delete w;
+	return false;
+      }
+    thread.m_added.push_back (w);
+    m_watched_count++;
+
+    return true;
+  }
+
+  void
+  multiplexer::end_handoff (watch *w, bool keep_watching)
+  {
+    io_thread &thread = *w->m_thread;
+    std::uint64_t one = 1;
+
+    std::unique_lock<std::mutex> ulock (thread.m_added_mutex);
+    thread.m_handed_back.emplace_back (w, keep_watching);
+    ulock.unlock ();
+
+    // the eventfd counter cannot overflow; a failed write means the I/O thread is already signaled
+    (void) write (thread.m_wakeup_fd, &one, sizeof (one));
+
+    // under mutex, so stop cannot return (and the multiplexer be destroyed) before this notification is done
+    std::lock_guard<std::mutex> lockg (m_handoff_mutex);
+    if (--m_handoff_count == 0)
+      {
+	m_handoff_cond.notify_all ();
+      }
+  }
+
+  std::size_t
+  multiplexer::get_thread_count () const
+  {
+    return m_threads.size ();
+  }
+
+  std::size_t
+  multiplexer::get_watched_count () const
+  {
+    return m_watched_count.load ();
+  }
+
+  void
+  multiplexer::execute (io_thread &thread)
+  {
+    epoll_event events[MULTIPLEXER_MAX_EVENTS];
+    clock_type::time_point now = clock_type::now ();
+    watch *w;
+    int wait_msecs;
+    int n, i;
+
+    wait_msecs = (int) std::chrono::duration_cast<std::chrono::milliseconds> (thread.m_next_tick - now).count ();
+    n = epoll_wait (thread.m_epoll_fd, events, MULTIPLEXER_MAX_EVENTS, wait_msecs > 0 ? wait_msecs : 0);
+    if (n < 0)
+      {
+	assert (errno == EINTR);
+	n = 0;
+      }
+
+    take_added (thread);
+    now = clock_type::now ();
+
+    for (i = 0; i < n; i++)
+      {
+	w = (watch *) events[i].data.ptr;
+	if (w == NULL)
+	  {
+	    // sockets were handed back; they are taken below
+	    std::uint64_t count;
+	    (void) read (thread.m_wakeup_fd, &count, sizeof (count));
+	    continue;
+	  }
+
+	w->m_last_active = now;
+
+	// count the hand-off before the socket can be handed back
+	m_handoff_count++;
+	switch (m_handlers.on_readable (w->m_arg, w))
+	  {
+	  case read_action::HANDED_OFF:
+	    w->m_is_handed_off = true;
+	    break;
+
+	  case read_action::REARM:
+	    m_handoff_count--;
+	    if (!arm (thread, w, EPOLL_CTL_MOD))
+	      {
+		remove (thread, w);
+	      }
+	    break;
+
+	  case read_action::REMOVE:
+	  default:
+	    m_handoff_count--;
+	    remove (thread, w);
+	    break;
+	  }
+      }
+
+    take_handed_back (thread);
+
+    now = clock_type::now ();
+    if (now >= thread.m_next_tick)
+      {
+	on_tick (thread, now);
+	thread.m_next_tick = now + m_tick;
+      }
+  }
+
+  void
+  multiplexer::take_added (io_thread &thread)
+  {
+    std::unique_lock<std::mutex> ulock (thread.m_added_mutex);
+
+    for (watch *w : thread.m_added)
+      {
+	w->m_index = thread.m_watches.size ();
+	thread.m_watches.push_back (w);
+      }
+    thread.m_added.clear ();
+  }
+
+  void
+  multiplexer::take_handed_back (io_thread &thread)
+  {
+    std::vector<std::pair<watch *, bool>> handed_back;
+
+    std::unique_lock<std::mutex> ulock (thread.m_added_mutex);
+    handed_back.swap (thread.m_handed_back);
+    ulock.unlock ();
+
+    for (const std::pair<watch *, bool> &it : handed_back)
+      {
+	watch *w = it.first;
+
+	assert (w->m_is_handed_off);
+	w->m_is_handed_off = false;
+	w->m_last_active = clock_type::now ();
+	if (!it.second || !arm (thread, w, EPOLL_CTL_MOD))
+	  {
+	    remove (thread, w);
+	  }
+      }
+  }
+
+  void
+  multiplexer::on_tick (io_thread &thread, clock_type::time_point now)
+  {
+    std::size_t index = 0;
+    watch *w;
+    bool is_idle;
+
+    while (index < thread.m_watches.size ())
+      {
+	w = thread.m_watches[index];
+	if (w->m_is_handed_off)
+	  {
+	    // its reader is busy with it
+	    index++;
+	    continue;
+	  }
+
+	is_idle = (now - w->m_last_active >= m_idle_interval);
+	if (is_idle)
+	  {
+	    // start next idle interval
+	    w->m_last_active = now;
+	  }
+
+	if (!m_handlers.on_timer (w->m_arg, is_idle))
+	  {
+	    // last watch is moved to index
+	    remove (thread, w);
+	    continue;
+	  }
+	index++;
+      }
+  }
+
+  void
+  multiplexer::remove (io_thread &thread, watch *w)
+  {
+    watch *last;
+
+    assert (w->m_index < thread.m_watches.size () && thread.m_watches[w->m_index] == w);
+
+    (void) epoll_ctl (thread.m_epoll_fd, EPOLL_CTL_DEL, w->m_fd, NULL);
+    close (w->m_fd);
+
+    last = thread.m_watches.back ();
+    last->m_index = w->m_index;
+    thread.m_watches[w->m_index] = last;
+    thread.m_watches.pop_back ();
+
+    m_watched_count--;
+    m_handlers.on_removed (w->m_arg);
+    delete w;
+  }
+
+  bool
+  multiplexer::arm (io_thread &thread, watch *w, int op)
+  {
+    epoll_event ev;
+
+    ev.events = EPOLLIN | EPOLLRDHUP | EPOLLET | EPOLLONESHOT;
+    ev.data.ptr = w;
+    return epoll_ctl (thread.m_epoll_fd, op, w->m_fd, &ev) == 0;
+  }
+} // namespace cubconn
+
+#endif // LINUX
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// connection_multiplexer - watch many sockets with a few epoll threads
+//
+//  how it works:
+//    each I/O thread has its own epoll instance; sockets are spread over threads when they are added. a socket is
+//    registered edge-triggered and one-shot: when it becomes readable, its thread calls on_readable once and then
+//    arms the socket again. arming checks readiness again, so a socket with more data pending is reported in next
+//    round, after the other ready sockets of thread had their turn.
+//
+//    every tick, a thread calls on_timer for each of its sockets. is_idle is set once for a socket that had no data
+//    for the idle interval; this is where slow checks (e.g. is the peer alive) are started. callbacks run on the I/O
+//    thread and must not block for long; everything that may wait is handed over to other threads.
+//
+//    the multiplexer registers a duplicate of the socket, which is closed when the socket is removed. the owner may
+//    close its socket at any time; the number of the duplicate cannot be reused by another socket while the
+//    multiplexer still watches it.
+//
+//    reading a socket may block (e.g. the peer sent only part of a packet), so on_readable may hand the socket off to
+//    another thread that does the reading. a socket handed off is not armed and not checked by on_timer until that
+//    thread calls end_handoff; the I/O thread is woken up to arm it again or remove it. stop waits for sockets still
+//    handed off.
+//
+//    callbacks of a socket are always called by the same thread, one at a time. on_removed is the last one. I/O
+//    threads are daemons of thread manager, so callbacks have a thread entry.
+//
+
+#ifndef _CONNECTION_MULTIPLEXER_HPP_
+#define _CONNECTION_MULTIPLEXER_HPP_
+
+#if !defined (LINUX)
+#error epoll multiplexer is only available on linux
+#endif // !LINUX
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// forward definitions
+namespace cubthread
+{
+  class daemon;
+}
+
+namespace cubconn
+{
+  class multiplexer
+  {
+    public:
+      using clock_type = std::chrono::steady_clock;
+
+      // a watched socket, as seen by its owner
+      struct watch;
+
+      // what to do with a socket after on_readable
+      enum class read_action
+      {
+	REARM,		// watch socket for more data
+	REMOVE,		// stop watching socket
+	HANDED_OFF	// socket is read by another thread, which calls end_handoff when it is done
+      };
+
+      // callbacks; arg is the argument the socket was added with
+      struct handlers
+      {
+	// socket has data (or was closed by peer); w is needed only to hand the socket off
+	std::function<read_action (void *arg, watch *w)> on_readable;
+	// called every tick; return false to stop watching socket
+	std::function<bool (void *arg, bool is_idle)> on_timer;
+	// socket is no longer watched; arg can be released
+	std::function<void (void *arg)> on_removed;
+      };
+
+      multiplexer (std::size_t thread_count, std::chrono::milliseconds tick, std::chrono::milliseconds idle_interval,
+		   const handlers &handlers_arg);
+      multiplexer (const multiplexer &) = delete;
+      multiplexer &operator= (const multiplexer &) = delete;
+      ~multiplexer ();
+
+      // create epoll instances and I/O daemons; false if they cannot be created
+      bool start ();
+      // stop I/O daemons; sockets still watched are removed and on_removed is called for each
+      void stop ();
+
+      // start watching socket; false if it cannot be watched (on_removed is not called)
+      bool add (int fd, void *arg);
+      // the thread a socket was handed off to is done reading it; may be called from any thread
+      void end_handoff (watch *w, bool keep_watching);
+
+      std::size_t get_thread_count () const;
+      std::size_t get_watched_count () const;
+
+    private:
+      struct io_thread
+      {
+	int m_epoll_fd;
+	int m_wakeup_fd;		// eventfd in m_epoll_fd, signaled when a socket is handed back
+	std::mutex m_added_mutex;
+	std::vector<watch *> m_added;	// added by other threads, not yet seen by I/O thread
+	std::vector<std::pair<watch *, bool>> m_handed_back;	// socket and keep_watching, protected by m_added_mutex
+	std::vector<watch *> m_watches;	// accessed only by I/O thread
+	clock_type::time_point m_next_tick;
+	cubthread::daemon *m_daemon;
+
+	io_thread ();
+      };
+
+      class io_task;
+
+      void execute (io_thread &thread);
+      void take_added (io_thread &thread);
+      void take_handed_back (io_thread &thread);
+      void on_tick (io_thread &thread, clock_type::time_point now);
+      void remove (io_thread &thread, watch *w);
+      static bool arm (io_thread &thread, watch *w, int op);
+
+      std::vector<io_thread *> m_threads;
+      std::chrono::milliseconds m_tick;
+      std::chrono::milliseconds m_idle_interval;
+      handlers m_handlers;
+      std::atomic<std::size_t> m_next_thread;
+      std::atomic<std::size_t> m_watched_count;
+      std::mutex m_handoff_mutex;
+      std::condition_variable m_handoff_cond;
+      std::atomic<int> m_handoff_count;	// sockets handed off and not handed back yet
+      bool m_is_started;
+  };
+} // namespace cubconn
+
+#endif // _CONNECTION_MULTIPLEXER_HPP_
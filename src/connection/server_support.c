@@ -27,6 +27,9 @@
 
 #include "config.h"
 #include "communication_server_channel.hpp"
+#if defined (LINUX)
+#include "connection_multiplexer.hpp"
+#endif /* LINUX */
 #include "internal_tasks_worker_pool.hpp"
 #include "log_append.hpp"
 #include "multi_thread_stream.hpp"
@@ -101,6 +104,14 @@
 
 #define RMUTEX_NAME_TEMP_CONN_ENTRY "TEMP_CONN_ENTRY"
 
+/* connection handling: how often the connection is checked, and how long it may stay idle before its peer is checked */
+#define CSS_CONN_CHECK_MSECS 100
+#define CSS_PEER_ALIVE_TIMEOUT_MSECS 5000
+
+/* connection workers when connections are watched by I/O threads; they read packets, close connections and check
+ * peers */
+#define CSS_CONN_MULTIPLEXER_WORKERS 64
+
 static struct timeval css_Shutdown_timeout = { 0, 0 };
 
 static char *css_Master_server_name = NULL;	/* database identifier */
@@ -209,6 +220,92 @@ private:
   CSS_CONN_ENTRY &m_conn;
 };
 
+#if defined (LINUX)
+// client connections are watched by I/O threads if connection_io_threads is not 0
+static cubconn::multiplexer *css_Conn_multiplexer = NULL;
+static bool css_Conn_multiplexer_is_stopping = false;
+
+// css_conn_io_state - client connection watched by css_Conn_multiplexer
+struct css_conn_io_state
+{
+  CSS_CONN_ENTRY *m_conn;
+  int m_status;                       // status the connection is closed with
+  std::atomic<int> m_ref_count;       // held by multiplexer, by running read and by running peer check
+  std::atomic<bool> m_is_peer_checked;
+  std::atomic<bool> m_is_peer_dead;
+
+  css_conn_io_state (CSS_CONN_ENTRY *conn)
+  : m_conn (conn)
+  , m_status (NO_ERRORS)
+  , m_ref_count (1)
+  , m_is_peer_checked (false)
+  , m_is_peer_dead (false)
+  {
+  }
+};
+
+// css_connection_close_task - close a connection that is no longer watched by css_Conn_multiplexer
+class css_connection_close_task : public cubthread::entry_task
+{
+public:
+
+  css_connection_close_task (void) = delete;
+
+  css_connection_close_task (CSS_CONN_ENTRY &conn, int status)
+  : m_conn (conn)
+  , m_status (status)
+  {
+  }
+
+  void execute (context_type &thread_ref) override final;
+
+private:
+  CSS_CONN_ENTRY &m_conn;
+  int m_status;
+};
+
+// css_connection_read_task - read a packet from a connection handed off by its I/O thread; it may wait for the rest of
+//                            a partial packet
+class css_connection_read_task : public cubthread::entry_task
+{
+public:
+
+  css_connection_read_task (void) = delete;
+
+  css_connection_read_task (css_conn_io_state &state, cubconn::multiplexer::watch *w)
+  : m_state (state)
+  , m_watch (w)
+  {
+  }
+
+  void execute (context_type &thread_ref) override final;
+
+private:
+  css_conn_io_state &m_state;
+  cubconn::multiplexer::watch *m_watch;
+};
+
+// css_peer_check_task - check if the peer of an idle connection is alive; it may wait for long
+class css_peer_check_task : public cubthread::entry_task
+{
+public:
+
+  css_peer_check_task (void) = delete;
+
+  css_peer_check_task (css_conn_io_state &state, SOCKET fd)
+  : m_state (state)
+  , m_fd (fd)
+  {
+  }
+
+  void execute (context_type &thread_ref) override final;
+
+private:
+  css_conn_io_state &m_state;
+  SOCKET m_fd;
+};
+#endif /* LINUX */
+
 static const size_t CSS_JOB_QUEUE_SCAN_COLUMN_COUNT = 4;
 
 static void css_setup_server_loop (void);
@@ -227,6 +324,16 @@ static void css_process_get_eof_request (SOCKET master_fd);
 static void css_close_connection_to_master (void);
 static int css_reestablish_connection_to_master (void);
 static int css_connection_handler_thread (THREAD_ENTRY * thrd, CSS_CONN_ENTRY * conn);
+static int css_get_conn_status (THREAD_ENTRY * thread_p, CSS_CONN_ENTRY * conn);
+static void css_end_connection_handler (THREAD_ENTRY * thread_p, CSS_CONN_ENTRY * conn, int status);
+#if defined (LINUX)
+static cubconn::multiplexer::read_action css_conn_io_on_readable (void *arg, cubconn::multiplexer::watch * w);
+static bool css_conn_io_on_timer (void *arg, bool is_idle);
+static void css_conn_io_on_removed (void *arg);
+static void css_release_conn_io_state (css_conn_io_state * state);
+static void css_start_conn_multiplexer (void);
+static void css_stop_conn_multiplexer (void);
+#endif /* LINUX */
 static css_error_code css_internal_connection_handler (CSS_CONN_ENTRY * conn);
 static int css_internal_request_handler (THREAD_ENTRY & thread_ref, CSS_CONN_ENTRY & conn_ref);
 static int css_test_for_client_errors (CSS_CONN_ENTRY * conn, unsigned int eid);
@@ -263,6 +370,7 @@ static bool css_get_connection_thread_pooling_configuration (void);
 static cubthread::wait_seconds css_get_connection_thread_timeout_configuration (void);
 static bool css_get_server_request_thread_pooling_configuration (void);
 static cubthread::wait_seconds css_get_server_request_thread_timeout_configuration (void);
+static bool css_get_server_request_thread_stealing_configuration (void);
 // *INDENT-ON*
 
 #if defined (SERVER_MODE)
@@ -1050,9 +1158,8 @@ css_reestablish_connection_to_master (void)
 static int
 css_connection_handler_thread (THREAD_ENTRY * thread_p, CSS_CONN_ENTRY * conn)
 {
-  int n, type, rv, status;
-  volatile int conn_status;
-  int css_peer_alive_timeout, poll_timeout;
+  int n, type, status;
+  int conn_status;
   int max_num_loop, num_loop;
   SOCKET fd;
   struct pollfd po[1] = { {0, 0, 0} };
@@ -1068,9 +1175,7 @@ css_connection_handler_thread (THREAD_ENTRY * thread_p, CSS_CONN_ENTRY * conn)
 
   thread_p->type = TT_SERVER;	/* server thread */
 
-  css_peer_alive_timeout = 5000;
-  poll_timeout = 100;
-  max_num_loop = css_peer_alive_timeout / poll_timeout;
+  max_num_loop = CSS_PEER_ALIVE_TIMEOUT_MSECS / CSS_CONN_CHECK_MSECS;
   num_loop = 0;
 
   status = NO_ERRORS;
@@ -1078,22 +1183,7 @@ css_connection_handler_thread (THREAD_ENTRY * thread_p, CSS_CONN_ENTRY * conn)
   while (thread_p->shutdown == false && conn->stop_talk == false)
     {
       /* check the connection */
-      conn_status = conn->status;
-      if (conn_status == CONN_CLOSING)
-	{
-	  /* There's an interesting race condition among client, worker thread and connection handler.
-	   * Please find CBRD-21375 for detail and also see sboot_notify_unregister_client.
-	   *
-	   * We have to synchronize here with worker thread which may be in sboot_notify_unregister_client
-	   * to let it have a chance to send reply to client.
-	   */
-	  rmutex_lock (thread_p, &conn->rmutex);
-
-	  conn_status = conn->status;
-
-	  rmutex_unlock (thread_p, &conn->rmutex);
-	}
-
+      conn_status = css_get_conn_status (thread_p, conn);
       if (conn_status != CONN_OPEN)
 	{
 	  er_log_debug (ARG_FILE_LINE, "css_connection_handler_thread: conn->status (%d) is not CONN_OPEN.",
@@ -1105,7 +1195,7 @@ css_connection_handler_thread (THREAD_ENTRY * thread_p, CSS_CONN_ENTRY * conn)
       po[0].fd = fd;
       po[0].events = POLLIN;
       po[0].revents = 0;
-      n = poll (po, 1, poll_timeout);
+      n = poll (po, 1, CSS_CONN_CHECK_MSECS);
       if (n == 0)
 	{
 	  if (num_loop < max_num_loop)
@@ -1119,7 +1209,7 @@ css_connection_handler_thread (THREAD_ENTRY * thread_p, CSS_CONN_ENTRY * conn)
 	  /* 0 means it timed out and no fd is changed. */
 	  if (CHECK_CLIENT_IS_ALIVE ())
 	    {
-	      if (css_peer_alive (fd, css_peer_alive_timeout) == false)
+	      if (css_peer_alive (fd, CSS_PEER_ALIVE_TIMEOUT_MSECS) == false)
 		{
 		  er_log_debug (ARG_FILE_LINE, "css_connection_handler_thread: css_peer_alive() error\n");
 		  status = CONNECTION_CLOSED;
@@ -1181,6 +1271,53 @@ css_connection_handler_thread (THREAD_ENTRY * thread_p, CSS_CONN_ENTRY * conn)
 	}
     }
 
+  css_end_connection_handler (thread_p, conn, status);
+
+  return 0;
+}
+
+/*
+ * css_get_conn_status () - get the status of a client connection
+ *   return: CONN_OPEN, CONN_CLOSED or CONN_CLOSING
+ *   thread_p(in):
+ *   conn(in): client connection
+ */
+static int
+css_get_conn_status (THREAD_ENTRY * thread_p, CSS_CONN_ENTRY * conn)
+{
+  volatile int conn_status;
+
+  conn_status = conn->status;
+  if (conn_status == CONN_CLOSING)
+    {
+      /* There's an interesting race condition among client, worker thread and connection handler.
+       * Please find CBRD-21375 for detail and also see sboot_notify_unregister_client.
+       *
+       * We have to synchronize here with worker thread which may be in sboot_notify_unregister_client
+       * to let it have a chance to send reply to client.
+       */
+      rmutex_lock (thread_p, &conn->rmutex);
+
+      conn_status = conn->status;
+
+      rmutex_unlock (thread_p, &conn->rmutex);
+    }
+
+  return conn_status;
+}
+
+/*
+ * css_end_connection_handler () - client connection is no longer handled; call connection error handler if needed
+ *   return:
+ *   thread_p(in):
+ *   conn(in): client connection
+ *   status(in): status the connection handling ended with
+ */
+static void
+css_end_connection_handler (THREAD_ENTRY * thread_p, CSS_CONN_ENTRY * conn, int status)
+{
+  int rv;
+
   /* check the connection and call connection error handler */
   if (status != NO_ERRORS || css_check_conn (conn) != NO_ERROR)
     {
@@ -1195,9 +1332,193 @@ css_connection_handler_thread (THREAD_ENTRY * thread_p, CSS_CONN_ENTRY * conn)
     {
       assert (thread_p->shutdown == true || conn->stop_talk == true);
     }
+}
 
-  return 0;
+#if defined (LINUX)
+/*
+ * css_conn_io_on_readable () - hand a client connection that has data off to a connection worker
+ *   return: what I/O thread should do with the connection
+ *   arg(in): connection state
+ *   w(in): connection watch, handed back by the worker
+ *
+ * Note: css_read_and_queue blocks until the whole packet is read; if the client sent only part of it, reading on the
+ *       I/O thread would stall all its other connections. the worker does what css_connection_handler_thread does
+ *       when the socket has data, and the connection is not watched meanwhile.
+ */
+static cubconn::multiplexer::read_action
+css_conn_io_on_readable (void *arg, cubconn::multiplexer::watch * w)
+{
+  css_conn_io_state *state = (css_conn_io_state *) arg;
+  CSS_CONN_ENTRY *conn = state->m_conn;
+  THREAD_ENTRY *thread_p = thread_get_thread_entry_info ();
+  int conn_status;
+
+  if (conn->stop_talk == true)
+    {
+      state->m_status = NO_ERRORS;
+      return cubconn::multiplexer::read_action::REMOVE;
+    }
+
+  conn_status = css_get_conn_status (thread_p, conn);
+  if (conn_status != CONN_OPEN)
+    {
+      er_log_debug (ARG_FILE_LINE, "css_conn_io_on_readable: conn->status (%d) is not CONN_OPEN.", conn_status);
+      state->m_status = CONNECTION_CLOSED;
+      return cubconn::multiplexer::read_action::REMOVE;
+    }
+
+  state->m_ref_count++;
+  cubthread::get_manager ()->push_task (css_Connection_worker_pool, new css_connection_read_task (*state, w));
+  return cubconn::multiplexer::read_action::HANDED_OFF;
+}
+
+/*
+ * css_conn_io_on_timer () - check a client connection watched by I/O thread
+ *   return: false to stop watching the connection
+ *   arg(in): connection state
+ *   is_idle(in): the connection had no data for CSS_PEER_ALIVE_TIMEOUT_MSECS
+ *
+ * Note: same as one round of css_connection_handler_thread when poll times out. the peer is checked by connection
+ *       workers, since it may take as long as the timeout.
+ */
+static bool
+css_conn_io_on_timer (void *arg, bool is_idle)
+{
+  css_conn_io_state *state = (css_conn_io_state *) arg;
+  CSS_CONN_ENTRY *conn = state->m_conn;
+  THREAD_ENTRY *thread_p = thread_get_thread_entry_info ();
+  int conn_status;
+
+  if (conn->stop_talk == true)
+    {
+      state->m_status = NO_ERRORS;
+      return false;
+    }
+
+  conn_status = css_get_conn_status (thread_p, conn);
+  if (conn_status != CONN_OPEN)
+    {
+      er_log_debug (ARG_FILE_LINE, "css_conn_io_on_timer: conn->status (%d) is not CONN_OPEN.", conn_status);
+      state->m_status = CONNECTION_CLOSED;
+      return false;
+    }
+
+  if (state->m_is_peer_dead)
+    {
+      er_log_debug (ARG_FILE_LINE, "css_conn_io_on_timer: css_peer_alive() error\n");
+      state->m_status = CONNECTION_CLOSED;
+      return false;
+    }
+
+  if (!is_idle)
+    {
+      return true;
+    }
+
+  if (CHECK_CLIENT_IS_ALIVE () && !state->m_is_peer_checked.exchange (true))
+    {
+      state->m_ref_count++;
+      cubthread::get_manager ()->push_task (css_Connection_worker_pool, new css_peer_check_task (*state, conn->fd));
+    }
+
+  /* check server's HA state */
+  if (css_ha_server_state () == HA_SERVER_STATE_TO_BE_STANDBY && conn->in_transaction == false
+      && css_count_transaction_worker_threads (thread_p, conn->get_tran_index (), conn->client_id) == 0)
+    {
+      state->m_status = REQUEST_REFUSED;
+      return false;
+    }
+
+  return true;
+}
+
+/*
+ * css_conn_io_on_removed () - client connection is no longer watched by I/O thread
+ *   return:
+ *   arg(in): connection state
+ */
+static void
+css_conn_io_on_removed (void *arg)
+{
+  css_conn_io_state *state = (css_conn_io_state *) arg;
+
+  if (!css_Conn_multiplexer_is_stopping)
+    {
+      /* the connection error handler may abort the transaction; don't block I/O thread */
+      cubthread::get_manager ()->push_task (css_Connection_worker_pool,
+					    new css_connection_close_task (*state->m_conn, state->m_status));
+    }
+  css_release_conn_io_state (state);
+}
+
+/*
+ * css_release_conn_io_state () - release a reference to the state of a connection watched by I/O thread
+ *   return:
+ *   state(in): connection state
+ */
+static void
+css_release_conn_io_state (css_conn_io_state * state)
+{
+  if (--state->m_ref_count == 0)
+    {
+      delete state;
+    }
+}
+
+/*
+ * css_start_conn_multiplexer () - start I/O threads that watch client connections, if they are configured
+ *   return:
+ *
+ * Note: if they cannot be started, each connection has its own connection thread.
+ */
+static void
+css_start_conn_multiplexer (void)
+{
+  int thread_count = prm_get_integer_value (PRM_ID_CSS_IO_THREADS);
+  cubconn::multiplexer::handlers handlers;
+
+  if (thread_count <= 0)
+    {
+      return;
+    }
+
+  handlers.on_readable = css_conn_io_on_readable;
+  handlers.on_timer = css_conn_io_on_timer;
+  handlers.on_removed = css_conn_io_on_removed;
+
+  css_Conn_multiplexer_is_stopping = false;
+  css_Conn_multiplexer =
+    new cubconn::multiplexer ((size_t) thread_count, std::chrono::milliseconds (CSS_CONN_CHECK_MSECS),
+			      std::chrono::milliseconds (CSS_PEER_ALIVE_TIMEOUT_MSECS), handlers);
+  if (!css_Conn_multiplexer->start ())
+    {
+      er_log_debug (ARG_FILE_LINE, "css_start_conn_multiplexer: cannot start %d I/O threads; errno %d\n",
+		    thread_count, errno);
+      delete css_Conn_multiplexer;
+      css_Conn_multiplexer = NULL;
+    }
+}
+
+/*
+ * css_stop_conn_multiplexer () - stop I/O threads that watch client connections
+ *   return:
+ *
+ * Note: waits for packets that connection workers are still reading. connections still watched are then dropped
+ *       without being closed; the server is going down.
+ */
+static void
+css_stop_conn_multiplexer (void)
+{
+  if (css_Conn_multiplexer == NULL)
+    {
+      return;
+    }
+
+  css_Conn_multiplexer_is_stopping = true;
+  delete css_Conn_multiplexer;
+  css_Conn_multiplexer = NULL;
 }
+#endif /* LINUX */
 
 /*
  * css_block_all_active_conn() - Before shutdown, stop all server thread
@@ -1248,8 +1569,26 @@ css_block_all_active_conn (unsigned short stop_phase)
 static css_error_code
 css_internal_connection_handler (CSS_CONN_ENTRY * conn)
 {
+#if defined (LINUX)
+  css_conn_io_state *state;
+#endif /* LINUX */
+
   css_insert_into_active_conn_list (conn);
 
+#if defined (LINUX)
+  if (css_Conn_multiplexer != NULL)
+    {
+      state = new css_conn_io_state (conn);
+      if (css_Conn_multiplexer->add (conn->fd, state))
+	{
+	  return NO_ERRORS;
+	}
+
+      /* socket cannot be watched; give it a connection thread */
+      delete state;
+    }
+#endif /* LINUX */
+
   // push connection handler task
   cubthread::get_manager ()->push_task (css_Connection_worker_pool, new css_connection_task (*conn));
 
@@ -1380,6 +1719,7 @@ css_init (THREAD_ENTRY * thread_p, char *server_name, int name_length, int port_
   const std::size_t MAX_WORKERS = css_get_max_conn () + 1;	// = css_Num_max_conn in connection_sr.c
   const std::size_t MAX_TASK_COUNT = 2 * MAX_WORKERS;	// not that it matters...
   const std::size_t MAX_CONNECTIONS = css_get_max_conn () + 1;
+  std::size_t connection_workers = MAX_CONNECTIONS;
 
   // create request worker pool
   css_Server_request_worker_pool =
@@ -1388,7 +1728,8 @@ css_init (THREAD_ENTRY * thread_p, char *server_name, int name_length, int port_
 						   cubthread::is_logging_configured
 						   (cubthread::LOG_WORKER_POOL_TRAN_WORKERS),
 						   css_get_server_request_thread_pooling_configuration (),
-						   css_get_server_request_thread_timeout_configuration ());
+						   css_get_server_request_thread_timeout_configuration (),
+						   css_get_server_request_thread_stealing_configuration ());
   if (css_Server_request_worker_pool == NULL)
     {
       assert (false);
@@ -1397,9 +1738,20 @@ css_init (THREAD_ENTRY * thread_p, char *server_name, int name_length, int port_
       goto shutdown;
     }
 
+#if defined (LINUX)
+  // watch client connections with I/O threads; connection threads are then only needed to read the packets, to close
+  // connections and to check their peers
+  css_start_conn_multiplexer ();
+  if (css_Conn_multiplexer != NULL)
+    {
+      connection_workers = MIN (MAX_CONNECTIONS, CSS_CONN_MULTIPLEXER_WORKERS);
+    }
+#endif /* LINUX */
+
   // create connection worker pool
   css_Connection_worker_pool =
-    cubthread::get_manager ()->create_worker_pool (MAX_CONNECTIONS, MAX_CONNECTIONS, "connection threads", NULL, 1,
+    cubthread::get_manager ()->create_worker_pool (connection_workers, 2 * MAX_CONNECTIONS, "connection threads",
+						   NULL, 1,
 						   cubthread::is_logging_configured
 						   (cubthread::LOG_WORKER_POOL_CONNECTIONS),
 						   css_get_connection_thread_pooling_configuration (),
@@ -1472,6 +1824,10 @@ shutdown:
   // stop log writers
   css_stop_all_workers (*thread_p, THREAD_STOP_LOGWR);
 
+#if defined (LINUX)
+  css_stop_conn_multiplexer ();
+#endif /* LINUX */
+
   if (prm_get_bool_value (PRM_ID_STATS_ON))
     {
       perfmon_er_log_current_stats (thread_p);
@@ -2573,6 +2929,7 @@ css_push_server_task (CSS_CONN_ENTRY &conn_ref)
   // note: cores are partitioned by connection index. this is particularly important in order to avoid having tasks
   //       randomly pushed to cores that are full. some of those tasks may belong to threads holding locks. as a
   //       consequence, lock waiters may wait longer or even indefinitely if we are really unlucky.
+  //       with work stealing, a task queued on a full core is taken by a free worker of another core.
   //
   thread_get_manager ()->push_task_on_core (css_Server_request_worker_pool, new css_server_task (conn_ref),
                                             static_cast<size_t> (conn_ref.idx));
@@ -2644,6 +3001,62 @@ css_connection_task::execute (context_type & thread_ref)
   thread_ref.clear_conn_session ();
 }
 
+#if defined (LINUX)
+void
+css_connection_close_task::execute (context_type &thread_ref)
+{
+  thread_ref.conn_entry = &m_conn;
+  thread_ref.type = TT_SERVER;
+
+  css_end_connection_handler (&thread_ref, &m_conn, m_status);
+
+  thread_ref.clear_conn_session ();
+}
+
+void
+css_connection_read_task::execute (context_type &thread_ref)
+{
+  CSS_CONN_ENTRY *conn = m_state.m_conn;
+  bool keep_watching = true;
+  int status;
+  int type;
+
+  (void) thread_ref;  // unused
+
+  /* read command/data/etc request from socket, and enqueue it to appr. queue */
+  status = css_read_and_queue (conn, &type);
+  if (status != NO_ERRORS)
+    {
+      er_log_debug (ARG_FILE_LINE, "css_connection_read_task: css_read_and_queue() error\n");
+      // the I/O thread closes the connection with this status
+      m_state.m_status = status;
+      keep_watching = false;
+    }
+  else if (type == COMMAND_TYPE)
+    {
+      css_push_server_task (*conn);
+    }
+
+  // the multiplexer is not destroyed before the connection is handed back
+  css_Conn_multiplexer->end_handoff (m_watch, keep_watching);
+  css_release_conn_io_state (&m_state);
+}
+
+void
+css_peer_check_task::execute (context_type &thread_ref)
+{
+  (void) thread_ref;  // unused
+
+  if (css_peer_alive (m_fd, CSS_PEER_ALIVE_TIMEOUT_MSECS) == false)
+    {
+      // the I/O thread closes the connection on its next check
+      m_state.m_is_peer_dead = true;
+    }
+  m_state.m_is_peer_checked = false;
+  css_release_conn_io_state (&m_state);
+}
+#endif /* LINUX */
+
 //
 // css_stop_non_log_writer () - function mapped over worker pools to search and stop non-log writer workers
 //
@@ -3100,6 +3513,12 @@ css_get_server_request_thread_timeout_configuration (void)
   return cubthread::wait_seconds (std::chrono::seconds (prm_get_integer_value (PRM_ID_THREAD_WORKER_TIMEOUT_SECONDS)));
 }
 
+static bool
+css_get_server_request_thread_stealing_configuration (void)
+{
+  return prm_get_bool_value (PRM_ID_THREAD_WORKER_STEALING);
+}
+
 void
 css_start_all_threads (void)
 {
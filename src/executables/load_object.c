@@ -36,6 +36,9 @@
 #include <ctype.h>
 #include <sys/stat.h>
 #include <math.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include "utility.h"
 #include "misc_string.h"
@@ -65,6 +68,25 @@
 #define MIGRATION_CHUNK 4096
 static char migration_buffer[MIGRATION_CHUNK];
 
+/*
+ * text_output_writer - writes the full buffers of a TEXT_OUTPUT while the
+ *                      next buffer is printed
+ */
+// *INDENT-OFF*
+struct text_output_writer
+{
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable cond;
+  char *spare_buffer;		/* buffer to print into next */
+  char *write_buffer;		/* buffer being written; NULL if writer is idle */
+  int write_count;
+  FILE *write_fp;
+  int error;			/* first write error */
+  bool shutdown;
+};
+// *INDENT-ON*
+
 static int object_disk_size (DESC_OBJ * obj, int *offset_size_ptr);
 static void put_varinfo (OR_BUF * buf, DESC_OBJ * obj, int offset_size);
 static void put_attributes (OR_BUF * buf, DESC_OBJ * obj);
@@ -73,6 +95,9 @@ static SM_ATTRIBUTE *find_current_attribute (SM_CLASS * class_, int id);
 static void get_desc_old (OR_BUF * buf, SM_CLASS * class_, int repid, DESC_OBJ * obj, int bound_bit_flag,
 			  int offset_size);
 static void print_set (print_output & output_ctx, DB_SET * set);
+static void text_output_write_loop (struct text_output_writer *writer);
+static int text_output_wait_writer (struct text_output_writer *writer);
+static int text_print_make_room (TEXT_OUTPUT * tout);
 static int fprint_special_set (TEXT_OUTPUT * tout, DB_SET * set);
 static int bfmt_print (int bfmt, const DB_VALUE * the_db_bit, char *string, int max_size);
 static char *strnchr (char *str, char ch, int nbytes);
@@ -443,6 +468,185 @@ error:
 }
 
 
+/*
+ * text_output_write_loop - write the buffers handed to writer, until it is
+ *                          shut down
+ *    return: void
+ *    writer(in/out): writer
+ */
+static void
+text_output_write_loop (struct text_output_writer *writer)
+{
+  // *INDENT-OFF*
+  std::unique_lock<std::mutex> ulock (writer->mutex);
+  // *INDENT-ON*
+  bool is_written;
+
+  while (true)
+    {
+      // *INDENT-OFF*
+      writer->cond.wait (ulock, [writer] { return writer->write_buffer != NULL || writer->shutdown; });
+      // *INDENT-ON*
+      if (writer->write_buffer == NULL)
+	{
+	  /* shutdown */
+	  break;
+	}
+
+      ulock.unlock ();
+      is_written = (writer->write_count == (int) fwrite (writer->write_buffer, 1, writer->write_count,
+							  writer->write_fp));
+      ulock.lock ();
+
+      if (!is_written && writer->error == NO_ERROR)
+	{
+	  writer->error = ER_IO_WRITE;
+	}
+      writer->spare_buffer = writer->write_buffer;
+      writer->write_buffer = NULL;
+      writer->cond.notify_all ();
+    }
+}
+
+/*
+ * text_output_wait_writer - wait until the buffer handed to writer is written
+ *    return: NO_ERROR if successful, ER_IO_WRITE if file I/O error occurred
+ *    writer(in/out): writer
+ */
+static int
+text_output_wait_writer (struct text_output_writer *writer)
+{
+  // *INDENT-OFF*
+  std::unique_lock<std::mutex> ulock (writer->mutex);
+
+  writer->cond.wait (ulock, [writer] { return writer->write_buffer == NULL; });
+  // *INDENT-ON*
+  return writer->error;
+}
+
+/*
+ * text_print_start_writer - write full buffers of TEXT_OUTPUT in background
+ *    return: NO_ERROR if successful, error code otherwise
+ *    tout(in/out): TEXT_OUTPUT structure, with its buffer allocated
+ * Note:
+ *    Values are printed into one buffer while the other is written, so
+ *    printing does not wait for the disk. text_print_flush still returns
+ *    after all printed contents are written.
+ */
+int
+text_print_start_writer (TEXT_OUTPUT * tout)
+{
+  struct text_output_writer *writer;
+
+  assert (tout->writer == NULL && tout->buffer != NULL);
+
+  // *INDENT-OFF*
+  writer = new (std::nothrow) text_output_writer ();
+  // *INDENT-ON*
+  if (writer == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (struct text_output_writer));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  writer->spare_buffer = (char *) malloc (tout->iosize);
+  if (writer->spare_buffer == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) tout->iosize);
+      delete writer;
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+  writer->write_buffer = NULL;
+  writer->write_count = 0;
+  writer->write_fp = NULL;
+  writer->error = NO_ERROR;
+  writer->shutdown = false;
+  // *INDENT-OFF*
+  writer->thread = std::thread (text_output_write_loop, writer);
+  // *INDENT-ON*
+
+  tout->writer = writer;
+  return NO_ERROR;
+}
+
+/*
+ * text_print_end_writer - wait for background writes and stop the writer
+ *    return: NO_ERROR if successful, ER_IO_WRITE if file I/O error occurred
+ *    tout(in/out): TEXT_OUTPUT structure
+ * Note:
+ *    Contents still in buffer are not written; call text_print_flush first.
+ */
+int
+text_print_end_writer (TEXT_OUTPUT * tout)
+{
+  struct text_output_writer *writer = tout->writer;
+  int error;
+
+  if (writer == NULL)
+    {
+      return NO_ERROR;
+    }
+
+  error = text_output_wait_writer (writer);
+  {
+    // *INDENT-OFF*
+    std::lock_guard<std::mutex> lock (writer->mutex);
+    // *INDENT-ON*
+    writer->shutdown = true;
+  }
+  writer->cond.notify_all ();
+  writer->thread.join ();
+
+  free_and_init (writer->spare_buffer);
+  delete writer;
+  tout->writer = NULL;
+
+  return error;
+}
+
+/*
+ * text_print_make_room - make the whole buffer of TEXT_OUTPUT available
+ *    return: NO_ERROR if successful, ER_IO_WRITE if file I/O error occurred
+ *    tout(in/out): TEXT_OUTPUT structure
+ * Note:
+ *    With a writer, buffer is handed to it and printing goes on in the spare
+ *    buffer. Otherwise, buffer is flushed.
+ */
+static int
+text_print_make_room (TEXT_OUTPUT * tout)
+{
+  struct text_output_writer *writer = tout->writer;
+  int error;
+
+  if (writer == NULL)
+    {
+      return text_print_flush (tout);
+    }
+
+  error = text_output_wait_writer (writer);
+  if (error != NO_ERROR)
+    {
+      return error;
+    }
+
+  {
+    // *INDENT-OFF*
+    std::lock_guard<std::mutex> lock (writer->mutex);
+    // *INDENT-ON*
+    writer->write_buffer = tout->buffer;
+    writer->write_count = tout->count;
+    writer->write_fp = tout->fp;
+    tout->buffer = writer->spare_buffer;
+    writer->spare_buffer = NULL;
+  }
+  writer->cond.notify_all ();
+
+  tout->ptr = tout->buffer;
+  tout->count = 0;
+
+  return NO_ERROR;
+}
+
 /*
  * text_print_flush - flush TEXT_OUTPUT contents to file
  *    return: NO_ERROR if successful, ER_IO_WRITE if file I/O error occurred
@@ -451,6 +655,12 @@ error:
 int
 text_print_flush (TEXT_OUTPUT * tout)
 {
+  /* contents handed to writer go first */
+  if (tout->writer != NULL && text_output_wait_writer (tout->writer) != NO_ERROR)
+    {
+      return ER_IO_WRITE;
+    }
+
   /* flush to disk */
   if (tout->count != (int) fwrite (tout->buffer, 1, tout->count, tout->fp))
     {
@@ -510,7 +720,7 @@ start:
 	}
       else
 	{			/* need more buffer */
-	  CHECK_PRINT_ERROR (text_print_flush (tout));
+	  CHECK_PRINT_ERROR (text_print_make_room (tout));
 	  goto start;		/* retry */
 	}
     }
@@ -1395,7 +1605,7 @@ fprint_special_strings (TEXT_OUTPUT * tout, DB_VALUE * value)
       if (tout->iosize - tout->count < INTERNAL_BUFFER_SIZE)
 	{
 	  /* flush remaining buffer */
-	  CHECK_PRINT_ERROR (text_print_flush (tout));
+	  CHECK_PRINT_ERROR (text_print_make_room (tout));
 	}
       CHECK_PRINT_ERROR (itoa_print (tout, db_get_bigint (value), 10 /* base */ ));
       break;
@@ -1403,7 +1613,7 @@ fprint_special_strings (TEXT_OUTPUT * tout, DB_VALUE * value)
       if (tout->iosize - tout->count < INTERNAL_BUFFER_SIZE)
 	{
 	  /* flush remaining buffer */
-	  CHECK_PRINT_ERROR (text_print_flush (tout));
+	  CHECK_PRINT_ERROR (text_print_make_room (tout));
 	}
       CHECK_PRINT_ERROR (itoa_print (tout, db_get_int (value), 10 /* base */ ));
       break;
@@ -1411,7 +1621,7 @@ fprint_special_strings (TEXT_OUTPUT * tout, DB_VALUE * value)
       if (tout->iosize - tout->count < INTERNAL_BUFFER_SIZE)
 	{
 	  /* flush remaining buffer */
-	  CHECK_PRINT_ERROR (text_print_flush (tout));
+	  CHECK_PRINT_ERROR (text_print_make_room (tout));
 	}
       CHECK_PRINT_ERROR (itoa_print (tout, db_get_short (value), 10 /* base */ ));
       break;
@@ -1420,14 +1630,20 @@ fprint_special_strings (TEXT_OUTPUT * tout, DB_VALUE * value)
     case DB_TYPE_DOUBLE:
       {
 	char *pos;
+	char *buffer;
 
 	pos = tout->ptr;
+	buffer = tout->buffer;
 	CHECK_PRINT_ERROR (text_print
 			   (tout, NULL, 0, "%.*g", (type == DB_TYPE_FLOAT) ? 10 : 17,
 			    (type == DB_TYPE_FLOAT) ? db_get_float (value) : db_get_double (value)));
 
-	/* if tout flushed, then this float/double should be the first content */
-	if ((pos < tout->ptr && !strchr (pos, '.')) || (pos > tout->ptr && !strchr (tout->buffer, '.')))
+	/* if tout flushed, then this float/double should be the first content; with a writer, buffers are swapped */
+	if (tout->buffer != buffer || pos > tout->ptr)
+	  {
+	    pos = tout->buffer;
+	  }
+	if (pos < tout->ptr && !strchr (pos, '.'))
 	  {
 	    CHECK_PRINT_ERROR (text_print (tout, ".", 1, NULL));
 	  }
@@ -1438,7 +1654,7 @@ fprint_special_strings (TEXT_OUTPUT * tout, DB_VALUE * value)
       if (tout->iosize - tout->count < INTERNAL_BUFFER_SIZE)
 	{
 	  /* flush remaining buffer */
-	  CHECK_PRINT_ERROR (text_print_flush (tout));
+	  CHECK_PRINT_ERROR (text_print_make_room (tout));
 	}
       CHECK_PRINT_ERROR (itoa_print (tout, db_get_enum_short (value), 10 /* base */ ));
       break;
@@ -64,6 +64,15 @@ typedef struct desc_obj
   DB_VALUE *values;
 } DESC_OBJ;
 
+/*
+ * The object file of a parallel unload (unloaddb --threads) is a manifest:
+ * LOAD_MANIFEST_HEADER on the first line, then the names of the data files,
+ * relative to the directory of the manifest, one per line, in load order.
+ */
+#define LOAD_MANIFEST_HEADER "%manifest"
+
+struct text_output_writer;
+
 typedef struct text_output
 {
   /* pointer to the buffer */
@@ -76,8 +85,12 @@ typedef struct text_output
   int count;
   /* output file */
   FILE *fp;
+  /* if not NULL, full buffers are written by a background thread */
+  struct text_output_writer *writer;
 } TEXT_OUTPUT;
 
+extern int text_print_start_writer (TEXT_OUTPUT * tout);
+extern int text_print_end_writer (TEXT_OUTPUT * tout);
 extern int text_print_flush (TEXT_OUTPUT * tout);
 extern int text_print (TEXT_OUTPUT * tout, const char *buf, int buflen, char const *fmt, ...);
 extern DESC_OBJ *make_desc_obj (SM_CLASS * class_);
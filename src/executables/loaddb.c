@@ -30,10 +30,15 @@
 #include <sys/stat.h>
 #include <stdarg.h>
 #include <assert.h>
+#include <errno.h>
 
 #if !defined (WINDOWS)
+#include <fcntl.h>
 #include <unistd.h>
+#include <poll.h>
+#include <signal.h>
 #include <sys/param.h>
+#include <sys/wait.h>
 #endif
 #include "porting.h"
 #include "db.h"
@@ -50,6 +55,7 @@
 #include "authenticate.h"
 #include "dbi.h"
 #include "network_interface_cl.h"
+#include "locator_cl.h"
 #include "util_func.h"
 
 #if defined (SA_MODE)
@@ -97,6 +103,11 @@ static int Interrupt_type = LDR_NO_INTERRUPT;
 static int schema_file_start_line = 1;
 static int index_file_start_line = 1;
 static int compare_Storage_order = 0;
+/* number of processes that load the object file */
+static int Load_threads = 1;
+/* data files listed by an object file that is a manifest (see LOAD_MANIFEST_HEADER); none otherwise */
+static char **Data_files = NULL;
+static int Data_files_count = 0;
 
 #define LOADDB_LOG_FILENAME_SUFFIX "loaddb.log"
 static FILE *loaddb_log_file;
@@ -112,11 +123,134 @@ static jmp_buf loaddb_jmp_buf;
 int interrupt_query = false;
 jmp_buf ldr_exec_query_status;
 
+#if !defined (WINDOWS) && !defined (SA_MODE)
+/*
+ * Parallel loading of the object file (--threads)
+ *
+ * loaddb forks the workers before it connects to the database; each worker
+ * connects on its own and loads in a transaction of its own. loaddb reads
+ * the object file once for the syntax check and once for the load, like a
+ * serial load does, and hands the lines out to the workers through pipes,
+ * in chunks that end at line boundaries, to the worker that has the least
+ * lines pending. A chunk is preceded by its %class line, unless the worker
+ * got it with an earlier chunk, and by %line directives, so the workers
+ * report the line numbers of the object file.
+ *
+ * The lines that define instance ids or refer to instances (@) all go to
+ * the first worker, which resolves the references as a serial load does;
+ * %id lines go to every worker.
+ *
+ * After each step the workers report their counts and wait to be told what
+ * to do next: the lines are loaded only if no worker found errors in them,
+ * and the load is committed only if no worker had errors loading them.
+ */
+#define LOADDB_MAX_THREADS 64
+#define LOADDB_READ_SIZE (1024 * 1024)
+#define LOADDB_CHUNK_SIZE (256 * 1024)
+/* see loaddb_run_worker */
+#define LOADDB_WORKER_LOCK_TIMEOUT 60
+
+/* what a worker does next */
+#define LOADDB_VERDICT_GO 'G'	/* connect to the database, followed by the password */
+#define LOADDB_VERDICT_LOAD 'L'
+#define LOADDB_VERDICT_COMMIT 'C'
+#define LOADDB_VERDICT_ABORT 'A'
+#define LOADDB_VERDICT_STATISTICS 'S'
+#define LOADDB_VERDICT_QUIT 'Q'
+
+typedef struct loaddb_buffer LOADDB_BUFFER;
+struct loaddb_buffer
+{
+  char *data;
+  size_t length;
+  size_t size;
+};
+
+/* lines of one class read from the object file, not handed out yet */
+typedef struct loaddb_chunk LOADDB_CHUNK;
+struct loaddb_chunk
+{
+  LOADDB_BUFFER text;
+  int class_no;			/* of the %class line the lines follow */
+  int next_line_no;		/* line number after the last line; 0 if empty */
+};
+
+/* what a worker reports on a step */
+typedef struct loaddb_worker_result LOADDB_WORKER_RESULT;
+struct loaddb_worker_result
+{
+  int status;			/* 0, or 3 if the step failed */
+  int interrupted;
+  int loaded;			/* Total_objects_loaded of an interrupted worker */
+  int errors;
+  int objects;
+  int defaults;
+  int lastcommit;
+  int fails;
+};
+
+typedef struct loaddb_worker LOADDB_WORKER;
+struct loaddb_worker
+{
+  pid_t pid;
+  /* the worker reads [0] and loaddb writes [1] */
+  int check_pipe[2];		/* lines to check */
+  int load_pipe[2];		/* lines to load */
+  int verdict_pipe[2];		/* what to do next */
+  /* loaddb reads [0] and the worker writes [1] */
+  int result_pipe[2];
+
+  int data_fd;			/* check_pipe[1] or load_pipe[1], for the current pass */
+  LOADDB_BUFFER pending;	/* lines not written to data_fd yet */
+  size_t written;		/* bytes of pending written */
+  int class_no;			/* of the %class line last written */
+};
+
+typedef enum
+{
+  LOADDB_SCAN_LINE,
+  LOADDB_SCAN_SQS,		/* '...' */
+  LOADDB_SCAN_DQS,		/* "..." */
+  LOADDB_SCAN_BRACKET,		/* [...] */
+  LOADDB_SCAN_LINE_COMMENT,	/* -- or //, up to the end of the line */
+  LOADDB_SCAN_COMMENT		/* C comment */
+} LOADDB_SCAN_STATE;
+
+typedef struct loaddb_splitter LOADDB_SPLITTER;
+struct loaddb_splitter
+{
+  LOADDB_SCAN_STATE state;
+  char prev;			/* last character scanned */
+  char last;			/* last character of the line that is not a blank */
+  int newlines;			/* counted as the loader counts them */
+
+  LOADDB_BUFFER line;		/* the line being read; ends at a newline out of strings and comments */
+  int line_no;
+  bool line_has_reference;
+
+  LOADDB_BUFFER class_line;	/* last %class line */
+  int class_line_no;
+  int class_no;
+
+  LOADDB_CHUNK shared;		/* lines any worker can load */
+  LOADDB_CHUNK pinned;		/* lines the first worker loads */
+};
+
+static LOADDB_WORKER *loaddb_workers = NULL;
+static int loaddb_num_workers = 0;
+static volatile sig_atomic_t loaddb_workers_interrupted = 0;
+#endif /* !WINDOWS && !SA_MODE */
+
 static int ldr_validate_object_file (FILE * outfp, const char *argv0);
 static int ldr_check_file_name_and_line_no (void);
 static void signal_handler (void);
 static void loaddb_report_num_of_commits (int num_committed);
 static void loaddb_get_num_of_inserted_objects (int num_objects);
+static void loaddb_advise_sequential_read (FILE * fp);
+static int loaddb_read_manifest (FILE * object_file);
+static void loaddb_free_manifest (void);
+static FILE *loaddb_open_data_file (int file_no);
+static int loaddb_parse_object_file (FILE * object_file);
 #if defined (WINDOWS)
 static int run_proc (char *path, char *cmd_line);
 #endif /* WINDOWS */
@@ -127,6 +261,32 @@ static int get_ignore_class_list (const char *filename);
 static void free_ignoreclasslist (void);
 static int ldr_compare_attribute_with_meta (char *table_name, char *meta, DB_ATTRIBUTE * attribute);
 static int ldr_compare_storage_order (FILE * schema_file);
+static int loaddb_login (const char *command_name, int dba_mode, bool can_prompt);
+#if !defined (WINDOWS) && !defined (SA_MODE)
+static int loaddb_buffer_append (LOADDB_BUFFER * buffer, const char *data, size_t size);
+static int loaddb_buffer_append_line_no (LOADDB_BUFFER * buffer, int line_no);
+static int loaddb_read_fully (int fd, void *data, size_t size);
+static int loaddb_write_fully (int fd, const void *data, size_t size);
+static void loaddb_close_fd (int *fd);
+static int loaddb_start_workers (const char *command_name, int dba_mode);
+static void loaddb_stop_workers (void);
+static void loaddb_run_worker (LOADDB_WORKER * worker, const char *command_name, int dba_mode);
+static char loaddb_worker_report (LOADDB_WORKER * worker, LOADDB_WORKER_RESULT * result);
+static void loaddb_interrupt_workers (void);
+static int loaddb_send_verdict (LOADDB_WORKER * worker, char verdict);
+static int loaddb_read_results (LOADDB_WORKER_RESULT * total);
+static int loaddb_write_pending (LOADDB_WORKER * worker);
+static int loaddb_wait_for_worker (int worker_index, size_t max_pending);
+static int loaddb_hand_out_chunk (LOADDB_SPLITTER * splitter, LOADDB_CHUNK * chunk);
+static int loaddb_hand_out_chunks (LOADDB_SPLITTER * splitter);
+static const char *loaddb_skip_blanks_and_comments (const char *p, const char *end);
+static bool loaddb_line_starts_with (const char *p, const char *end, const char *command);
+static bool loaddb_line_defines_instance (const char *p, const char *end);
+static int loaddb_split_line (LOADDB_SPLITTER * splitter);
+static int loaddb_split_block (LOADDB_SPLITTER * splitter, const char *block, size_t size);
+static int loaddb_split_object_file (FILE * object_file, bool is_load_pass);
+static int loaddb_load_in_workers (FILE ** object_file, int *interrupted);
+#endif /* !WINDOWS && !SA_MODE */
 
 /*
  * print_log_msg - print log message
@@ -317,6 +477,177 @@ loaddb_get_num_of_inserted_objects (int num_objects)
   Total_objects_loaded = num_objects;
 }
 
+/*
+ * loaddb_advise_sequential_read - tell the system that the file is read once
+ *                                 from start to end
+ *    return: void
+ *    fp(in): object file
+ * Note:
+ *    The parser reads the object file in small blocks. A larger read-ahead
+ *    lets the system read the next blocks while the current ones are loaded.
+ */
+static void
+loaddb_advise_sequential_read (FILE * fp)
+{
+#if defined (POSIX_FADV_SEQUENTIAL)
+  (void) posix_fadvise (fileno (fp), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif /* POSIX_FADV_SEQUENTIAL */
+}
+
+/*
+ * loaddb_read_manifest - read the data file names of an object file that is
+ *                        a manifest
+ *    return: NO_ERROR if successful, error code otherwise
+ *    object_file(in): rewound if it is not a manifest
+ * Note:
+ *    The names are relative to the directory of the object file. Every data
+ *    file is checked to be readable, so a missing one is found out before
+ *    anything is loaded.
+ */
+static int
+loaddb_read_manifest (FILE * object_file)
+{
+  const char *msg_format;
+  char line[PATH_MAX];
+  char *name;
+  char **files;
+  const char *p;
+  FILE *fp;
+  int dir_length = 0;
+  int length;
+
+  if (fgets (line, sizeof (line), object_file) == NULL
+      || strncmp (line, LOAD_MANIFEST_HEADER, strlen (LOAD_MANIFEST_HEADER)) != 0)
+    {
+      rewind (object_file);
+      return NO_ERROR;
+    }
+
+  for (p = Object_file; *p != '\0'; p++)
+    {
+      if (*p == '/' || IS_PATH_SEPARATOR (*p))
+	{
+	  dir_length = (int) (p - Object_file) + 1;
+	}
+    }
+
+  while (fgets (line, sizeof (line), object_file) != NULL)
+    {
+      length = (int) strlen (line);
+      while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+	{
+	  line[--length] = '\0';
+	}
+      if (length == 0)
+	{
+	  continue;
+	}
+
+      files = (char **) realloc (Data_files, (Data_files_count + 1) * sizeof (char *));
+      name = (char *) malloc (dir_length + length + 1);
+      if (files == NULL || name == NULL)
+	{
+	  Data_files = (files != NULL) ? files : Data_files;
+	  free (name);
+	  msg_format = msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_BAD_INFILE);
+	  print_log_msg (1, msg_format, Object_file);
+	  util_log_write_errstr (msg_format, Object_file);
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
+	}
+      Data_files = files;
+      memcpy (name, Object_file, dir_length);
+      memcpy (name + dir_length, line, length + 1);
+      Data_files[Data_files_count++] = name;
+
+      fp = loaddb_open_data_file (Data_files_count - 1);
+      if (fp == NULL)
+	{
+	  return ER_FAILED;
+	}
+      fclose (fp);
+    }
+
+  if (ferror (object_file))
+    {
+      msg_format = msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_BAD_INFILE);
+      print_log_msg (1, msg_format, Object_file);
+      util_log_write_errstr (msg_format, Object_file);
+      return ER_FAILED;
+    }
+
+  return NO_ERROR;
+}
+
+static void
+loaddb_free_manifest (void)
+{
+  int i;
+
+  for (i = 0; i < Data_files_count; i++)
+    {
+      free (Data_files[i]);
+    }
+  free (Data_files);
+  Data_files = NULL;
+  Data_files_count = 0;
+}
+
+/*
+ * loaddb_open_data_file - open a data file listed by the manifest
+ *    return: the file, NULL on error
+ *    file_no(in):
+ */
+static FILE *
+loaddb_open_data_file (int file_no)
+{
+  const char *msg_format;
+  FILE *fp;
+
+  fp = fopen_ex (Data_files[file_no], "rb");	/* keep out ^Z */
+  if (fp == NULL)
+    {
+      msg_format = msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_BAD_INFILE);
+      print_log_msg (1, msg_format, Data_files[file_no]);
+      util_log_write_errstr (msg_format, Data_files[file_no]);
+      return NULL;
+    }
+  loaddb_advise_sequential_read (fp);
+
+  return fp;
+}
+
+/*
+ * loaddb_parse_object_file - check or load the object file, or the data
+ *                            files it lists
+ *    return: NO_ERROR if successful, ER_FAILED if a data file cannot be read
+ *    object_file(in):
+ */
+static int
+loaddb_parse_object_file (FILE * object_file)
+{
+  FILE *fp;
+  int i;
+
+  if (Data_files_count == 0)
+    {
+      do_loader_parse (object_file);
+      return NO_ERROR;
+    }
+
+  for (i = 0; i < Data_files_count; i++)
+    {
+      fp = loaddb_open_data_file (i);
+      if (fp == NULL)
+	{
+	  return ER_FAILED;
+	}
+      do_loader_parse (fp);
+      fclose (fp);
+    }
+
+  return NO_ERROR;
+}
+
 #if defined (WINDOWS)
 /*
  * run_proc - run a process with a given command_line
@@ -570,105 +901,25 @@ compare_end:
 }
 
 /*
- * loaddb_internal - internal main loaddb function
+ * loaddb_login - connect to the database
  *    return: NO_ERROR if successful, error code otherwise
- *    argc(in): argc of main
- *    argv(in): argv of main
+ *    command_name(in): name of the utility
  *    dba_mode(in):
+ *    can_prompt(in): prompt for the password if the one given is wrong
  */
 static int
-loaddb_internal (UTIL_FUNCTION_ARG * arg, int dba_mode)
+loaddb_login (const char *command_name, int dba_mode, bool can_prompt)
 {
-  UTIL_ARG_MAP *arg_map = arg->arg_map;
-  int error = NO_ERROR;
-  /* set to static to avoid copiler warning (clobbered by longjump) */
-  static FILE *schema_file = NULL;
-  static FILE *index_file = NULL;
-  static FILE *object_file = NULL;
-  FILE *error_file = NULL;
-  int status = 0;
-  int errors = 0;
-  int objects = 0;
-  int defaults = 0;
-  int fails = 0;
-
-  int ldr_init_ret = NO_ERROR;
-  int lastcommit = 0;
+  int error;
   char *passwd;
-  /* set to static to avoid copiler warning (clobbered by longjump) */
-  static int interrupted = false;
-  int au_save = 0;
-  extern bool obt_Enable_autoincrement;
-  char log_file_name[PATH_MAX];
-  const char *msg_format;
-
-  LOADDB_INIT_DEBUG ();
-  obt_Enable_autoincrement = false;
-
-  Volume = utility_get_option_string_value (arg_map, OPTION_STRING_TABLE, 0);
-  Input_file = utility_get_option_string_value (arg_map, OPTION_STRING_TABLE, 1);
-  User_name = utility_get_option_string_value (arg_map, LOAD_USER_S, 0);
-  Password = utility_get_option_string_value (arg_map, LOAD_PASSWORD_S, 0);
-  Syntax_check = utility_get_option_bool_value (arg_map, LOAD_CHECK_ONLY_S);
-  Load_only = utility_get_option_bool_value (arg_map, LOAD_LOAD_ONLY_S);
-  Estimated_size = utility_get_option_int_value (arg_map, LOAD_ESTIMATED_SIZE_S);
-  Verbose = utility_get_option_bool_value (arg_map, LOAD_VERBOSE_S);
-  Disable_statistics = utility_get_option_bool_value (arg_map, LOAD_NO_STATISTICS_S);
-  Periodic_commit = utility_get_option_int_value (arg_map, LOAD_PERIODIC_COMMIT_S);
-  Verbose_commit = Periodic_commit > 0;
-  No_oid_hint = utility_get_option_bool_value (arg_map, LOAD_NO_OID_S);
-  Schema_file = utility_get_option_string_value (arg_map, LOAD_SCHEMA_FILE_S, 0);
-  Index_file = utility_get_option_string_value (arg_map, LOAD_INDEX_FILE_S, 0);
-  Object_file = utility_get_option_string_value (arg_map, LOAD_DATA_FILE_S, 0);
-  Error_file = utility_get_option_string_value (arg_map, LOAD_ERROR_CONTROL_FILE_S, 0);
-  Ignore_logging = utility_get_option_bool_value (arg_map, LOAD_IGNORE_LOGGING_S);
-  Table_name = utility_get_option_string_value (arg_map, LOAD_TABLE_NAME_S, 0);
-
-  Ignore_class_file = utility_get_option_string_value (arg_map, LOAD_IGNORE_CLASS_S, 0);
-  compare_Storage_order = utility_get_option_bool_value (arg_map, LOAD_COMPARE_STORAGE_ORDER_S);
-
-  Input_file = Input_file ? Input_file : "";
-  Schema_file = Schema_file ? Schema_file : "";
-  Index_file = Index_file ? Index_file : "";
-  Object_file = Object_file ? Object_file : "";
-  Error_file = Error_file ? Error_file : "";
-  Table_name = Table_name ? Table_name : "";
-
-  if (ldr_validate_object_file (stderr, arg->argv0))
-    {
-      status = 1;
-      goto error_return;
-    }
-
-  /* error message log file */
-  sprintf (log_file_name, "%s_%s.err", Volume, arg->command_name);
-  er_init (log_file_name, ER_NEVER_EXIT);
-
-  if (Index_file[0] != '\0' && prm_get_integer_value (PRM_ID_SR_NBUFFERS) < LOAD_INDEX_MIN_SORT_BUFFER_PAGES)
-    {
-      sysprm_set_force (prm_get_name (PRM_ID_SR_NBUFFERS), LOAD_INDEX_MIN_SORT_BUFFER_PAGES_STRING);
-    }
-
-  sysprm_set_force (prm_get_name (PRM_ID_JAVA_STORED_PROCEDURE), "no");
-
-  /* open loaddb log file */
-  sprintf (log_file_name, "%s_%s", Volume, LOADDB_LOG_FILENAME_SUFFIX);
-  loaddb_log_file = fopen (log_file_name, "w+");
-  if (loaddb_log_file == NULL)
-    {
-      PRINT_AND_LOG_ERR_MSG ("Cannot open log file %s\n", log_file_name);
-      status = 2;
-      goto error_return;
-    }
 
-  /* login */
   if (User_name != NULL || !dba_mode)
     {
       (void) db_login (User_name, Password);
-      error = db_restart (arg->command_name, true, Volume);
+      error = db_restart (command_name, true, Volume);
       if (error != NO_ERROR)
 	{
-	  if (error == ER_AU_INVALID_PASSWORD)
+	  if (error == ER_AU_INVALID_PASSWORD && can_prompt)
 	    {
 	      /* prompt for password and try again */
 	      passwd =
@@ -677,8 +928,10 @@ loaddb_internal (UTIL_FUNCTION_ARG * arg, int dba_mode)
 		{
 		  passwd = NULL;
 		}
+	      /* the workers of a parallel load log in with it too */
+	      Password = passwd;
 	      (void) db_login (User_name, passwd);
-	      error = db_restart (arg->command_name, true, Volume);
+	      error = db_restart (command_name, true, Volume);
 	    }
 	}
     }
@@ -688,72 +941,1539 @@ loaddb_internal (UTIL_FUNCTION_ARG * arg, int dba_mode)
       AU_DISABLE_PASSWORDS ();
       db_set_client_type (DB_CLIENT_TYPE_ADMIN_UTILITY);
       (void) db_login ("DBA", NULL);
-      error = db_restart (arg->command_name, true, Volume);
+      error = db_restart (command_name, true, Volume);
     }
 
-  if (error != NO_ERROR)
+  return error;
+}
+
+#if !defined (WINDOWS) && !defined (SA_MODE)
+/*
+ * loaddb_buffer_append - append data to a buffer
+ *    return: NO_ERROR if successful, ER_OUT_OF_VIRTUAL_MEMORY otherwise
+ *    buffer(in/out):
+ *    data(in):
+ *    size(in):
+ */
+static int
+loaddb_buffer_append (LOADDB_BUFFER * buffer, const char *data, size_t size)
+{
+  char *new_data;
+  size_t new_size;
+
+  if (buffer->length + size > buffer->size)
     {
-      if (er_errid () < ER_FAILED)
+      new_size = (buffer->size > 0) ? buffer->size * 2 : LOADDB_CHUNK_SIZE;
+      if (new_size < buffer->length + size)
 	{
-	  // an error was set.
-	  print_log_msg (1, "%s\n", db_error_string (3));
-	  util_log_write_errstr ("%s\n", db_error_string (3));
+	  new_size = buffer->length + size;
 	}
-      else
+      new_data = (char *) realloc (buffer->data, new_size);
+      if (new_data == NULL)
 	{
-	  PRINT_AND_LOG_ERR_MSG ("Cannot restart database %s\n", Volume);
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
 	}
-      status = 3;
-      goto error_return;
+      buffer->data = new_data;
+      buffer->size = new_size;
     }
 
-  /* disable trigger actions to be fired */
-  db_disable_trigger ();
+  memcpy (buffer->data + buffer->length, data, size);
+  buffer->length += size;
+  return NO_ERROR;
+}
 
-  /* check if schema/index/object files exist */
-  ldr_check_file_name_and_line_no ();
+/*
+ * loaddb_buffer_append_line_no - append the %line directive that sets the
+ *                                line number of the next line
+ *    return: NO_ERROR if successful, ER_OUT_OF_VIRTUAL_MEMORY otherwise
+ *    buffer(in/out):
+ *    line_no(in):
+ */
+static int
+loaddb_buffer_append_line_no (LOADDB_BUFFER * buffer, int line_no)
+{
+  char directive[32];
+  int length;
 
-  if (Schema_file[0] != 0)
+  length = snprintf (directive, sizeof (directive), "%%line %d\n", line_no);
+  return loaddb_buffer_append (buffer, directive, (size_t) length);
+}
+
+/*
+ * loaddb_read_fully - read size bytes from a pipe
+ *    return: NO_ERROR if successful, ER_FAILED on end of file or error
+ *    fd(in):
+ *    data(out):
+ *    size(in):
+ */
+static int
+loaddb_read_fully (int fd, void *data, size_t size)
+{
+  char *p = (char *) data;
+  ssize_t n;
+
+  while (size > 0)
     {
-      schema_file = fopen (Schema_file, "r");
-      if (schema_file == NULL)
+      n = read (fd, p, size);
+      if (n < 0 && errno == EINTR)
 	{
-	  msg_format = msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_BAD_INFILE);
-	  print_log_msg (1, msg_format, Schema_file);
-	  util_log_write_errstr (msg_format, Schema_file);
-	  status = 2;
-	  goto error_return;
+	  continue;
 	}
-    }
-  if (Index_file[0] != 0)
-    {
-      index_file = fopen (Index_file, "r");
-      if (index_file == NULL)
+      if (n <= 0)
 	{
-	  msg_format = msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_BAD_INFILE);
-	  print_log_msg (1, msg_format, Index_file);
-	  util_log_write_errstr (msg_format, Index_file);
-	  status = 2;
-	  goto error_return;
+	  return ER_FAILED;
 	}
+      p += n;
+      size -= n;
     }
-  if (Object_file[0] != 0)
-    {
-      object_file = fopen_ex (Object_file, "rb");	/* keep out ^Z */
 
-      if (object_file == NULL)
+  return NO_ERROR;
+}
+
+/*
+ * loaddb_write_fully - write size bytes to a pipe
+ *    return: NO_ERROR if successful, ER_FAILED otherwise
+ *    fd(in):
+ *    data(in):
+ *    size(in):
+ */
+static int
+loaddb_write_fully (int fd, const void *data, size_t size)
+{
+  const char *p = (const char *) data;
+  ssize_t n;
+
+  while (size > 0)
+    {
+      n = write (fd, p, size);
+      if (n < 0 && errno == EINTR)
 	{
-	  msg_format = msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_BAD_INFILE);
-	  print_log_msg (1, msg_format, Object_file);
-	  util_log_write_errstr (msg_format, Object_file);
-	  status = 2;
-	  goto error_return;
+	  continue;
+	}
+      if (n <= 0)
+	{
+	  return ER_FAILED;
 	}
+      p += n;
+      size -= n;
     }
 
-  if (Ignore_class_file)
-    {
-      int retval;
+  return NO_ERROR;
+}
+
+static void
+loaddb_close_fd (int *fd)
+{
+  if (*fd >= 0)
+    {
+      close (*fd);
+      *fd = -1;
+    }
+}
+
+/*
+ * loaddb_start_workers - fork the worker processes of a parallel load
+ *    return: NO_ERROR if successful, ER_FAILED otherwise
+ *    command_name(in): name of the utility
+ *    dba_mode(in):
+ * Note:
+ *    Called before loaddb connects to the database; the workers wait until
+ *    loaddb has loaded the schema.
+ */
+static int
+loaddb_start_workers (const char *command_name, int dba_mode)
+{
+  LOADDB_WORKER *worker;
+  pid_t pid;
+  int i, j;
+
+  loaddb_workers = (LOADDB_WORKER *) calloc (Load_threads, sizeof (LOADDB_WORKER));
+  if (loaddb_workers == NULL)
+    {
+      return ER_FAILED;
+    }
+  loaddb_num_workers = Load_threads;
+
+  for (i = 0; i < loaddb_num_workers; i++)
+    {
+      worker = &loaddb_workers[i];
+      worker->pid = -1;
+      worker->check_pipe[0] = worker->check_pipe[1] = -1;
+      worker->load_pipe[0] = worker->load_pipe[1] = -1;
+      worker->verdict_pipe[0] = worker->verdict_pipe[1] = -1;
+      worker->result_pipe[0] = worker->result_pipe[1] = -1;
+      worker->data_fd = -1;
+    }
+
+  for (i = 0; i < loaddb_num_workers; i++)
+    {
+      worker = &loaddb_workers[i];
+      if (pipe (worker->check_pipe) != 0 || pipe (worker->load_pipe) != 0 || pipe (worker->verdict_pipe) != 0
+	  || pipe (worker->result_pipe) != 0)
+	{
+	  goto error_exit;
+	}
+#if defined (F_SETPIPE_SZ)
+      /* fewer wake ups of the workers */
+      (void) fcntl (worker->check_pipe[1], F_SETPIPE_SZ, LOADDB_CHUNK_SIZE);
+      (void) fcntl (worker->load_pipe[1], F_SETPIPE_SZ, LOADDB_CHUNK_SIZE);
+#endif /* F_SETPIPE_SZ */
+    }
+
+  /* do not let the workers write what is buffered again */
+  fflush (NULL);
+
+  for (i = 0; i < loaddb_num_workers; i++)
+    {
+      pid = fork ();
+      if (pid < 0)
+	{
+	  goto error_exit;
+	}
+
+      if (pid == 0)
+	{
+	  /* keep only the pipe ends of this worker */
+	  for (j = 0; j < loaddb_num_workers; j++)
+	    {
+	      worker = &loaddb_workers[j];
+	      if (j != i)
+		{
+		  loaddb_close_fd (&worker->check_pipe[0]);
+		  loaddb_close_fd (&worker->load_pipe[0]);
+		  loaddb_close_fd (&worker->verdict_pipe[0]);
+		  loaddb_close_fd (&worker->result_pipe[1]);
+		}
+	      loaddb_close_fd (&worker->check_pipe[1]);
+	      loaddb_close_fd (&worker->load_pipe[1]);
+	      loaddb_close_fd (&worker->verdict_pipe[1]);
+	      loaddb_close_fd (&worker->result_pipe[0]);
+	    }
+	  loaddb_run_worker (&loaddb_workers[i], command_name, dba_mode);
+	}
+
+      loaddb_workers[i].pid = pid;
+    }
+
+  for (i = 0; i < loaddb_num_workers; i++)
+    {
+      worker = &loaddb_workers[i];
+      loaddb_close_fd (&worker->check_pipe[0]);
+      loaddb_close_fd (&worker->load_pipe[0]);
+      loaddb_close_fd (&worker->verdict_pipe[0]);
+      loaddb_close_fd (&worker->result_pipe[1]);
+    }
+
+  return NO_ERROR;
+
+error_exit:
+  loaddb_stop_workers ();
+  return ER_FAILED;
+}
+
+/*
+ * loaddb_stop_workers - close the pipes to the workers and wait until they
+ *                       exit
+ *    return: void
+ * Note:
+ *    A worker that is waiting to be told what to do next just exits.
+ */
+static void
+loaddb_stop_workers (void)
+{
+  LOADDB_WORKER *worker;
+  int i, status;
+
+  if (loaddb_workers == NULL)
+    {
+      return;
+    }
+
+  for (i = 0; i < loaddb_num_workers; i++)
+    {
+      worker = &loaddb_workers[i];
+      loaddb_close_fd (&worker->check_pipe[0]);
+      loaddb_close_fd (&worker->check_pipe[1]);
+      loaddb_close_fd (&worker->load_pipe[0]);
+      loaddb_close_fd (&worker->load_pipe[1]);
+      loaddb_close_fd (&worker->verdict_pipe[0]);
+      loaddb_close_fd (&worker->verdict_pipe[1]);
+      loaddb_close_fd (&worker->result_pipe[0]);
+      loaddb_close_fd (&worker->result_pipe[1]);
+      free (worker->pending.data);
+    }
+
+  for (i = 0; i < loaddb_num_workers; i++)
+    {
+      if (loaddb_workers[i].pid > 0)
+	{
+	  while (waitpid (loaddb_workers[i].pid, &status, 0) < 0 && errno == EINTR)
+	    {
+	      ;
+	    }
+	}
+    }
+
+  free (loaddb_workers);
+  loaddb_workers = NULL;
+  loaddb_num_workers = 0;
+}
+
+/*
+ * loaddb_run_worker - main of a worker process of a parallel load
+ *    return: does not return
+ *    worker(in): pipe ends of the worker
+ *    command_name(in): name of the utility
+ *    dba_mode(in):
+ * Note:
+ *    The transactions of the workers end only when every worker is done
+ *    with the load, so a worker that waits for a lock another worker holds
+ *    would wait forever. Only duplicate unique keys make workers wait for
+ *    each other, and they fail the load anyway, so a worker waits for a
+ *    lock LOADDB_WORKER_LOCK_TIMEOUT seconds at most.
+ */
+static void
+loaddb_run_worker (LOADDB_WORKER * worker, const char *command_name, int dba_mode)
+{
+  /* set to static to avoid copiler warning (clobbered by longjump) */
+  static LOADDB_WORKER_RESULT result;
+  static FILE *fp = NULL;
+  FILE *error_file;
+  char *password = NULL;
+  char verdict;
+  int length;
+
+  (void) os_set_signal_handler (SIGPIPE, SIG_IGN);
+  memset (&result, 0, sizeof (result));
+
+  /* wait until the schema is loaded */
+  if (loaddb_read_fully (worker->verdict_pipe[0], &verdict, 1) != NO_ERROR || verdict != LOADDB_VERDICT_GO
+      || loaddb_read_fully (worker->verdict_pipe[0], &length, sizeof (length)) != NO_ERROR)
+    {
+      exit (0);
+    }
+  if (length >= 0)
+    {
+      password = (char *) malloc (length + 1);
+      if (password == NULL || loaddb_read_fully (worker->verdict_pipe[0], password, length) != NO_ERROR)
+	{
+	  exit (3);
+	}
+      password[length] = '\0';
+    }
+  Password = password;
+
+  if (loaddb_login (command_name, dba_mode, false) != NO_ERROR)
+    {
+      print_log_msg (1, "%s\n", db_error_string (3));
+      util_log_write_errstr ("%s\n", db_error_string (3));
+      result.status = 3;
+      (void) loaddb_worker_report (worker, &result);
+      exit (3);
+    }
+
+  db_disable_trigger ();
+  (void) db_set_lock_timeout (LOADDB_WORKER_LOCK_TIMEOUT);
+
+  if (Error_file[0] != 0)
+    {
+      error_file = fopen_ex (Error_file, "rt");
+      if (error_file != NULL)
+	{
+	  er_filter_fileset (error_file);
+	  fclose (error_file);
+	}
+    }
+
+  if ((Ignore_class_file != NULL && get_ignore_class_list (Ignore_class_file) < 0)
+      || (Ignore_logging != 0 && locator_log_force_nologging () != NO_ERROR))
+    {
+      print_log_msg (1, "%s\n", db_error_string (3));
+      util_log_write_errstr ("%s\n", db_error_string (3));
+      result.status = 3;
+      (void) loaddb_worker_report (worker, &result);
+      (void) db_shutdown ();
+      exit (3);
+    }
+
+  /* the server inserts the index keys of each flush in key order */
+  locator_Sort_flush_index_keys = true;
+  ldr_init (Verbose);
+
+  if (Ignore_logging)
+    {
+      Interrupt_type = LDR_STOP_AND_COMMIT_INTERRUPT;
+    }
+  else
+    {
+      Interrupt_type = LDR_STOP_AND_ABORT_INTERRUPT;
+    }
+
+  if (Periodic_commit)
+    {
+      /* register the post commit function */
+      ldr_register_post_commit_handler (&loaddb_report_num_of_commits, NULL);
+    }
+
+  if (!Load_only)
+    {
+      fp = fdopen (worker->check_pipe[0], "rb");
+      if (fp == NULL)
+	{
+	  result.status = 3;
+	}
+      else
+	{
+	  worker->check_pipe[0] = -1;
+	  if (Table_name[0] != '\0' && ldr_init_class_spec (Table_name) != NO_ERROR)
+	    {
+	      result.status = 3;
+	    }
+	  else
+	    {
+	      do_loader_parse (fp);
+	    }
+	  fclose (fp);
+	  ldr_stats (&result.errors, &result.objects, &result.defaults, &result.lastcommit, &result.fails);
+	}
+
+      if (loaddb_worker_report (worker, &result) != LOADDB_VERDICT_LOAD)
+	{
+	  goto end;
+	}
+    }
+  loaddb_close_fd (&worker->check_pipe[0]);
+
+  ldr_start (Periodic_commit);
+  fp = fdopen (worker->load_pipe[0], "rb");
+  if (fp == NULL)
+    {
+      result.status = 3;
+      (void) loaddb_worker_report (worker, &result);
+      goto end;
+    }
+  worker->load_pipe[0] = -1;
+
+  /* make sure signals are caught */
+  util_arm_signal_handlers (signal_handler, signal_handler);
+
+  /* register function to call and jmp environment to longjmp to after aborting or committing. */
+  ldr_register_post_interrupt_handler (&loaddb_get_num_of_inserted_objects, &loaddb_jmp_buf);
+
+  if (setjmp (loaddb_jmp_buf) != 0)
+    {
+      /* the loader has already aborted or committed the transaction */
+      result.status = 3;
+      result.interrupted = true;
+      result.loaded = Total_objects_loaded;
+    }
+  else
+    {
+      if (Table_name[0] != '\0')
+	{
+	  ldr_init_class_spec (Table_name);
+	}
+      do_loader_parse (fp);
+    }
+  /* loaddb stops writing to a worker that stopped reading */
+  fclose (fp);
+  ldr_stats (&result.errors, &result.objects, &result.defaults, &result.lastcommit, &result.fails);
+
+  verdict = loaddb_worker_report (worker, &result);
+  if (!result.interrupted)
+    {
+      if (verdict == LOADDB_VERDICT_COMMIT)
+	{
+	  if (db_commit_transaction () != NO_ERROR)
+	    {
+	      util_log_write_errstr ("%s\n", db_error_string (3));
+	      result.status = 3;
+	    }
+	}
+      else
+	{
+	  db_abort_transaction ();
+	}
+    }
+
+  verdict = loaddb_worker_report (worker, &result);
+  if (verdict == LOADDB_VERDICT_STATISTICS)
+    {
+      if (!ldr_update_statistics ())
+	{
+	  (void) db_commit_transaction ();
+	}
+      (void) loaddb_worker_report (worker, &result);
+    }
+
+end:
+  ldr_final ();
+  free_ignoreclasslist ();
+  (void) db_shutdown ();
+  exit (result.status);
+}
+
+/*
+ * loaddb_worker_report - report on a step and wait to be told what to do
+ *                        next; called by a worker
+ *    return: what to do next
+ *    worker(in):
+ *    result(in):
+ */
+static char
+loaddb_worker_report (LOADDB_WORKER * worker, LOADDB_WORKER_RESULT * result)
+{
+  char verdict;
+
+  if (loaddb_write_fully (worker->result_pipe[1], result, sizeof (*result)) != NO_ERROR
+      || loaddb_read_fully (worker->verdict_pipe[0], &verdict, 1) != NO_ERROR)
+    {
+      return LOADDB_VERDICT_QUIT;
+    }
+
+  return verdict;
+}
+
+/*
+ * loaddb_interrupt_workers - signal handler of loaddb while the workers
+ *                            load; passes the interrupt on to them
+ *    return: void
+ */
+static void
+loaddb_interrupt_workers (void)
+{
+  int i;
+
+  loaddb_workers_interrupted = 1;
+  for (i = 0; i < loaddb_num_workers; i++)
+    {
+      if (loaddb_workers[i].pid > 0)
+	{
+	  (void) kill (loaddb_workers[i].pid, SIGINT);
+	}
+    }
+}
+
+/*
+ * loaddb_send_verdict - tell a worker what to do next
+ *    return: NO_ERROR if successful, ER_FAILED if the worker is gone
+ *    worker(in):
+ *    verdict(in):
+ */
+static int
+loaddb_send_verdict (LOADDB_WORKER * worker, char verdict)
+{
+  int length;
+
+  if (loaddb_write_fully (worker->verdict_pipe[1], &verdict, 1) != NO_ERROR)
+    {
+      return ER_FAILED;
+    }
+
+  if (verdict == LOADDB_VERDICT_GO)
+    {
+      /* the password loaddb logged in with, which may have been prompted for */
+      length = (Password != NULL) ? (int) strlen (Password) : -1;
+      if (loaddb_write_fully (worker->verdict_pipe[1], &length, sizeof (length)) != NO_ERROR
+	  || (length > 0 && loaddb_write_fully (worker->verdict_pipe[1], Password, length) != NO_ERROR))
+	{
+	  return ER_FAILED;
+	}
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * loaddb_read_results - read what every worker reports on a step
+ *    return: number of workers that failed the step or are gone
+ *    total(out): counts of all the workers
+ */
+static int
+loaddb_read_results (LOADDB_WORKER_RESULT * total)
+{
+  LOADDB_WORKER *worker;
+  LOADDB_WORKER_RESULT result;
+  int failed = 0;
+  int i;
+
+  memset (total, 0, sizeof (*total));
+  for (i = 0; i < loaddb_num_workers; i++)
+    {
+      worker = &loaddb_workers[i];
+      if (worker->result_pipe[0] < 0
+	  || loaddb_read_fully (worker->result_pipe[0], &result, sizeof (result)) != NO_ERROR)
+	{
+	  /* the worker is gone */
+	  loaddb_close_fd (&worker->result_pipe[0]);
+	  failed++;
+	  continue;
+	}
+
+      if (result.status != 0)
+	{
+	  failed++;
+	}
+      if (result.interrupted)
+	{
+	  total->interrupted++;
+	  if (result.loaded > 0)
+	    {
+	      total->loaded += result.loaded;
+	    }
+	}
+      total->errors += result.errors;
+      total->objects += result.objects;
+      total->defaults += result.defaults;
+      total->fails += result.fails;
+    }
+
+  return failed;
+}
+
+/*
+ * loaddb_write_pending - write the pending lines of a worker, as many as
+ *                        the pipe takes
+ *    return: NO_ERROR if successful, ER_FAILED if the worker is gone
+ *    worker(in):
+ */
+static int
+loaddb_write_pending (LOADDB_WORKER * worker)
+{
+  ssize_t n;
+
+  while (worker->written < worker->pending.length)
+    {
+      n = write (worker->data_fd, worker->pending.data + worker->written, worker->pending.length - worker->written);
+      if (n < 0)
+	{
+	  if (errno == EINTR)
+	    {
+	      continue;
+	    }
+	  if (errno == EAGAIN || errno == EWOULDBLOCK)
+	    {
+	      return NO_ERROR;
+	    }
+	  return ER_FAILED;
+	}
+      worker->written += n;
+    }
+
+  worker->pending.length = 0;
+  worker->written = 0;
+  return NO_ERROR;
+}
+
+/*
+ * loaddb_wait_for_worker - wait until a worker has at most max_pending bytes
+ *                          of lines pending
+ *    return: the worker with the least bytes pending, -1 if a worker is gone
+ *            or loaddb was interrupted
+ *    worker_index(in): the worker to wait for, or -1 for any worker
+ *    max_pending(in):
+ * Note:
+ *    Workers with as many bytes pending are taken in turn.
+ */
+static int
+loaddb_wait_for_worker (int worker_index, size_t max_pending)
+{
+  static int next_worker = 0;
+  struct pollfd fds[LOADDB_MAX_THREADS];
+  LOADDB_WORKER *worker;
+  size_t pending, best_pending = 0;
+  int best, nfds, i, j;
+
+  while (true)
+    {
+      best = -1;
+      nfds = 0;
+      for (j = 0; j < loaddb_num_workers; j++)
+	{
+	  i = (next_worker + j) % loaddb_num_workers;
+	  worker = &loaddb_workers[i];
+	  if (loaddb_write_pending (worker) != NO_ERROR)
+	    {
+	      return -1;
+	    }
+	  if (worker_index >= 0 && i != worker_index)
+	    {
+	      continue;
+	    }
+
+	  pending = worker->pending.length - worker->written;
+	  if (pending <= max_pending && (best < 0 || pending < best_pending))
+	    {
+	      best = i;
+	      best_pending = pending;
+	    }
+	  if (pending > 0)
+	    {
+	      fds[nfds].fd = worker->data_fd;
+	      fds[nfds].events = POLLOUT;
+	      fds[nfds].revents = 0;
+	      nfds++;
+	    }
+	}
+
+      if (best >= 0)
+	{
+	  if (worker_index < 0)
+	    {
+	      next_worker = best + 1;
+	    }
+	  return best;
+	}
+      if (loaddb_workers_interrupted)
+	{
+	  return -1;
+	}
+      if (poll (fds, nfds, -1) < 0 && errno != EINTR)
+	{
+	  return -1;
+	}
+    }
+}
+
+/*
+ * loaddb_hand_out_chunk - hand out the lines of a chunk to a worker
+ *    return: NO_ERROR if successful, error code otherwise
+ *    splitter(in/out):
+ *    chunk(in/out): emptied
+ */
+static int
+loaddb_hand_out_chunk (LOADDB_SPLITTER * splitter, LOADDB_CHUNK * chunk)
+{
+  LOADDB_WORKER *worker;
+  int i;
+  int error = NO_ERROR;
+
+  if (chunk->text.length == 0)
+    {
+      return NO_ERROR;
+    }
+
+  /* the lines that define or refer to instances go to the first worker */
+  i = loaddb_wait_for_worker ((chunk == &splitter->pinned) ? 0 : -1, LOADDB_CHUNK_SIZE);
+  if (i < 0)
+    {
+      return ER_FAILED;
+    }
+  worker = &loaddb_workers[i];
+
+  if (worker->class_no != chunk->class_no)
+    {
+      error = loaddb_buffer_append_line_no (&worker->pending, splitter->class_line_no);
+      if (error == NO_ERROR)
+	{
+	  error = loaddb_buffer_append (&worker->pending, splitter->class_line.data, splitter->class_line.length);
+	}
+      worker->class_no = chunk->class_no;
+    }
+  if (error == NO_ERROR)
+    {
+      error = loaddb_buffer_append (&worker->pending, chunk->text.data, chunk->text.length);
+    }
+
+  chunk->text.length = 0;
+  chunk->next_line_no = 0;
+  return error;
+}
+
+static int
+loaddb_hand_out_chunks (LOADDB_SPLITTER * splitter)
+{
+  int error;
+
+  error = loaddb_hand_out_chunk (splitter, &splitter->shared);
+  if (error == NO_ERROR)
+    {
+      error = loaddb_hand_out_chunk (splitter, &splitter->pinned);
+    }
+  return error;
+}
+
+/*
+ * loaddb_skip_blanks_and_comments - skip the blanks and comments at the
+ *                                   start of a line
+ *    return: first character of the line that is not skipped
+ *    p(in):
+ *    end(in):
+ */
+static const char *
+loaddb_skip_blanks_and_comments (const char *p, const char *end)
+{
+  while (p < end)
+    {
+      if (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')
+	{
+	  p++;
+	}
+      else if (p + 1 < end && ((p[0] == '-' && p[1] == '-') || (p[0] == '/' && p[1] == '/')))
+	{
+	  while (p < end && *p != '\n')
+	    {
+	      p++;
+	    }
+	}
+      else if (p + 1 < end && p[0] == '/' && p[1] == '*')
+	{
+	  for (p += 2; p < end && !(p[0] == '*' && p + 1 < end && p[1] == '/'); p++)
+	    {
+	      ;
+	    }
+	  p = (p < end) ? p + 2 : end;
+	}
+      else
+	{
+	  break;
+	}
+    }
+
+  return p;
+}
+
+/*
+ * loaddb_line_starts_with - check if a line is a command like %class
+ *    return: true if it is
+ *    p(in): first character of the line
+ *    end(in):
+ *    command(in):
+ */
+static bool
+loaddb_line_starts_with (const char *p, const char *end, const char *command)
+{
+  size_t length = strlen (command);
+
+  if ((size_t) (end - p) <= length || strncasecmp (p, command, length) != 0)
+    {
+      return false;
+    }
+
+  /* not a longer identifier */
+  return !(char_isalnum (p[length]) || p[length] == '_' || p[length] == '%' || p[length] == '#');
+}
+
+/*
+ * loaddb_line_defines_instance - check if a line starts with an instance id
+ *    return: true if it does
+ *    p(in): first character of the line
+ *    end(in):
+ */
+static bool
+loaddb_line_defines_instance (const char *p, const char *end)
+{
+  const char *q;
+
+  for (q = p; q < end && char_isdigit (*q); q++)
+    {
+      ;
+    }
+
+  /* "12:" is an id, "12:30" a time */
+  return q > p && q + 1 < end && q[0] == ':' && !char_isdigit (q[1]);
+}
+
+/*
+ * loaddb_split_line - hand out a line of the object file
+ *    return: NO_ERROR if successful, error code otherwise
+ *    splitter(in/out):
+ */
+static int
+loaddb_split_line (LOADDB_SPLITTER * splitter)
+{
+  const char *text = splitter->line.data;
+  const char *end = text + splitter->line.length;
+  const char *p;
+  LOADDB_CHUNK *chunk;
+  int next_line_no = splitter->newlines + 1;
+  int i;
+  int error = NO_ERROR;
+
+  p = loaddb_skip_blanks_and_comments (text, end);
+  if (p == end)
+    {
+      /* nothing to load */
+    }
+  else if (loaddb_line_starts_with (p, end, "%class"))
+    {
+      error = loaddb_hand_out_chunks (splitter);
+      if (error == NO_ERROR)
+	{
+	  splitter->class_line.length = 0;
+	  error = loaddb_buffer_append (&splitter->class_line, text, splitter->line.length);
+	  splitter->class_line_no = splitter->line_no;
+	  splitter->class_no++;
+	}
+    }
+  else if (loaddb_line_starts_with (p, end, "%id"))
+    {
+      error = loaddb_hand_out_chunks (splitter);
+      for (i = 0; i < loaddb_num_workers && error == NO_ERROR; i++)
+	{
+	  error = loaddb_buffer_append_line_no (&loaddb_workers[i].pending, splitter->line_no);
+	  if (error == NO_ERROR)
+	    {
+	      error = loaddb_buffer_append (&loaddb_workers[i].pending, text, splitter->line.length);
+	    }
+	}
+    }
+  else
+    {
+      if (splitter->line_has_reference || loaddb_line_defines_instance (p, end))
+	{
+	  chunk = &splitter->pinned;
+	}
+      else
+	{
+	  chunk = &splitter->shared;
+	}
+
+      assert (chunk->text.length == 0 || chunk->class_no == splitter->class_no);
+      chunk->class_no = splitter->class_no;
+      if (chunk->next_line_no != splitter->line_no)
+	{
+	  error = loaddb_buffer_append_line_no (&chunk->text, splitter->line_no);
+	}
+      if (error == NO_ERROR)
+	{
+	  error = loaddb_buffer_append (&chunk->text, text, splitter->line.length);
+	}
+      chunk->next_line_no = next_line_no;
+
+      if (error == NO_ERROR && chunk->text.length >= LOADDB_CHUNK_SIZE)
+	{
+	  error = loaddb_hand_out_chunk (splitter, chunk);
+	}
+    }
+
+  splitter->line.length = 0;
+  splitter->line_no = next_line_no;
+  splitter->line_has_reference = false;
+  return error;
+}
+
+/*
+ * loaddb_split_block - split a block of the object file into lines
+ *    return: NO_ERROR if successful, error code otherwise
+ *    splitter(in/out):
+ *    block(in):
+ *    size(in):
+ * Note:
+ *    A line ends at a newline out of strings and comments, unless it is
+ *    continued by a backslash or by '+' after a string. The newlines are
+ *    counted the way the loader counts them, out of strings only.
+ */
+static int
+loaddb_split_block (LOADDB_SPLITTER * splitter, const char *block, size_t size)
+{
+  const char *start = block;
+  size_t i;
+  char c;
+  int error;
+
+  for (i = 0; i < size; i++)
+    {
+      c = block[i];
+      switch (splitter->state)
+	{
+	case LOADDB_SCAN_LINE:
+	  if (c == '\n')
+	    {
+	      splitter->newlines++;
+	      if (splitter->last != '\\' && splitter->last != '+')
+		{
+		  error = loaddb_buffer_append (&splitter->line, start, block + i + 1 - start);
+		  if (error == NO_ERROR)
+		    {
+		      error = loaddb_split_line (splitter);
+		    }
+		  if (error != NO_ERROR)
+		    {
+		      return error;
+		    }
+		  start = block + i + 1;
+		}
+	      splitter->last = c;
+	    }
+	  else if (c == '\'')
+	    {
+	      splitter->state = LOADDB_SCAN_SQS;
+	    }
+	  else if (c == '"')
+	    {
+	      splitter->state = LOADDB_SCAN_DQS;
+	    }
+	  else if (c == '[')
+	    {
+	      splitter->state = LOADDB_SCAN_BRACKET;
+	    }
+	  else if ((c == '-' || c == '/') && splitter->prev == c)
+	    {
+	      splitter->state = LOADDB_SCAN_LINE_COMMENT;
+	    }
+	  else if (c == '*' && splitter->prev == '/')
+	    {
+	      splitter->state = LOADDB_SCAN_COMMENT;
+	      c = '\0';
+	    }
+	  else if (c == '@')
+	    {
+	      splitter->line_has_reference = true;
+	    }
+
+	  if (c != ' ' && c != '\t' && c != '\r' && c != '\n')
+	    {
+	      splitter->last = c;
+	    }
+	  break;
+
+	case LOADDB_SCAN_SQS:
+	  if (c == '\'')
+	    {
+	      splitter->state = LOADDB_SCAN_LINE;
+	      splitter->last = c;
+	    }
+	  break;
+
+	case LOADDB_SCAN_DQS:
+	  if (c == '"')
+	    {
+	      splitter->state = LOADDB_SCAN_LINE;
+	      splitter->last = c;
+	    }
+	  break;
+
+	case LOADDB_SCAN_BRACKET:
+	  if (c == ']')
+	    {
+	      splitter->state = LOADDB_SCAN_LINE;
+	      splitter->last = c;
+	    }
+	  break;
+
+	case LOADDB_SCAN_LINE_COMMENT:
+	  if (c == '\n')
+	    {
+	      /* the comment takes the newline; the line goes on */
+	      splitter->newlines++;
+	      splitter->state = LOADDB_SCAN_LINE;
+	      splitter->last = c;
+	    }
+	  break;
+
+	case LOADDB_SCAN_COMMENT:
+	  if (c == '\n')
+	    {
+	      splitter->newlines++;
+	    }
+	  else if (c == '/' && splitter->prev == '*')
+	    {
+	      splitter->state = LOADDB_SCAN_LINE;
+	      c = '\0';
+	    }
+	  break;
+	}
+      splitter->prev = c;
+    }
+
+  return loaddb_buffer_append (&splitter->line, start, block + size - start);
+}
+
+/*
+ * loaddb_split_object_file - read the object file, or the data files it
+ *                            lists, and hand the lines out to the workers
+ *    return: NO_ERROR if successful, error code otherwise
+ *    object_file(in):
+ *    is_load_pass(in): false for the syntax check, true for the load
+ * Note:
+ *    The pipes of the pass are closed on return, which ends the input of
+ *    the workers.
+ */
+static int
+loaddb_split_object_file (FILE * object_file, bool is_load_pass)
+{
+  LOADDB_SPLITTER splitter;
+  LOADDB_WORKER *worker;
+  FILE *fp;
+  char *block;
+  size_t size;
+  int file_no;
+  int i;
+  int error = NO_ERROR;
+
+  memset (&splitter, 0, sizeof (splitter));
+
+  for (i = 0; i < loaddb_num_workers; i++)
+    {
+      worker = &loaddb_workers[i];
+      worker->data_fd = is_load_pass ? worker->load_pipe[1] : worker->check_pipe[1];
+      worker->pending.length = 0;
+      worker->written = 0;
+      worker->class_no = 0;
+      if (worker->data_fd >= 0)
+	{
+	  (void) fcntl (worker->data_fd, F_SETFL, fcntl (worker->data_fd, F_GETFL) | O_NONBLOCK);
+	}
+    }
+
+  block = (char *) malloc (LOADDB_READ_SIZE);
+  if (block == NULL)
+    {
+      error = ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  /* the data files of a manifest are split one after the other, each from its first line */
+  for (file_no = 0; error == NO_ERROR && file_no < MAX (Data_files_count, 1); file_no++)
+    {
+      fp = object_file;
+      if (Data_files_count > 0)
+	{
+	  fp = loaddb_open_data_file (file_no);
+	  if (fp == NULL)
+	    {
+	      error = ER_FAILED;
+	      break;
+	    }
+	}
+
+      splitter.state = LOADDB_SCAN_LINE;
+      splitter.prev = '\0';
+      splitter.last = '\n';
+      splitter.newlines = 0;
+      splitter.line_no = 1;
+      splitter.shared.next_line_no = 0;
+      splitter.pinned.next_line_no = 0;
+
+      while (error == NO_ERROR && !loaddb_workers_interrupted && (size = fread (block, 1, LOADDB_READ_SIZE, fp)) > 0)
+	{
+	  error = loaddb_split_block (&splitter, block, size);
+	}
+      if (error == NO_ERROR && (ferror (fp) || loaddb_workers_interrupted))
+	{
+	  error = ER_FAILED;
+	}
+
+      if (error == NO_ERROR && splitter.line.length > 0)
+	{
+	  /* the last line has no newline */
+	  error = loaddb_buffer_append (&splitter.line, "\n", 1);
+	  if (error == NO_ERROR)
+	    {
+	      splitter.newlines++;
+	      error = loaddb_split_line (&splitter);
+	    }
+	}
+      if (error == NO_ERROR)
+	{
+	  error = loaddb_hand_out_chunks (&splitter);
+	}
+
+      if (fp != object_file)
+	{
+	  fclose (fp);
+	}
+    }
+  for (i = 0; i < loaddb_num_workers && error == NO_ERROR; i++)
+    {
+      if (loaddb_wait_for_worker (i, 0) < 0)
+	{
+	  error = ER_FAILED;
+	}
+    }
+
+  for (i = 0; i < loaddb_num_workers; i++)
+    {
+      worker = &loaddb_workers[i];
+      loaddb_close_fd (is_load_pass ? &worker->load_pipe[1] : &worker->check_pipe[1]);
+      worker->data_fd = -1;
+    }
+
+  free (block);
+  free (splitter.line.data);
+  free (splitter.class_line.data);
+  free (splitter.shared.text.data);
+  free (splitter.pinned.text.data);
+  return error;
+}
+
+/*
+ * loaddb_load_in_workers - load the object file with the workers
+ *    return: status of loaddb
+ *    object_file(in/out): closed on return
+ *    interrupted(out): set if the load was interrupted
+ */
+static int
+loaddb_load_in_workers (FILE ** object_file, int *interrupted)
+{
+  LOADDB_WORKER_RESULT total, result;
+  struct timeval start_time, end_time;
+  INT64 elapsed_msec;
+  char verdict;
+  bool is_failed;
+  int failed;
+  int objects;
+  int status = 0;
+  int error;
+  int i;
+
+  if (Ignore_logging)
+    {
+      Interrupt_type = LDR_STOP_AND_COMMIT_INTERRUPT;
+    }
+  else
+    {
+      Interrupt_type = LDR_STOP_AND_ABORT_INTERRUPT;
+    }
+
+  /* the workers connect to the database now that the schema is loaded; a worker that is gone is found out when its
+   * results are read */
+  for (i = 0; i < loaddb_num_workers; i++)
+    {
+      (void) loaddb_send_verdict (&loaddb_workers[i], LOADDB_VERDICT_GO);
+    }
+
+  util_arm_signal_handlers (loaddb_interrupt_workers, loaddb_interrupt_workers);
+  gettimeofday (&start_time, NULL);
+
+  if (!Load_only)
+    {
+      print_log_msg ((int) Verbose, msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_CHECKING));
+      error = loaddb_split_object_file (*object_file, false);
+      failed = loaddb_read_results (&total);
+      if (total.errors)
+	{
+	  print_log_msg (1, msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_ERROR_COUNT),
+			 total.errors);
+	}
+
+      verdict = LOADDB_VERDICT_LOAD;
+      if (error != NO_ERROR || failed > 0)
+	{
+	  status = 3;
+	  verdict = LOADDB_VERDICT_QUIT;
+	}
+      else if (total.errors || Syntax_check)
+	{
+	  verdict = LOADDB_VERDICT_QUIT;
+	}
+      else
+	{
+	  fclose (*object_file);
+	  *object_file = fopen_ex (Object_file, "rb");	/* keep out ^Z */
+	  if (*object_file == NULL)
+	    {
+	      verdict = LOADDB_VERDICT_QUIT;
+	    }
+	}
+
+      for (i = 0; i < loaddb_num_workers; i++)
+	{
+	  (void) loaddb_send_verdict (&loaddb_workers[i], verdict);
+	}
+      if (verdict != LOADDB_VERDICT_LOAD)
+	{
+	  goto end;
+	}
+    }
+  else
+    {
+      for (i = 0; i < loaddb_num_workers; i++)
+	{
+	  loaddb_close_fd (&loaddb_workers[i].check_pipe[1]);
+	}
+    }
+
+  loaddb_advise_sequential_read (*object_file);
+  print_log_msg ((int) Verbose, msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_INSERTING));
+
+  error = loaddb_split_object_file (*object_file, true);
+  failed = loaddb_read_results (&total);
+  objects = total.objects;
+
+  /* the workers that got the interrupt have aborted or committed already */
+  if (total.interrupted > 0 || loaddb_workers_interrupted)
+    {
+      *interrupted = true;
+      print_log_msg (1, msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_OBJECT_COUNT),
+		     total.loaded);
+    }
+  is_failed = (failed > total.interrupted || (error != NO_ERROR && !*interrupted));
+  if (is_failed || *interrupted)
+    {
+      status = 3;
+    }
+
+  /* commit only what a serial load would commit */
+  if (total.errors == 0 && !is_failed && (!*interrupted || Interrupt_type == LDR_STOP_AND_COMMIT_INTERRUPT))
+    {
+      verdict = LOADDB_VERDICT_COMMIT;
+    }
+  else
+    {
+      verdict = LOADDB_VERDICT_ABORT;
+    }
+
+  if (total.errors)
+    {
+      print_log_msg (1, msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_ERROR_COUNT),
+		     total.errors);
+    }
+  else if (verdict == LOADDB_VERDICT_COMMIT && !*interrupted)
+    {
+      if (total.objects || total.fails)
+	{
+	  print_log_msg (1, msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB,
+					    LOADDB_MSG_INSERT_AND_FAIL_COUNT), total.objects, total.fails);
+	}
+      if (total.defaults)
+	{
+	  print_log_msg (1, msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_DEFAULT_COUNT),
+			 total.defaults);
+	}
+      print_log_msg ((int) Verbose,
+		     msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_COMMITTING));
+    }
+
+  for (i = 0; i < loaddb_num_workers; i++)
+    {
+      (void) loaddb_send_verdict (&loaddb_workers[i], verdict);
+    }
+  failed = loaddb_read_results (&total);
+  if (verdict != LOADDB_VERDICT_COMMIT || *interrupted)
+    {
+      goto end;
+    }
+  if (failed > 0)
+    {
+      /* the workers that did commit cannot be rolled back any more */
+      status = 3;
+      goto end;
+    }
+
+  gettimeofday (&end_time, NULL);
+  elapsed_msec = timeval_diff_in_msec (&end_time, &start_time);
+  print_log_msg (1, msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_INSTANCE_RATE),
+		 objects, (long long) (elapsed_msec / 1000), (int) (elapsed_msec % 1000),
+		 (long long) ((elapsed_msec > 0) ? (INT64) objects * 1000 / elapsed_msec : objects));
+
+  if (!Disable_statistics)
+    {
+      if (Verbose)
+	{
+	  print_log_msg (1, msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB,
+					    LOADDB_MSG_UPDATING_STATISTICS));
+	}
+      /* one worker at a time; they may have loaded the same classes */
+      for (i = 0; i < loaddb_num_workers; i++)
+	{
+	  if (loaddb_send_verdict (&loaddb_workers[i], LOADDB_VERDICT_STATISTICS) == NO_ERROR)
+	    {
+	      (void) loaddb_read_fully (loaddb_workers[i].result_pipe[0], &result, sizeof (result));
+	    }
+	}
+    }
+
+end:
+  if (*object_file != NULL)
+    {
+      fclose (*object_file);
+      *object_file = NULL;
+    }
+  loaddb_stop_workers ();
+
+  return status;
+}
+#endif /* !WINDOWS && !SA_MODE */
+
+/*
+ * loaddb_internal - internal main loaddb function
+ *    return: NO_ERROR if successful, error code otherwise
+ *    argc(in): argc of main
+ *    argv(in): argv of main
+ *    dba_mode(in):
+ */
+static int
+loaddb_internal (UTIL_FUNCTION_ARG * arg, int dba_mode)
+{
+  UTIL_ARG_MAP *arg_map = arg->arg_map;
+  int error = NO_ERROR;
+  /* set to static to avoid copiler warning (clobbered by longjump) */
+  static FILE *schema_file = NULL;
+  static FILE *index_file = NULL;
+  static FILE *object_file = NULL;
+  FILE *error_file = NULL;
+  int status = 0;
+  int errors = 0;
+  int objects = 0;
+  int defaults = 0;
+  int fails = 0;
+
+  int ldr_init_ret = NO_ERROR;
+  int lastcommit = 0;
+  /* set to static to avoid copiler warning (clobbered by longjump) */
+  static int interrupted = false;
+  int au_save = 0;
+  extern bool obt_Enable_autoincrement;
+  char log_file_name[PATH_MAX];
+  const char *msg_format;
+
+  LOADDB_INIT_DEBUG ();
+  obt_Enable_autoincrement = false;
+
+  Volume = utility_get_option_string_value (arg_map, OPTION_STRING_TABLE, 0);
+  Input_file = utility_get_option_string_value (arg_map, OPTION_STRING_TABLE, 1);
+  User_name = utility_get_option_string_value (arg_map, LOAD_USER_S, 0);
+  Password = utility_get_option_string_value (arg_map, LOAD_PASSWORD_S, 0);
+  Syntax_check = utility_get_option_bool_value (arg_map, LOAD_CHECK_ONLY_S);
+  Load_only = utility_get_option_bool_value (arg_map, LOAD_LOAD_ONLY_S);
+  Estimated_size = utility_get_option_int_value (arg_map, LOAD_ESTIMATED_SIZE_S);
+  Verbose = utility_get_option_bool_value (arg_map, LOAD_VERBOSE_S);
+  Disable_statistics = utility_get_option_bool_value (arg_map, LOAD_NO_STATISTICS_S);
+  Periodic_commit = utility_get_option_int_value (arg_map, LOAD_PERIODIC_COMMIT_S);
+  Verbose_commit = Periodic_commit > 0;
+  No_oid_hint = utility_get_option_bool_value (arg_map, LOAD_NO_OID_S);
+  Schema_file = utility_get_option_string_value (arg_map, LOAD_SCHEMA_FILE_S, 0);
+  Index_file = utility_get_option_string_value (arg_map, LOAD_INDEX_FILE_S, 0);
+  Object_file = utility_get_option_string_value (arg_map, LOAD_DATA_FILE_S, 0);
+  Error_file = utility_get_option_string_value (arg_map, LOAD_ERROR_CONTROL_FILE_S, 0);
+  Ignore_logging = utility_get_option_bool_value (arg_map, LOAD_IGNORE_LOGGING_S);
+  Table_name = utility_get_option_string_value (arg_map, LOAD_TABLE_NAME_S, 0);
+
+  Ignore_class_file = utility_get_option_string_value (arg_map, LOAD_IGNORE_CLASS_S, 0);
+  compare_Storage_order = utility_get_option_bool_value (arg_map, LOAD_COMPARE_STORAGE_ORDER_S);
+  Load_threads = utility_get_option_int_value (arg_map, LOAD_THREADS_S);
+
+  Input_file = Input_file ? Input_file : "";
+  Schema_file = Schema_file ? Schema_file : "";
+  Index_file = Index_file ? Index_file : "";
+  Object_file = Object_file ? Object_file : "";
+  Error_file = Error_file ? Error_file : "";
+  Table_name = Table_name ? Table_name : "";
+
+  if (ldr_validate_object_file (stderr, arg->argv0))
+    {
+      status = 1;
+      goto error_return;
+    }
+
+  /* error message log file */
+  sprintf (log_file_name, "%s_%s.err", Volume, arg->command_name);
+  er_init (log_file_name, ER_NEVER_EXIT);
+
+  if (Index_file[0] != '\0' && prm_get_integer_value (PRM_ID_SR_NBUFFERS) < LOAD_INDEX_MIN_SORT_BUFFER_PAGES)
+    {
+      sysprm_set_force (prm_get_name (PRM_ID_SR_NBUFFERS), LOAD_INDEX_MIN_SORT_BUFFER_PAGES_STRING);
+    }
+
+  sysprm_set_force (prm_get_name (PRM_ID_JAVA_STORED_PROCEDURE), "no");
+
+  /* open loaddb log file */
+  sprintf (log_file_name, "%s_%s", Volume, LOADDB_LOG_FILENAME_SUFFIX);
+  loaddb_log_file = fopen (log_file_name, "w+");
+  if (loaddb_log_file == NULL)
+    {
+      PRINT_AND_LOG_ERR_MSG ("Cannot open log file %s\n", log_file_name);
+      status = 2;
+      goto error_return;
+    }
+
+  if (Load_threads > 1 && Object_file[0] != 0)
+    {
+#if defined (SA_MODE)
+      msg_format = msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_INCOMPATIBLE_ARGS);
+      print_log_msg (1, msg_format, "--" LOAD_THREADS_L, "--" LOAD_SA_MODE_L);
+      util_log_write_errstr (msg_format, "--" LOAD_THREADS_L, "--" LOAD_SA_MODE_L);
+      status = 1;		/* parsing error */
+      goto error_return;
+#elif !defined (WINDOWS)
+      if (Load_threads > LOADDB_MAX_THREADS)
+	{
+	  Load_threads = LOADDB_MAX_THREADS;
+	}
+
+      /* the workers are forked before loaddb connects to the database */
+      if (loaddb_start_workers (arg->command_name, dba_mode) != NO_ERROR)
+	{
+	  PRINT_AND_LOG_ERR_MSG ("Cannot start %d load processes\n", Load_threads);
+	  status = 3;
+	  goto error_return;
+	}
+#endif /* !WINDOWS */
+    }
+
+  /* login */
+  error = loaddb_login (arg->command_name, dba_mode, true);
+  if (error != NO_ERROR)
+    {
+      if (er_errid () < ER_FAILED)
+	{
+	  // an error was set.
+	  print_log_msg (1, "%s\n", db_error_string (3));
+	  util_log_write_errstr ("%s\n", db_error_string (3));
+	}
+      else
+	{
+	  PRINT_AND_LOG_ERR_MSG ("Cannot restart database %s\n", Volume);
+	}
+      status = 3;
+      goto error_return;
+    }
+
+  /* disable trigger actions to be fired */
+  db_disable_trigger ();
+
+  /* check if schema/index/object files exist */
+  ldr_check_file_name_and_line_no ();
+
+  if (Schema_file[0] != 0)
+    {
+      schema_file = fopen (Schema_file, "r");
+      if (schema_file == NULL)
+	{
+	  msg_format = msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_BAD_INFILE);
+	  print_log_msg (1, msg_format, Schema_file);
+	  util_log_write_errstr (msg_format, Schema_file);
+	  status = 2;
+	  goto error_return;
+	}
+    }
+  if (Index_file[0] != 0)
+    {
+      index_file = fopen (Index_file, "r");
+      if (index_file == NULL)
+	{
+	  msg_format = msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_BAD_INFILE);
+	  print_log_msg (1, msg_format, Index_file);
+	  util_log_write_errstr (msg_format, Index_file);
+	  status = 2;
+	  goto error_return;
+	}
+    }
+  if (Object_file[0] != 0)
+    {
+      object_file = fopen_ex (Object_file, "rb");	/* keep out ^Z */
+
+      if (object_file == NULL)
+	{
+	  msg_format = msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_BAD_INFILE);
+	  print_log_msg (1, msg_format, Object_file);
+	  util_log_write_errstr (msg_format, Object_file);
+	  status = 2;
+	  goto error_return;
+	}
+      loaddb_advise_sequential_read (object_file);
+
+      if (loaddb_read_manifest (object_file) != NO_ERROR)
+	{
+	  status = 2;
+	  goto error_return;
+	}
+    }
+
+  if (Ignore_class_file)
+    {
+      int retval;
       retval = get_ignore_class_list (Ignore_class_file);
 
       if (retval < 0)
@@ -867,11 +2587,21 @@ loaddb_internal (UTIL_FUNCTION_ARG * arg, int dba_mode)
 
   /* if index file is specified, do index creation */
 
+#if !defined (WINDOWS) && !defined (SA_MODE)
+  if (object_file != NULL && loaddb_workers != NULL)
+    {
+      print_log_msg (1, "\nStart object loading.\n");
+      status = loaddb_load_in_workers (&object_file, &interrupted);
+    }
+#endif /* !WINDOWS && !SA_MODE */
+
   if (object_file != NULL)
     {
 #if defined (SA_MODE)
       locator_Dont_check_foreign_key = true;
 #endif
+      /* the server inserts the index keys of each flush in key order */
+      locator_Sort_flush_index_keys = true;
       print_log_msg (1, "\nStart object loading.\n");
       ldr_init (Verbose);
 
@@ -902,8 +2632,12 @@ loaddb_internal (UTIL_FUNCTION_ARG * arg, int dba_mode)
 	    {
 	      ldr_init_ret = ldr_init_class_spec (Table_name);
 	    }
-	  do_loader_parse (object_file);
+	  error = loaddb_parse_object_file (object_file);
 	  ldr_stats (&errors, &objects, &defaults, &lastcommit, &fails);
+	  if (error != NO_ERROR)
+	    {
+	      errors++;
+	    }
 	}
       else
 	{
@@ -923,6 +2657,7 @@ loaddb_internal (UTIL_FUNCTION_ARG * arg, int dba_mode)
 	  object_file = fopen_ex (Object_file, "rb");	/* keep out ^Z */
 	  if (object_file != NULL)
 	    {
+	      loaddb_advise_sequential_read (object_file);
 	      print_log_msg ((int) Verbose,
 			     msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_INSERTING));
 
@@ -959,8 +2694,12 @@ loaddb_internal (UTIL_FUNCTION_ARG * arg, int dba_mode)
 		    {
 		      ldr_init_class_spec (Table_name);
 		    }
-		  do_loader_parse (object_file);
+		  error = loaddb_parse_object_file (object_file);
 		  ldr_stats (&errors, &objects, &defaults, &lastcommit, &fails);
+		  if (error != NO_ERROR)
+		    {
+		      errors++;
+		    }
 		  if (errors)
 		    {
 		      if (lastcommit > 0)
@@ -1073,12 +2812,16 @@ loaddb_internal (UTIL_FUNCTION_ARG * arg, int dba_mode)
   (void) db_shutdown ();
 
   free_ignoreclasslist ();
+  loaddb_free_manifest ();
 
   fclose (loaddb_log_file);
 
   return status;
 
 error_return:
+#if !defined (WINDOWS) && !defined (SA_MODE)
+  loaddb_stop_workers ();
+#endif /* !WINDOWS && !SA_MODE */
   if (schema_file != NULL)
     {
       fclose (schema_file);
@@ -1098,6 +2841,7 @@ error_return:
     }
 
   free_ignoreclasslist ();
+  loaddb_free_manifest ();
 
   return status;
 }
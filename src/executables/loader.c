@@ -299,6 +299,8 @@ struct LDR_CONTEXT
   /* for the current class */
   int flush_interval;		/* The number of instances before a */
   /* flush is performed */
+  struct timeval start_time;	/* Time when loading of the class */
+  /* started */
 
   CLASS_TABLE *table;		/* Table of instances currently */
   /* accumlated for the class */
@@ -502,6 +504,7 @@ static int ldr_assign_class_id (DB_OBJECT * class_, int id);
 static DB_OBJECT *ldr_find_class (const char *classname);
 static DB_OBJECT *ldr_get_class_from_id (int id);
 static void ldr_clear_context (LDR_CONTEXT * context);
+static void ldr_print_class_rate (LDR_CONTEXT * context);
 static void ldr_clear_and_free_context (LDR_CONTEXT * context);
 static void ldr_internal_error (LDR_CONTEXT * context);
 static void display_error_line (int adjust);
@@ -4170,6 +4173,27 @@ ldr_flush (LDR_CONTEXT * context)
   context->inst_count = 0;
 }
 
+/*
+ * ldr_print_class_rate - print the number of instances loaded into current
+ *                        class and the rate they were loaded at
+ *    return: void
+ *    context(in): context
+ */
+static void
+ldr_print_class_rate (LDR_CONTEXT * context)
+{
+  struct timeval end_time;
+  INT64 elapsed_msec;
+  INT64 rate;
+
+  gettimeofday (&end_time, NULL);
+  elapsed_msec = timeval_diff_in_msec (&end_time, &context->start_time);
+  rate = (elapsed_msec > 0) ? (INT64) context->inst_total * 1000 / elapsed_msec : context->inst_total;
+
+  fprintf (stdout, msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_INSTANCE_RATE),
+	   context->inst_total, (long long) (elapsed_msec / 1000), (int) (elapsed_msec % 1000), (long long) rate);
+}
+
 /*
  * check_commit - check interrupt and commit w.r.t. commit period
  *    return: NO_ERROR if successful, error code otherwise
@@ -4434,8 +4458,16 @@ ldr_finish_context (LDR_CONTEXT * context)
 	    }
 	  if (context->verbose)
 	    {
-	      fprintf (stdout, msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_INSTANCE_COUNT),
-		       context->inst_total);
+	      if (context->validation_only)
+		{
+		  fprintf (stdout,
+			   msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_INSTANCE_COUNT),
+			   context->inst_total);
+		}
+	      else
+		{
+		  ldr_print_class_rate (context);
+		}
 	    }
 	}
     }
@@ -4556,6 +4588,7 @@ ldr_act_init_context (LDR_CONTEXT * context, const char *class_name, int len)
     }
 
   context->valid = true;
+  gettimeofday (&context->start_time, NULL);
   if (context->verbose)
     {
       fprintf (stdout, msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB, LOADDB_MSG_CLASS_TITLE),
@@ -39,6 +39,10 @@
 #include <time.h>
 #include <direct.h>
 #define	SIGALRM	14
+#else /* !WINDOWS */
+#include <unistd.h>
+#include <poll.h>
+#include <sys/wait.h>
 #endif /* WINDOWS */
 
 #include "authenticate.h"
@@ -160,8 +164,82 @@ static int total_approximate_class_objects = 0;
 
 #define HEADER_FORMAT 	"-------------------------------+--------------------------------\n""    %-25s  |  %23s \n""-------------------------------+--------------------------------\n"
 #define MSG_FORMAT 		"    %-25s  |  %10d (%3d%% / %3d%%)"
+#define RATE_FORMAT		"  %10lld rows/sec"
 static FILE *unloadlog_file = NULL;
 
+/*
+ * Parallel unload (--threads)
+ *
+ * unloaddb forks the workers before it connects to the database; each worker
+ * connects on its own and unloads the tasks unloaddb hands out to it through
+ * a pipe, largest first, into a data file of its own (or into files of the
+ * classes, with --datafile-per-class). A task is a class, or a part of a
+ * large class: a range of its heap pages, which the worker fetches a window
+ * of pages at a time. The classes that refer to objects, or whose objects are
+ * referred to, make up one task: they share the numbering of the objects, so
+ * one worker unloads them as a serial unload does.
+ *
+ * Before the workers connect, unloaddb locks the classes in shared mode and
+ * keeps them locked until the workers are done, so every worker reads the
+ * same committed objects. The object file is then a manifest that lists the
+ * data files (see LOAD_MANIFEST_HEADER); unloaddb reports the progress of the
+ * workers.
+ */
+#define UNLOAD_PART_MIN_PAGES 1024	/* a class is split in parts of so many heap pages at least */
+#define UNLOAD_FETCH_PAGES 256	/* heap pages of a part fetched by one scan */
+
+/* what a worker does next */
+#define UNLOAD_COMMAND_GO 'G'	/* connect to the database, followed by the password */
+#define UNLOAD_COMMAND_TASK 'T'	/* followed by the task */
+#define UNLOAD_COMMAND_QUIT 'Q'
+
+typedef struct unload_task UNLOAD_TASK;
+struct unload_task
+{
+  OID class_oid;		/* NULL for the classes that refer to objects or are referred to */
+  char class_name[DB_MAX_IDENTIFIER_LENGTH + 1];
+  int part;			/* 0 to n_parts - 1 */
+  int n_parts;
+  VPID lower;			/* heap pages of the part; NULL VPIDs for the whole heap */
+  VPID upper;
+  int est_pages;
+};
+
+/* what a worker reports on a class or a part, once it is unloaded */
+typedef struct unload_report UNLOAD_REPORT;
+struct unload_report
+{
+  int task_done;		/* last report on the task */
+  int status;			/* 0, or 1 if unloaddb must fail */
+  char class_name[DB_MAX_IDENTIFIER_LENGTH + 1];	/* empty when only the end of the task is reported */
+  int part;
+  int n_parts;
+  int objects;
+  int failed_objects;
+  INT64 elapsed_msec;
+};
+
+/* number of workers of unloaddb; 0 if it unloads the objects itself, and in the workers */
+static int unload_num_workers = 0;
+/* index of this process among the workers; -1 in unloaddb */
+static int unload_worker_no = -1;
+
+#if !defined (WINDOWS) && !defined (SA_MODE)
+typedef struct unload_worker UNLOAD_WORKER;
+struct unload_worker
+{
+  pid_t pid;
+  int command_pipe[2];		/* the worker reads [0] and unloaddb writes [1] */
+  int report_pipe[2];		/* unloaddb reads [0] and the worker writes [1] */
+  int task_no;			/* task the worker is unloading; -1 if none */
+};
+
+static UNLOAD_WORKER *unload_workers = NULL;
+/* pipe ends of this worker */
+static int unload_command_fd = -1;
+static int unload_report_fd = -1;
+#endif /* !WINDOWS && !SA_MODE */
+
 
 static int get_estimated_objs (HFID * hfid, int *est_objects);
 static int set_referenced_subclasses (DB_OBJECT * class_);
@@ -170,13 +248,29 @@ static void extractobjects_cleanup (void);
 static void extractobjects_term_handler (int sig);
 static bool mark_referenced_domain (SM_CLASS * class_ptr, int *num_set);
 static void gauge_alarm_handler (int sig);
-static int process_class (int cl_no);
+static int process_class (int cl_no, const UNLOAD_TASK * task);
 static int process_object (DESC_OBJ * desc_obj, OID * obj_oid, int referenced_class);
 static int process_set (DB_SET * set);
 static int process_value (DB_VALUE * value);
 static void update_hash (OID * object_oid, OID * class_oid, int *data);
 static DB_OBJECT *is_class (OID * obj_oid, OID * class_oid);
 static int all_classes_processed (void);
+static int print_class_ids (void);
+#if !defined (WINDOWS) && !defined (SA_MODE)
+static bool is_in_reference_group (int cl_no, SM_CLASS * class_ptr);
+static int unload_read_fully (int fd, void *data, size_t size);
+static int unload_write_fully (int fd, const void *data, size_t size);
+static void unload_close_fd (int *fd);
+static int unload_send_command (UNLOAD_WORKER * worker, char command, const UNLOAD_TASK * task);
+static int compare_tasks (const void *a, const void *b);
+static int unload_make_tasks (UNLOAD_TASK ** tasks_out, int *n_tasks_out);
+static void unload_print_progress (const UNLOAD_REPORT * report);
+static int unload_write_manifest (const UNLOAD_TASK * tasks, int n_tasks, const char *output_prefix);
+static int unload_in_workers (const char *exec_name, const char *output_prefix);
+static int unload_task_class (int cl_no, const UNLOAD_TASK * task, const char *output_dirname,
+			      const char *output_prefix, UNLOAD_REPORT * report);
+static int unload_run_tasks (const char *output_dirname, const char *output_prefix);
+#endif /* !WINDOWS && !SA_MODE */
 
 /*
  * get_estimated_objs - get the estimated number of object reside in file heap
@@ -340,6 +434,7 @@ extractobjects_cleanup (void)
 {
   if (obj_out)
     {
+      (void) text_print_end_writer (obj_out);
       if (obj_out->buffer != NULL)
 	free_and_init (obj_out->buffer);
       if (obj_out->fp != NULL)
@@ -372,6 +467,17 @@ extractobjects_cleanup (void)
 static void
 extractobjects_term_handler (int sig)
 {
+#if !defined (WINDOWS) && !defined (SA_MODE)
+  int i;
+
+  for (i = 0; i < unload_num_workers; i++)
+    {
+      if (unload_workers[i].pid > 0)
+	{
+	  (void) kill (unload_workers[i].pid, SIGTERM);
+	}
+    }
+#endif /* !WINDOWS && !SA_MODE */
   extractobjects_cleanup ();
   /* terminate a program */
   _exit (1);
@@ -429,6 +535,11 @@ mark_referenced_domain (SM_CLASS * class_ptr, int *num_set)
  * extractobjects - dump the database in loader format.
  *    return: 0 for success. 1 for error
  *    exec_name(in): utility name
+ *    output_dirname(in): directory of the object files
+ *    output_prefix(in): prefix of the object files
+ * Note:
+ *    Called by the workers of a parallel unload too; see unload_in_workers
+ *    and unload_run_tasks.
  */
 int
 extractobjects (const char *exec_name, const char *output_dirname, const char *output_prefix)
@@ -484,7 +595,8 @@ extractobjects (const char *exec_name, const char *output_dirname, const char *o
       return 1;
     }
 
-  if (!datafile_per_class)
+  /* unloaddb writes the manifest of the data files of its workers, a worker a data file of its own */
+  if (!datafile_per_class || unload_num_workers > 0)
     {
       output_filename = (char *) malloc (PATH_MAX);
 
@@ -492,7 +604,15 @@ extractobjects (const char *exec_name, const char *output_dirname, const char *o
 	{
 	  return 1;
 	}
-      snprintf (output_filename, PATH_MAX - 1, "%s/%s%s", output_dirname, output_prefix, OBJECT_SUFFIX);
+      if (unload_worker_no >= 0)
+	{
+	  snprintf (output_filename, PATH_MAX - 1, "%s/%s%s_%d", output_dirname, output_prefix, OBJECT_SUFFIX,
+		    unload_worker_no);
+	}
+      else
+	{
+	  snprintf (output_filename, PATH_MAX - 1, "%s/%s%s", output_dirname, output_prefix, OBJECT_SUFFIX);
+	}
 
       obj_out->fp = fopen_ex (output_filename, "wb");
       if (obj_out->fp == NULL)
@@ -530,9 +650,21 @@ extractobjects (const char *exec_name, const char *output_dirname, const char *o
     obj_out->iosize -= (obj_out->iosize % blksize);
 
     obj_out->buffer = (char *) malloc (obj_out->iosize);
+    if (obj_out->buffer == NULL)
+      {
+	status = 1;
+	goto end;
+      }
 
     obj_out->ptr = obj_out->buffer;	/* init */
     obj_out->count = 0;		/* init */
+
+    /* format objects while the previous buffer is written */
+    if (text_print_start_writer (obj_out) != NO_ERROR)
+      {
+	status = 1;
+	goto end;
+      }
   }
 
   /*
@@ -652,17 +784,6 @@ extractobjects (const char *exec_name, const char *output_dirname, const char *o
 	  else
 	    MARK_CLASS_REQUESTED (i);
 
-	  if (!datafile_per_class && (!required_class_only || IS_CLASS_REQUESTED (i)))
-	    {
-	      if (text_print
-		  (obj_out, NULL, 0, "%cid %s%s%s %d\n", '%', PRINT_IDENTIFIER (sm_ch_name ((MOBJ) class_ptr)),
-		   i) != NO_ERROR)
-		{
-		  status = 1;
-		  goto end;
-		}
-	    }
-
 	  if (IS_CLASS_REQUESTED (i))
 	    {
 	      if (!datafile_per_class)
@@ -739,6 +860,13 @@ extractobjects (const char *exec_name, const char *output_dirname, const char *o
 	}
     }
 
+  /* the worker that unloads the classes that refer to objects prints them with their objects */
+  if (!datafile_per_class && unload_num_workers == 0 && unload_worker_no < 0 && print_class_ids () != NO_ERROR)
+    {
+      status = 1;
+      goto end;
+    }
+
   OR_PUT_NULL_OID (&null_oid);
 
 #if defined(CUBRID_DEBUG)
@@ -830,9 +958,22 @@ extractobjects (const char *exec_name, const char *output_dirname, const char *o
 #endif /* CUBRID_DEBUG */
 
   /*
-   * Lock all unloaded classes with IS_LOCK
+   * Lock all unloaded classes with IS_LOCK. The workers of a parallel unload
+   * must all read the same objects: unloaddb locks the classes, including
+   * the referenced ones, with S_LOCK until the workers are done.
    */
-  if (locator_fetch_set (num_unload_classes, unload_class_table, DB_FETCH_READ, DB_FETCH_READ, true) == NULL)
+  if (unload_num_workers > 0)
+    {
+      for (i = 0; i < class_table->num; i++)
+	{
+	  if (IS_CLASS_REFERENCED (i) && !IS_CLASS_REQUESTED (i))
+	    {
+	      unload_class_table[num_unload_classes++] = class_table->mops[i];
+	    }
+	}
+    }
+  if (locator_fetch_set (num_unload_classes, unload_class_table, DB_FETCH_READ,
+			 (unload_num_workers > 0) ? DB_FETCH_QUERY_READ : DB_FETCH_READ, true) == NULL)
     {
       status = 1;
       goto end;
@@ -855,10 +996,18 @@ extractobjects (const char *exec_name, const char *output_dirname, const char *o
   /*
    * Create the hash table
    */
-  if (has_obj_ref || num_cls_ref > 0)
+  if ((has_obj_ref || num_cls_ref > 0) && unload_num_workers == 0)
     {				/* found any referenced domain */
+      char *hash_file = hash_filename;
+      char worker_hash_file[PATH_MAX];
+
+      if (hash_filename != NULL && unload_worker_no >= 0)
+	{
+	  snprintf (worker_hash_file, sizeof (worker_hash_file), "%s_%d", hash_filename, unload_worker_no);
+	  hash_file = worker_hash_file;
+	}
       obj_table =
-	fh_create ("object hash", est_size, page_size, cached_pages, hash_filename, FH_OID_KEY, DB_SIZEOF (int),
+	fh_create ("object hash", est_size, page_size, cached_pages, hash_file, FH_OID_KEY, DB_SIZEOF (int),
 		   oid_hash, oid_compare_equals);
 
       if (obj_table == NULL)
@@ -872,75 +1021,92 @@ extractobjects (const char *exec_name, const char *output_dirname, const char *o
    * Dump the object definitions
    */
   total_approximate_class_objects = est_objects;
-  snprintf (unloadlog_filename, sizeof (unloadlog_filename) - 1, "%s_unloaddb.log", output_prefix);
-  unloadlog_file = fopen (unloadlog_filename, "w+");
-  if (unloadlog_file != NULL)
+  if (unload_worker_no < 0)
+    {
+      snprintf (unloadlog_filename, sizeof (unloadlog_filename) - 1, "%s_unloaddb.log", output_prefix);
+      unloadlog_file = fopen (unloadlog_filename, "w+");
+      if (unloadlog_file != NULL)
+	{
+	  fprintf (unloadlog_file, HEADER_FORMAT, "Class Name", "Total Instances");
+	}
+      if (verbose_flag)
+	{
+	  fprintf (stdout, HEADER_FORMAT, "Class Name", "Total Instances");
+	}
+    }
+
+#if !defined (WINDOWS) && !defined (SA_MODE)
+  if (unload_num_workers > 0)
     {
-      fprintf (unloadlog_file, HEADER_FORMAT, "Class Name", "Total Instances");
+      status = unload_in_workers (exec_name, output_prefix);
     }
-  if (verbose_flag)
+  else if (unload_worker_no >= 0)
     {
-      fprintf (stdout, HEADER_FORMAT, "Class Name", "Total Instances");
+      status = unload_run_tasks (output_dirname, output_prefix);
     }
-
-  do
+  else
+#endif /* !WINDOWS && !SA_MODE */
     {
-      for (i = 0; i < class_table->num; i++)
+      do
 	{
-	  if (!WS_IS_DELETED (class_table->mops[i]) && class_table->mops[i] != sm_Root_class_mop)
+	  for (i = 0; i < class_table->num; i++)
 	    {
-	      int ret_val;
-
-	      if (datafile_per_class && IS_CLASS_REQUESTED (i))
+	      if (!WS_IS_DELETED (class_table->mops[i]) && class_table->mops[i] != sm_Root_class_mop)
 		{
-		  char outfile[PATH_MAX];
+		  int ret_val;
 
-		  ws_find (class_table->mops[i], (MOBJ *) (&class_ptr));
-		  if (class_ptr == NULL)
+		  if (datafile_per_class && IS_CLASS_REQUESTED (i))
 		    {
-		      status = 1;
-		      goto end;
-		    }
+		      char outfile[PATH_MAX];
 
-		  snprintf (outfile, PATH_MAX - 1, "%s/%s_%s%s", output_dirname, output_prefix,
-			    sm_ch_name ((MOBJ) class_ptr), OBJECT_SUFFIX);
+		      ws_find (class_table->mops[i], (MOBJ *) (&class_ptr));
+		      if (class_ptr == NULL)
+			{
+			  status = 1;
+			  goto end;
+			}
 
-		  obj_out->fp = fopen_ex (outfile, "wb");
-		  if (obj_out->fp == NULL)
-		    {
-		      status = 1;
-		      goto end;
+		      snprintf (outfile, PATH_MAX - 1, "%s/%s_%s%s", output_dirname, output_prefix,
+				sm_ch_name ((MOBJ) class_ptr), OBJECT_SUFFIX);
+
+		      obj_out->fp = fopen_ex (outfile, "wb");
+		      if (obj_out->fp == NULL)
+			{
+			  status = 1;
+			  goto end;
+			}
 		    }
-		}
 
-	      ret_val = process_class (i);
+		  ret_val = process_class (i, NULL);
 
-	      if (datafile_per_class && IS_CLASS_REQUESTED (i))
-		{
-		  if (text_print_flush (obj_out) != NO_ERROR)
+		  if (datafile_per_class && IS_CLASS_REQUESTED (i))
 		    {
-		      status = 1;
-		      goto end;
-		    }
+		      if (text_print_flush (obj_out) != NO_ERROR)
+			{
+			  status = 1;
+			  goto end;
+			}
 
-		  fclose (obj_out->fp);
-		  obj_out->fp = NULL;
-		}
+		      fclose (obj_out->fp);
+		      obj_out->fp = NULL;
+		    }
 
-	      if (ret_val != NO_ERROR)
-		{
-		  if (!ignore_err_flag)
+		  if (ret_val != NO_ERROR)
 		    {
-		      status = 1;
-		      goto end;
+		      if (!ignore_err_flag)
+			{
+			  status = 1;
+			  goto end;
+			}
 		    }
 		}
 	    }
 	}
+      while (!all_classes_processed ());
     }
-  while (!all_classes_processed ());
 
-  if (failed_objects != 0)
+  /* a worker reports its failed objects to unloaddb */
+  if (failed_objects != 0 && unload_worker_no < 0)
     {
       status = 1;
       fprintf (stdout, msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_UNLOADDB, UNLOADDB_MSG_OBJECTS_FAILED),
@@ -971,7 +1137,7 @@ extractobjects (const char *exec_name, const char *output_dirname, const char *o
     }
 
   /* flush remaining buffer */
-  if (!datafile_per_class && text_print_flush (obj_out) != NO_ERROR)
+  if (obj_out->fp != NULL && text_print_flush (obj_out) != NO_ERROR)
     {
       status = 1;
     }
@@ -1031,9 +1197,10 @@ gauge_alarm_handler (int sig)
  * process_class - dump one class in loader format
  *    return: NO_ERROR, if successful, error number, if not successful.
  *    cl_no(in): class object index for class_table
+ *    task(in): part of the class a worker unloads; NULL for the whole class
  */
 static int
-process_class (int cl_no)
+process_class (int cl_no, const UNLOAD_TASK * task)
 {
   int error = NO_ERROR;
   DB_OBJECT *class_ = class_table->mops[cl_no];
@@ -1060,12 +1227,21 @@ process_class (int cl_no)
   time_t start = 0;
 #endif
   int total;
+  struct timeval start_time, end_time;
+  INT64 elapsed_msec;
+  long long rate;
+  /* the shared and class attributes are unloaded with the first part */
+  bool has_class_values = (task == NULL || task->part == 0);
+  bool is_part = (task != NULL && task->n_parts > 1);
+  VPID *part_pages = NULL;
+  int n_part_pages = 0;
+  int window, n_window_pages;
 
   /*
    * Only process classes that were requested or classes that were
    * referenced via requested classes.
    */
-  if (IS_CLASS_PROCESSED (cl_no))
+  if (task == NULL && IS_CLASS_PROCESSED (cl_no))
     {
       goto exit_on_end;		/* do nothing successfully */
     }
@@ -1096,7 +1272,7 @@ process_class (int cl_no)
   for (attribute = class_ptr->shared; attribute != NULL; attribute = (SM_ATTRIBUTE *) attribute->header.next)
     {
 
-      if (DB_VALUE_TYPE (&attribute->default_value.value) == DB_TYPE_NULL)
+      if (!has_class_values || DB_VALUE_TYPE (&attribute->default_value.value) == DB_TYPE_NULL)
 	{
 	  continue;
 	}
@@ -1122,7 +1298,7 @@ process_class (int cl_no)
   v = 0;
   for (attribute = class_ptr->shared; attribute != NULL; attribute = (SM_ATTRIBUTE *) attribute->header.next)
     {
-      if (DB_VALUE_TYPE (&attribute->default_value.value) == DB_TYPE_NULL)
+      if (!has_class_values || DB_VALUE_TYPE (&attribute->default_value.value) == DB_TYPE_NULL)
 	{
 	  continue;
 	}
@@ -1147,7 +1323,7 @@ process_class (int cl_no)
   v = 0;
   for (attribute = class_ptr->class_attributes; attribute != NULL; attribute = (SM_ATTRIBUTE *) attribute->header.next)
     {
-      if (DB_VALUE_TYPE (&attribute->default_value.value) == DB_TYPE_NULL)
+      if (!has_class_values || DB_VALUE_TYPE (&attribute->default_value.value) == DB_TYPE_NULL)
 	{
 	  continue;
 	}
@@ -1173,7 +1349,7 @@ process_class (int cl_no)
   for (attribute = class_ptr->class_attributes; attribute != NULL; attribute = (SM_ATTRIBUTE *) attribute->header.next)
     {
 
-      if (DB_VALUE_TYPE (&attribute->default_value.value) == DB_TYPE_NULL)
+      if (!has_class_values || DB_VALUE_TYPE (&attribute->default_value.value) == DB_TYPE_NULL)
 	{
 	  continue;
 	}
@@ -1221,8 +1397,11 @@ process_class (int cl_no)
 	{
 	  total = (int) (100 * ((float) total_objects / (float) total_approximate_class_objects));
 	}
-      fprintf (unloadlog_file, MSG_FORMAT "\n", sm_ch_name ((MOBJ) class_ptr), 0, 100, total);
-      fflush (unloadlog_file);
+      if (unloadlog_file != NULL)
+	{
+	  fprintf (unloadlog_file, MSG_FORMAT "\n", sm_ch_name ((MOBJ) class_ptr), 0, 100, total);
+	  fflush (unloadlog_file);
+	}
       if (verbose_flag)
 	{
 	  fprintf (stdout, MSG_FORMAT "\n", sm_ch_name ((MOBJ) class_ptr), 0, 100, total);
@@ -1243,8 +1422,11 @@ process_class (int cl_no)
 	{
 	  total = (int) (100 * ((float) total_objects / (float) total_approximate_class_objects));
 	}
-      fprintf (unloadlog_file, MSG_FORMAT "\n", sm_ch_name ((MOBJ) class_ptr), 0, 100, total);
-      fflush (unloadlog_file);
+      if (unloadlog_file != NULL)
+	{
+	  fprintf (unloadlog_file, MSG_FORMAT "\n", sm_ch_name ((MOBJ) class_ptr), 0, 100, total);
+	  fflush (unloadlog_file);
+	}
       if (verbose_flag)
 	{
 	  fprintf (stdout, MSG_FORMAT "\n", sm_ch_name ((MOBJ) class_ptr), 0, 100, total);
@@ -1253,12 +1435,13 @@ process_class (int cl_no)
       goto exit_on_end;
     }
 
-  nobjects = 0;
-  nfetched = -1;
-  OID_SET_NULL (&last_oid);
-
   /* Now start fetching all the instances */
 
+  if (is_part && heap_get_pages (hfid, &task->lower, &task->upper, 1, &part_pages, &n_part_pages) != NO_ERROR)
+    {
+      goto exit_on_error;
+    }
+
   approximate_class_objects = 0;
   if (get_estimated_objs (hfid, &approximate_class_objects) < 0)
     {
@@ -1276,90 +1459,110 @@ process_class (int cl_no)
     }
 
   desc_obj = make_desc_obj (class_ptr);
+  gettimeofday (&start_time, NULL);
 
-  while (nobjects != nfetched)
+  /* a part is fetched a window of pages at a time, each with a scan of its own; a part without pages is empty */
+  window = 0;
+  do
     {
-      if (locator_fetch_all
-	  (hfid, &lock, LC_FETCH_MVCC_VERSION, class_oid, &nobjects, &nfetched, &last_oid, &fetch_area) == NO_ERROR)
+      n_window_pages = MIN (n_part_pages - window, UNLOAD_FETCH_PAGES);
+      lock = IS_LOCK;
+      nobjects = 0;
+      nfetched = (is_part && n_part_pages == 0) ? 0 : -1;
+      OID_SET_NULL (&last_oid);
+
+      while (nobjects != nfetched)
 	{
-	  if (fetch_area != NULL)
+	  if (locator_fetch_all_pages (hfid, &lock, LC_FETCH_MVCC_VERSION, class_oid,
+				       (n_window_pages > 0) ? part_pages + window : NULL, n_window_pages, &nobjects,
+				       &nfetched, &last_oid, &fetch_area) == NO_ERROR)
 	    {
-	      mobjs = LC_MANYOBJS_PTR_IN_COPYAREA (fetch_area);
-	      obj = LC_START_ONEOBJ_PTR_IN_COPYAREA (mobjs);
-
-	      for (i = 0; i < mobjs->num_objs; ++i)
+	      if (fetch_area != NULL)
 		{
-		  /*
-		   * Process all objects for a requested class, but
-		   * only referenced objects for a referenced class.
-		   */
-		  ++class_objects;
-		  ++total_objects;
-		  LC_RECDES_TO_GET_ONEOBJ (fetch_area, obj, &recdes);
-		  if ((error = desc_disk_to_obj (class_, class_ptr, &recdes, desc_obj)) == NO_ERROR)
+		  mobjs = LC_MANYOBJS_PTR_IN_COPYAREA (fetch_area);
+		  obj = LC_START_ONEOBJ_PTR_IN_COPYAREA (mobjs);
+
+		  for (i = 0; i < mobjs->num_objs; ++i)
 		    {
-		      if ((error = process_object (desc_obj, &obj->oid, referenced_class)) != NO_ERROR)
+		      /*
+		       * Process all objects for a requested class, but
+		       * only referenced objects for a referenced class.
+		       */
+		      ++class_objects;
+		      ++total_objects;
+		      LC_RECDES_TO_GET_ONEOBJ (fetch_area, obj, &recdes);
+		      if ((error = desc_disk_to_obj (class_, class_ptr, &recdes, desc_obj)) == NO_ERROR)
 			{
-			  if (!ignore_err_flag)
+			  if ((error = process_object (desc_obj, &obj->oid, referenced_class)) != NO_ERROR)
 			    {
-			      desc_free (desc_obj);
-			      locator_free_copy_area (fetch_area);
-			      goto exit_on_error;
+			      if (!ignore_err_flag)
+				{
+				  desc_free (desc_obj);
+				  locator_free_copy_area (fetch_area);
+				  goto exit_on_error;
+				}
 			    }
 			}
-		    }
-		  else
-		    {
-		      if (error == ER_TF_BUFFER_UNDERFLOW)
+		      else
 			{
-			  desc_free (desc_obj);
-			  goto exit_on_error;
+			  if (error == ER_TF_BUFFER_UNDERFLOW)
+			    {
+			      desc_free (desc_obj);
+			      goto exit_on_error;
+			    }
+			  ++failed_objects;
 			}
-		      ++failed_objects;
-		    }
-		  obj = LC_NEXT_ONEOBJ_PTR_IN_COPYAREA (obj);
+		      obj = LC_NEXT_ONEOBJ_PTR_IN_COPYAREA (obj);
 #if defined(WINDOWS)
-		  if (verbose_flag && (i % 10 == 0))
-		    {
-		      _ftime (&timebuffer);
-		      if (start == 0)
-			{
-			  start = timebuffer.time;
-			}
-		      else
+		      if (verbose_flag && (i % 10 == 0))
 			{
-			  if ((timebuffer.time - start) > GAUGE_INTERVAL)
+			  _ftime (&timebuffer);
+			  if (start == 0)
 			    {
-			      gauge_alarm_handler (SIGALRM);
 			      start = timebuffer.time;
 			    }
+			  else
+			    {
+			      if ((timebuffer.time - start) > GAUGE_INTERVAL)
+				{
+				  gauge_alarm_handler (SIGALRM);
+				  start = timebuffer.time;
+				}
+			    }
 			}
-		    }
 #endif
+		    }
+		  locator_free_copy_area (fetch_area);
+		}
+	      else
+		{
+		  /* No more objects */
+		  break;
 		}
-	      locator_free_copy_area (fetch_area);
 	    }
 	  else
 	    {
-	      /* No more objects */
-	      break;
-	    }
-	}
-      else
-	{
-	  /* some error was occurred */
-	  if (!ignore_err_flag)
-	    {
-	      desc_free (desc_obj);
-	      goto exit_on_error;
+	      /* some error was occurred */
+	      if (!ignore_err_flag)
+		{
+		  desc_free (desc_obj);
+		  goto exit_on_error;
+		}
+	      else
+		++failed_objects;
 	    }
-	  else
-	    ++failed_objects;
 	}
+
+      window += n_window_pages;
     }
+  while (window < n_part_pages);
 
   desc_free (desc_obj);
 
+  gettimeofday (&end_time, NULL);
+  elapsed_msec = timeval_diff_in_msec (&end_time, &start_time);
+  rate = (elapsed_msec > 0) ? (long long) class_objects * 1000 / elapsed_msec : class_objects;
+
   total_approximate_class_objects += (class_objects - approximate_class_objects);
   if (total_objects == total_approximate_class_objects)
     {
@@ -1376,12 +1579,20 @@ process_class (int cl_no)
       (void) os_set_signal_handler (SIGALRM, prev_handler);
 #endif
 
-      fprintf (stdout, MSG_FORMAT "\n", sm_ch_name ((MOBJ) class_ptr), class_objects, 100, total);
+      fprintf (stdout, MSG_FORMAT RATE_FORMAT "\n", sm_ch_name ((MOBJ) class_ptr), class_objects, 100, total, rate);
       fflush (stdout);
     }
-  fprintf (unloadlog_file, MSG_FORMAT "\n", sm_ch_name ((MOBJ) class_ptr), class_objects, 100, total);
+  if (unloadlog_file != NULL)
+    {
+      fprintf (unloadlog_file, MSG_FORMAT RATE_FORMAT "\n", sm_ch_name ((MOBJ) class_ptr), class_objects, 100, total,
+	       rate);
+    }
 
 exit_on_end:
+  if (part_pages != NULL)
+    {
+      free_and_init (part_pages);
+    }
 
   return error;
 
@@ -1833,6 +2044,966 @@ all_classes_processed (void)
   return 1;
 }
 
+/*
+ * print_class_ids - print the %id lines of the classes, which references to
+ *                   objects are printed with
+ *    return: NO_ERROR, if successful, error number, if not successful.
+ */
+static int
+print_class_ids (void)
+{
+  int error = NO_ERROR;
+  SM_CLASS *class_ptr;
+  int *cls_no_ptr;
+  int i;
+
+  for (i = 0; i < class_table->num; i++)
+    {
+      if (WS_IS_DELETED (class_table->mops[i]) || class_table->mops[i] == sm_Root_class_mop)
+	{
+	  continue;
+	}
+
+      /* only the classes that are unloaded are hashed */
+      if (fh_get (cl_table, ws_oid (class_table->mops[i]), (FH_DATA *) (&cls_no_ptr)) != NO_ERROR
+	  || cls_no_ptr == NULL)
+	{
+	  continue;
+	}
+
+      if (!required_class_only || IS_CLASS_REQUESTED (i))
+	{
+	  ws_find (class_table->mops[i], (MOBJ *) (&class_ptr));
+	  if (class_ptr == NULL)
+	    {
+	      goto exit_on_error;
+	    }
+	  CHECK_PRINT_ERROR (text_print
+			     (obj_out, NULL, 0, "%cid %s%s%s %d\n", '%', PRINT_IDENTIFIER (sm_ch_name ((MOBJ) class_ptr)),
+			      i));
+	}
+    }
+
+exit_on_end:
+
+  return error;
+
+exit_on_error:
+
+  CHECK_EXIT_ERROR (error);
+  goto exit_on_end;
+}
+
+#if !defined (WINDOWS) && !defined (SA_MODE)
+/*
+ * is_in_reference_group - check if the objects of a class are numbered, or
+ *                         refer to numbered objects
+ *    return: true if they are
+ *    cl_no(in): class object index for class_table
+ *    class_ptr(in): the class
+ * Note:
+ *    A parallel unload unloads all such classes with one worker, which
+ *    numbers the objects like a serial unload does.
+ */
+static bool
+is_in_reference_group (int cl_no, SM_CLASS * class_ptr)
+{
+  SM_ATTRIBUTE *attribute;
+  int num_cls_ref = 0;
+
+  if (datafile_per_class)
+    {
+      /* the objects are not numbered and the references are unloaded as NULL */
+      return false;
+    }
+  if (IS_CLASS_REFERENCED (cl_no))
+    {
+      return true;
+    }
+
+  for (attribute = class_ptr->shared; attribute != NULL; attribute = (SM_ATTRIBUTE *) attribute->header.next)
+    {
+      if (check_referenced_domain (attribute->domain, false, &num_cls_ref))
+	{
+	  return true;
+	}
+    }
+  for (attribute = class_ptr->class_attributes; attribute != NULL; attribute = (SM_ATTRIBUTE *) attribute->header.next)
+    {
+      if (check_referenced_domain (attribute->domain, false, &num_cls_ref))
+	{
+	  return true;
+	}
+    }
+  for (attribute = class_ptr->ordered_attributes; attribute; attribute = attribute->order_link)
+    {
+      if (attribute->header.name_space == ID_ATTRIBUTE
+	  && check_referenced_domain (attribute->domain, false, &num_cls_ref))
+	{
+	  return true;
+	}
+    }
+
+  return num_cls_ref > 0;
+}
+
+/*
+ * unload_read_fully - read size bytes from a pipe
+ *    return: NO_ERROR if successful, ER_FAILED on end of file or error
+ *    fd(in):
+ *    data(out):
+ *    size(in):
+ */
+static int
+unload_read_fully (int fd, void *data, size_t size)
+{
+  char *p = (char *) data;
+  ssize_t n;
+
+  while (size > 0)
+    {
+      n = read (fd, p, size);
+      if (n < 0 && errno == EINTR)
+	{
+	  continue;
+	}
+      if (n <= 0)
+	{
+	  return ER_FAILED;
+	}
+      p += n;
+      size -= n;
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * unload_write_fully - write size bytes to a pipe
+ *    return: NO_ERROR if successful, ER_FAILED otherwise
+ *    fd(in):
+ *    data(in):
+ *    size(in):
+ */
+static int
+unload_write_fully (int fd, const void *data, size_t size)
+{
+  const char *p = (const char *) data;
+  ssize_t n;
+
+  while (size > 0)
+    {
+      n = write (fd, p, size);
+      if (n < 0 && errno == EINTR)
+	{
+	  continue;
+	}
+      if (n <= 0)
+	{
+	  return ER_FAILED;
+	}
+      p += n;
+      size -= n;
+    }
+
+  return NO_ERROR;
+}
+
+static void
+unload_close_fd (int *fd)
+{
+  if (*fd >= 0)
+    {
+      close (*fd);
+      *fd = -1;
+    }
+}
+
+/*
+ * unload_start_workers - fork the worker processes of a parallel unload
+ *    return: NO_ERROR if successful, ER_FAILED otherwise
+ * Note:
+ *    Called before unloaddb connects to the database, in unloaddb and, on
+ *    return, in each worker (see unload_is_worker). A worker waits in
+ *    unload_wait_for_go until unloaddb has locked the classes.
+ */
+int
+unload_start_workers (void)
+{
+  UNLOAD_WORKER *worker;
+  pid_t pid;
+  int i, j;
+
+  unload_workers = (UNLOAD_WORKER *) calloc (unload_threads, sizeof (UNLOAD_WORKER));
+  if (unload_workers == NULL)
+    {
+      return ER_FAILED;
+    }
+  unload_num_workers = unload_threads;
+
+  for (i = 0; i < unload_num_workers; i++)
+    {
+      worker = &unload_workers[i];
+      worker->pid = -1;
+      worker->command_pipe[0] = worker->command_pipe[1] = -1;
+      worker->report_pipe[0] = worker->report_pipe[1] = -1;
+      worker->task_no = -1;
+    }
+
+  for (i = 0; i < unload_num_workers; i++)
+    {
+      worker = &unload_workers[i];
+      if (pipe (worker->command_pipe) != 0 || pipe (worker->report_pipe) != 0)
+	{
+	  goto error_exit;
+	}
+    }
+
+  /* do not let the workers write what is buffered again */
+  fflush (NULL);
+
+  for (i = 0; i < unload_num_workers; i++)
+    {
+      pid = fork ();
+      if (pid < 0)
+	{
+	  goto error_exit;
+	}
+
+      if (pid == 0)
+	{
+	  /* keep only the pipe ends of this worker */
+	  unload_command_fd = unload_workers[i].command_pipe[0];
+	  unload_report_fd = unload_workers[i].report_pipe[1];
+	  for (j = 0; j < unload_num_workers; j++)
+	    {
+	      worker = &unload_workers[j];
+	      if (j != i)
+		{
+		  unload_close_fd (&worker->command_pipe[0]);
+		  unload_close_fd (&worker->report_pipe[1]);
+		}
+	      unload_close_fd (&worker->command_pipe[1]);
+	      unload_close_fd (&worker->report_pipe[0]);
+	    }
+	  free_and_init (unload_workers);
+	  unload_num_workers = 0;
+	  unload_worker_no = i;
+
+	  (void) os_set_signal_handler (SIGPIPE, SIG_IGN);
+	  return NO_ERROR;
+	}
+
+      unload_workers[i].pid = pid;
+    }
+
+  for (i = 0; i < unload_num_workers; i++)
+    {
+      worker = &unload_workers[i];
+      unload_close_fd (&worker->command_pipe[0]);
+      unload_close_fd (&worker->report_pipe[1]);
+    }
+  (void) os_set_signal_handler (SIGPIPE, SIG_IGN);
+
+  return NO_ERROR;
+
+error_exit:
+  unload_stop_workers ();
+  return ER_FAILED;
+}
+
+/*
+ * unload_stop_workers - close the pipes to the workers and wait until they
+ *                       exit; called by unloaddb
+ *    return: void
+ * Note:
+ *    A worker that is waiting for the go or for a task just exits.
+ */
+void
+unload_stop_workers (void)
+{
+  UNLOAD_WORKER *worker;
+  int i, status;
+
+  if (unload_workers == NULL)
+    {
+      return;
+    }
+
+  for (i = 0; i < unload_num_workers; i++)
+    {
+      worker = &unload_workers[i];
+      unload_close_fd (&worker->command_pipe[0]);
+      unload_close_fd (&worker->command_pipe[1]);
+      unload_close_fd (&worker->report_pipe[0]);
+      unload_close_fd (&worker->report_pipe[1]);
+    }
+
+  for (i = 0; i < unload_num_workers; i++)
+    {
+      if (unload_workers[i].pid > 0)
+	{
+	  while (waitpid (unload_workers[i].pid, &status, 0) < 0 && errno == EINTR)
+	    {
+	      ;
+	    }
+	}
+    }
+
+  free_and_init (unload_workers);
+  unload_num_workers = 0;
+}
+
+/*
+ * unload_wait_for_go - wait until unloaddb lets the worker connect to the
+ *                      database; called by a worker
+ *    return: NO_ERROR if successful, ER_FAILED if unloaddb gave up
+ *    password(out): the password unloaddb connected with
+ */
+int
+unload_wait_for_go (char **password)
+{
+  char command;
+  int length;
+
+  *password = NULL;
+  if (unload_read_fully (unload_command_fd, &command, 1) != NO_ERROR || command != UNLOAD_COMMAND_GO
+      || unload_read_fully (unload_command_fd, &length, sizeof (length)) != NO_ERROR)
+    {
+      return ER_FAILED;
+    }
+
+  if (length >= 0)
+    {
+      *password = (char *) malloc (length + 1);
+      if (*password == NULL || unload_read_fully (unload_command_fd, *password, length) != NO_ERROR)
+	{
+	  return ER_FAILED;
+	}
+      (*password)[length] = '\0';
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * unload_send_command - tell a worker what to do next
+ *    return: NO_ERROR if successful, ER_FAILED if the worker is gone
+ *    worker(in):
+ *    command(in):
+ *    task(in): the task of UNLOAD_COMMAND_TASK
+ */
+static int
+unload_send_command (UNLOAD_WORKER * worker, char command, const UNLOAD_TASK * task)
+{
+  int length;
+
+  if (unload_write_fully (worker->command_pipe[1], &command, 1) != NO_ERROR)
+    {
+      return ER_FAILED;
+    }
+
+  if (command == UNLOAD_COMMAND_GO)
+    {
+      /* the password unloaddb connected with, which may have been prompted for */
+      length = (unload_password != NULL) ? (int) strlen (unload_password) : -1;
+      if (unload_write_fully (worker->command_pipe[1], &length, sizeof (length)) != NO_ERROR
+	  || (length > 0 && unload_write_fully (worker->command_pipe[1], unload_password, length) != NO_ERROR))
+	{
+	  return ER_FAILED;
+	}
+    }
+  else if (command == UNLOAD_COMMAND_TASK)
+    {
+      if (unload_write_fully (worker->command_pipe[1], task, sizeof (*task)) != NO_ERROR)
+	{
+	  return ER_FAILED;
+	}
+    }
+
+  return NO_ERROR;
+}
+
+static int
+compare_tasks (const void *a, const void *b)
+{
+  const UNLOAD_TASK *task_a = (const UNLOAD_TASK *) a;
+  const UNLOAD_TASK *task_b = (const UNLOAD_TASK *) b;
+
+  if (task_a->est_pages != task_b->est_pages)
+    {
+      return (task_a->est_pages > task_b->est_pages) ? -1 : 1;
+    }
+  return task_a->part - task_b->part;
+}
+
+/*
+ * unload_make_tasks - split the unload in tasks for the workers
+ *    return: NO_ERROR, if successful, error number, if not successful.
+ *    tasks_out(out): the tasks, largest first; allocated with malloc
+ *    n_tasks_out(out):
+ * Note:
+ *    A class of UNLOAD_PART_MIN_PAGES heap pages or more is split in parts,
+ *    one for each worker at most, at every so many pages of its heap.
+ */
+static int
+unload_make_tasks (UNLOAD_TASK ** tasks_out, int *n_tasks_out)
+{
+  int error = NO_ERROR;
+  UNLOAD_TASK *tasks = NULL, *new_tasks, *task;
+  int n_tasks = 0;
+  SM_CLASS *class_ptr;
+  HFID *hfid;
+  VPID null_vpid;
+  VPID *bounds = NULL;
+  int n_bounds;
+  int nobjs, npages;
+  int n_parts;
+  int reference_pages = 0;
+  bool has_reference_group = false;
+  int i, k;
+
+  VPID_SET_NULL (&null_vpid);
+
+  /* one more for the classes that refer to objects or are referred to */
+  tasks = (UNLOAD_TASK *) malloc ((class_table->num + 1) * sizeof (UNLOAD_TASK));
+  if (tasks == NULL)
+    {
+      error = ER_OUT_OF_VIRTUAL_MEMORY;
+      goto exit_on_error;
+    }
+
+  for (i = 0; i < class_table->num; i++)
+    {
+      if (!IS_CLASS_REQUESTED (i) && !IS_CLASS_REFERENCED (i))
+	{
+	  continue;
+	}
+
+      ws_find (class_table->mops[i], (MOBJ *) (&class_ptr));
+      if (class_ptr == NULL)
+	{
+	  goto exit_on_error;
+	}
+
+      npages = 0;
+      hfid = sm_ch_heap ((MOBJ) class_ptr);
+      if (!HFID_IS_NULL (hfid))
+	{
+	  error = heap_get_class_num_objects_pages (hfid, 1, &nobjs, &npages);
+	  if (error != NO_ERROR)
+	    {
+	      goto exit_on_error;
+	    }
+	}
+
+      if (is_in_reference_group (i, class_ptr))
+	{
+	  has_reference_group = true;
+	  reference_pages += npages;
+	  continue;
+	}
+
+      n_parts = 1;
+      n_bounds = 0;
+      if (!HFID_IS_NULL (hfid) && npages >= 2 * UNLOAD_PART_MIN_PAGES && unload_num_workers > 1)
+	{
+	  n_parts = MIN (unload_num_workers, npages / UNLOAD_PART_MIN_PAGES);
+	  error = heap_get_pages (hfid, &null_vpid, &null_vpid, (npages + n_parts - 1) / n_parts, &bounds, &n_bounds);
+	  if (error != NO_ERROR)
+	    {
+	      goto exit_on_error;
+	    }
+	  n_parts = MAX (n_bounds, 1);
+
+	  new_tasks = (UNLOAD_TASK *) realloc (tasks, (class_table->num + n_tasks + n_parts) * sizeof (UNLOAD_TASK));
+	  if (new_tasks == NULL)
+	    {
+	      error = ER_OUT_OF_VIRTUAL_MEMORY;
+	      goto exit_on_error;
+	    }
+	  tasks = new_tasks;
+	}
+
+      for (k = 0; k < n_parts; k++)
+	{
+	  task = &tasks[n_tasks++];
+	  memset (task, 0, sizeof (*task));
+	  COPY_OID (&task->class_oid, ws_oid (class_table->mops[i]));
+	  strncpy (task->class_name, sm_ch_name ((MOBJ) class_ptr), sizeof (task->class_name) - 1);
+	  task->part = k;
+	  task->n_parts = n_parts;
+	  task->lower = (k > 0 && k < n_bounds) ? bounds[k] : null_vpid;
+	  task->upper = (k + 1 < n_bounds) ? bounds[k + 1] : null_vpid;
+	  task->est_pages = npages / n_parts;
+	}
+
+      if (bounds != NULL)
+	{
+	  free_and_init (bounds);
+	}
+    }
+
+  if (has_reference_group)
+    {
+      task = &tasks[n_tasks++];
+      memset (task, 0, sizeof (*task));
+      OID_SET_NULL (&task->class_oid);
+      task->n_parts = 1;
+      VPID_SET_NULL (&task->lower);
+      VPID_SET_NULL (&task->upper);
+      task->est_pages = reference_pages;
+    }
+
+  qsort (tasks, n_tasks, sizeof (UNLOAD_TASK), compare_tasks);
+
+  *tasks_out = tasks;
+  *n_tasks_out = n_tasks;
+
+exit_on_end:
+
+  return error;
+
+exit_on_error:
+
+  if (bounds != NULL)
+    {
+      free_and_init (bounds);
+    }
+  if (tasks != NULL)
+    {
+      free_and_init (tasks);
+    }
+  CHECK_EXIT_ERROR (error);
+  goto exit_on_end;
+}
+
+/*
+ * unload_print_progress - report a class, or a part of it, unloaded by a
+ *                         worker
+ *    return: void
+ *    report(in):
+ */
+static void
+unload_print_progress (const UNLOAD_REPORT * report)
+{
+  char name[DB_MAX_IDENTIFIER_LENGTH + 32];
+  long long rate;
+  int total;
+
+  if (report->n_parts > 1)
+    {
+      snprintf (name, sizeof (name), "%s (%d/%d)", report->class_name, report->part + 1, report->n_parts);
+    }
+  else
+    {
+      snprintf (name, sizeof (name), "%s", report->class_name);
+    }
+
+  rate = (report->elapsed_msec > 0) ? (long long) report->objects * 1000 / report->elapsed_msec : report->objects;
+  if (total_objects >= total_approximate_class_objects)
+    {
+      total = 100;
+    }
+  else
+    {
+      total = (int) (100 * ((float) total_objects / (float) total_approximate_class_objects));
+    }
+
+  if (unloadlog_file != NULL)
+    {
+      fprintf (unloadlog_file, MSG_FORMAT RATE_FORMAT "\n", name, report->objects, 100, total, rate);
+      fflush (unloadlog_file);
+    }
+  if (verbose_flag)
+    {
+      fprintf (stdout, MSG_FORMAT RATE_FORMAT "\n", name, report->objects, 100, total, rate);
+      fflush (stdout);
+    }
+}
+
+/*
+ * unload_write_manifest - write the names of the data files of the workers
+ *                         to the object file
+ *    return: NO_ERROR, if successful, error number, if not successful.
+ *    tasks(in):
+ *    n_tasks(in):
+ *    output_prefix(in): prefix of the object files
+ */
+static int
+unload_write_manifest (const UNLOAD_TASK * tasks, int n_tasks, const char *output_prefix)
+{
+  int error = NO_ERROR;
+  int i;
+
+  CHECK_PRINT_ERROR (text_print (obj_out, NULL, 0, "%s\n", LOAD_MANIFEST_HEADER));
+
+  if (!datafile_per_class)
+    {
+      for (i = 0; i < unload_num_workers; i++)
+	{
+	  CHECK_PRINT_ERROR (text_print (obj_out, NULL, 0, "%s%s_%d\n", output_prefix, OBJECT_SUFFIX, i));
+	}
+    }
+  else
+    {
+      /* see unload_task_class */
+      for (i = 0; i < n_tasks; i++)
+	{
+	  if (tasks[i].part > 0)
+	    {
+	      CHECK_PRINT_ERROR (text_print (obj_out, NULL, 0, "%s_%s%s_%d\n", output_prefix, tasks[i].class_name,
+					     OBJECT_SUFFIX, tasks[i].part));
+	    }
+	  else
+	    {
+	      CHECK_PRINT_ERROR (text_print (obj_out, NULL, 0, "%s_%s%s\n", output_prefix, tasks[i].class_name,
+					     OBJECT_SUFFIX));
+	    }
+	}
+    }
+
+exit_on_end:
+
+  return error;
+
+exit_on_error:
+
+  CHECK_EXIT_ERROR (error);
+  goto exit_on_end;
+}
+
+/*
+ * unload_in_workers - hand out the tasks of the unload to the workers and
+ *                     report their progress; called by unloaddb
+ *    return: 0 for success. 1 for error
+ *    exec_name(in): utility name
+ *    output_prefix(in): prefix of the object files
+ */
+static int
+unload_in_workers (const char *exec_name, const char *output_prefix)
+{
+  UNLOAD_TASK *tasks = NULL;
+  int n_tasks = 0;
+  UNLOAD_WORKER *worker;
+  UNLOAD_REPORT report;
+  struct pollfd *fds = NULL;
+  int *fd_workers = NULL;
+  int n_fds;
+  int next_task = 0;
+  int running = 0;
+  bool is_stopped = false;
+  int status = 0;
+  int i;
+
+  fds = (struct pollfd *) malloc (unload_num_workers * sizeof (struct pollfd));
+  fd_workers = (int *) malloc (unload_num_workers * sizeof (int));
+  if (fds == NULL || fd_workers == NULL || unload_make_tasks (&tasks, &n_tasks) != NO_ERROR)
+    {
+      status = 1;
+      goto end;
+    }
+
+  /* the workers connect to the database now that the classes are locked */
+  for (i = 0; i < unload_num_workers; i++)
+    {
+      if (unload_send_command (&unload_workers[i], UNLOAD_COMMAND_GO, NULL) != NO_ERROR)
+	{
+	  status = 1;
+	  goto end;
+	}
+    }
+
+  for (i = 0; i < unload_num_workers; i++)
+    {
+      worker = &unload_workers[i];
+      if (next_task < n_tasks && unload_send_command (worker, UNLOAD_COMMAND_TASK, &tasks[next_task]) == NO_ERROR)
+	{
+	  worker->task_no = next_task++;
+	  running++;
+	}
+      else
+	{
+	  (void) unload_send_command (worker, UNLOAD_COMMAND_QUIT, NULL);
+	}
+    }
+
+  while (running > 0)
+    {
+      n_fds = 0;
+      for (i = 0; i < unload_num_workers; i++)
+	{
+	  if (unload_workers[i].task_no >= 0)
+	    {
+	      fds[n_fds].fd = unload_workers[i].report_pipe[0];
+	      fds[n_fds].events = POLLIN;
+	      fds[n_fds].revents = 0;
+	      fd_workers[n_fds++] = i;
+	    }
+	}
+
+      if (poll (fds, n_fds, -1) < 0)
+	{
+	  if (errno == EINTR)
+	    {
+	      continue;
+	    }
+	  status = 1;
+	  break;
+	}
+
+      for (i = 0; i < n_fds; i++)
+	{
+	  if (fds[i].revents == 0)
+	    {
+	      continue;
+	    }
+
+	  worker = &unload_workers[fd_workers[i]];
+	  if (unload_read_fully (worker->report_pipe[0], &report, sizeof (report)) != NO_ERROR)
+	    {
+	      /* the worker is gone; it has printed why, if it could */
+	      fprintf (stderr, "%s: unload process %d exited before its task was done.\n", exec_name, fd_workers[i]);
+	      status = 1;
+	      is_stopped = true;
+	      unload_close_fd (&worker->report_pipe[0]);
+	      worker->task_no = -1;
+	      running--;
+	      continue;
+	    }
+
+	  total_objects += report.objects;
+	  failed_objects += report.failed_objects;
+	  if (report.class_name[0] != '\0')
+	    {
+	      unload_print_progress (&report);
+	    }
+	  if (report.status != 0)
+	    {
+	      status = 1;
+	      is_stopped = true;
+	    }
+
+	  if (report.task_done)
+	    {
+	      worker->task_no = -1;
+	      running--;
+	      if (!is_stopped && next_task < n_tasks
+		  && unload_send_command (worker, UNLOAD_COMMAND_TASK, &tasks[next_task]) == NO_ERROR)
+		{
+		  worker->task_no = next_task++;
+		  running++;
+		}
+	      else
+		{
+		  (void) unload_send_command (worker, UNLOAD_COMMAND_QUIT, NULL);
+		}
+	    }
+	}
+    }
+
+  if (unload_write_manifest (tasks, n_tasks, output_prefix) != NO_ERROR)
+    {
+      status = 1;
+    }
+
+end:
+  if (tasks != NULL)
+    {
+      free_and_init (tasks);
+    }
+  if (fds != NULL)
+    {
+      free_and_init (fds);
+    }
+  if (fd_workers != NULL)
+    {
+      free_and_init (fd_workers);
+    }
+
+  return status;
+}
+
+/*
+ * unload_task_class - unload a class, or a part of it, and report it; called
+ *                     by a worker
+ *    return: NO_ERROR, if successful, error number, if not successful.
+ *    cl_no(in): class object index for class_table
+ *    task(in): the part of the class; NULL for the whole class
+ *    output_dirname(in): directory of the object files
+ *    output_prefix(in): prefix of the object files
+ *    report(out):
+ */
+static int
+unload_task_class (int cl_no, const UNLOAD_TASK * task, const char *output_dirname, const char *output_prefix,
+		   UNLOAD_REPORT * report)
+{
+  int error = NO_ERROR;
+  SM_CLASS *class_ptr;
+  char outfile[PATH_MAX];
+  int prev_total_objects = total_objects;
+  int prev_failed_objects = failed_objects;
+  struct timeval start_time, end_time;
+
+  memset (report, 0, sizeof (*report));
+  report->n_parts = 1;
+
+  ws_find (class_table->mops[cl_no], (MOBJ *) (&class_ptr));
+  if (class_ptr == NULL)
+    {
+      report->status = 1;
+      return ER_FAILED;
+    }
+  strncpy (report->class_name, sm_ch_name ((MOBJ) class_ptr), sizeof (report->class_name) - 1);
+  if (task != NULL)
+    {
+      report->part = task->part;
+      report->n_parts = task->n_parts;
+    }
+
+  if (datafile_per_class)
+    {
+      /* see unload_write_manifest */
+      if (task != NULL && task->part > 0)
+	{
+	  snprintf (outfile, PATH_MAX - 1, "%s/%s_%s%s_%d", output_dirname, output_prefix,
+		    sm_ch_name ((MOBJ) class_ptr), OBJECT_SUFFIX, task->part);
+	}
+      else
+	{
+	  snprintf (outfile, PATH_MAX - 1, "%s/%s_%s%s", output_dirname, output_prefix,
+		    sm_ch_name ((MOBJ) class_ptr), OBJECT_SUFFIX);
+	}
+
+      obj_out->fp = fopen_ex (outfile, "wb");
+      if (obj_out->fp == NULL)
+	{
+	  report->status = 1;
+	  return ER_FAILED;
+	}
+    }
+
+  gettimeofday (&start_time, NULL);
+  error = process_class (cl_no, task);
+  gettimeofday (&end_time, NULL);
+
+  if (datafile_per_class)
+    {
+      if (text_print_flush (obj_out) != NO_ERROR && error == NO_ERROR)
+	{
+	  error = ER_FAILED;
+	}
+      fclose (obj_out->fp);
+      obj_out->fp = NULL;
+    }
+
+  report->objects = total_objects - prev_total_objects;
+  report->failed_objects = failed_objects - prev_failed_objects;
+  report->elapsed_msec = timeval_diff_in_msec (&end_time, &start_time);
+  report->status = (error != NO_ERROR && !ignore_err_flag) ? 1 : 0;
+
+  return error;
+}
+
+/*
+ * unload_run_tasks - unload the tasks unloaddb hands out; called by a worker
+ *    return: 0 for success. 1 for error
+ *    output_dirname(in): directory of the object files
+ *    output_prefix(in): prefix of the object files
+ */
+static int
+unload_run_tasks (const char *output_dirname, const char *output_prefix)
+{
+  UNLOAD_TASK task;
+  UNLOAD_REPORT report;
+  SM_CLASS *class_ptr;
+  int *cls_no_ptr;
+  char command;
+  int status = 0;
+  int i;
+
+  /* unloaddb reports the progress */
+  verbose_flag = false;
+
+  while (unload_read_fully (unload_command_fd, &command, 1) == NO_ERROR && command == UNLOAD_COMMAND_TASK)
+    {
+      if (unload_read_fully (unload_command_fd, &task, sizeof (task)) != NO_ERROR)
+	{
+	  status = 1;
+	  break;
+	}
+
+      memset (&report, 0, sizeof (report));
+      if (OID_ISNULL (&task.class_oid))
+	{
+	  /* the classes that refer to objects or are referred to, in the order of a serial unload */
+	  if (print_class_ids () != NO_ERROR)
+	    {
+	      report.status = 1;
+	    }
+	  for (i = 0; i < class_table->num && report.status == 0; i++)
+	    {
+	      if (!IS_CLASS_REQUESTED (i) && !IS_CLASS_REFERENCED (i))
+		{
+		  continue;
+		}
+	      ws_find (class_table->mops[i], (MOBJ *) (&class_ptr));
+	      if (class_ptr == NULL)
+		{
+		  report.status = 1;
+		  break;
+		}
+	      if (!is_in_reference_group (i, class_ptr))
+		{
+		  continue;
+		}
+
+	      (void) unload_task_class (i, NULL, output_dirname, output_prefix, &report);
+	      if (unload_write_fully (unload_report_fd, &report, sizeof (report)) != NO_ERROR)
+		{
+		  return 1;
+		}
+	    }
+
+	  /* only the end of the task, reported above */
+	  i = report.status;
+	  memset (&report, 0, sizeof (report));
+	  report.status = i;
+	}
+      else if (fh_get (cl_table, &task.class_oid, (FH_DATA *) (&cls_no_ptr)) != NO_ERROR || cls_no_ptr == NULL)
+	{
+	  report.status = 1;
+	}
+      else
+	{
+	  (void) unload_task_class (*cls_no_ptr, &task, output_dirname, output_prefix, &report);
+	}
+
+      report.task_done = 1;
+      if (unload_write_fully (unload_report_fd, &report, sizeof (report)) != NO_ERROR)
+	{
+	  return 1;
+	}
+      if (report.status != 0)
+	{
+	  status = 1;
+	}
+    }
+
+  return status;
+}
+#endif /* !WINDOWS && !SA_MODE */
+
+/*
+ * unload_is_worker - check if this process is a worker of a parallel unload
+ *    return: true if it is
+ */
+bool
+unload_is_worker (void)
+{
+  return unload_worker_no >= 0;
+}
+
 /*
  * ltrim - trim a given string.
  *    return: pointer to the trimed string.
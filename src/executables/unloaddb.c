@@ -47,7 +47,7 @@ char *database_name = NULL;
 const char *output_dirname = NULL;
 char *input_filename = NULL;
 FILE *output_file = NULL;
-TEXT_OUTPUT object_output = { NULL, NULL, 0, 0, NULL };
+TEXT_OUTPUT object_output = { NULL, NULL, 0, 0, NULL, NULL };
 
 TEXT_OUTPUT *obj_out = &object_output;
 int page_size = 4096;
@@ -60,6 +60,8 @@ bool include_references = false;
 
 bool required_class_only = false;
 bool datafile_per_class = false;
+int unload_threads = 1;
+const char *unload_password = NULL;
 LIST_MOPS *class_table = NULL;
 DB_OBJECT **req_class_table = NULL;
 
@@ -123,6 +125,7 @@ unloaddb (UTIL_FUNCTION_ARG * arg)
   do_objects = utility_get_option_bool_value (arg_map, UNLOAD_DATA_ONLY_S);
   output_prefix = utility_get_option_string_value (arg_map, UNLOAD_OUTPUT_PREFIX_S, 0);
   hash_filename = utility_get_option_string_value (arg_map, UNLOAD_HASH_FILE_S, 0);
+  unload_threads = utility_get_option_int_value (arg_map, UNLOAD_THREADS_S);
   verbose_flag = utility_get_option_bool_value (arg_map, UNLOAD_VERBOSE_S);
   database_name = utility_get_option_string_value (arg_map, OPTION_STRING_TABLE, 0);
   user = utility_get_option_string_value (arg_map, UNLOAD_USER_S, 0);
@@ -167,6 +170,35 @@ unloaddb (UTIL_FUNCTION_ARG * arg)
 
   sysprm_set_force (prm_get_name (PRM_ID_JAVA_STORED_PROCEDURE), "no");
 
+  if (unload_threads > 1 && (do_objects || !do_schema))
+    {
+#if defined (SA_MODE)
+      PRINT_AND_LOG_ERR_MSG (msgcat_message (MSGCAT_CATALOG_UTILS, MSGCAT_UTIL_SET_LOADDB,
+					     LOADDB_MSG_INCOMPATIBLE_ARGS), "--" UNLOAD_THREADS_L, "--" UNLOAD_SA_MODE_L);
+      status = 1;
+      goto end;
+#elif !defined (WINDOWS)
+      if (unload_threads > UNLOAD_MAX_THREADS)
+	{
+	  unload_threads = UNLOAD_MAX_THREADS;
+	}
+
+      /* the workers are forked before unloaddb connects to the database */
+      if (unload_start_workers () != NO_ERROR)
+	{
+	  PRINT_AND_LOG_ERR_MSG ("%s: Cannot start %d unload processes\n", exec_name, unload_threads);
+	  status = 1;
+	  goto end;
+	}
+
+      /* a worker connects once unloaddb has locked the classes, with the password unloaddb connected with */
+      if (unload_is_worker () && unload_wait_for_go (&password) != NO_ERROR)
+	{
+	  goto end;
+	}
+#endif /* !WINDOWS */
+    }
+
   /*
    * Open db
    */
@@ -180,7 +212,7 @@ unloaddb (UTIL_FUNCTION_ARG * arg)
     {
       /* pass */
     }
-  else if (password == NULL && db_error_code () == ER_AU_INVALID_PASSWORD)
+  else if (password == NULL && db_error_code () == ER_AU_INVALID_PASSWORD && !unload_is_worker ())
     {
       /* console input a password */
       password =
@@ -201,6 +233,7 @@ unloaddb (UTIL_FUNCTION_ARG * arg)
       goto end;
     }
 
+  unload_password = password;
   ignore_err_flag = prm_get_bool_value (PRM_ID_UNLOADDB_IGNORE_ERROR);
 
   if (!status)
@@ -215,8 +248,11 @@ unloaddb (UTIL_FUNCTION_ARG * arg)
   if (required_class_only && include_references)
     {
       include_references = false;
-      fprintf (stdout, "warning: '-ir' option is ignored.\n");
-      fflush (stdout);
+      if (!unload_is_worker ())
+	{
+	  fprintf (stdout, "warning: '-ir' option is ignored.\n");
+	  fflush (stdout);
+	}
     }
 
   class_table = locator_get_all_mops (sm_Root_class_mop, DB_FETCH_READ, NULL);
@@ -285,7 +321,7 @@ unloaddb (UTIL_FUNCTION_ARG * arg)
 	}
     }
 
-  if (!status && (do_schema || !do_objects))
+  if (!status && (do_schema || !do_objects) && !unload_is_worker ())
     {
       char indexes_output_filename[PATH_MAX * 2];
       char trigger_output_filename[PATH_MAX * 2];
@@ -374,5 +410,14 @@ end:
 
   unload_context.clear_schema_workspace ();
 
+#if !defined (WINDOWS) && !defined (SA_MODE)
+  unload_stop_workers ();
+  if (unload_is_worker () && password != NULL)
+    {
+      /* allocated by unload_wait_for_go */
+      free_and_init (password);
+    }
+#endif /* !WINDOWS && !SA_MODE */
+
   return status;
 }
@@ -49,6 +49,8 @@ extern bool do_objects;
 extern bool ignore_err_flag;
 extern bool required_class_only;
 extern bool datafile_per_class;
+extern int unload_threads;
+extern const char *unload_password;
 extern LIST_MOPS *class_table;
 extern DB_OBJECT **req_class_table;
 extern int is_req_class (DB_OBJECT * class_);
@@ -56,6 +58,9 @@ extern int get_requested_classes (const char *input_filename, DB_OBJECT * class_
 
 extern int lo_count;
 
+/* worker processes of a parallel unload (--threads) */
+#define UNLOAD_MAX_THREADS 64
+
 #define PRINT_IDENTIFIER(s) "[", (s), "]"
 #define PRINT_FUNCTION_INDEX_NAME(s) "\"", (s), "\""
 
@@ -67,6 +72,12 @@ extern int emit_indexes (print_output & output_ctx, DB_OBJLIST * classes, int ha
 extern int extract_indexes_to_file (extract_context & ctxt, const char *output_filename);
 extern int extract_classes (extract_context & ctxt, print_output & schema_output_ctx);
 extern int extractobjects (const char *exec_name, const char *output_dirname, const char *output_prefix);
+#if !defined (WINDOWS) && !defined (SA_MODE)
+extern int unload_start_workers (void);
+extern int unload_wait_for_go (char **password);
+extern void unload_stop_workers (void);
+#endif /* !WINDOWS && !SA_MODE */
+extern bool unload_is_worker (void);
 
 extern int create_filename_schema (const char *output_dirname, const char *output_prefix,
 				   char *output_filename_p, const size_t filename_size);
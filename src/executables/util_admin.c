@@ -387,12 +387,14 @@ static UTIL_ARG_MAP ua_Plandump_Option_Map[] = {
   {OPTION_STRING_TABLE, {0}, {0}},
   {PLANDUMP_DROP_S, {ARG_BOOLEAN}, {0}},
   {PLANDUMP_OUTPUT_FILE_S, {ARG_STRING}, {0}},
+  {PLANDUMP_SAVE_S, {ARG_BOOLEAN}, {0}},
   {0, {0}, {0}}
 };
 
 static GETOPT_LONG ua_Plandump_Option[] = {
   {PLANDUMP_DROP_L, 0, 0, PLANDUMP_DROP_S},
   {PLANDUMP_OUTPUT_FILE_L, 1, 0, PLANDUMP_OUTPUT_FILE_S},
+  {PLANDUMP_SAVE_L, 0, 0, PLANDUMP_SAVE_S},
   {0, 0, 0, 0}
 };
 
@@ -464,6 +466,7 @@ static UTIL_ARG_MAP ua_Load_Option_Map[] = {
   {LOAD_SA_MODE_S, {ARG_BOOLEAN}, {(void *) 1}},
   {LOAD_TABLE_NAME_S, {ARG_STRING}, {0}},
   {LOAD_COMPARE_STORAGE_ORDER_S, {ARG_BOOLEAN}, {0}},
+  {LOAD_THREADS_S, {ARG_INTEGER}, {(void *) 1}},
   {0, {0}, {0}}
 };
 
@@ -487,6 +490,7 @@ static GETOPT_LONG ua_Load_Option[] = {
   {LOAD_SA_MODE_L, 0, 0, LOAD_SA_MODE_S},
   {LOAD_TABLE_NAME_L, 1, 0, LOAD_TABLE_NAME_S},
   {LOAD_COMPARE_STORAGE_ORDER_L, 0, 0, LOAD_COMPARE_STORAGE_ORDER_S},
+  {LOAD_THREADS_L, 1, 0, LOAD_THREADS_S},
   {0, 0, 0, 0}
 };
 
@@ -511,6 +515,7 @@ static UTIL_ARG_MAP ua_Unload_Option_Map[] = {
   {UNLOAD_USER_S, {ARG_STRING}, {0}},
   {UNLOAD_PASSWORD_S, {ARG_STRING}, {0}},
   {UNLOAD_KEEP_STORAGE_ORDER_S, {ARG_BOOLEAN}, {0}},
+  {UNLOAD_THREADS_S, {ARG_INTEGER}, {(void *) 1}},
   {0, {0}, {0}}
 };
 
@@ -534,6 +539,7 @@ static GETOPT_LONG ua_Unload_Option[] = {
   {UNLOAD_USER_L, 1, 0, LOAD_USER_S},
   {UNLOAD_PASSWORD_L, 1, 0, LOAD_PASSWORD_S},
   {UNLOAD_KEEP_STORAGE_ORDER_L, 0, 0, UNLOAD_KEEP_STORAGE_ORDER_S},
+  {UNLOAD_THREADS_L, 1, 0, UNLOAD_THREADS_S},
   {0, 0, 0, 0}
 };
 
@@ -2043,6 +2043,7 @@ plandump (UTIL_FUNCTION_ARG * arg)
   const char *database_name;
   const char *output_file = NULL;
   bool drop_flag = false;
+  bool save_flag = false;
   FILE *outfp = NULL;
 
   database_name = utility_get_option_string_value (arg_map, OPTION_STRING_TABLE, 0);
@@ -2052,6 +2053,7 @@ plandump (UTIL_FUNCTION_ARG * arg)
     }
 
   drop_flag = utility_get_option_bool_value (arg_map, PLANDUMP_DROP_S);
+  save_flag = utility_get_option_bool_value (arg_map, PLANDUMP_SAVE_S);
   output_file = utility_get_option_string_value (arg_map, PLANDUMP_OUTPUT_FILE_S, 0);
 
   if (utility_get_option_string_table_size (arg_map) != 1)
@@ -2095,6 +2097,15 @@ plandump (UTIL_FUNCTION_ARG * arg)
     }
 
   qmgr_dump_query_plans (outfp);
+  if (save_flag)
+    {
+      if (qmgr_save_all_query_plans () != NO_ERROR)
+	{
+	  PRINT_AND_LOG_ERR_MSG ("%s\n", db_error_string (3));
+	  db_shutdown ();
+	  goto error_exit;
+	}
+    }
   if (drop_flag)
     {
       if (qmgr_drop_all_query_plans () != NO_ERROR)
@@ -483,6 +483,7 @@ typedef enum
   LOADDB_MSG_INSERT_AND_FAIL_COUNT = 116,
   LOADDB_MSG_LOAD_FAIL = 117,
   LOADDB_MSG_EXCEED_MAX_LEN = 118,
+  LOADDB_MSG_INSTANCE_RATE = 119,
   LOADDB_MSG_USAGE = 120
 } MSGCAT_LOADDB_MSG;
 
@@ -1160,6 +1161,8 @@ typedef struct _ha_config
 #define PLANDUMP_DROP_L                         "drop"
 #define PLANDUMP_OUTPUT_FILE_S		        'o'
 #define PLANDUMP_OUTPUT_FILE_L                  "output-file"
+#define PLANDUMP_SAVE_S			        's'
+#define PLANDUMP_SAVE_L                         "save"
 
 /* tranlist option list */
 #define TRANLIST_USER_S                         'u'
@@ -1233,6 +1236,8 @@ typedef struct _ha_config
 #define LOAD_TABLE_NAME_L                       "table"
 #define LOAD_COMPARE_STORAGE_ORDER_S		11817
 #define LOAD_COMPARE_STORAGE_ORDER_L		"compare-storage-order"
+#define LOAD_THREADS_S				11818
+#define LOAD_THREADS_L				"threads"
 
 /* unloaddb option list */
 #define UNLOAD_INPUT_CLASS_FILE_S               'i'
@@ -1273,6 +1278,8 @@ typedef struct _ha_config
 #define UNLOAD_PASSWORD_L                       "password"
 #define UNLOAD_KEEP_STORAGE_ORDER_S		11918
 #define UNLOAD_KEEP_STORAGE_ORDER_L		"keep-storage-order"
+#define UNLOAD_THREADS_S			11919
+#define UNLOAD_THREADS_L			"threads"
 
 /* compactdb option list */
 #define COMPACT_VERBOSE_S                       'v'
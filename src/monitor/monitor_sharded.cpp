@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// monitor_sharded.cpp - implementation of statistics collected in per-thread shards
+//
+
+#include "monitor_sharded.hpp"
+
+#include "monitor_collect.hpp"
+
+#include <cassert>
+#include <cmath>
+
+namespace cubmonitor
+{
+  //////////////////////////////////////////////////////////////////////////
+  // shard of thread
+  //////////////////////////////////////////////////////////////////////////
+
+  static std::atomic<std::size_t> Shard_next_index (0);
+  // shard index + 1; zero until first call of thread
+  static thread_local std::size_t tl_Shard_index = 0;
+
+  std::size_t
+  get_shard_index (void)
+  {
+    if (tl_Shard_index == 0)
+      {
+	tl_Shard_index = (Shard_next_index++ % SHARD_COUNT) + 1;
+      }
+    return tl_Shard_index - 1;
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // latency_histogram_statistic
+  //////////////////////////////////////////////////////////////////////////
+
+  const std::size_t latency_histogram_statistic::SUB_BUCKET_BITS;
+  const std::size_t latency_histogram_statistic::SUB_BUCKET_COUNT;
+  const std::size_t latency_histogram_statistic::MAX_VALUE_BITS;
+  const std::size_t latency_histogram_statistic::BUCKET_COUNT;
+
+  static std::size_t
+  highest_bit (std::uint64_t value)
+  {
+    std::size_t bit = 0;
+
+    assert (value != 0);
+#if defined (__GNUC__)
+    bit = 63 - __builtin_clzll (value);
+#else
+    while (value >>= 1)
+      {
+	bit++;
+      }
+#endif
+    return bit;
+  }
+
+  latency_histogram_statistic::latency_histogram_statistic (void)
+  {
+    for (shard &s : m_shards)
+      {
+	s.m_count.store (0, std::memory_order_relaxed);
+	s.m_total.store (0, std::memory_order_relaxed);
+	s.m_max.store (0, std::memory_order_relaxed);
+	for (std::atomic<std::uint64_t> &bucket : s.m_buckets)
+	  {
+	    bucket.store (0, std::memory_order_relaxed);
+	  }
+      }
+  }
+
+  std::size_t
+  latency_histogram_statistic::get_bucket_index (std::uint64_t nanosecs)
+  {
+    std::size_t bit;
+
+    if (nanosecs < SUB_BUCKET_COUNT)
+      {
+	return (std::size_t) nanosecs;
+      }
+    if (nanosecs >> MAX_VALUE_BITS != 0)
+      {
+	return BUCKET_COUNT - 1;
+      }
+
+    // power of two gives the group of buckets, next SUB_BUCKET_BITS bits give the bucket in group
+    bit = highest_bit (nanosecs);
+    return (bit - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT
+	   + (std::size_t) ((nanosecs >> (bit - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1));
+  }
+
+  std::uint64_t
+  latency_histogram_statistic::get_bucket_highest (std::size_t bucket_index)
+  {
+    std::size_t bit;
+    std::uint64_t lowest;
+
+    assert (bucket_index < BUCKET_COUNT);
+
+    if (bucket_index < SUB_BUCKET_COUNT)
+      {
+	return bucket_index;
+      }
+
+    bit = bucket_index / SUB_BUCKET_COUNT + SUB_BUCKET_BITS - 1;
+    lowest = (SUB_BUCKET_COUNT + bucket_index % SUB_BUCKET_COUNT) << (bit - SUB_BUCKET_BITS);
+    return lowest + (1ULL << (bit - SUB_BUCKET_BITS)) - 1;
+  }
+
+  void
+  latency_histogram_statistic::collect (const time_rep &value)
+  {
+    shard &s = m_shards[get_shard_index ()];
+    std::uint64_t nanosecs = value.count () > 0 ? (std::uint64_t) value.count () : 0;
+    std::uint64_t max;
+
+    s.m_buckets[get_bucket_index (nanosecs)].fetch_add (1, std::memory_order_relaxed);
+    s.m_count.fetch_add (1, std::memory_order_relaxed);
+    s.m_total.fetch_add (nanosecs, std::memory_order_relaxed);
+
+    max = s.m_max.load (std::memory_order_relaxed);
+    while (nanosecs > max && !s.m_max.compare_exchange_weak (max, nanosecs, std::memory_order_relaxed))
+      {
+	// max was reloaded
+      }
+  }
+
+  std::size_t
+  latency_histogram_statistic::get_statistics_count (void) const
+  {
+    return 6;
+  }
+
+  void
+  latency_histogram_statistic::fetch (statistic_value *destination, fetch_mode mode /* = FETCH_GLOBAL */) const
+  {
+    std::uint64_t buckets[BUCKET_COUNT];
+    std::uint64_t count;
+
+    if (mode != FETCH_GLOBAL)
+      {
+	// no transaction sheets
+	for (std::size_t i = 0; i < get_statistics_count (); i++)
+	  {
+	    destination[i] = 0;
+	  }
+	return;
+      }
+
+    // merge shards once for all percentiles
+    count = merge_buckets (buckets);
+
+    destination[0] = statistic_value_cast (get_count (mode));
+    destination[1] = statistic_value_cast (get_time (mode));
+    destination[2] = statistic_value_cast (find_percentile (buckets, count, 50));
+    destination[3] = statistic_value_cast (find_percentile (buckets, count, 99));
+    destination[4] = statistic_value_cast (find_percentile (buckets, count, 99.9));
+    destination[5] = statistic_value_cast (get_max_time (mode));
+  }
+
+  amount_rep
+  latency_histogram_statistic::get_count (fetch_mode mode /* = FETCH_GLOBAL */) const
+  {
+    amount_rep count = 0;
+
+    if (mode != FETCH_GLOBAL)
+      {
+	return 0;
+      }
+    for (const shard &s : m_shards)
+      {
+	count += s.m_count.load (std::memory_order_relaxed);
+      }
+    return count;
+  }
+
+  time_rep
+  latency_histogram_statistic::get_time (fetch_mode mode /* = FETCH_GLOBAL */) const
+  {
+    std::uint64_t total = 0;
+
+    if (mode != FETCH_GLOBAL)
+      {
+	return time_rep ();
+      }
+    for (const shard &s : m_shards)
+      {
+	total += s.m_total.load (std::memory_order_relaxed);
+      }
+    return sharded_rep_cast<time_rep> (total);
+  }
+
+  time_rep
+  latency_histogram_statistic::get_max_time (fetch_mode mode /* = FETCH_GLOBAL */) const
+  {
+    std::uint64_t max = 0;
+    std::uint64_t shard_max;
+
+    if (mode != FETCH_GLOBAL)
+      {
+	return time_rep ();
+      }
+    for (const shard &s : m_shards)
+      {
+	shard_max = s.m_max.load (std::memory_order_relaxed);
+	if (shard_max > max)
+	  {
+	    max = shard_max;
+	  }
+      }
+    return sharded_rep_cast<time_rep> (max);
+  }
+
+  time_rep
+  latency_histogram_statistic::get_percentile_time (double percent, fetch_mode mode /* = FETCH_GLOBAL */) const
+  {
+    std::uint64_t buckets[BUCKET_COUNT];
+    std::uint64_t count;
+
+    if (mode != FETCH_GLOBAL)
+      {
+	return time_rep ();
+      }
+
+    count = merge_buckets (buckets);
+    return find_percentile (buckets, count, percent);
+  }
+
+  std::uint64_t
+  latency_histogram_statistic::merge_buckets (std::uint64_t *buckets) const
+  {
+    std::uint64_t count = 0;
+
+    for (std::size_t i = 0; i < BUCKET_COUNT; i++)
+      {
+	buckets[i] = 0;
+	for (const shard &s : m_shards)
+	  {
+	    buckets[i] += s.m_buckets[i].load (std::memory_order_relaxed);
+	  }
+	count += buckets[i];
+      }
+    return count;
+  }
+
+  time_rep
+  latency_histogram_statistic::find_percentile (const std::uint64_t *buckets, std::uint64_t count,
+      double percent) const
+  {
+    std::uint64_t rank;
+    std::uint64_t seen = 0;
+    std::uint64_t highest;
+    std::uint64_t max;
+
+    if (count == 0)
+      {
+	return time_rep ();
+      }
+
+    // rank of the value, 1 to count
+    rank = (std::uint64_t) std::ceil (percent / 100 * (double) count);
+    if (rank < 1)
+      {
+	rank = 1;
+      }
+    else if (rank > count)
+      {
+	rank = count;
+      }
+
+    for (std::size_t i = 0; i < BUCKET_COUNT; i++)
+      {
+	seen += buckets[i];
+	if (seen >= rank)
+	  {
+	    // no value exceeds max; it is a closer bound for the last bucket
+	    highest = get_bucket_highest (i);
+	    max = (std::uint64_t) get_max_time ().count ();
+	    return sharded_rep_cast<time_rep> (highest < max ? highest : max);
+	  }
+      }
+
+    // buckets changed while they were merged
+    return get_max_time ();
+  }
+
+  void
+  latency_histogram_statistic::register_to_monitor (monitor &mon, const char *basename) const
+  {
+    const char *count_prefix = "Num_";
+    const char *total_time_prefix = "Total_time_";
+    const char *p50_time_prefix = "P50_time_";
+    const char *p99_time_prefix = "P99_time_";
+    const char *p999_time_prefix = "P999_time_";
+    const char *max_time_prefix = "Max_time_";
+    std::vector<std::string> names;
+
+    build_name_vector (names, basename, count_prefix, total_time_prefix, p50_time_prefix, p99_time_prefix,
+		       p999_time_prefix, max_time_prefix);
+    assert (names.size () == get_statistics_count ());
+
+    mon.register_statistics (*this, names);
+  }
+
+} // namespace cubmonitor
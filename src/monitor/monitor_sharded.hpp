@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// monitor_sharded.hpp - statistics collected in per-thread shards
+//
+//  atomic statistics are shared by all threads that collect them; under load, the cache line of the value goes from
+//  core to core on every collect. sharded statistics keep one value per shard, each in its own cache line. a thread
+//  always collects to the same shard and fetch adds up all shards, so collect is cheap and fetch is the one that pays.
+//
+//  threads take shards round robin, on their first collect. there are more shards than usual core counts, but
+//  threads may still share a shard; values of a shard are atomic, so this only costs some cache line traffic.
+//
+//  Based on type of collections, there are two types of sharded statistics:
+//
+//      1. accumulator - values are added up in shard of thread; named valuetype_accumulator_sharded_statistic.
+//      2. latency histogram - durations are counted in log-linear buckets; percentiles can be fetched. values up to
+//         2 * SUB_BUCKET_COUNT nanoseconds are exact; above that, a bucket is 1 / SUB_BUCKET_COUNT of its power of
+//         two wide, so a percentile is at most ~6% above the actual value.
+//
+//  Sharded statistics are meant to be global objects; a latency histogram takes ~84KB.
+//
+//  How to use:
+//
+//          cubmonitor::latency_histogram_statistic my_histogram;
+//
+//          cubmonitor::time_point start_pt = cubmonitor::clock_type::now ();
+//          // do some operations
+//          my_histogram.collect (cubmonitor::clock_type::now () - start_pt);
+//
+//          std::cout << "p99 is " << cubmonitor::statistic_value_cast (my_histogram.get_percentile_time (99))
+//                    << " microseconds." << std::endl;
+//
+
+#if !defined _MONITOR_SHARDED_HPP_
+#define _MONITOR_SHARDED_HPP_
+
+#include "monitor_registration.hpp"
+#include "monitor_statistic.hpp"
+
+#include <atomic>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cubmonitor
+{
+  // shards of each statistic; power of two
+  const std::size_t SHARD_COUNT = 16;
+  // cache line size; shards are aligned to it
+  const std::size_t SHARD_ALIGNMENT = 64;
+
+  // shard of calling thread
+  std::size_t get_shard_index (void);
+
+  //////////////////////////////////////////////////////////////////////////
+  // Sharded accumulator statistic
+  //
+  // Rep may be amount_rep or time_rep.
+  //////////////////////////////////////////////////////////////////////////
+  template <typename Rep>
+  class accumulator_sharded_statistic
+  {
+    public:
+      using rep = Rep;                            // collected data representation
+
+      accumulator_sharded_statistic (void);
+
+      void collect (const Rep &value);            // collect value
+
+      // fetch interface for monitor registration
+      inline void fetch (statistic_value *destination, fetch_mode mode = FETCH_GLOBAL) const;
+      std::size_t get_statistics_count (void) const
+      {
+	return 1;
+      }
+
+      // get current value; sum of all shards
+      Rep get_value (fetch_mode mode = FETCH_GLOBAL) const;
+
+    private:
+      struct alignas (SHARD_ALIGNMENT) shard
+      {
+	std::atomic<std::uint64_t> m_value;
+      };
+
+      shard m_shards[SHARD_COUNT];
+  };
+
+  using amount_accumulator_sharded_statistic = accumulator_sharded_statistic<amount_rep>;
+  using time_accumulator_sharded_statistic = accumulator_sharded_statistic<time_rep>;
+
+  //////////////////////////////////////////////////////////////////////////
+  // Latency histogram statistic
+  //
+  // Fetches six values: count, total time, p50, p99 and p999 times and max time.
+  //////////////////////////////////////////////////////////////////////////
+  class latency_histogram_statistic
+  {
+    public:
+      // each power of two is split in 2^SUB_BUCKET_BITS buckets
+      static const std::size_t SUB_BUCKET_BITS = 4;
+      static const std::size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+      // durations are counted up to 2^MAX_VALUE_BITS - 1 nanoseconds (~4.9 hours); longer ones in last bucket
+      static const std::size_t MAX_VALUE_BITS = 44;
+      static const std::size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+      latency_histogram_statistic (void);
+
+      void collect (const time_rep &value);       // collect duration
+
+      // fetch interface for monitor registration
+      void fetch (statistic_value *destination, fetch_mode mode = FETCH_GLOBAL) const;
+      std::size_t get_statistics_count (void) const;
+
+      // getters
+      amount_rep get_count (fetch_mode mode = FETCH_GLOBAL) const;
+      time_rep get_time (fetch_mode mode = FETCH_GLOBAL) const;
+      time_rep get_max_time (fetch_mode mode = FETCH_GLOBAL) const;
+      // duration that percent (0 to 100) of collected durations do not exceed; zero if nothing was collected
+      time_rep get_percentile_time (double percent, fetch_mode mode = FETCH_GLOBAL) const;
+
+      // register statistic to monitor
+      // six statistics are registered: counter, total time, p50, p99, p999 and max time
+      void register_to_monitor (monitor &mon, const char *basename) const;
+
+      // bucket of a duration in nanoseconds and the highest duration counted in a bucket
+      static std::size_t get_bucket_index (std::uint64_t nanosecs);
+      static std::uint64_t get_bucket_highest (std::size_t bucket_index);
+
+    private:
+      struct alignas (SHARD_ALIGNMENT) shard
+      {
+	std::atomic<std::uint64_t> m_count;
+	std::atomic<std::uint64_t> m_total;
+	std::atomic<std::uint64_t> m_max;
+	std::atomic<std::uint64_t> m_buckets[BUCKET_COUNT];
+      };
+
+      // add up buckets of all shards; returns total count
+      std::uint64_t merge_buckets (std::uint64_t *buckets) const;
+      time_rep find_percentile (const std::uint64_t *buckets, std::uint64_t count, double percent) const;
+
+      shard m_shards[SHARD_COUNT];
+  };
+
+  //////////////////////////////////////////////////////////////////////////
+  // template and inline implementation
+  //////////////////////////////////////////////////////////////////////////
+
+  // representations are stored as std::uint64_t in shards
+  inline std::uint64_t
+  sharded_value_cast (const amount_rep &value)
+  {
+    return value;
+  }
+
+  inline std::uint64_t
+  sharded_value_cast (const time_rep &value)
+  {
+    return static_cast<std::uint64_t> (value.count ());
+  }
+
+  template <typename Rep>
+  Rep sharded_rep_cast (std::uint64_t value);
+
+  template <>
+  inline amount_rep
+  sharded_rep_cast<amount_rep> (std::uint64_t value)
+  {
+    return value;
+  }
+
+  template <>
+  inline time_rep
+  sharded_rep_cast<time_rep> (std::uint64_t value)
+  {
+    return time_rep (static_cast<time_rep::rep> (value));
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // accumulator_sharded_statistic
+  //////////////////////////////////////////////////////////////////////////
+
+  template <typename Rep>
+  accumulator_sharded_statistic<Rep>::accumulator_sharded_statistic (void)
+  {
+    for (shard &s : m_shards)
+      {
+	s.m_value.store (0, std::memory_order_relaxed);
+      }
+  }
+
+  template <typename Rep>
+  void
+  accumulator_sharded_statistic<Rep>::collect (const Rep &value)
+  {
+    m_shards[get_shard_index ()].m_value.fetch_add (sharded_value_cast (value), std::memory_order_relaxed);
+  }
+
+  template <typename Rep>
+  void
+  accumulator_sharded_statistic<Rep>::fetch (statistic_value *destination, fetch_mode mode /* = FETCH_GLOBAL */) const
+  {
+    *destination = statistic_value_cast (get_value (mode));
+  }
+
+  template <typename Rep>
+  Rep
+  accumulator_sharded_statistic<Rep>::get_value (fetch_mode mode /* = FETCH_GLOBAL */) const
+  {
+    std::uint64_t sum = 0;
+
+    if (mode != FETCH_GLOBAL)
+      {
+	// no transaction sheets
+	return Rep ();
+      }
+
+    for (const shard &s : m_shards)
+      {
+	sum += s.m_value.load (std::memory_order_relaxed);
+      }
+    return sharded_rep_cast<Rep> (sum);
+  }
+
+} // namespace cubmonitor
+
+#endif // _MONITOR_SHARDED_HPP_
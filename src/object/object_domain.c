@@ -5718,6 +5718,77 @@ tp_value_string_to_double (const DB_VALUE * value, DB_VALUE * result)
   return ret;
 }
 
+/*
+ * tp_value_to_histogram_key - Map an ordered scalar value onto the real line.
+ *    return: true if the value has a histogram key, false otherwise
+ *    value(in): value to map
+ *    key(out): order preserving key of the value
+ * Note:
+ *    Used to build and probe the equi-depth column histograms of the optimizer statistics. Only numeric and
+ *    date/time types (without time zone) have a key; other types return false.
+ */
+bool
+tp_value_to_histogram_key (const DB_VALUE * value, double *key)
+{
+  DB_DATETIME *datetime;
+
+  if (value == NULL || DB_IS_NULL (value))
+    {
+      return false;
+    }
+
+  switch (DB_VALUE_TYPE (value))
+    {
+    case DB_TYPE_SHORT:
+      *key = (double) db_get_short (value);
+      return true;
+
+    case DB_TYPE_INTEGER:
+      *key = (double) db_get_int (value);
+      return true;
+
+    case DB_TYPE_BIGINT:
+      *key = (double) db_get_bigint (value);
+      return true;
+
+    case DB_TYPE_FLOAT:
+      *key = (double) db_get_float (value);
+      return true;
+
+    case DB_TYPE_DOUBLE:
+      *key = db_get_double (value);
+      return true;
+
+    case DB_TYPE_MONETARY:
+      *key = db_get_monetary (value)->amount;
+      return true;
+
+    case DB_TYPE_NUMERIC:
+      numeric_coerce_num_to_double (db_locate_numeric (value), DB_VALUE_SCALE (value), key);
+      return true;
+
+    case DB_TYPE_DATE:
+      *key = (double) *db_get_date (value);
+      return true;
+
+    case DB_TYPE_TIME:
+      *key = (double) *db_get_time (value);
+      return true;
+
+    case DB_TYPE_TIMESTAMP:
+      *key = (double) *db_get_timestamp (value);
+      return true;
+
+    case DB_TYPE_DATETIME:
+      datetime = db_get_datetime (value);
+      *key = (double) datetime->date * MILLISECONDS_OF_ONE_DAY + (double) datetime->time;
+      return true;
+
+    default:
+      return false;
+    }
+}
+
 static void
 make_desired_string_db_value (DB_TYPE desired_type, const TP_DOMAIN * desired_domain, const char *new_string,
 			      DB_VALUE * target, TP_DOMAIN_STATUS * status, DB_DATA_STATUS * data_stat)
@@ -500,6 +500,7 @@ extern "C"
   extern int tp_value_str_auto_cast_to_number (DB_VALUE * src, DB_VALUE * dest, DB_TYPE * val_type);
   extern TP_DOMAIN *tp_infer_common_domain (TP_DOMAIN * arg1, TP_DOMAIN * arg2);
   extern int tp_value_string_to_double (const DB_VALUE * value, DB_VALUE * result);
+  extern bool tp_value_to_histogram_key (const DB_VALUE * value, double *key);
   extern void tp_domain_clear_enumeration (DB_ENUMERATION * enumeration);
   extern int tp_enumeration_to_varchar (const DB_VALUE * src, DB_VALUE * result);
   extern int tp_domain_status_er_set (TP_DOMAIN_STATUS status, const char *file_name, const int line_no,
@@ -128,6 +128,10 @@ typedef struct
 				 * # of {a, b} ... pkeys[key_size-1] -> # of {a, b, ..., x} */
   bool valid_limits;
   bool is_indexed;
+  int ndv;			/* estimated number of distinct values; 0 if unknown */
+  int null_count;		/* estimated number of null values */
+  int n_bounds;			/* number of equi-depth histogram bounds; 0 if no histogram */
+  double *bounds;		/* histogram bounds */
 } QO_ATTR_CUM_STATS;
 
 typedef struct qo_plan QO_PLAN;
@@ -373,6 +373,15 @@ make_mergelist_proc (QO_ENV * env, QO_PLAN * plan, XASL_NODE * left, PT_NODE * l
     }				/* for (i = ... ) */
   assert (cnt == ncols);
 
+  if (plan->plan_un.join.join_method == QO_JOINMETHOD_HASH_JOIN)
+    {
+      /* the join columns are hashed, not merged; build the operands without sorting them */
+      assert (ls_merge->join_type == JOIN_INNER);
+      ls_merge->join_method = QFILE_HASH_JOIN;
+      left->orderby_list = NULL;
+      rght->orderby_list = NULL;
+    }
+
   left_elen = bitset_cardinality (left_exprs);
   left_nlen = pt_length_of_list (left_list) - left_elen;
   rght_elen = bitset_cardinality (rght_exprs);
@@ -921,7 +930,8 @@ add_sort_spec (QO_ENV * env, XASL_NODE * xasl, QO_PLAN * plan, DB_VALUE * ordby_
   if (instnum_flag)
     {
       if (xasl && subplan->plan_type == QO_PLANTYPE_JOIN
-	  && subplan->plan_un.join.join_method == QO_JOINMETHOD_MERGE_JOIN)
+	  && (subplan->plan_un.join.join_method == QO_JOINMETHOD_MERGE_JOIN
+	      || subplan->plan_un.join.join_method == QO_JOINMETHOD_HASH_JOIN))
 	{
 	  PT_NODE *instnum_pred;
 
@@ -1807,6 +1817,7 @@ gen_outer (QO_ENV * env, QO_PLAN * plan, BITSET * subqueries, XASL_NODE * inner_
 	  break;
 
 	case QO_JOINMETHOD_MERGE_JOIN:
+	case QO_JOINMETHOD_HASH_JOIN:
 	  /*
 	   * The optimizer isn't supposed to produce plans in which a
 	   * merge join isn't "shielded" by a sort (temp file) plan,
@@ -4118,7 +4129,8 @@ qo_check_join_for_multi_range_opt (QO_PLAN * plan)
 
   /* verify that this is a valid join for multi range optimization */
   if (plan == NULL || plan->plan_type != QO_PLANTYPE_JOIN || plan->plan_un.join.join_type != JOIN_INNER
-      || plan->plan_un.join.join_method == QO_JOINMETHOD_MERGE_JOIN)
+      || plan->plan_un.join.join_method == QO_JOINMETHOD_MERGE_JOIN
+      || plan->plan_un.join.join_method == QO_JOINMETHOD_HASH_JOIN)
     {
       return false;
     }
@@ -4846,6 +4846,9 @@ qo_get_attr_info_func_index (QO_ENV * env, QO_SEGMENT * seg, const char *expr_st
   cum_statsp->key_type = NULL;
   cum_statsp->pkeys_size = 0;
   cum_statsp->pkeys = NULL;
+  cum_statsp->ndv = cum_statsp->null_count = 0;
+  cum_statsp->n_bounds = 0;
+  cum_statsp->bounds = NULL;
 
   /* set the statistics from the class information(QO_CLASS_INFO_ENTRY) */
   for (i = 0; i < n; class_info_entryp++, i++)
@@ -5018,6 +5021,9 @@ qo_get_attr_info (QO_ENV * env, QO_SEGMENT * seg)
       cum_statsp->key_type = NULL;
       cum_statsp->pkeys_size = 0;
       cum_statsp->pkeys = NULL;
+      cum_statsp->ndv = cum_statsp->null_count = 0;
+      cum_statsp->n_bounds = 0;
+      cum_statsp->bounds = NULL;
 
       return attr_infop;
     }
@@ -5031,6 +5037,9 @@ qo_get_attr_info (QO_ENV * env, QO_SEGMENT * seg)
   cum_statsp->key_type = NULL;
   cum_statsp->pkeys_size = 0;
   cum_statsp->pkeys = NULL;
+  cum_statsp->ndv = cum_statsp->null_count = 0;
+  cum_statsp->n_bounds = 0;
+  cum_statsp->bounds = NULL;
 
   /* set the statistics from the class information(QO_CLASS_INFO_ENTRY) */
   for (i = 0; i < n; class_info_entryp++, i++)
@@ -5082,6 +5091,24 @@ qo_get_attr_info (QO_ENV * env, QO_SEGMENT * seg)
 	  cum_statsp->valid_limits = true;
 	}
 
+      /* column statistics; as for keys, assume the value distributions of the classes overlap. the histogram is used
+       * only when the segment represents a single class */
+      cum_statsp->ndv = MAX (cum_statsp->ndv, attr_statsp->ndv);
+      cum_statsp->null_count += attr_statsp->null_count;
+      if (n == 1 && attr_statsp->n_bounds > 0)
+	{
+	  cum_statsp->bounds = (double *) malloc (attr_statsp->n_bounds * sizeof (double));
+	  if (cum_statsp->bounds == NULL)
+	    {
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+		      attr_statsp->n_bounds * sizeof (double));
+	      qo_free_attr_info (env, attr_infop);
+	      return NULL;
+	    }
+	  memcpy (cum_statsp->bounds, attr_statsp->bounds, attr_statsp->n_bounds * sizeof (double));
+	  cum_statsp->n_bounds = attr_statsp->n_bounds;
+	}
+
       n_func_indexes = 0;
       n_unavail_indexes = 0;
       for (j = 0; j < attr_statsp->n_btstats; j++)
@@ -5227,6 +5254,10 @@ qo_free_attr_info (QO_ENV * env, QO_ATTR_INFO * info)
 	{
 	  free_and_init (cum_statsp->pkeys);
 	}
+      if (cum_statsp->bounds)
+	{
+	  free_and_init (cum_statsp->bounds);
+	}
       free_and_init (info);
     }
 }
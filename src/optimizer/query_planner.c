@@ -142,6 +142,7 @@ static void qo_sscan_cost (QO_PLAN *);
 static void qo_iscan_cost (QO_PLAN *);
 static void qo_sort_cost (QO_PLAN *);
 static void qo_mjoin_cost (QO_PLAN *);
+static void qo_hjoin_cost (QO_PLAN *);
 static void qo_follow_cost (QO_PLAN *);
 static void qo_worst_cost (QO_PLAN *);
 static void qo_zero_cost (QO_PLAN *);
@@ -179,6 +180,9 @@ static int qo_examine_nl_join (QO_INFO *, JOIN_TYPE, QO_INFO *, QO_INFO *, BITSE
 			       BITSET *, int);
 static int qo_examine_merge_join (QO_INFO *, JOIN_TYPE, QO_INFO *, QO_INFO *, BITSET *, BITSET *, BITSET *, BITSET *,
 				  BITSET *);
+static bool qo_is_hash_join_term (QO_TERM * term);
+static int qo_examine_hash_join (QO_INFO *, JOIN_TYPE, QO_INFO *, QO_INFO *, BITSET *, BITSET *, BITSET *, BITSET *,
+				 BITSET *);
 static int qo_examine_correlated_index (QO_INFO *, JOIN_TYPE, QO_INFO *, QO_INFO *, BITSET *, BITSET *, BITSET *);
 static int qo_examine_follow (QO_INFO *, QO_TERM *, QO_INFO *, BITSET *, BITSET *);
 static void qo_compute_projected_segs (QO_PLANNER *, BITSET *, BITSET *, BITSET *);
@@ -323,6 +327,17 @@ static QO_PLAN_VTBL qo_merge_join_plan_vtbl = {
   "Merge join"
 };
 
+static QO_PLAN_VTBL qo_hash_join_plan_vtbl = {
+  "h-join",
+  qo_join_fprint,
+  qo_join_walk,
+  qo_join_free,
+  qo_hjoin_cost,
+  qo_hjoin_cost,
+  qo_join_info,
+  "Hash join"
+};
+
 static QO_PLAN_VTBL qo_follow_plan_vtbl = {
   "follow",
   qo_follow_fprint,
@@ -363,6 +378,7 @@ QO_PLAN_VTBL *all_vtbls[] = {
   &qo_nl_join_plan_vtbl,
   &qo_idx_join_plan_vtbl,
   &qo_merge_join_plan_vtbl,
+  &qo_hash_join_plan_vtbl,
   &qo_follow_plan_vtbl,
   &qo_set_follow_plan_vtbl,
   &qo_worst_plan_vtbl
@@ -410,6 +426,14 @@ static PRED_CLASS qo_classify (PT_NODE * attr);
 
 static int qo_index_cardinality (QO_ENV * env, PT_NODE * attr);
 
+static QO_ATTR_INFO *qo_get_attr_stats_info (QO_ENV * env, PT_NODE * attr, QO_NODE ** nodepp);
+
+static int qo_distinct_values (QO_ENV * env, PT_NODE * attr);
+
+static double qo_null_selectivity (QO_ENV * env, PT_NODE * attr);
+
+static double qo_histogram_selectivity (QO_ENV * env, PT_NODE * attr, PT_NODE * lower, PT_NODE * upper);
+
 /*
  * log3 () -
  *   return:
@@ -2719,6 +2743,25 @@ qo_join_new (QO_INFO * info, JOIN_TYPE join_type, QO_JOINMETHOD join_method, QO_
 	}
 
       break;
+
+    case QO_JOINMETHOD_HASH_JOIN:
+
+      plan->vtbl = &qo_hash_join_plan_vtbl;
+
+      /* The operands are read from list files in whatever order they were built, so the result has no order. */
+      plan->order = QO_UNORDERED;
+
+      /* Like merge joins, hash joins read both operands from list files; unlike them, the lists need not be sorted. */
+      if (outer->plan_type != QO_PLANTYPE_SORT)
+	{
+	  outer = qo_sort_new (outer, QO_UNORDERED, SORT_TEMP);
+	}
+      if (inner->plan_type != QO_PLANTYPE_SORT)
+	{
+	  inner = qo_sort_new (inner, QO_UNORDERED, SORT_TEMP);
+	}
+
+      break;
     }
 
   assert (inner != NULL && outer != NULL);
@@ -2817,7 +2860,7 @@ qo_join_new (QO_INFO * info, JOIN_TYPE join_type, QO_JOINMETHOD join_method, QO_
    * not storing them into a listfile. We could push the cost into the merge plan itself, I suppose, but a rational
    * implementation wouldn't impose this cost, and so I have hope that one day we'll be able to eliminate it.
    */
-  if (join_method == QO_JOINMETHOD_MERGE_JOIN)
+  if (join_method == QO_JOINMETHOD_MERGE_JOIN || join_method == QO_JOINMETHOD_HASH_JOIN)
     {
       plan = qo_sort_new (plan, plan->order, SORT_TEMP);
     }
@@ -3214,6 +3257,73 @@ qo_mjoin_cost (QO_PLAN * planp)
   planp->variable_io_cost = outer->variable_io_cost + inner->variable_io_cost;
 }
 
+/*
+ * qo_hjoin_cost () -
+ *   return:
+ *   planp(in):
+ *
+ * Note: The inner list is read once to build the hash table and the outer
+ *	 list once to probe it. If the inner list does not fit in
+ *	 max_hash_join_size, both lists are written to partition files and
+ *	 read back once more.
+ */
+static void
+qo_hjoin_cost (QO_PLAN * planp)
+{
+  QO_PLAN *inner;
+  QO_PLAN *outer;
+  QO_ENV *env;
+  double outer_cardinality = 0.0, inner_cardinality = 0.0;
+  double inner_size, pages;
+
+  inner = planp->plan_un.join.inner;
+
+  /* for worst cost */
+  if (inner->fixed_cpu_cost == QO_INFINITY || inner->fixed_io_cost == QO_INFINITY
+      || inner->variable_cpu_cost == QO_INFINITY || inner->variable_io_cost == QO_INFINITY)
+    {
+      qo_worst_cost (planp);
+      return;
+    }
+
+  outer = planp->plan_un.join.outer;
+
+  /* for worst cost */
+  if (outer->fixed_cpu_cost == QO_INFINITY || outer->fixed_io_cost == QO_INFINITY
+      || outer->variable_cpu_cost == QO_INFINITY || outer->variable_io_cost == QO_INFINITY)
+    {
+      qo_worst_cost (planp);
+      return;
+    }
+
+  env = outer->info->env;
+  if (outer->has_sort_limit)
+    {
+      outer_cardinality = (double) db_get_bigint (&QO_ENV_LIMIT_VALUE (env));
+    }
+  else
+    {
+      outer_cardinality = outer->info->cardinality;
+    }
+  inner_cardinality = inner->info->cardinality;
+
+  /* CPU and IO costs which are fixed against join; the hash table is built before the first row is produced */
+  planp->fixed_cpu_cost = outer->fixed_cpu_cost + inner->fixed_cpu_cost;
+  planp->fixed_cpu_cost += inner->variable_cpu_cost + inner_cardinality * (double) QO_CPU_WEIGHT;
+  planp->fixed_io_cost = outer->fixed_io_cost + inner->fixed_io_cost + inner->variable_io_cost;
+  /* CPU and IO costs which are variable according to the join plan; one probe per outer row */
+  planp->variable_cpu_cost = outer->variable_cpu_cost + outer_cardinality * (double) QO_CPU_WEIGHT;
+  planp->variable_io_cost = outer->variable_io_cost;
+
+  inner_size = inner_cardinality * (double) inner->info->projected_size;
+  if (inner_size > (double) prm_get_bigint_value (PRM_ID_MAX_HASH_JOIN_SIZE))
+    {
+      /* partitioned: write both lists out and read them back */
+      pages = (outer_cardinality * (double) outer->info->projected_size + inner_size) / IO_PAGESIZE;
+      planp->variable_io_cost += 2.0 * MAX (1.0, pages);
+    }
+}
+
 /*
  * qo_follow_new () -
  *   return:
@@ -5954,6 +6064,148 @@ exit:
   return n;
 }
 
+/*
+ * qo_is_hash_join_term () - check whether a join term can be evaluated by
+ *			     hashing the values of both sides
+ *   return: bool
+ *   term(in):
+ *
+ * Note: The executor hashes the column values of each side separately, so
+ *	 both sides must have the same type and that type must give equal
+ *	 hash numbers to values that compare equal.
+ */
+static bool
+qo_is_hash_join_term (QO_TERM * term)
+{
+  PT_NODE *expr, *arg1, *arg2;
+
+  expr = QO_TERM_PT_EXPR (term);
+  if (expr == NULL || expr->node_type != PT_EXPR || expr->info.expr.op != PT_EQ)
+    {
+      return false;
+    }
+
+  arg1 = expr->info.expr.arg1;
+  arg2 = expr->info.expr.arg2;
+  if (arg1 == NULL || arg2 == NULL || arg1->type_enum != arg2->type_enum)
+    {
+      return false;
+    }
+
+  switch (arg1->type_enum)
+    {
+    case PT_TYPE_INTEGER:
+    case PT_TYPE_SMALLINT:
+    case PT_TYPE_BIGINT:
+    case PT_TYPE_DATE:
+    case PT_TYPE_TIME:
+    case PT_TYPE_TIMESTAMP:
+    case PT_TYPE_DATETIME:
+      return true;
+
+    case PT_TYPE_CHAR:
+    case PT_TYPE_VARCHAR:
+    case PT_TYPE_NCHAR:
+    case PT_TYPE_VARNCHAR:
+      /* string hashing depends on the collation */
+      return (arg1->data_type != NULL && arg2->data_type != NULL
+	      && arg1->data_type->info.data_type.collation_id == arg2->data_type->info.data_type.collation_id);
+
+    default:
+      /* numeric scale, float signed zero, sets, lobs, ... hash equal values differently */
+      return false;
+    }
+}
+
+/*
+ * qo_examine_hash_join () -
+ *   return:
+ *   info(in):
+ *   join_type(in):
+ *   outer(in):
+ *   inner(in):
+ *   sm_join_terms(in):
+ *   duj_terms(in):
+ *   afj_terms(in):
+ *   sarged_terms(in):
+ *   pinned_subqueries(in):
+ *
+ * Note: Only inner equi-joins are implemented as hash joins; every term of
+ *	 sm_join_terms becomes a hash key column.
+ */
+static int
+qo_examine_hash_join (QO_INFO * info, JOIN_TYPE join_type, QO_INFO * outer, QO_INFO * inner, BITSET * sm_join_terms,
+		      BITSET * duj_terms, BITSET * afj_terms, BITSET * sarged_terms, BITSET * pinned_subqueries)
+{
+  int n = 0;
+  QO_PLAN *outer_plan, *inner_plan;
+  QO_NODE *inner_node;
+  PT_NODE *spec;
+  int t;
+  BITSET_ITERATOR iter;
+
+  if (join_type != JOIN_INNER)
+    {
+      goto exit;
+    }
+
+  /* fake terms need the nested loop evaluation order; see qo_examine_merge_join () */
+  if (bitset_intersects (sarged_terms, &(info->env->fake_terms)))
+    {
+      goto exit;
+    }
+
+  for (t = bitset_iterate (sm_join_terms, &iter); t != -1; t = bitset_next_member (&iter))
+    {
+      if (!qo_is_hash_join_term (QO_ENV_TERM (info->env, t)))
+	{
+	  goto exit;
+	}
+    }
+
+  /* At here, inner is single class spec */
+  inner_node = QO_ENV_NODE (inner->env, bitset_first_member (&(inner->nodes)));
+
+  if (QO_NODE_HINT (inner_node) & (PT_HINT_USE_NL | PT_HINT_USE_IDX | PT_HINT_USE_MERGE))
+    {
+      /* join hint: force nl-join, idx-join, m-join; */
+      goto exit;
+    }
+  else if (!prm_get_bool_value (PRM_ID_OPTIMIZER_ENABLE_HASH_JOIN))
+    {
+      /* optimizer prm: keep out h-join; */
+      goto exit;
+    }
+
+  spec = QO_NODE_ENTITY_SPEC (inner_node);
+  if (spec && spec->info.spec.flat_entity_list == NULL && spec->info.spec.derived_table_type == PT_IS_CSELECT)
+    {
+      /* cselect joins are not inner joins at execution */
+      goto exit;
+    }
+
+  outer_plan = qo_find_best_plan_on_info (outer, QO_UNORDERED, 1.0);
+  if (outer_plan == NULL)
+    {
+      goto exit;
+    }
+
+  inner_plan = qo_find_best_plan_on_info (inner, QO_UNORDERED, 1.0);
+  if (inner_plan == NULL)
+    {
+      goto exit;
+    }
+
+  n =
+    qo_check_plan_on_info (info,
+			   qo_join_new (info, join_type, QO_JOINMETHOD_HASH_JOIN, outer_plan, inner_plan,
+					sm_join_terms, duj_terms, afj_terms, sarged_terms, pinned_subqueries));
+
+exit:
+
+  return n;
+}
+
 /*
  * qo_examine_correlated_index () -
  *   return: int
@@ -7076,6 +7328,14 @@ planner_visit_node (QO_PLANNER * planner, QO_PARTITION * partition, PT_HINT_ENUM
 				     &sarged_terms, &pinned_subqueries);
 	  }
 #endif /* MERGE_JOINS */
+
+	/* STEP 5-5: examine hash-join */
+	if (!bitset_is_empty (&sm_join_terms))
+	  {
+	    kept +=
+	      qo_examine_hash_join (new_info, join_type, head_info, tail_info, &sm_join_terms, &duj_terms, &afj_terms,
+				    &sarged_terms, &pinned_subqueries);
+	  }
       }
 
     /* At this point, kept indicates the number of worthwhile plans generated by examine_joins (i.e., plans that where
@@ -9089,11 +9349,12 @@ qo_expr_selectivity (QO_ENV * env, PT_NODE * pt_expr)
 	  break;
 
 	case PT_IS_NULL:
-	  selectivity = DEFAULT_NULL_SELECTIVITY;	/* make a guess */
+	  selectivity = qo_null_selectivity (env, node->info.expr.arg1);
 	  break;
 
 	case PT_IS_NOT_NULL:
-	  selectivity = qo_not_selectivity (env, DEFAULT_NULL_SELECTIVITY);
+	  lhs_selectivity = qo_null_selectivity (env, node->info.expr.arg1);
+	  selectivity = qo_not_selectivity (env, lhs_selectivity);
 	  break;
 
 	case PT_EXISTS:
@@ -9206,9 +9467,9 @@ qo_equal_selectivity (QO_ENV * env, PT_NODE * pt_expr)
 	case PC_ATTR:
 	  /* attr = attr */
 
-	  /* check for indexes on either of the attributes */
-	  lhs_icard = qo_index_cardinality (env, lhs);
-	  rhs_icard = qo_index_cardinality (env, rhs);
+	  /* check for indexes or column statistics on either of the attributes */
+	  lhs_icard = qo_distinct_values (env, lhs);
+	  rhs_icard = qo_distinct_values (env, rhs);
 
 	  icard = MAX (lhs_icard, rhs_icard);
 	  if (icard != 0)
@@ -9230,7 +9491,7 @@ qo_equal_selectivity (QO_ENV * env, PT_NODE * pt_expr)
 	  /* attr = const */
 
 	  /* check for index on the attribute.  NOTE: For an equality predicate, we treat subqueries as constants. */
-	  lhs_icard = qo_index_cardinality (env, lhs);
+	  lhs_icard = qo_distinct_values (env, lhs);
 	  if (lhs_icard != 0)
 	    {
 	      selectivity = (1.0 / lhs_icard);
@@ -9257,7 +9518,7 @@ qo_equal_selectivity (QO_ENV * env, PT_NODE * pt_expr)
 	  /* const = attr */
 
 	  /* check for index on the attribute.  NOTE: For an equality predicate, we treat subqueries as constants. */
-	  rhs_icard = qo_index_cardinality (env, rhs);
+	  rhs_icard = qo_distinct_values (env, rhs);
 	  if (rhs_icard != 0)
 	    {
 	      selectivity = (1.0 / rhs_icard);
@@ -9297,7 +9558,46 @@ qo_equal_selectivity (QO_ENV * env, PT_NODE * pt_expr)
 static double
 qo_comp_selectivity (QO_ENV * env, PT_NODE * pt_expr)
 {
-  return DEFAULT_COMP_SELECTIVITY;
+  PT_NODE *lhs, *rhs;
+  PT_OP_TYPE op;
+  double selectivity;
+
+  lhs = pt_expr->info.expr.arg1;
+  rhs = pt_expr->info.expr.arg2;
+  op = pt_expr->info.expr.op;
+
+  selectivity = -1.0;
+
+  /* the only interesting cases are 'attr op const' and 'const op attr' */
+  if (qo_classify (lhs) == PC_ATTR && qo_classify (rhs) == PC_CONST)
+    {
+      if (op == PT_LT || op == PT_LE)
+	{
+	  selectivity = qo_histogram_selectivity (env, lhs, NULL, rhs);
+	}
+      else
+	{
+	  selectivity = qo_histogram_selectivity (env, lhs, rhs, NULL);
+	}
+    }
+  else if (qo_classify (lhs) == PC_CONST && qo_classify (rhs) == PC_ATTR)
+    {
+      if (op == PT_LT || op == PT_LE)
+	{
+	  selectivity = qo_histogram_selectivity (env, rhs, lhs, NULL);
+	}
+      else
+	{
+	  selectivity = qo_histogram_selectivity (env, rhs, NULL, lhs);
+	}
+    }
+
+  if (selectivity < 0.0)
+    {
+      return DEFAULT_COMP_SELECTIVITY;
+    }
+
+  return selectivity;
 }
 
 /*
@@ -9312,12 +9612,24 @@ static double
 qo_between_selectivity (QO_ENV * env, PT_NODE * pt_expr)
 {
   PT_NODE *and_node;
+  double selectivity;
 
   and_node = pt_expr->info.expr.arg2;
 
   QO_ASSERT (env, and_node->node_type == PT_EXPR);
   QO_ASSERT (env, pt_is_between_range_op (and_node->info.expr.op));
 
+  if (qo_classify (pt_expr->info.expr.arg1) == PC_ATTR && qo_classify (and_node->info.expr.arg1) == PC_CONST
+      && qo_classify (and_node->info.expr.arg2) == PC_CONST)
+    {
+      selectivity =
+	qo_histogram_selectivity (env, pt_expr->info.expr.arg1, and_node->info.expr.arg1, and_node->info.expr.arg2);
+      if (selectivity >= 0.0)
+	{
+	  return selectivity;
+	}
+    }
+
   return DEFAULT_BETWEEN_SELECTIVITY;
 }
 
@@ -9350,7 +9662,7 @@ qo_range_selectivity (QO_ENV * env, PT_NODE * pt_expr)
 #endif
 
   /* get index cardinality */
-  lhs_icard = qo_index_cardinality (env, lhs);
+  lhs_icard = qo_distinct_values (env, lhs);
 
   total_selectivity = 0.0;
 
@@ -9370,6 +9682,15 @@ qo_range_selectivity (QO_ENV * env, PT_NODE * pt_expr)
 	  || op_type == PT_BETWEEN_GT_LT)
 	{
 	  selectivity = DEFAULT_BETWEEN_SELECTIVITY;
+
+	  if (pc1 == PC_CONST && qo_classify (arg2) == PC_CONST)
+	    {
+	      selectivity = qo_histogram_selectivity (env, lhs, arg1, arg2);
+	      if (selectivity < 0.0)
+		{
+		  selectivity = DEFAULT_BETWEEN_SELECTIVITY;
+		}
+	    }
 	}
       else if (op_type == PT_BETWEEN_EQ_NA)
 	{
@@ -9380,7 +9701,7 @@ qo_range_selectivity (QO_ENV * env, PT_NODE * pt_expr)
 	  if (pc1 == PC_ATTR)
 	    {
 	      /* attr1 range (attr2 = ) */
-	      rhs_icard = qo_index_cardinality (env, arg1);
+	      rhs_icard = qo_distinct_values (env, arg1);
 
 	      icard = MAX (lhs_icard, rhs_icard);
 	      if (icard != 0)
@@ -9409,7 +9730,22 @@ qo_range_selectivity (QO_ENV * env, PT_NODE * pt_expr)
 	{
 	  /* PT_BETWEEN_INF_LE, PT_BETWEEN_INF_LT, PT_BETWEEN_GE_INF, and PT_BETWEEN_GT_INF have only one argument */
 
-	  selectivity = DEFAULT_COMP_SELECTIVITY;
+	  selectivity = -1.0;
+	  if (pc1 == PC_CONST)
+	    {
+	      if (op_type == PT_BETWEEN_INF_LE || op_type == PT_BETWEEN_INF_LT)
+		{
+		  selectivity = qo_histogram_selectivity (env, lhs, NULL, arg1);
+		}
+	      else
+		{
+		  selectivity = qo_histogram_selectivity (env, lhs, arg1, NULL);
+		}
+	    }
+	  if (selectivity < 0.0)
+	    {
+	      selectivity = DEFAULT_COMP_SELECTIVITY;
+	    }
 	}
 
       selectivity = MAX (selectivity, 0.0);
@@ -9445,8 +9781,8 @@ qo_all_some_in_selectivity (QO_ENV * env, PT_NODE * pt_expr)
   /* The only interesting cases are: attr IN set or attr IN subquery */
   if (pc_lhs == PC_ATTR && (pc_rhs == PC_SET || pc_rhs == PC_SUBQUERY))
     {
-      /* check for index on the attribute.  */
-      icard = qo_index_cardinality (env, pt_expr->info.expr.arg1);
+      /* check for index or column statistics on the attribute.  */
+      icard = qo_distinct_values (env, pt_expr->info.expr.arg1);
 
       if (icard != 0)
 	{
@@ -9533,11 +9869,41 @@ qo_classify (PT_NODE * attr)
  */
 static int
 qo_index_cardinality (QO_ENV * env, PT_NODE * attr)
+{
+  QO_ATTR_INFO *info;
+
+  info = qo_get_attr_stats_info (env, attr, NULL);
+  if (info == NULL)
+    {
+      return 0;
+    }
+
+  if (info->cum_stats.is_indexed != true)
+    {
+      return 0;
+    }
+
+  QO_ASSERT (env, info->cum_stats.pkeys_size > 0);
+  QO_ASSERT (env, info->cum_stats.pkeys_size <= BTREE_STATS_PKEYS_NUM);
+  QO_ASSERT (env, info->cum_stats.pkeys != NULL);
+
+  /* return number of the first partial-key of the index on the attribute shown in the expression */
+  return info->cum_stats.pkeys[0];
+}
+
+/*
+ * qo_get_attr_stats_info () - Find the statistics gathered for an attribute
+ *   return: attribute info of the segment, or NULL if there is none
+ *   env(in): optimizer environment
+ *   attr(in): pt node for the attribute
+ *   nodepp(out): if not NULL, the node the attribute belongs to
+ */
+static QO_ATTR_INFO *
+qo_get_attr_stats_info (QO_ENV * env, PT_NODE * attr, QO_NODE ** nodepp)
 {
   PT_NODE *dummy;
   QO_NODE *nodep;
   QO_SEGMENT *segp;
-  QO_ATTR_INFO *info;
 
   if (attr->node_type == PT_DOT_)
     {
@@ -9549,37 +9915,202 @@ qo_index_cardinality (QO_ENV * env, PT_NODE * attr)
   nodep = lookup_node (attr, env, &dummy);
   if (nodep == NULL)
     {
-      return 0;
+      return NULL;
     }
 
   segp = lookup_seg (nodep, attr, env);
   if (segp == NULL)
     {
-      return 0;
+      return NULL;
     }
 
   if (attr->info.name.meta_class == PT_RESERVED)
     {
-      return 0;
+      return NULL;
+    }
+
+  if (nodepp != NULL)
+    {
+      *nodepp = nodep;
+    }
+
+  return QO_SEG_INFO (segp);
+}
+
+/*
+ * qo_distinct_values () - Estimate the number of distinct values of an attribute
+ *   return: number of distinct values, or 0 if unknown
+ *   env(in): optimizer environment
+ *   attr(in): pt node for the attribute
+ *
+ * Note: the cardinality of an index on the attribute is exact and preferred; otherwise the estimate gathered from
+ *       the sampled column statistics is used.
+ */
+static int
+qo_distinct_values (QO_ENV * env, PT_NODE * attr)
+{
+  QO_ATTR_INFO *info;
+  int icard;
+
+  icard = qo_index_cardinality (env, attr);
+  if (icard != 0)
+    {
+      return icard;
     }
 
-  info = QO_SEG_INFO (segp);
+  info = qo_get_attr_stats_info (env, attr, NULL);
   if (info == NULL)
     {
       return 0;
     }
 
-  if (info->cum_stats.is_indexed != true)
+  return info->cum_stats.ndv;
+}
+
+/*
+ * qo_null_selectivity () - Compute the selectivity of an is null predicate
+ *   return: double
+ *   env(in): optimizer environment
+ *   attr(in): operand of the predicate
+ */
+static double
+qo_null_selectivity (QO_ENV * env, PT_NODE * attr)
+{
+  QO_ATTR_INFO *info;
+  QO_NODE *nodep = NULL;
+  double selectivity;
+
+  if (qo_classify (attr) != PC_ATTR)
     {
-      return 0;
+      return DEFAULT_NULL_SELECTIVITY;
     }
 
-  QO_ASSERT (env, info->cum_stats.pkeys_size > 0);
-  QO_ASSERT (env, info->cum_stats.pkeys_size <= BTREE_STATS_PKEYS_NUM);
-  QO_ASSERT (env, info->cum_stats.pkeys != NULL);
+  info = qo_get_attr_stats_info (env, attr, &nodep);
+  if (info == NULL || !info->cum_stats.valid_limits || info->cum_stats.ndv == 0 || QO_NODE_NCARD (nodep) == 0)
+    {
+      /* no column statistics; make a guess */
+      return DEFAULT_NULL_SELECTIVITY;
+    }
 
-  /* return number of the first partial-key of the index on the attribute shown in the expression */
-  return info->cum_stats.pkeys[0];
+  selectivity = (double) info->cum_stats.null_count / (double) QO_NODE_NCARD (nodep);
+  selectivity = MAX (selectivity, 0.0);
+  selectivity = MIN (selectivity, 1.0);
+
+  return selectivity;
+}
+
+/*
+ * qo_histogram_selectivity () - Estimate the fraction of rows of an attribute that fall into a range by using the
+ *                               equi-depth histogram of the attribute
+ *   return: selectivity, or -1.0 if the histogram cannot be used
+ *   env(in): optimizer environment
+ *   attr(in): pt node for the attribute
+ *   lower(in): constant lower bound of the range, or NULL if unbounded
+ *   upper(in): constant upper bound of the range, or NULL if unbounded
+ *
+ * Note: the inclusiveness of the bounds is ignored; values are assumed to be spread uniformly within a bucket.
+ */
+static double
+qo_histogram_selectivity (QO_ENV * env, PT_NODE * attr, PT_NODE * lower, PT_NODE * upper)
+{
+  QO_ATTR_INFO *info;
+  QO_ATTR_CUM_STATS *cum_statsp;
+  QO_NODE *nodep = NULL;
+  PT_NODE *bound_node[2];
+  DB_VALUE *bound_value;
+  DB_VALUE coerced;
+  TP_DOMAIN *domain;
+  double key, fraction[2], bucket_fraction, not_null_fraction, selectivity;
+  int i, b, n_buckets;
+
+  info = qo_get_attr_stats_info (env, attr, &nodep);
+  if (info == NULL || info->cum_stats.n_bounds < 2 || QO_NODE_NCARD (nodep) == 0)
+    {
+      return -1.0;
+    }
+  cum_statsp = &info->cum_stats;
+
+  domain = tp_domain_resolve_default (cum_statsp->type);
+  if (domain == NULL)
+    {
+      return -1.0;
+    }
+
+  n_buckets = cum_statsp->n_bounds - 1;
+  bound_node[0] = lower;
+  bound_node[1] = upper;
+
+  for (i = 0; i < 2; i++)
+    {
+      /* fraction of not null values lower than the bound */
+      fraction[i] = (i == 0) ? 0.0 : 1.0;
+      if (bound_node[i] == NULL)
+	{
+	  continue;
+	}
+
+      bound_value = pt_value_to_db (QO_ENV_PARSER (env), bound_node[i]);
+      if (bound_value == NULL || DB_IS_NULL (bound_value))
+	{
+	  return -1.0;
+	}
+
+      /* bring the constant to the type of the attribute so that its key is comparable with the bounds */
+      db_make_null (&coerced);
+      if (tp_value_coerce (bound_value, &coerced, domain) != DOMAIN_COMPATIBLE)
+	{
+	  pr_clear_value (&coerced);
+	  return -1.0;
+	}
+      if (!tp_value_to_histogram_key (&coerced, &key))
+	{
+	  pr_clear_value (&coerced);
+	  return -1.0;
+	}
+      pr_clear_value (&coerced);
+
+      if (key <= cum_statsp->bounds[0])
+	{
+	  fraction[i] = 0.0;
+	}
+      else if (key >= cum_statsp->bounds[n_buckets])
+	{
+	  fraction[i] = 1.0;
+	}
+      else
+	{
+	  for (b = 0; b < n_buckets - 1; b++)
+	    {
+	      if (key < cum_statsp->bounds[b + 1])
+		{
+		  break;
+		}
+	    }
+
+	  bucket_fraction = 0.0;
+	  if (cum_statsp->bounds[b + 1] > cum_statsp->bounds[b])
+	    {
+	      bucket_fraction = (key - cum_statsp->bounds[b]) / (cum_statsp->bounds[b + 1] - cum_statsp->bounds[b]);
+	    }
+	  fraction[i] = (b + bucket_fraction) / n_buckets;
+	}
+    }
+
+  not_null_fraction = 1.0 - ((double) cum_statsp->null_count / (double) QO_NODE_NCARD (nodep));
+  not_null_fraction = MAX (not_null_fraction, 0.0);
+
+  selectivity = (fraction[1] - fraction[0]) * not_null_fraction;
+
+  /* a range never selects less than a single distinct value; the statistics may be stale */
+  if (cum_statsp->ndv > 0)
+    {
+      selectivity = MAX (selectivity, not_null_fraction / cum_statsp->ndv);
+    }
+
+  selectivity = MAX (selectivity, 0.0);
+  selectivity = MIN (selectivity, 1.0);
+
+  return selectivity;
 }
 
 /*
@@ -10498,7 +11029,7 @@ qo_plan_compute_iscan_sort_list (QO_PLAN * root, PT_NODE * group_by, bool * is_i
 	    }
 	  else
 	    {
-	      /* QO_JOINMETHOD_MERGE_JOIN */
+	      /* QO_JOINMETHOD_MERGE_JOIN, QO_JOINMETHOD_HASH_JOIN */
 	      plan = NULL;
 	    }
 	  break;
@@ -11042,6 +11573,10 @@ qo_plan_join_print_json (QO_PLAN * plan)
     case QO_JOINMETHOD_MERGE_JOIN:
       method = "MERGE JOIN";
       break;
+
+    case QO_JOINMETHOD_HASH_JOIN:
+      method = "HASH JOIN";
+      break;
     }
 
   switch (plan->plan_un.join.join_type)
@@ -11353,6 +11888,10 @@ qo_plan_join_print_text (FILE * fp, QO_PLAN * plan, int indent)
     case QO_JOINMETHOD_MERGE_JOIN:
       method = "MERGE JOIN";
       break;
+
+    case QO_JOINMETHOD_HASH_JOIN:
+      method = "HASH JOIN";
+      break;
     }
 
   switch (plan->plan_un.join.join_type)
@@ -65,7 +65,8 @@ typedef enum
 {
   QO_JOINMETHOD_NL_JOIN,
   QO_JOINMETHOD_IDX_JOIN,
-  QO_JOINMETHOD_MERGE_JOIN
+  QO_JOINMETHOD_MERGE_JOIN,
+  QO_JOINMETHOD_HASH_JOIN
 } QO_JOINMETHOD;
 
 typedef struct qo_plan_vtbl QO_PLAN_VTBL;
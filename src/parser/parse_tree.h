@@ -1174,7 +1174,7 @@ typedef enum
   PT_HINT_RECOMPILE = 0x0100,	/* 0000 0001 0000 0000 *//* recompile */
   PT_HINT_LK_TIMEOUT = 0x0200,	/* 0000 0010 0000 0000 *//* lock_timeout */
   PT_HINT_NO_LOGGING = 0x0400,	/* 0000 0100 0000 0000 *//* no_logging */
-  PT_HINT_UNUSED1 = 0x0800,	/* 0000 1000 0000 0000 *//* not used */
+  PT_HINT_PARALLEL = 0x0800,	/* 0000 1000 0000 0000 *//* parallel scan degree */
   PT_HINT_QUERY_CACHE = 0x1000,	/* 0001 0000 0000 0000 *//* query_cache */
   PT_HINT_REEXECUTE = 0x2000,	/* 0010 0000 0000 0000 *//* reexecute */
   PT_HINT_JDBC_CACHE = 0x4000,	/* 0100 0000 0000 0000 *//* jdbc_cache */
@@ -2707,6 +2707,7 @@ struct pt_select_info
   PT_NODE *use_merge;		/* PT_NAME (list) */
   PT_NODE *waitsecs_hint;	/* lock timeout in seconds */
   PT_NODE *jdbc_life_time;	/* jdbc cache life time */
+  PT_NODE *parallel_hint;	/* degree of parallel scan */
   struct qo_summary *qo_summary;
   PT_NODE *check_where;		/* with check option predicate */
   PT_NODE *for_update;		/* FOR UPDATE clause tables list */
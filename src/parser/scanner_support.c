@@ -312,6 +312,14 @@ pt_get_hint (const char *text, PT_HINT hint_table[], PT_NODE * node)
 		}
 	      hint_table[i].arg_list = NULL;
 	      break;
+	    case PT_HINT_PARALLEL:	/* parallel scan degree */
+	      if (node->node_type == PT_SELECT)
+		{
+		  node->info.query.q.select.hint = (PT_HINT_ENUM) (node->info.query.q.select.hint | hint_table[i].hint);
+		  node->info.query.q.select.parallel_hint = hint_table[i].arg_list;
+		  hint_table[i].arg_list = NULL;
+		}
+	      break;
 	    case PT_HINT_NO_LOGGING:	/* no logging */
 	      if (node->node_type == PT_UPDATE)
 		{
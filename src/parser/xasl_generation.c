@@ -16123,6 +16123,17 @@ pt_to_buildvalue_proc (PARSER_CONTEXT * parser, PT_NODE * select_node, QO_PLAN *
   /* assume parse tree correct, and PT_DISTINCT only other possibility */
   xasl->option = ((select_node->info.query.all_distinct == PT_ALL) ? Q_ALL : Q_DISTINCT);
 
+  /* set parallel scan degree if specified; the server caps it with parallel_scan_degree */
+  if (select_node->info.query.q.select.hint & PT_HINT_PARALLEL
+      && PT_IS_HINT_NODE (select_node->info.query.q.select.parallel_hint))
+    {
+      xasl->parallel_degree = atoi (select_node->info.query.q.select.parallel_hint->info.name.original);
+      if (xasl->parallel_degree < 0)
+	{
+	  xasl->parallel_degree = 0;
+	}
+    }
+
   /* set 'etc' field for pseudocolumn nodes */
   pt_set_level_node_etc (parser, select_node->info.query.q.select.list, &xasl->level_val);
   pt_set_isleaf_node_etc (parser, select_node->info.query.q.select.list, &xasl->isleaf_val);
@@ -0,0 +1,826 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/*
+ * batch_filter.c - batch-at-a-time evaluation of simple scan predicates
+ *
+ * The simple terms of a data filter conjunction (attr op constant, attr BETWEEN constants and attr IN (constants)
+ * over fixed width INTEGER, BIGINT, DOUBLE, DATE and DATETIME attributes) are compiled into a batch filter. The
+ * attributes of a batch of records are decoded into typed arrays and the terms are evaluated with plain loops over
+ * those arrays, producing a selection vector. The batch filter only rejects records for which the data filter cannot
+ * be true; the selected records still go through the regular evaluation.
+ */
+
+#ident "$Id$"
+
+#include "config.h"
+
+#include <string.h>
+#include <assert.h>
+
+#include "batch_filter.h"
+
+#include "dbtype.h"
+#include "error_manager.h"
+#include "memory_alloc.h"
+#include "numeric_opfunc.h"
+#include "object_primitive.h"
+#include "object_representation.h"
+#include "object_representation_sr.h"
+#include "query_executor.h"
+#include "regu_var.hpp"
+#include "set_object.h"
+
+/* sel[i] &= values[i] op constant for bound values; records that were not decoded stay selected */
+#define BATCH_FILTER_CMP_LOOP(values, op, constant) \
+  do \
+    { \
+      for (i = 0; i < n_records; i++) \
+	{ \
+	  sel[i] &= (unsigned char) ((((values)[i] op (constant)) & !col->is_null[i]) | filter->skip[i]); \
+	} \
+    } \
+  while (0)
+
+/* match[i] |= values[i] == constant */
+#define BATCH_FILTER_MATCH_LOOP(values, constant) \
+  do \
+    { \
+      for (i = 0; i < n_records; i++) \
+	{ \
+	  filter->match[i] |= (unsigned char) ((values)[i] == (constant)); \
+	} \
+    } \
+  while (0)
+
+static bool batch_filter_is_supported_type (DB_TYPE type);
+static int batch_filter_find_column (BATCH_FILTER * filter, DB_TYPE type, int location, int position);
+static void batch_filter_put_value (const DB_VALUE * value, INT64 * int_value, double *double_value);
+static OR_ATTRIBUTE *batch_filter_get_attribute (const REGU_VARIABLE * regu, HEAP_CACHE_ATTRINFO * attr_cache);
+static DB_VALUE *batch_filter_get_constant (const REGU_VARIABLE * regu, VAL_DESCR * vd);
+static int batch_filter_compile_comp (BATCH_FILTER * filter, const COMP_EVAL_TERM * et_comp,
+				      HEAP_CACHE_ATTRINFO * attr_cache, VAL_DESCR * vd);
+static int batch_filter_compile_alsm (BATCH_FILTER * filter, const ALSM_EVAL_TERM * et_alsm,
+				      HEAP_CACHE_ATTRINFO * attr_cache, VAL_DESCR * vd);
+static int batch_filter_compile_pred (BATCH_FILTER * filter, const PRED_EXPR * pred,
+				      HEAP_CACHE_ATTRINFO * attr_cache, VAL_DESCR * vd);
+
+/*
+ * batch_filter_create () - create an empty batch filter
+ *   return: batch filter or NULL on error
+ *   repr_id(in): representation of the records to decode
+ *   n_variable(in): number of variable attributes of the representation
+ *   fixed_length(in): total size of the fixed attributes of the representation
+ */
+BATCH_FILTER *
+batch_filter_create (REPR_ID repr_id, int n_variable, int fixed_length)
+{
+  BATCH_FILTER *filter;
+
+  filter = (BATCH_FILTER *) malloc (sizeof (BATCH_FILTER));
+  if (filter == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (BATCH_FILTER));
+      return NULL;
+    }
+  memset (filter, 0, sizeof (BATCH_FILTER));
+
+  filter->repr_id = repr_id;
+  filter->n_variable = n_variable;
+  filter->fixed_length = fixed_length;
+
+  filter->skip = (unsigned char *) malloc (2 * BATCH_FILTER_CAPACITY);
+  if (filter->skip == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) (2 * BATCH_FILTER_CAPACITY));
+      free_and_init (filter);
+      return NULL;
+    }
+  filter->match = filter->skip + BATCH_FILTER_CAPACITY;
+
+  return filter;
+}
+
+/*
+ * batch_filter_destroy () - free a batch filter
+ *   return:
+ *   filter(in): batch filter
+ */
+void
+batch_filter_destroy (BATCH_FILTER * filter)
+{
+  int i;
+
+  if (filter == NULL)
+    {
+      return;
+    }
+
+  for (i = 0; i < filter->n_columns; i++)
+    {
+      if (filter->columns[i].int_values != NULL)
+	{
+	  free_and_init (filter->columns[i].int_values);
+	}
+      if (filter->columns[i].double_values != NULL)
+	{
+	  free_and_init (filter->columns[i].double_values);
+	}
+      if (filter->columns[i].is_null != NULL)
+	{
+	  free_and_init (filter->columns[i].is_null);
+	}
+    }
+
+  for (i = 0; i < filter->n_terms; i++)
+    {
+      if (filter->terms[i].int_values != NULL)
+	{
+	  free_and_init (filter->terms[i].int_values);
+	}
+      if (filter->terms[i].double_values != NULL)
+	{
+	  free_and_init (filter->terms[i].double_values);
+	}
+    }
+
+  free_and_init (filter->skip);
+  free_and_init (filter);
+}
+
+/*
+ * batch_filter_is_supported_type () - can attributes of this type be decoded by batch filters?
+ *   return: true if supported
+ *   type(in): attribute type
+ */
+static bool
+batch_filter_is_supported_type (DB_TYPE type)
+{
+  switch (type)
+    {
+    case DB_TYPE_INTEGER:
+    case DB_TYPE_BIGINT:
+    case DB_TYPE_DOUBLE:
+    case DB_TYPE_DATE:
+    case DB_TYPE_DATETIME:
+      return true;
+    default:
+      return false;
+    }
+}
+
+/*
+ * batch_filter_find_column () - get the column of an attribute, add it if needed
+ *   return: column index or error code
+ *   filter(in/out): batch filter
+ *   type(in): attribute type
+ *   location(in): offset of the attribute among the fixed attributes
+ *   position(in): bound bit position of the attribute
+ */
+static int
+batch_filter_find_column (BATCH_FILTER * filter, DB_TYPE type, int location, int position)
+{
+  BATCH_FILTER_COLUMN *col;
+  int i;
+
+  for (i = 0; i < filter->n_columns; i++)
+    {
+      if (filter->columns[i].location == location)
+	{
+	  assert (filter->columns[i].type == type);
+	  return i;
+	}
+    }
+
+  assert (filter->n_columns < BATCH_FILTER_MAX_TERMS);
+
+  col = &filter->columns[filter->n_columns];
+  col->type = type;
+  col->location = location;
+  col->position = position;
+  col->is_null = (unsigned char *) malloc (BATCH_FILTER_CAPACITY);
+  if (type == DB_TYPE_DOUBLE)
+    {
+      col->double_values = (double *) malloc (BATCH_FILTER_CAPACITY * sizeof (double));
+    }
+  else
+    {
+      col->int_values = (INT64 *) malloc (BATCH_FILTER_CAPACITY * sizeof (INT64));
+    }
+  /* count the column now so batch_filter_destroy frees what was allocated */
+  filter->n_columns++;
+
+  if (col->is_null == NULL || (col->double_values == NULL && col->int_values == NULL))
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      (size_t) (BATCH_FILTER_CAPACITY * sizeof (double)));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  return filter->n_columns - 1;
+}
+
+/*
+ * batch_filter_put_value () - encode a value the way the columns of its type are decoded
+ *   return:
+ *   value(in): non-null value of a supported type
+ *   int_value(out): encoded value for all types but DOUBLE
+ *   double_value(out): encoded value for DOUBLE
+ */
+static void
+batch_filter_put_value (const DB_VALUE * value, INT64 * int_value, double *double_value)
+{
+  DB_DATETIME *datetime;
+
+  switch (DB_VALUE_DOMAIN_TYPE (value))
+    {
+    case DB_TYPE_INTEGER:
+      *int_value = db_get_int (value);
+      break;
+    case DB_TYPE_BIGINT:
+      *int_value = db_get_bigint (value);
+      break;
+    case DB_TYPE_DOUBLE:
+      *double_value = db_get_double (value);
+      break;
+    case DB_TYPE_DATE:
+      *int_value = *db_get_date (value);
+      break;
+    case DB_TYPE_DATETIME:
+      datetime = db_get_datetime (value);
+      *int_value = (INT64) datetime->date * MILLISECONDS_OF_ONE_DAY + datetime->time;
+      break;
+    default:
+      assert (false);
+      break;
+    }
+}
+
+/*
+ * batch_filter_add_term () - add a term to the batch filter
+ *   return: error code
+ *   filter(in/out): batch filter
+ *   type(in): attribute type
+ *   location(in): offset of the attribute among the fixed attributes
+ *   position(in): bound bit position of the attribute
+ *   op(in): comparison operator
+ *   values(in): non-null constants of the attribute type
+ *   n_values(in): number of constants; one unless op is BATCH_FILTER_IN
+ */
+int
+batch_filter_add_term (BATCH_FILTER * filter, DB_TYPE type, int location, int position, BATCH_FILTER_OP op,
+		       const DB_VALUE * values, int n_values)
+{
+  BATCH_FILTER_TERM *term;
+  int column;
+  int i;
+
+  assert (batch_filter_is_supported_type (type));
+  assert (op == BATCH_FILTER_IN || n_values == 1);
+
+  if (filter->n_terms >= BATCH_FILTER_MAX_TERMS)
+    {
+      /* the rest is left to the regular evaluation */
+      return NO_ERROR;
+    }
+
+  column = batch_filter_find_column (filter, type, location, position);
+  if (column < 0)
+    {
+      return column;
+    }
+
+  term = &filter->terms[filter->n_terms];
+  term->column = column;
+  term->op = op;
+  term->n_values = n_values;
+  term->int_values = NULL;
+  term->double_values = NULL;
+  filter->n_terms++;
+
+  if (n_values == 0)
+    {
+      return NO_ERROR;
+    }
+
+  if (type == DB_TYPE_DOUBLE)
+    {
+      term->double_values = (double *) malloc (n_values * sizeof (double));
+    }
+  else
+    {
+      term->int_values = (INT64 *) malloc (n_values * sizeof (INT64));
+    }
+  if (term->double_values == NULL && term->int_values == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) (n_values * sizeof (double)));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  for (i = 0; i < n_values; i++)
+    {
+      assert (DB_VALUE_DOMAIN_TYPE (&values[i]) == type);
+      batch_filter_put_value (&values[i], term->int_values != NULL ? &term->int_values[i] : NULL,
+			      term->double_values != NULL ? &term->double_values[i] : NULL);
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * batch_filter_get_attribute () - get the representation of an attribute fetched by a regu variable
+ *   return: fixed attribute of a supported type or NULL
+ *   regu(in): regu variable
+ *   attr_cache(in): attribute cache of the scan
+ */
+static OR_ATTRIBUTE *
+batch_filter_get_attribute (const REGU_VARIABLE * regu, HEAP_CACHE_ATTRINFO * attr_cache)
+{
+  int i;
+
+  if (regu == NULL || regu->type != TYPE_ATTR_ID || regu->value.attr_descr.cache_attrinfo != attr_cache)
+    {
+      return NULL;
+    }
+
+  for (i = 0; i < attr_cache->num_values; i++)
+    {
+      HEAP_ATTRVALUE *value = &attr_cache->values[i];
+
+      if (value->attrid != regu->value.attr_descr.id)
+	{
+	  continue;
+	}
+      if (value->attr_type != HEAP_INSTANCE_ATTR || value->last_attrepr == NULL || !value->last_attrepr->is_fixed
+	  || !batch_filter_is_supported_type (value->last_attrepr->type))
+	{
+	  return NULL;
+	}
+      return value->last_attrepr;
+    }
+
+  return NULL;
+}
+
+/*
+ * batch_filter_get_constant () - get the value of a constant regu variable
+ *   return: value or NULL if regu variable is not a constant of the query
+ *   regu(in): regu variable
+ *   vd(in): value descriptor of the query
+ */
+static DB_VALUE *
+batch_filter_get_constant (const REGU_VARIABLE * regu, VAL_DESCR * vd)
+{
+  if (regu == NULL)
+    {
+      return NULL;
+    }
+
+  if (regu->type == TYPE_DBVAL)
+    {
+      return (DB_VALUE *) & regu->value.dbval;
+    }
+  else if (regu->type == TYPE_POS_VALUE && vd != NULL && regu->value.val_pos >= 0
+	   && regu->value.val_pos < vd->dbval_cnt)
+    {
+      return &vd->dbval_ptr[regu->value.val_pos];
+    }
+
+  return NULL;
+}
+
+/*
+ * batch_filter_compile_comp () - add a comparison term, if simple enough
+ *   return: error code
+ *   filter(in/out): batch filter
+ *   et_comp(in): comparison term
+ *   attr_cache(in): attribute cache of the scan
+ *   vd(in): value descriptor of the query
+ */
+static int
+batch_filter_compile_comp (BATCH_FILTER * filter, const COMP_EVAL_TERM * et_comp, HEAP_CACHE_ATTRINFO * attr_cache,
+			   VAL_DESCR * vd)
+{
+  OR_ATTRIBUTE *attr;
+  DB_VALUE *constant;
+  BATCH_FILTER_OP op;
+  bool reversed = false;
+
+  attr = batch_filter_get_attribute (et_comp->lhs, attr_cache);
+  constant = batch_filter_get_constant (et_comp->rhs, vd);
+  if (attr == NULL || constant == NULL)
+    {
+      /* constant op attr */
+      attr = batch_filter_get_attribute (et_comp->rhs, attr_cache);
+      constant = batch_filter_get_constant (et_comp->lhs, vd);
+      reversed = true;
+    }
+  if (attr == NULL || constant == NULL || DB_IS_NULL (constant) || DB_VALUE_DOMAIN_TYPE (constant) != attr->type)
+    {
+      return NO_ERROR;
+    }
+
+  switch (et_comp->rel_op)
+    {
+    case R_EQ:
+      op = BATCH_FILTER_EQ;
+      break;
+    case R_NE:
+      op = BATCH_FILTER_NE;
+      break;
+    case R_LT:
+      op = reversed ? BATCH_FILTER_GT : BATCH_FILTER_LT;
+      break;
+    case R_LE:
+      op = reversed ? BATCH_FILTER_GE : BATCH_FILTER_LE;
+      break;
+    case R_GT:
+      op = reversed ? BATCH_FILTER_LT : BATCH_FILTER_GT;
+      break;
+    case R_GE:
+      op = reversed ? BATCH_FILTER_LE : BATCH_FILTER_GE;
+      break;
+    default:
+      return NO_ERROR;
+    }
+
+  return batch_filter_add_term (filter, attr->type, attr->location, attr->position, op, constant, 1);
+}
+
+/*
+ * batch_filter_compile_alsm () - add an IN term, if simple enough
+ *   return: error code
+ *   filter(in/out): batch filter
+ *   et_alsm(in): all/some term
+ *   attr_cache(in): attribute cache of the scan
+ *   vd(in): value descriptor of the query
+ */
+static int
+batch_filter_compile_alsm (BATCH_FILTER * filter, const ALSM_EVAL_TERM * et_alsm, HEAP_CACHE_ATTRINFO * attr_cache,
+			   VAL_DESCR * vd)
+{
+  OR_ATTRIBUTE *attr;
+  DB_VALUE *constant;
+  DB_SET *set;
+  DB_VALUE *values = NULL;
+  int n_values = 0;
+  int size, i;
+  int error = NO_ERROR;
+
+  if (et_alsm->eq_flag != F_SOME || et_alsm->rel_op != R_EQ)
+    {
+      return NO_ERROR;
+    }
+
+  attr = batch_filter_get_attribute (et_alsm->elem, attr_cache);
+  constant = batch_filter_get_constant (et_alsm->elemset, vd);
+  if (attr == NULL || constant == NULL || DB_IS_NULL (constant)
+      || !TP_IS_SET_TYPE (DB_VALUE_DOMAIN_TYPE (constant)))
+    {
+      return NO_ERROR;
+    }
+
+  set = db_get_set (constant);
+  size = set_size (set);
+  if (size > 0)
+    {
+      values = (DB_VALUE *) malloc (size * sizeof (DB_VALUE));
+      if (values == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) (size * sizeof (DB_VALUE)));
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
+	}
+    }
+
+  for (i = 0; i < size; i++)
+    {
+      error = set_get_element (set, i, &values[n_values]);
+      if (error != NO_ERROR)
+	{
+	  goto end;
+	}
+      if (DB_IS_NULL (&values[n_values]))
+	{
+	  /* never equal */
+	  continue;
+	}
+      if (DB_VALUE_DOMAIN_TYPE (&values[n_values]) != attr->type)
+	{
+	  /* would need coercion; leave the term to the regular evaluation */
+	  pr_clear_value (&values[n_values]);
+	  goto end;
+	}
+      n_values++;
+    }
+
+  error = batch_filter_add_term (filter, attr->type, attr->location, attr->position, BATCH_FILTER_IN, values,
+				 n_values);
+
+end:
+  for (i = 0; i < n_values; i++)
+    {
+      pr_clear_value (&values[i]);
+    }
+  if (values != NULL)
+    {
+      free_and_init (values);
+    }
+
+  return error;
+}
+
+/*
+ * batch_filter_compile_pred () - add the simple terms of a conjunction
+ *   return: error code
+ *   filter(in/out): batch filter
+ *   pred(in): predicate
+ *   attr_cache(in): attribute cache of the scan
+ *   vd(in): value descriptor of the query
+ */
+static int
+batch_filter_compile_pred (BATCH_FILTER * filter, const PRED_EXPR * pred, HEAP_CACHE_ATTRINFO * attr_cache,
+			   VAL_DESCR * vd)
+{
+  int error;
+
+  if (pred == NULL)
+    {
+      return NO_ERROR;
+    }
+
+  switch (pred->type)
+    {
+    case T_PRED:
+      if (pred->pe.m_pred.bool_op != B_AND)
+	{
+	  return NO_ERROR;
+	}
+      error = batch_filter_compile_pred (filter, pred->pe.m_pred.lhs, attr_cache, vd);
+      if (error != NO_ERROR)
+	{
+	  return error;
+	}
+      return batch_filter_compile_pred (filter, pred->pe.m_pred.rhs, attr_cache, vd);
+
+    case T_EVAL_TERM:
+      if (pred->pe.m_eval_term.et_type == T_COMP_EVAL_TERM)
+	{
+	  return batch_filter_compile_comp (filter, &pred->pe.m_eval_term.et.et_comp, attr_cache, vd);
+	}
+      else if (pred->pe.m_eval_term.et_type == T_ALSM_EVAL_TERM)
+	{
+	  return batch_filter_compile_alsm (filter, &pred->pe.m_eval_term.et.et_alsm, attr_cache, vd);
+	}
+      return NO_ERROR;
+
+    default:
+      return NO_ERROR;
+    }
+}
+
+/*
+ * batch_filter_compile () - compile the simple terms of a data filter into a batch filter
+ *   return: error code
+ *   thread_p(in):
+ *   pred(in): data filter
+ *   attr_cache(in): attribute cache of the data filter, already started
+ *   vd(in): value descriptor of the query
+ *   filter_out(out): batch filter, or NULL if the data filter has no simple terms
+ */
+int
+batch_filter_compile (THREAD_ENTRY * thread_p, const PRED_EXPR * pred, HEAP_CACHE_ATTRINFO * attr_cache,
+		      VAL_DESCR * vd, BATCH_FILTER ** filter_out)
+{
+  OR_CLASSREP *classrep;
+  BATCH_FILTER *filter;
+  int error;
+
+  *filter_out = NULL;
+
+  if (pred == NULL || attr_cache == NULL || attr_cache->num_values <= 0 || attr_cache->last_classrepr == NULL)
+    {
+      return NO_ERROR;
+    }
+
+  classrep = attr_cache->last_classrepr;
+  filter = batch_filter_create (classrep->id, classrep->n_variable, classrep->fixed_length);
+  if (filter == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error);
+      return error;
+    }
+
+  error = batch_filter_compile_pred (filter, pred, attr_cache, vd);
+  if (error != NO_ERROR || filter->n_terms == 0)
+    {
+      batch_filter_destroy (filter);
+      return error;
+    }
+
+  *filter_out = filter;
+  return NO_ERROR;
+}
+
+/*
+ * batch_filter_decode () - decode the filter columns of a batch of records
+ *   return:
+ *   filter(in/out): batch filter
+ *   recdes(in): records
+ *   n_records(in): number of records, at most BATCH_FILTER_CAPACITY
+ */
+void
+batch_filter_decode (BATCH_FILTER * filter, const RECDES * recdes, int n_records)
+{
+  BATCH_FILTER_COLUMN *col;
+  DB_DATETIME datetime;
+  char *data, *fixed, *bound_bits;
+  bool has_bound_bits;
+  int i, c;
+
+  assert (n_records <= BATCH_FILTER_CAPACITY);
+
+  for (i = 0; i < n_records; i++)
+    {
+      data = recdes[i].data;
+      if (OR_GET_REPID (data) != filter->repr_id)
+	{
+	  /* attributes are elsewhere in other representations */
+	  filter->skip[i] = 1;
+	  for (c = 0; c < filter->n_columns; c++)
+	    {
+	      col = &filter->columns[c];
+	      col->is_null[i] = 0;
+	      if (col->type == DB_TYPE_DOUBLE)
+		{
+		  col->double_values[i] = 0;
+		}
+	      else
+		{
+		  col->int_values[i] = 0;
+		}
+	    }
+	  continue;
+	}
+
+      filter->skip[i] = 0;
+      fixed = data + OR_HEADER_SIZE (data) + OR_VAR_TABLE_SIZE_INTERNAL (filter->n_variable, OR_GET_OFFSET_SIZE (data));
+      bound_bits = fixed + filter->fixed_length;
+      has_bound_bits = OR_GET_BOUND_BIT_FLAG (data) != 0;
+
+      for (c = 0; c < filter->n_columns; c++)
+	{
+	  col = &filter->columns[c];
+	  col->is_null[i] = (has_bound_bits && !OR_GET_BOUND_BIT (bound_bits, col->position)) ? 1 : 0;
+
+	  switch (col->type)
+	    {
+	    case DB_TYPE_INTEGER:
+	    case DB_TYPE_DATE:
+	      /* DATE is an unsigned julian day */
+	      col->int_values[i] = (col->type == DB_TYPE_INTEGER) ? (INT64) OR_GET_INT (fixed + col->location)
+		: (INT64) (unsigned int) OR_GET_INT (fixed + col->location);
+	      break;
+	    case DB_TYPE_BIGINT:
+	      OR_GET_BIGINT (fixed + col->location, &col->int_values[i]);
+	      break;
+	    case DB_TYPE_DOUBLE:
+	      OR_GET_DOUBLE (fixed + col->location, &col->double_values[i]);
+	      break;
+	    case DB_TYPE_DATETIME:
+	      OR_GET_DATETIME (fixed + col->location, &datetime);
+	      col->int_values[i] = (INT64) datetime.date * MILLISECONDS_OF_ONE_DAY + datetime.time;
+	      break;
+	    default:
+	      assert (false);
+	      break;
+	    }
+	}
+    }
+}
+
+/*
+ * batch_filter_evaluate () - evaluate the terms of a batch filter over a decoded batch
+ *   return: number of selected records
+ *   filter(in): batch filter, decoded
+ *   n_records(in): number of decoded records
+ *   sel(out): 1 for records that may satisfy the data filter, 0 for records that cannot
+ *
+ * Note: NULL values never satisfy a term. Records that were not decoded are always selected.
+ */
+int
+batch_filter_evaluate (const BATCH_FILTER * filter, int n_records, unsigned char *sel)
+{
+  const BATCH_FILTER_TERM *term;
+  const BATCH_FILTER_COLUMN *col;
+  int t, i, k;
+  int count;
+
+  memset (sel, 1, n_records);
+
+  for (t = 0; t < filter->n_terms; t++)
+    {
+      term = &filter->terms[t];
+      col = &filter->columns[term->column];
+
+      if (term->op == BATCH_FILTER_IN)
+	{
+	  memset (filter->match, 0, n_records);
+	  for (k = 0; k < term->n_values; k++)
+	    {
+	      if (col->type == DB_TYPE_DOUBLE)
+		{
+		  BATCH_FILTER_MATCH_LOOP (col->double_values, term->double_values[k]);
+		}
+	      else
+		{
+		  BATCH_FILTER_MATCH_LOOP (col->int_values, term->int_values[k]);
+		}
+	    }
+	  BATCH_FILTER_CMP_LOOP (filter->match, !=, 0);
+	  continue;
+	}
+
+      if (col->type == DB_TYPE_DOUBLE)
+	{
+	  double constant = term->double_values[0];
+
+	  switch (term->op)
+	    {
+	    case BATCH_FILTER_EQ:
+	      BATCH_FILTER_CMP_LOOP (col->double_values, ==, constant);
+	      break;
+	    case BATCH_FILTER_NE:
+	      BATCH_FILTER_CMP_LOOP (col->double_values, !=, constant);
+	      break;
+	    case BATCH_FILTER_LT:
+	      BATCH_FILTER_CMP_LOOP (col->double_values, <, constant);
+	      break;
+	    case BATCH_FILTER_LE:
+	      BATCH_FILTER_CMP_LOOP (col->double_values, <=, constant);
+	      break;
+	    case BATCH_FILTER_GT:
+	      BATCH_FILTER_CMP_LOOP (col->double_values, >, constant);
+	      break;
+	    case BATCH_FILTER_GE:
+	      BATCH_FILTER_CMP_LOOP (col->double_values, >=, constant);
+	      break;
+	    default:
+	      assert (false);
+	      break;
+	    }
+	}
+      else
+	{
+	  INT64 constant = term->int_values[0];
+
+	  switch (term->op)
+	    {
+	    case BATCH_FILTER_EQ:
+	      BATCH_FILTER_CMP_LOOP (col->int_values, ==, constant);
+	      break;
+	    case BATCH_FILTER_NE:
+	      BATCH_FILTER_CMP_LOOP (col->int_values, !=, constant);
+	      break;
+	    case BATCH_FILTER_LT:
+	      BATCH_FILTER_CMP_LOOP (col->int_values, <, constant);
+	      break;
+	    case BATCH_FILTER_LE:
+	      BATCH_FILTER_CMP_LOOP (col->int_values, <=, constant);
+	      break;
+	    case BATCH_FILTER_GT:
+	      BATCH_FILTER_CMP_LOOP (col->int_values, >, constant);
+	      break;
+	    case BATCH_FILTER_GE:
+	      BATCH_FILTER_CMP_LOOP (col->int_values, >=, constant);
+	      break;
+	    default:
+	      assert (false);
+	      break;
+	    }
+	}
+    }
+
+  count = 0;
+  for (i = 0; i < n_records; i++)
+    {
+      count += sel[i];
+    }
+
+  return count;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+
+/*
+ * batch_filter.h - batch-at-a-time evaluation of simple scan predicates
+ */
+
+#ifndef _BATCH_FILTER_H_
+#define _BATCH_FILTER_H_
+
+#ident "$Id$"
+
+#if !defined (SERVER_MODE) && !defined (SA_MODE)
+#error Belongs to server module
+#endif /* !defined (SERVER_MODE) && !defined (SA_MODE) */
+
+#include "dbtype_def.h"
+#include "heap_attrinfo.h"
+#include "storage_common.h"
+#include "thread_compat.hpp"
+#include "xasl_predicate.hpp"
+
+struct val_descr;
+
+/* maximum number of records decoded and evaluated at once */
+#define BATCH_FILTER_CAPACITY 512
+
+/* maximum number of predicate terms handled by a batch filter */
+#define BATCH_FILTER_MAX_TERMS 16
+
+typedef enum
+{
+  BATCH_FILTER_EQ,
+  BATCH_FILTER_NE,
+  BATCH_FILTER_LT,
+  BATCH_FILTER_LE,
+  BATCH_FILTER_GT,
+  BATCH_FILTER_GE,
+  BATCH_FILTER_IN
+} BATCH_FILTER_OP;
+
+/* fixed width attribute decoded into a typed array */
+typedef struct batch_filter_column BATCH_FILTER_COLUMN;
+struct batch_filter_column
+{
+  DB_TYPE type;			/* INTEGER, BIGINT, DOUBLE, DATE or DATETIME */
+  int location;			/* offset among the fixed attributes */
+  int position;			/* bound bit position */
+  INT64 *int_values;		/* values of all types but DOUBLE; DATETIME as milliseconds */
+  double *double_values;	/* values of DOUBLE */
+  unsigned char *is_null;	/* 1 for unbound values */
+};
+
+/* attr op constant, or attr IN (constants) */
+typedef struct batch_filter_term BATCH_FILTER_TERM;
+struct batch_filter_term
+{
+  int column;			/* index of the column */
+  BATCH_FILTER_OP op;		/* comparison operator */
+  int n_values;			/* number of constants; one unless op is BATCH_FILTER_IN */
+  INT64 *int_values;		/* constants, same encoding as the column */
+  double *double_values;
+};
+
+/*
+ * Conjunction of simple terms of a data filter, evaluated over the records of a heap page at once.
+ * Records of other representations than repr_id are not decoded; they are "skipped", i.e. left
+ * selected for the regular evaluation.
+ */
+typedef struct batch_filter BATCH_FILTER;
+struct batch_filter
+{
+  REPR_ID repr_id;		/* representation of the decoded records */
+  int n_variable;		/* number of variable attributes of the representation */
+  int fixed_length;		/* total size of the fixed attributes of the representation */
+
+  int n_columns;
+  BATCH_FILTER_COLUMN columns[BATCH_FILTER_MAX_TERMS];
+  int n_terms;
+  BATCH_FILTER_TERM terms[BATCH_FILTER_MAX_TERMS];
+
+  unsigned char *skip;		/* 1 for records that were not decoded */
+  unsigned char *match;		/* scratch selection for IN terms */
+};
+
+extern BATCH_FILTER *batch_filter_create (REPR_ID repr_id, int n_variable, int fixed_length);
+extern void batch_filter_destroy (BATCH_FILTER * filter);
+extern int batch_filter_add_term (BATCH_FILTER * filter, DB_TYPE type, int location, int position,
+				  BATCH_FILTER_OP op, const DB_VALUE * values, int n_values);
+extern int batch_filter_compile (THREAD_ENTRY * thread_p, const PRED_EXPR * pred, HEAP_CACHE_ATTRINFO * attr_cache,
+				 struct val_descr *vd, BATCH_FILTER ** filter_out);
+
+extern void batch_filter_decode (BATCH_FILTER * filter, const RECDES * recdes, int n_records);
+extern int batch_filter_evaluate (const BATCH_FILTER * filter, int n_records, unsigned char *sel);
+
+#endif /* _BATCH_FILTER_H_ */
@@ -129,6 +129,7 @@
                          db_value_type(n) == DB_TYPE_NCHAR)
 
 static void do_set_trace_to_query_flag (QUERY_FLAG * query_flag);
+static QUERY_FLAG do_get_insert_query_flag (PARSER_CONTEXT * parser, PT_NODE * statement);
 static void do_send_plan_trace_to_session (PARSER_CONTEXT * parser);
 static int do_vacuum (PARSER_CONTEXT * parser, PT_NODE * statement);
 static int do_insert_checks (PARSER_CONTEXT * parser, PT_NODE * statement, PT_NODE ** class_,
@@ -13512,6 +13513,40 @@ cleanup:
   return error;
 }
 
+/*
+ * do_get_insert_query_flag () - Get the execution flag of the prepared INSERT statement
+ *   return: query flag
+ *   parser(in): Parser context
+ *   statement(in):
+ */
+static QUERY_FLAG
+do_get_insert_query_flag (PARSER_CONTEXT * parser, PT_NODE * statement)
+{
+  QUERY_FLAG query_flag;
+
+  query_flag = DEFAULT_EXEC_MODE;
+
+  query_flag |= NOT_FROM_RESULT_CACHE;
+  query_flag |= RESULT_CACHE_INHIBITED;
+
+  if (parser->return_generated_keys)
+    {
+      query_flag |= RETURN_GENERATED_KEYS;
+    }
+
+  if (parser->is_xasl_pinned_reference)
+    {
+      query_flag |= XASL_CACHE_PINNED_REFERENCE;
+    }
+
+  if (parser->is_auto_commit)
+    {
+      query_flag |= TRAN_AUTO_COMMIT;
+    }
+
+  return query_flag;
+}
+
 /*
  * do_execute_insert () - Execute the prepared INSERT statement
  *   return: Error code
@@ -13546,31 +13581,13 @@ do_execute_insert (PARSER_CONTEXT * parser, PT_NODE * statement)
   flat = statement->info.insert.spec->info.spec.flat_entity_list;
   class_obj = (flat) ? flat->info.name.db_object : NULL;
 
-  query_flag = DEFAULT_EXEC_MODE;
-
-  query_flag |= NOT_FROM_RESULT_CACHE;
-  query_flag |= RESULT_CACHE_INHIBITED;
-
-  if (parser->return_generated_keys)
-    {
-      query_flag |= RETURN_GENERATED_KEYS;
-    }
-
-  if (parser->is_xasl_pinned_reference)
-    {
-      query_flag |= XASL_CACHE_PINNED_REFERENCE;
-    }
+  query_flag = do_get_insert_query_flag (parser, statement);
 
   if (statement->use_auto_commit)
     {
       query_flag |= EXECUTE_QUERY_WITH_COMMIT;
     }
 
-  if (parser->is_auto_commit)
-    {
-      query_flag |= TRAN_AUTO_COMMIT;
-    }
-
   if (prm_get_bool_value (PRM_ID_QUERY_TRACE) == true && parser->query_trace == true)
     {
       do_set_trace_to_query_flag (&query_flag);
@@ -13621,6 +13638,40 @@ do_execute_insert (PARSER_CONTEXT * parser, PT_NODE * statement)
   return err;
 }
 
+/*
+ * do_execute_insert_array () - Execute the prepared INSERT statement once for each row of host variables, in the
+ *				server
+ *   return: Error code; the error that stopped the execution if less than n_rows were executed
+ *   parser(in): Parser context
+ *   statement(in): INSERT statement prepared in XASL cache
+ *   n_rows(in): number of rows
+ *   row_values(in): host variables and auto parameters of all rows, row after row
+ *   row_results(out): per row, number of inserted objects or error code
+ *   row_messages(out): per row, error message allocated with malloc, or NULL
+ *   n_executed(out): number of rows executed
+ *
+ * Note: Each row is a statement, as if the statement was executed for each row; the caller commits in auto-commit
+ *	 mode.
+ */
+int
+do_execute_insert_array (PARSER_CONTEXT * parser, PT_NODE * statement, int n_rows, const DB_VALUE * row_values,
+			 int *row_results, char **row_messages, int *n_executed)
+{
+  QUERY_FLAG query_flag;
+
+  assert (statement->node_type == PT_INSERT && statement->xasl_id != NULL);
+  assert (!parser->return_generated_keys);
+
+  *n_executed = 0;
+
+  CHECK_MODIFICATION_ERROR ();
+
+  query_flag = do_get_insert_query_flag (parser, statement);
+
+  return execute_query_array (statement->xasl_id, n_rows, parser->host_var_count + parser->auto_param_count,
+			      row_values, query_flag, row_results, row_messages, n_executed);
+}
+
 /*
  * Function Group:
  * Implement method calls
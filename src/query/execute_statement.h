@@ -104,6 +104,8 @@ extern int do_alter_user (const PARSER_CONTEXT * parser, const PT_NODE * stateme
 extern int do_insert (PARSER_CONTEXT * parser, PT_NODE * statement);
 extern int do_prepare_insert (PARSER_CONTEXT * parser, PT_NODE * statement);
 extern int do_execute_insert (PARSER_CONTEXT * parser, PT_NODE * statement);
+extern int do_execute_insert_array (PARSER_CONTEXT * parser, PT_NODE * statement, int n_rows,
+				    const DB_VALUE * row_values, int *row_results, char **row_messages, int *n_executed);
 
 extern int do_call_method (PARSER_CONTEXT * parser, PT_NODE * statement);
 extern void do_print_classname_on_method (DB_OBJECT * self, DB_VALUE * result);
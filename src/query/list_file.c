@@ -37,14 +37,19 @@
 #include "db_value_printer.hpp"
 #include "dbtype.h"
 #include "error_manager.h"
+#include "language_support.h"
 #include "log_append.hpp"
+#include "log_impl.h"
+#include "mvcc.h"
 #include "object_primitive.h"
+#include "perf_monitor.h"
 #include "query_manager.h"
 #include "query_opfunc.h"
 #include "stream_to_xasl.h"
 #include "thread_entry.hpp"
 #include "thread_manager.hpp"	// for thread_sleep
 #include "xasl.h"
+#include "xasl_cache.h"
 
 /* TODO */
 #if !defined (SERVER_MODE)
@@ -82,6 +87,60 @@ static int rv;
 typedef SCAN_CODE (*ADVANCE_FUCTION) (THREAD_ENTRY * thread_p, QFILE_LIST_SCAN_ID *, QFILE_TUPLE_RECORD *,
 				      QFILE_LIST_SCAN_ID *, QFILE_TUPLE_RECORD *, QFILE_TUPLE_VALUE_TYPE_LIST *);
 
+/* range of the hash numbers of the tuples of a hashed set operation */
+#define QFILE_HASH_SETOP_HASH_RANGE 0x7fffffff
+
+/* maximum number of partitions of a hashed set operation that does not fit in memory */
+#define QFILE_HASH_SETOP_MAX_PARTITIONS 256
+
+/* minimum number of buckets of the hash table of a hashed set operation */
+#define QFILE_HASH_SETOP_MIN_BUCKETS 1000
+
+/* distinct tuple of a hashed set operation; the tuple is allocated right after the entry */
+typedef struct qfile_hash_setop_entry QFILE_HASH_SETOP_ENTRY;
+struct qfile_hash_setop_entry
+{
+  QFILE_HASH_SETOP_ENTRY *next;	/* next entry of the bucket */
+  unsigned int hash;		/* hash number of the tuple */
+  bool is_matched;		/* the tuple was found in the probing list */
+  QFILE_TUPLE tpl;		/* copy of the tuple */
+};
+
+typedef struct qfile_hash_setop_state QFILE_HASH_SETOP_STATE;
+struct qfile_hash_setop_state
+{
+  int flag;			/* QFILE_FLAG_UNION, QFILE_FLAG_DIFFERENCE or QFILE_FLAG_INTERSECT */
+  QFILE_TUPLE_VALUE_TYPE_LIST *types;	/* domains to hash and compare the tuples of both lists with */
+  QFILE_LIST_ID *dest_list_p;	/* result list file */
+  QFILE_HASH_SETOP_ENTRY **buckets;	/* hash table of the building list */
+  unsigned int bucket_cnt;
+  unsigned int hash_divisor;	/* partition count; hash numbers of a partition are all equal modulo it */
+  bool insert_on_probe;		/* probing tuples that are not found are added to the hash table */
+  UINT64 mem_size;		/* size of the current hash table */
+  UINT64 max_mem_size;
+  UINT64 build_rows;
+  UINT64 probe_rows;
+};
+
+/* class that results of the list cache are made of */
+typedef struct qfile_list_cache_class QFILE_LIST_CACHE_CLASS;
+struct qfile_list_cache_class
+{
+  OID class_oid;		/* key of class_ht */
+  MVCCID max_mvccid;		/* highest MVCCID of committed transactions that modified the class */
+  int *ht_nos;			/* numbers of list_hts[] that cache results made of the class */
+  int n_ht_nos;
+  int max_ht_nos;
+};
+
+/* classes that results of a list_hts[] element are made of */
+typedef struct qfile_list_cache_ht_classes QFILE_LIST_CACHE_HT_CLASSES;
+struct qfile_list_cache_ht_classes
+{
+  QFILE_LIST_CACHE_CLASS **classes;
+  int n_classes;
+};
+
 /* query result(list file) cache related things */
 typedef struct qfile_list_cache QFILE_LIST_CACHE;
 struct qfile_list_cache
@@ -90,6 +149,10 @@ struct qfile_list_cache
   bool *ht_assigned;		/* flags denoting list_hts[] assignment */
   unsigned int n_hts;		/* number of elements of list_hts */
   unsigned int next_ht_no;	/* next no. of list_hts[] to be assigned */
+  QFILE_LIST_CACHE_HT_CLASSES *ht_classes;	/* array[n_hts] of classes the results of list_hts[] are made of */
+  MHT_TABLE *class_ht;		/* class OID to QFILE_LIST_CACHE_CLASS; reverse index of ht_classes */
+  QFILE_LIST_CACHE_ENTRY *lru_head;	/* most recently used entry */
+  QFILE_LIST_CACHE_ENTRY *lru_tail;	/* least recently used entry; first to be evicted */
   QFILE_LIST_CACHE_ENTRY **tran_list;	/* array[MAX_NTRANS] of list per trx */
   int n_entries;		/* total number of cache entries */
   int n_pages;			/* total number of pages used by the cache */
@@ -99,21 +162,6 @@ struct qfile_list_cache
   unsigned int full_counter;	/* counter of cache full & replacement */
 };
 
-typedef struct qfile_list_cache_candidate QFILE_LIST_CACHE_CANDIDATE;
-struct qfile_list_cache_candidate
-{
-  int total_num;		/* total number of cache entries */
-  int num_candidates;		/* number of candidates */
-  int num_victims;		/* number of victims */
-  int selcnt;
-  QFILE_LIST_CACHE_ENTRY **time_candidates;	/* candidates who are old aged */
-  QFILE_LIST_CACHE_ENTRY **ref_candidates;	/* candidates who are recently used */
-  QFILE_LIST_CACHE_ENTRY **victims;	/* victims; cache entries to be deleted */
-  int c_idx;
-  int v_idx;
-  bool include_in_use;
-};
-
 /* list cache entry pooling */
 #define FIXED_SIZE_OF_POOLED_LIST_CACHE_ENTRY   4096
 #define ADDITION_FOR_POOLED_LIST_CACHE_ENTRY    offsetof(QFILE_POOLED_LIST_CACHE_ENTRY, s.entry)
@@ -152,10 +200,7 @@ struct qfile_list_cache_entry_pool
  */
 
 /* list cache and related information */
-static QFILE_LIST_CACHE qfile_List_cache = { NULL, NULL, 0, 0, NULL, 0, 0, 0, 0, 0, 0 };
-
-/* information of candidates to be removed from XASL cache */
-static QFILE_LIST_CACHE_CANDIDATE qfile_List_cache_candidate = { 0, 0, 0, 0, NULL, NULL, NULL, 0, 0, false };
+static QFILE_LIST_CACHE qfile_List_cache = { NULL, NULL, 0, 0, NULL, NULL, NULL, NULL, NULL, 0, 0, 0, 0, 0, 0 };
 
 /* list cache entry pool */
 static QFILE_LIST_CACHE_ENTRY_POOL qfile_List_cache_entry_pool = { NULL, 0, 0 };
@@ -234,6 +279,14 @@ static void qfile_close_and_free_list_file (THREAD_ENTRY * thread_p, QFILE_LIST_
 
 static QFILE_LIST_ID *qfile_union_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id1, QFILE_LIST_ID * list_id2,
 					int flag);
+static int qfile_hash_setop_key (QFILE_TUPLE tpl, QFILE_TUPLE_VALUE_TYPE_LIST * types, unsigned int *hash_p);
+static int qfile_hash_setop_scan (THREAD_ENTRY * thread_p, QFILE_HASH_SETOP_STATE * state, QFILE_LIST_ID * list_id_p,
+				  bool is_probe);
+static void qfile_hash_setop_clear_table (THREAD_ENTRY * thread_p, QFILE_HASH_SETOP_STATE * state);
+static int qfile_hash_setop_pair (THREAD_ENTRY * thread_p, QFILE_HASH_SETOP_STATE * state, QFILE_LIST_ID * lhs_file_p,
+				  QFILE_LIST_ID * rhs_file_p);
+static int qfile_hash_setop_partition (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id_p,
+				       QFILE_TUPLE_VALUE_TYPE_LIST * types, QFILE_LIST_ID ** part_list, int part_cnt);
 
 static SORT_STATUS qfile_get_next_sort_item (THREAD_ENTRY * thread_p, RECDES * recdes, void *arg);
 static int qfile_put_next_sort_item (THREAD_ENTRY * thread_p, const RECDES * recdes, void *arg);
@@ -267,9 +320,18 @@ static void qfile_add_uncommitted_list_cache_entry (int tran_index, QFILE_LIST_C
 static void qfile_delete_uncommitted_list_cache_entry (int tran_index, QFILE_LIST_CACHE_ENTRY * lent);
 static int qfile_delete_list_cache_entry (THREAD_ENTRY * thread_p, void *data, void *args);
 static int qfile_end_use_of_list_cache_entry_local (THREAD_ENTRY * thread_p, void *data, void *args);
-static bool qfile_is_early_time (struct timeval *a, struct timeval *b);
-
-static int qfile_select_list_cache_entry (THREAD_ENTRY * thread_p, void *data, void *args);
+static int qfile_invalidate_list_cache_entry (THREAD_ENTRY * thread_p, void *data, void *args);
+static void qfile_lru_add_list_cache_entry (QFILE_LIST_CACHE_ENTRY * lent);
+static void qfile_lru_remove_list_cache_entry (QFILE_LIST_CACHE_ENTRY * lent);
+static bool qfile_evict_list_cache_entries (THREAD_ENTRY * thread_p, MHT_TABLE * ht, int page_cnt);
+static QFILE_LIST_CACHE_CLASS *qfile_get_list_cache_class (const OID * class_oid);
+static int qfile_free_list_cache_class (const void *key, void *data, void *args);
+static int qfile_register_list_cache_classes (int list_ht_no, const XCACHE_RELATED_OBJECT * related_objects,
+					      int n_related_objects);
+static void qfile_unregister_list_cache_classes (int list_ht_no);
+#if defined(SERVER_MODE)
+static bool qfile_is_list_cache_visible (int list_ht_no, const MVCC_SNAPSHOT * snapshot);
+#endif /* SERVER_MODE */
 
 static int qfile_get_list_cache_entry_size_for_allocate (int nparam);
 #if defined(SERVER_MODE)
@@ -2719,220 +2781,826 @@ error:
 }
 
 /*
- * qfile_copy_tuple_descr_to_tuple () - generate a tuple into a tuple record
- *                                      structure from a tuple descriptor
- *   return: NO_ERROR or error code
- *   thread_p(in): thread
- *   tpl_descr(in): tuple descriptor
- *   tpl_rec(in): tuple record
+ * qfile_can_hash_combine () - check whether two list files can be combined
+ *			       by qfile_hash_combine_two_list ()
+ *   return: bool
+ *   lhs_file(in): pointer to a QFILE_LIST_ID for one of the input files
+ *   rhs_file(in): pointer to a QFILE_LIST_ID for the other input file, or NULL
+ *   flag(in): the kind of combination, as for qfile_combine_two_list ()
  *
- * NOTE: tpl_rec's fields will be private_alloc'd by this function and it's the
- * caller's resposability to properly dispose the memory
+ * Note: Only the DISTINCT variants are hashed. Tuples of both lists are hashed
+ *	 column by column, so every column must have a type that gives equal
+ *	 hash numbers to values that compare equal: integers, date/time, OIDs
+ *	 and strings of a binary collation.
  */
-int
-qfile_copy_tuple_descr_to_tuple (THREAD_ENTRY * thread_p, QFILE_TUPLE_DESCRIPTOR * tpl_descr,
-				 QFILE_TUPLE_RECORD * tplrec)
+bool
+qfile_can_hash_combine (QFILE_LIST_ID * lhs_file_p, QFILE_LIST_ID * rhs_file_p, int flag)
 {
-  char *tuple_p;
-  int i, size;
-
-  assert (tpl_descr != NULL && tplrec != NULL);
+  TP_DOMAIN *lhs_dom, *rhs_dom, *dom;
+  DB_TYPE lhs_type, rhs_type;
+  int i;
 
-  /* alloc tuple record with tuple descriptor footprint */
-  tplrec->size = tpl_descr->tpl_size;
-  tplrec->tpl = (char *) db_private_alloc (thread_p, tplrec->size);
-  if (tplrec->tpl == NULL)
+  if (rhs_file_p == NULL || !QFILE_IS_FLAG_SET (flag, QFILE_FLAG_DISTINCT)
+      || prm_get_bigint_value (PRM_ID_MAX_HASH_SET_OP_SIZE) == 0)
     {
-      return ER_FAILED;
+      return false;
     }
 
-  /* put length */
-  QFILE_PUT_TUPLE_LENGTH (tplrec->tpl, tplrec->size);
-  tuple_p = tplrec->tpl + QFILE_TUPLE_LENGTH_SIZE;
+  if (lhs_file_p->type_list.type_cnt != rhs_file_p->type_list.type_cnt)
+    {
+      return false;
+    }
 
-  /* build tuple */
-  for (i = 0; i < tpl_descr->f_cnt; i++)
+  for (i = 0; i < lhs_file_p->type_list.type_cnt; i++)
     {
-      if (qdata_copy_db_value_to_tuple_value (tpl_descr->f_valp[i], !(tpl_descr->clear_f_val_at_clone_decache[i]),
-					      tuple_p, &size) != NO_ERROR)
+      lhs_dom = lhs_file_p->type_list.domp[i];
+      rhs_dom = rhs_file_p->type_list.domp[i];
+      lhs_type = TP_DOMAIN_TYPE (lhs_dom);
+      rhs_type = TP_DOMAIN_TYPE (rhs_dom);
+
+      /* columns of these types hold NULL values only */
+      if (lhs_type == DB_TYPE_NULL || lhs_type == DB_TYPE_VARIABLE)
 	{
-	  /* error has already been set */
-	  db_private_free_and_init (thread_p, tplrec->tpl);
-	  return ER_FAILED;
+	  dom = rhs_dom;
+	}
+      else if (rhs_type == DB_TYPE_NULL || rhs_type == DB_TYPE_VARIABLE)
+	{
+	  dom = lhs_dom;
+	}
+      else if (lhs_type != rhs_type)
+	{
+	  return false;
+	}
+      else
+	{
+	  if (TP_TYPE_HAS_COLLATION (lhs_type)
+	      && (TP_DOMAIN_COLLATION (lhs_dom) != TP_DOMAIN_COLLATION (rhs_dom)
+		  || TP_DOMAIN_COLLATION_FLAG (rhs_dom) != TP_DOMAIN_COLL_NORMAL))
+	    {
+	      return false;
+	    }
+	  dom = lhs_dom;
 	}
-      tuple_p += size;
 
-      assert (tuple_p <= tplrec->tpl + tplrec->size);
+      switch (TP_DOMAIN_TYPE (dom))
+	{
+	case DB_TYPE_NULL:
+	case DB_TYPE_VARIABLE:
+	case DB_TYPE_INTEGER:
+	case DB_TYPE_SMALLINT:
+	case DB_TYPE_BIGINT:
+	case DB_TYPE_DATE:
+	case DB_TYPE_TIME:
+	case DB_TYPE_TIMESTAMP:
+	case DB_TYPE_DATETIME:
+	case DB_TYPE_OID:
+	  break;
+
+	case DB_TYPE_CHAR:
+	case DB_TYPE_VARCHAR:
+	case DB_TYPE_NCHAR:
+	case DB_TYPE_VARNCHAR:
+	  /* strings are hashed by their bytes, trailing spaces ignored */
+	  if (TP_DOMAIN_COLLATION_FLAG (dom) != TP_DOMAIN_COLL_NORMAL
+	      || !(LANG_IS_COERCIBLE_COLL (TP_DOMAIN_COLLATION (dom)) || TP_DOMAIN_COLLATION (dom) == LANG_COLL_BINARY))
+	    {
+	      return false;
+	    }
+	  break;
+
+	default:
+	  /* numeric scale, float signed zero, sets, lobs, ... hash equal values differently */
+	  return false;
+	}
     }
 
-  /* all ok */
-  return NO_ERROR;
+  return true;
 }
 
+/*
+ * qfile_hash_setop_key () - compute the hash number of all the columns of a tuple
+ *   return: NO_ERROR, or ER_code
+ *   tpl(in)    : list file tuple
+ *   types(in)  : column domains
+ *   hash_p(out)        : hash number
+ *
+ * Note: NULL values hash as zero; a set operation takes them as equal.
+ */
 static int
-qfile_copy_tuple (THREAD_ENTRY * thread_p, QFILE_LIST_ID * to_list_id_p, QFILE_LIST_ID * from_list_id_p)
+qfile_hash_setop_key (QFILE_TUPLE tpl, QFILE_TUPLE_VALUE_TYPE_LIST * types, unsigned int *hash_p)
 {
-  QFILE_LIST_SCAN_ID scan_id;
-  QFILE_TUPLE_RECORD tuple_record = { NULL, 0 };
-  SCAN_CODE qp_scan;
+  OR_BUF buf;
+  DB_VALUE dbval;
+  char *tuple_p;
+  unsigned int hash = 0, value_hash;
+  int length, i;
 
-  /* scan through the first list file and add the tuples to the result list file. */
-  if (qfile_open_list_scan (from_list_id_p, &scan_id) != NO_ERROR)
-    {
-      return ER_FAILED;
-    }
+  tuple_p = (char *) tpl + QFILE_TUPLE_LENGTH_SIZE;
 
-  while (true)
+  for (i = 0; i < types->type_cnt; i++)
     {
-      qp_scan = qfile_scan_list_next (thread_p, &scan_id, &tuple_record, PEEK);
-      if (qp_scan != S_SUCCESS)
-	{
-	  break;
-	}
+      length = QFILE_GET_TUPLE_VALUE_LENGTH (tuple_p);
 
-      if (qfile_add_tuple_to_list (thread_p, to_list_id_p, tuple_record.tpl) != NO_ERROR)
+      /* zero length means NULL */
+      value_hash = 0;
+      if (length > 0)
 	{
-	  qfile_close_scan (thread_p, &scan_id);
-	  return ER_FAILED;
-	}
-    }
+	  /* do not copy the value; it is only hashed */
+	  PRIM_SET_NULL (&dbval);
+	  or_init (&buf, tuple_p + QFILE_TUPLE_VALUE_HEADER_SIZE, length);
+	  if (types->domp[i]->type->data_readval (&buf, &dbval, types->domp[i], -1, false, NULL, 0) != NO_ERROR)
+	    {
+	      return ER_FAILED;
+	    }
 
-  qfile_close_scan (thread_p, &scan_id);
+	  value_hash = mht_get_hash_number (QFILE_HASH_SETOP_HASH_RANGE, &dbval);
 
-  if (qp_scan != S_END)
-    {
-      return ER_FAILED;
+	  if (DB_NEED_CLEAR (&dbval))
+	    {
+	      pr_clear_value (&dbval);
+	    }
+	}
+
+      hash = ((hash << 5) | (hash >> 27)) ^ value_hash;
+      tuple_p += QFILE_TUPLE_VALUE_HEADER_SIZE + length;
     }
 
-  return NO_ERROR;
-}
+  *hash_p = hash;
 
-static void
-qfile_close_and_free_list_file (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id)
-{
-  qfile_close_list (thread_p, list_id);
-  QFILE_FREE_AND_INIT_LIST_ID (list_id);
+  return NO_ERROR;
 }
 
 /*
- * qfile_union_list () -
- * 	 return: IST_ID *, or NULL
- *   list_id1(in): First list file identifier
- * 	 list_id2(in): Second list file identifier
- * 	 flag(in):
+ * qfile_hash_setop_scan () - put the tuples of a list file into the hash
+ *			      table, or look them up in it
+ *   return: NO_ERROR, or ER_code
+ *   state(in/out)      : hashed set operation state
+ *   list_id(in)        : list file to scan
+ *   is_probe(in)       : false to build the hash table, true to probe it
  *
- * Note: This routine takes the union of two list files by getting the
- *              tuples of the both list files and generates a new list file.
- *              The source list files are not affected.
+ * Note: A tuple is added to the table only if no equal tuple is there yet, so
+ *	 the table holds distinct tuples. Added tuples go to the result list
+ *	 for UNION, and for probing tuples that state->insert_on_probe lets in.
+ *	 Found probing tuples mark their entries, and go to the result list for
+ *	 INTERSECT on the first match.
  */
-static QFILE_LIST_ID *
-qfile_union_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id1_p, QFILE_LIST_ID * list_id2_p, int flag)
+static int
+qfile_hash_setop_scan (THREAD_ENTRY * thread_p, QFILE_HASH_SETOP_STATE * state, QFILE_LIST_ID * list_id_p,
+		       bool is_probe)
 {
-  QFILE_LIST_ID *result_list_id_p, *base, *tail;
+  QFILE_LIST_SCAN_ID scan_id;
+  QFILE_TUPLE_RECORD tuple_record = { NULL, 0 };
+  QFILE_HASH_SETOP_ENTRY *entry;
+  SCAN_CODE scan;
+  unsigned int hash, bucket;
+  int tpl_len, cmp;
 
-  if (list_id1_p->tuple_cnt == 0)
-    {
-      base = list_id2_p;
-      tail = NULL;
-    }
-  else if (list_id2_p->tuple_cnt == 0)
-    {
-      base = list_id1_p;
-      tail = NULL;
-    }
-  else
+  if (qfile_open_list_scan (list_id_p, &scan_id) != NO_ERROR)
     {
-      base = list_id1_p;
-      tail = list_id2_p;
+      return ER_FAILED;
     }
 
-  result_list_id_p = qfile_clone_list_id (base, false);
-  if (result_list_id_p == NULL)
+  while ((scan = qfile_scan_list_next (thread_p, &scan_id, &tuple_record, PEEK)) == S_SUCCESS)
     {
-      return NULL;
-    }
+      if (qfile_hash_setop_key (tuple_record.tpl, state->types, &hash) != NO_ERROR)
+	{
+	  scan = S_ERROR;
+	  break;
+	}
 
-  if (tail != NULL)
-    {
-      if (qfile_reopen_list_as_append_mode (thread_p, result_list_id_p) != NO_ERROR)
+      if (is_probe)
 	{
-	  goto error;
+	  state->probe_rows++;
 	}
 
-      if (qfile_unify_types (result_list_id_p, tail) != NO_ERROR)
+      bucket = (hash / state->hash_divisor) % state->bucket_cnt;
+      for (entry = state->buckets[bucket]; entry != NULL; entry = entry->next)
 	{
-	  goto error;
+	  if (entry->hash != hash)
+	    {
+	      continue;
+	    }
+	  if (qfile_compare_tuple_helper (entry->tpl, tuple_record.tpl, state->types, &cmp) != NO_ERROR)
+	    {
+	      scan = S_ERROR;
+	      break;
+	    }
+	  if (cmp == 0)
+	    {
+	      break;
+	    }
 	}
 
-      if (qfile_copy_tuple (thread_p, result_list_id_p, tail) != NO_ERROR)
+      if (scan == S_ERROR)
 	{
-	  goto error;
+	  break;
 	}
 
-      qfile_close_list (thread_p, result_list_id_p);
+      if (entry != NULL)
+	{
+	  if (is_probe && !entry->is_matched)
+	    {
+	      entry->is_matched = true;
+	      if (QFILE_IS_FLAG_SET (state->flag, QFILE_FLAG_INTERSECT)
+		  && qfile_add_tuple_to_list (thread_p, state->dest_list_p, entry->tpl) != NO_ERROR)
+		{
+		  scan = S_ERROR;
+		  break;
+		}
+	    }
+	  continue;
+	}
+
+      if (is_probe && !state->insert_on_probe)
+	{
+	  continue;
+	}
+
+      /* the peeked tuple lives in the scan page; keep a copy */
+      tpl_len = QFILE_GET_TUPLE_LENGTH (tuple_record.tpl);
+      entry = (QFILE_HASH_SETOP_ENTRY *) db_private_alloc (thread_p, sizeof (QFILE_HASH_SETOP_ENTRY) + tpl_len);
+      if (entry == NULL)
+	{
+	  scan = S_ERROR;
+	  break;
+	}
+      entry->tpl = (QFILE_TUPLE) (entry + 1);
+      memcpy (entry->tpl, tuple_record.tpl, tpl_len);
+      entry->hash = hash;
+      entry->is_matched = is_probe;
+
+      entry->next = state->buckets[bucket];
+      state->buckets[bucket] = entry;
+
+      state->build_rows++;
+      state->mem_size += sizeof (QFILE_HASH_SETOP_ENTRY) + tpl_len;
+
+      if ((is_probe || QFILE_IS_FLAG_SET (state->flag, QFILE_FLAG_UNION))
+	  && qfile_add_tuple_to_list (thread_p, state->dest_list_p, entry->tpl) != NO_ERROR)
+	{
+	  scan = S_ERROR;
+	  break;
+	}
     }
 
-  /* clear base list_id to prevent double free of tfile_vfid */
-  qfile_clear_list_id (base);
+  qfile_close_scan (thread_p, &scan_id);
 
-  return result_list_id_p;
+  state->max_mem_size = MAX (state->max_mem_size, state->mem_size);
 
-error:
-  qfile_close_list (thread_p, result_list_id_p);
-  qfile_free_list_id (result_list_id_p);
-  return NULL;
+  return (scan == S_ERROR) ? ER_FAILED : NO_ERROR;
 }
 
 /*
- * qfile_reallocate_tuple () - reallocates a tuple to the desired size.
- *              If it cant, it sets an error and returns 0
- *   return: nt 1 succes, 0 failure
- *   tplrec(in): tuple descriptor
- * 	 tpl_size(in): desired size
- * 	 file(in):
- *   line(in):
- *
+ * qfile_hash_setop_clear_table () - free the hash table of a hashed set operation
+ *   return:
+ *   state(in/out)      : hashed set operation state
  */
-int
-qfile_reallocate_tuple (QFILE_TUPLE_RECORD * tuple_record_p, int tuple_size)
+static void
+qfile_hash_setop_clear_table (THREAD_ENTRY * thread_p, QFILE_HASH_SETOP_STATE * state)
 {
-  QFILE_TUPLE tuple;
+  QFILE_HASH_SETOP_ENTRY *entry, *next;
+  unsigned int i;
 
-  if (tuple_record_p->size == 0)
+  if (state->buckets == NULL)
     {
-      tuple_record_p->tpl = (QFILE_TUPLE) db_private_alloc (NULL, tuple_size);
+      return;
     }
-  else
+
+  for (i = 0; i < state->bucket_cnt; i++)
     {
-      /*
-       * Don't leak the original tuple if we get a malloc failure!
-       */
-      tuple = (QFILE_TUPLE) db_private_realloc (NULL, tuple_record_p->tpl, tuple_size);
-      if (tuple == NULL)
+      for (entry = state->buckets[i]; entry != NULL; entry = next)
 	{
-	  db_private_free_and_init (NULL, tuple_record_p->tpl);
+	  next = entry->next;
+	  db_private_free (thread_p, entry);
 	}
-      tuple_record_p->tpl = tuple;
-    }
-
-  if (tuple_record_p->tpl == NULL)
-    {
-      return ER_FAILED;
     }
 
-  tuple_record_p->size = tuple_size;
-
-  return NO_ERROR;
+  db_private_free_and_init (thread_p, state->buckets);
+  state->bucket_cnt = 0;
+  state->mem_size = 0;
 }
 
-#if defined (CUBRID_DEBUG)
 /*
- * qfile_print_list () - Dump the content of the list file to the standard output
- *   return: none
- *   list_id(in): List File Identifier
+ * qfile_hash_setop_pair () - combine two list files through a hash table
+ *   return: NO_ERROR, or ER_code
+ *   state(in/out)      : hashed set operation state
+ *   lhs_file(in)       : left list file
+ *   rhs_file(in)       : right list file
+ *
+ * Note: The hash table is built from the smaller list and the other list
+ *	 probes it:
+ *	 UNION: both lists are added; the result is the content of the table.
+ *	 INTERSECT: the probing tuples found in the table are the result.
+ *	 DIFFERENCE, built from the left list: the entries that no right tuple
+ *	 matched are the result.
+ *	 DIFFERENCE, built from the right list: the left tuples that are not
+ *	 found are added to the table and are the result.
  */
-void
-qfile_print_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id_p)
+static int
+qfile_hash_setop_pair (THREAD_ENTRY * thread_p, QFILE_HASH_SETOP_STATE * state, QFILE_LIST_ID * lhs_file_p,
+		       QFILE_LIST_ID * rhs_file_p)
+{
+  QFILE_LIST_ID *build_list_p, *probe_list_p;
+  QFILE_HASH_SETOP_ENTRY *entry;
+  bool is_build_lhs;
+  UINT64 bucket_cnt;
+  unsigned int i;
+  int error = NO_ERROR;
+
+  assert (state->buckets == NULL);
+
+  if (lhs_file_p->tuple_cnt == 0 && (rhs_file_p->tuple_cnt == 0 || !QFILE_IS_FLAG_SET (state->flag, QFILE_FLAG_UNION)))
+    {
+      /* nothing to add to the result */
+      return NO_ERROR;
+    }
+  if (rhs_file_p->tuple_cnt == 0 && QFILE_IS_FLAG_SET (state->flag, QFILE_FLAG_INTERSECT))
+    {
+      return NO_ERROR;
+    }
+
+  is_build_lhs = (lhs_file_p->page_cnt <= rhs_file_p->page_cnt);
+  build_list_p = is_build_lhs ? lhs_file_p : rhs_file_p;
+  probe_list_p = is_build_lhs ? rhs_file_p : lhs_file_p;
+
+  state->insert_on_probe = (QFILE_IS_FLAG_SET (state->flag, QFILE_FLAG_UNION)
+			    || (QFILE_IS_FLAG_SET (state->flag, QFILE_FLAG_DIFFERENCE) && !is_build_lhs));
+
+  bucket_cnt = build_list_p->tuple_cnt + (state->insert_on_probe ? probe_list_p->tuple_cnt : 0);
+  state->bucket_cnt = (unsigned int) MIN (MAX (bucket_cnt, QFILE_HASH_SETOP_MIN_BUCKETS), INT_MAX / 8);
+  state->buckets =
+    (QFILE_HASH_SETOP_ENTRY **) db_private_alloc (thread_p, state->bucket_cnt * sizeof (QFILE_HASH_SETOP_ENTRY *));
+  if (state->buckets == NULL)
+    {
+      return ER_FAILED;
+    }
+  memset (state->buckets, 0, state->bucket_cnt * sizeof (QFILE_HASH_SETOP_ENTRY *));
+  state->mem_size = state->bucket_cnt * sizeof (QFILE_HASH_SETOP_ENTRY *);
+
+  error = qfile_hash_setop_scan (thread_p, state, build_list_p, false);
+  if (error == NO_ERROR)
+    {
+      error = qfile_hash_setop_scan (thread_p, state, probe_list_p, true);
+    }
+
+  if (error == NO_ERROR && QFILE_IS_FLAG_SET (state->flag, QFILE_FLAG_DIFFERENCE) && is_build_lhs)
+    {
+      for (i = 0; i < state->bucket_cnt && error == NO_ERROR; i++)
+	{
+	  for (entry = state->buckets[i]; entry != NULL; entry = entry->next)
+	    {
+	      if (!entry->is_matched)
+		{
+		  error = qfile_add_tuple_to_list (thread_p, state->dest_list_p, entry->tpl);
+		  if (error != NO_ERROR)
+		    {
+		      break;
+		    }
+		}
+	    }
+	}
+    }
+
+  qfile_hash_setop_clear_table (thread_p, state);
+
+  return error;
+}
+
+/*
+ * qfile_hash_setop_partition () - distribute the tuples of a list file to
+ *				   partitions by the hash of the tuple
+ *   return: NO_ERROR, or ER_code
+ *   list_id(in)        : list file to partition
+ *   types(in)  : column domains to hash the tuples with
+ *   part_list(out)     : part_cnt partition list files
+ *   part_cnt(in)       : partitions count
+ */
+static int
+qfile_hash_setop_partition (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id_p, QFILE_TUPLE_VALUE_TYPE_LIST * types,
+			    QFILE_LIST_ID ** part_list, int part_cnt)
+{
+  QFILE_LIST_SCAN_ID scan_id;
+  QFILE_TUPLE_RECORD tuple_record = { NULL, 0 };
+  SCAN_CODE scan;
+  unsigned int hash;
+  int p;
+
+  for (p = 0; p < part_cnt; p++)
+    {
+      part_list[p] = qfile_open_list (thread_p, &list_id_p->type_list, NULL, list_id_p->query_id, 0);
+      if (part_list[p] == NULL)
+	{
+	  return ER_FAILED;
+	}
+    }
+
+  if (qfile_open_list_scan (list_id_p, &scan_id) != NO_ERROR)
+    {
+      return ER_FAILED;
+    }
+
+  while ((scan = qfile_scan_list_next (thread_p, &scan_id, &tuple_record, PEEK)) == S_SUCCESS)
+    {
+      if (qfile_hash_setop_key (tuple_record.tpl, types, &hash) != NO_ERROR)
+	{
+	  scan = S_ERROR;
+	  break;
+	}
+
+      if (qfile_add_tuple_to_list (thread_p, part_list[hash % part_cnt], tuple_record.tpl) != NO_ERROR)
+	{
+	  scan = S_ERROR;
+	  break;
+	}
+    }
+
+  qfile_close_scan (thread_p, &scan_id);
+
+  for (p = 0; p < part_cnt; p++)
+    {
+      qfile_close_list (thread_p, part_list[p]);
+    }
+
+  return (scan == S_ERROR) ? ER_FAILED : NO_ERROR;
+}
+
+/*
+ * qfile_hash_combine_two_list () -
+ *   return: QFILE_LIST_ID *, or NULL
+ *   lhs_file(in): pointer to a QFILE_LIST_ID for one of the input files
+ *   rhs_file(in): pointer to a QFILE_LIST_ID for the other input file
+ *   flag(in): {QFILE_FLAG_UNION, QFILE_FLAG_DIFFERENCE, QFILE_FLAG_INTERSECT}
+ *             with QFILE_FLAG_DISTINCT
+ *   stats(out): hashed set operation trace statistics, or NULL
+ *
+ * Note: Same as qfile_combine_two_list (), but the input lists are not sorted;
+ * the distinct tuples of the smaller list are put into an in-memory hash table
+ * and the other list is streamed through it. If the table would be larger than
+ * max_hash_set_op_size, both lists are first split into partitions by the hash
+ * of the tuples and each pair of partitions is combined the same way. The
+ * result is not sorted.
+ *
+ * Note: The caller checks qfile_can_hash_combine () first.
+ */
+QFILE_LIST_ID *
+qfile_hash_combine_two_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * lhs_file_p, QFILE_LIST_ID * rhs_file_p, int flag,
+			     HASHSETOP_STATS * stats)
+{
+  QFILE_LIST_ID *dest_list_id_p = NULL;
+  QFILE_LIST_ID **lhs_part_list = NULL, **rhs_part_list = NULL;
+  QFILE_HASH_SETOP_STATE state;
+  UINT64 mem_limit, table_size;
+  int part_cnt = 0;
+  int p;
+
+  assert (rhs_file_p != NULL && QFILE_IS_FLAG_SET (flag, QFILE_FLAG_DISTINCT));
+
+  memset (&state, 0, sizeof (QFILE_HASH_SETOP_STATE));
+  state.flag = flag;
+  state.hash_divisor = 1;
+
+  dest_list_id_p = qfile_open_list (thread_p, &lhs_file_p->type_list, NULL, lhs_file_p->query_id, flag);
+  if (dest_list_id_p == NULL)
+    {
+      goto error;
+    }
+
+  if (qfile_unify_types (dest_list_id_p, rhs_file_p) != NO_ERROR)
+    {
+      goto error;
+    }
+
+  /* both lists are hashed and compared with the domains of the result, like the sorted lists are merged */
+  state.types = &dest_list_id_p->type_list;
+  state.dest_list_p = dest_list_id_p;
+
+  mem_limit = prm_get_bigint_value (PRM_ID_MAX_HASH_SET_OP_SIZE);
+  if (QFILE_IS_FLAG_SET (flag, QFILE_FLAG_INTERSECT))
+    {
+      table_size = (UINT64) MIN (lhs_file_p->page_cnt, rhs_file_p->page_cnt) * DB_PAGESIZE;
+    }
+  else if (QFILE_IS_FLAG_SET (flag, QFILE_FLAG_DIFFERENCE))
+    {
+      /* the left tuples are added to the table if it is built from the right list */
+      table_size = (UINT64) lhs_file_p->page_cnt * DB_PAGESIZE;
+      if (rhs_file_p->page_cnt < lhs_file_p->page_cnt)
+	{
+	  table_size += (UINT64) rhs_file_p->page_cnt * DB_PAGESIZE;
+	}
+    }
+  else
+    {
+      table_size = (UINT64) (lhs_file_p->page_cnt + rhs_file_p->page_cnt) * DB_PAGESIZE;
+    }
+
+  if (table_size <= mem_limit)
+    {
+      if (qfile_hash_setop_pair (thread_p, &state, lhs_file_p, rhs_file_p) != NO_ERROR)
+	{
+	  goto error;
+	}
+    }
+  else
+    {
+      /* aim at partitions of half the memory budget, since the hash table costs more than the list pages */
+      part_cnt = (int) MIN (table_size * 2 / mem_limit + 1, QFILE_HASH_SETOP_MAX_PARTITIONS);
+      state.hash_divisor = part_cnt;
+
+      lhs_part_list = (QFILE_LIST_ID **) db_private_alloc (thread_p, part_cnt * sizeof (QFILE_LIST_ID *));
+      rhs_part_list = (QFILE_LIST_ID **) db_private_alloc (thread_p, part_cnt * sizeof (QFILE_LIST_ID *));
+      if (lhs_part_list == NULL || rhs_part_list == NULL)
+	{
+	  goto error;
+	}
+      memset (lhs_part_list, 0, part_cnt * sizeof (QFILE_LIST_ID *));
+      memset (rhs_part_list, 0, part_cnt * sizeof (QFILE_LIST_ID *));
+
+      if (qfile_hash_setop_partition (thread_p, lhs_file_p, state.types, lhs_part_list, part_cnt) != NO_ERROR
+	  || qfile_hash_setop_partition (thread_p, rhs_file_p, state.types, rhs_part_list, part_cnt) != NO_ERROR)
+	{
+	  goto error;
+	}
+
+      for (p = 0; p < part_cnt; p++)
+	{
+	  if (qfile_hash_setop_pair (thread_p, &state, lhs_part_list[p], rhs_part_list[p]) != NO_ERROR)
+	    {
+	      goto error;
+	    }
+
+	  /* this pair of partitions is done; release its pages before the next one */
+	  qfile_destroy_list (thread_p, lhs_part_list[p]);
+	  QFILE_FREE_AND_INIT_LIST_ID (lhs_part_list[p]);
+	  qfile_destroy_list (thread_p, rhs_part_list[p]);
+	  QFILE_FREE_AND_INIT_LIST_ID (rhs_part_list[p]);
+	}
+    }
+
+  qfile_close_list (thread_p, dest_list_id_p);
+
+end:
+  if (stats != NULL)
+    {
+      stats->run_hashsetop = true;
+      stats->build_rows += state.build_rows;
+      stats->probe_rows += state.probe_rows;
+      stats->mem_size = MAX (stats->mem_size, state.max_mem_size);
+      stats->partitions = MAX (stats->partitions, part_cnt);
+    }
+
+  qfile_hash_setop_clear_table (thread_p, &state);
+
+  for (p = 0; p < part_cnt; p++)
+    {
+      if (lhs_part_list != NULL && lhs_part_list[p] != NULL)
+	{
+	  qfile_close_list (thread_p, lhs_part_list[p]);
+	  qfile_destroy_list (thread_p, lhs_part_list[p]);
+	  QFILE_FREE_AND_INIT_LIST_ID (lhs_part_list[p]);
+	}
+      if (rhs_part_list != NULL && rhs_part_list[p] != NULL)
+	{
+	  qfile_close_list (thread_p, rhs_part_list[p]);
+	  qfile_destroy_list (thread_p, rhs_part_list[p]);
+	  QFILE_FREE_AND_INIT_LIST_ID (rhs_part_list[p]);
+	}
+    }
+  if (lhs_part_list)
+    {
+      db_private_free_and_init (thread_p, lhs_part_list);
+    }
+  if (rhs_part_list)
+    {
+      db_private_free_and_init (thread_p, rhs_part_list);
+    }
+
+  return dest_list_id_p;
+
+error:
+  if (dest_list_id_p)
+    {
+      qfile_close_list (thread_p, dest_list_id_p);
+      qfile_destroy_list (thread_p, dest_list_id_p);
+      QFILE_FREE_AND_INIT_LIST_ID (dest_list_id_p);
+    }
+  goto end;
+}
+
+/*
+ * qfile_copy_tuple_descr_to_tuple () - generate a tuple into a tuple record
+ *                                      structure from a tuple descriptor
+ *   return: NO_ERROR or error code
+ *   thread_p(in): thread
+ *   tpl_descr(in): tuple descriptor
+ *   tpl_rec(in): tuple record
+ *
+ * NOTE: tpl_rec's fields will be private_alloc'd by this function and it's the
+ * caller's resposability to properly dispose the memory
+ */
+int
+qfile_copy_tuple_descr_to_tuple (THREAD_ENTRY * thread_p, QFILE_TUPLE_DESCRIPTOR * tpl_descr,
+				 QFILE_TUPLE_RECORD * tplrec)
+{
+  char *tuple_p;
+  int i, size;
+
+  assert (tpl_descr != NULL && tplrec != NULL);
+
+  /* alloc tuple record with tuple descriptor footprint */
+  tplrec->size = tpl_descr->tpl_size;
+  tplrec->tpl = (char *) db_private_alloc (thread_p, tplrec->size);
+  if (tplrec->tpl == NULL)
+    {
+      return ER_FAILED;
+    }
+
+  /* put length */
+  QFILE_PUT_TUPLE_LENGTH (tplrec->tpl, tplrec->size);
+  tuple_p = tplrec->tpl + QFILE_TUPLE_LENGTH_SIZE;
+
+  /* build tuple */
+  for (i = 0; i < tpl_descr->f_cnt; i++)
+    {
+      if (qdata_copy_db_value_to_tuple_value (tpl_descr->f_valp[i], !(tpl_descr->clear_f_val_at_clone_decache[i]),
+					      tuple_p, &size) != NO_ERROR)
+	{
+	  /* error has already been set */
+	  db_private_free_and_init (thread_p, tplrec->tpl);
+	  return ER_FAILED;
+	}
+      tuple_p += size;
+
+      assert (tuple_p <= tplrec->tpl + tplrec->size);
+    }
+
+  /* all ok */
+  return NO_ERROR;
+}
+
+static int
+qfile_copy_tuple (THREAD_ENTRY * thread_p, QFILE_LIST_ID * to_list_id_p, QFILE_LIST_ID * from_list_id_p)
+{
+  QFILE_LIST_SCAN_ID scan_id;
+  QFILE_TUPLE_RECORD tuple_record = { NULL, 0 };
+  SCAN_CODE qp_scan;
+
+  /* scan through the first list file and add the tuples to the result list file. */
+  if (qfile_open_list_scan (from_list_id_p, &scan_id) != NO_ERROR)
+    {
+      return ER_FAILED;
+    }
+
+  while (true)
+    {
+      qp_scan = qfile_scan_list_next (thread_p, &scan_id, &tuple_record, PEEK);
+      if (qp_scan != S_SUCCESS)
+	{
+	  break;
+	}
+
+      if (qfile_add_tuple_to_list (thread_p, to_list_id_p, tuple_record.tpl) != NO_ERROR)
+	{
+	  qfile_close_scan (thread_p, &scan_id);
+	  return ER_FAILED;
+	}
+    }
+
+  qfile_close_scan (thread_p, &scan_id);
+
+  if (qp_scan != S_END)
+    {
+      return ER_FAILED;
+    }
+
+  return NO_ERROR;
+}
+
+static void
+qfile_close_and_free_list_file (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id)
+{
+  qfile_close_list (thread_p, list_id);
+  QFILE_FREE_AND_INIT_LIST_ID (list_id);
+}
+
+/*
+ * qfile_union_list () -
+ * 	 return: IST_ID *, or NULL
+ *   list_id1(in): First list file identifier
+ * 	 list_id2(in): Second list file identifier
+ * 	 flag(in):
+ *
+ * Note: This routine takes the union of two list files by getting the
+ *              tuples of the both list files and generates a new list file.
+ *              The source list files are not affected.
+ */
+static QFILE_LIST_ID *
+qfile_union_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id1_p, QFILE_LIST_ID * list_id2_p, int flag)
+{
+  QFILE_LIST_ID *result_list_id_p, *base, *tail;
+
+  if (list_id1_p->tuple_cnt == 0)
+    {
+      base = list_id2_p;
+      tail = NULL;
+    }
+  else if (list_id2_p->tuple_cnt == 0)
+    {
+      base = list_id1_p;
+      tail = NULL;
+    }
+  else
+    {
+      base = list_id1_p;
+      tail = list_id2_p;
+    }
+
+  result_list_id_p = qfile_clone_list_id (base, false);
+  if (result_list_id_p == NULL)
+    {
+      return NULL;
+    }
+
+  if (tail != NULL)
+    {
+      if (qfile_reopen_list_as_append_mode (thread_p, result_list_id_p) != NO_ERROR)
+	{
+	  goto error;
+	}
+
+      if (qfile_unify_types (result_list_id_p, tail) != NO_ERROR)
+	{
+	  goto error;
+	}
+
+      if (qfile_copy_tuple (thread_p, result_list_id_p, tail) != NO_ERROR)
+	{
+	  goto error;
+	}
+
+      qfile_close_list (thread_p, result_list_id_p);
+    }
+
+  /* clear base list_id to prevent double free of tfile_vfid */
+  qfile_clear_list_id (base);
+
+  return result_list_id_p;
+
+error:
+  qfile_close_list (thread_p, result_list_id_p);
+  qfile_free_list_id (result_list_id_p);
+  return NULL;
+}
+
+/*
+ * qfile_reallocate_tuple () - reallocates a tuple to the desired size.
+ *              If it cant, it sets an error and returns 0
+ *   return: nt 1 succes, 0 failure
+ *   tplrec(in): tuple descriptor
+ * 	 tpl_size(in): desired size
+ * 	 file(in):
+ *   line(in):
+ *
+ */
+int
+qfile_reallocate_tuple (QFILE_TUPLE_RECORD * tuple_record_p, int tuple_size)
+{
+  QFILE_TUPLE tuple;
+
+  if (tuple_record_p->size == 0)
+    {
+      tuple_record_p->tpl = (QFILE_TUPLE) db_private_alloc (NULL, tuple_size);
+    }
+  else
+    {
+      /*
+       * Don't leak the original tuple if we get a malloc failure!
+       */
+      tuple = (QFILE_TUPLE) db_private_realloc (NULL, tuple_record_p->tpl, tuple_size);
+      if (tuple == NULL)
+	{
+	  db_private_free_and_init (NULL, tuple_record_p->tpl);
+	}
+      tuple_record_p->tpl = tuple;
+    }
+
+  if (tuple_record_p->tpl == NULL)
+    {
+      return ER_FAILED;
+    }
+
+  tuple_record_p->size = tuple_size;
+
+  return NO_ERROR;
+}
+
+#if defined (CUBRID_DEBUG)
+/*
+ * qfile_print_list () - Dump the content of the list file to the standard output
+ *   return: none
+ *   list_id(in): List File Identifier
+ */
+void
+qfile_print_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id_p)
 {
   QFILE_LIST_SCAN_ID scan_id;
   QFILE_TUPLE_RECORD tuple_record = { NULL, 0 };
@@ -4215,6 +4883,11 @@ qfile_scan_next (THREAD_ENTRY * thread_p, QFILE_LIST_SCAN_ID * scan_id_p)
 	  scan_id_p->curr_tpl = (char *) scan_id_p->curr_pgptr + QFILE_PAGE_HEADER_SIZE;
 	  scan_id_p->curr_tplno = 0;
 	  scan_id_p->position = S_ON;
+
+	  /* let page buffer read the following pages while this one is scanned */
+	  VPID_SET_NULL (&scan_id_p->read_ahead_vpid);
+	  QFILE_GET_NEXT_VPID (&next_vpid, page_p);
+	  pgbuf_read_ahead (thread_p, &next_vpid, &scan_id_p->read_ahead_vpid);
 	  return S_SUCCESS;
 	}
       else
@@ -4246,6 +4919,9 @@ qfile_scan_next (THREAD_ENTRY * thread_p, QFILE_LIST_SCAN_ID * scan_id_p)
 	  scan_id_p->curr_tplno = 0;
 	  scan_id_p->curr_offset = QFILE_PAGE_HEADER_SIZE;
 	  scan_id_p->curr_tpl = (char *) scan_id_p->curr_pgptr + QFILE_PAGE_HEADER_SIZE;
+
+	  QFILE_GET_NEXT_VPID (&next_vpid, next_page_p);
+	  pgbuf_read_ahead (thread_p, &next_vpid, &scan_id_p->read_ahead_vpid);
 	  return S_SUCCESS;
 	}
       else
@@ -4549,6 +5225,7 @@ qfile_open_list_scan (QFILE_LIST_ID * list_id_p, QFILE_LIST_SCAN_ID * scan_id_p)
   scan_id_p->keep_page_on_finish = 0;
   scan_id_p->curr_vpid.pageid = NULL_PAGEID;
   scan_id_p->curr_vpid.volid = NULL_VOLID;
+  VPID_SET_NULL (&scan_id_p->read_ahead_vpid);
   QFILE_CLEAR_LIST_ID (&scan_id_p->list_id);
 
   if (qfile_copy_list_id (&scan_id_p->list_id, list_id_p, true) != NO_ERROR)
@@ -4804,9 +5481,11 @@ qfile_initialize_list_cache (THREAD_ENTRY * thread_p)
 	  (void) mht_map_no_key (thread_p, qfile_List_cache.list_hts[i], qfile_free_list_cache_entry,
 				 qfile_List_cache.list_hts[i]);
 	  (void) mht_clear (qfile_List_cache.list_hts[i], NULL, NULL);
+	  qfile_unregister_list_cache_classes (i);
 	}
       (void) memset (qfile_List_cache.ht_assigned, 0, sizeof (bool) * qfile_List_cache.n_hts);
       qfile_List_cache.next_ht_no = 0;
+      (void) mht_clear (qfile_List_cache.class_ht, qfile_free_list_cache_class, NULL);
     }
   else
     {
@@ -4835,7 +5514,23 @@ qfile_initialize_list_cache (THREAD_ENTRY * thread_p)
 	  goto error;
 	}
       qfile_List_cache.next_ht_no = 0;
+
+      qfile_List_cache.ht_classes =
+	(QFILE_LIST_CACHE_HT_CLASSES *) calloc (qfile_List_cache.n_hts, sizeof (QFILE_LIST_CACHE_HT_CLASSES));
+      if (qfile_List_cache.ht_classes == NULL)
+	{
+	  goto error;
+	}
+
+      qfile_List_cache.class_ht =
+	mht_create ("list file cache (class OID)", qfile_List_cache.n_hts, oid_hash, oid_compare_equals);
+      if (qfile_List_cache.class_ht == NULL)
+	{
+	  goto error;
+	}
     }
+  qfile_List_cache.lru_head = NULL;
+  qfile_List_cache.lru_tail = NULL;
 
   /* list of entries per transaction */
   if (qfile_List_cache.tran_list)
@@ -4899,6 +5594,20 @@ error:
   qfile_List_cache_entry_pool.n_entries = 0;
   qfile_List_cache_entry_pool.free_list = -1;
 
+  if (qfile_List_cache.class_ht)
+    {
+      (void) mht_clear (qfile_List_cache.class_ht, qfile_free_list_cache_class, NULL);
+      mht_destroy (qfile_List_cache.class_ht);
+      qfile_List_cache.class_ht = NULL;
+    }
+  if (qfile_List_cache.ht_classes)
+    {
+      for (i = 0; i < qfile_List_cache.n_hts; i++)
+	{
+	  free_and_init (qfile_List_cache.ht_classes[i].classes);
+	}
+      free_and_init (qfile_List_cache.ht_classes);
+    }
   if (qfile_List_cache.ht_assigned)
     {
       free_and_init (qfile_List_cache.ht_assigned);
@@ -4945,9 +5654,13 @@ qfile_finalize_list_cache (THREAD_ENTRY * thread_p)
 	  (void) mht_map_no_key (thread_p, qfile_List_cache.list_hts[i], qfile_free_list_cache_entry,
 				 qfile_List_cache.list_hts[i]);
 	  mht_destroy (qfile_List_cache.list_hts[i]);
+	  qfile_unregister_list_cache_classes (i);
 	}
       free_and_init (qfile_List_cache.list_hts);
     }
+  qfile_List_cache.n_hts = 0;
+  qfile_List_cache.lru_head = NULL;
+  qfile_List_cache.lru_tail = NULL;
 
   if (qfile_List_cache.tran_list)
     {
@@ -4959,6 +5672,18 @@ qfile_finalize_list_cache (THREAD_ENTRY * thread_p)
       free_and_init (qfile_List_cache.ht_assigned);
     }
 
+  if (qfile_List_cache.ht_classes)
+    {
+      free_and_init (qfile_List_cache.ht_classes);
+    }
+
+  if (qfile_List_cache.class_ht)
+    {
+      (void) mht_clear (qfile_List_cache.class_ht, qfile_free_list_cache_class, NULL);
+      mht_destroy (qfile_List_cache.class_ht);
+      qfile_List_cache.class_ht = NULL;
+    }
+
   /* list cache entry pool */
   if (qfile_List_cache_entry_pool.pool)
     {
@@ -5056,6 +5781,7 @@ qfile_clear_list_cache (THREAD_ENTRY * thread_p, int list_ht_no, bool release)
   /* release assigned memory hash table */
   if (release)
     {
+      qfile_unregister_list_cache_classes (list_ht_no);
       qfile_List_cache.ht_assigned[list_ht_no] = false;
       qfile_List_cache.next_ht_no = list_ht_no;
     }
@@ -5440,92 +6166,481 @@ qfile_delete_uncommitted_list_cache_entry (int tran_index, QFILE_LIST_CACHE_ENTR
 }
 
 /*
- * qfile_delete_list_cache_entry () - Delete a list cache entry
- *                               Can be used by mht_map_no_key() function
+ * qfile_delete_list_cache_entry () - Delete a list cache entry
+ *                               Can be used by mht_map_no_key() function
+ *   return:
+ *   data(in/out)   :
+ *   args(in)   : not used
+ */
+static int
+qfile_delete_list_cache_entry (THREAD_ENTRY * thread_p, void *data, void *args)
+{
+  /* this function should be called within CSECT_QPROC_LIST_CACHE */
+  QFILE_LIST_CACHE_ENTRY *lent = (QFILE_LIST_CACHE_ENTRY *) data;
+  int error_code = ER_FAILED;
+
+  if (data == NULL)
+    {
+      return ER_FAILED;
+    }
+
+  /* mark it to be deleted */
+  lent->deletion_marker = true;
+#if defined(SERVER_MODE)
+  if (lent->deletion_marker && lent->last_ta_idx == 0)
+#else /* not SERVER_MODE */
+  if (lent->deletion_marker)
+#endif /* not SERVER_MODE */
+    {
+      /* update counter */
+      qfile_List_cache.n_entries--;
+      qfile_List_cache.n_pages -= lent->list_id.page_cnt;
+
+      /* remove the entry from the hash table */
+      if (mht_rem2 (qfile_List_cache.list_hts[lent->list_ht_no], &lent->param_values, lent, NULL, NULL) != NO_ERROR)
+	{
+	  if (!lent->deletion_marker)
+	    {
+	      char *s = NULL;
+
+	      if (lent->param_values.size > 0)
+		{
+		  s = pr_valstring (&lent->param_values.vals[0]);
+		}
+
+	      er_log_debug (ARG_FILE_LINE,
+			    "ls_delete_list_cache_ent: mht_rem failed for param_values { %d %s ...}\n",
+			    lent->param_values.size, s ? s : "(null)");
+	      if (s)
+		{
+		  db_private_free (thread_p, s);
+		}
+	    }
+	}
+
+      /* destroy the temp file of XASL_ID */
+      if (!VFID_ISNULL (&lent->list_id.temp_vfid) && file_temp_retire (thread_p, &lent->list_id.temp_vfid) != NO_ERROR)
+	{
+	  er_log_debug (ARG_FILE_LINE, "ls_delete_list_cache_ent: fl_destroy failed for vfid { %d %d }\n",
+			lent->list_id.temp_vfid.fileid, lent->list_id.temp_vfid.volid);
+	}
+
+      /* clear list_id */
+      qfile_clear_list_id (&lent->list_id);
+
+      /* remove from the list of uncommitted entries in the transaction which made it */
+#if defined(SERVER_MODE)
+      if (lent->uncommitted_marker && qfile_List_cache.tran_list[lent->tran_index])
+	{
+	  qfile_delete_uncommitted_list_cache_entry (lent->tran_index, lent);
+	}
+#endif /* SERVER_MODE */
+      qfile_lru_remove_list_cache_entry (lent);
+      error_code = qfile_free_list_cache_entry (thread_p, lent, NULL);
+    }
+
+  return error_code;
+}
+
+/*
+ * qfile_end_use_of_list_cache_entry_local () -
+ *   return:
+ *   data(in)   :
+ *   args(in)   :
+ */
+static int
+qfile_end_use_of_list_cache_entry_local (THREAD_ENTRY * thread_p, void *data, void *args)
+{
+  return qfile_end_use_of_list_cache_entry (thread_p, (QFILE_LIST_CACHE_ENTRY *) data, *((bool *) args));
+}
+
+/*
+ * qfile_invalidate_list_cache_entry () - Delete a list cache entry which is made of a modified class
+ *                               Can be used by mht_map_no_key() function
+ *   return:
+ *   data(in/out)   :
+ *   args(in/out)   : counter of invalidated entries
+ *
+ * Note: An entry in use is only marked; it is deleted when it is no longer used.
+ */
+static int
+qfile_invalidate_list_cache_entry (THREAD_ENTRY * thread_p, void *data, void *args)
+{
+  /* this function should be called within CSECT_QPROC_LIST_CACHE */
+  QFILE_LIST_CACHE_ENTRY *lent = (QFILE_LIST_CACHE_ENTRY *) data;
+
+  if (!lent->deletion_marker)
+    {
+      (*(int *) args)++;
+    }
+  (void) qfile_delete_list_cache_entry (thread_p, lent, NULL);
+
+  /* continue with next entries */
+  return NO_ERROR;
+}
+
+/*
+ * qfile_lru_add_list_cache_entry () - Add the entry to the head of LRU list
+ *   return:
+ *   lent(in/out)   :
+ */
+static void
+qfile_lru_add_list_cache_entry (QFILE_LIST_CACHE_ENTRY * lent)
+{
+  /* this function should be called within CSECT_QPROC_LIST_CACHE */
+  assert (lent->lru_prev == NULL && lent->lru_next == NULL);
+
+  lent->lru_next = qfile_List_cache.lru_head;
+  if (qfile_List_cache.lru_head != NULL)
+    {
+      qfile_List_cache.lru_head->lru_prev = lent;
+    }
+  else
+    {
+      qfile_List_cache.lru_tail = lent;
+    }
+  qfile_List_cache.lru_head = lent;
+}
+
+/*
+ * qfile_lru_remove_list_cache_entry () - Remove the entry from LRU list, if it is there
+ *   return:
+ *   lent(in/out)   :
+ */
+static void
+qfile_lru_remove_list_cache_entry (QFILE_LIST_CACHE_ENTRY * lent)
+{
+  /* this function should be called within CSECT_QPROC_LIST_CACHE */
+  if (lent->lru_prev != NULL)
+    {
+      lent->lru_prev->lru_next = lent->lru_next;
+    }
+  else if (qfile_List_cache.lru_head == lent)
+    {
+      qfile_List_cache.lru_head = lent->lru_next;
+    }
+
+  if (lent->lru_next != NULL)
+    {
+      lent->lru_next->lru_prev = lent->lru_prev;
+    }
+  else if (qfile_List_cache.lru_tail == lent)
+    {
+      qfile_List_cache.lru_tail = lent->lru_prev;
+    }
+
+  lent->lru_prev = NULL;
+  lent->lru_next = NULL;
+}
+
+/*
+ * qfile_evict_list_cache_entries () - Evict least recently used entries until a new entry fits in the list cache
+ *   return: true if the new entry fits, false otherwise
+ *   ht(in)     : memory hash table of the new entry
+ *   page_cnt(in)       : number of pages of the new entry
+ *
+ * Note: Entries that are in use are not evicted.
+ */
+static bool
+qfile_evict_list_cache_entries (THREAD_ENTRY * thread_p, MHT_TABLE * ht, int page_cnt)
+{
+  /* this function should be called within CSECT_QPROC_LIST_CACHE */
+  QFILE_LIST_CACHE_ENTRY *lent, *lru_prev;
+  int max_entries, max_pages;
+
+  max_entries = prm_get_integer_value (PRM_ID_LIST_MAX_QUERY_CACHE_ENTRIES);
+  max_pages = prm_get_integer_value (PRM_ID_LIST_MAX_QUERY_CACHE_PAGES);
+
+  if (page_cnt > max_pages)
+    {
+      /* would not fit in an empty cache */
+      return false;
+    }
+
+  if ((int) mht_count (ht) < max_entries && qfile_List_cache.n_entries < max_entries
+      && qfile_List_cache.n_pages + page_cnt <= max_pages)
+    {
+      return true;
+    }
+
+  qfile_List_cache.full_counter++;	/* counter */
+
+  for (lent = qfile_List_cache.lru_tail; lent != NULL; lent = lru_prev)
+    {
+      lru_prev = lent->lru_prev;
+
+#if defined(SERVER_MODE)
+      if (lent->last_ta_idx > 0)
+	{
+	  /* do not evict one that is in use */
+	  continue;
+	}
+#endif /* SERVER_MODE */
+
+      (void) qfile_delete_list_cache_entry (thread_p, lent, NULL);
+      perfmon_inc_stat (thread_p, PSTAT_QRC_NUM_EVICT);
+
+      if ((int) mht_count (ht) < max_entries && qfile_List_cache.n_entries < max_entries
+	  && qfile_List_cache.n_pages + page_cnt <= max_pages)
+	{
+	  return true;
+	}
+    }
+
+  return false;
+}
+
+/*
+ * qfile_get_list_cache_class () - Find the class in the reverse index of list cache, or add it
+ *   return: class of list cache, NULL on error
+ *   class_oid(in)      :
+ */
+static QFILE_LIST_CACHE_CLASS *
+qfile_get_list_cache_class (const OID * class_oid)
+{
+  /* this function should be called within CSECT_QPROC_LIST_CACHE */
+  QFILE_LIST_CACHE_CLASS *cls;
+
+  cls = (QFILE_LIST_CACHE_CLASS *) mht_get (qfile_List_cache.class_ht, class_oid);
+  if (cls != NULL)
+    {
+      return cls;
+    }
+
+  cls = (QFILE_LIST_CACHE_CLASS *) malloc (sizeof (QFILE_LIST_CACHE_CLASS));
+  if (cls == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (QFILE_LIST_CACHE_CLASS));
+      return NULL;
+    }
+  COPY_OID (&cls->class_oid, class_oid);
+  cls->max_mvccid = MVCCID_NULL;
+  cls->ht_nos = NULL;
+  cls->n_ht_nos = 0;
+  cls->max_ht_nos = 0;
+
+  if (mht_put (qfile_List_cache.class_ht, &cls->class_oid, cls) == NULL)
+    {
+      free_and_init (cls);
+      return NULL;
+    }
+
+  return cls;
+}
+
+/*
+ * qfile_free_list_cache_class () - Free a class of list cache
+ *                              Can be used by mht_clear() function
+ *   return:
+ *   key(in)    :
+ *   data(in)   :
+ *   args(in)   :
+ */
+static int
+qfile_free_list_cache_class (const void *key, void *data, void *args)
+{
+  QFILE_LIST_CACHE_CLASS *cls = (QFILE_LIST_CACHE_CLASS *) data;
+
+  if (cls->ht_nos != NULL)
+    {
+      free_and_init (cls->ht_nos);
+    }
+  free_and_init (cls);
+
+  return NO_ERROR;
+}
+
+/*
+ * qfile_register_list_cache_classes () - Register the classes that results of the hash table are made of
+ *   return: error code
+ *   list_ht_no(in)     :
+ *   related_objects(in)        : objects referenced by XASL cache entry of the hash table
+ *   n_related_objects(in)      :
+ */
+static int
+qfile_register_list_cache_classes (int list_ht_no, const XCACHE_RELATED_OBJECT * related_objects,
+				   int n_related_objects)
+{
+  /* this function should be called within CSECT_QPROC_LIST_CACHE */
+  QFILE_LIST_CACHE_HT_CLASSES *ht_classes = &qfile_List_cache.ht_classes[list_ht_no];
+  QFILE_LIST_CACHE_CLASS *cls;
+  int *ht_nos;
+  int i;
+
+  assert (ht_classes->n_classes == 0 && ht_classes->classes == NULL);
+
+  if (n_related_objects <= 0)
+    {
+      return NO_ERROR;
+    }
+
+  ht_classes->classes = (QFILE_LIST_CACHE_CLASS **) malloc (n_related_objects * sizeof (QFILE_LIST_CACHE_CLASS *));
+  if (ht_classes->classes == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      n_related_objects * sizeof (QFILE_LIST_CACHE_CLASS *));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  for (i = 0; i < n_related_objects; i++)
+    {
+      cls = qfile_get_list_cache_class (&related_objects[i].oid);
+      if (cls == NULL)
+	{
+	  goto error;
+	}
+
+      if (cls->n_ht_nos == cls->max_ht_nos)
+	{
+	  ht_nos = (int *) realloc (cls->ht_nos, (cls->max_ht_nos + 8) * sizeof (int));
+	  if (ht_nos == NULL)
+	    {
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+		      (cls->max_ht_nos + 8) * sizeof (int));
+	      goto error;
+	    }
+	  cls->ht_nos = ht_nos;
+	  cls->max_ht_nos += 8;
+	}
+
+      cls->ht_nos[cls->n_ht_nos++] = list_ht_no;
+      ht_classes->classes[ht_classes->n_classes++] = cls;
+    }
+
+  return NO_ERROR;
+
+error:
+  qfile_unregister_list_cache_classes (list_ht_no);
+  return ER_FAILED;
+}
+
+/*
+ * qfile_unregister_list_cache_classes () - Remove the hash table from the reverse index of list cache
  *   return:
- *   data(in/out)   :
- *   args(in)   :
+ *   list_ht_no(in)     :
  */
-static int
-qfile_delete_list_cache_entry (THREAD_ENTRY * thread_p, void *data, void *args)
+static void
+qfile_unregister_list_cache_classes (int list_ht_no)
 {
   /* this function should be called within CSECT_QPROC_LIST_CACHE */
-  QFILE_LIST_CACHE_ENTRY *lent = (QFILE_LIST_CACHE_ENTRY *) data;
-  int tran_index;
-  int error_code = ER_FAILED;
+  QFILE_LIST_CACHE_HT_CLASSES *ht_classes;
+  QFILE_LIST_CACHE_CLASS *cls;
+  int i, j;
 
-  if (data == NULL || args == NULL)
+  if (qfile_List_cache.ht_classes == NULL)
     {
-      return ER_FAILED;
+      return;
     }
 
-  tran_index = *((int *) args);
-
-  /* mark it to be deleted */
-  lent->deletion_marker = true;
-#if defined(SERVER_MODE)
-  if (lent->deletion_marker && lent->last_ta_idx == 0)
-#else /* not SERVER_MODE */
-  if (lent->deletion_marker)
-#endif /* not SERVER_MODE */
+  ht_classes = &qfile_List_cache.ht_classes[list_ht_no];
+  for (i = 0; i < ht_classes->n_classes; i++)
     {
-      /* update counter */
-      qfile_List_cache.n_entries--;
-      qfile_List_cache.n_pages -= lent->list_id.page_cnt;
-
-      /* remove the entry from the hash table */
-      if (mht_rem2 (qfile_List_cache.list_hts[lent->list_ht_no], &lent->param_values, lent, NULL, NULL) != NO_ERROR)
+      cls = ht_classes->classes[i];
+      for (j = 0; j < cls->n_ht_nos; j++)
 	{
-	  if (!lent->deletion_marker)
+	  if (cls->ht_nos[j] == list_ht_no)
 	    {
-	      char *s = NULL;
-
-	      if (lent->param_values.size > 0)
-		{
-		  s = pr_valstring (&lent->param_values.vals[0]);
-		}
-
-	      er_log_debug (ARG_FILE_LINE,
-			    "ls_delete_list_cache_ent: mht_rem failed for param_values { %d %s ...}\n",
-			    lent->param_values.size, s ? s : "(null)");
-	      if (s)
-		{
-		  db_private_free (thread_p, s);
-		}
+	      cls->ht_nos[j] = cls->ht_nos[--cls->n_ht_nos];
+	      break;
 	    }
 	}
+    }
 
-      /* destroy the temp file of XASL_ID */
-      if (!VFID_ISNULL (&lent->list_id.temp_vfid) && file_temp_retire (thread_p, &lent->list_id.temp_vfid) != NO_ERROR)
-	{
-	  er_log_debug (ARG_FILE_LINE, "ls_delete_list_cache_ent: fl_destroy failed for vfid { %d %d }\n",
-			lent->list_id.temp_vfid.fileid, lent->list_id.temp_vfid.volid);
-	}
+  if (ht_classes->classes != NULL)
+    {
+      free_and_init (ht_classes->classes);
+    }
+  ht_classes->n_classes = 0;
+}
 
-      /* clear list_id */
-      qfile_clear_list_id (&lent->list_id);
+#if defined(SERVER_MODE)
+/*
+ * qfile_is_list_cache_visible () - Can results of the hash table be shared with the snapshot?
+ *   return: true if the snapshot sees all committed changes to the classes of the results
+ *   list_ht_no(in)     :
+ *   snapshot(in)       : MVCC snapshot
+ *
+ * Note: All transactions before the lowest active one of the snapshot are completed. A result made with, or given to,
+ *       a snapshot that does not see a committed change to its classes could differ from what the snapshot would
+ *       read, so it must not be shared.
+ */
+static bool
+qfile_is_list_cache_visible (int list_ht_no, const MVCC_SNAPSHOT * snapshot)
+{
+  /* this function should be called within CSECT_QPROC_LIST_CACHE */
+  QFILE_LIST_CACHE_HT_CLASSES *ht_classes = &qfile_List_cache.ht_classes[list_ht_no];
+  MVCCID max_mvccid;
+  int i;
 
-      /* remove from the list of uncommitted entries in the transaction */
-      if (qfile_List_cache.tran_list[tran_index])
+  for (i = 0; i < ht_classes->n_classes; i++)
+    {
+      max_mvccid = ht_classes->classes[i]->max_mvccid;
+      if (MVCCID_IS_VALID (max_mvccid) && !MVCC_ID_PRECEDES (max_mvccid, snapshot->lowest_active_mvccid))
 	{
-	  qfile_delete_uncommitted_list_cache_entry (tran_index, lent);
+	  return false;
 	}
-      error_code = qfile_free_list_cache_entry (thread_p, lent, NULL);
     }
 
-  return error_code;
+  return true;
 }
+#endif /* SERVER_MODE */
 
 /*
- * qfile_end_use_of_list_cache_entry_local () -
- *   return:
- *   data(in)   :
- *   args(in)   :
+ * qfile_clear_list_cache_by_class () - Invalidate cached results that are made of the class
+ *   return: error code
+ *   class_oid(in)      : class modified by a committing transaction
+ *   mvccid(in) : MVCCID of the transaction
+ *
+ * Note: The MVCCID is remembered for the class. Until the transaction is seen as completed by all snapshots, the
+ *       results made of the class are not shared; see qfile_is_list_cache_visible ().
  */
-static int
-qfile_end_use_of_list_cache_entry_local (THREAD_ENTRY * thread_p, void *data, void *args)
+int
+qfile_clear_list_cache_by_class (THREAD_ENTRY * thread_p, const OID * class_oid, MVCCID mvccid)
 {
-  return qfile_end_use_of_list_cache_entry (thread_p, (QFILE_LIST_CACHE_ENTRY *) data, *((bool *) args));
+  QFILE_LIST_CACHE_CLASS *cls;
+  int n_invalidated = 0;
+  int i;
+
+  if (QFILE_IS_LIST_CACHE_DISABLED)
+    {
+      return ER_FAILED;
+    }
+  if (qfile_List_cache.n_hts == 0)
+    {
+      return ER_FAILED;
+    }
+
+  if (csect_enter (thread_p, CSECT_QPROC_LIST_CACHE, INF_WAIT) != NO_ERROR)
+    {
+      return ER_FAILED;
+    }
+
+  cls = qfile_get_list_cache_class (class_oid);
+  if (cls == NULL)
+    {
+      csect_exit (thread_p, CSECT_QPROC_LIST_CACHE);
+      return ER_FAILED;
+    }
+
+  if (MVCC_ID_PRECEDES (cls->max_mvccid, mvccid))
+    {
+      cls->max_mvccid = mvccid;
+    }
+
+  for (i = 0; i < cls->n_ht_nos; i++)
+    {
+      (void) mht_map_no_key (thread_p, qfile_List_cache.list_hts[cls->ht_nos[i]], qfile_invalidate_list_cache_entry,
+			     &n_invalidated);
+    }
+
+  csect_exit (thread_p, CSECT_QPROC_LIST_CACHE);
+
+  if (n_invalidated > 0)
+    {
+      perfmon_add_stat (thread_p, PSTAT_QRC_NUM_INVALIDATE, n_invalidated);
+    }
+
+  return NO_ERROR;
 }
 
 /*
@@ -5542,9 +6657,10 @@ QFILE_LIST_CACHE_ENTRY *
 qfile_lookup_list_cache_entry (THREAD_ENTRY * thread_p, int list_ht_no, const DB_VALUE_ARRAY * params)
 {
   QFILE_LIST_CACHE_ENTRY *lent;
-  int tran_index;
 #if defined(SERVER_MODE)
+  int tran_index;
   TRAN_ISOLATION tran_isolation;
+  MVCC_SNAPSHOT *snapshot;
 #if defined(WINDOWS)
   unsigned int num_elements;
 #else
@@ -5564,12 +6680,18 @@ qfile_lookup_list_cache_entry (THREAD_ENTRY * thread_p, int list_ht_no, const DB
       return NULL;
     }
 
+#if defined(SERVER_MODE)
+  snapshot = logtb_get_mvcc_snapshot (thread_p);
+#endif /* SERVER_MODE */
+
   if (csect_enter (thread_p, CSECT_QPROC_LIST_CACHE, INF_WAIT) != NO_ERROR)
     {
       return NULL;
     }
 
+#if defined(SERVER_MODE)
   tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+#endif /* SERVER_MODE */
 
   /* look up the hash table with the key */
   lent = (QFILE_LIST_CACHE_ENTRY *) mht_get (qfile_List_cache.list_hts[list_ht_no], params);
@@ -5579,10 +6701,15 @@ qfile_lookup_list_cache_entry (THREAD_ENTRY * thread_p, int list_ht_no, const DB
       /* check if it is marked to be deleted */
       if (lent->deletion_marker)
 	{
-	  (void) qfile_delete_list_cache_entry (thread_p, lent, &tran_index);
+	  (void) qfile_delete_list_cache_entry (thread_p, lent, NULL);
 	  lent = NULL;
 	}
 #if defined(SERVER_MODE)
+      /* check if the result was made with changes to its classes that my snapshot does not see */
+      if (lent && (snapshot == NULL || !qfile_is_list_cache_visible (list_ht_no, snapshot)))
+	{
+	  lent = NULL;
+	}
 #if 0
       /* check if the recorded transaction isolation level is higher than the current one */
       if (lent)
@@ -5644,15 +6771,21 @@ qfile_lookup_list_cache_entry (THREAD_ENTRY * thread_p, int list_ht_no, const DB
 #endif /* SERVER_MODE */
 	  (void) gettimeofday (&lent->time_last_used, NULL);
 	  lent->ref_count++;
+
+	  /* move it to the head of LRU list */
+	  qfile_lru_remove_list_cache_entry (lent);
+	  qfile_lru_add_list_cache_entry (lent);
 	}
     }
   if (lent)
     {
       qfile_List_cache.hit_counter++;	/* counter */
+      perfmon_inc_stat (thread_p, PSTAT_QRC_NUM_HIT);
     }
   else
     {
       qfile_List_cache.miss_counter++;	/* counter */
+      perfmon_inc_stat (thread_p, PSTAT_QRC_NUM_MISS);
     }
 
   csect_exit (thread_p, CSECT_QPROC_LIST_CACHE);
@@ -5660,120 +6793,6 @@ qfile_lookup_list_cache_entry (THREAD_ENTRY * thread_p, int list_ht_no, const DB
   return lent;
 }
 
-static bool
-qfile_is_early_time (struct timeval *a, struct timeval *b)
-{
-  if (a->tv_sec == b->tv_sec)
-    {
-      return a->tv_usec < b->tv_usec;
-    }
-  else
-    {
-      return a->tv_sec < b->tv_sec;
-    }
-}
-
-/*
- * qfile_select_list_cache_entry () - Select candidates to remove from the list cache
- *                               Will be used by mht_map_no_key() function
- *   return:
- *   data(in)   :
- *   args(in/out)   :
- */
-static int
-qfile_select_list_cache_entry (THREAD_ENTRY * thread_p, void *data, void *args)
-{
-  QFILE_LIST_CACHE_ENTRY *lent = (QFILE_LIST_CACHE_ENTRY *) data;
-  QFILE_LIST_CACHE_CANDIDATE *info = (QFILE_LIST_CACHE_CANDIDATE *) args;
-  QFILE_LIST_CACHE_ENTRY **p, **q;
-  int i;
-  size_t n;
-
-#if defined(SERVER_MODE)
-  if (info->include_in_use == false && lent->last_ta_idx > 0)
-    {
-      /* do not select one that is in use */
-      return NO_ERROR;
-    }
-  if (info->include_in_use == true && lent->last_ta_idx == 0)
-    {
-      /* this entry may be selected in the previous selection step */
-      return NO_ERROR;
-    }
-#endif /* SERVER_MODE */
-
-  p = info->time_candidates;
-  q = info->ref_candidates;
-  i = 0;
-
-  while (i < info->c_idx && (p || q))
-    {
-      if (p && qfile_is_early_time (&(lent->time_created), &((*p)->time_created)))
-	{
-	  if (info->c_idx < info->num_candidates)
-	    {
-	      n = sizeof (QFILE_LIST_CACHE_ENTRY *) * (info->c_idx - i);
-	    }
-	  else
-	    {
-	      n = sizeof (QFILE_LIST_CACHE_ENTRY *) * (info->c_idx - i - 1);
-	    }
-	  (void) memmove (p + 1, p, n);
-	  *p = lent;
-	  p = NULL;
-	}
-      else if (p)
-	{
-	  p++;
-	}
-
-      if (q && lent->ref_count < (*q)->ref_count)
-	{
-	  if (info->c_idx < info->num_candidates)
-	    {
-	      n = sizeof (QFILE_LIST_CACHE_ENTRY *) * (info->c_idx - i);
-	    }
-	  else
-	    {
-	      n = sizeof (QFILE_LIST_CACHE_ENTRY *) * (info->c_idx - i - 1);
-	    }
-
-	  (void) memmove (q + 1, q, n);
-	  *q = lent;
-	  q = NULL;
-	}
-      else if (q)
-	{
-	  q++;
-	}
-
-      i++;
-    }
-
-  if (info->c_idx < info->num_candidates)
-    {
-      if (p)
-	{
-	  *p = lent;
-	}
-
-      if (q)
-	{
-	  *q = lent;
-	}
-
-      info->c_idx++;
-    }
-
-  if (--info->selcnt <= 0)
-    {
-      /* due to the performance reason, stop traversing here */
-      return ER_FAILED;
-    }
-
-  return NO_ERROR;
-}
-
 /*
  * qfile_update_list_cache_entry () - Update list cache entry if exist or create new
  *                               one
@@ -5790,13 +6809,15 @@ qfile_select_list_cache_entry (THREAD_ENTRY * thread_p, void *data, void *args)
  */
 QFILE_LIST_CACHE_ENTRY *
 qfile_update_list_cache_entry (THREAD_ENTRY * thread_p, int *list_ht_no_ptr, const DB_VALUE_ARRAY * params,
-			       const QFILE_LIST_ID * list_id, const char *query_string)
+			       const QFILE_LIST_ID * list_id, const char *query_string,
+			       const XCACHE_RELATED_OBJECT * related_objects, int n_related_objects)
 {
-  QFILE_LIST_CACHE_ENTRY *lent, *old, **p, **q, **r;
+  QFILE_LIST_CACHE_ENTRY *lent = NULL;
   MHT_TABLE *ht;
   int tran_index;
 #if defined(SERVER_MODE)
   TRAN_ISOLATION tran_isolation;
+  MVCC_SNAPSHOT *snapshot;
 #if defined(WINDOWS)
   unsigned int num_elements;
 #else
@@ -5806,9 +6827,8 @@ qfile_update_list_cache_entry (THREAD_ENTRY * thread_p, int *list_ht_no_ptr, con
   size_t i_idx, num_active_users;
 #endif
 #endif /* SERVER_MODE */
-  unsigned int n;
   HL_HEAPID old_pri_heap_id;
-  int i, j, k;
+  int i;
   int alloc_size;
 
   if (QFILE_IS_LIST_CACHE_DISABLED)
@@ -5820,6 +6840,10 @@ qfile_update_list_cache_entry (THREAD_ENTRY * thread_p, int *list_ht_no_ptr, con
       return NULL;
     }
 
+#if defined(SERVER_MODE)
+  snapshot = logtb_get_mvcc_snapshot (thread_p);
+#endif /* SERVER_MODE */
+
   if (csect_enter (thread_p, CSECT_QPROC_LIST_CACHE, INF_WAIT) != NO_ERROR)
     {
       return NULL;
@@ -5834,11 +6858,27 @@ qfile_update_list_cache_entry (THREAD_ENTRY * thread_p, int *list_ht_no_ptr, con
 	  csect_exit (thread_p, CSECT_QPROC_LIST_CACHE);
 	  return NULL;
 	}
+
+      /* results of the hash table will be invalidated by changes to these classes */
+      if (qfile_register_list_cache_classes (*list_ht_no_ptr, related_objects, n_related_objects) != NO_ERROR)
+	{
+	  qfile_List_cache.ht_assigned[*list_ht_no_ptr] = false;
+	  *list_ht_no_ptr = -1;
+	  csect_exit (thread_p, CSECT_QPROC_LIST_CACHE);
+	  return NULL;
+	}
     }
 
   tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
 #if defined(SERVER_MODE)
   tran_isolation = logtb_find_isolation (tran_index);
+
+  /* do not share a result made with a snapshot that does not see all committed changes to its classes; a transaction
+   * that committed them may have already invalidated the cache */
+  if (snapshot == NULL || !qfile_is_list_cache_visible (*list_ht_no_ptr, snapshot))
+    {
+      goto end;
+    }
 #endif /* SERVER_MODE */
 
   /*
@@ -5864,7 +6904,7 @@ qfile_update_list_cache_entry (THREAD_ENTRY * thread_p, int *list_ht_no_ptr, con
       /* check if it is possible to delete the previous cached result */
       if (lent->deletion_marker)
 	{
-	  if (qfile_delete_list_cache_entry (thread_p, lent, &tran_index) == NO_ERROR)
+	  if (qfile_delete_list_cache_entry (thread_p, lent, NULL) == NO_ERROR)
 	    {
 	      lent = NULL;
 	    }
@@ -5875,7 +6915,7 @@ qfile_update_list_cache_entry (THREAD_ENTRY * thread_p, int *list_ht_no_ptr, con
        * other's to delete and making new entry with mine */
       if (lent->tran_isolation < tran_isolation)
 	{
-	  if (qfile_delete_list_cache_entry (thread_p, lent, &tran_index) == NO_ERROR)
+	  if (qfile_delete_list_cache_entry (thread_p, lent, NULL) == NO_ERROR)
 	    {
 	      lent = NULL;
 	    }
@@ -5908,6 +6948,8 @@ qfile_update_list_cache_entry (THREAD_ENTRY * thread_p, int *list_ht_no_ptr, con
 #endif /* SERVER_MODE */
       (void) gettimeofday (&lent->time_last_used, NULL);
       lent->ref_count++;
+      qfile_lru_remove_list_cache_entry (lent);
+      qfile_lru_add_list_cache_entry (lent);
     }
   while (0);
 
@@ -5917,114 +6959,10 @@ qfile_update_list_cache_entry (THREAD_ENTRY * thread_p, int *list_ht_no_ptr, con
       goto end;
     }
 
-  /* check the number of list cache entries */
-  if ((int) mht_count (ht) >= prm_get_integer_value (PRM_ID_LIST_MAX_QUERY_CACHE_ENTRIES)
-      || qfile_List_cache.n_entries >= prm_get_integer_value (PRM_ID_LIST_MAX_QUERY_CACHE_ENTRIES)
-      || qfile_List_cache.n_pages >= prm_get_integer_value (PRM_ID_LIST_MAX_QUERY_CACHE_PAGES))
+  /* make room for the new entry by evicting least recently used ones */
+  if (!qfile_evict_list_cache_entries (thread_p, ht, list_id->page_cnt))
     {
-
-      qfile_List_cache.full_counter++;	/* counter */
-
-      /* at first, examine hash entries to selet candidates */
-      qfile_List_cache_candidate.c_idx = 0;
-      qfile_List_cache_candidate.v_idx = 0;
-      qfile_List_cache_candidate.selcnt = qfile_List_cache_candidate.num_candidates;
-      /* at first, try to find candidates within entries that is not in use */
-      qfile_List_cache_candidate.include_in_use = false;
-
-      /* select candidates from all hash tables */
-      for (n = 0; n < qfile_List_cache.n_hts; n++)
-	{
-	  if (qfile_List_cache.ht_assigned[n])
-	    {
-	      (void) mht_map_no_key (thread_p, qfile_List_cache.list_hts[n], qfile_select_list_cache_entry,
-				     &qfile_List_cache_candidate);
-	    }
-	}
-      if (qfile_List_cache_candidate.c_idx < qfile_List_cache_candidate.num_candidates)
-	{
-	  /* insufficient candidates; try once more */
-	  qfile_List_cache_candidate.include_in_use = true;
-	  for (n = 0; n < qfile_List_cache.n_hts; n++)
-	    {
-	      if (qfile_List_cache.ht_assigned[n])
-		{
-		  (void) mht_map_no_key (thread_p, qfile_List_cache.list_hts[n], qfile_select_list_cache_entry,
-					 &qfile_List_cache_candidate);
-		}
-	    }
-	}
-
-      /* find victims who appears in both groups */
-      k = qfile_List_cache_candidate.v_idx;
-      r = qfile_List_cache_candidate.victims;
-      for (i = 0, p = qfile_List_cache_candidate.time_candidates; i < qfile_List_cache_candidate.num_candidates;
-	   i++, p++)
-	{
-	  for (j = 0, q = qfile_List_cache_candidate.ref_candidates; j < qfile_List_cache_candidate.num_candidates;
-	       j++, q++)
-	    {
-	      if (*p && *q && *p == *q && k < qfile_List_cache_candidate.num_victims)
-		{
-		  *r++ = *p;
-		  k++;
-		  *p = *q = NULL;
-		  break;
-		}
-	    }
-	  if (k >= qfile_List_cache_candidate.num_victims)
-	    {
-	      break;
-	    }
-	}
-
-      /* select more victims if insufficient */
-      if (k < qfile_List_cache_candidate.num_victims)
-	{
-	  /*
-	   * The above victim selection algorithm is not completed yet.
-	   * Two double linked lists for list cache entries are needed to
-	   * implement the algorithm efficiently. One for creation time, and
-	   * the other one for referencing.
-	   * Instead, select from most significant members from each groups.
-	   */
-	  p = qfile_List_cache_candidate.time_candidates;
-	  q = qfile_List_cache_candidate.ref_candidates;
-	  for (i = 0; i < qfile_List_cache_candidate.num_candidates; i++)
-	    {
-	      if (*p)
-		{
-		  *r++ = *p;
-		  k++;
-		  *p = NULL;
-		  if (k >= qfile_List_cache_candidate.num_victims)
-		    {
-		      break;
-		    }
-		}
-	      if (*q)
-		{
-		  *r++ = *q;
-		  k++;
-		  *q = NULL;
-		  if (k >= qfile_List_cache_candidate.num_victims)
-		    {
-		      break;
-		    }
-		}
-	      p++, q++;
-	    }
-	}
-      qfile_List_cache_candidate.c_idx = 0;
-      qfile_List_cache_candidate.v_idx = k;
-
-      /* now, delete victims from the cache */
-      for (k = 0, r = qfile_List_cache_candidate.victims; k < qfile_List_cache_candidate.v_idx; k++, r++)
-	{
-	  old = *r;
-	  (void) qfile_delete_list_cache_entry (thread_p, old, &tran_index);
-	}
-      qfile_List_cache_candidate.v_idx = 0;
+      goto end;
     }
 
   /* make new QFILE_LIST_CACHE_ENTRY */
@@ -6039,6 +6977,7 @@ qfile_update_list_cache_entry (THREAD_ENTRY * thread_p, int *list_ht_no_ptr, con
   lent->list_ht_no = *list_ht_no_ptr;
 #if defined(SERVER_MODE)
   lent->uncommitted_marker = true;
+  lent->tran_index = tran_index;
   lent->tran_isolation = tran_isolation;
   lent->last_ta_idx = 0;
   lent->tran_index_array =
@@ -6064,7 +7003,7 @@ qfile_update_list_cache_entry (THREAD_ENTRY * thread_p, int *list_ht_no_ptr, con
   /* copy the QFILE_LIST_ID */
   if (qfile_copy_list_id (&lent->list_id, list_id, false) != NO_ERROR)
     {
-      (void) qfile_delete_list_cache_entry (thread_p, lent, &tran_index);
+      (void) qfile_delete_list_cache_entry (thread_p, lent, NULL);
       lent = NULL;
       goto end;
     }
@@ -6110,13 +7049,14 @@ qfile_update_list_cache_entry (THREAD_ENTRY * thread_p, int *list_ht_no_ptr, con
 	{
 	  db_private_free (thread_p, s);
 	}
-      (void) qfile_delete_list_cache_entry (thread_p, lent, &tran_index);
+      (void) qfile_delete_list_cache_entry (thread_p, lent, NULL);
       lent = NULL;
       goto end;
     }
 
   /* append to the list of uncommitted entries in the transaction */
   qfile_add_uncommitted_list_cache_entry (tran_index, lent);
+  qfile_lru_add_list_cache_entry (lent);
 
   /* update counter */
   qfile_List_cache.n_entries++;
@@ -6137,8 +7077,8 @@ end:
 int
 qfile_end_use_of_list_cache_entry (THREAD_ENTRY * thread_p, QFILE_LIST_CACHE_ENTRY * lent, bool marker)
 {
-  int tran_index;
 #if defined(SERVER_MODE)
+  int tran_index;
   int *p, *r;
 #if defined(WINDOWS)
   unsigned int num_elements;
@@ -6205,7 +7145,7 @@ qfile_end_use_of_list_cache_entry (THREAD_ENTRY * thread_p, QFILE_LIST_CACHE_ENT
   /* if this entry will be deleted */
   if (marker)
     {
-      (void) qfile_delete_list_cache_entry (thread_p, lent, &tran_index);
+      (void) qfile_delete_list_cache_entry (thread_p, lent, NULL);
     }
 
   csect_exit (thread_p, CSECT_QPROC_LIST_CACHE);
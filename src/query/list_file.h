@@ -45,6 +45,8 @@
 // forward definitions
 struct valptr_list_node;
 struct xasl_node_header;
+struct hashsetop_stat;
+struct xcache_related_object;
 
 extern int qfile_Is_list_cache_disabled;
 
@@ -88,7 +90,10 @@ struct qfile_list_cache_entry
   int *tran_index_array;	/* array of TID(tran index)s that are currently using this list file; size is
 				 * MAX_NTRANS */
   size_t last_ta_idx;		/* index of the last element in TIDs array */
+  int tran_index;		/* transaction which made this result */
 #endif				/* SERVER_MODE */
+  QFILE_LIST_CACHE_ENTRY *lru_prev;	/* more recently used entry */
+  QFILE_LIST_CACHE_ENTRY *lru_next;	/* less recently used entry */
   const char *query_string;	/* query string; information purpose only */
   struct timeval time_created;	/* when this entry created */
   struct timeval time_last_used;	/* when this entry used lastly */
@@ -160,8 +165,11 @@ QFILE_LIST_CACHE_ENTRY *qfile_lookup_list_cache_entry (THREAD_ENTRY * thread_p,
 						       const DB_VALUE_ARRAY * params);
 QFILE_LIST_CACHE_ENTRY *qfile_update_list_cache_entry (THREAD_ENTRY * thread_p, int *list_ht_no_ptr,
 						       const DB_VALUE_ARRAY * params, const QFILE_LIST_ID * list_id,
-						       const char *query_string);
+						       const char *query_string,
+						       const struct xcache_related_object *related_objects,
+						       int n_related_objects);
 int qfile_end_use_of_list_cache_entry (THREAD_ENTRY * thread_p, QFILE_LIST_CACHE_ENTRY * lent, bool marker);
+extern int qfile_clear_list_cache_by_class (THREAD_ENTRY * thread_p, const OID * class_oid, MVCCID mvccid);
 
 /* Scan related routines */
 extern int qfile_modify_type_list (QFILE_TUPLE_VALUE_TYPE_LIST * type_list, QFILE_LIST_ID * list_id);
@@ -180,6 +188,9 @@ extern int qfile_fast_val_tuple_to_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID
 extern int qfile_add_item_to_list (THREAD_ENTRY * thread_p, char *item, int item_size, QFILE_LIST_ID * list_id);
 extern QFILE_LIST_ID *qfile_combine_two_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * lhs_file,
 					      QFILE_LIST_ID * rhs_file, int flag);
+extern bool qfile_can_hash_combine (QFILE_LIST_ID * lhs_file, QFILE_LIST_ID * rhs_file, int flag);
+extern QFILE_LIST_ID *qfile_hash_combine_two_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * lhs_file,
+						   QFILE_LIST_ID * rhs_file, int flag, struct hashsetop_stat *stats);
 extern int qfile_copy_tuple_descr_to_tuple (THREAD_ENTRY * thread_p, QFILE_TUPLE_DESCRIPTOR * tpl_descr,
 					    QFILE_TUPLE_RECORD * tplrec);
 extern int qfile_reallocate_tuple (QFILE_TUPLE_RECORD * tplrec, int tpl_size);
@@ -217,9 +217,24 @@ qdata_aggregate_accumulator_to_accumulator (cubthread::entry *thread_p, cubxasl:
       /* do nothing */
       break;
 
+    case PT_COUNT:
+      // new_acc holds a partial count that must be added, not counted as one more value
+      if (new_acc->curr_cnt < 1 || DB_IS_NULL (new_acc->value))
+	{
+	  break;
+	}
+      if (acc->curr_cnt < 1 || DB_IS_NULL (acc->value))
+	{
+	  db_make_int (acc->value, db_get_int (new_acc->value));
+	}
+      else
+	{
+	  db_make_int (acc->value, db_get_int (acc->value) + db_get_int (new_acc->value));
+	}
+      break;
+
     case PT_MIN:
     case PT_MAX:
-    case PT_COUNT:
     case PT_AGG_BIT_AND:
     case PT_AGG_BIT_OR:
     case PT_AGG_BIT_XOR:
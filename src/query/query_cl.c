@@ -132,6 +132,42 @@ execute_query (const XASL_ID * xasl_id, QUERY_ID * query_idp, int var_cnt, const
   return ret;
 }
 
+/*
+ * execute_query_array () - Execute a prepared query once for each row of host variables
+ *   return: Error code; the error that stopped the execution if less than n_rows were executed
+ *   xasl_id(in)        : XASL file id that was a result of prepare_query()
+ *   n_rows(in) : number of rows
+ *   var_cnt(in)        : number of host variables of each row
+ *   varptr(in) : array of host variables of all rows, row after row
+ *   flag(in)   : flag
+ *   row_results(out)   : per row, number of affected objects or error code
+ *   row_messages(out)  : per row, error message allocated with malloc, or NULL
+ *   n_executed(out)    : number of rows executed
+ *
+ * Note: The query must not return a result to be fetched; it is ended after each row.
+ */
+int
+execute_query_array (const XASL_ID * xasl_id, int n_rows, int var_cnt, const DB_VALUE * varptr, QUERY_FLAG flag,
+		     int *row_results, char **row_messages, int *n_executed)
+{
+  int row;
+
+  /* if QO_PARAM_LEVEL indicate no execution, just return */
+  if (qo_need_skip_execution ())
+    {
+      for (row = 0; row < n_rows; row++)
+	{
+	  row_results[row] = 0;
+	  row_messages[row] = NULL;
+	}
+      *n_executed = n_rows;
+      return NO_ERROR;
+    }
+
+  return qmgr_execute_query_array (xasl_id, n_rows, var_cnt, varptr, flag, tran_get_query_timeout (), row_results,
+				   row_messages, n_executed);
+}
+
 /*
  * prepare_and_execute_query () -
  *   return:
@@ -38,6 +38,8 @@ extern int prepare_query (compile_context * context, xasl_stream * stream);
 extern int execute_query (const XASL_ID * xasl_id, QUERY_ID * query_idp, int var_cnt, const DB_VALUE * varptr,
 			  QFILE_LIST_ID ** list_idp, QUERY_FLAG flag, CACHE_TIME * clt_cache_time,
 			  CACHE_TIME * srv_cache_time);
+extern int execute_query_array (const XASL_ID * xasl_id, int n_rows, int var_cnt, const DB_VALUE * varptr,
+				QUERY_FLAG flag, int *row_results, char **row_messages, int *n_executed);
 extern int prepare_and_execute_query (char *stream, int stream_size, QUERY_ID * query_id, int var_cnt,
 				      DB_VALUE * varptr, QFILE_LIST_ID ** result, QUERY_FLAG flag);
 
@@ -237,7 +237,8 @@ qdump_print_list_merge_info (QFILE_LIST_MERGE_INFO * merge_info_p)
     }
 
   fprintf (foutput, "[join type:%d]", merge_info_p->join_type);
-  fprintf (foutput, "[single fetch:%d]\n", merge_info_p->single_fetch);
+  fprintf (foutput, "[single fetch:%d]", merge_info_p->single_fetch);
+  fprintf (foutput, "[join method:%d]\n", merge_info_p->join_method);
 
   qdump_print_column ("outer column position", merge_info_p->ls_column_cnt, merge_info_p->ls_outer_column);
   qdump_print_column ("outer column is unique", merge_info_p->ls_column_cnt, merge_info_p->ls_outer_unique);
@@ -2875,8 +2876,10 @@ qdump_print_stats_json (xasl_node * xasl_p, json_t * parent)
 {
   ORDERBY_STATS *ostats;
   GROUPBY_STATS *gstats;
+  HASHJOIN_STATS *hstats;
+  HASHSETOP_STATS *sstats;
   json_t *proc, *scan = NULL;
-  json_t *subquery, *groupby, *orderby;
+  json_t *subquery, *groupby, *orderby, *hashjoin, *hashsetop;
   json_t *left, *right, *outer, *inner;
   json_t *cte_non_recursive_part, *cte_recursive_part;
 
@@ -2920,6 +2923,19 @@ qdump_print_stats_json (xasl_node * xasl_p, json_t * parent)
 
       json_object_set_new (proc, "left", left);
       json_object_set_new (proc, "right", right);
+
+      sstats = &xasl_p->hashsetop_stats;
+      if (sstats->run_hashsetop)
+	{
+	  hashsetop = json_object ();
+
+	  json_object_set_new (hashsetop, "time", json_integer (TO_MSEC (sstats->hashsetop_time)));
+	  json_object_set_new (hashsetop, "build", json_integer (sstats->build_rows));
+	  json_object_set_new (hashsetop, "probe", json_integer (sstats->probe_rows));
+	  json_object_set_new (hashsetop, "memory", json_integer (sstats->mem_size));
+	  json_object_set_new (hashsetop, "partitions", json_integer (sstats->partitions));
+	  json_object_set_new (proc, "HASH", hashsetop);
+	}
       break;
 
     case MERGELIST_PROC:
@@ -2931,6 +2947,18 @@ qdump_print_stats_json (xasl_node * xasl_p, json_t * parent)
 
       json_object_set_new (proc, "outer", outer);
       json_object_set_new (proc, "inner", inner);
+
+      hstats = &xasl_p->hashjoin_stats;
+      if (hstats->run_hashjoin)
+	{
+	  hashjoin = json_object ();
+
+	  json_object_set_new (hashjoin, "time", json_integer (TO_MSEC (hstats->hashjoin_time)));
+	  json_object_set_new (hashjoin, "build", json_integer (hstats->build_rows));
+	  json_object_set_new (hashjoin, "probe", json_integer (hstats->probe_rows));
+	  json_object_set_new (hashjoin, "partitions", json_integer (hstats->partitions));
+	  json_object_set_new (proc, "HASHJOIN", hashjoin);
+	}
       break;
 
     case MERGE_PROC:
@@ -3157,6 +3185,24 @@ qdump_print_access_spec_stats_text (FILE * fp, ACCESS_SPEC_TYPE * spec_list_p, i
   return;
 }
 
+/*
+ * qdump_print_hashsetop_stats_text () - finish the line of a set operation
+ *   return:
+ *   fp(in):
+ *   sstats(in):
+ */
+static void
+qdump_print_hashsetop_stats_text (FILE * fp, HASHSETOP_STATS * sstats)
+{
+  if (sstats->run_hashsetop)
+    {
+      fprintf (fp, " (hash time: %d, build: %lld, probe: %lld, memory: %lld, partitions: %d)",
+	       TO_MSEC (sstats->hashsetop_time), (long long int) sstats->build_rows,
+	       (long long int) sstats->probe_rows, (long long int) sstats->mem_size, sstats->partitions);
+    }
+  fprintf (fp, "\n");
+}
+
 /*
  * qdump_print_stats_text () -
  *   return:
@@ -3169,6 +3215,7 @@ qdump_print_stats_text (FILE * fp, xasl_node * xasl_p, int indent)
 {
   ORDERBY_STATS *ostats;
   GROUPBY_STATS *gstats;
+  HASHJOIN_STATS *hstats;
 
   if (xasl_p == NULL)
     {
@@ -3201,23 +3248,36 @@ qdump_print_stats_text (FILE * fp, xasl_node * xasl_p, int indent)
       break;
 
     case UNION_PROC:
-      fprintf (fp, "UNION\n");
+      fprintf (fp, "UNION");
+      qdump_print_hashsetop_stats_text (fp, &xasl_p->hashsetop_stats);
       qdump_print_stats_text (fp, xasl_p->proc.union_.left, indent);
       qdump_print_stats_text (fp, xasl_p->proc.union_.right, indent);
       break;
     case DIFFERENCE_PROC:
-      fprintf (fp, "DIFFERENCE\n");
+      fprintf (fp, "DIFFERENCE");
+      qdump_print_hashsetop_stats_text (fp, &xasl_p->hashsetop_stats);
       qdump_print_stats_text (fp, xasl_p->proc.union_.left, indent);
       qdump_print_stats_text (fp, xasl_p->proc.union_.right, indent);
       break;
     case INTERSECTION_PROC:
-      fprintf (fp, "INTERSECTION\n");
+      fprintf (fp, "INTERSECTION");
+      qdump_print_hashsetop_stats_text (fp, &xasl_p->hashsetop_stats);
       qdump_print_stats_text (fp, xasl_p->proc.union_.left, indent);
       qdump_print_stats_text (fp, xasl_p->proc.union_.right, indent);
       break;
 
     case MERGELIST_PROC:
-      fprintf (fp, "MERGELIST\n");
+      hstats = &xasl_p->hashjoin_stats;
+      if (hstats->run_hashjoin)
+	{
+	  fprintf (fp, "HASHJOIN (time: %d, build: %lld, probe: %lld, partitions: %d)\n",
+		   TO_MSEC (hstats->hashjoin_time), (long long int) hstats->build_rows,
+		   (long long int) hstats->probe_rows, hstats->partitions);
+	}
+      else
+	{
+	  fprintf (fp, "MERGELIST\n");
+	}
       qdump_print_stats_text (fp, xasl_p->proc.mergelist.outer_xasl, indent);
       qdump_print_stats_text (fp, xasl_p->proc.mergelist.inner_xasl, indent);
       break;
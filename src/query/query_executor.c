@@ -78,8 +78,16 @@
 #include "xasl_aggregate.hpp"
 #include "xasl_analytic.hpp"
 #include "xasl_predicate.hpp"
+#if defined (SERVER_MODE)
+#include "server_support.h"
+#include "thread_entry_task.hpp"
+#include "thread_task_group.hpp"
+#endif /* SERVER_MODE */
 
 #include <vector>
+#if defined (SERVER_MODE)
+#include <functional>
+#endif /* SERVER_MODE */
 
 // XASL_STATE
 typedef struct xasl_state XASL_STATE;
@@ -125,6 +133,18 @@ struct xasl_state
 /* maximum selectivity allowed for hash aggregate evaluation */
 #define HASH_AGGREGATE_VH_SELECTIVITY_THRESHOLD         0.5f
 
+/* range of the hash numbers of hash join keys */
+#define HASH_JOIN_HASH_RANGE 0x7fffffff
+
+/* maximum number of partitions of a hash join that does not fit in memory */
+#define HASH_JOIN_MAX_PARTITIONS 256
+
+/* minimum number of heap pages for each participant of a parallel scan */
+#define PARALLEL_SCAN_MIN_PAGES 64
+
+/* number of page chunks for each participant of a parallel scan; chunks are claimed on demand to balance the load */
+#define PARALLEL_SCAN_CHUNKS_PER_PARTICIPANT 4
+
 
 #define QEXEC_CLEAR_AGG_LIST_VALUE(agg_list) \
   do \
@@ -187,6 +207,67 @@ struct groupby_dimension
   AGGREGATE_TYPE *d_agg_list;	/* aggregation colunms list */
 };
 
+/* inner tuple of a hash join table; the tuple is allocated right after the entry */
+typedef struct hash_join_entry HASH_JOIN_ENTRY;
+struct hash_join_entry
+{
+  HASH_JOIN_ENTRY *next;	/* next entry of the bucket */
+  unsigned int hash;		/* hash number of the join columns */
+  QFILE_TUPLE tpl;		/* copy of the inner tuple */
+};
+
+typedef struct hash_join_state HASH_JOIN_STATE;
+struct hash_join_state
+{
+  QFILE_LIST_MERGE_INFO *merge_infop;	/* join columns and result positions */
+  TP_DOMAIN **outer_domp;	/* join column domains of the outer list */
+  TP_DOMAIN **inner_domp;	/* join column domains of the inner list */
+  char **outer_valp;		/* join column values of the probing tuple */
+  char **inner_valp;		/* join column values of the matching tuple */
+  HASH_JOIN_ENTRY **buckets;	/* hash table of the inner tuples */
+  unsigned int bucket_cnt;
+  unsigned int hash_divisor;	/* partition count; hash numbers of a partition are all equal modulo it */
+  QFILE_TUPLE_RECORD tplrec;	/* result tuple area */
+  UINT64 build_rows;
+  UINT64 probe_rows;
+};
+
+#if defined (SERVER_MODE)
+typedef struct parallel_scan PARALLEL_SCAN;
+typedef struct parallel_scan_worker PARALLEL_SCAN_WORKER;
+
+/* worker of a parallel scan; executes its own clone of the cached XASL */
+struct parallel_scan_worker
+{
+  XASL_NODE *xasl;		/* clone holding the partial aggregates; NULL if the worker did not scan */
+};
+
+/* heap pages of a scalar aggregate scan shared by the query thread and by workers of the worker pool. Lives on the
+ * stack of the query thread: workers run as tasks of a cubthread::task_group, and the tasks no worker claimed by the
+ * time the query thread finished scanning are cancelled without touching the scan. */
+struct parallel_scan
+{
+  XASL_CACHE_ENTRY *xcache_entry;	/* cache entry of the query; fixed by the query thread */
+  XASL_STATE *xasl_state;	/* state of the query thread; host variables are shared read-only */
+  int fixed_scan;
+
+  VPID *pages;			/* all pages of the heap file, sorted */
+  int n_pages;
+  int chunk_size;
+
+  pthread_mutex_t mutex;	/* protects the fields below */
+  pthread_cond_t cond;
+  int next_page;		/* first page that is not claimed yet */
+  int n_published;		/* workers that published their partial aggregates */
+  bool merged;			/* partial aggregates were merged and may be freed */
+  bool has_error;
+  OR_ALIGNED_BUF (1024) error_area;	/* first error of a worker */
+
+  PARALLEL_SCAN_WORKER *workers;
+  int n_workers;
+};
+#endif /* SERVER_MODE */
+
 typedef struct groupby_state GROUPBY_STATE;
 struct groupby_state
 {
@@ -500,6 +581,17 @@ static QFILE_LIST_ID *qexec_merge_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID *
 static QFILE_LIST_ID *qexec_merge_list_outer (THREAD_ENTRY * thread_p, SCAN_ID * outer_sid, SCAN_ID * inner_sid,
 					      QFILE_LIST_MERGE_INFO * merge_infop, PRED_EXPR * other_outer_join_pred,
 					      XASL_STATE * xasl_state, int ls_flag);
+static int qexec_hash_join_key (QFILE_TUPLE tpl, int *col_list, TP_DOMAIN ** domp, int nvals, unsigned int *hash_p,
+				bool * is_null_p);
+static int qexec_hash_join_build (THREAD_ENTRY * thread_p, HASH_JOIN_STATE * hjstate, QFILE_LIST_ID * inner_list_idp);
+static int qexec_hash_join_probe (THREAD_ENTRY * thread_p, HASH_JOIN_STATE * hjstate, QFILE_LIST_ID * outer_list_idp,
+				  QFILE_LIST_ID * list_idp);
+static void qexec_hash_join_clear_table (THREAD_ENTRY * thread_p, HASH_JOIN_STATE * hjstate);
+static int qexec_hash_join_partition (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_idp, int *col_list,
+				      TP_DOMAIN ** domp, int nvals, QFILE_LIST_ID ** part_list, int part_cnt);
+static QFILE_LIST_ID *qexec_hash_join_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * outer_list_idp,
+					    QFILE_LIST_ID * inner_list_idp, QFILE_LIST_MERGE_INFO * merge_infop,
+					    int ls_flag, HASHJOIN_STATS * stats);
 static int qexec_merge_listfiles (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state);
 static int qexec_open_scan (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * curr_spec, VAL_LIST * val_list, VAL_DESCR * vd,
 			    bool force_select_lock, int fixed, int grouped, bool iscan_oid_order, SCAN_ID * s_id,
@@ -514,6 +606,16 @@ static SCAN_CODE qexec_execute_scan (THREAD_ENTRY * thread_p, XASL_NODE * xasl,
 				     QFILE_TUPLE_RECORD * ignore, XASL_SCAN_FNC_PTR next_scan_fnc);
 static SCAN_CODE qexec_intprt_fnc (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state,
 				   QFILE_TUPLE_RECORD * tplrec, XASL_SCAN_FNC_PTR next_scan_fnc);
+#if defined (SERVER_MODE)
+static bool qexec_is_parallel_scan_eligible (XASL_NODE * xasl);
+static SCAN_CODE qexec_intprt_fnc_parallel (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state,
+					    QFILE_TUPLE_RECORD * tplrec, XASL_SCAN_FNC_PTR next_scan_fnc);
+static SCAN_CODE qexec_parallel_scan_run (THREAD_ENTRY * thread_p, PARALLEL_SCAN * pscan, XASL_NODE * xasl,
+					  XASL_STATE * xasl_state, QFILE_TUPLE_RECORD * tplrec);
+static bool qexec_parallel_scan_claim (PARALLEL_SCAN * pscan, int *first_page, int *n_pages);
+static void qexec_parallel_scan_set_error (PARALLEL_SCAN * pscan);
+static int qexec_parallel_scan_merge (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_NODE * part_xasl);
+#endif /* SERVER_MODE */
 static SCAN_CODE qexec_merge_fnc (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state,
 				  QFILE_TUPLE_RECORD * tplrec, XASL_SCAN_FNC_PTR ignore);
 static int qexec_setup_list_id (THREAD_ENTRY * thread_p, XASL_NODE * xasl);
@@ -626,6 +728,7 @@ static void qexec_resolve_domains_for_group_by (BUILDLIST_PROC_NODE * buildlist,
 static int qexec_resolve_domains_for_aggregation (THREAD_ENTRY * thread_p, AGGREGATE_TYPE * agg_p,
 						  XASL_STATE * xasl_state, QFILE_TUPLE_RECORD * tplrec,
 						  REGU_VARIABLE_LIST regu_list, int *resolved);
+static void qexec_resolve_domains_for_buildvalue_outptr (XASL_NODE * xasl);
 static int query_multi_range_opt_check_set_sort_col (THREAD_ENTRY * thread_p, XASL_NODE * xasl);
 static ACCESS_SPEC_TYPE *query_multi_range_opt_check_specs (THREAD_ENTRY * thread_p, XASL_NODE * xasl);
 static int qexec_init_instnum_val (XASL_NODE * xasl, THREAD_ENTRY * thread_p, XASL_STATE * xasl_state);
@@ -1270,9 +1373,6 @@ qexec_end_one_iteration (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE *
     {
       if (xasl->proc.buildvalue.agg_list != NULL)
 	{
-	  AGGREGATE_TYPE *agg_node = NULL;
-	  REGU_VARIABLE_LIST out_list_val = NULL;
-
 	  if (xasl->proc.buildvalue.agg_list != NULL && !xasl->proc.buildvalue.agg_domains_resolved)
 	    {
 	      if (qexec_resolve_domains_for_aggregation (thread_p, xasl->proc.buildvalue.agg_list, xasl_state, tplrec,
@@ -1289,31 +1389,7 @@ qexec_end_one_iteration (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE *
 	    }
 
 	  /* resolve domains for aggregates */
-	  for (out_list_val = xasl->outptr_list->valptrp; out_list_val != NULL; out_list_val = out_list_val->next)
-	    {
-	      assert (out_list_val->value.domain != NULL);
-
-	      /* aggregates corresponds to CONSTANT regu vars in outptr_list */
-	      if (out_list_val->value.type != TYPE_CONSTANT
-		  || (TP_DOMAIN_TYPE (out_list_val->value.domain) != DB_TYPE_VARIABLE
-		      && TP_DOMAIN_COLLATION_FLAG (out_list_val->value.domain) == TP_DOMAIN_COLL_NORMAL))
-		{
-		  continue;
-		}
-
-	      /* search in aggregate list by comparing DB_VALUE pointers */
-	      for (agg_node = xasl->proc.buildvalue.agg_list; agg_node != NULL; agg_node = agg_node->next)
-		{
-		  if (out_list_val->value.value.dbvalptr == agg_node->accumulator.value
-		      && TP_DOMAIN_TYPE (agg_node->domain) != DB_TYPE_NULL)
-		    {
-		      assert (agg_node->domain != NULL);
-		      assert (TP_DOMAIN_COLLATION_FLAG (agg_node->domain) == TP_DOMAIN_COLL_NORMAL);
-		      out_list_val->value.domain = agg_node->domain;
-		    }
-		}
-
-	    }
+	  qexec_resolve_domains_for_buildvalue_outptr (xasl);
 	}
     }
 
@@ -2283,6 +2359,8 @@ qexec_clear_xasl (THREAD_ENTRY * thread_p, xasl_node * xasl, bool is_final)
       // clear trace stats
       memset (&xasl->orderby_stats, 0, sizeof (ORDERBY_STATS));
       memset (&xasl->groupby_stats, 0, sizeof (GROUPBY_STATS));
+      memset (&xasl->hashjoin_stats, 0, sizeof (HASHJOIN_STATS));
+      memset (&xasl->hashsetop_stats, 0, sizeof (HASHSETOP_STATS));
       memset (&xasl->xasl_stats, 0, sizeof (XASL_STATS));
     }
 
@@ -6285,1861 +6363,2963 @@ exit_on_error:
 }
 
 /*
- * qexec_merge_listfiles () -
+ * qexec_hash_join_key () - compute the hash number of the join columns of a tuple
  *   return: NO_ERROR, or ER_code
- *   xasl(in)   : XASL Tree pointer
- *   xasl_state(in)     :
- *
- * Note: This function is used for a direct merge of two LIST files
- * during XASL tree interpretation.
- *
- * Note: For a direct list file merge, currently the outer and inner columns
- * should have the same data type.
+ *   tpl(in)    : list file tuple
+ *   col_list(in)       : join column positions in the tuple
+ *   domp(in)   : join column domains
+ *   nvals(in)  : join columns count
+ *   hash_p(out)        : hash number
+ *   is_null_p(out)     : true if any join column is NULL; such a tuple never joins
  */
 static int
-qexec_merge_listfiles (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state)
+qexec_hash_join_key (QFILE_TUPLE tpl, int *col_list, TP_DOMAIN ** domp, int nvals, unsigned int *hash_p,
+		     bool * is_null_p)
 {
-  QFILE_LIST_ID *list_id = NULL;
-  ACCESS_SPEC_TYPE *outer_spec = NULL;	/* left */
-  ACCESS_SPEC_TYPE *inner_spec = NULL;	/* right */
-  QFILE_LIST_MERGE_INFO *merge_infop = &(xasl->proc.mergelist.ls_merge);
-  XASL_NODE *outer_xasl, *inner_xasl;
-  int ls_flag = 0;
-
-  outer_xasl = xasl->proc.mergelist.outer_xasl;
-  inner_xasl = xasl->proc.mergelist.inner_xasl;
+  OR_BUF buf;
+  DB_VALUE dbval;
+  char *valp;
+  unsigned int hash = 0;
+  int k;
 
-  /* open the empty list file if not already open */
+  *is_null_p = false;
 
-  if (outer_xasl->list_id->type_list.type_cnt == 0)
+  for (k = 0; k < nvals; k++)
     {
-      /* start main block iterations */
-      if (qexec_start_mainblock_iterations (thread_p, outer_xasl, xasl_state) != NO_ERROR)
+      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (tpl, col_list[k], valp);
+      if (QFILE_GET_TUPLE_VALUE_FLAG (valp) == V_UNBOUND || QFILE_GET_TUPLE_VALUE_LENGTH (valp) == 0)
 	{
-	  GOTO_EXIT_ON_ERROR;
+	  *is_null_p = true;
+	  return NO_ERROR;
 	}
-    }
-  if (inner_xasl->list_id->type_list.type_cnt == 0)
-    {
-      /* start main block iterations */
-      if (qexec_start_mainblock_iterations (thread_p, inner_xasl, xasl_state) != NO_ERROR)
+
+      /* do not copy the value; it is only hashed */
+      PRIM_SET_NULL (&dbval);
+      or_init (&buf, valp + QFILE_TUPLE_VALUE_HEADER_SIZE, QFILE_GET_TUPLE_VALUE_LENGTH (valp));
+      if (domp[k]->type->data_readval (&buf, &dbval, domp[k], -1, false, NULL, 0) != NO_ERROR)
 	{
-	  GOTO_EXIT_ON_ERROR;
+	  return ER_FAILED;
+	}
+
+      if (DB_IS_NULL (&dbval))
+	{
+	  *is_null_p = true;
+	  return NO_ERROR;
+	}
+
+      hash = ((hash << 5) | (hash >> 27)) ^ mht_get_hash_number (HASH_JOIN_HASH_RANGE, &dbval);
+
+      if (DB_NEED_CLEAR (&dbval))
+	{
+	  pr_clear_value (&dbval);
 	}
     }
 
-  /* If MERGELIST_PROC does not have 'order by' (xasl->orderby_list), then the list file to be open at here will be the
-   * last one. Otherwise, the last list file will be open at qexec_orderby_distinct(). (Note that only one that can
-   * have 'group by' is BUILDLIST_PROC type.) And, the top most XASL is the other condition for the list file to be the
-   * last result file. */
+  *hash_p = hash;
 
-  QFILE_SET_FLAG (ls_flag, QFILE_FLAG_ALL);
-  if (XASL_IS_FLAGED (xasl, XASL_TOP_MOST_XASL) && XASL_IS_FLAGED (xasl, XASL_TO_BE_CACHED)
-      && (xasl->orderby_list == NULL || XASL_IS_FLAGED (xasl, XASL_SKIP_ORDERBY_LIST)) && xasl->option != Q_DISTINCT)
+  return NO_ERROR;
+}
+
+/*
+ * qexec_hash_join_build () - put the tuples of the inner list into the hash table
+ *   return: NO_ERROR, or ER_code
+ *   hjstate(in/out)    : hash join state
+ *   inner_list_idp(in) : inner list file
+ */
+static int
+qexec_hash_join_build (THREAD_ENTRY * thread_p, HASH_JOIN_STATE * hjstate, QFILE_LIST_ID * inner_list_idp)
+{
+  QFILE_LIST_MERGE_INFO *merge_infop = hjstate->merge_infop;
+  QFILE_LIST_SCAN_ID inner_sid;
+  QFILE_TUPLE_RECORD inner_tplrec = { NULL, 0 };
+  HASH_JOIN_ENTRY *entry;
+  SCAN_CODE scan;
+  unsigned int hash, bucket;
+  bool is_null;
+  int tpl_len;
+
+  assert (hjstate->buckets == NULL);
+
+  hjstate->bucket_cnt = (unsigned int) MAX (inner_list_idp->tuple_cnt, HASH_AGGREGATE_DEFAULT_TABLE_SIZE);
+  hjstate->buckets = (HASH_JOIN_ENTRY **) db_private_alloc (thread_p, hjstate->bucket_cnt * sizeof (HASH_JOIN_ENTRY *));
+  if (hjstate->buckets == NULL)
     {
-      QFILE_SET_FLAG (ls_flag, QFILE_FLAG_RESULT_FILE);
+      return ER_FAILED;
     }
+  memset (hjstate->buckets, 0, hjstate->bucket_cnt * sizeof (HASH_JOIN_ENTRY *));
 
-  if (merge_infop->join_type == JOIN_INNER)
+  if (qfile_open_list_scan (inner_list_idp, &inner_sid) != NO_ERROR)
     {
-      /* call list file merge routine */
-      list_id = qexec_merge_list (thread_p, outer_xasl->list_id, inner_xasl->list_id, merge_infop, ls_flag);
+      return ER_FAILED;
     }
-  else
-    {
-      outer_spec = xasl->proc.mergelist.outer_spec_list;
-      inner_spec = xasl->proc.mergelist.inner_spec_list;
 
-      assert (xasl->scan_op_type == S_SELECT);
-      if (qexec_open_scan (thread_p, outer_spec, xasl->proc.mergelist.outer_val_list, &xasl_state->vd, false,
-			   outer_spec->fixed_scan, outer_spec->grouped_scan, true, &outer_spec->s_id,
-			   xasl_state->query_id, S_SELECT, false, NULL) != NO_ERROR)
+  while ((scan = qfile_scan_list_next (thread_p, &inner_sid, &inner_tplrec, PEEK)) == S_SUCCESS)
+    {
+      if (qexec_hash_join_key (inner_tplrec.tpl, merge_infop->ls_inner_column, hjstate->inner_domp,
+			       merge_infop->ls_column_cnt, &hash, &is_null) != NO_ERROR)
 	{
-	  GOTO_EXIT_ON_ERROR;
+	  scan = S_ERROR;
+	  break;
+	}
+      if (is_null)
+	{
+	  continue;
 	}
 
-      if (qexec_open_scan (thread_p, inner_spec, xasl->proc.mergelist.inner_val_list, &xasl_state->vd, false,
-			   inner_spec->fixed_scan, inner_spec->grouped_scan, true, &inner_spec->s_id,
-			   xasl_state->query_id, S_SELECT, false, NULL) != NO_ERROR)
+      /* the peeked tuple lives in the scan page; keep a copy */
+      tpl_len = QFILE_GET_TUPLE_LENGTH (inner_tplrec.tpl);
+      entry = (HASH_JOIN_ENTRY *) db_private_alloc (thread_p, sizeof (HASH_JOIN_ENTRY) + tpl_len);
+      if (entry == NULL)
 	{
-	  GOTO_EXIT_ON_ERROR;
+	  scan = S_ERROR;
+	  break;
 	}
+      entry->tpl = (QFILE_TUPLE) (entry + 1);
+      memcpy (entry->tpl, inner_tplrec.tpl, tpl_len);
+      entry->hash = hash;
 
-      /* call outer join merge routine */
-      list_id =
-	qexec_merge_list_outer (thread_p, &outer_spec->s_id, &inner_spec->s_id, merge_infop, xasl->after_join_pred,
-				xasl_state, ls_flag);
+      bucket = (hash / hjstate->hash_divisor) % hjstate->bucket_cnt;
+      entry->next = hjstate->buckets[bucket];
+      hjstate->buckets[bucket] = entry;
 
-      qexec_close_scan (thread_p, outer_spec);
-      outer_spec = NULL;
+      hjstate->build_rows++;
+    }
 
-      qexec_close_scan (thread_p, inner_spec);
-      inner_spec = NULL;
+  qfile_close_scan (thread_p, &inner_sid);
+
+  return (scan == S_ERROR) ? ER_FAILED : NO_ERROR;
+}
+
+/*
+ * qexec_hash_join_probe () - join the tuples of the outer list with the hash table
+ *   return: NO_ERROR, or ER_code
+ *   hjstate(in/out)    : hash join state
+ *   outer_list_idp(in) : outer list file
+ *   list_idp(in)       : result list file
+ *
+ * Note: Tuples of a bucket that have the same hash number are compared with
+ * qexec_cmp_tpl_vals_merge (), so collisions never produce a result.
+ */
+static int
+qexec_hash_join_probe (THREAD_ENTRY * thread_p, HASH_JOIN_STATE * hjstate, QFILE_LIST_ID * outer_list_idp,
+		       QFILE_LIST_ID * list_idp)
+{
+  QFILE_LIST_MERGE_INFO *merge_infop = hjstate->merge_infop;
+  QFILE_LIST_SCAN_ID outer_sid;
+  QFILE_TUPLE_RECORD outer_tplrec = { NULL, 0 };
+  QFILE_TUPLE_RECORD inner_tplrec;
+  HASH_JOIN_ENTRY *entry;
+  SCAN_CODE scan;
+  DB_VALUE_COMPARE_RESULT val_cmp;
+  unsigned int hash;
+  bool is_null;
+  int nvals = merge_infop->ls_column_cnt;
+  int k;
+
+  if (qfile_open_list_scan (outer_list_idp, &outer_sid) != NO_ERROR)
+    {
+      return ER_FAILED;
     }
 
-  if (list_id == NULL)
+  while ((scan = qfile_scan_list_next (thread_p, &outer_sid, &outer_tplrec, PEEK)) == S_SUCCESS)
     {
-      GOTO_EXIT_ON_ERROR;
+      if (qexec_hash_join_key (outer_tplrec.tpl, merge_infop->ls_outer_column, hjstate->outer_domp, nvals, &hash,
+			       &is_null) != NO_ERROR)
+	{
+	  scan = S_ERROR;
+	  break;
+	}
+      if (is_null)
+	{
+	  continue;
+	}
+
+      hjstate->probe_rows++;
+
+      for (k = 0; k < nvals; k++)
+	{
+	  QFILE_GET_TUPLE_VALUE_HEADER_POSITION (outer_tplrec.tpl, merge_infop->ls_outer_column[k],
+						 hjstate->outer_valp[k]);
+	}
+
+      for (entry = hjstate->buckets[(hash / hjstate->hash_divisor) % hjstate->bucket_cnt]; entry != NULL;
+	   entry = entry->next)
+	{
+	  if (entry->hash != hash)
+	    {
+	      continue;
+	    }
+
+	  for (k = 0; k < nvals; k++)
+	    {
+	      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (entry->tpl, merge_infop->ls_inner_column[k],
+						     hjstate->inner_valp[k]);
+	    }
+
+	  val_cmp = qexec_cmp_tpl_vals_merge (hjstate->outer_valp, hjstate->outer_domp, hjstate->inner_valp,
+					      hjstate->inner_domp, nvals);
+	  if (val_cmp == DB_UNK)
+	    {
+	      scan = S_ERROR;
+	      break;
+	    }
+	  if (val_cmp != DB_EQ)
+	    {
+	      continue;
+	    }
+
+	  inner_tplrec.tpl = entry->tpl;
+	  inner_tplrec.size = QFILE_GET_TUPLE_LENGTH (entry->tpl);
+	  if (qexec_merge_tuple_add_list (thread_p, list_idp, &outer_tplrec, &inner_tplrec, merge_infop,
+					  &hjstate->tplrec) != NO_ERROR)
+	    {
+	      scan = S_ERROR;
+	      break;
+	    }
+	}
+
+      if (scan == S_ERROR)
+	{
+	  break;
+	}
     }
 
-  /* make this the resultant list file */
-  qfile_copy_list_id (xasl->list_id, list_id, true);
-  QFILE_FREE_AND_INIT_LIST_ID (list_id);
+  qfile_close_scan (thread_p, &outer_sid);
 
-  return NO_ERROR;
+  return (scan == S_ERROR) ? ER_FAILED : NO_ERROR;
+}
 
-exit_on_error:
+/*
+ * qexec_hash_join_clear_table () - free the hash table of a hash join
+ *   return:
+ *   hjstate(in/out)    : hash join state
+ */
+static void
+qexec_hash_join_clear_table (THREAD_ENTRY * thread_p, HASH_JOIN_STATE * hjstate)
+{
+  HASH_JOIN_ENTRY *entry, *next;
+  unsigned int i;
 
-  if (outer_spec)
+  if (hjstate->buckets == NULL)
     {
-      qexec_close_scan (thread_p, outer_spec);
+      return;
     }
-  if (inner_spec)
+
+  for (i = 0; i < hjstate->bucket_cnt; i++)
     {
-      qexec_close_scan (thread_p, inner_spec);
+      for (entry = hjstate->buckets[i]; entry != NULL; entry = next)
+	{
+	  next = entry->next;
+	  db_private_free (thread_p, entry);
+	}
     }
 
-  return ER_FAILED;
+  db_private_free_and_init (thread_p, hjstate->buckets);
+  hjstate->bucket_cnt = 0;
 }
 
 /*
- * Interpreter routines
- */
-
-/*
- * qexec_open_scan () -
+ * qexec_hash_join_partition () - distribute the tuples of a list file to
+ *				  partitions by the hash of the join columns
  *   return: NO_ERROR, or ER_code
- *   curr_spec(in)      : Access Specification Node
- *   val_list(in)       : Value list pointer
- *   vd(in)     : Value descriptor
- *   force_select_lock(in)  :
- *   fixed(in)  : Fixed scan flag
- *   grouped(in)        : Grouped scan flag
- *   iscan_oid_order(in)       :
- *   s_id(out)   : Set to the scan identifier
- *   p_mvcc_select_lock_needed(out): true, whether instance lock needed at select
+ *   list_idp(in)       : list file to partition
+ *   col_list(in)       : join column positions in the tuple
+ *   domp(in)   : join column domains
+ *   nvals(in)  : join columns count
+ *   part_list(out)     : part_cnt partition list files
+ *   part_cnt(in)       : partitions count
  *
- * Note: This routine is used to open a scan on an access specification
- * node. A scan identifier is created with the given parameters.
+ * Note: Tuples with a NULL join column are dropped; they never join.
  */
 static int
-qexec_open_scan (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * curr_spec, VAL_LIST * val_list, VAL_DESCR * vd,
-		 bool force_select_lock, int fixed, int grouped, bool iscan_oid_order, SCAN_ID * s_id,
-		 QUERY_ID query_id, SCAN_OPERATION_TYPE scan_op_type, bool scan_immediately_stop,
-		 bool * p_mvcc_select_lock_needed)
+qexec_hash_join_partition (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_idp, int *col_list, TP_DOMAIN ** domp,
+			   int nvals, QFILE_LIST_ID ** part_list, int part_cnt)
 {
-  SCAN_TYPE scan_type;
-  INDX_INFO *indx_info;
-  bool mvcc_select_lock_needed = false;
-  int error_code = NO_ERROR;
+  QFILE_LIST_SCAN_ID sid;
+  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
+  SCAN_CODE scan;
+  unsigned int hash;
+  bool is_null;
+  int p;
 
-  if (curr_spec->pruning_type == DB_PARTITIONED_CLASS && !curr_spec->pruned)
+  for (p = 0; p < part_cnt; p++)
     {
-      error_code = qexec_prune_spec (thread_p, curr_spec, vd, scan_op_type);
-      if (error_code != NO_ERROR)
+      part_list[p] = qfile_open_list (thread_p, &list_idp->type_list, NULL, list_idp->query_id, 0);
+      if (part_list[p] == NULL)
 	{
-	  ASSERT_ERROR ();
-	  goto exit_on_error;
+	  return ER_FAILED;
 	}
     }
 
-  if (curr_spec->type == TARGET_CLASS && mvcc_is_mvcc_disabled_class (&ACCESS_SPEC_CLS_OID (curr_spec)))
+  if (qfile_open_list_scan (list_idp, &sid) != NO_ERROR)
     {
-      assert (!force_select_lock);
-
-      /* We expect to update or delete a non MVCC objects via a scan are only db_serial, db_ha_apply_info and
-       * _db_collation objects. */
-      assert ((scan_op_type != S_DELETE && scan_op_type != S_UPDATE) || oid_is_serial (&ACCESS_SPEC_CLS_OID (curr_spec))
-	      || (oid_check_cached_class_oid (OID_CACHE_HA_APPLY_INFO_CLASS_ID, &ACCESS_SPEC_CLS_OID (curr_spec)))
-	      || (oid_check_cached_class_oid (OID_CACHE_COLLATION_CLASS_ID, &ACCESS_SPEC_CLS_OID (curr_spec))));
+      return ER_FAILED;
     }
-  else
+
+  while ((scan = qfile_scan_list_next (thread_p, &sid, &tplrec, PEEK)) == S_SUCCESS)
     {
-      if (force_select_lock)
+      if (qexec_hash_join_key (tplrec.tpl, col_list, domp, nvals, &hash, &is_null) != NO_ERROR)
 	{
-	  mvcc_select_lock_needed = true;
+	  scan = S_ERROR;
+	  break;
 	}
-      else
+      if (is_null)
 	{
-	  mvcc_select_lock_needed = (curr_spec->flags & ACCESS_SPEC_FLAG_FOR_UPDATE);
+	  continue;
 	}
-    }
 
-  switch (curr_spec->type)
-    {
-    case TARGET_CLASS:
-      if (curr_spec->access == ACCESS_METHOD_SEQUENTIAL)
-	{
-	  /* open a sequential heap file scan */
-	  scan_type = S_HEAP_SCAN;
-	  indx_info = NULL;
-	}
-      else if (curr_spec->access == ACCESS_METHOD_SEQUENTIAL_RECORD_INFO)
-	{
-	  /* open a sequential heap file scan that reads record info */
-	  scan_type = S_HEAP_SCAN_RECORD_INFO;
-	  indx_info = NULL;
-	}
-      else if (curr_spec->access == ACCESS_METHOD_SEQUENTIAL_PAGE_SCAN)
-	{
-	  /* open a sequential heap file scan that reads page info */
-	  scan_type = S_HEAP_PAGE_SCAN;
-	  indx_info = NULL;
-	}
-      else if (curr_spec->access == ACCESS_METHOD_INDEX)
-	{
-	  /* open an indexed heap file scan */
-	  scan_type = S_INDX_SCAN;
-	  indx_info = curr_spec->indexptr;
-	}
-      else if (curr_spec->access == ACCESS_METHOD_INDEX_KEY_INFO)
-	{
-	  scan_type = S_INDX_KEY_INFO_SCAN;
-	  indx_info = curr_spec->indexptr;
-	}
-      else if (curr_spec->access == ACCESS_METHOD_INDEX_NODE_INFO)
+      if (qfile_add_tuple_to_list (thread_p, part_list[hash % part_cnt], tplrec.tpl) != NO_ERROR)
 	{
-	  scan_type = S_INDX_NODE_INFO_SCAN;
-	  indx_info = curr_spec->indexptr;
+	  scan = S_ERROR;
+	  break;
 	}
-      else
-	{
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_XASLNODE, 0);
-	  return ER_QPROC_INVALID_XASLNODE;
-	}			/* if */
+    }
 
-      if (scan_type == S_HEAP_SCAN || scan_type == S_HEAP_SCAN_RECORD_INFO)
-	{
-	  error_code = scan_open_heap_scan (thread_p, s_id, mvcc_select_lock_needed, scan_op_type, fixed, grouped,
-					    curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd,
-					    &ACCESS_SPEC_CLS_OID (curr_spec), &ACCESS_SPEC_HFID (curr_spec),
-					    curr_spec->s.cls_node.cls_regu_list_pred, curr_spec->where_pred,
-					    curr_spec->s.cls_node.cls_regu_list_rest,
-					    curr_spec->s.cls_node.num_attrs_pred,
-					    curr_spec->s.cls_node.attrids_pred, curr_spec->s.cls_node.cache_pred,
-					    curr_spec->s.cls_node.num_attrs_rest, curr_spec->s.cls_node.attrids_rest,
-					    curr_spec->s.cls_node.cache_rest, scan_type,
-					    curr_spec->s.cls_node.cache_reserved,
-					    curr_spec->s.cls_node.cls_regu_list_reserved);
-	  if (error_code != NO_ERROR)
-	    {
-	      ASSERT_ERROR ();
-	      goto exit_on_error;
-	    }
-	}
-      else if (scan_type == S_HEAP_PAGE_SCAN)
-	{
-	  error_code = scan_open_heap_page_scan (thread_p, s_id, val_list, vd, &ACCESS_SPEC_CLS_OID (curr_spec),
-						 &ACCESS_SPEC_HFID (curr_spec), curr_spec->where_pred, scan_type,
-						 curr_spec->s.cls_node.cache_reserved,
-						 curr_spec->s.cls_node.cls_regu_list_reserved);
-	  if (error_code != NO_ERROR)
-	    {
-	      ASSERT_ERROR ();
-	      goto exit_on_error;
-	    }
-	}
-      else if (scan_type == S_INDX_KEY_INFO_SCAN)
-	{
-	  error_code =
-	    scan_open_index_key_info_scan (thread_p, s_id, val_list, vd, indx_info, &ACCESS_SPEC_CLS_OID (curr_spec),
-					   &ACCESS_SPEC_HFID (curr_spec), curr_spec->where_pred,
-					   curr_spec->s.cls_node.cls_output_val_list, iscan_oid_order, query_id,
-					   curr_spec->s.cls_node.cache_reserved,
-					   curr_spec->s.cls_node.cls_regu_list_reserved);
-	  if (error_code != NO_ERROR)
-	    {
-	      ASSERT_ERROR ();
-	      goto exit_on_error;
-	    }
-	  /* monitor */
-	  perfmon_inc_stat (thread_p, PSTAT_QM_NUM_ISCANS);
-	}
-      else if (scan_type == S_INDX_NODE_INFO_SCAN)
-	{
-	  error_code = scan_open_index_node_info_scan (thread_p, s_id, val_list, vd, indx_info, curr_spec->where_pred,
-						       curr_spec->s.cls_node.cache_reserved,
-						       curr_spec->s.cls_node.cls_regu_list_reserved);
-	  if (error_code != NO_ERROR)
-	    {
-	      ASSERT_ERROR ();
-	      goto exit_on_error;
-	    }
-	  /* monitor */
-	  perfmon_inc_stat (thread_p, PSTAT_QM_NUM_ISCANS);
-	}
-      else			/* S_INDX_SCAN */
-	{
-	  error_code = scan_open_index_scan (thread_p, s_id, mvcc_select_lock_needed, scan_op_type, fixed, grouped,
-					     curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd, indx_info,
-					     &ACCESS_SPEC_CLS_OID (curr_spec), &ACCESS_SPEC_HFID (curr_spec),
-					     curr_spec->s.cls_node.cls_regu_list_key, curr_spec->where_key,
-					     curr_spec->s.cls_node.cls_regu_list_pred, curr_spec->where_pred,
-					     curr_spec->s.cls_node.cls_regu_list_rest, curr_spec->where_range,
-					     curr_spec->s.cls_node.cls_regu_list_range,
-					     curr_spec->s.cls_node.cls_output_val_list,
-					     curr_spec->s.cls_node.cls_regu_val_list,
-					     curr_spec->s.cls_node.num_attrs_key, curr_spec->s.cls_node.attrids_key,
-					     curr_spec->s.cls_node.cache_key, curr_spec->s.cls_node.num_attrs_pred,
-					     curr_spec->s.cls_node.attrids_pred, curr_spec->s.cls_node.cache_pred,
-					     curr_spec->s.cls_node.num_attrs_rest, curr_spec->s.cls_node.attrids_rest,
-					     curr_spec->s.cls_node.cache_rest, curr_spec->s.cls_node.num_attrs_range,
-					     curr_spec->s.cls_node.attrids_range, curr_spec->s.cls_node.cache_range,
-					     iscan_oid_order, query_id);
-	  if (error_code != NO_ERROR)
-	    {
-	      ASSERT_ERROR ();
-	      goto exit_on_error;
-	    }
-	  /* monitor */
-	  perfmon_inc_stat (thread_p, PSTAT_QM_NUM_ISCANS);
-	}
-      break;
+  qfile_close_scan (thread_p, &sid);
 
-    case TARGET_CLASS_ATTR:
-      error_code =
-	scan_open_class_attr_scan (thread_p, s_id, grouped, curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd,
-				   &ACCESS_SPEC_CLS_OID (curr_spec), &ACCESS_SPEC_HFID (curr_spec),
-				   curr_spec->s.cls_node.cls_regu_list_pred, curr_spec->where_pred,
-				   curr_spec->s.cls_node.cls_regu_list_rest, curr_spec->s.cls_node.num_attrs_pred,
-				   curr_spec->s.cls_node.attrids_pred, curr_spec->s.cls_node.cache_pred,
-				   curr_spec->s.cls_node.num_attrs_rest, curr_spec->s.cls_node.attrids_rest,
-				   curr_spec->s.cls_node.cache_rest);
-      if (error_code != NO_ERROR)
+  for (p = 0; p < part_cnt; p++)
+    {
+      qfile_close_list (thread_p, part_list[p]);
+    }
+
+  return (scan == S_ERROR) ? ER_FAILED : NO_ERROR;
+}
+
+/*
+ * qexec_hash_join_list () -
+ *   return: QFILE_LIST_ID *, or NULL
+ *   outer_list_idp(in) : First (left) list file to be joined
+ *   inner_list_idp(in) : Second (right) list file to be joined
+ *   merge_infop(in)    : List file merge information
+ *   ls_flag(in)        :
+ *   stats(out) : hash join trace statistics
+ *
+ * Note: This routine inner joins the given two list files, which need not be
+ * sorted, and returns the result list file identifier. The inner list is put
+ * into an in-memory hash table and the outer list probes it. If the inner
+ * list is larger than max_hash_join_size, both lists are first split into
+ * partitions by the hash of the join columns and each pair of partitions is
+ * joined the same way.
+ *
+ * Note: Like qexec_merge_list (), the routine assumes that the join column
+ * data types for both list files are same.
+ */
+static QFILE_LIST_ID *
+qexec_hash_join_list (THREAD_ENTRY * thread_p, QFILE_LIST_ID * outer_list_idp, QFILE_LIST_ID * inner_list_idp,
+		      QFILE_LIST_MERGE_INFO * merge_infop, int ls_flag, HASHJOIN_STATS * stats)
+{
+  QFILE_LIST_ID *list_idp = NULL;
+  QFILE_LIST_ID **outer_part_list = NULL, **inner_part_list = NULL;
+  QFILE_TUPLE_VALUE_TYPE_LIST type_list;
+  HASH_JOIN_STATE hjstate;
+  UINT64 mem_limit, inner_size;
+  int nvals, part_cnt = 0;
+  int k, p;
+
+  memset (&hjstate, 0, sizeof (HASH_JOIN_STATE));
+  hjstate.merge_infop = merge_infop;
+  hjstate.hash_divisor = 1;
+
+  /* get merge columns count */
+  nvals = merge_infop->ls_column_cnt;
+
+  /* form the typelist for the resultant list file */
+  type_list.type_cnt = merge_infop->ls_pos_cnt;
+  type_list.domp = (TP_DOMAIN **) malloc (type_list.type_cnt * sizeof (TP_DOMAIN *));
+  if (type_list.domp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  for (k = 0; k < type_list.type_cnt; k++)
+    {
+      type_list.domp[k] = ((merge_infop->ls_outer_inner_list[k] == QFILE_OUTER_LIST)
+			   ? outer_list_idp->type_list.domp[merge_infop->ls_pos_list[k]]
+			   : inner_list_idp->type_list.domp[merge_infop->ls_pos_list[k]]);
+    }
+
+  /* open the result list file; same query id with outer(inner) list file */
+  list_idp = qfile_open_list (thread_p, &type_list, NULL, outer_list_idp->query_id, ls_flag);
+  if (list_idp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  if (outer_list_idp->tuple_cnt == 0 || inner_list_idp->tuple_cnt == 0)
+    {
+      goto exit_on_end;
+    }
+
+  /* allocate the area to store the merged tuple */
+  if (qfile_reallocate_tuple (&hjstate.tplrec, DB_PAGESIZE) != NO_ERROR)
+    {
+      goto exit_on_error;
+    }
+
+  /* join column domain info */
+  hjstate.outer_domp = (TP_DOMAIN **) db_private_alloc (thread_p, nvals * sizeof (TP_DOMAIN *));
+  hjstate.inner_domp = (TP_DOMAIN **) db_private_alloc (thread_p, nvals * sizeof (TP_DOMAIN *));
+  hjstate.outer_valp = (char **) db_private_alloc (thread_p, nvals * sizeof (char *));
+  hjstate.inner_valp = (char **) db_private_alloc (thread_p, nvals * sizeof (char *));
+  if (hjstate.outer_domp == NULL || hjstate.inner_domp == NULL || hjstate.outer_valp == NULL
+      || hjstate.inner_valp == NULL)
+    {
+      goto exit_on_error;
+    }
+
+  for (k = 0; k < nvals; k++)
+    {
+      hjstate.outer_domp[k] = outer_list_idp->type_list.domp[merge_infop->ls_outer_column[k]];
+      hjstate.inner_domp[k] = inner_list_idp->type_list.domp[merge_infop->ls_inner_column[k]];
+
+      /* values of different types may compare equal but hash differently */
+      if (TP_DOMAIN_TYPE (hjstate.outer_domp[k]) != TP_DOMAIN_TYPE (hjstate.inner_domp[k]))
 	{
-	  ASSERT_ERROR ();
+	  assert (false);
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_XASLNODE, 0);
 	  goto exit_on_error;
 	}
-      break;
+    }
 
-    case TARGET_LIST:
-      /* open a list file scan */
-      error_code =
-	scan_open_list_scan (thread_p, s_id, grouped, curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd,
-			     ACCESS_SPEC_LIST_ID (curr_spec), curr_spec->s.list_node.list_regu_list_pred,
-			     curr_spec->where_pred, curr_spec->s.list_node.list_regu_list_rest);
-      if (error_code != NO_ERROR)
+  mem_limit = prm_get_bigint_value (PRM_ID_MAX_HASH_JOIN_SIZE);
+  inner_size = (UINT64) inner_list_idp->page_cnt * DB_PAGESIZE;
+
+  if (inner_size <= mem_limit)
+    {
+      if (qexec_hash_join_build (thread_p, &hjstate, inner_list_idp) != NO_ERROR
+	  || qexec_hash_join_probe (thread_p, &hjstate, outer_list_idp, list_idp) != NO_ERROR)
 	{
-	  ASSERT_ERROR ();
 	  goto exit_on_error;
 	}
-      break;
+      qexec_hash_join_clear_table (thread_p, &hjstate);
+    }
+  else
+    {
+      /* aim at partitions of half the memory budget, since the hash table costs more than the list pages */
+      part_cnt = (int) MIN (inner_size * 2 / mem_limit + 1, HASH_JOIN_MAX_PARTITIONS);
+      hjstate.hash_divisor = part_cnt;
 
-    case TARGET_SHOWSTMT:
-      /* open a showstmt scan */
-      error_code =
-	scan_open_showstmt_scan (thread_p, s_id, grouped, curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd,
-				 curr_spec->where_pred, curr_spec->s.showstmt_node.show_type,
-				 curr_spec->s.showstmt_node.arg_list);
-      if (error_code != NO_ERROR)
+      outer_part_list = (QFILE_LIST_ID **) db_private_alloc (thread_p, part_cnt * sizeof (QFILE_LIST_ID *));
+      inner_part_list = (QFILE_LIST_ID **) db_private_alloc (thread_p, part_cnt * sizeof (QFILE_LIST_ID *));
+      if (outer_part_list == NULL || inner_part_list == NULL)
 	{
-	  ASSERT_ERROR ();
 	  goto exit_on_error;
 	}
-      break;
+      memset (outer_part_list, 0, part_cnt * sizeof (QFILE_LIST_ID *));
+      memset (inner_part_list, 0, part_cnt * sizeof (QFILE_LIST_ID *));
 
-    case TARGET_REGUVAL_LIST:
-      /* open a regu value list scan */
-      error_code =
-	scan_open_values_scan (thread_p, s_id, grouped, curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd,
-			       ACCESS_SPEC_RLIST_VALPTR_LIST (curr_spec));
-      if (error_code != NO_ERROR)
+      if (qexec_hash_join_partition (thread_p, inner_list_idp, merge_infop->ls_inner_column, hjstate.inner_domp, nvals,
+				     inner_part_list, part_cnt) != NO_ERROR
+	  || qexec_hash_join_partition (thread_p, outer_list_idp, merge_infop->ls_outer_column, hjstate.outer_domp,
+					nvals, outer_part_list, part_cnt) != NO_ERROR)
 	{
-	  ASSERT_ERROR ();
 	  goto exit_on_error;
 	}
-      break;
 
-    case TARGET_SET:
-      /* open a set based derived table scan */
-      error_code =
-	scan_open_set_scan (thread_p, s_id, grouped, curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd,
-			    ACCESS_SPEC_SET_PTR (curr_spec), ACCESS_SPEC_SET_REGU_LIST (curr_spec),
-			    curr_spec->where_pred);
-      if (error_code != NO_ERROR)
+      for (p = 0; p < part_cnt; p++)
 	{
-	  ASSERT_ERROR ();
-	  goto exit_on_error;
+	  if (inner_part_list[p]->tuple_cnt > 0 && outer_part_list[p]->tuple_cnt > 0)
+	    {
+	      if (qexec_hash_join_build (thread_p, &hjstate, inner_part_list[p]) != NO_ERROR
+		  || qexec_hash_join_probe (thread_p, &hjstate, outer_part_list[p], list_idp) != NO_ERROR)
+		{
+		  goto exit_on_error;
+		}
+	      qexec_hash_join_clear_table (thread_p, &hjstate);
+	    }
+
+	  /* this pair of partitions is done; release its pages before the next one */
+	  qfile_destroy_list (thread_p, inner_part_list[p]);
+	  QFILE_FREE_AND_INIT_LIST_ID (inner_part_list[p]);
+	  qfile_destroy_list (thread_p, outer_part_list[p]);
+	  QFILE_FREE_AND_INIT_LIST_ID (outer_part_list[p]);
 	}
-      break;
+    }
 
-    case TARGET_JSON_TABLE:
-      /* open a json table based derived table scan */
-      error_code =
-	scan_open_json_table_scan (thread_p, s_id, grouped, curr_spec->single_fetch, curr_spec->s_dbval, val_list,
-				   vd, curr_spec->where_pred);
-      if (error_code != NO_ERROR)
+exit_on_end:
+  if (stats != NULL)
+    {
+      stats->run_hashjoin = true;
+      stats->build_rows += hjstate.build_rows;
+      stats->probe_rows += hjstate.probe_rows;
+      stats->partitions = MAX (stats->partitions, part_cnt);
+    }
+
+  qexec_hash_join_clear_table (thread_p, &hjstate);
+
+  for (p = 0; p < part_cnt; p++)
+    {
+      if (inner_part_list != NULL && inner_part_list[p] != NULL)
 	{
-	  ASSERT_ERROR ();
-	  goto exit_on_error;
+	  qfile_close_list (thread_p, inner_part_list[p]);
+	  qfile_destroy_list (thread_p, inner_part_list[p]);
+	  QFILE_FREE_AND_INIT_LIST_ID (inner_part_list[p]);
 	}
-      break;
-
-    case TARGET_METHOD:
-      error_code =
-	scan_open_method_scan (thread_p, s_id, grouped, curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd,
-			       ACCESS_SPEC_METHOD_LIST_ID (curr_spec), ACCESS_SPEC_METHOD_SIG_LIST (curr_spec));
-      if (error_code != NO_ERROR)
+      if (outer_part_list != NULL && outer_part_list[p] != NULL)
 	{
-	  ASSERT_ERROR ();
-	  goto exit_on_error;
+	  qfile_close_list (thread_p, outer_part_list[p]);
+	  qfile_destroy_list (thread_p, outer_part_list[p]);
+	  QFILE_FREE_AND_INIT_LIST_ID (outer_part_list[p]);
 	}
-      break;
+    }
+  if (inner_part_list)
+    {
+      db_private_free_and_init (thread_p, inner_part_list);
+    }
+  if (outer_part_list)
+    {
+      db_private_free_and_init (thread_p, outer_part_list);
+    }
 
-    default:
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_XASLNODE, 0);
-      error_code = ER_QPROC_INVALID_XASLNODE;
-      goto exit_on_error;
-    }				/* switch */
+  if (type_list.domp)
+    {
+      free_and_init (type_list.domp);
+    }
 
-  s_id->scan_immediately_stop = scan_immediately_stop;
+  if (hjstate.tplrec.tpl)
+    {
+      db_private_free_and_init (thread_p, hjstate.tplrec.tpl);
+    }
+  if (hjstate.outer_domp)
+    {
+      db_private_free_and_init (thread_p, hjstate.outer_domp);
+    }
+  if (hjstate.inner_domp)
+    {
+      db_private_free_and_init (thread_p, hjstate.inner_domp);
+    }
+  if (hjstate.outer_valp)
+    {
+      db_private_free_and_init (thread_p, hjstate.outer_valp);
+    }
+  if (hjstate.inner_valp)
+    {
+      db_private_free_and_init (thread_p, hjstate.inner_valp);
+    }
 
-  if (p_mvcc_select_lock_needed)
+  if (list_idp)
     {
-      *p_mvcc_select_lock_needed = mvcc_select_lock_needed;
+      qfile_close_list (thread_p, list_idp);
     }
 
-  return NO_ERROR;
+  return list_idp;
 
 exit_on_error:
-
-  if (curr_spec->pruning_type == DB_PARTITIONED_CLASS && curr_spec->parts != NULL)
+  if (list_idp)
     {
-      /* reset pruning info */
-      db_private_free (thread_p, curr_spec->parts);
-      curr_spec->parts = NULL;
-      curr_spec->curent = NULL;
-      curr_spec->pruned = false;
+      qfile_close_list (thread_p, list_idp);
+      QFILE_FREE_AND_INIT_LIST_ID (list_idp);
     }
 
-  ASSERT_ERROR_AND_SET (error_code);
-  return error_code;
+  list_idp = NULL;
+  goto exit_on_end;
 }
 
 /*
- * qexec_close_scan () -
- *   return:
- *   curr_spec(in)      : Access Specification Node
+ * qexec_merge_listfiles () -
+ *   return: NO_ERROR, or ER_code
+ *   xasl(in)   : XASL Tree pointer
+ *   xasl_state(in)     :
  *
- * Note: This routine is used to close the access specification node scan.
+ * Note: This function is used for a direct merge of two LIST files
+ * during XASL tree interpretation.
+ *
+ * Note: For a direct list file merge, currently the outer and inner columns
+ * should have the same data type.
  */
-static void
-qexec_close_scan (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * curr_spec)
+static int
+qexec_merge_listfiles (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state)
 {
-  if (curr_spec == NULL)
+  QFILE_LIST_ID *list_id = NULL;
+  ACCESS_SPEC_TYPE *outer_spec = NULL;	/* left */
+  ACCESS_SPEC_TYPE *inner_spec = NULL;	/* right */
+  QFILE_LIST_MERGE_INFO *merge_infop = &(xasl->proc.mergelist.ls_merge);
+  XASL_NODE *outer_xasl, *inner_xasl;
+  int ls_flag = 0;
+
+  outer_xasl = xasl->proc.mergelist.outer_xasl;
+  inner_xasl = xasl->proc.mergelist.inner_xasl;
+
+  /* open the empty list file if not already open */
+
+  if (outer_xasl->list_id->type_list.type_cnt == 0)
     {
-      return;
+      /* start main block iterations */
+      if (qexec_start_mainblock_iterations (thread_p, outer_xasl, xasl_state) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+    }
+  if (inner_xasl->list_id->type_list.type_cnt == 0)
+    {
+      /* start main block iterations */
+      if (qexec_start_mainblock_iterations (thread_p, inner_xasl, xasl_state) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
     }
 
-  /* monitoring */
-  switch (curr_spec->type)
+  /* If MERGELIST_PROC does not have 'order by' (xasl->orderby_list), then the list file to be open at here will be the
+   * last one. Otherwise, the last list file will be open at qexec_orderby_distinct(). (Note that only one that can
+   * have 'group by' is BUILDLIST_PROC type.) And, the top most XASL is the other condition for the list file to be the
+   * last result file. */
+
+  QFILE_SET_FLAG (ls_flag, QFILE_FLAG_ALL);
+  if (XASL_IS_FLAGED (xasl, XASL_TOP_MOST_XASL) && XASL_IS_FLAGED (xasl, XASL_TO_BE_CACHED)
+      && (xasl->orderby_list == NULL || XASL_IS_FLAGED (xasl, XASL_SKIP_ORDERBY_LIST)) && xasl->option != Q_DISTINCT)
     {
-    case TARGET_CLASS:
-      if (curr_spec->access == ACCESS_METHOD_SEQUENTIAL || curr_spec->access == ACCESS_METHOD_SEQUENTIAL_RECORD_INFO
-	  || curr_spec->access == ACCESS_METHOD_SEQUENTIAL_PAGE_SCAN)
+      QFILE_SET_FLAG (ls_flag, QFILE_FLAG_RESULT_FILE);
+    }
+
+  if (merge_infop->join_method == QFILE_HASH_JOIN)
+    {
+      HASHJOIN_STATS *stats = NULL;
+      TSC_TICKS start_tick, end_tick;
+      TSCTIMEVAL tv_diff;
+
+      /* the optimizer makes hash joins of inner joins only */
+      assert (merge_infop->join_type == JOIN_INNER);
+
+      if (thread_is_on_trace (thread_p))
 	{
-	  perfmon_inc_stat (thread_p, PSTAT_QM_NUM_SSCANS);
+	  stats = &xasl->hashjoin_stats;
+	  tsc_getticks (&start_tick);
 	}
-      else if (IS_ANY_INDEX_ACCESS (curr_spec->access))
+
+      /* call list file hash join routine */
+      list_id =
+	qexec_hash_join_list (thread_p, outer_xasl->list_id, inner_xasl->list_id, merge_infop, ls_flag, stats);
+
+      if (stats != NULL)
 	{
-	  perfmon_inc_stat (thread_p, PSTAT_QM_NUM_ISCANS);
+	  tsc_getticks (&end_tick);
+	  tsc_elapsed_time_usec (&tv_diff, end_tick, start_tick);
+	  TSC_ADD_TIMEVAL (stats->hashjoin_time, tv_diff);
 	}
+    }
+  else if (merge_infop->join_type == JOIN_INNER)
+    {
+      /* call list file merge routine */
+      list_id = qexec_merge_list (thread_p, outer_xasl->list_id, inner_xasl->list_id, merge_infop, ls_flag);
+    }
+  else
+    {
+      outer_spec = xasl->proc.mergelist.outer_spec_list;
+      inner_spec = xasl->proc.mergelist.inner_spec_list;
 
-      if (curr_spec->parts != NULL)
+      assert (xasl->scan_op_type == S_SELECT);
+      if (qexec_open_scan (thread_p, outer_spec, xasl->proc.mergelist.outer_val_list, &xasl_state->vd, false,
+			   outer_spec->fixed_scan, outer_spec->grouped_scan, true, &outer_spec->s_id,
+			   xasl_state->query_id, S_SELECT, false, NULL) != NO_ERROR)
 	{
-	  /* reset pruning info */
-	  db_private_free (thread_p, curr_spec->parts);
-	  curr_spec->parts = NULL;
-	  curr_spec->curent = NULL;
-	  curr_spec->pruned = false;
+	  GOTO_EXIT_ON_ERROR;
 	}
-      break;
 
-    case TARGET_CLASS_ATTR:
-      break;
+      if (qexec_open_scan (thread_p, inner_spec, xasl->proc.mergelist.inner_val_list, &xasl_state->vd, false,
+			   inner_spec->fixed_scan, inner_spec->grouped_scan, true, &inner_spec->s_id,
+			   xasl_state->query_id, S_SELECT, false, NULL) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
 
-    case TARGET_LIST:
-      perfmon_inc_stat (thread_p, PSTAT_QM_NUM_LSCANS);
-      break;
+      /* call outer join merge routine */
+      list_id =
+	qexec_merge_list_outer (thread_p, &outer_spec->s_id, &inner_spec->s_id, merge_infop, xasl->after_join_pred,
+				xasl_state, ls_flag);
 
-    case TARGET_SHOWSTMT:
-      /* do nothing */
-      break;
+      qexec_close_scan (thread_p, outer_spec);
+      outer_spec = NULL;
 
-    case TARGET_REGUVAL_LIST:
-      /* currently do nothing */
-      break;
+      qexec_close_scan (thread_p, inner_spec);
+      inner_spec = NULL;
+    }
 
-    case TARGET_SET:
-      perfmon_inc_stat (thread_p, PSTAT_QM_NUM_SETSCANS);
-      break;
+  if (list_id == NULL)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
 
-    case TARGET_JSON_TABLE:
-      /* currently do nothing
-         todo: check if here need to add something
-       */
-      break;
+  /* make this the resultant list file */
+  qfile_copy_list_id (xasl->list_id, list_id, true);
+  QFILE_FREE_AND_INIT_LIST_ID (list_id);
 
-    case TARGET_METHOD:
-      perfmon_inc_stat (thread_p, PSTAT_QM_NUM_METHSCANS);
-      break;
+  return NO_ERROR;
+
+exit_on_error:
+
+  if (outer_spec)
+    {
+      qexec_close_scan (thread_p, outer_spec);
+    }
+  if (inner_spec)
+    {
+      qexec_close_scan (thread_p, inner_spec);
     }
 
-  scan_close_scan (thread_p, &curr_spec->s_id);
+  return ER_FAILED;
 }
 
 /*
- * qexec_end_scan () -
- *   return:
+ * Interpreter routines
+ */
+
+/*
+ * qexec_open_scan () -
+ *   return: NO_ERROR, or ER_code
  *   curr_spec(in)      : Access Specification Node
+ *   val_list(in)       : Value list pointer
+ *   vd(in)     : Value descriptor
+ *   force_select_lock(in)  :
+ *   fixed(in)  : Fixed scan flag
+ *   grouped(in)        : Grouped scan flag
+ *   iscan_oid_order(in)       :
+ *   s_id(out)   : Set to the scan identifier
+ *   p_mvcc_select_lock_needed(out): true, whether instance lock needed at select
  *
- * Note: This routine is used to end the access specification node scan.
- *
- * Note: This routine is called for ERROR CASE scan end operation.
+ * Note: This routine is used to open a scan on an access specification
+ * node. A scan identifier is created with the given parameters.
  */
-static void
-qexec_end_scan (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * curr_spec)
+static int
+qexec_open_scan (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * curr_spec, VAL_LIST * val_list, VAL_DESCR * vd,
+		 bool force_select_lock, int fixed, int grouped, bool iscan_oid_order, SCAN_ID * s_id,
+		 QUERY_ID query_id, SCAN_OPERATION_TYPE scan_op_type, bool scan_immediately_stop,
+		 bool * p_mvcc_select_lock_needed)
 {
-  if (curr_spec)
-    {
-      scan_end_scan (thread_p, &curr_spec->s_id);
-    }
-}
+  SCAN_TYPE scan_type;
+  INDX_INFO *indx_info;
+  bool mvcc_select_lock_needed = false;
+  int error_code = NO_ERROR;
 
-/*
- * qexec_next_merge_block () -
- *   return:
- *   spec(in)   :
- */
-static SCAN_CODE
-qexec_next_merge_block (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE ** spec)
-{
-  SCAN_CODE sb_scan;
-
-  if (scan_start_scan (thread_p, &(*spec)->s_id) != NO_ERROR)
-    {
-      return S_ERROR;
-    }
-
-  do
+  if (curr_spec->pruning_type == DB_PARTITIONED_CLASS && !curr_spec->pruned)
     {
-      sb_scan = scan_next_scan_block (thread_p, &(*spec)->s_id);
-      if (sb_scan == S_SUCCESS)
+      error_code = qexec_prune_spec (thread_p, curr_spec, vd, scan_op_type);
+      if (error_code != NO_ERROR)
 	{
-	  return S_SUCCESS;
+	  ASSERT_ERROR ();
+	  goto exit_on_error;
 	}
-      else if (sb_scan == S_END)
-	{
-	  /* close old scan */
-	  scan_end_scan (thread_p, &(*spec)->s_id);
-
-	  /* move to the following access specifications left */
-	  *spec = (*spec)->next;
-
-	  /* check for and skip the case of empty heap files */
-	  while (*spec != NULL && QEXEC_EMPTY_ACCESS_SPEC_SCAN (*spec))
-	    {
-	      *spec = (*spec)->next;
-	    }
+    }
 
-	  if (*spec == NULL)
-	    {
-	      return S_END;
-	    }
+  if (curr_spec->type == TARGET_CLASS && mvcc_is_mvcc_disabled_class (&ACCESS_SPEC_CLS_OID (curr_spec)))
+    {
+      assert (!force_select_lock);
 
-	  /* initialize scan */
-	  if (scan_start_scan (thread_p, &(*spec)->s_id) != NO_ERROR)
-	    {
-	      return S_ERROR;
-	    }
+      /* We expect to update or delete a non MVCC objects via a scan are only db_serial, db_ha_apply_info and
+       * _db_collation objects. */
+      assert ((scan_op_type != S_DELETE && scan_op_type != S_UPDATE) || oid_is_serial (&ACCESS_SPEC_CLS_OID (curr_spec))
+	      || (oid_check_cached_class_oid (OID_CACHE_HA_APPLY_INFO_CLASS_ID, &ACCESS_SPEC_CLS_OID (curr_spec)))
+	      || (oid_check_cached_class_oid (OID_CACHE_COLLATION_CLASS_ID, &ACCESS_SPEC_CLS_OID (curr_spec))));
+    }
+  else
+    {
+      if (force_select_lock)
+	{
+	  mvcc_select_lock_needed = true;
 	}
       else
 	{
-	  return S_ERROR;
+	  mvcc_select_lock_needed = (curr_spec->flags & ACCESS_SPEC_FLAG_FOR_UPDATE);
 	}
-
     }
-  while (1);
-}
-
-/*
- * qexec_next_scan_block () -
- *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
- *   xasl(in)   : XASL Tree pointer
- *
- * Note: This function is used to move the current access specification
- * node scan identifier for the given XASL block to the next
- * scan block. If there are no more scan blocks for the current
- * access specfication node, it moves to the next access
- * specification, if any, and starts the new scan block for that
- * node. If there are no more access specification nodes left,
- * it returns S_END.
- */
-static SCAN_CODE
-qexec_next_scan_block (THREAD_ENTRY * thread_p, XASL_NODE * xasl)
-{
-  SCAN_CODE sb_scan;
-  OID *class_oid;
-  HFID *class_hfid;
 
-  if (xasl->curr_spec == NULL)
+  switch (curr_spec->type)
     {
-      /* initialize scan id */
-      xasl->curr_spec = xasl->spec_list;
-
-      /* check for and skip the case of empty heap file cases */
-      while (xasl->curr_spec != NULL && QEXEC_EMPTY_ACCESS_SPEC_SCAN (xasl->curr_spec))
+    case TARGET_CLASS:
+      if (curr_spec->access == ACCESS_METHOD_SEQUENTIAL)
 	{
-	  xasl->curr_spec = xasl->curr_spec->next;
+	  /* open a sequential heap file scan */
+	  scan_type = S_HEAP_SCAN;
+	  indx_info = NULL;
 	}
-
-      if (xasl->curr_spec == NULL)
+      else if (curr_spec->access == ACCESS_METHOD_SEQUENTIAL_RECORD_INFO)
 	{
-	  return S_END;
+	  /* open a sequential heap file scan that reads record info */
+	  scan_type = S_HEAP_SCAN_RECORD_INFO;
+	  indx_info = NULL;
 	}
-
-      assert (xasl->curr_spec != NULL);
-
-      /* initialize scan */
-      if ((xasl->curr_spec->type == TARGET_CLASS || xasl->curr_spec->type == TARGET_CLASS_ATTR)
-	  && xasl->curr_spec->parts != NULL && xasl->curr_spec->curent == NULL
-	  && xasl->curr_spec->access != ACCESS_METHOD_INDEX_NODE_INFO)
+      else if (curr_spec->access == ACCESS_METHOD_SEQUENTIAL_PAGE_SCAN)
 	{
-	  /* initialize the scan_id for partitioned classes */
-	  if (xasl->curr_spec->access == ACCESS_METHOD_SEQUENTIAL
-	      || xasl->curr_spec->access == ACCESS_METHOD_SEQUENTIAL_RECORD_INFO)
-	    {
-	      class_oid = &xasl->curr_spec->s_id.s.hsid.cls_oid;
-	      class_hfid = &xasl->curr_spec->s_id.s.hsid.hfid;
-	    }
-	  else if (xasl->curr_spec->access == ACCESS_METHOD_SEQUENTIAL_PAGE_SCAN)
-	    {
-	      class_oid = &xasl->curr_spec->s_id.s.hpsid.cls_oid;
-	      class_hfid = &xasl->curr_spec->s_id.s.hpsid.hfid;
-	    }
-	  else if (xasl->curr_spec->access == ACCESS_METHOD_INDEX
-		   || xasl->curr_spec->access == ACCESS_METHOD_INDEX_KEY_INFO)
-	    {
-	      class_oid = &xasl->curr_spec->s_id.s.isid.cls_oid;
-	      class_hfid = &xasl->curr_spec->s_id.s.isid.hfid;
-	    }
-	  else
-	    {
-	      assert (false);
-	      return S_ERROR;
-	    }
-
-	  COPY_OID (class_oid, &ACCESS_SPEC_CLS_OID (xasl->curr_spec));
-	  HFID_COPY (class_hfid, &ACCESS_SPEC_HFID (xasl->curr_spec));
+	  /* open a sequential heap file scan that reads page info */
+	  scan_type = S_HEAP_PAGE_SCAN;
+	  indx_info = NULL;
 	}
-
-      if (scan_start_scan (thread_p, &xasl->curr_spec->s_id) != NO_ERROR)
+      else if (curr_spec->access == ACCESS_METHOD_INDEX)
 	{
-	  return S_ERROR;
+	  /* open an indexed heap file scan */
+	  scan_type = S_INDX_SCAN;
+	  indx_info = curr_spec->indexptr;
 	}
-    }
-
-  do
-    {
-      sb_scan = scan_next_scan_block (thread_p, &xasl->curr_spec->s_id);
-      if (sb_scan == S_SUCCESS)
+      else if (curr_spec->access == ACCESS_METHOD_INDEX_KEY_INFO)
 	{
-	  return S_SUCCESS;
+	  scan_type = S_INDX_KEY_INFO_SCAN;
+	  indx_info = curr_spec->indexptr;
 	}
-      else if (sb_scan == S_END)
+      else if (curr_spec->access == ACCESS_METHOD_INDEX_NODE_INFO)
 	{
-	  /* if curr_spec is a partitioned class, do not move to the next spec unless we went through all partitions */
-	  SCAN_CODE s_parts = qexec_init_next_partition (thread_p, xasl->curr_spec);
-	  if (s_parts == S_SUCCESS)
-	    {
-	      /* successfully moved to the next partition */
-	      continue;
-	    }
-	  else if (s_parts == S_ERROR)
-	    {
-	      return S_ERROR;
-	    }
-
-	  /* close old scan */
-	  scan_end_scan (thread_p, &xasl->curr_spec->s_id);
-
-	  /* move to the following access specifications left */
-	  xasl->curr_spec = xasl->curr_spec->next;
+	  scan_type = S_INDX_NODE_INFO_SCAN;
+	  indx_info = curr_spec->indexptr;
+	}
+      else
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_XASLNODE, 0);
+	  return ER_QPROC_INVALID_XASLNODE;
+	}			/* if */
 
-	  /* check for and skip the case of empty heap files */
-	  while (xasl->curr_spec != NULL && QEXEC_EMPTY_ACCESS_SPEC_SCAN (xasl->curr_spec))
+      if (scan_type == S_HEAP_SCAN || scan_type == S_HEAP_SCAN_RECORD_INFO)
+	{
+	  error_code = scan_open_heap_scan (thread_p, s_id, mvcc_select_lock_needed, scan_op_type, fixed, grouped,
+					    curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd,
+					    &ACCESS_SPEC_CLS_OID (curr_spec), &ACCESS_SPEC_HFID (curr_spec),
+					    curr_spec->s.cls_node.cls_regu_list_pred, curr_spec->where_pred,
+					    curr_spec->s.cls_node.cls_regu_list_rest,
+					    curr_spec->s.cls_node.num_attrs_pred,
+					    curr_spec->s.cls_node.attrids_pred, curr_spec->s.cls_node.cache_pred,
+					    curr_spec->s.cls_node.num_attrs_rest, curr_spec->s.cls_node.attrids_rest,
+					    curr_spec->s.cls_node.cache_rest, scan_type,
+					    curr_spec->s.cls_node.cache_reserved,
+					    curr_spec->s.cls_node.cls_regu_list_reserved);
+	  if (error_code != NO_ERROR)
 	    {
-	      xasl->curr_spec = xasl->curr_spec->next;
+	      ASSERT_ERROR ();
+	      goto exit_on_error;
 	    }
-
-	  if (xasl->curr_spec == NULL)
+	}
+      else if (scan_type == S_HEAP_PAGE_SCAN)
+	{
+	  error_code = scan_open_heap_page_scan (thread_p, s_id, val_list, vd, &ACCESS_SPEC_CLS_OID (curr_spec),
+						 &ACCESS_SPEC_HFID (curr_spec), curr_spec->where_pred, scan_type,
+						 curr_spec->s.cls_node.cache_reserved,
+						 curr_spec->s.cls_node.cls_regu_list_reserved);
+	  if (error_code != NO_ERROR)
 	    {
-	      return S_END;
+	      ASSERT_ERROR ();
+	      goto exit_on_error;
 	    }
-
-	  /* initialize scan */
-	  if (scan_start_scan (thread_p, &xasl->curr_spec->s_id) != NO_ERROR)
+	}
+      else if (scan_type == S_INDX_KEY_INFO_SCAN)
+	{
+	  error_code =
+	    scan_open_index_key_info_scan (thread_p, s_id, val_list, vd, indx_info, &ACCESS_SPEC_CLS_OID (curr_spec),
+					   &ACCESS_SPEC_HFID (curr_spec), curr_spec->where_pred,
+					   curr_spec->s.cls_node.cls_output_val_list, iscan_oid_order, query_id,
+					   curr_spec->s.cls_node.cache_reserved,
+					   curr_spec->s.cls_node.cls_regu_list_reserved);
+	  if (error_code != NO_ERROR)
 	    {
-	      return S_ERROR;
+	      ASSERT_ERROR ();
+	      goto exit_on_error;
 	    }
+	  /* monitor */
+	  perfmon_inc_stat (thread_p, PSTAT_QM_NUM_ISCANS);
 	}
-      else
+      else if (scan_type == S_INDX_NODE_INFO_SCAN)
 	{
-	  return S_ERROR;
+	  error_code = scan_open_index_node_info_scan (thread_p, s_id, val_list, vd, indx_info, curr_spec->where_pred,
+						       curr_spec->s.cls_node.cache_reserved,
+						       curr_spec->s.cls_node.cls_regu_list_reserved);
+	  if (error_code != NO_ERROR)
+	    {
+	      ASSERT_ERROR ();
+	      goto exit_on_error;
+	    }
+	  /* monitor */
+	  perfmon_inc_stat (thread_p, PSTAT_QM_NUM_ISCANS);
 	}
-    }
-  while (1);
-
-}
-
-/*
- * qexec_next_scan_block_iterations () -
- *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
- *   xasl(in)   : XASL Tree pointer
- *
- */
-static SCAN_CODE
-qexec_next_scan_block_iterations (THREAD_ENTRY * thread_p, XASL_NODE * xasl)
-{
-  SCAN_CODE sb_next;
-  SCAN_CODE xs_scan;
-  SCAN_CODE xs_scan2;
-  XASL_NODE *last_xptr;
-  XASL_NODE *prev_xptr;
-  XASL_NODE *xptr2, *xptr3;
+      else			/* S_INDX_SCAN */
+	{
+	  error_code = scan_open_index_scan (thread_p, s_id, mvcc_select_lock_needed, scan_op_type, fixed, grouped,
+					     curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd, indx_info,
+					     &ACCESS_SPEC_CLS_OID (curr_spec), &ACCESS_SPEC_HFID (curr_spec),
+					     curr_spec->s.cls_node.cls_regu_list_key, curr_spec->where_key,
+					     curr_spec->s.cls_node.cls_regu_list_pred, curr_spec->where_pred,
+					     curr_spec->s.cls_node.cls_regu_list_rest, curr_spec->where_range,
+					     curr_spec->s.cls_node.cls_regu_list_range,
+					     curr_spec->s.cls_node.cls_output_val_list,
+					     curr_spec->s.cls_node.cls_regu_val_list,
+					     curr_spec->s.cls_node.num_attrs_key, curr_spec->s.cls_node.attrids_key,
+					     curr_spec->s.cls_node.cache_key, curr_spec->s.cls_node.num_attrs_pred,
+					     curr_spec->s.cls_node.attrids_pred, curr_spec->s.cls_node.cache_pred,
+					     curr_spec->s.cls_node.num_attrs_rest, curr_spec->s.cls_node.attrids_rest,
+					     curr_spec->s.cls_node.cache_rest, curr_spec->s.cls_node.num_attrs_range,
+					     curr_spec->s.cls_node.attrids_range, curr_spec->s.cls_node.cache_range,
+					     iscan_oid_order, query_id);
+	  if (error_code != NO_ERROR)
+	    {
+	      ASSERT_ERROR ();
+	      goto exit_on_error;
+	    }
+	  /* monitor */
+	  perfmon_inc_stat (thread_p, PSTAT_QM_NUM_ISCANS);
+	}
+      break;
 
-  /* first find the last scan block to be moved */
-  for (last_xptr = xasl; last_xptr->scan_ptr; last_xptr = last_xptr->scan_ptr)
-    {
-      if (!last_xptr->next_scan_block_on
-	  || (last_xptr->curr_spec && last_xptr->curr_spec->s_id.status == S_STARTED
-	      && !last_xptr->curr_spec->s_id.qualified_block))
+    case TARGET_CLASS_ATTR:
+      error_code =
+	scan_open_class_attr_scan (thread_p, s_id, grouped, curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd,
+				   &ACCESS_SPEC_CLS_OID (curr_spec), &ACCESS_SPEC_HFID (curr_spec),
+				   curr_spec->s.cls_node.cls_regu_list_pred, curr_spec->where_pred,
+				   curr_spec->s.cls_node.cls_regu_list_rest, curr_spec->s.cls_node.num_attrs_pred,
+				   curr_spec->s.cls_node.attrids_pred, curr_spec->s.cls_node.cache_pred,
+				   curr_spec->s.cls_node.num_attrs_rest, curr_spec->s.cls_node.attrids_rest,
+				   curr_spec->s.cls_node.cache_rest);
+      if (error_code != NO_ERROR)
 	{
-	  break;
+	  ASSERT_ERROR ();
+	  goto exit_on_error;
 	}
-    }
+      break;
 
-  /* move the last scan block and reset further scans */
+    case TARGET_LIST:
+      /* open a list file scan */
+      error_code =
+	scan_open_list_scan (thread_p, s_id, grouped, curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd,
+			     ACCESS_SPEC_LIST_ID (curr_spec), curr_spec->s.list_node.list_regu_list_pred,
+			     curr_spec->where_pred, curr_spec->s.list_node.list_regu_list_rest);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  goto exit_on_error;
+	}
+      break;
 
-  /* if there are no qualified items in the current scan block, this scan block will make no contribution with other
-   * possible scan block combinations from following classes. Thus, directly move to the next scan block in this class. */
-  if (last_xptr->curr_spec && last_xptr->curr_spec->s_id.status == S_STARTED
-      && !last_xptr->curr_spec->s_id.qualified_block)
-    {
-      if ((xs_scan = qexec_next_scan_block (thread_p, last_xptr)) == S_END)
+    case TARGET_SHOWSTMT:
+      /* open a showstmt scan */
+      error_code =
+	scan_open_showstmt_scan (thread_p, s_id, grouped, curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd,
+				 curr_spec->where_pred, curr_spec->s.showstmt_node.show_type,
+				 curr_spec->s.showstmt_node.arg_list);
+      if (error_code != NO_ERROR)
 	{
-	  /* close following scan procedures if they are still active */
-	  for (xptr2 = last_xptr; xptr2; xptr2 = xptr2->scan_ptr)
-	    {
-	      if (xptr2->scan_ptr && xptr2->next_scan_block_on)
-		{
-		  if (xptr2->scan_ptr->curr_spec)
-		    {
-		      scan_end_scan (thread_p, &xptr2->scan_ptr->curr_spec->s_id);
-		    }
-		  xptr2->scan_ptr->curr_spec->curent = NULL;
-		  xptr2->scan_ptr->curr_spec = NULL;
-		  xptr2->next_scan_block_on = false;
-		}
-	    }
+	  ASSERT_ERROR ();
+	  goto exit_on_error;
 	}
-      else if (xs_scan == S_ERROR)
+      break;
+
+    case TARGET_REGUVAL_LIST:
+      /* open a regu value list scan */
+      error_code =
+	scan_open_values_scan (thread_p, s_id, grouped, curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd,
+			       ACCESS_SPEC_RLIST_VALPTR_LIST (curr_spec));
+      if (error_code != NO_ERROR)
 	{
-	  return S_ERROR;
+	  ASSERT_ERROR ();
+	  goto exit_on_error;
 	}
-    }
-  else if ((xs_scan = qexec_next_scan_block (thread_p, last_xptr)) == S_SUCCESS)
-    {				/* reset all the futher scans */
-      for (xptr2 = last_xptr; xptr2; xptr2 = xptr2->scan_ptr)
+      break;
+
+    case TARGET_SET:
+      /* open a set based derived table scan */
+      error_code =
+	scan_open_set_scan (thread_p, s_id, grouped, curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd,
+			    ACCESS_SPEC_SET_PTR (curr_spec), ACCESS_SPEC_SET_REGU_LIST (curr_spec),
+			    curr_spec->where_pred);
+      if (error_code != NO_ERROR)
 	{
-	  if (xptr2->scan_ptr)
-	    {
-	      sb_next = qexec_next_scan_block (thread_p, xptr2->scan_ptr);
-	      if (sb_next == S_SUCCESS)
-		{
-		  xptr2->next_scan_block_on = true;
-		}
-	      else if (sb_next == S_END)
-		{
-		  /* close all preceding scan procedures and return */
-		  for (xptr3 = xasl; xptr3 && xptr3 != xptr2->scan_ptr; xptr3 = xptr3->scan_ptr)
-		    {
-		      if (xptr3->curr_spec)
-			{
-			  scan_end_scan (thread_p, &xptr3->curr_spec->s_id);
-			}
-		      xptr3->curr_spec->curent = NULL;
-		      xptr3->curr_spec = NULL;
-		      xptr3->next_scan_block_on = false;
-		    }
-		  return S_END;
-		}
-	      else
-		{
-		  return S_ERROR;
-		}
-	    }
+	  ASSERT_ERROR ();
+	  goto exit_on_error;
+	}
+      break;
+
+    case TARGET_JSON_TABLE:
+      /* open a json table based derived table scan */
+      error_code =
+	scan_open_json_table_scan (thread_p, s_id, grouped, curr_spec->single_fetch, curr_spec->s_dbval, val_list,
+				   vd, curr_spec->where_pred);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  goto exit_on_error;
+	}
+      break;
+
+    case TARGET_METHOD:
+      error_code =
+	scan_open_method_scan (thread_p, s_id, grouped, curr_spec->single_fetch, curr_spec->s_dbval, val_list, vd,
+			       ACCESS_SPEC_METHOD_LIST_ID (curr_spec), ACCESS_SPEC_METHOD_SIG_LIST (curr_spec));
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  goto exit_on_error;
 	}
+      break;
+
+    default:
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_XASLNODE, 0);
+      error_code = ER_QPROC_INVALID_XASLNODE;
+      goto exit_on_error;
+    }				/* switch */
+
+  s_id->scan_immediately_stop = scan_immediately_stop;
+
+  if (p_mvcc_select_lock_needed)
+    {
+      *p_mvcc_select_lock_needed = mvcc_select_lock_needed;
     }
-  else if (xs_scan == S_ERROR)
+
+  return NO_ERROR;
+
+exit_on_error:
+
+  if (curr_spec->pruning_type == DB_PARTITIONED_CLASS && curr_spec->parts != NULL)
     {
-      return S_ERROR;
+      /* reset pruning info */
+      db_private_free (thread_p, curr_spec->parts);
+      curr_spec->parts = NULL;
+      curr_spec->curent = NULL;
+      curr_spec->pruned = false;
     }
 
-  /* now move backwards, resetting all the previous scans */
-  while (last_xptr != xasl)
+  ASSERT_ERROR_AND_SET (error_code);
+  return error_code;
+}
+
+/*
+ * qexec_close_scan () -
+ *   return:
+ *   curr_spec(in)      : Access Specification Node
+ *
+ * Note: This routine is used to close the access specification node scan.
+ */
+static void
+qexec_close_scan (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * curr_spec)
+{
+  if (curr_spec == NULL)
     {
+      return;
+    }
 
-      /* find the previous to last xptr */
-      for (prev_xptr = xasl; prev_xptr->scan_ptr != last_xptr; prev_xptr = prev_xptr->scan_ptr)
-	;
+  /* monitoring */
+  switch (curr_spec->type)
+    {
+    case TARGET_CLASS:
+      if (curr_spec->access == ACCESS_METHOD_SEQUENTIAL || curr_spec->access == ACCESS_METHOD_SEQUENTIAL_RECORD_INFO
+	  || curr_spec->access == ACCESS_METHOD_SEQUENTIAL_PAGE_SCAN)
+	{
+	  perfmon_inc_stat (thread_p, PSTAT_QM_NUM_SSCANS);
+	}
+      else if (IS_ANY_INDEX_ACCESS (curr_spec->access))
+	{
+	  perfmon_inc_stat (thread_p, PSTAT_QM_NUM_ISCANS);
+	}
 
-      /* set previous scan according to the last scan status */
-      if (last_xptr->curr_spec == NULL)
-	{			/* last scan ended */
-	  prev_xptr->next_scan_block_on = false;
+      if (curr_spec->parts != NULL)
+	{
+	  /* reset pruning info */
+	  db_private_free (thread_p, curr_spec->parts);
+	  curr_spec->parts = NULL;
+	  curr_spec->curent = NULL;
+	  curr_spec->pruned = false;
+	}
+      break;
 
-	  /* move the scan block of the previous scan */
-	  xs_scan2 = qexec_next_scan_block (thread_p, prev_xptr);
-	  if (xs_scan2 == S_SUCCESS)
+    case TARGET_CLASS_ATTR:
+      break;
+
+    case TARGET_LIST:
+      perfmon_inc_stat (thread_p, PSTAT_QM_NUM_LSCANS);
+      break;
+
+    case TARGET_SHOWSTMT:
+      /* do nothing */
+      break;
+
+    case TARGET_REGUVAL_LIST:
+      /* currently do nothing */
+      break;
+
+    case TARGET_SET:
+      perfmon_inc_stat (thread_p, PSTAT_QM_NUM_SETSCANS);
+      break;
+
+    case TARGET_JSON_TABLE:
+      /* currently do nothing
+         todo: check if here need to add something
+       */
+      break;
+
+    case TARGET_METHOD:
+      perfmon_inc_stat (thread_p, PSTAT_QM_NUM_METHSCANS);
+      break;
+    }
+
+  scan_close_scan (thread_p, &curr_spec->s_id);
+}
+
+/*
+ * qexec_end_scan () -
+ *   return:
+ *   curr_spec(in)      : Access Specification Node
+ *
+ * Note: This routine is used to end the access specification node scan.
+ *
+ * Note: This routine is called for ERROR CASE scan end operation.
+ */
+static void
+qexec_end_scan (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * curr_spec)
+{
+  if (curr_spec)
+    {
+      scan_end_scan (thread_p, &curr_spec->s_id);
+    }
+}
+
+/*
+ * qexec_next_merge_block () -
+ *   return:
+ *   spec(in)   :
+ */
+static SCAN_CODE
+qexec_next_merge_block (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE ** spec)
+{
+  SCAN_CODE sb_scan;
+
+  if (scan_start_scan (thread_p, &(*spec)->s_id) != NO_ERROR)
+    {
+      return S_ERROR;
+    }
+
+  do
+    {
+      sb_scan = scan_next_scan_block (thread_p, &(*spec)->s_id);
+      if (sb_scan == S_SUCCESS)
+	{
+	  return S_SUCCESS;
+	}
+      else if (sb_scan == S_END)
+	{
+	  /* close old scan */
+	  scan_end_scan (thread_p, &(*spec)->s_id);
+
+	  /* move to the following access specifications left */
+	  *spec = (*spec)->next;
+
+	  /* check for and skip the case of empty heap files */
+	  while (*spec != NULL && QEXEC_EMPTY_ACCESS_SPEC_SCAN (*spec))
 	    {
-	      /* move all the further scan blocks */
-	      for (xptr2 = prev_xptr; xptr2; xptr2 = xptr2->scan_ptr)
-		{
-		  if (xptr2->scan_ptr)
-		    {
-		      sb_next = qexec_next_scan_block (thread_p, xptr2->scan_ptr);
-		      if (sb_next == S_SUCCESS)
-			{
-			  xptr2->next_scan_block_on = true;
-			}
-		      else if (sb_next == S_END)
-			{
-			  /* close all preceding scan procedures and return */
-			  for (xptr3 = xasl; xptr3 && xptr3 != xptr2->scan_ptr; xptr3 = xptr3->scan_ptr)
-			    {
-			      if (xptr3->curr_spec)
-				{
-				  scan_end_scan (thread_p, &xptr3->curr_spec->s_id);
-				}
-			      xptr3->curr_spec->curent = NULL;
-			      xptr3->curr_spec = NULL;
-			      xptr3->next_scan_block_on = false;
-			    }
-			  return S_END;
-			}
-		      else
-			{
-			  return S_ERROR;
-			}
-		    }
-		}
+	      *spec = (*spec)->next;
 	    }
-	  else if (xs_scan2 == S_ERROR)
+
+	  if (*spec == NULL)
 	    {
-	      return S_ERROR;
+	      return S_END;
 	    }
 
-	}
-      else			/* last scan successfully moved */
-	{
-	  if (scan_reset_scan_block (thread_p, &prev_xptr->curr_spec->s_id) == S_ERROR)
+	  /* initialize scan */
+	  if (scan_start_scan (thread_p, &(*spec)->s_id) != NO_ERROR)
 	    {
 	      return S_ERROR;
 	    }
 	}
+      else
+	{
+	  return S_ERROR;
+	}
 
-      /* make previous scan the last scan ptr */
-      last_xptr = prev_xptr;
-    }				/* while */
-
-  /* return the status of the first XASL block */
-  return (xasl->curr_spec) ? S_SUCCESS : S_END;
+    }
+  while (1);
 }
 
 /*
- * qexec_execute_scan () -
+ * qexec_next_scan_block () -
  *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
- *   xasl(in)   : XASL Tree block
- *   xasl_state(in)     : XASL tree state information
- *   next_scan_fnc(in)  : Function to interpret following scan block
- *
- * Note: This routine executes one iteration on a scan operation on
- * the given XASL tree block. If end_of_scan is reached, it
- * return S_END. If an error occurs, it returns
- * S_ERROR. Each scan procedure block may have its own scan
- * procedures forming a path of scan procedure blocks. Thus, for
- * each scan procedure block interpretation, if there are already
- * active scan procedures started from that block, first their
- * execution is requested. Only if all of the following scan
- * procedures come to an end returning S_END, then the
- * current scan procedure scan item is advanced. When this scan
- * procedure too come to an end, it returns S_END to the
- * caller, indicating that there are no more scan items in the
- * path of the scan procedure blocks.
+ *   xasl(in)   : XASL Tree pointer
  *
- * Note: This function is the general scan block interpretation function.
+ * Note: This function is used to move the current access specification
+ * node scan identifier for the given XASL block to the next
+ * scan block. If there are no more scan blocks for the current
+ * access specfication node, it moves to the next access
+ * specification, if any, and starts the new scan block for that
+ * node. If there are no more access specification nodes left,
+ * it returns S_END.
  */
 static SCAN_CODE
-qexec_execute_scan (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state, QFILE_TUPLE_RECORD * ignore,
-		    XASL_SCAN_FNC_PTR next_scan_fnc)
+qexec_next_scan_block (THREAD_ENTRY * thread_p, XASL_NODE * xasl)
 {
-  XASL_NODE *xptr;
-  SCAN_CODE sc_scan;
-  SCAN_CODE xs_scan;
-  DB_LOGICAL ev_res;
-  int qualified;
-  SCAN_OPERATION_TYPE scan_operation_type;
+  SCAN_CODE sb_scan;
+  OID *class_oid;
+  HFID *class_hfid;
 
-  /* check if further scan procedure are still active */
-  if (xasl->scan_ptr && xasl->next_scan_on)
+  if (xasl->curr_spec == NULL)
     {
-      xs_scan = (*next_scan_fnc) (thread_p, xasl->scan_ptr, xasl_state, ignore, next_scan_fnc + 1);
-      if (xs_scan != S_END)
+      /* initialize scan id */
+      xasl->curr_spec = xasl->spec_list;
+
+      /* check for and skip the case of empty heap file cases */
+      while (xasl->curr_spec != NULL && QEXEC_EMPTY_ACCESS_SPEC_SCAN (xasl->curr_spec))
 	{
-	  return xs_scan;
+	  xasl->curr_spec = xasl->curr_spec->next;
 	}
 
-      xasl->next_scan_on = false;
-    }
-
-  do
-    {
-      sc_scan = scan_next_scan (thread_p, &xasl->curr_spec->s_id);
-      if (sc_scan != S_SUCCESS)
+      if (xasl->curr_spec == NULL)
 	{
-	  return sc_scan;
+	  return S_END;
 	}
 
-      /* set scan item as qualified */
-      qualified = true;
+      assert (xasl->curr_spec != NULL);
 
-      if (qualified)
+      /* initialize scan */
+      if ((xasl->curr_spec->type == TARGET_CLASS || xasl->curr_spec->type == TARGET_CLASS_ATTR)
+	  && xasl->curr_spec->parts != NULL && xasl->curr_spec->curent == NULL
+	  && xasl->curr_spec->access != ACCESS_METHOD_INDEX_NODE_INFO)
 	{
-	  /* clear bptr subquery list files */
-	  if (xasl->bptr_list)
+	  /* initialize the scan_id for partitioned classes */
+	  if (xasl->curr_spec->access == ACCESS_METHOD_SEQUENTIAL
+	      || xasl->curr_spec->access == ACCESS_METHOD_SEQUENTIAL_RECORD_INFO)
 	    {
-	      qexec_clear_head_lists (thread_p, xasl->bptr_list);
-	      if (xasl->curr_spec->flags & ACCESS_SPEC_FLAG_FOR_UPDATE)
-		{
-		  scan_operation_type = S_UPDATE;
-		}
-	      else
-		{
-		  scan_operation_type = S_SELECT;
-		}
+	      class_oid = &xasl->curr_spec->s_id.s.hsid.cls_oid;
+	      class_hfid = &xasl->curr_spec->s_id.s.hsid.hfid;
 	    }
-	  /* evaluate bptr list */
-	  for (xptr = xasl->bptr_list; qualified && xptr != NULL; xptr = xptr->next)
+	  else if (xasl->curr_spec->access == ACCESS_METHOD_SEQUENTIAL_PAGE_SCAN)
 	    {
-	      if (qexec_execute_obj_fetch (thread_p, xptr, xasl_state, scan_operation_type) != NO_ERROR)
-		{
-		  return S_ERROR;
-		}
-	      else if (xptr->proc.fetch.fetch_res == false)
-		{
-		  qualified = false;
-		}
+	      class_oid = &xasl->curr_spec->s_id.s.hpsid.cls_oid;
+	      class_hfid = &xasl->curr_spec->s_id.s.hpsid.hfid;
 	    }
-	}			/* if (qualified) */
-
-      if (qualified)
-	{
-	  /* evaluate dptr list */
-	  for (xptr = xasl->dptr_list; xptr != NULL; xptr = xptr->next)
+	  else if (xasl->curr_spec->access == ACCESS_METHOD_INDEX
+		   || xasl->curr_spec->access == ACCESS_METHOD_INDEX_KEY_INFO)
 	    {
-	      /* clear correlated subquery list files */
-	      qexec_clear_head_lists (thread_p, xptr);
-	      if (XASL_IS_FLAGED (xptr, XASL_LINK_TO_REGU_VARIABLE))
-		{
-		  /* skip if linked to regu var */
-		  continue;
-		}
-	      if (qexec_execute_mainblock (thread_p, xptr, xasl_state, NULL) != NO_ERROR)
-		{
-		  return S_ERROR;
-		}
+	      class_oid = &xasl->curr_spec->s_id.s.isid.cls_oid;
+	      class_hfid = &xasl->curr_spec->s_id.s.isid.hfid;
 	    }
-	}			/* if (qualified) */
-
-      if (qualified)
-	{
-	  /* evaluate after join predicate */
-	  ev_res = V_UNKNOWN;
-	  if (xasl->after_join_pred != NULL)
+	  else
 	    {
-	      ev_res = eval_pred (thread_p, xasl->after_join_pred, &xasl_state->vd, NULL);
-	      if (ev_res == V_ERROR)
-		{
-		  return S_ERROR;
-		}
+	      assert (false);
+	      return S_ERROR;
 	    }
-	  qualified = (xasl->after_join_pred == NULL || ev_res == V_TRUE);
-	}			/* if (qualified) */
 
-      if (qualified)
+	  COPY_OID (class_oid, &ACCESS_SPEC_CLS_OID (xasl->curr_spec));
+	  HFID_COPY (class_hfid, &ACCESS_SPEC_HFID (xasl->curr_spec));
+	}
+
+      if (scan_start_scan (thread_p, &xasl->curr_spec->s_id) != NO_ERROR)
 	{
-	  /* evaluate if predicate */
-	  ev_res = V_UNKNOWN;
-	  if (xasl->if_pred != NULL)
-	    {
-	      ev_res = eval_pred (thread_p, xasl->if_pred, &xasl_state->vd, NULL);
-	      if (ev_res == V_ERROR)
-		{
-		  return S_ERROR;
-		}
-	    }
-	  qualified = (xasl->if_pred == NULL || ev_res == V_TRUE);
-	}			/* if (qualified) */
+	  return S_ERROR;
+	}
+    }
 
-      if (qualified)
+  do
+    {
+      sb_scan = scan_next_scan_block (thread_p, &xasl->curr_spec->s_id);
+      if (sb_scan == S_SUCCESS)
 	{
-	  /* clear fptr subquery list files */
-	  if (xasl->fptr_list)
+	  return S_SUCCESS;
+	}
+      else if (sb_scan == S_END)
+	{
+	  /* if curr_spec is a partitioned class, do not move to the next spec unless we went through all partitions */
+	  SCAN_CODE s_parts = qexec_init_next_partition (thread_p, xasl->curr_spec);
+	  if (s_parts == S_SUCCESS)
 	    {
-	      qexec_clear_head_lists (thread_p, xasl->fptr_list);
-	      if (xasl->curr_spec->flags & ACCESS_SPEC_FLAG_FOR_UPDATE)
-		{
-		  scan_operation_type = S_UPDATE;
-		}
-	      else
-		{
-		  scan_operation_type = S_SELECT;
-		}
+	      /* successfully moved to the next partition */
+	      continue;
 	    }
-	  /* evaluate fptr list */
-	  for (xptr = xasl->fptr_list; qualified && xptr != NULL; xptr = xptr->next)
+	  else if (s_parts == S_ERROR)
 	    {
-	      if (qexec_execute_obj_fetch (thread_p, xptr, xasl_state, scan_operation_type) != NO_ERROR)
-		{
-		  return S_ERROR;
-		}
-	      else if (xptr->proc.fetch.fetch_res == false)
-		{
-		  qualified = false;
-		}
+	      return S_ERROR;
 	    }
-	}			/* if (qualified) */
 
-      if (qualified)
-	{
-	  if (!xasl->scan_ptr)
-	    {
-	      /* no scan procedure block */
-	      return S_SUCCESS;
-	    }
-	  else
-	    {
-	      /* current scan block has at least one qualified item */
-	      xasl->curr_spec->s_id.qualified_block = true;
+	  /* close old scan */
+	  scan_end_scan (thread_p, &xasl->curr_spec->s_id);
 
-	      /* start following scan procedure */
-	      xasl->scan_ptr->next_scan_on = false;
-	      if (scan_reset_scan_block (thread_p, &xasl->scan_ptr->curr_spec->s_id) == S_ERROR)
-		{
-		  return S_ERROR;
-		}
+	  /* move to the following access specifications left */
+	  xasl->curr_spec = xasl->curr_spec->next;
 
-	      xasl->next_scan_on = true;
+	  /* check for and skip the case of empty heap files */
+	  while (xasl->curr_spec != NULL && QEXEC_EMPTY_ACCESS_SPEC_SCAN (xasl->curr_spec))
+	    {
+	      xasl->curr_spec = xasl->curr_spec->next;
+	    }
 
-	      /* execute following scan procedure */
-	      xs_scan = (*next_scan_fnc) (thread_p, xasl->scan_ptr, xasl_state, ignore, next_scan_fnc + 1);
-	      if (xs_scan == S_END)
-		{
-		  xasl->next_scan_on = false;
-		}
-	      else
-		{
-		  return xs_scan;
-		}
+	  if (xasl->curr_spec == NULL)
+	    {
+	      return S_END;
 	    }
-	}			/* if (qualified) */
 
+	  /* initialize scan */
+	  if (scan_start_scan (thread_p, &xasl->curr_spec->s_id) != NO_ERROR)
+	    {
+	      return S_ERROR;
+	    }
+	}
+      else
+	{
+	  return S_ERROR;
+	}
     }
   while (1);
 
 }
 
 /*
- * qexec_reset_regu_variable_list () - reset value cache for a list of regu
- *				       variables
- * return : void
- * list (in) : regu variable list
+ * qexec_next_scan_block_iterations () -
+ *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
+ *   xasl(in)   : XASL Tree pointer
+ *
  */
-static void
-qexec_reset_regu_variable_list (REGU_VARIABLE_LIST list)
+static SCAN_CODE
+qexec_next_scan_block_iterations (THREAD_ENTRY * thread_p, XASL_NODE * xasl)
 {
-  REGU_VARIABLE_LIST var = list;
-
-  while (var != NULL)
-    {
-      qexec_reset_regu_variable (&var->value);
-      var = var->next;
-    }
-}
+  SCAN_CODE sb_next;
+  SCAN_CODE xs_scan;
+  SCAN_CODE xs_scan2;
+  XASL_NODE *last_xptr;
+  XASL_NODE *prev_xptr;
+  XASL_NODE *xptr2, *xptr3;
 
-/*
- * qexec_reset_pred_expr () - reset value cache for a pred expr
- * return : void
- * pred (in) : pred expr
- */
-static void
-qexec_reset_pred_expr (PRED_EXPR * pred)
-{
-  if (pred == NULL)
-    {
-      return;
-    }
-  switch (pred->type)
+  /* first find the last scan block to be moved */
+  for (last_xptr = xasl; last_xptr->scan_ptr; last_xptr = last_xptr->scan_ptr)
     {
-    case T_PRED:
-      qexec_reset_pred_expr (pred->pe.m_pred.lhs);
-      qexec_reset_pred_expr (pred->pe.m_pred.rhs);
-      break;
-    case T_EVAL_TERM:
-      switch (pred->pe.m_eval_term.et_type)
+      if (!last_xptr->next_scan_block_on
+	  || (last_xptr->curr_spec && last_xptr->curr_spec->s_id.status == S_STARTED
+	      && !last_xptr->curr_spec->s_id.qualified_block))
 	{
-	case T_COMP_EVAL_TERM:
-	  {
-	    COMP_EVAL_TERM *et_comp = &pred->pe.m_eval_term.et.et_comp;
-
-	    qexec_reset_regu_variable (et_comp->lhs);
-	    qexec_reset_regu_variable (et_comp->rhs);
-	  }
-	  break;
-	case T_ALSM_EVAL_TERM:
-	  {
-	    ALSM_EVAL_TERM *et_alsm = &pred->pe.m_eval_term.et.et_alsm;
-
-	    qexec_reset_regu_variable (et_alsm->elem);
-	    qexec_reset_regu_variable (et_alsm->elemset);
-	  }
-	  break;
-	case T_LIKE_EVAL_TERM:
-	  {
-	    LIKE_EVAL_TERM *et_like = &pred->pe.m_eval_term.et.et_like;
-
-	    qexec_reset_regu_variable (et_like->src);
-	    qexec_reset_regu_variable (et_like->pattern);
-	    qexec_reset_regu_variable (et_like->esc_char);
-	  }
 	  break;
-	case T_RLIKE_EVAL_TERM:
-	  {
-	    RLIKE_EVAL_TERM *et_rlike = &pred->pe.m_eval_term.et.et_rlike;
-	    qexec_reset_regu_variable (et_rlike->case_sensitive);
-	    qexec_reset_regu_variable (et_rlike->pattern);
-	    qexec_reset_regu_variable (et_rlike->src);
-	  }
 	}
-      break;
-    case T_NOT_TERM:
-      qexec_reset_pred_expr (pred->pe.m_not_term);
-      break;
     }
-}
 
-/*
- * qexec_reset_regu_variable () - reset the cache for a regu variable
- * return : void
- * var (in) : regu variable
- */
-static void
-qexec_reset_regu_variable (REGU_VARIABLE * var)
-{
-  if (var == NULL)
-    {
-      return;
-    }
+  /* move the last scan block and reset further scans */
 
-  switch (var->type)
+  /* if there are no qualified items in the current scan block, this scan block will make no contribution with other
+   * possible scan block combinations from following classes. Thus, directly move to the next scan block in this class. */
+  if (last_xptr->curr_spec && last_xptr->curr_spec->s_id.status == S_STARTED
+      && !last_xptr->curr_spec->s_id.qualified_block)
     {
-    case TYPE_ATTR_ID:
-    case TYPE_SHARED_ATTR_ID:
-    case TYPE_CLASS_ATTR_ID:
-      var->value.attr_descr.cache_dbvalp = NULL;
-      break;
-    case TYPE_INARITH:
-    case TYPE_OUTARITH:
-      qexec_reset_regu_variable (var->value.arithptr->leftptr);
-      qexec_reset_regu_variable (var->value.arithptr->rightptr);
-      qexec_reset_regu_variable (var->value.arithptr->thirdptr);
-      /* use arithptr */
-      break;
-    case TYPE_FUNC:
-      /* use funcp */
-      qexec_reset_regu_variable_list (var->value.funcp->operand);
-      break;
-    default:
-      break;
-    }
-}
-
-/*
- * qexec_prune_spec () - perform partition pruning on an access spec
- * return : error code or NO_ERROR
- * thread_p (in) :
- * spec (in) :
- * vd (in) :
- * scan_op_type (in) :
- */
-static int
-qexec_prune_spec (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * spec, VAL_DESCR * vd, SCAN_OPERATION_TYPE scan_op_type)
-{
-  PARTITION_SPEC_TYPE *partition_spec = NULL;
-  LOCK lock = NULL_LOCK;
-  int granted;
-  int error = NO_ERROR;
-
-  if (spec == NULL || spec->pruned)
-    {
-      return NO_ERROR;
+      if ((xs_scan = qexec_next_scan_block (thread_p, last_xptr)) == S_END)
+	{
+	  /* close following scan procedures if they are still active */
+	  for (xptr2 = last_xptr; xptr2; xptr2 = xptr2->scan_ptr)
+	    {
+	      if (xptr2->scan_ptr && xptr2->next_scan_block_on)
+		{
+		  if (xptr2->scan_ptr->curr_spec)
+		    {
+		      scan_end_scan (thread_p, &xptr2->scan_ptr->curr_spec->s_id);
+		    }
+		  xptr2->scan_ptr->curr_spec->curent = NULL;
+		  xptr2->scan_ptr->curr_spec = NULL;
+		  xptr2->next_scan_block_on = false;
+		}
+	    }
+	}
+      else if (xs_scan == S_ERROR)
+	{
+	  return S_ERROR;
+	}
     }
-  else if (spec->pruning_type != DB_PARTITIONED_CLASS)
+  else if ((xs_scan = qexec_next_scan_block (thread_p, last_xptr)) == S_SUCCESS)
+    {				/* reset all the futher scans */
+      for (xptr2 = last_xptr; xptr2; xptr2 = xptr2->scan_ptr)
+	{
+	  if (xptr2->scan_ptr)
+	    {
+	      sb_next = qexec_next_scan_block (thread_p, xptr2->scan_ptr);
+	      if (sb_next == S_SUCCESS)
+		{
+		  xptr2->next_scan_block_on = true;
+		}
+	      else if (sb_next == S_END)
+		{
+		  /* close all preceding scan procedures and return */
+		  for (xptr3 = xasl; xptr3 && xptr3 != xptr2->scan_ptr; xptr3 = xptr3->scan_ptr)
+		    {
+		      if (xptr3->curr_spec)
+			{
+			  scan_end_scan (thread_p, &xptr3->curr_spec->s_id);
+			}
+		      xptr3->curr_spec->curent = NULL;
+		      xptr3->curr_spec = NULL;
+		      xptr3->next_scan_block_on = false;
+		    }
+		  return S_END;
+		}
+	      else
+		{
+		  return S_ERROR;
+		}
+	    }
+	}
+    }
+  else if (xs_scan == S_ERROR)
     {
-      spec->pruned = true;
-      return NO_ERROR;
+      return S_ERROR;
     }
 
-  error = partition_prune_spec (thread_p, vd, spec);
-  if (error != NO_ERROR)
+  /* now move backwards, resetting all the previous scans */
+  while (last_xptr != xasl)
     {
-      ASSERT_ERROR ();
-      return error;
-    }
 
-  if (!COMPOSITE_LOCK (scan_op_type) && !(spec->flags & ACCESS_SPEC_FLAG_FOR_UPDATE))
+      /* find the previous to last xptr */
+      for (prev_xptr = xasl; prev_xptr->scan_ptr != last_xptr; prev_xptr = prev_xptr->scan_ptr)
+	;
+
+      /* set previous scan according to the last scan status */
+      if (last_xptr->curr_spec == NULL)
+	{			/* last scan ended */
+	  prev_xptr->next_scan_block_on = false;
+
+	  /* move the scan block of the previous scan */
+	  xs_scan2 = qexec_next_scan_block (thread_p, prev_xptr);
+	  if (xs_scan2 == S_SUCCESS)
+	    {
+	      /* move all the further scan blocks */
+	      for (xptr2 = prev_xptr; xptr2; xptr2 = xptr2->scan_ptr)
+		{
+		  if (xptr2->scan_ptr)
+		    {
+		      sb_next = qexec_next_scan_block (thread_p, xptr2->scan_ptr);
+		      if (sb_next == S_SUCCESS)
+			{
+			  xptr2->next_scan_block_on = true;
+			}
+		      else if (sb_next == S_END)
+			{
+			  /* close all preceding scan procedures and return */
+			  for (xptr3 = xasl; xptr3 && xptr3 != xptr2->scan_ptr; xptr3 = xptr3->scan_ptr)
+			    {
+			      if (xptr3->curr_spec)
+				{
+				  scan_end_scan (thread_p, &xptr3->curr_spec->s_id);
+				}
+			      xptr3->curr_spec->curent = NULL;
+			      xptr3->curr_spec = NULL;
+			      xptr3->next_scan_block_on = false;
+			    }
+			  return S_END;
+			}
+		      else
+			{
+			  return S_ERROR;
+			}
+		    }
+		}
+	    }
+	  else if (xs_scan2 == S_ERROR)
+	    {
+	      return S_ERROR;
+	    }
+
+	}
+      else			/* last scan successfully moved */
+	{
+	  if (scan_reset_scan_block (thread_p, &prev_xptr->curr_spec->s_id) == S_ERROR)
+	    {
+	      return S_ERROR;
+	    }
+	}
+
+      /* make previous scan the last scan ptr */
+      last_xptr = prev_xptr;
+    }				/* while */
+
+  /* return the status of the first XASL block */
+  return (xasl->curr_spec) ? S_SUCCESS : S_END;
+}
+
+/*
+ * qexec_execute_scan () -
+ *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
+ *   xasl(in)   : XASL Tree block
+ *   xasl_state(in)     : XASL tree state information
+ *   next_scan_fnc(in)  : Function to interpret following scan block
+ *
+ * Note: This routine executes one iteration on a scan operation on
+ * the given XASL tree block. If end_of_scan is reached, it
+ * return S_END. If an error occurs, it returns
+ * S_ERROR. Each scan procedure block may have its own scan
+ * procedures forming a path of scan procedure blocks. Thus, for
+ * each scan procedure block interpretation, if there are already
+ * active scan procedures started from that block, first their
+ * execution is requested. Only if all of the following scan
+ * procedures come to an end returning S_END, then the
+ * current scan procedure scan item is advanced. When this scan
+ * procedure too come to an end, it returns S_END to the
+ * caller, indicating that there are no more scan items in the
+ * path of the scan procedure blocks.
+ *
+ * Note: This function is the general scan block interpretation function.
+ */
+static SCAN_CODE
+qexec_execute_scan (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state, QFILE_TUPLE_RECORD * ignore,
+		    XASL_SCAN_FNC_PTR next_scan_fnc)
+{
+  XASL_NODE *xptr;
+  SCAN_CODE sc_scan;
+  SCAN_CODE xs_scan;
+  DB_LOGICAL ev_res;
+  int qualified;
+  SCAN_OPERATION_TYPE scan_operation_type;
+
+  /* check if further scan procedure are still active */
+  if (xasl->scan_ptr && xasl->next_scan_on)
     {
-      lock = IS_LOCK;
+      xs_scan = (*next_scan_fnc) (thread_p, xasl->scan_ptr, xasl_state, ignore, next_scan_fnc + 1);
+      if (xs_scan != S_END)
+	{
+	  return xs_scan;
+	}
+
+      xasl->next_scan_on = false;
     }
-  else
+
+  do
     {
-      /* MVCC use IX_LOCK on class at update/delete */
-      lock = IX_LOCK;
-    }
+      sc_scan = scan_next_scan (thread_p, &xasl->curr_spec->s_id);
+      if (sc_scan != S_SUCCESS)
+	{
+	  return sc_scan;
+	}
+
+      /* set scan item as qualified */
+      qualified = true;
+
+      if (qualified)
+	{
+	  /* clear bptr subquery list files */
+	  if (xasl->bptr_list)
+	    {
+	      qexec_clear_head_lists (thread_p, xasl->bptr_list);
+	      if (xasl->curr_spec->flags & ACCESS_SPEC_FLAG_FOR_UPDATE)
+		{
+		  scan_operation_type = S_UPDATE;
+		}
+	      else
+		{
+		  scan_operation_type = S_SELECT;
+		}
+	    }
+	  /* evaluate bptr list */
+	  for (xptr = xasl->bptr_list; qualified && xptr != NULL; xptr = xptr->next)
+	    {
+	      if (qexec_execute_obj_fetch (thread_p, xptr, xasl_state, scan_operation_type) != NO_ERROR)
+		{
+		  return S_ERROR;
+		}
+	      else if (xptr->proc.fetch.fetch_res == false)
+		{
+		  qualified = false;
+		}
+	    }
+	}			/* if (qualified) */
+
+      if (qualified)
+	{
+	  /* evaluate dptr list */
+	  for (xptr = xasl->dptr_list; xptr != NULL; xptr = xptr->next)
+	    {
+	      /* clear correlated subquery list files */
+	      qexec_clear_head_lists (thread_p, xptr);
+	      if (XASL_IS_FLAGED (xptr, XASL_LINK_TO_REGU_VARIABLE))
+		{
+		  /* skip if linked to regu var */
+		  continue;
+		}
+	      if (qexec_execute_mainblock (thread_p, xptr, xasl_state, NULL) != NO_ERROR)
+		{
+		  return S_ERROR;
+		}
+	    }
+	}			/* if (qualified) */
+
+      if (qualified)
+	{
+	  /* evaluate after join predicate */
+	  ev_res = V_UNKNOWN;
+	  if (xasl->after_join_pred != NULL)
+	    {
+	      ev_res = eval_pred (thread_p, xasl->after_join_pred, &xasl_state->vd, NULL);
+	      if (ev_res == V_ERROR)
+		{
+		  return S_ERROR;
+		}
+	    }
+	  qualified = (xasl->after_join_pred == NULL || ev_res == V_TRUE);
+	}			/* if (qualified) */
+
+      if (qualified)
+	{
+	  /* evaluate if predicate */
+	  ev_res = V_UNKNOWN;
+	  if (xasl->if_pred != NULL)
+	    {
+	      ev_res = eval_pred (thread_p, xasl->if_pred, &xasl_state->vd, NULL);
+	      if (ev_res == V_ERROR)
+		{
+		  return S_ERROR;
+		}
+	    }
+	  qualified = (xasl->if_pred == NULL || ev_res == V_TRUE);
+	}			/* if (qualified) */
+
+      if (qualified)
+	{
+	  /* clear fptr subquery list files */
+	  if (xasl->fptr_list)
+	    {
+	      qexec_clear_head_lists (thread_p, xasl->fptr_list);
+	      if (xasl->curr_spec->flags & ACCESS_SPEC_FLAG_FOR_UPDATE)
+		{
+		  scan_operation_type = S_UPDATE;
+		}
+	      else
+		{
+		  scan_operation_type = S_SELECT;
+		}
+	    }
+	  /* evaluate fptr list */
+	  for (xptr = xasl->fptr_list; qualified && xptr != NULL; xptr = xptr->next)
+	    {
+	      if (qexec_execute_obj_fetch (thread_p, xptr, xasl_state, scan_operation_type) != NO_ERROR)
+		{
+		  return S_ERROR;
+		}
+	      else if (xptr->proc.fetch.fetch_res == false)
+		{
+		  qualified = false;
+		}
+	    }
+	}			/* if (qualified) */
+
+      if (qualified)
+	{
+	  if (!xasl->scan_ptr)
+	    {
+	      /* no scan procedure block */
+	      return S_SUCCESS;
+	    }
+	  else
+	    {
+	      /* current scan block has at least one qualified item */
+	      xasl->curr_spec->s_id.qualified_block = true;
+
+	      /* start following scan procedure */
+	      xasl->scan_ptr->next_scan_on = false;
+	      if (scan_reset_scan_block (thread_p, &xasl->scan_ptr->curr_spec->s_id) == S_ERROR)
+		{
+		  return S_ERROR;
+		}
+
+	      xasl->next_scan_on = true;
+
+	      /* execute following scan procedure */
+	      xs_scan = (*next_scan_fnc) (thread_p, xasl->scan_ptr, xasl_state, ignore, next_scan_fnc + 1);
+	      if (xs_scan == S_END)
+		{
+		  xasl->next_scan_on = false;
+		}
+	      else
+		{
+		  return xs_scan;
+		}
+	    }
+	}			/* if (qualified) */
+
+    }
+  while (1);
+
+}
+
+/*
+ * qexec_reset_regu_variable_list () - reset value cache for a list of regu
+ *				       variables
+ * return : void
+ * list (in) : regu variable list
+ */
+static void
+qexec_reset_regu_variable_list (REGU_VARIABLE_LIST list)
+{
+  REGU_VARIABLE_LIST var = list;
+
+  while (var != NULL)
+    {
+      qexec_reset_regu_variable (&var->value);
+      var = var->next;
+    }
+}
+
+/*
+ * qexec_reset_pred_expr () - reset value cache for a pred expr
+ * return : void
+ * pred (in) : pred expr
+ */
+static void
+qexec_reset_pred_expr (PRED_EXPR * pred)
+{
+  if (pred == NULL)
+    {
+      return;
+    }
+  switch (pred->type)
+    {
+    case T_PRED:
+      qexec_reset_pred_expr (pred->pe.m_pred.lhs);
+      qexec_reset_pred_expr (pred->pe.m_pred.rhs);
+      break;
+    case T_EVAL_TERM:
+      switch (pred->pe.m_eval_term.et_type)
+	{
+	case T_COMP_EVAL_TERM:
+	  {
+	    COMP_EVAL_TERM *et_comp = &pred->pe.m_eval_term.et.et_comp;
+
+	    qexec_reset_regu_variable (et_comp->lhs);
+	    qexec_reset_regu_variable (et_comp->rhs);
+	  }
+	  break;
+	case T_ALSM_EVAL_TERM:
+	  {
+	    ALSM_EVAL_TERM *et_alsm = &pred->pe.m_eval_term.et.et_alsm;
+
+	    qexec_reset_regu_variable (et_alsm->elem);
+	    qexec_reset_regu_variable (et_alsm->elemset);
+	  }
+	  break;
+	case T_LIKE_EVAL_TERM:
+	  {
+	    LIKE_EVAL_TERM *et_like = &pred->pe.m_eval_term.et.et_like;
+
+	    qexec_reset_regu_variable (et_like->src);
+	    qexec_reset_regu_variable (et_like->pattern);
+	    qexec_reset_regu_variable (et_like->esc_char);
+	  }
+	  break;
+	case T_RLIKE_EVAL_TERM:
+	  {
+	    RLIKE_EVAL_TERM *et_rlike = &pred->pe.m_eval_term.et.et_rlike;
+	    qexec_reset_regu_variable (et_rlike->case_sensitive);
+	    qexec_reset_regu_variable (et_rlike->pattern);
+	    qexec_reset_regu_variable (et_rlike->src);
+	  }
+	}
+      break;
+    case T_NOT_TERM:
+      qexec_reset_pred_expr (pred->pe.m_not_term);
+      break;
+    }
+}
+
+/*
+ * qexec_reset_regu_variable () - reset the cache for a regu variable
+ * return : void
+ * var (in) : regu variable
+ */
+static void
+qexec_reset_regu_variable (REGU_VARIABLE * var)
+{
+  if (var == NULL)
+    {
+      return;
+    }
+
+  switch (var->type)
+    {
+    case TYPE_ATTR_ID:
+    case TYPE_SHARED_ATTR_ID:
+    case TYPE_CLASS_ATTR_ID:
+      var->value.attr_descr.cache_dbvalp = NULL;
+      break;
+    case TYPE_INARITH:
+    case TYPE_OUTARITH:
+      qexec_reset_regu_variable (var->value.arithptr->leftptr);
+      qexec_reset_regu_variable (var->value.arithptr->rightptr);
+      qexec_reset_regu_variable (var->value.arithptr->thirdptr);
+      /* use arithptr */
+      break;
+    case TYPE_FUNC:
+      /* use funcp */
+      qexec_reset_regu_variable_list (var->value.funcp->operand);
+      break;
+    default:
+      break;
+    }
+}
+
+/*
+ * qexec_prune_spec () - perform partition pruning on an access spec
+ * return : error code or NO_ERROR
+ * thread_p (in) :
+ * spec (in) :
+ * vd (in) :
+ * scan_op_type (in) :
+ */
+static int
+qexec_prune_spec (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * spec, VAL_DESCR * vd, SCAN_OPERATION_TYPE scan_op_type)
+{
+  PARTITION_SPEC_TYPE *partition_spec = NULL;
+  LOCK lock = NULL_LOCK;
+  int granted;
+  int error = NO_ERROR;
+
+  if (spec == NULL || spec->pruned)
+    {
+      return NO_ERROR;
+    }
+  else if (spec->pruning_type != DB_PARTITIONED_CLASS)
+    {
+      spec->pruned = true;
+      return NO_ERROR;
+    }
+
+  error = partition_prune_spec (thread_p, vd, spec);
+  if (error != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      return error;
+    }
+
+  if (!COMPOSITE_LOCK (scan_op_type) && !(spec->flags & ACCESS_SPEC_FLAG_FOR_UPDATE))
+    {
+      lock = IS_LOCK;
+    }
+  else
+    {
+      /* MVCC use IX_LOCK on class at update/delete */
+      lock = IX_LOCK;
+    }
+
+  for (partition_spec = spec->parts; partition_spec != NULL; partition_spec = partition_spec->next)
+    {
+      granted = lock_subclass (thread_p, &partition_spec->oid, &ACCESS_SPEC_CLS_OID (spec), lock, LK_UNCOND_LOCK);
+      if (granted != LK_GRANTED)
+	{
+	  ASSERT_ERROR_AND_SET (error);
+	  return error;
+	}
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * qexec_init_next_partition () - move to the next partition in the list
+ * return : S_END if there are no more partitions, S_SUCCESS on success,
+ *	    S_ERROR on error
+ * thread_p (in) :
+ * spec (in)	 : spec for which to move to the next partition
+ */
+static SCAN_CODE
+qexec_init_next_partition (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * spec)
+{
+  int error = NO_ERROR;
+  SCAN_OPERATION_TYPE scan_op_type = spec->s_id.scan_op_type;
+  bool mvcc_select_lock_needed = spec->s_id.mvcc_select_lock_needed;
+  int fixed = spec->s_id.fixed;
+  int grouped = spec->s_id.grouped;
+  QPROC_SINGLE_FETCH single_fetch = spec->s_id.single_fetch;
+  VAL_LIST *val_list = spec->s_id.val_list;
+  VAL_DESCR *vd = spec->s_id.vd;
+  bool iscan_oid_order = spec->s_id.s.isid.iscan_oid_order;
+  INDX_INFO *idxptr = NULL;
+  QUERY_ID query_id = spec->s_id.s.isid.indx_cov.query_id;
+  OID class_oid;
+  HFID class_hfid;
+  BTID btid;
+
+  if (spec->type != TARGET_CLASS && spec->type != TARGET_CLASS_ATTR)
+    {
+      return S_END;
+    }
+
+  if (spec->parts == NULL)
+    {
+      return S_END;
+    }
+
+  if (spec->curent == NULL)
+    {
+      spec->curent = spec->parts;
+    }
+  else
+    {
+      if (spec->curent->next == NULL)
+	{
+	  /* no more partitions */
+	  spec->curent = NULL;
+	}
+      else
+	{
+	  spec->curent = spec->curent->next;
+	}
+    }
+  /* close current scan and open a new one on the next partition */
+  scan_end_scan (thread_p, &spec->s_id);
+  scan_close_scan (thread_p, &spec->s_id);
+
+  /* we also need to reset caches for attributes */
+  qexec_reset_regu_variable_list (spec->s.cls_node.cls_regu_list_pred);
+  qexec_reset_regu_variable_list (spec->s.cls_node.cls_regu_list_rest);
+  qexec_reset_regu_variable_list (spec->s.cls_node.cls_regu_list_key);
+  qexec_reset_pred_expr (spec->where_pred);
+  qexec_reset_pred_expr (spec->where_key);
+
+  if (spec->curent == NULL)
+    {
+      /* reset back to root class */
+      COPY_OID (&class_oid, &ACCESS_SPEC_CLS_OID (spec));
+      HFID_COPY (&class_hfid, &ACCESS_SPEC_HFID (spec));
+      if (IS_ANY_INDEX_ACCESS (spec->access))
+	{
+	  btid = spec->btid;
+	}
+    }
+  else
+    {
+      COPY_OID (&class_oid, &spec->curent->oid);
+      HFID_COPY (&class_hfid, &spec->curent->hfid);
+      if (IS_ANY_INDEX_ACCESS (spec->access))
+	{
+	  btid = spec->curent->btid;
+	}
+    }
+  if (spec->type == TARGET_CLASS
+      && (spec->access == ACCESS_METHOD_SEQUENTIAL || spec->access == ACCESS_METHOD_SEQUENTIAL_RECORD_INFO))
+    {
+      HEAP_SCAN_ID *hsidp = &spec->s_id.s.hsid;
+      SCAN_TYPE scan_type = (spec->access == ACCESS_METHOD_SEQUENTIAL) ? S_HEAP_SCAN : S_HEAP_SCAN_RECORD_INFO;
+      int i = 0;
+      if (hsidp->caches_inited)
+	{
+	  heap_attrinfo_end (thread_p, hsidp->pred_attrs.attr_cache);
+	  heap_attrinfo_end (thread_p, hsidp->rest_attrs.attr_cache);
+	  if (hsidp->cache_recordinfo != NULL)
+	    {
+	      for (i = 0; i < HEAP_RECORD_INFO_COUNT; i++)
+		{
+		  pr_clear_value (hsidp->cache_recordinfo[i]);
+		}
+	    }
+	  hsidp->caches_inited = false;
+	}
+      hsidp->scancache_inited = false;
+
+      error =
+	scan_open_heap_scan (thread_p, &spec->s_id, mvcc_select_lock_needed, scan_op_type, fixed, grouped, single_fetch,
+			     spec->s_dbval, val_list, vd, &class_oid, &class_hfid, spec->s.cls_node.cls_regu_list_pred,
+			     spec->where_pred, spec->s.cls_node.cls_regu_list_rest,
+			     spec->s.cls_node.num_attrs_pred, spec->s.cls_node.attrids_pred,
+			     spec->s.cls_node.cache_pred, spec->s.cls_node.num_attrs_rest,
+			     spec->s.cls_node.attrids_rest, spec->s.cls_node.cache_rest,
+			     scan_type, spec->s.cls_node.cache_reserved, spec->s.cls_node.cls_regu_list_reserved);
+    }
+  else if (spec->type == TARGET_CLASS && spec->access == ACCESS_METHOD_SEQUENTIAL_PAGE_SCAN)
+    {
+      HEAP_PAGE_SCAN_ID *hpsidp = &spec->s_id.s.hpsid;
+      SCAN_TYPE scan_type = S_HEAP_PAGE_SCAN;
+      int i = 0;
+
+      if (hpsidp->cache_page_info != NULL)
+	{
+	  for (i = 0; i < HEAP_PAGE_INFO_COUNT; i++)
+	    {
+	      pr_clear_value (hpsidp->cache_page_info[i]);
+	    }
+	}
+      error =
+	scan_open_heap_page_scan (thread_p, &spec->s_id, val_list, vd, &class_oid, &class_hfid, spec->where_pred,
+				  scan_type, spec->s.cls_node.cache_reserved, spec->s.cls_node.cls_regu_list_reserved);
+    }
+  else if (spec->type == TARGET_CLASS && spec->access == ACCESS_METHOD_INDEX)
+    {
+      INDX_SCAN_ID *isidp = &spec->s_id.s.isid;
+      if (isidp->caches_inited)
+	{
+	  if (isidp->range_pred.regu_list)
+	    {
+	      heap_attrinfo_end (thread_p, isidp->range_attrs.attr_cache);
+
+	      /* some attributes might remain also cached in pred_expr
+	       * (lhs|rhs).value.attr_descr.cache_dbvalp might point to attr_cache values
+	       * see fetch_peek_dbval for example */
+	      qexec_reset_pred_expr (isidp->range_pred.pred_expr);
+	    }
+	  if (isidp->key_pred.regu_list)
+	    {
+	      heap_attrinfo_end (thread_p, isidp->key_attrs.attr_cache);
+	    }
+	  heap_attrinfo_end (thread_p, isidp->pred_attrs.attr_cache);
+	  heap_attrinfo_end (thread_p, isidp->rest_attrs.attr_cache);
+	  isidp->caches_inited = false;
+	}
+      idxptr = spec->indexptr;
+      idxptr->btid = btid;
+      spec->s_id.s.isid.scancache_inited = false;
+      spec->s_id.s.isid.caches_inited = false;
+
+      error =
+	scan_open_index_scan (thread_p, &spec->s_id, mvcc_select_lock_needed, scan_op_type, fixed, grouped,
+			      single_fetch, spec->s_dbval, val_list, vd, idxptr, &class_oid, &class_hfid,
+			      spec->s.cls_node.cls_regu_list_key, spec->where_key, spec->s.cls_node.cls_regu_list_pred,
+			      spec->where_pred, spec->s.cls_node.cls_regu_list_rest, spec->where_range,
+			      spec->s.cls_node.cls_regu_list_range,
+			      spec->s.cls_node.cls_output_val_list, spec->s.cls_node.cls_regu_val_list,
+			      spec->s.cls_node.num_attrs_key, spec->s.cls_node.attrids_key, spec->s.cls_node.cache_key,
+			      spec->s.cls_node.num_attrs_pred, spec->s.cls_node.attrids_pred,
+			      spec->s.cls_node.cache_pred, spec->s.cls_node.num_attrs_rest,
+			      spec->s.cls_node.attrids_rest, spec->s.cls_node.cache_rest,
+			      spec->s.cls_node.num_attrs_range, spec->s.cls_node.attrids_range,
+			      spec->s.cls_node.cache_range, iscan_oid_order, query_id);
+
+    }
+  else if (spec->type == TARGET_CLASS_ATTR)
+    {
+      if (spec->s_id.s.hsid.caches_inited)
+	{
+	  heap_attrinfo_end (thread_p, spec->s_id.s.hsid.pred_attrs.attr_cache);
+	  heap_attrinfo_end (thread_p, spec->s_id.s.hsid.rest_attrs.attr_cache);
+	  spec->s_id.s.hsid.caches_inited = false;
+	}
+
+      error =
+	scan_open_class_attr_scan (thread_p, &spec->s_id, grouped, spec->single_fetch, spec->s_dbval, val_list, vd,
+				   &class_oid, &class_hfid, spec->s.cls_node.cls_regu_list_pred, spec->where_pred,
+				   spec->s.cls_node.cls_regu_list_rest, spec->s.cls_node.num_attrs_pred,
+				   spec->s.cls_node.attrids_pred, spec->s.cls_node.cache_pred,
+				   spec->s.cls_node.num_attrs_rest, spec->s.cls_node.attrids_rest,
+				   spec->s.cls_node.cache_rest);
+    }
+  if (error != NO_ERROR)
+    {
+      return S_ERROR;
+    }
+
+  if (spec->curent == NULL)
+    {
+      return S_END;
+    }
+
+  error = scan_start_scan (thread_p, &spec->s_id);
+  if (error != NO_ERROR)
+    {
+      return S_ERROR;
+    }
+  return S_SUCCESS;
+}
+
+/*
+ * qexec_intprt_fnc () -
+ *   return: scan code
+ *   xasl(in)   : XASL Tree pointer
+ *   xasl_state(in)     : XASL Tree state information
+ *   tplrec(out) : Tuple record descriptor to store result tuples
+ *   next_scan_fnc(in)  : Function to interpret following XASL scan block
+ *
+ * Note: This function is the main function used to interpret an XASL
+ * tree block. That is, it assumes a general format XASL block
+ * with all possible representations.
+ */
+static SCAN_CODE
+qexec_intprt_fnc (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state, QFILE_TUPLE_RECORD * tplrec,
+		  XASL_SCAN_FNC_PTR next_scan_fnc)
+{
+#define CTE_CURRENT_SCAN_READ_TUPLE(node) \
+  ((((node)->curr_spec->type == TARGET_LIST && (node)->curr_spec->s_id.type == S_LIST_SCAN)) \
+    ? ((node)->curr_spec->s_id.s.llsid.lsid.curr_tplno) : -1)
+#define CTE_CURR_ITERATION_LAST_TUPLE(node) \
+  ((((node)->curr_spec->type == TARGET_LIST && (node)->curr_spec->s_id.type == S_LIST_SCAN)) \
+    ? ((node)->curr_spec->s_id.s.llsid.list_id->tuple_cnt - 1) : -1)
+
+  XASL_NODE *xptr;
+  SCAN_CODE xs_scan;
+  SCAN_CODE xb_scan;
+  SCAN_CODE ls_scan;
+  DB_LOGICAL ev_res;
+  int qualified;
+  AGGREGATE_TYPE *agg_ptr;
+  bool count_star_with_iscan_opt = false;
+  SCAN_OPERATION_TYPE scan_operation_type;
+  int curr_iteration_last_cursor;
+  int recursive_iterations;
+  bool max_recursive_iterations_reached = false;
+  bool cte_start_new_iteration = false;
+
+  if (xasl->type == BUILDVALUE_PROC)
+    {
+      BUILDVALUE_PROC_NODE *buildvalue = &xasl->proc.buildvalue;
+      if (buildvalue->agg_list != NULL)
+	{
+	  int error = NO_ERROR;
+	  bool is_scan_needed = false;
+	  if (!buildvalue->is_always_false)
+	    {
+	      error =
+		qexec_evaluate_aggregates_optimize (thread_p, buildvalue->agg_list, xasl->spec_list, &is_scan_needed);
+	      if (error != NO_ERROR)
+		{
+		  is_scan_needed = true;
+		}
+	    }
+
+	  if (prm_get_bool_value (PRM_ID_OPTIMIZER_ENABLE_AGGREGATE_OPTIMIZATION) == false)
+	    {
+	      is_scan_needed = true;
+	    }
+
+	  if (!is_scan_needed)
+	    {
+	      return S_SUCCESS;
+	    }
+
+	  agg_ptr = buildvalue->agg_list;
+	  if (!xasl->scan_ptr	/* no scan procedure */
+	      && !xasl->fptr_list	/* no path expressions */
+	      && !xasl->if_pred	/* no if predicates */
+	      && !xasl->instnum_pred	/* no instnum predicate */
+	      && agg_ptr->next == NULL	/* no other aggregate functions */
+	      && agg_ptr->function == PT_COUNT_STAR)
+	    {
+	      /* only one count(*) function */
+	      ACCESS_SPEC_TYPE *specp = xasl->spec_list;
+	      if (specp->next == NULL && specp->access == ACCESS_METHOD_INDEX
+		  && specp->s.cls_node.cls_regu_list_pred == NULL && specp->where_pred == NULL
+		  && !specp->indexptr->use_iss && !SCAN_IS_INDEX_MRO (&specp->s_id.s.isid)
+		  && !SCAN_IS_INDEX_COVERED (&specp->s_id.s.isid))
+		{
+		  /* count(*) query will scan an index but does not have a data-filter */
+		  specp->s_id.s.isid.need_count_only = true;
+		  count_star_with_iscan_opt = true;
+		}
+	    }
+	}
+    }
+  else if (xasl->type == BUILDLIST_PROC)
+    {
+      /* If it is BUILDLIST, do not optimize aggregation */
+      if (xasl->proc.buildlist.g_agg_list != NULL)
+	{
+	  for (agg_ptr = xasl->proc.buildlist.g_agg_list; agg_ptr; agg_ptr = agg_ptr->next)
+	    {
+	      agg_ptr->flag_agg_optimize = false;
+	    }
+	}
+    }
+
+  while ((xb_scan = qexec_next_scan_block_iterations (thread_p, xasl)) == S_SUCCESS)
+    {
+      int cte_offset_read_tuple = 0;
+      int cte_curr_scan_tplno = -1;
+
+      if (xasl->max_iterations != -1)
+	{
+	  assert (xasl->curr_spec->type == TARGET_LIST);
+	  assert (xasl->curr_spec->s_id.type == S_LIST_SCAN);
+
+	  cte_start_new_iteration = true;
+	  recursive_iterations = 1;
+	}
+
+      while ((ls_scan = scan_next_scan (thread_p, &xasl->curr_spec->s_id)) == S_SUCCESS)
+	{
+	  if (xasl->max_iterations != -1)
+	    {
+	      /* the scan tuple number resets when when a new page is fetched
+	       * cte_offset_read_tuple keeps of the global tuple number across the entire list */
+	      if (CTE_CURRENT_SCAN_READ_TUPLE (xasl) < cte_curr_scan_tplno)
+		{
+		  cte_offset_read_tuple += cte_curr_scan_tplno + 1;
+		}
+
+	      cte_curr_scan_tplno = CTE_CURRENT_SCAN_READ_TUPLE (xasl);
+
+	      if (cte_start_new_iteration)
+		{
+		  recursive_iterations++;
+		  if (recursive_iterations >= xasl->max_iterations)
+		    {
+		      max_recursive_iterations_reached = true;
+		      break;
+		    }
+
+		  curr_iteration_last_cursor = CTE_CURR_ITERATION_LAST_TUPLE (xasl);
+		  assert (curr_iteration_last_cursor >= 0);
+		  cte_start_new_iteration = false;
+		}
+
+	      if (cte_curr_scan_tplno + cte_offset_read_tuple == curr_iteration_last_cursor)
+		{
+		  cte_start_new_iteration = true;
+		}
+	    }
+
+	  if (count_star_with_iscan_opt)
+	    {
+	      xasl->proc.buildvalue.agg_list->accumulator.curr_cnt += (&xasl->curr_spec->s_id)->s.isid.oids_count;
+	      /* may have more scan ranges */
+	      continue;
+	    }
+	  /* set scan item as qualified */
+	  qualified = true;
+
+	  if (xasl->bptr_list)
+	    {
+	      if (xasl->curr_spec->flags & ACCESS_SPEC_FLAG_FOR_UPDATE)
+		{
+		  scan_operation_type = S_UPDATE;
+		}
+	      else
+		{
+		  scan_operation_type = S_SELECT;
+		}
+	    }
+
+	  /* evaluate bptr list */
+	  /* if path expression fetch fails, this instance disqualifies */
+	  for (xptr = xasl->bptr_list; qualified && xptr != NULL; xptr = xptr->next)
+	    {
+	      if (qexec_execute_obj_fetch (thread_p, xptr, xasl_state, scan_operation_type) != NO_ERROR)
+		{
+		  return S_ERROR;
+		}
+	      else if (xptr->proc.fetch.fetch_res == false)
+		{
+		  qualified = false;
+		}
+	    }
+
+	  if (qualified)
+	    {
+	      /* evaluate dptr list */
+	      for (xptr = xasl->dptr_list; xptr != NULL; xptr = xptr->next)
+		{
+		  /* clear correlated subquery list files */
+		  qexec_clear_head_lists (thread_p, xptr);
+		  if (XASL_IS_FLAGED (xptr, XASL_LINK_TO_REGU_VARIABLE))
+		    {
+		      /* skip if linked to regu var */
+		      continue;
+		    }
+		  if (qexec_execute_mainblock (thread_p, xptr, xasl_state, NULL) != NO_ERROR)
+		    {
+		      return S_ERROR;
+		    }
+		}
+
+	      /* evaluate after join predicate */
+	      ev_res = V_UNKNOWN;
+	      if (xasl->after_join_pred != NULL)
+		{
+		  ev_res = eval_pred (thread_p, xasl->after_join_pred, &xasl_state->vd, NULL);
+		  if (ev_res == V_ERROR)
+		    {
+		      return S_ERROR;
+		    }
+		}
+	      qualified = (xasl->after_join_pred == NULL || ev_res == V_TRUE);
+
+	      if (qualified)
+		{
+		  /* evaluate if predicate */
+		  ev_res = V_UNKNOWN;
+		  if (xasl->if_pred != NULL)
+		    {
+		      ev_res = eval_pred (thread_p, xasl->if_pred, &xasl_state->vd, NULL);
+		      if (ev_res == V_ERROR)
+			{
+			  return S_ERROR;
+			}
+		    }
+		  qualified = (xasl->if_pred == NULL || ev_res == V_TRUE);
+		}
+
+	      if (qualified)
+		{
+		  /* evaluate fptr list */
+		  if (xasl->fptr_list)
+		    {
+		      if (xasl->curr_spec->flags & ACCESS_SPEC_FLAG_FOR_UPDATE)
+			{
+			  scan_operation_type = S_UPDATE;
+			}
+		      else
+			{
+			  scan_operation_type = S_SELECT;
+			}
+		    }
+
+		  for (xptr = xasl->fptr_list; qualified && xptr != NULL; xptr = xptr->next)
+		    {
+		      if (qexec_execute_obj_fetch (thread_p, xptr, xasl_state, scan_operation_type) != NO_ERROR)
+			{
+			  return S_ERROR;
+			}
+		      else if (xptr->proc.fetch.fetch_res == false)
+			{
+			  qualified = false;
+			}
+		    }
+
+		  if (qualified)
+		    {
+
+		      if (!xasl->scan_ptr)
+			{	/* no scan procedure block */
+
+			  /* if hierarchical query do special processing */
+			  if (XASL_IS_FLAGED (xasl, XASL_HAS_CONNECT_BY))
+			    {
+			      if (qexec_update_connect_by_lists (thread_p, xasl->connect_by_ptr, xasl_state, tplrec) !=
+				  NO_ERROR)
+				{
+				  return S_ERROR;
+				}
+			    }
+			  else
+			    {
+			      /* evaluate inst_num predicate */
+			      if (xasl->instnum_val)
+				{
+				  ev_res = qexec_eval_instnum_pred (thread_p, xasl, xasl_state);
+				  if (ev_res == V_ERROR)
+				    {
+				      return S_ERROR;
+				    }
+
+
+				  if ((xasl->instnum_flag & XASL_INSTNUM_FLAG_SCAN_LAST_STOP))
+				    {
+				      if (qexec_end_one_iteration (thread_p, xasl, xasl_state, tplrec) != NO_ERROR)
+					{
+					  return S_ERROR;
+					}
+
+				      return S_SUCCESS;
+				    }
+
+				  if ((xasl->instnum_flag & XASL_INSTNUM_FLAG_SCAN_STOP))
+				    {
+				      return S_SUCCESS;
+				    }
+				}
+			      qualified = (xasl->instnum_pred == NULL || ev_res == V_TRUE);
+			      if (qualified
+				  && (qexec_end_one_iteration (thread_p, xasl, xasl_state, tplrec) != NO_ERROR))
+				{
+				  return S_ERROR;
+				}
+			    }
+
+			}
+		      else
+			{	/* handle the scan procedure */
+			  /* current scan block has at least one qualified item */
+			  xasl->curr_spec->s_id.qualified_block = true;
+
+			  /* handle the scan procedure */
+			  xasl->scan_ptr->next_scan_on = false;
+			  if (scan_reset_scan_block (thread_p, &xasl->scan_ptr->curr_spec->s_id) == S_ERROR)
+			    {
+			      return S_ERROR;
+			    }
+
+			  xasl->next_scan_on = true;
+
+
+			  while ((xs_scan = (*next_scan_fnc) (thread_p, xasl->scan_ptr, xasl_state, tplrec,
+							      next_scan_fnc + 1)) == S_SUCCESS)
+			    {
+
+			      /* if hierarchical query do special processing */
+			      if (XASL_IS_FLAGED (xasl, XASL_HAS_CONNECT_BY))
+				{
+				  if (qexec_update_connect_by_lists (thread_p, xasl->connect_by_ptr, xasl_state, tplrec)
+				      != NO_ERROR)
+				    {
+				      return S_ERROR;
+				    }
+				}
+			      else
+				{
+				  /* evaluate inst_num predicate */
+				  if (xasl->instnum_val)
+				    {
+				      ev_res = qexec_eval_instnum_pred (thread_p, xasl, xasl_state);
+				      if (ev_res == V_ERROR)
+					{
+					  return S_ERROR;
+					}
+
+				      if ((xasl->instnum_flag & XASL_INSTNUM_FLAG_SCAN_LAST_STOP))
+					{
+					  if (qexec_end_one_iteration (thread_p, xasl, xasl_state, tplrec) != NO_ERROR)
+					    {
+					      return S_ERROR;
+					    }
+
+					  return S_SUCCESS;
+					}
+
+				      if (xasl->instnum_flag & XASL_INSTNUM_FLAG_SCAN_STOP)
+					{
+					  return S_SUCCESS;
+					}
+				    }
+				  qualified = (xasl->instnum_pred == NULL || ev_res == V_TRUE);
+
+				  if (qualified
+				      /* one iteration successfully completed */
+				      && qexec_end_one_iteration (thread_p, xasl, xasl_state, tplrec) != NO_ERROR)
+				    {
+				      return S_ERROR;
+				    }
+				}
+
+			    }
+
+			  if (xs_scan != S_END)	/* an error happened */
+			    {
+			      return S_ERROR;
+			    }
+			}
+		    }
+		}
+	    }
+
+	  qexec_clear_all_lists (thread_p, xasl);
+	}
+
+      if (max_recursive_iterations_reached)
+	{
+	  xb_scan = S_ERROR;
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CTE_MAX_RECURSION_REACHED, 1, xasl->max_iterations);
+	  break;
+	}
 
-  for (partition_spec = spec->parts; partition_spec != NULL; partition_spec = partition_spec->next)
-    {
-      granted = lock_subclass (thread_p, &partition_spec->oid, &ACCESS_SPEC_CLS_OID (spec), lock, LK_UNCOND_LOCK);
-      if (granted != LK_GRANTED)
+      if (ls_scan != S_END)	/* an error happened */
 	{
-	  ASSERT_ERROR_AND_SET (error);
-	  return error;
+	  return S_ERROR;
 	}
     }
 
-  return NO_ERROR;
+  if (xb_scan != S_END)		/* an error happened */
+    {
+      return S_ERROR;
+    }
+
+  return S_SUCCESS;
+
+#undef CTE_CURRENT_SCAN_READ_TUPLE
+#undef CTE_CURR_ITERATION_LAST_TUPLE
 }
 
+#if defined (SERVER_MODE)
 /*
- * qexec_init_next_partition () - move to the next partition in the list
- * return : S_END if there are no more partitions, S_SUCCESS on success,
- *	    S_ERROR on error
- * thread_p (in) :
- * spec (in)	 : spec for which to move to the next partition
+ * qexec_is_parallel_scan_eligible () - can the XASL block be interpreted by qexec_intprt_fnc_parallel?
+ *   return: true if eligible
+ *   xasl(in): XASL Tree pointer
+ *
+ * Note: Only top most scalar aggregate queries over a single heap file qualify. The aggregates must be mergeable
+ *       and the block must not depend on other XASL blocks or on the order of the scanned rows.
  */
-static SCAN_CODE
-qexec_init_next_partition (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * spec)
+static bool
+qexec_is_parallel_scan_eligible (XASL_NODE * xasl)
 {
-  int error = NO_ERROR;
-  SCAN_OPERATION_TYPE scan_op_type = spec->s_id.scan_op_type;
-  bool mvcc_select_lock_needed = spec->s_id.mvcc_select_lock_needed;
-  int fixed = spec->s_id.fixed;
-  int grouped = spec->s_id.grouped;
-  QPROC_SINGLE_FETCH single_fetch = spec->s_id.single_fetch;
-  VAL_LIST *val_list = spec->s_id.val_list;
-  VAL_DESCR *vd = spec->s_id.vd;
-  bool iscan_oid_order = spec->s_id.s.isid.iscan_oid_order;
-  INDX_INFO *idxptr = NULL;
-  QUERY_ID query_id = spec->s_id.s.isid.indx_cov.query_id;
-  OID class_oid;
-  HFID class_hfid;
-  BTID btid;
+  ACCESS_SPEC_TYPE *specp;
+  AGGREGATE_TYPE *agg_p;
 
-  if (spec->type != TARGET_CLASS && spec->type != TARGET_CLASS_ATTR)
+  if (xasl->type != BUILDVALUE_PROC || !XASL_IS_FLAGED (xasl, XASL_TOP_MOST_XASL)
+      || xasl->proc.buildvalue.agg_list == NULL || xasl->proc.buildvalue.is_always_false)
     {
-      return S_END;
+      return false;
     }
 
-  if (spec->parts == NULL)
+  if (xasl->scan_ptr != NULL || xasl->merge_spec != NULL || xasl->aptr_list != NULL || xasl->bptr_list != NULL
+      || xasl->dptr_list != NULL || xasl->fptr_list != NULL || XASL_IS_FLAGED (xasl, XASL_HAS_CONNECT_BY)
+      || xasl->instnum_val != NULL || xasl->instnum_pred != NULL || xasl->limit_row_count != NULL
+      || xasl->selected_upd_list != NULL || xasl->scan_op_type != S_SELECT || xasl->upd_del_class_cnt != 0)
     {
-      return S_END;
+      return false;
     }
 
-  if (spec->curent == NULL)
-    {
-      spec->curent = spec->parts;
-    }
-  else
+  specp = xasl->spec_list;
+  if (specp == NULL || specp->next != NULL || specp->type != TARGET_CLASS
+      || specp->access != ACCESS_METHOD_SEQUENTIAL || specp->pruning_type != DB_NOT_PARTITIONED_CLASS
+      || specp->parts != NULL || QEXEC_EMPTY_ACCESS_SPEC_SCAN (specp))
     {
-      if (spec->curent->next == NULL)
-	{
-	  /* no more partitions */
-	  spec->curent = NULL;
-	}
-      else
-	{
-	  spec->curent = spec->curent->next;
-	}
+      return false;
     }
-  /* close current scan and open a new one on the next partition */
-  scan_end_scan (thread_p, &spec->s_id);
-  scan_close_scan (thread_p, &spec->s_id);
-
-  /* we also need to reset caches for attributes */
-  qexec_reset_regu_variable_list (spec->s.cls_node.cls_regu_list_pred);
-  qexec_reset_regu_variable_list (spec->s.cls_node.cls_regu_list_rest);
-  qexec_reset_regu_variable_list (spec->s.cls_node.cls_regu_list_key);
-  qexec_reset_pred_expr (spec->where_pred);
-  qexec_reset_pred_expr (spec->where_key);
 
-  if (spec->curent == NULL)
-    {
-      /* reset back to root class */
-      COPY_OID (&class_oid, &ACCESS_SPEC_CLS_OID (spec));
-      HFID_COPY (&class_hfid, &ACCESS_SPEC_HFID (spec));
-      if (IS_ANY_INDEX_ACCESS (spec->access))
-	{
-	  btid = spec->btid;
-	}
-    }
-  else
-    {
-      COPY_OID (&class_oid, &spec->curent->oid);
-      HFID_COPY (&class_hfid, &spec->curent->hfid);
-      if (IS_ANY_INDEX_ACCESS (spec->access))
-	{
-	  btid = spec->curent->btid;
-	}
-    }
-  if (spec->type == TARGET_CLASS
-      && (spec->access == ACCESS_METHOD_SEQUENTIAL || spec->access == ACCESS_METHOD_SEQUENTIAL_RECORD_INFO))
+  for (agg_p = xasl->proc.buildvalue.agg_list; agg_p != NULL; agg_p = agg_p->next)
     {
-      HEAP_SCAN_ID *hsidp = &spec->s_id.s.hsid;
-      SCAN_TYPE scan_type = (spec->access == ACCESS_METHOD_SEQUENTIAL) ? S_HEAP_SCAN : S_HEAP_SCAN_RECORD_INFO;
-      int i = 0;
-      if (hsidp->caches_inited)
+      if (agg_p->option == Q_DISTINCT || agg_p->sort_list != NULL || agg_p->flag_agg_optimize)
 	{
-	  heap_attrinfo_end (thread_p, hsidp->pred_attrs.attr_cache);
-	  heap_attrinfo_end (thread_p, hsidp->rest_attrs.attr_cache);
-	  if (hsidp->cache_recordinfo != NULL)
-	    {
-	      for (i = 0; i < HEAP_RECORD_INFO_COUNT; i++)
-		{
-		  pr_clear_value (hsidp->cache_recordinfo[i]);
-		}
-	    }
-	  hsidp->caches_inited = false;
+	  return false;
 	}
-      hsidp->scancache_inited = false;
-
-      error =
-	scan_open_heap_scan (thread_p, &spec->s_id, mvcc_select_lock_needed, scan_op_type, fixed, grouped, single_fetch,
-			     spec->s_dbval, val_list, vd, &class_oid, &class_hfid, spec->s.cls_node.cls_regu_list_pred,
-			     spec->where_pred, spec->s.cls_node.cls_regu_list_rest,
-			     spec->s.cls_node.num_attrs_pred, spec->s.cls_node.attrids_pred,
-			     spec->s.cls_node.cache_pred, spec->s.cls_node.num_attrs_rest,
-			     spec->s.cls_node.attrids_rest, spec->s.cls_node.cache_rest,
-			     scan_type, spec->s.cls_node.cache_reserved, spec->s.cls_node.cls_regu_list_reserved);
-    }
-  else if (spec->type == TARGET_CLASS && spec->access == ACCESS_METHOD_SEQUENTIAL_PAGE_SCAN)
-    {
-      HEAP_PAGE_SCAN_ID *hpsidp = &spec->s_id.s.hpsid;
-      SCAN_TYPE scan_type = S_HEAP_PAGE_SCAN;
-      int i = 0;
 
-      if (hpsidp->cache_page_info != NULL)
-	{
-	  for (i = 0; i < HEAP_PAGE_INFO_COUNT; i++)
-	    {
-	      pr_clear_value (hpsidp->cache_page_info[i]);
-	    }
-	}
-      error =
-	scan_open_heap_page_scan (thread_p, &spec->s_id, val_list, vd, &class_oid, &class_hfid, spec->where_pred,
-				  scan_type, spec->s.cls_node.cache_reserved, spec->s.cls_node.cls_regu_list_reserved);
-    }
-  else if (spec->type == TARGET_CLASS && spec->access == ACCESS_METHOD_INDEX)
-    {
-      INDX_SCAN_ID *isidp = &spec->s_id.s.isid;
-      if (isidp->caches_inited)
+      switch (agg_p->function)
 	{
-	  if (isidp->range_pred.regu_list)
-	    {
-	      heap_attrinfo_end (thread_p, isidp->range_attrs.attr_cache);
-
-	      /* some attributes might remain also cached in pred_expr
-	       * (lhs|rhs).value.attr_descr.cache_dbvalp might point to attr_cache values
-	       * see fetch_peek_dbval for example */
-	      qexec_reset_pred_expr (isidp->range_pred.pred_expr);
-	    }
-	  if (isidp->key_pred.regu_list)
-	    {
-	      heap_attrinfo_end (thread_p, isidp->key_attrs.attr_cache);
-	    }
-	  heap_attrinfo_end (thread_p, isidp->pred_attrs.attr_cache);
-	  heap_attrinfo_end (thread_p, isidp->rest_attrs.attr_cache);
-	  isidp->caches_inited = false;
-	}
-      idxptr = spec->indexptr;
-      idxptr->btid = btid;
-      spec->s_id.s.isid.scancache_inited = false;
-      spec->s_id.s.isid.caches_inited = false;
-
-      error =
-	scan_open_index_scan (thread_p, &spec->s_id, mvcc_select_lock_needed, scan_op_type, fixed, grouped,
-			      single_fetch, spec->s_dbval, val_list, vd, idxptr, &class_oid, &class_hfid,
-			      spec->s.cls_node.cls_regu_list_key, spec->where_key, spec->s.cls_node.cls_regu_list_pred,
-			      spec->where_pred, spec->s.cls_node.cls_regu_list_rest, spec->where_range,
-			      spec->s.cls_node.cls_regu_list_range,
-			      spec->s.cls_node.cls_output_val_list, spec->s.cls_node.cls_regu_val_list,
-			      spec->s.cls_node.num_attrs_key, spec->s.cls_node.attrids_key, spec->s.cls_node.cache_key,
-			      spec->s.cls_node.num_attrs_pred, spec->s.cls_node.attrids_pred,
-			      spec->s.cls_node.cache_pred, spec->s.cls_node.num_attrs_rest,
-			      spec->s.cls_node.attrids_rest, spec->s.cls_node.cache_rest,
-			      spec->s.cls_node.num_attrs_range, spec->s.cls_node.attrids_range,
-			      spec->s.cls_node.cache_range, iscan_oid_order, query_id);
+	case PT_COUNT_STAR:
+	case PT_COUNT:
+	case PT_SUM:
+	case PT_AVG:
+	case PT_MIN:
+	case PT_MAX:
+	case PT_AGG_BIT_AND:
+	case PT_AGG_BIT_OR:
+	case PT_AGG_BIT_XOR:
+	case PT_STDDEV:
+	case PT_STDDEV_POP:
+	case PT_STDDEV_SAMP:
+	case PT_VARIANCE:
+	case PT_VAR_POP:
+	case PT_VAR_SAMP:
+	  break;
 
-    }
-  else if (spec->type == TARGET_CLASS_ATTR)
-    {
-      if (spec->s_id.s.hsid.caches_inited)
-	{
-	  heap_attrinfo_end (thread_p, spec->s_id.s.hsid.pred_attrs.attr_cache);
-	  heap_attrinfo_end (thread_p, spec->s_id.s.hsid.rest_attrs.attr_cache);
-	  spec->s_id.s.hsid.caches_inited = false;
+	default:
+	  return false;
 	}
-
-      error =
-	scan_open_class_attr_scan (thread_p, &spec->s_id, grouped, spec->single_fetch, spec->s_dbval, val_list, vd,
-				   &class_oid, &class_hfid, spec->s.cls_node.cls_regu_list_pred, spec->where_pred,
-				   spec->s.cls_node.cls_regu_list_rest, spec->s.cls_node.num_attrs_pred,
-				   spec->s.cls_node.attrids_pred, spec->s.cls_node.cache_pred,
-				   spec->s.cls_node.num_attrs_rest, spec->s.cls_node.attrids_rest,
-				   spec->s.cls_node.cache_rest);
-    }
-  if (error != NO_ERROR)
-    {
-      return S_ERROR;
-    }
-
-  if (spec->curent == NULL)
-    {
-      return S_END;
     }
 
-  error = scan_start_scan (thread_p, &spec->s_id);
-  if (error != NO_ERROR)
-    {
-      return S_ERROR;
-    }
-  return S_SUCCESS;
+  return true;
 }
 
 /*
- * qexec_intprt_fnc () -
- *   return: scan code
- *   xasl(in)   : XASL Tree pointer
- *   xasl_state(in)     : XASL Tree state information
- *   tplrec(out) : Tuple record descriptor to store result tuples
- *   next_scan_fnc(in)  : Function to interpret following XASL scan block
- *
- * Note: This function is the main function used to interpret an XASL
- * tree block. That is, it assumes a general format XASL block
- * with all possible representations.
+ * qexec_parallel_scan_claim () - claim the next chunk of heap pages of a parallel scan
+ *   return: false if all pages are claimed
+ *   pscan(in): parallel scan
+ *   first_page(out): index of the first page of the chunk
+ *   n_pages(out): number of pages of the chunk
  */
-static SCAN_CODE
-qexec_intprt_fnc (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state, QFILE_TUPLE_RECORD * tplrec,
-		  XASL_SCAN_FNC_PTR next_scan_fnc)
+static bool
+qexec_parallel_scan_claim (PARALLEL_SCAN * pscan, int *first_page, int *n_pages)
 {
-#define CTE_CURRENT_SCAN_READ_TUPLE(node) \
-  ((((node)->curr_spec->type == TARGET_LIST && (node)->curr_spec->s_id.type == S_LIST_SCAN)) \
-    ? ((node)->curr_spec->s_id.s.llsid.lsid.curr_tplno) : -1)
-#define CTE_CURR_ITERATION_LAST_TUPLE(node) \
-  ((((node)->curr_spec->type == TARGET_LIST && (node)->curr_spec->s_id.type == S_LIST_SCAN)) \
-    ? ((node)->curr_spec->s_id.s.llsid.list_id->tuple_cnt - 1) : -1)
-
-  XASL_NODE *xptr;
-  SCAN_CODE xs_scan;
-  SCAN_CODE xb_scan;
-  SCAN_CODE ls_scan;
-  DB_LOGICAL ev_res;
-  int qualified;
-  AGGREGATE_TYPE *agg_ptr;
-  bool count_star_with_iscan_opt = false;
-  SCAN_OPERATION_TYPE scan_operation_type;
-  int curr_iteration_last_cursor;
-  int recursive_iterations;
-  bool max_recursive_iterations_reached = false;
-  bool cte_start_new_iteration = false;
+  bool claimed = false;
 
-  if (xasl->type == BUILDVALUE_PROC)
+  pthread_mutex_lock (&pscan->mutex);
+  if (pscan->next_page < pscan->n_pages)
     {
-      BUILDVALUE_PROC_NODE *buildvalue = &xasl->proc.buildvalue;
-      if (buildvalue->agg_list != NULL)
-	{
-	  int error = NO_ERROR;
-	  bool is_scan_needed = false;
-	  if (!buildvalue->is_always_false)
-	    {
-	      error =
-		qexec_evaluate_aggregates_optimize (thread_p, buildvalue->agg_list, xasl->spec_list, &is_scan_needed);
-	      if (error != NO_ERROR)
-		{
-		  is_scan_needed = true;
-		}
-	    }
+      *first_page = pscan->next_page;
+      *n_pages = MIN (pscan->chunk_size, pscan->n_pages - pscan->next_page);
+      pscan->next_page += *n_pages;
+      claimed = true;
+    }
+  pthread_mutex_unlock (&pscan->mutex);
 
-	  if (prm_get_bool_value (PRM_ID_OPTIMIZER_ENABLE_AGGREGATE_OPTIMIZATION) == false)
-	    {
-	      is_scan_needed = true;
-	    }
+  return claimed;
+}
 
-	  if (!is_scan_needed)
-	    {
-	      return S_SUCCESS;
-	    }
+/*
+ * qexec_parallel_scan_set_error () - stop a parallel scan on error
+ *   return: void
+ *   pscan(in): parallel scan
+ *
+ * Note: Called by workers; the first error is saved to be raised again by the query thread.
+ */
+static void
+qexec_parallel_scan_set_error (PARALLEL_SCAN * pscan)
+{
+  int length = 1024;
 
-	  agg_ptr = buildvalue->agg_list;
-	  if (!xasl->scan_ptr	/* no scan procedure */
-	      && !xasl->fptr_list	/* no path expressions */
-	      && !xasl->if_pred	/* no if predicates */
-	      && !xasl->instnum_pred	/* no instnum predicate */
-	      && agg_ptr->next == NULL	/* no other aggregate functions */
-	      && agg_ptr->function == PT_COUNT_STAR)
-	    {
-	      /* only one count(*) function */
-	      ACCESS_SPEC_TYPE *specp = xasl->spec_list;
-	      if (specp->next == NULL && specp->access == ACCESS_METHOD_INDEX
-		  && specp->s.cls_node.cls_regu_list_pred == NULL && specp->where_pred == NULL
-		  && !specp->indexptr->use_iss && !SCAN_IS_INDEX_MRO (&specp->s_id.s.isid)
-		  && !SCAN_IS_INDEX_COVERED (&specp->s_id.s.isid))
-		{
-		  /* count(*) query will scan an index but does not have a data-filter */
-		  specp->s_id.s.isid.need_count_only = true;
-		  count_star_with_iscan_opt = true;
-		}
-	    }
+  pthread_mutex_lock (&pscan->mutex);
+  if (!pscan->has_error)
+    {
+      if (er_errid () == NO_ERROR)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_GENERIC_ERROR, 0);
 	}
+      (void) er_get_area_error (OR_ALIGNED_BUF_START (pscan->error_area), &length);
+      pscan->has_error = true;
     }
-  else if (xasl->type == BUILDLIST_PROC)
+  /* nothing left to claim */
+  pscan->next_page = pscan->n_pages;
+  pthread_mutex_unlock (&pscan->mutex);
+}
+
+/*
+ * qexec_parallel_scan_run () - scan and aggregate chunks of heap pages until all are claimed
+ *   return: scan code
+ *   pscan(in): parallel scan
+ *   xasl(in): XASL Tree pointer; its heap scan is opened
+ *   xasl_state(in): XASL Tree state information
+ *   tplrec(out): Tuple record descriptor
+ */
+static SCAN_CODE
+qexec_parallel_scan_run (THREAD_ENTRY * thread_p, PARALLEL_SCAN * pscan, XASL_NODE * xasl, XASL_STATE * xasl_state,
+			 QFILE_TUPLE_RECORD * tplrec)
+{
+  int first_page, n_pages;
+
+  while (qexec_parallel_scan_claim (pscan, &first_page, &n_pages))
     {
-      /* If it is BUILDLIST, do not optimize aggregation */
-      if (xasl->proc.buildlist.g_agg_list != NULL)
+      scan_set_heap_page_set (&xasl->spec_list->s_id, &pscan->pages[first_page], n_pages);
+      if (qexec_intprt_fnc (thread_p, xasl, xasl_state, tplrec, NULL) != S_SUCCESS)
 	{
-	  for (agg_ptr = xasl->proc.buildlist.g_agg_list; agg_ptr; agg_ptr = agg_ptr->next)
-	    {
-	      agg_ptr->flag_agg_optimize = false;
-	    }
+	  return S_ERROR;
 	}
     }
 
-  while ((xb_scan = qexec_next_scan_block_iterations (thread_p, xasl)) == S_SUCCESS)
-    {
-      int cte_offset_read_tuple = 0;
-      int cte_curr_scan_tplno = -1;
+  return S_SUCCESS;
+}
 
-      if (xasl->max_iterations != -1)
-	{
-	  assert (xasl->curr_spec->type == TARGET_LIST);
-	  assert (xasl->curr_spec->s_id.type == S_LIST_SCAN);
+/*
+ * qexec_parallel_scan_execute () - execute a worker of a parallel scan
+ *   return: void
+ *   thread_ref(in): worker thread
+ *   pscan(in): parallel scan
+ *   worker_index(in): index of the worker
+ *
+ * Note: Workers share the transaction of the query thread (see thread_share_tran) and only read, with the snapshot
+ *       the query thread took before handing them over; logtb_check_tran_owner rejects anything else.
+ */
+// *INDENT-OFF*
+static void
+qexec_parallel_scan_execute (cubthread::entry &thread_ref, PARALLEL_SCAN * pscan, int worker_index)
+{
+  THREAD_ENTRY *thread_p = &thread_ref;
+  XASL_CLONE xclone = XASL_CLONE_INITIALIZER;
+  XASL_NODE *xasl = NULL;
+  XASL_STATE xasl_state;
+  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
+  ACCESS_SPEC_TYPE *specp = NULL;
+  AGGREGATE_TYPE *agg_p;
+  bool scan_opened = false;
+  bool mvcc_select_lock_needed = false;
+  bool has_pages;
+  int error = NO_ERROR;
 
-	  cte_start_new_iteration = true;
-	  recursive_iterations = 1;
-	}
+  pthread_mutex_lock (&pscan->mutex);
+  has_pages = pscan->next_page < pscan->n_pages;
+  pthread_mutex_unlock (&pscan->mutex);
 
-      while ((ls_scan = scan_next_scan (thread_p, &xasl->curr_spec->s_id)) == S_SUCCESS)
-	{
-	  if (xasl->max_iterations != -1)
-	    {
-	      /* the scan tuple number resets when when a new page is fetched
-	       * cte_offset_read_tuple keeps of the global tuple number across the entire list */
-	      if (CTE_CURRENT_SCAN_READ_TUPLE (xasl) < cte_curr_scan_tplno)
-		{
-		  cte_offset_read_tuple += cte_curr_scan_tplno + 1;
-		}
+  if (!has_pages)
+    {
+      /* the others were faster; do not bother with a clone */
+      goto publish;
+    }
 
-	      cte_curr_scan_tplno = CTE_CURRENT_SCAN_READ_TUPLE (xasl);
+  error = xcache_get_clone (thread_p, pscan->xcache_entry, &xclone);
+  if (error != NO_ERROR)
+    {
+      goto publish;
+    }
+  xasl = xclone.xasl;
+  assert (xasl->type == BUILDVALUE_PROC);
 
-	      if (cte_start_new_iteration)
-		{
-		  recursive_iterations++;
-		  if (recursive_iterations >= xasl->max_iterations)
-		    {
-		      max_recursive_iterations_reached = true;
-		      break;
-		    }
+  xasl_state = *pscan->xasl_state;
+  xasl_state.vd.xasl_state = &xasl_state;
 
-		  curr_iteration_last_cursor = CTE_CURR_ITERATION_LAST_TUPLE (xasl);
-		  assert (curr_iteration_last_cursor >= 0);
-		  cte_start_new_iteration = false;
-		}
+  /* start iterations like qexec_execute_mainblock does */
+  for (agg_p = xasl->proc.buildvalue.agg_list; agg_p != NULL; agg_p = agg_p->next)
+    {
+      agg_p->accumulator_domain.value_dom = NULL;
+      agg_p->accumulator_domain.value2_dom = NULL;
+    }
+  xasl->proc.buildvalue.agg_domains_resolved = 0;
+  if (xasl->proc.buildvalue.grbynum_val)
+    {
+      db_make_bigint (xasl->proc.buildvalue.grbynum_val, 1);
+    }
+  error = qdata_initialize_aggregate_list (thread_p, xasl->proc.buildvalue.agg_list, xasl_state.query_id);
+  if (error != NO_ERROR)
+    {
+      goto publish;
+    }
 
-	      if (cte_curr_scan_tplno + cte_offset_read_tuple == curr_iteration_last_cursor)
-		{
-		  cte_start_new_iteration = true;
-		}
-	    }
+  specp = xasl->spec_list;
+  specp->fixed_scan = pscan->fixed_scan;
+  specp->grouped_scan = false;
+  error = qexec_open_scan (thread_p, specp, xasl->val_list, &xasl_state.vd, false, specp->fixed_scan, false,
+			   xasl->iscan_oid_order, &specp->s_id, xasl_state.query_id, xasl->scan_op_type, false,
+			   &mvcc_select_lock_needed);
+  if (error != NO_ERROR)
+    {
+      goto publish;
+    }
+  scan_opened = true;
 
-	  if (count_star_with_iscan_opt)
-	    {
-	      xasl->proc.buildvalue.agg_list->accumulator.curr_cnt += (&xasl->curr_spec->s_id)->s.isid.oids_count;
-	      /* may have more scan ranges */
-	      continue;
-	    }
-	  /* set scan item as qualified */
-	  qualified = true;
+  if (qexec_parallel_scan_run (thread_p, pscan, xasl, &xasl_state, &tplrec) != S_SUCCESS)
+    {
+      error = ER_FAILED;
+      goto publish;
+    }
 
-	  if (xasl->bptr_list)
-	    {
-	      if (xasl->curr_spec->flags & ACCESS_SPEC_FLAG_FOR_UPDATE)
-		{
-		  scan_operation_type = S_UPDATE;
-		}
-	      else
-		{
-		  scan_operation_type = S_SELECT;
-		}
-	    }
+publish:
+  if (scan_opened)
+    {
+      qexec_end_scan (thread_p, specp);
+      qexec_close_scan (thread_p, specp);
+      xasl->curr_spec = NULL;
+    }
 
-	  /* evaluate bptr list */
-	  /* if path expression fetch fails, this instance disqualifies */
-	  for (xptr = xasl->bptr_list; qualified && xptr != NULL; xptr = xptr->next)
-	    {
-	      if (qexec_execute_obj_fetch (thread_p, xptr, xasl_state, scan_operation_type) != NO_ERROR)
-		{
-		  return S_ERROR;
-		}
-	      else if (xptr->proc.fetch.fetch_res == false)
-		{
-		  qualified = false;
-		}
-	    }
+  if (error != NO_ERROR)
+    {
+      qexec_parallel_scan_set_error (pscan);
+    }
+  else
+    {
+      pscan->workers[worker_index].xasl = xasl;
+    }
 
-	  if (qualified)
-	    {
-	      /* evaluate dptr list */
-	      for (xptr = xasl->dptr_list; xptr != NULL; xptr = xptr->next)
-		{
-		  /* clear correlated subquery list files */
-		  qexec_clear_head_lists (thread_p, xptr);
-		  if (XASL_IS_FLAGED (xptr, XASL_LINK_TO_REGU_VARIABLE))
-		    {
-		      /* skip if linked to regu var */
-		      continue;
-		    }
-		  if (qexec_execute_mainblock (thread_p, xptr, xasl_state, NULL) != NO_ERROR)
-		    {
-		      return S_ERROR;
-		    }
-		}
+  /* partial aggregates live in the private heap of this thread; keep them until the query thread merged them */
+  pthread_mutex_lock (&pscan->mutex);
+  pscan->n_published++;
+  pthread_cond_broadcast (&pscan->cond);
+  while (!pscan->merged)
+    {
+      pthread_cond_wait (&pscan->cond, &pscan->mutex);
+    }
+  pthread_mutex_unlock (&pscan->mutex);
 
-	      /* evaluate after join predicate */
-	      ev_res = V_UNKNOWN;
-	      if (xasl->after_join_pred != NULL)
-		{
-		  ev_res = eval_pred (thread_p, xasl->after_join_pred, &xasl_state->vd, NULL);
-		  if (ev_res == V_ERROR)
-		    {
-		      return S_ERROR;
-		    }
-		}
-	      qualified = (xasl->after_join_pred == NULL || ev_res == V_TRUE);
+  if (xclone.xasl != NULL)
+    {
+      (void) qexec_clear_xasl (thread_p, xclone.xasl, true);
+      xcache_retire_clone (thread_p, pscan->xcache_entry, &xclone);
+    }
+  if (tplrec.tpl != NULL)
+    {
+      db_private_free_and_init (thread_p, tplrec.tpl);
+    }
+  er_clear ();
+}
+// *INDENT-ON*
 
-	      if (qualified)
-		{
-		  /* evaluate if predicate */
-		  ev_res = V_UNKNOWN;
-		  if (xasl->if_pred != NULL)
-		    {
-		      ev_res = eval_pred (thread_p, xasl->if_pred, &xasl_state->vd, NULL);
-		      if (ev_res == V_ERROR)
-			{
-			  return S_ERROR;
-			}
-		    }
-		  qualified = (xasl->if_pred == NULL || ev_res == V_TRUE);
-		}
+/*
+ * qexec_parallel_scan_merge () - merge the partial aggregates of a worker
+ *   return: error code
+ *   xasl(in/out): XASL of the query thread
+ *   part_xasl(in): XASL clone of the worker
+ */
+static int
+qexec_parallel_scan_merge (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_NODE * part_xasl)
+{
+  AGGREGATE_TYPE *agg_p, *part_agg_p;
 
-	      if (qualified)
-		{
-		  /* evaluate fptr list */
-		  if (xasl->fptr_list)
-		    {
-		      if (xasl->curr_spec->flags & ACCESS_SPEC_FLAG_FOR_UPDATE)
-			{
-			  scan_operation_type = S_UPDATE;
-			}
-		      else
-			{
-			  scan_operation_type = S_SELECT;
-			}
-		    }
+  for (agg_p = xasl->proc.buildvalue.agg_list, part_agg_p = part_xasl->proc.buildvalue.agg_list;
+       agg_p != NULL && part_agg_p != NULL; agg_p = agg_p->next, part_agg_p = part_agg_p->next)
+    {
+      assert (agg_p->function == part_agg_p->function);
 
-		  for (xptr = xasl->fptr_list; qualified && xptr != NULL; xptr = xptr->next)
-		    {
-		      if (qexec_execute_obj_fetch (thread_p, xptr, xasl_state, scan_operation_type) != NO_ERROR)
-			{
-			  return S_ERROR;
-			}
-		      else if (xptr->proc.fetch.fetch_res == false)
-			{
-			  qualified = false;
-			}
-		    }
+      if (part_agg_p->accumulator.curr_cnt < 1)
+	{
+	  /* nothing was aggregated */
+	  continue;
+	}
+
+      if (agg_p->accumulator_domain.value_dom == NULL || agg_p->accumulator_domain.value2_dom == NULL)
+	{
+	  /* no value was aggregated by the query thread; domains are resolved by the worker */
+	  agg_p->domain = part_agg_p->domain;
+	  agg_p->opr_dbtype = part_agg_p->opr_dbtype;
+	  agg_p->accumulator_domain = part_agg_p->accumulator_domain;
+	}
 
-		  if (qualified)
-		    {
+      if (qdata_aggregate_accumulator_to_accumulator (thread_p, &agg_p->accumulator, &agg_p->accumulator_domain,
+						      agg_p->function, agg_p->domain,
+						      &part_agg_p->accumulator) != NO_ERROR)
+	{
+	  return ER_FAILED;
+	}
+    }
 
-		      if (!xasl->scan_ptr)
-			{	/* no scan procedure block */
+  return NO_ERROR;
+}
 
-			  /* if hierarchical query do special processing */
-			  if (XASL_IS_FLAGED (xasl, XASL_HAS_CONNECT_BY))
-			    {
-			      if (qexec_update_connect_by_lists (thread_p, xasl->connect_by_ptr, xasl_state, tplrec) !=
-				  NO_ERROR)
-				{
-				  return S_ERROR;
-				}
-			    }
-			  else
-			    {
-			      /* evaluate inst_num predicate */
-			      if (xasl->instnum_val)
-				{
-				  ev_res = qexec_eval_instnum_pred (thread_p, xasl, xasl_state);
-				  if (ev_res == V_ERROR)
-				    {
-				      return S_ERROR;
-				    }
+/*
+ * qexec_intprt_fnc_parallel () - interpret a scalar aggregate XASL block by scanning its heap file in parallel
+ *   return: scan code
+ *   xasl(in): XASL Tree pointer
+ *   xasl_state(in): XASL Tree state information
+ *   tplrec(out): Tuple record descriptor to store result tuples
+ *   next_scan_fnc(in): Function to interpret following XASL scan block
+ *
+ * Note: The pages of the heap file are collected from the file table and split in chunks. The chunks are claimed by the
+ *       query thread and by workers of the worker pool. Each worker executes its own clone of the cached XASL; the
+ *       query thread merges their partial aggregates into its own at the end. Workers that did not start by the time
+ *       the query thread runs out of chunks are cancelled, so a busy worker pool only lowers the degree of parallelism.
+ *       Workers share the transaction of the query thread, so they are interrupted with it, but they only read: all
+ *       participants use the snapshot taken here, before the workers start, and logtb_check_tran_owner rejects locks,
+ *       logging and new snapshots requested by a worker. The degree of parallelism is given by parallel_scan_degree and
+ *       may be lowered by the PARALLEL hint. Falls back to qexec_intprt_fnc for small heap files and for queries that
+ *       are not cached.
+ */
+static SCAN_CODE
+qexec_intprt_fnc_parallel (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state,
+			   QFILE_TUPLE_RECORD * tplrec, XASL_SCAN_FNC_PTR next_scan_fnc)
+{
+  PARALLEL_SCAN pscan;
+  PARALLEL_SCAN_WORKER *workers;
+  VPID *pages;
+  QMGR_QUERY_ENTRY *query_p;
+  ACCESS_SPEC_TYPE *specp = xasl->spec_list;
+  SCAN_CODE qp_scan = S_SUCCESS;
+  int degree, n_user_pages, max_pages, n_pages, n_chunks, n_workers, n_claimed, tran_index, i;
 
+  degree = prm_get_integer_value (PRM_ID_PARALLEL_SCAN_DEGREE);
+  if (xasl->parallel_degree > 0)
+    {
+      degree = MIN (degree, xasl->parallel_degree);
+    }
+  degree = MIN (degree, fileio_os_sysconf ());
+  if (degree <= 1 || specp->s_id.type != S_HEAP_SCAN || specp->grouped_scan)
+    {
+      return qexec_intprt_fnc (thread_p, xasl, xasl_state, tplrec, next_scan_fnc);
+    }
 
-				  if ((xasl->instnum_flag & XASL_INSTNUM_FLAG_SCAN_LAST_STOP))
-				    {
-				      if (qexec_end_one_iteration (thread_p, xasl, xasl_state, tplrec) != NO_ERROR)
-					{
-					  return S_ERROR;
-					}
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  query_p = qmgr_get_query_entry (thread_p, xasl_state->query_id, tran_index);
+  if (query_p == NULL || query_p->xasl_ent == NULL)
+    {
+      /* workers need the cache entry to clone the XASL */
+      return qexec_intprt_fnc (thread_p, xasl, xasl_state, tplrec, next_scan_fnc);
+    }
 
-				      return S_SUCCESS;
-				    }
+  if (file_get_num_user_pages (thread_p, &specp->s_id.s.hsid.hfid.vfid, &n_user_pages) != NO_ERROR)
+    {
+      return S_ERROR;
+    }
+  degree = MIN (degree, n_user_pages / PARALLEL_SCAN_MIN_PAGES);
+  if (degree <= 1)
+    {
+      return qexec_intprt_fnc (thread_p, xasl, xasl_state, tplrec, next_scan_fnc);
+    }
 
-				  if ((xasl->instnum_flag & XASL_INSTNUM_FLAG_SCAN_STOP))
-				    {
-				      return S_SUCCESS;
-				    }
-				}
-			      qualified = (xasl->instnum_pred == NULL || ev_res == V_TRUE);
-			      if (qualified
-				  && (qexec_end_one_iteration (thread_p, xasl, xasl_state, tplrec) != NO_ERROR))
-				{
-				  return S_ERROR;
-				}
-			    }
+  /* leave room for pages allocated meanwhile; if the array still fills up, pages may be missing */
+  max_pages = n_user_pages + DISK_SECTOR_NPAGES;
+  pages = (VPID *) db_private_alloc (thread_p, max_pages * sizeof (VPID));
+  if (pages == NULL)
+    {
+      return S_ERROR;
+    }
+  if (file_sample_pages (thread_p, &specp->s_id.s.hsid.hfid.vfid, max_pages, pages, &n_pages) != NO_ERROR)
+    {
+      db_private_free_and_init (thread_p, pages);
+      return S_ERROR;
+    }
+  if (n_pages >= max_pages)
+    {
+      db_private_free_and_init (thread_p, pages);
+      return qexec_intprt_fnc (thread_p, xasl, xasl_state, tplrec, next_scan_fnc);
+    }
 
-			}
-		      else
-			{	/* handle the scan procedure */
-			  /* current scan block has at least one qualified item */
-			  xasl->curr_spec->s_id.qualified_block = true;
+  /* all participants must see the same snapshot; take it before the workers start */
+  if (logtb_get_mvcc_snapshot (thread_p) == NULL)
+    {
+      db_private_free_and_init (thread_p, pages);
+      return S_ERROR;
+    }
 
-			  /* handle the scan procedure */
-			  xasl->scan_ptr->next_scan_on = false;
-			  if (scan_reset_scan_block (thread_p, &xasl->scan_ptr->curr_spec->s_id) == S_ERROR)
-			    {
-			      return S_ERROR;
-			    }
+  n_workers = degree - 1;
+  workers = (PARALLEL_SCAN_WORKER *) db_private_alloc (thread_p, n_workers * sizeof (PARALLEL_SCAN_WORKER));
+  if (workers == NULL)
+    {
+      db_private_free_and_init (thread_p, pages);
+      return S_ERROR;
+    }
 
-			  xasl->next_scan_on = true;
+  if (pthread_mutex_init (&pscan.mutex, NULL) != 0)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CSS_PTHREAD_MUTEX_INIT, 0);
+      db_private_free_and_init (thread_p, workers);
+      db_private_free_and_init (thread_p, pages);
+      return S_ERROR;
+    }
+  if (pthread_cond_init (&pscan.cond, NULL) != 0)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CSS_PTHREAD_COND_INIT, 0);
+      pthread_mutex_destroy (&pscan.mutex);
+      db_private_free_and_init (thread_p, workers);
+      db_private_free_and_init (thread_p, pages);
+      return S_ERROR;
+    }
 
+  pscan.xcache_entry = query_p->xasl_ent;
+  pscan.xasl_state = xasl_state;
+  pscan.fixed_scan = specp->fixed_scan;
+  pscan.pages = pages;
+  pscan.n_pages = n_pages;
+  n_chunks = degree * PARALLEL_SCAN_CHUNKS_PER_PARTICIPANT;
+  pscan.chunk_size = MAX (PARALLEL_SCAN_MIN_PAGES / PARALLEL_SCAN_CHUNKS_PER_PARTICIPANT,
+			  (n_pages + n_chunks - 1) / n_chunks);
+  pscan.next_page = 0;
+  pscan.n_published = 0;
+  pscan.merged = false;
+  pscan.has_error = false;
+  pscan.workers = workers;
+  pscan.n_workers = n_workers;
 
-			  while ((xs_scan = (*next_scan_fnc) (thread_p, xasl->scan_ptr, xasl_state, tplrec,
-							      next_scan_fnc + 1)) == S_SUCCESS)
-			    {
+  {
+    // *INDENT-OFF*
+    using scan_task_group = cubthread::task_group<cubthread::entry>;
 
-			      /* if hierarchical query do special processing */
-			      if (XASL_IS_FLAGED (xasl, XASL_HAS_CONNECT_BY))
-				{
-				  if (qexec_update_connect_by_lists (thread_p, xasl->connect_by_ptr, xasl_state, tplrec)
-				      != NO_ERROR)
-				    {
-				      return S_ERROR;
-				    }
-				}
-			      else
-				{
-				  /* evaluate inst_num predicate */
-				  if (xasl->instnum_val)
-				    {
-				      ev_res = qexec_eval_instnum_pred (thread_p, xasl, xasl_state);
-				      if (ev_res == V_ERROR)
-					{
-					  return S_ERROR;
-					}
+    scan_task_group group ([tran_index] (const scan_task_group::task_func & task)
+      {
+        cubthread::entry_callable_task *callable =
+          new cubthread::entry_callable_task ([tran_index, task] (cubthread::entry & thread_ref)
+            {
+              /* read on behalf of the query transaction; interrupts of the transaction are seen by this thread too */
+              thread_share_tran (&thread_ref, tran_index);
+              pthread_mutex_unlock (&thread_ref.tran_index_lock);
 
-				      if ((xasl->instnum_flag & XASL_INSTNUM_FLAG_SCAN_LAST_STOP))
-					{
-					  if (qexec_end_one_iteration (thread_p, xasl, xasl_state, tplrec) != NO_ERROR)
-					    {
-					      return S_ERROR;
-					    }
+              task (thread_ref);
 
-					  return S_SUCCESS;
-					}
+              thread_end_share_tran (&thread_ref);
+            });
+        css_push_external_task (css_get_current_conn_entry (), callable);
+      });
 
-				      if (xasl->instnum_flag & XASL_INSTNUM_FLAG_SCAN_STOP)
-					{
-					  return S_SUCCESS;
-					}
-				    }
-				  qualified = (xasl->instnum_pred == NULL || ev_res == V_TRUE);
+    for (i = 0; i < n_workers; i++)
+      {
+        workers[i].xasl = NULL;
+        group.hand_over (std::bind (qexec_parallel_scan_execute, std::placeholders::_1, &pscan, i));
+      }
+    // *INDENT-ON*
 
-				  if (qualified
-				      /* one iteration successfully completed */
-				      && qexec_end_one_iteration (thread_p, xasl, xasl_state, tplrec) != NO_ERROR)
-				    {
-				      return S_ERROR;
-				    }
-				}
+    /* the query thread takes its share of chunks too, and all chunks no worker claimed; it never waits for workers
+     * that are still queued in a busy worker pool */
+    qp_scan = qexec_parallel_scan_run (thread_p, &pscan, xasl, xasl_state, tplrec);
 
-			    }
+    if (qp_scan != S_SUCCESS)
+      {
+	pthread_mutex_lock (&pscan.mutex);
+	pscan.next_page = pscan.n_pages;
+	pthread_mutex_unlock (&pscan.mutex);
+      }
 
-			  if (xs_scan != S_END)	/* an error happened */
-			    {
-			      return S_ERROR;
-			    }
-			}
-		    }
-		}
-	    }
+    /* only workers that claimed their task publish partial aggregates */
+    n_claimed = n_workers - (int) group.cancel_queued ();
 
-	  qexec_clear_all_lists (thread_p, xasl);
-	}
+    pthread_mutex_lock (&pscan.mutex);
+    while (pscan.n_published < n_claimed)
+      {
+	pthread_cond_wait (&pscan.cond, &pscan.mutex);
+      }
+    pthread_mutex_unlock (&pscan.mutex);
 
-      if (max_recursive_iterations_reached)
-	{
-	  xb_scan = S_ERROR;
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CTE_MAX_RECURSION_REACHED, 1, xasl->max_iterations);
-	  break;
-	}
+    if (qp_scan == S_SUCCESS && !pscan.has_error)
+      {
+	for (i = 0; i < n_workers; i++)
+	  {
+	    if (workers[i].xasl != NULL && qexec_parallel_scan_merge (thread_p, xasl, workers[i].xasl) != NO_ERROR)
+	      {
+		qp_scan = S_ERROR;
+		break;
+	      }
+	  }
+      }
 
-      if (ls_scan != S_END)	/* an error happened */
-	{
-	  return S_ERROR;
-	}
-    }
+    /* workers free their partial aggregates and finish */
+    pthread_mutex_lock (&pscan.mutex);
+    pscan.merged = true;
+    pthread_cond_broadcast (&pscan.cond);
+    pthread_mutex_unlock (&pscan.mutex);
 
-  if (xb_scan != S_END)		/* an error happened */
+    group.wait_claimed ();
+  }
+
+  if (qp_scan == S_SUCCESS && pscan.has_error)
     {
-      return S_ERROR;
+      (void) er_set_area_error (OR_ALIGNED_BUF_START (pscan.error_area));
+      qp_scan = S_ERROR;
+    }
+  if (qp_scan == S_SUCCESS)
+    {
+      qexec_resolve_domains_for_buildvalue_outptr (xasl);
     }
 
-  return S_SUCCESS;
+  pthread_cond_destroy (&pscan.cond);
+  pthread_mutex_destroy (&pscan.mutex);
+  db_private_free_and_init (thread_p, workers);
+  db_private_free_and_init (thread_p, pages);
 
-#undef CTE_CURRENT_SCAN_READ_TUPLE
-#undef CTE_CURR_ITERATION_LAST_TUPLE
+  return qp_scan;
 }
+#endif /* SERVER_MODE */
 
 /*
  * qexec_merge_fnc () -
@@ -10874,6 +12054,7 @@ qexec_execute_insert (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xa
   int flag;
   TP_DOMAIN *result_domain;
   bool has_user_format;
+  bool use_insert_buffer;
 
   aptr = xasl->aptr_list;
   val_no = insert->num_vals;
@@ -11243,6 +12424,11 @@ qexec_execute_insert (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xa
       scan_cache_op_type = SINGLE_ROW_INSERT;
     }
 
+  /* keys of a multi-row insert may be inserted into indexes in key order, after the rows; not if rows are looked up
+   * in the indexes while the statement inserts them */
+  use_insert_buffer = (scan_cache_op_type == MULTI_ROW_INSERT && pcontext == NULL && !insert->do_replace
+		       && odku_assignments == NULL && xasl->dptr_list == NULL);
+
   if (specp)
     {
       /* we are inserting multiple values ... ie. insert into foo select ... */
@@ -11260,6 +12446,11 @@ qexec_execute_insert (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xa
 	}
       scan_cache_inited = true;
 
+      if (use_insert_buffer && locator_start_insert_buffer (thread_p, &scan_cache, &class_oid) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+
       assert (xasl->scan_op_type == S_SELECT);
 
       /* force_select_lock = false */
@@ -11438,6 +12629,11 @@ qexec_execute_insert (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xa
 	}
       scan_cache_inited = true;
 
+      if (use_insert_buffer && locator_start_insert_buffer (thread_p, &scan_cache, &class_oid) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+
       if (XASL_IS_FLAGED (xasl, XASL_LINK_TO_REGU_VARIABLE) && scan_cache.file_type == FILE_HEAP_REUSE_SLOTS)
 	{
 	  /* do not allow references to reusable oids in sub-inserts. this is a safety check and should have been
@@ -11592,6 +12788,12 @@ qexec_execute_insert (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xa
 	}
     }
 
+  /* insert the buffered index keys */
+  if (scan_cache_inited && locator_flush_insert_buffer (thread_p, &scan_cache) != NO_ERROR)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
+
   /* check uniques */
   /* In this case, consider only single class. Therefore, uniqueness checking is performed based on the local
    * statistical information kept in scan_cache. And then, it is reflected into the transaction's statistical
@@ -13361,8 +14563,37 @@ qexec_end_mainblock_iterations (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_
 	  QFILE_SET_FLAG (ls_flag, QFILE_FLAG_RESULT_FILE);
 	}
 
-      t_list_id =
-	qfile_combine_two_list (thread_p, xasl->proc.union_.left->list_id, xasl->proc.union_.right->list_id, ls_flag);
+      /* a hashed set operation does not sort its result; use it unless an ORDER BY relies on the sorted lists */
+      if ((xasl->orderby_list == NULL || !XASL_IS_FLAGED (xasl, XASL_SKIP_ORDERBY_LIST))
+	  && qfile_can_hash_combine (xasl->proc.union_.left->list_id, xasl->proc.union_.right->list_id, ls_flag))
+	{
+	  HASHSETOP_STATS *stats = NULL;
+	  TSC_TICKS start_tick, end_tick;
+	  TSCTIMEVAL tv_diff;
+
+	  if (thread_is_on_trace (thread_p))
+	    {
+	      stats = &xasl->hashsetop_stats;
+	      tsc_getticks (&start_tick);
+	    }
+
+	  t_list_id =
+	    qfile_hash_combine_two_list (thread_p, xasl->proc.union_.left->list_id, xasl->proc.union_.right->list_id,
+					 ls_flag, stats);
+
+	  if (stats != NULL)
+	    {
+	      tsc_getticks (&end_tick);
+	      tsc_elapsed_time_usec (&tv_diff, end_tick, start_tick);
+	      TSC_ADD_TIMEVAL (stats->hashsetop_time, tv_diff);
+	    }
+	}
+      else
+	{
+	  t_list_id =
+	    qfile_combine_two_list (thread_p, xasl->proc.union_.left->list_id, xasl->proc.union_.right->list_id,
+				    ls_flag);
+	}
       distinct_needed = false;
       if (!t_list_id)
 	{
@@ -14180,6 +15411,12 @@ qexec_execute_mainblock_internal (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XAS
 		  if (level == 0)
 		    {
 		      func_vector[level] = (XSAL_SCAN_FUNC) qexec_intprt_fnc;
+#if defined (SERVER_MODE)
+		      if (qexec_is_parallel_scan_eligible (xasl))
+			{
+			  func_vector[level] = (XSAL_SCAN_FUNC) qexec_intprt_fnc_parallel;
+			}
+#endif /* SERVER_MODE */
 		    }
 		  else
 		    {
@@ -14921,32 +16158,15 @@ tranid_compare (const void *t1, const void *t2)
  *                                   by class OID
  *   return: NO_ERROR, or ER_code
  *   class_oid(in)      :
+ *   mvccid(in) : MVCCID of the transaction which modified the class
+ *
+ * Note: Called when the transaction which modified the class ends. Its MVCCID keeps cached results of the class
+ *       from being shared until all snapshots see the transaction completed.
  */
 int
-qexec_clear_list_cache_by_class (THREAD_ENTRY * thread_p, const OID * class_oid)
+qexec_clear_list_cache_by_class (THREAD_ENTRY * thread_p, const OID * class_oid, MVCCID mvccid)
 {
-#if 0
-  /* TODO: Update this in xasl_cache.c */
-  XASL_CACHE_ENTRY *ent;
-  void *last;
-
-  /* for all entries in the class oid hash table Note that mht_put2() allows mutiple data with the same key, so we have
-   * to use mht_get2() */
-
-  last = NULL;
-  do
-    {
-      /* look up the hash table with the key */
-      ent = (XASL_CACHE_ENTRY *) mht_get2 (xasl_ent_cache.oid_ht, class_oid, &last);
-      if (ent && ent->list_ht_no >= 0)
-	{
-	  (void) qfile_clear_list_cache (thread_p, ent->list_ht_no, false);
-	}
-    }
-  while (ent);
-#endif /* 0 */
-
-  return NO_ERROR;
+  return qfile_clear_list_cache_by_class (thread_p, class_oid, mvccid);
 }
 
 /*
@@ -18503,6 +19723,45 @@ qexec_resolve_domains_for_group_by (BUILDLIST_PROC_NODE * buildlist, OUTPTR_LIST
     }
 }
 
+/*
+ * qexec_resolve_domains_for_buildvalue_outptr () - update domains of output
+ *                                                  values of aggregates
+ *   xasl(in): BUILDVALUE_PROC XASL node
+ */
+static void
+qexec_resolve_domains_for_buildvalue_outptr (XASL_NODE * xasl)
+{
+  AGGREGATE_TYPE *agg_node = NULL;
+  REGU_VARIABLE_LIST out_list_val = NULL;
+
+  assert (xasl->type == BUILDVALUE_PROC);
+
+  for (out_list_val = xasl->outptr_list->valptrp; out_list_val != NULL; out_list_val = out_list_val->next)
+    {
+      assert (out_list_val->value.domain != NULL);
+
+      /* aggregates corresponds to CONSTANT regu vars in outptr_list */
+      if (out_list_val->value.type != TYPE_CONSTANT
+	  || (TP_DOMAIN_TYPE (out_list_val->value.domain) != DB_TYPE_VARIABLE
+	      && TP_DOMAIN_COLLATION_FLAG (out_list_val->value.domain) == TP_DOMAIN_COLL_NORMAL))
+	{
+	  continue;
+	}
+
+      /* search in aggregate list by comparing DB_VALUE pointers */
+      for (agg_node = xasl->proc.buildvalue.agg_list; agg_node != NULL; agg_node = agg_node->next)
+	{
+	  if (out_list_val->value.value.dbvalptr == agg_node->accumulator.value
+	      && TP_DOMAIN_TYPE (agg_node->domain) != DB_TYPE_NULL)
+	    {
+	      assert (agg_node->domain != NULL);
+	      assert (TP_DOMAIN_COLLATION_FLAG (agg_node->domain) == TP_DOMAIN_COLL_NORMAL);
+	      out_list_val->value.domain = agg_node->domain;
+	    }
+	}
+    }
+}
+
 /*
  * qexec_resolve_domains_for_aggregation () - update domains of aggregate
  *                                            functions and accumulators
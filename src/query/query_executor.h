@@ -90,7 +90,7 @@ extern qfile_list_id *qexec_get_xasl_list_id (xasl_node * xasl);
 extern void get_xasl_dumper_linked_in ();
 #endif
 
-extern int qexec_clear_list_cache_by_class (THREAD_ENTRY * thread_p, const OID * class_oid);
+extern int qexec_clear_list_cache_by_class (THREAD_ENTRY * thread_p, const OID * class_oid, MVCCID mvccid);
 
 #if defined(CUBRID_DEBUG)
 extern bool qdump_check_xasl_tree (xasl_node * xasl);
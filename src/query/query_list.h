@@ -333,12 +333,20 @@ typedef enum
   QPROC_NO_SINGLE_OUTER		/* 1 NULL row or n qualified rows */
 } QPROC_SINGLE_FETCH;
 
+/* how the list files of a MERGELIST_PROC are joined */
+typedef enum
+{
+  QFILE_MERGE_JOIN = 0,		/* both lists sorted on the join columns, merged */
+  QFILE_HASH_JOIN		/* inner list hashed, outer list probes it; no order needed */
+} QFILE_JOIN_METHOD;
+
 /* List File Merge Information */
 typedef struct qfile_list_merge_info QFILE_LIST_MERGE_INFO;
 struct qfile_list_merge_info
 {
   JOIN_TYPE join_type;		/* inner, left, right or outer */
   QPROC_SINGLE_FETCH single_fetch;	/* merge in single fetch mode */
+  QFILE_JOIN_METHOD join_method;	/* merge or hash join */
   int ls_column_cnt;		/* join columns count */
   int ls_pos_cnt;		/* tuple value fetch count */
   int *ls_outer_column;		/* outer list join columns number */
@@ -507,6 +515,7 @@ struct qfile_list_scan_id
   int curr_tplno;		/* current tuple number */
   QFILE_TUPLE_RECORD tplrec;	/* used for overflow tuple peeking */
   QFILE_LIST_ID list_id;	/* list file identifier */
+  VPID read_ahead_vpid;		/* read-ahead cursor (see pgbuf_read_ahead) */
 };
 
 /* list file flag; denoting type and/or operation of the list file */
@@ -152,7 +152,9 @@ static QMGR_QUERY_ENTRY *qmgr_find_query_entry (QMGR_QUERY_ENTRY * query_list_p,
 static void qmgr_delete_query_entry (THREAD_ENTRY * thread_p, QUERY_ID query_id, int trans_ind);
 static void qmgr_free_tran_entries (THREAD_ENTRY * thread_p);
 
-static void qmgr_clear_relative_cache_entries (THREAD_ENTRY * thread_p, QMGR_TRAN_ENTRY * tran_entry_p);
+static void qmgr_clear_relative_cache_entries (THREAD_ENTRY * thread_p, int tran_index, QMGR_TRAN_ENTRY * tran_entry_p);
+static bool qmgr_is_related_class_modified (QMGR_TRAN_ENTRY * tran_entry_p, XASL_CACHE_ENTRY * xasl_cache_entry_p);
+static bool qmgr_is_array_execution_stopped (THREAD_ENTRY * thread_p, int error_code);
 static OID_BLOCK_LIST *qmgr_allocate_oid_block (THREAD_ENTRY * thread_p);
 static void qmgr_free_oid_block (THREAD_ENTRY * thread_p, OID_BLOCK_LIST * oid_block);
 static int qmgr_init_external_file_page (THREAD_ENTRY * thread_p, PAGE_PTR page, void *args);
@@ -1242,6 +1244,7 @@ xqmgr_execute_query (THREAD_ENTRY * thread_p, const XASL_ID * xasl_id_p, QUERY_I
   bool saved_is_stats_on;
   bool xasl_trace;
   bool is_xasl_pinned_reference;
+  bool is_related_class_modified;
 
   cached_result = false;
   query_p = NULL;
@@ -1360,7 +1363,11 @@ xqmgr_execute_query (THREAD_ENTRY * thread_p, const XASL_ID * xasl_id_p, QUERY_I
       goto exit_on_error;
     }
 
-  if (qmgr_can_get_result_from_cache (*flag_p))
+  /* the transaction does not see the same results as the others for the classes that it has modified */
+  is_related_class_modified =
+    qmgr_is_related_class_modified (&qmgr_Query_table.tran_entries_p[tran_index], xasl_cache_entry_p);
+
+  if (!is_related_class_modified && qmgr_can_get_result_from_cache (*flag_p))
     {
       /* lookup the list cache with the parameter values (DB_VALUE array) */
       list_cache_entry_p = qfile_lookup_list_cache_entry (thread_p, xasl_cache_entry_p->list_ht_no, &params);
@@ -1479,7 +1486,7 @@ xqmgr_execute_query (THREAD_ENTRY * thread_p, const XASL_ID * xasl_id_p, QUERY_I
   /* If it is allowed to cache the query result or if it is required to cache, put the list file id(QFILE_LIST_ID) into
    * the list cache. Provided are the corresponding XASL cache entry to be linked, and the parameters (host variables -
    * DB_VALUES). */
-  if (qmgr_is_allowed_result_cache (*flag_p))
+  if (!is_related_class_modified && qmgr_is_allowed_result_cache (*flag_p))
     {
       /* check once more to ensure that the related XASL entry is still valid */
       if (xcache_can_entry_cache_list (xasl_cache_entry_p))
@@ -1515,7 +1522,8 @@ xqmgr_execute_query (THREAD_ENTRY * thread_p, const XASL_ID * xasl_id_p, QUERY_I
 	   * is, or make new one */
 	  list_cache_entry_p =
 	    qfile_update_list_cache_entry (thread_p, &xasl_cache_entry_p->list_ht_no, &params, list_id_p,
-					   xasl_cache_entry_p->sql_info.sql_hash_text);
+					   xasl_cache_entry_p->sql_info.sql_hash_text, xasl_cache_entry_p->related_objects,
+					   xasl_cache_entry_p->n_related_objects);
 	  if (list_cache_entry_p == NULL)
 	    {
 	      char *s;
@@ -1619,6 +1627,106 @@ exit_on_error:
   goto end;
 }
 
+/*
+ * xqmgr_execute_query_array () - execute a prepared query once for each row of parameter values
+ *   return: number of rows executed
+ *   thread_p(in):
+ *   xasl_id_p(in): XASL file id of the prepared query
+ *   n_rows(in): number of rows
+ *   dbval_count(in): number of parameter values of each row
+ *   row_data(in): parameter values of each row; packed in server mode, DB_VALUE array in stand-alone mode
+ *   flag(in): query execution flag
+ *   query_timeout(in):
+ *   row_results(out): per row, number of affected objects or error code
+ *   row_messages(out): per row, error message allocated with malloc, or NULL
+ *
+ * Note: Rows are executed in order, each as a separate statement: an error undoes the statement of its row and the
+ *       execution goes on with the next row. It stops at an error that aborts or interrupts the transaction, or that
+ *       requires the query to be recompiled; the error is left set and the row is not counted as executed.
+ *       The result of each row is freed when its query ends, so the query should not return rows to be fetched.
+ */
+int
+xqmgr_execute_query_array (THREAD_ENTRY * thread_p, const XASL_ID * xasl_id_p, int n_rows, int dbval_count,
+			   void **row_data, QUERY_FLAG flag, int query_timeout, int *row_results, char **row_messages)
+{
+  QFILE_LIST_ID *list_id_p;
+  QUERY_ID query_id;
+  QUERY_FLAG row_flag;
+  CACHE_TIME client_cache_time, server_cache_time;
+  int row, error_code;
+
+  assert (!IS_QUERY_EXECUTE_WITH_COMMIT (flag));
+
+  for (row = 0; row < n_rows; row++)
+    {
+      if (row > 0)
+	{
+	  /* each row is a new statement */
+	  (void) logtb_invalidate_snapshot_data (thread_p);
+	}
+
+      row_flag = flag;
+      query_id = NULL_QUERY_ID;
+      CACHE_TIME_RESET (&client_cache_time);
+      CACHE_TIME_RESET (&server_cache_time);
+
+      list_id_p = xqmgr_execute_query (thread_p, xasl_id_p, &query_id, dbval_count, row_data[row], &row_flag,
+				       &client_cache_time, &server_cache_time, query_timeout, NULL);
+      if (list_id_p != NULL)
+	{
+	  row_results[row] = list_id_p->tuple_cnt;
+	  row_messages[row] = NULL;
+	  QFILE_FREE_AND_INIT_LIST_ID (list_id_p);
+
+	  if (query_id > 0)
+	    {
+	      (void) xqmgr_end_query (thread_p, query_id);
+	    }
+	  continue;
+	}
+
+      ASSERT_ERROR_AND_SET (error_code);
+      if (qmgr_is_array_execution_stopped (thread_p, error_code))
+	{
+	  return row;
+	}
+
+      row_results[row] = error_code;
+      row_messages[row] = strdup (er_msg ());
+      er_clear ();
+    }
+
+  return n_rows;
+}
+
+/*
+ * qmgr_is_array_execution_stopped () - can the execution of a query array go on after the error of a row?
+ *   return: true to stop the execution
+ *   thread_p(in):
+ *   error_code(in): error of row
+ */
+static bool
+qmgr_is_array_execution_stopped (THREAD_ENTRY * thread_p, int error_code)
+{
+  LOG_TDES *tdes;
+
+  switch (error_code)
+    {
+    case ER_LK_UNILATERALLY_ABORTED:
+    case ER_DB_NO_MODIFICATIONS:
+    case ER_INTERRUPTED:
+    case ER_QPROC_XASLNODE_RECOMPILE_REQUESTED:
+    case ER_QPROC_INVALID_XASLNODE:
+      return true;
+    default:
+      break;
+    }
+
+  /* the transaction was aborted by another error */
+  tdes = LOG_FIND_CURRENT_TDES (thread_p);
+  return tdes != NULL && tdes->tran_abort_reason != TRAN_NORMAL;
+}
+
 /*
  * copy_bind_value_to_tdes - copy bind values to transaction descriptor
  * return:
@@ -1975,6 +2083,16 @@ xqmgr_drop_all_query_plans (THREAD_ENTRY * thread_p)
   return NO_ERROR;
 }
 
+/*
+ * xqmgr_save_all_query_plans () - Save the stored query plans, to load them back after restart
+ *   return: NO_ERROR or error code
+ */
+int
+xqmgr_save_all_query_plans (THREAD_ENTRY * thread_p)
+{
+  return xcache_save (thread_p);
+}
+
 /*
  * xqmgr_dump_query_plans () - Dump the content of the XASL cache
  *   return:
@@ -2003,17 +2121,26 @@ xqmgr_dump_query_cache (THREAD_ENTRY * thread_p, FILE * out_fp)
  */
 
 static void
-qmgr_clear_relative_cache_entries (THREAD_ENTRY * thread_p, QMGR_TRAN_ENTRY * tran_entry_p)
+qmgr_clear_relative_cache_entries (THREAD_ENTRY * thread_p, int tran_index, QMGR_TRAN_ENTRY * tran_entry_p)
 {
   OID_BLOCK_LIST *oid_block_p;
   OID *class_oid_p;
+  LOG_TDES *tdes;
+  MVCCID mvccid = MVCCID_NULL;
   int i;
 
+  /* the highest MVCCID of the transaction; sub-transaction ids are assigned after the transaction id */
+  tdes = LOG_FIND_TDES (tran_index);
+  if (tdes != NULL)
+    {
+      mvccid = tdes->mvccinfo.sub_ids.empty ()? tdes->mvccinfo.id : tdes->mvccinfo.sub_ids.back ();
+    }
+
   for (oid_block_p = tran_entry_p->modified_classes_p; oid_block_p; oid_block_p = oid_block_p->next)
     {
       for (i = 0, class_oid_p = oid_block_p->oid_array; i < oid_block_p->last_oid_idx; i++, class_oid_p++)
 	{
-	  if (qexec_clear_list_cache_by_class (thread_p, class_oid_p) != NO_ERROR)
+	  if (qexec_clear_list_cache_by_class (thread_p, class_oid_p, mvccid) != NO_ERROR)
 	    {
 	      er_log_debug (ARG_FILE_LINE,
 			    "qm_clear_trans_wakeup: qexec_clear_list_cache_by_class failed for class { %d %d %d }\n",
@@ -2023,6 +2150,36 @@ qmgr_clear_relative_cache_entries (THREAD_ENTRY * thread_p, QMGR_TRAN_ENTRY * tr
     }
 }
 
+/*
+ * qmgr_is_related_class_modified () - Has the transaction modified a class that the query refers to?
+ *   return: true if it has
+ *   tran_entry_p(in)   : transaction entry
+ *   xasl_cache_entry_p(in)     : XASL cache entry of the query
+ */
+static bool
+qmgr_is_related_class_modified (QMGR_TRAN_ENTRY * tran_entry_p, XASL_CACHE_ENTRY * xasl_cache_entry_p)
+{
+  OID_BLOCK_LIST *oid_block_p;
+  OID *class_oid_p;
+  int i, j;
+
+  for (oid_block_p = tran_entry_p->modified_classes_p; oid_block_p; oid_block_p = oid_block_p->next)
+    {
+      for (i = 0, class_oid_p = oid_block_p->oid_array; i < oid_block_p->last_oid_idx; i++, class_oid_p++)
+	{
+	  for (j = 0; j < xasl_cache_entry_p->n_related_objects; j++)
+	    {
+	      if (OID_EQ (class_oid_p, &xasl_cache_entry_p->related_objects[j].oid))
+		{
+		  return true;
+		}
+	    }
+	}
+    }
+
+  return false;
+}
+
 /*
  * qmgr_clear_trans_wakeup () -
  *   return:
@@ -2069,13 +2226,10 @@ qmgr_clear_trans_wakeup (THREAD_ENTRY * thread_p, int tran_index, bool is_tran_d
       qfile_clear_uncommited_list_cache_entry (thread_p, tran_index);
     }
 
-  /* if the transaction is aborting, clear relative cache entries */
+  /* clear cache entries relative to the classes that the transaction has modified */
   if (tran_entry_p->modified_classes_p)
     {
-      if (is_abort)
-	{
-	  qmgr_clear_relative_cache_entries (thread_p, tran_entry_p);
-	}
+      qmgr_clear_relative_cache_entries (thread_p, tran_index, tran_entry_p);
 
       qmgr_free_oid_block (thread_p, tran_entry_p->modified_classes_p);
       tran_entry_p->modified_classes_p = NULL;
@@ -2592,6 +2746,12 @@ qmgr_create_new_temp_file (THREAD_ENTRY * thread_p, QUERY_ID query_id, QMGR_TEMP
       return NULL;
     }
 
+  /* temporary files belong to the transaction; parallel workers must not create them */
+  if (logtb_check_tran_owner (thread_p) != NO_ERROR)
+    {
+      return NULL;
+    }
+
   num_buffer_pages = ((membuf_type == TEMP_FILE_MEMBUF_NORMAL)
 		      ? prm_get_integer_value (PRM_ID_TEMP_MEM_BUFFER_PAGES)
 		      : prm_get_integer_value (PRM_ID_INDEX_SCAN_KEY_BUFFER_PAGES));
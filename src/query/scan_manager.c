@@ -170,6 +170,11 @@ static int scan_init_index_key_limit (THREAD_ENTRY * thread_p, INDX_SCAN_ID * is
 				      VAL_DESCR * vd);
 static SCAN_CODE scan_next_scan_local (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
 static SCAN_CODE scan_next_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
+static int scan_start_heap_batch (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
+static void scan_end_heap_batch (THREAD_ENTRY * thread_p, HEAP_SCAN_ID * hsidp);
+static void scan_reset_heap_batch (HEAP_SCAN_BATCH * batch, const OID * oid);
+static SCAN_CODE scan_fill_heap_batch (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
+static SCAN_CODE scan_next_heap_batch (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, RECDES * recdes);
 static SCAN_CODE scan_next_heap_page_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
 static SCAN_CODE scan_next_class_attr_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
 static SCAN_CODE scan_next_index_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
@@ -2831,6 +2836,15 @@ scan_open_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
   hsidp->cache_recordinfo = cache_recordinfo;
   hsidp->recordinfo_regu_list = regu_list_recordinfo;
 
+  hsidp->page_set = NULL;
+  hsidp->n_page_set = 0;
+
+  if (hsidp->batch != NULL)
+    {
+      scan_end_heap_batch (thread_p, hsidp);
+    }
+  hsidp->batch_inited = false;
+
   return NO_ERROR;
 }
 
@@ -3898,6 +3912,22 @@ scan_open_method_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
   return method_open_scan (thread_p, &scan_id->s.vaid.scan_buf, list_id, meth_sig_list);
 }
 
+/*
+ * scan_set_heap_page_set () - Restrict an opened sequential heap scan to the given pages.
+ *   return: void
+ *   scan_id(in/out): Scan identifier
+ *   page_set(in): Sorted heap pages to scan; must outlive the scan
+ *   n_page_set(in): Number of pages
+ */
+void
+scan_set_heap_page_set (SCAN_ID * scan_id, const VPID * page_set, int n_page_set)
+{
+  assert (scan_id->type == S_HEAP_SCAN && !scan_id->grouped);
+
+  scan_id->s.hsid.page_set = page_set;
+  scan_id->s.hsid.n_page_set = n_page_set;
+}
+
 /*
  * scan_start_scan () - Start the scan process on the given scan identifier.
  *   return: NO_ERROR, or ER_code
@@ -3955,6 +3985,10 @@ scan_start_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 	      goto exit_on_error;
 	    }
 	  hsidp->scancache_inited = true;
+	  if (hsidp->page_set != NULL)
+	    {
+	      heap_scancache_set_page_set (&hsidp->scan_cache, hsidp->page_set, hsidp->n_page_set);
+	    }
 	}
       if (hsidp->caches_inited != true)
 	{
@@ -3985,6 +4019,14 @@ scan_start_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 	    }
 	  hsidp->caches_inited = true;
 	}
+      if (!hsidp->batch_inited)
+	{
+	  ret = scan_start_heap_batch (thread_p, scan_id);
+	  if (ret != NO_ERROR)
+	    {
+	      goto exit_on_error;
+	    }
+	}
       break;
 
     case S_HEAP_PAGE_SCAN:
@@ -4625,6 +4667,12 @@ scan_close_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
     {
     case S_HEAP_SCAN:
     case S_HEAP_SCAN_RECORD_INFO:
+      if (scan_id->s.hsid.batch != NULL)
+	{
+	  scan_end_heap_batch (thread_p, &scan_id->s.hsid);
+	}
+      break;
+
     case S_HEAP_PAGE_SCAN:
     case S_CLASS_ATTR_SCAN:
     case S_VALUES_SCAN:
@@ -4957,6 +5005,240 @@ typedef enum
   OBJ_REPEAT_GET_WITH_LOCK = 1,
   OBJ_GET_WITH_LOCK_COMPLETE = 2
 } OBJECT_GET_STATUS;
+/*
+ * scan_start_heap_batch () - set up batch-at-a-time evaluation of the data filter of a heap scan
+ *   return: error code
+ *   scan_id(in/out): heap scan identifier, with attribute caches started
+ *
+ * Note: Batches are used only by forward, not grouped scans that return the qualified records without locking them.
+ *       The batch filter only rejects records that cannot satisfy the data filter; the selected records are
+ *       evaluated as usual.
+ */
+static int
+scan_start_heap_batch (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
+{
+  HEAP_SCAN_ID *hsidp = &scan_id->s.hsid;
+  HEAP_SCAN_BATCH *batch;
+  BATCH_FILTER *filter = NULL;
+  int error;
+
+  hsidp->batch_inited = true;
+
+  if (!prm_get_bool_value (PRM_ID_VECTORIZED_SCAN) || scan_id->type != S_HEAP_SCAN || scan_id->grouped
+      || scan_id->mvcc_select_lock_needed || hsidp->scan_pred.pred_expr == NULL || OID_IS_ROOTOID (&hsidp->cls_oid)
+      || mvcc_is_mvcc_disabled_class (&hsidp->cls_oid))
+    {
+      return NO_ERROR;
+    }
+
+  error =
+    batch_filter_compile (thread_p, hsidp->scan_pred.pred_expr, hsidp->pred_attrs.attr_cache, scan_id->vd, &filter);
+  if (error != NO_ERROR || filter == NULL)
+    {
+      return error;
+    }
+
+  batch = (HEAP_SCAN_BATCH *) db_private_alloc (thread_p, sizeof (HEAP_SCAN_BATCH));
+  if (batch == NULL)
+    {
+      batch_filter_destroy (filter);
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (HEAP_SCAN_BATCH));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  batch->filter = filter;
+  batch->area_size = IO_PAGESIZE;
+  batch->area = (char *) db_private_alloc (thread_p, batch->area_size);
+  if (batch->area == NULL)
+    {
+      batch_filter_destroy (filter);
+      db_private_free_and_init (thread_p, batch);
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) IO_PAGESIZE);
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+  scan_reset_heap_batch (batch, &hsidp->curr_oid);
+
+  hsidp->batch = batch;
+  return NO_ERROR;
+}
+
+/*
+ * scan_end_heap_batch () - free the batch of a heap scan
+ *   return:
+ *   hsidp(in/out): heap scan identifier
+ */
+static void
+scan_end_heap_batch (THREAD_ENTRY * thread_p, HEAP_SCAN_ID * hsidp)
+{
+  HEAP_SCAN_BATCH *batch = hsidp->batch;
+
+  batch_filter_destroy (batch->filter);
+  db_private_free_and_init (thread_p, batch->area);
+  db_private_free_and_init (thread_p, hsidp->batch);
+}
+
+/*
+ * scan_reset_heap_batch () - drop the records read ahead and continue reading after the given object
+ *   return:
+ *   batch(in/out): heap scan batch
+ *   oid(in): current object of the scan, NULL OID to restart from the beginning
+ */
+static void
+scan_reset_heap_batch (HEAP_SCAN_BATCH * batch, const OID * oid)
+{
+  batch->n_records = 0;
+  batch->next = 0;
+  batch->has_carry = false;
+  batch->end_reached = false;
+  COPY_OID (&batch->fill_oid, oid);
+  COPY_OID (&batch->last_oid, oid);
+}
+
+/*
+ * scan_fill_heap_batch () - read the next visible records of the current heap page and evaluate the batch filter
+ *   return: S_SUCCESS, S_ERROR
+ *   scan_id(in/out): heap scan identifier
+ *
+ * Note: A batch ends with the page, or earlier if the records do not fit the batch. The first record of the next page
+ *       is read to find the end of the page; it is kept as the first record of the next batch.
+ */
+static SCAN_CODE
+scan_fill_heap_batch (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
+{
+  HEAP_SCAN_ID *hsidp = &scan_id->s.hsid;
+  HEAP_SCAN_BATCH *batch = hsidp->batch;
+  RECDES recdes;
+  SCAN_CODE sp_scan;
+  char *new_area;
+  int new_size;
+  int offset = 0;
+  int n;
+
+  if (batch->has_carry)
+    {
+      n = batch->n_records;
+      memmove (batch->area, batch->recdes[n].data, batch->recdes[n].length);
+      batch->recdes[0] = batch->recdes[n];
+      batch->recdes[0].data = batch->area;
+      COPY_OID (&batch->oids[0], &batch->oids[n]);
+      offset = batch->recdes[0].length;
+      batch->n_records = 1;
+      batch->has_carry = false;
+    }
+  else
+    {
+      batch->n_records = 0;
+    }
+  batch->next = 0;
+
+  while (batch->n_records < BATCH_FILTER_CAPACITY)
+    {
+      n = batch->n_records;
+      offset = DB_ALIGN (offset, MAX_ALIGNMENT);
+      recdes.data = batch->area + offset;
+      recdes.area_size = batch->area_size - offset;
+
+      sp_scan =
+	heap_next (thread_p, &hsidp->hfid, &hsidp->cls_oid, &batch->fill_oid, &recdes, &hsidp->scan_cache, COPY);
+      if (sp_scan == S_DOESNT_FIT)
+	{
+	  if (n > 0)
+	    {
+	      /* the record is read again by the next batch */
+	      break;
+	    }
+
+	  /* a record larger than the area */
+	  new_size = DB_ALIGN (-recdes.length, IO_PAGESIZE);
+	  new_area = (char *) db_private_realloc (thread_p, batch->area, new_size);
+	  if (new_area == NULL)
+	    {
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) new_size);
+	      return S_ERROR;
+	    }
+	  batch->area = new_area;
+	  batch->area_size = new_size;
+	  continue;
+	}
+      else if (sp_scan == S_END)
+	{
+	  batch->end_reached = true;
+	  break;
+	}
+      else if (sp_scan != S_SUCCESS)
+	{
+	  return S_ERROR;
+	}
+
+      batch->recdes[n] = recdes;
+      COPY_OID (&batch->oids[n], &batch->fill_oid);
+      offset += recdes.length;
+
+      if (n > 0 && (batch->oids[n].pageid != batch->oids[0].pageid || batch->oids[n].volid != batch->oids[0].volid))
+	{
+	  /* first record of the next page */
+	  batch->has_carry = true;
+	  break;
+	}
+      batch->n_records++;
+    }
+
+  batch_filter_decode (batch->filter, batch->recdes, batch->n_records);
+  (void) batch_filter_evaluate (batch->filter, batch->n_records, batch->sel);
+
+  return S_SUCCESS;
+}
+
+/*
+ * scan_next_heap_batch () - get the next record of a heap scan selected by the batch filter
+ *   return: S_SUCCESS, S_END, S_ERROR
+ *   scan_id(in/out): heap scan identifier
+ *   recdes(out): copy of the record, valid until the next call
+ */
+static SCAN_CODE
+scan_next_heap_batch (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, RECDES * recdes)
+{
+  HEAP_SCAN_ID *hsidp = &scan_id->s.hsid;
+  HEAP_SCAN_BATCH *batch = hsidp->batch;
+  int i;
+
+  if (!OID_EQ (&hsidp->curr_oid, &batch->last_oid))
+    {
+      /* the scan was restarted */
+      scan_reset_heap_batch (batch, &hsidp->curr_oid);
+    }
+
+  while (true)
+    {
+      while (batch->next < batch->n_records)
+	{
+	  i = batch->next++;
+	  if (batch->sel[i])
+	    {
+	      COPY_OID (&hsidp->curr_oid, &batch->oids[i]);
+	      COPY_OID (&batch->last_oid, &batch->oids[i]);
+	      *recdes = batch->recdes[i];
+	      return S_SUCCESS;
+	    }
+
+	  /* rejected by the batch filter */
+	  scan_id->scan_stats.read_rows++;
+	}
+
+      if (batch->end_reached)
+	{
+	  OID_SET_NULL (&hsidp->curr_oid);
+	  scan_reset_heap_batch (batch, &hsidp->curr_oid);
+	  return S_END;
+	}
+
+      if (scan_fill_heap_batch (thread_p, scan_id) != S_SUCCESS)
+	{
+	  return S_ERROR;
+	}
+    }
+}
+
 /*
  * scan_next_heap_scan () - The scan is moved to the next heap scan item.
  *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
@@ -4981,6 +5263,7 @@ scan_next_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
   bool is_peeking;
   OBJECT_GET_STATUS object_get_status;
   regu_variable_list_node *p;
+  bool use_batch;
 
   hsidp = &scan_id->s.hsid;
   if (scan_id->mvcc_select_lock_needed)
@@ -5002,6 +5285,14 @@ scan_next_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
       is_peeking = PEEK;
     }
 
+  /* records are prefiltered a page at a time and copied; other qualifications need the records rejected too */
+  use_batch = (hsidp->batch != NULL && !scan_id->grouped && scan_id->direction == S_FORWARD
+	       && scan_id->qualification == QPROC_QUALIFIED);
+  if (use_batch)
+    {
+      is_peeking = COPY;
+    }
+
   if (data_filter.val_list)
     {
       for (p = data_filter.scan_pred->regu_list; p; p = p->next)
@@ -5032,7 +5323,11 @@ scan_next_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 	  if (scan_id->direction == S_FORWARD)
 	    {
 	      /* move forward */
-	      if (scan_id->type == S_HEAP_SCAN)
+	      if (use_batch)
+		{
+		  sp_scan = scan_next_heap_batch (thread_p, scan_id, &recdes);
+		}
+	      else if (scan_id->type == S_HEAP_SCAN)
 		{
 		  sp_scan =
 		    heap_next (thread_p, &hsidp->hfid, &hsidp->cls_oid, &hsidp->curr_oid, &recdes, &hsidp->scan_cache,
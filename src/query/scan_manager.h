@@ -36,6 +36,7 @@
 #include "jansson.h"
 #endif
 
+#include "batch_filter.h"
 #include "btree.h"		/* TODO: for BTREE_SCAN */
 #include "heap_file.h"		/* for HEAP_SCANCACHE */
 #include "method_scan.h"	/* for METHOD_SCAN_BUFFER */
@@ -90,6 +91,24 @@ typedef enum
   S_INDX_NODE_INFO_SCAN		/* scans b-tree nodes for info */
 } SCAN_TYPE;
 
+/* records of a heap page read ahead and prefiltered by a batch filter */
+typedef struct heap_scan_batch HEAP_SCAN_BATCH;
+struct heap_scan_batch
+{
+  BATCH_FILTER *filter;		/* simple terms of the data filter */
+  char *area;			/* copies of the records */
+  int area_size;		/* size of area */
+  RECDES recdes[BATCH_FILTER_CAPACITY];	/* records of the batch */
+  OID oids[BATCH_FILTER_CAPACITY];	/* object identifiers of the records */
+  unsigned char sel[BATCH_FILTER_CAPACITY];	/* records selected by the batch filter */
+  int n_records;		/* number of records in the batch */
+  int next;			/* index of the next record to return */
+  OID fill_oid;			/* last object read from the heap file */
+  OID last_oid;			/* last object returned by the scan */
+  bool has_carry;		/* record n_records is on the next page and starts the next batch */
+  bool end_reached;		/* no more records in the heap file */
+};
+
 typedef struct heap_scan_id HEAP_SCAN_ID;
 struct heap_scan_id
 {
@@ -108,7 +127,13 @@ struct heap_scan_id
   DB_VALUE **cache_recordinfo;	/* cache for record information */
   regu_variable_list_node *recordinfo_regu_list;	/* regulator variable list for record info */
 
+  const VPID *page_set;		/* pages to scan when the heap is scanned in parallel; NULL for all pages */
+  int n_page_set;		/* number of pages in page_set */
+
   RECDES row_recdes;		/* record descriptor of current row */
+
+  HEAP_SCAN_BATCH *batch;	/* batch-at-a-time data filter; NULL when records are evaluated one by one */
+  bool batch_inited;		/* was batch evaluation considered for the scan? */
 };				/* Regular Heap File Scan Identifier */
 
 typedef struct heap_page_scan_id HEAP_PAGE_SCAN_ID;
@@ -458,6 +483,7 @@ extern int scan_open_method_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
 				  val_list_node * val_list, val_descr * vd,
 				  /* */
 				  QFILE_LIST_ID * list_id, method_sig_list * meth_sig_list);
+extern void scan_set_heap_page_set (SCAN_ID * s_id, const VPID * page_set, int n_page_set);
 extern int scan_start_scan (THREAD_ENTRY * thread_p, SCAN_ID * s_id);
 extern SCAN_CODE scan_reset_scan_block (THREAD_ENTRY * thread_p, SCAN_ID * s_id);
 extern SCAN_CODE scan_next_scan_block (THREAD_ENTRY * thread_p, SCAN_ID * s_id);
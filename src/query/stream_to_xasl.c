@@ -2188,6 +2188,7 @@ stx_build_xasl_node (THREAD_ENTRY * thread_p, char *ptr, XASL_NODE * xasl)
 
   ptr = or_unpack_int (ptr, &tmp);
   xasl->iscan_oid_order = (bool) tmp;
+  ptr = or_unpack_int (ptr, &xasl->parallel_degree);
 
   xasl->query_alias = stx_restore_string (thread_p, ptr);
   assert (xasl->query_alias != NULL);
@@ -3063,6 +3064,9 @@ stx_build_ls_merge_info (THREAD_ENTRY * thread_p, char *ptr, QFILE_LIST_MERGE_IN
   ptr = or_unpack_int (ptr, &single_fetch);
   list_merge_info->single_fetch = (QPROC_SINGLE_FETCH) single_fetch;
 
+  ptr = or_unpack_int (ptr, &tmp);
+  list_merge_info->join_method = (QFILE_JOIN_METHOD) tmp;
+
   ptr = or_unpack_int (ptr, &list_merge_info->ls_column_cnt);
 
   ptr = or_unpack_int (ptr, &offset);
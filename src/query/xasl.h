@@ -150,6 +150,8 @@ using PRED_EXPR = cubxasl::pred_expr;
 #if defined (SERVER_MODE) || defined (SA_MODE)
 typedef struct groupby_stat GROUPBY_STATS;
 typedef struct orderby_stat ORDERBY_STATS;
+typedef struct hashjoin_stat HASHJOIN_STATS;
+typedef struct hashsetop_stat HASHSETOP_STATS;
 typedef struct xasl_stat XASL_STATS;
 
 typedef struct topn_tuple TOPN_TUPLE;
@@ -882,6 +884,25 @@ struct groupby_stat
   bool groupby_sort;
 };
 
+struct hashjoin_stat
+{
+  struct timeval hashjoin_time;
+  UINT64 build_rows;		/* inner tuples put into the hash tables */
+  UINT64 probe_rows;		/* outer tuples looked up in the hash tables */
+  int partitions;		/* 0 if the inner list fit in memory */
+  bool run_hashjoin;
+};
+
+struct hashsetop_stat
+{
+  struct timeval hashsetop_time;
+  UINT64 build_rows;		/* tuples put into the hash tables */
+  UINT64 probe_rows;		/* tuples looked up in the hash tables */
+  UINT64 mem_size;		/* peak size of a hash table, in bytes */
+  int partitions;		/* 0 if the operands fit in memory */
+  bool run_hashsetop;
+};
+
 struct xasl_stat
 {
   struct timeval elapsed_time;
@@ -1034,12 +1055,15 @@ struct xasl_node
   const char *query_alias;
   int dbval_cnt;		/* number of host variables in this XASL */
   bool iscan_oid_order;
+  int parallel_degree;		/* max degree of parallel scan given by hint, 0 if none */
 
   int max_iterations;		/* Number of maximum iterations (used during run-time for recursive CTE) */
 
 #if defined (SERVER_MODE) || defined (SA_MODE)
   ORDERBY_STATS orderby_stats;
   GROUPBY_STATS groupby_stats;
+  HASHJOIN_STATS hashjoin_stats;
+  HASHSETOP_STATS hashsetop_stats;
   XASL_STATS xasl_stats;
 
   TOPN_TUPLES *topn_items;	/* top-n tuples for orderby limit */
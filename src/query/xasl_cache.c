@@ -29,15 +29,23 @@
 #include "compile_context.h"
 #include "config.h"
 #include "system_parameter.h"
+#include "file_io.h"
+#include "heap_file.h"
 #include "list_file.h"
+#include "log_impl.h"
 #include "perf_monitor.h"
 #include "query_executor.h"
 #include "query_manager.h"
+#include "release_string.h"
 #include "statistics_sr.h"
 #include "stream_to_xasl.h"
 #include "thread_entry.hpp"
 #include "thread_manager.hpp"
 #include "xasl_unpack_info.hpp"
+#if defined (SERVER_MODE)
+#include "internal_tasks_worker_pool.hpp"
+#include "thread_entry_task.hpp"
+#endif /* SERVER_MODE */
 
 #include <assert.h>
 
@@ -106,6 +114,8 @@ struct xcache
   INT32 cleanup_flag;
   BINARY_HEAP *cleanup_bh;
   XCACHE_CLEANUP_CANDIDATE *cleanup_array;
+  volatile bool loading;	/* saved entries are being loaded */
+  volatile bool stop_loading;	/* loading of saved entries must stop */
 
   XCACHE_STATS stats;
 };
@@ -123,6 +133,8 @@ XCACHE xcache_Global = {
   0,				/* cleanup_flag */
   NULL,				/* cleanup_bh */
   NULL,				/* cleanup_array */
+  false,			/* loading */
+  false,			/* stop_loading */
   XCACHE_STATS_INITIALIZER
 };
 
@@ -139,6 +151,8 @@ XCACHE xcache_Global = {
 #define xcache_Cleanup_flag xcache_Global.cleanup_flag
 #define xcache_Cleanup_bh xcache_Global.cleanup_bh
 #define xcache_Cleanup_array xcache_Global.cleanup_array
+#define xcache_Loading xcache_Global.loading
+#define xcache_Stop_loading xcache_Global.stop_loading
 
 /* Statistics */
 #define XCACHE_STAT_GET(name) ATOMIC_LOAD_64 (&xcache_Global.stats.name)
@@ -249,6 +263,46 @@ static LF_ENTRY_DESCRIPTOR xcache_Entry_descriptor = {
   LOCK_TO_LOCKMODE_STRING ((xent)->related_objects[oidx].lock),						  \
   (xent)->related_objects[oidx].tcard
 
+/* Persistence: entries are saved to a file at shutdown (or on demand) and loaded back in background after restart.
+ * Each saved entry keeps, for every related class, the identity of its representation, heap file and indexes at the
+ * time it was saved. An entry is loaded only if all of them are unchanged. */
+#define XCACHE_PERSIST_MAGIC 0x58434143	/* "XCAC" */
+#define XCACHE_PERSIST_VERSION 1
+#define XCACHE_PERSIST_BUILD_SIZE 64
+
+typedef struct xcache_persist_header XCACHE_PERSIST_HEADER;
+struct xcache_persist_header
+{
+  int magic;
+  int version;
+  INT64 db_creation;		/* entries are only valid for the same database */
+  char build[XCACHE_PERSIST_BUILD_SIZE];	/* and for the same XASL stream format */
+  int n_entries;
+};
+
+typedef struct xcache_persist_entry XCACHE_PERSIST_ENTRY;
+struct xcache_persist_entry
+{
+  SHA1Hash sha1;
+  int n_related_objects;
+  int sql_hash_text_len;	/* lengths include the terminating null; 0 if there is no text */
+  int sql_user_text_len;
+  int sql_plan_text_len;
+  int stream_size;
+};
+
+typedef struct xcache_persist_object XCACHE_PERSIST_OBJECT;
+struct xcache_persist_object
+{
+  OID oid;
+  int lock;
+  int tcard;
+  REPR_ID repr_id;		/* NULL_REPRID for serials */
+  HFID hfid;
+  int n_indexes;
+  unsigned int index_hash;	/* hash of the index BTIDs */
+};
+
 static bool xcache_entry_mark_deleted (THREAD_ENTRY * thread_p, XASL_CACHE_ENTRY * xcache_entry);
 static bool xcache_entry_set_request_recompile_flag (THREAD_ENTRY * thread_p, XASL_CACHE_ENTRY * xcache_entry,
 						     bool set_flag);
@@ -260,6 +314,15 @@ static void xcache_invalidate_entries (THREAD_ENTRY * thread_p,
 				       bool (*invalidate_check) (XASL_CACHE_ENTRY *, const OID *), const OID * arg);
 static bool xcache_entry_is_related_to_oid (XASL_CACHE_ENTRY * xcache_entry, const OID * related_to_oid);
 static XCACHE_CLEANUP_REASON xcache_need_cleanup (void);
+static int xcache_get_object_signature (THREAD_ENTRY * thread_p, const OID * oid, int tcard,
+					XCACHE_PERSIST_OBJECT * signature);
+static bool xcache_check_object_signature (THREAD_ENTRY * thread_p, const XCACHE_PERSIST_OBJECT * saved);
+#if defined (SERVER_MODE)
+static void xcache_load (THREAD_ENTRY * thread_p);
+static int xcache_load_entry (THREAD_ENTRY * thread_p, FILE * fp, const XCACHE_PERSIST_ENTRY * entry_header,
+			      int *n_loaded, int *n_discarded);
+#endif /* SERVER_MODE */
+static void xcache_stop_load (void);
 
 /*
  * xcache_initialize () - Initialize XASL cache.
@@ -354,6 +417,8 @@ xcache_finalize (THREAD_ENTRY * thread_p)
       return;
     }
 
+  xcache_stop_load ();
+
   xcache_check_logging ();
   xcache_log ("finalize.\n");
 
@@ -429,6 +494,7 @@ xcache_entry_init (void *entry)
   /* Add here if anything should be initialized. */
   xcache_entry->related_objects = NULL;
   xcache_entry->ref_count = 0;
+  xcache_entry->list_ht_no = -1;
 
   xcache_entry->sql_info.sql_hash_text = NULL;
   xcache_entry->sql_info.sql_user_text = NULL;
@@ -439,6 +505,7 @@ xcache_entry_init (void *entry)
   xcache_entry->stream.buffer = NULL;
 
   xcache_entry->free_data_on_uninit = false;
+  xcache_entry->loaded_from_file = false;
   xcache_entry->initialized = true;
 
   assert (xcache_entry->n_cache_clones == 0);
@@ -478,6 +545,13 @@ xcache_entry_uninit (void *entry)
 		  XCACHE_LOG_ENTRY_TEXT ("xasl cache entry") XCACHE_LOG_TRAN_TEXT,
 		  XCACHE_LOG_ENTRY_ARGS (xcache_entry), XCACHE_LOG_TRAN_ARGS (thread_p));
 
+      if (xcache_entry->list_ht_no >= 0)
+	{
+	  /* drop cached results and release the list cache hash table */
+	  (void) qfile_clear_list_cache (thread_p, xcache_entry->list_ht_no, true);
+	  xcache_entry->list_ht_no = -1;
+	}
+
       if (xcache_entry->related_objects != NULL)
 	{
 	  free_and_init (xcache_entry->related_objects);
@@ -519,6 +593,7 @@ xcache_entry_uninit (void *entry)
 		  XCACHE_LOG_ENTRY_TEXT ("xasl cache entry") XCACHE_LOG_TRAN_TEXT,
 		  XCACHE_LOG_ENTRY_ARGS (xcache_entry), XCACHE_LOG_TRAN_ARGS (thread_p));
       xcache_entry->related_objects = NULL;
+      xcache_entry->list_ht_no = -1;
       xcache_entry->sql_info.sql_hash_text = NULL;
       xcache_entry->sql_info.sql_plan_text = NULL;
       xcache_entry->sql_info.sql_user_text = NULL;
@@ -816,6 +891,10 @@ xcache_find_sha1 (THREAD_ENTRY * thread_p, const SHA1Hash * sha1, const XASL_CAC
 
   perfmon_inc_stat (thread_p, PSTAT_PC_NUM_HIT);
   XCACHE_STAT_INC (hits);
+  if ((*xcache_entry)->loaded_from_file)
+    {
+      perfmon_inc_stat (thread_p, PSTAT_PC_NUM_LOADED_HIT);
+    }
 
   assert (*xcache_entry != NULL);
 
@@ -877,10 +956,8 @@ xcache_find_xasl_id_for_execute (THREAD_ENTRY * thread_p, const XASL_ID * xid, X
 				 XASL_CLONE * xclone)
 {
   int error_code = NO_ERROR;
-  HL_HEAPID save_heapid = 0;
   int oid_index;
   int lock_result;
-  bool use_xasl_clone = false;
   xasl_cache_rt_check_result recompile_due_to_threshold = XASL_CACHE_RECOMPILE_NOT_NEEDED;
 
   assert (xid != NULL);
@@ -987,38 +1064,69 @@ xcache_find_xasl_id_for_execute (THREAD_ENTRY * thread_p, const XASL_ID * xid, X
 
   assert ((*xcache_entry) != NULL);
 
+  error_code = xcache_get_clone (thread_p, *xcache_entry, xclone);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      xcache_unfix (thread_p, *xcache_entry);
+      *xcache_entry = NULL;
+      return error_code;
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * xcache_get_clone () - Get an XASL clone of a fixed cache entry. A cached clone is used if one is available,
+ *			 otherwise the XASL stream is unpacked.
+ *
+ * return	     : Error code.
+ * thread_p (in)     : Thread entry.
+ * xcache_entry (in) : Fixed XASL cache entry.
+ * xclone (out)      : XASL clone. Must be given back with xcache_retire_clone.
+ *
+ * NOTE: The entry is not unfixed on error; it is the caller's job.
+ */
+int
+xcache_get_clone (THREAD_ENTRY * thread_p, XASL_CACHE_ENTRY * xcache_entry, XASL_CLONE * xclone)
+{
+  int error_code = NO_ERROR;
+  HL_HEAPID save_heapid = 0;
+  bool use_xasl_clone = false;
+
+  assert (xcache_entry != NULL);
+  assert (xclone != NULL);
+
   if (xcache_uses_clones ())
     {
       use_xasl_clone = true;
       /* Try to fetch a cached clone. */
-      if ((*xcache_entry)->cache_clones == NULL)
+      if (xcache_entry->cache_clones == NULL)
 	{
 	  assert_release (false);
 	  /* Fall through. */
 	}
       else
 	{
-	  (void) pthread_mutex_lock (&(*xcache_entry)->cache_clones_mutex);
-	  assert ((*xcache_entry)->n_cache_clones <= xcache_Max_clones);
-	  if ((*xcache_entry)->n_cache_clones > 0)
+	  (void) pthread_mutex_lock (&xcache_entry->cache_clones_mutex);
+	  assert (xcache_entry->n_cache_clones <= xcache_Max_clones);
+	  if (xcache_entry->n_cache_clones > 0)
 	    {
 	      /* A clone is available. */
-	      *xclone = (*xcache_entry)->cache_clones[--(*xcache_entry)->n_cache_clones];
-	      (void) pthread_mutex_unlock (&(*xcache_entry)->cache_clones_mutex);
+	      *xclone = xcache_entry->cache_clones[--xcache_entry->n_cache_clones];
+	      (void) pthread_mutex_unlock (&xcache_entry->cache_clones_mutex);
 
 	      assert (xclone->xasl != NULL && xclone->xasl_buf != NULL);
 
 	      xcache_log ("found cached clone: \n"
 			  XCACHE_LOG_ENTRY_TEXT ("entry")
-			  XCACHE_LOG_XASL_ID_TEXT ("lookup xasl_id")
 			  XCACHE_LOG_CLONE
 			  XCACHE_LOG_TRAN_TEXT,
-			  XCACHE_LOG_ENTRY_ARGS (*xcache_entry),
-			  XCACHE_LOG_XASL_ID_ARGS (xid),
+			  XCACHE_LOG_ENTRY_ARGS (xcache_entry),
 			  XCACHE_LOG_CLONE_ARGS (xclone), XCACHE_LOG_TRAN_ARGS (thread_p));
 	      return NO_ERROR;
 	    }
-	  (void) pthread_mutex_unlock (&(*xcache_entry)->cache_clones_mutex);
+	  (void) pthread_mutex_unlock (&xcache_entry->cache_clones_mutex);
 	}
       /* Clone not found. */
       /* When clones are activated, we use global heap to generate the XASL's; this way, other threads can use the
@@ -1026,8 +1134,8 @@ xcache_find_xasl_id_for_execute (THREAD_ENTRY * thread_p, const XASL_ID * xid, X
       save_heapid = db_change_private_heap (thread_p, 0);
     }
   error_code =
-    stx_map_stream_to_xasl (thread_p, &xclone->xasl, use_xasl_clone, (*xcache_entry)->stream.buffer,
-			    (*xcache_entry)->stream.buffer_size, &xclone->xasl_buf);
+    stx_map_stream_to_xasl (thread_p, &xclone->xasl, use_xasl_clone, xcache_entry->stream.buffer,
+			    xcache_entry->stream.buffer_size, &xclone->xasl_buf);
   if (save_heapid != 0)
     {
       /* Restore heap id. */
@@ -1037,12 +1145,10 @@ xcache_find_xasl_id_for_execute (THREAD_ENTRY * thread_p, const XASL_ID * xid, X
     {
       ASSERT_ERROR ();
       assert (xclone->xasl == NULL && xclone->xasl_buf == NULL);
-      xcache_unfix (thread_p, *xcache_entry);
-      *xcache_entry = NULL;
 
       xcache_log_error ("could not load XASL tree and buffer: \n"
 			XCACHE_LOG_XASL_ID_TEXT ("xasl_id") XCACHE_LOG_TRAN_TEXT,
-			XCACHE_LOG_XASL_ID_ARGS (xid), XCACHE_LOG_TRAN_ARGS (thread_p));
+			XCACHE_LOG_XASL_ID_ARGS (&xcache_entry->xasl_id), XCACHE_LOG_TRAN_ARGS (thread_p));
 
       return error_code;
     }
@@ -1050,11 +1156,9 @@ xcache_find_xasl_id_for_execute (THREAD_ENTRY * thread_p, const XASL_ID * xid, X
 
   xcache_log ("loaded xasl clone: \n"
 	      XCACHE_LOG_ENTRY_TEXT ("entry")
-	      XCACHE_LOG_XASL_ID_TEXT ("lookup xasl_id")
 	      XCACHE_LOG_CLONE
 	      XCACHE_LOG_TRAN_TEXT,
-	      XCACHE_LOG_ENTRY_ARGS (*xcache_entry),
-	      XCACHE_LOG_XASL_ID_ARGS (xid), XCACHE_LOG_CLONE_ARGS (xclone), XCACHE_LOG_TRAN_ARGS (thread_p));
+	      XCACHE_LOG_ENTRY_ARGS (xcache_entry), XCACHE_LOG_CLONE_ARGS (xclone), XCACHE_LOG_TRAN_ARGS (thread_p));
 
   return NO_ERROR;
 }
@@ -2401,3 +2505,506 @@ xcache_uses_clones (void)
 {
   return xcache_Max_clones > 0;
 }
+
+/*
+ * xcache_get_object_signature () - Get the identity of a related object, to check later that it was not changed.
+ *
+ * return	  : Error code.
+ * thread_p (in)  : Thread entry.
+ * oid (in)	  : Class or serial OID.
+ * tcard (in)	  : Related object cardinality (XASL_SERIAL_OID_TCARD for serials).
+ * signature (out): Object signature.
+ */
+static int
+xcache_get_object_signature (THREAD_ENTRY * thread_p, const OID * oid, int tcard, XCACHE_PERSIST_OBJECT * signature)
+{
+  OR_CLASSREP *rep = NULL;
+  int idx_incache = -1;
+  int index;
+  int error_code = NO_ERROR;
+
+  memset (signature, 0, sizeof (*signature));
+  signature->oid = *oid;
+  signature->tcard = tcard;
+  signature->repr_id = NULL_REPRID;
+  HFID_SET_NULL (&signature->hfid);
+
+  if (tcard == XASL_SERIAL_OID_TCARD)
+    {
+      /* Serials have no representation. It is enough that they still exist. */
+      return heap_does_exist (thread_p, NULL, oid) ? NO_ERROR : ER_FAILED;
+    }
+
+  if (!heap_does_exist (thread_p, oid_Root_class_oid, oid))
+    {
+      return ER_FAILED;
+    }
+
+  error_code = heap_get_class_info (thread_p, oid, &signature->hfid, NULL, NULL);
+  if (error_code != NO_ERROR)
+    {
+      return error_code;
+    }
+
+  rep = heap_classrepr_get (thread_p, oid, NULL, NULL_REPRID, &idx_incache);
+  if (rep == NULL)
+    {
+      return ER_FAILED;
+    }
+
+  signature->repr_id = rep->id;
+  signature->n_indexes = rep->n_indexes;
+  for (index = 0; index < rep->n_indexes; index++)
+    {
+      signature->index_hash = signature->index_hash * 31 + (unsigned int) rep->indexes[index].btid.vfid.volid;
+      signature->index_hash = signature->index_hash * 31 + (unsigned int) rep->indexes[index].btid.vfid.fileid;
+      signature->index_hash = signature->index_hash * 31 + (unsigned int) rep->indexes[index].btid.root_pageid;
+    }
+  heap_classrepr_free_and_init (rep, &idx_incache);
+
+  return NO_ERROR;
+}
+
+/*
+ * xcache_check_object_signature () - Check that a related object is the same as when its signature was saved.
+ *
+ * return	 : True if object was not changed, false otherwise.
+ * thread_p (in) : Thread entry.
+ * saved (in)	 : Saved signature.
+ */
+static bool
+xcache_check_object_signature (THREAD_ENTRY * thread_p, const XCACHE_PERSIST_OBJECT * saved)
+{
+  XCACHE_PERSIST_OBJECT current;
+
+  if (xcache_get_object_signature (thread_p, &saved->oid, saved->tcard, &current) != NO_ERROR)
+    {
+      /* Object was dropped. */
+      er_clear ();
+      return false;
+    }
+
+  return (current.repr_id == saved->repr_id && HFID_EQ (&current.hfid, &saved->hfid)
+	  && current.n_indexes == saved->n_indexes && current.index_hash == saved->index_hash);
+}
+
+/*
+ * xcache_save () - Save XASL cache entries to a file, to load them back after restart.
+ *
+ * return	 : Error code.
+ * thread_p (in) : Thread entry.
+ *
+ * Note: The file is written to a temporary name first and renamed, so a crash never leaves a partial file. A load
+ *	 still in progress is stopped; entries not loaded yet are not saved again.
+ */
+int
+xcache_save (THREAD_ENTRY * thread_p)
+{
+  LF_HASH_TABLE_ITERATOR iter;
+  LF_TRAN_ENTRY *t_entry = thread_get_tran_entry (thread_p, THREAD_TS_XCACHE);
+  XASL_CACHE_ENTRY *xcache_entry = NULL;
+  XCACHE_PERSIST_HEADER header;
+  XCACHE_PERSIST_ENTRY entry_header;
+  XCACHE_PERSIST_OBJECT *objects = NULL, *new_objects = NULL;
+  int objects_capacity = 0;
+  int oid_index;
+  char xcache_name[PATH_MAX], tmp_name[PATH_MAX];
+  FILE *fp;
+  bool is_written;
+
+  if (!xcache_Enabled || !prm_get_bool_value (PRM_ID_XASL_CACHE_PERSIST))
+    {
+      return NO_ERROR;
+    }
+
+  xcache_stop_load ();
+
+  fileio_make_xcache_name (xcache_name, log_Path, log_Prefix);
+  snprintf (tmp_name, sizeof (tmp_name), "%s.tmp", xcache_name);
+
+  fp = fopen (tmp_name, "wb");
+  if (fp == NULL)
+    {
+      er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_GENERIC_ERROR, 0);
+      return ER_GENERIC_ERROR;
+    }
+
+  memset (&header, 0, sizeof (header));
+  header.magic = XCACHE_PERSIST_MAGIC;
+  header.version = XCACHE_PERSIST_VERSION;
+  header.db_creation = log_Gl.hdr.db_creation;
+  strncpy (header.build, rel_build_number (), sizeof (header.build) - 1);
+  header.n_entries = 0;
+  is_written = (fwrite (&header, sizeof (header), 1, fp) == 1);
+
+  /* NOTE: Iterate to the end even if write fails; the iterator ends the latch-free transaction when done. */
+  lf_hash_create_iterator (&iter, t_entry, &xcache_Ht);
+  while ((xcache_entry = (XASL_CACHE_ENTRY *) lf_hash_iterate (&iter)) != NULL)
+    {
+      if (!is_written)
+	{
+	  continue;
+	}
+      if ((xcache_entry->xasl_id.cache_flag & XCACHE_ENTRY_FLAGS_MASK) != 0 || xcache_entry->stream.buffer == NULL
+	  || xcache_entry->sql_info.sql_hash_text == NULL)
+	{
+	  /* deleted, being recompiled or not usable */
+	  continue;
+	}
+
+      if (xcache_entry->n_related_objects > objects_capacity)
+	{
+	  new_objects =
+	    (XCACHE_PERSIST_OBJECT *) realloc (objects, xcache_entry->n_related_objects * sizeof (XCACHE_PERSIST_OBJECT));
+	  if (new_objects == NULL)
+	    {
+	      is_written = false;
+	      continue;
+	    }
+	  objects = new_objects;
+	  objects_capacity = xcache_entry->n_related_objects;
+	}
+      for (oid_index = 0; oid_index < xcache_entry->n_related_objects; oid_index++)
+	{
+	  if (xcache_get_object_signature (thread_p, &xcache_entry->related_objects[oid_index].oid,
+					   xcache_entry->related_objects[oid_index].tcard, &objects[oid_index])
+	      != NO_ERROR)
+	    {
+	      break;
+	    }
+	  objects[oid_index].lock = (int) xcache_entry->related_objects[oid_index].lock;
+	}
+      if (oid_index < xcache_entry->n_related_objects)
+	{
+	  /* object was dropped; entry is about to be removed */
+	  er_clear ();
+	  continue;
+	}
+
+      memset (&entry_header, 0, sizeof (entry_header));
+      entry_header.sha1 = xcache_entry->xasl_id.sha1;
+      entry_header.n_related_objects = xcache_entry->n_related_objects;
+      entry_header.sql_hash_text_len = (int) strlen (xcache_entry->sql_info.sql_hash_text) + 1;
+      entry_header.sql_user_text_len =
+	xcache_entry->sql_info.sql_user_text != NULL ? (int) strlen (xcache_entry->sql_info.sql_user_text) + 1 : 0;
+      entry_header.sql_plan_text_len =
+	xcache_entry->sql_info.sql_plan_text != NULL ? (int) strlen (xcache_entry->sql_info.sql_plan_text) + 1 : 0;
+      entry_header.stream_size = xcache_entry->stream.buffer_size;
+
+      is_written = (fwrite (&entry_header, sizeof (entry_header), 1, fp) == 1
+		    && fwrite (objects, sizeof (XCACHE_PERSIST_OBJECT), (size_t) entry_header.n_related_objects, fp)
+		    == (size_t) entry_header.n_related_objects
+		    && fwrite (xcache_entry->sql_info.sql_hash_text, 1, (size_t) entry_header.sql_hash_text_len, fp)
+		    == (size_t) entry_header.sql_hash_text_len
+		    && (entry_header.sql_user_text_len == 0
+			|| fwrite (xcache_entry->sql_info.sql_user_text, (size_t) entry_header.sql_user_text_len, 1,
+				   fp) == 1)
+		    && (entry_header.sql_plan_text_len == 0
+			|| fwrite (xcache_entry->sql_info.sql_plan_text, (size_t) entry_header.sql_plan_text_len, 1,
+				   fp) == 1)
+		    && fwrite (xcache_entry->stream.buffer, 1, (size_t) entry_header.stream_size, fp)
+		    == (size_t) entry_header.stream_size);
+      header.n_entries++;
+    }
+
+  if (objects != NULL)
+    {
+      free (objects);
+    }
+
+  if (is_written)
+    {
+      /* now that the entries are counted, rewrite the header */
+      is_written = (fseek (fp, 0, SEEK_SET) == 0 && fwrite (&header, sizeof (header), 1, fp) == 1);
+    }
+  is_written = (fclose (fp) == 0) && is_written;
+
+  if (!is_written || rename (tmp_name, xcache_name) != 0)
+    {
+      er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_GENERIC_ERROR, 0);
+      er_log_debug (ARG_FILE_LINE, "xcache_save: cannot save %s\n", xcache_name);
+      (void) remove (tmp_name);
+      return ER_GENERIC_ERROR;
+    }
+
+  er_log_debug (ARG_FILE_LINE, "xcache_save: saved %d entries to %s\n", header.n_entries, xcache_name);
+  return NO_ERROR;
+}
+
+/*
+ * xcache_start_load () - Start loading the saved XASL cache entries in background.
+ *
+ * return : Void.
+ */
+void
+xcache_start_load (void)
+{
+#if defined (SERVER_MODE)
+  if (!xcache_Enabled || !prm_get_bool_value (PRM_ID_XASL_CACHE_PERSIST))
+    {
+      return;
+    }
+
+  xcache_Stop_loading = false;
+  xcache_Loading = true;
+
+  // *INDENT-OFF*
+  cubthread::entry_task *load_task = new cubthread::entry_callable_task ([] (cubthread::entry &context)
+  {
+    xcache_load (&context);
+  });
+
+  cubthread::get_manager ()->push_task (cubthread::internal_tasks_worker_pool::get_instance (), load_task);
+  // *INDENT-ON*
+#endif /* SERVER_MODE */
+}
+
+/*
+ * xcache_stop_load () - Stop loading the saved XASL cache entries and wait for the loader to finish.
+ *
+ * return : Void.
+ */
+static void
+xcache_stop_load (void)
+{
+#if defined (SERVER_MODE)
+  xcache_Stop_loading = true;
+  while (xcache_Loading)
+    {
+      thread_sleep (10);
+    }
+#endif /* SERVER_MODE */
+}
+
+#if defined (SERVER_MODE)
+/*
+ * xcache_load () - Load the saved XASL cache entries. Entries with changed related objects are discarded.
+ *
+ * return	 : Void.
+ * thread_p (in) : Thread entry.
+ *
+ * Note: Loading is best effort; a missing or bad file only means the cache starts empty. It stops when the cache is
+ *	 full, so loaded entries never evict those compiled since restart.
+ */
+static void
+xcache_load (THREAD_ENTRY * thread_p)
+{
+  char xcache_name[PATH_MAX];
+  XCACHE_PERSIST_HEADER header;
+  XCACHE_PERSIST_ENTRY entry_header;
+  FILE *fp = NULL;
+  int save_tran_index;
+  int entry_index;
+  int n_loaded = 0, n_discarded = 0;
+
+  /* threads of internal tasks have no transaction; read the catalog as system transaction */
+  save_tran_index = thread_p->tran_index;
+  thread_p->tran_index = LOG_SYSTEM_TRAN_INDEX;
+
+  fileio_make_xcache_name (xcache_name, log_Path, log_Prefix);
+  fp = fopen (xcache_name, "rb");
+  if (fp == NULL)
+    {
+      goto end;
+    }
+
+  if (fread (&header, sizeof (header), 1, fp) != 1 || header.magic != XCACHE_PERSIST_MAGIC
+      || header.version != XCACHE_PERSIST_VERSION || header.db_creation != log_Gl.hdr.db_creation
+      || strncmp (header.build, rel_build_number (), sizeof (header.build) - 1) != 0 || header.n_entries < 0)
+    {
+      er_log_debug (ARG_FILE_LINE, "xcache_load: %s was not saved by this database or build\n", xcache_name);
+      goto end;
+    }
+
+  for (entry_index = 0; entry_index < header.n_entries; entry_index++)
+    {
+      if (xcache_Stop_loading || ATOMIC_INC_32 (&xcache_Entry_count, 0) >= xcache_Soft_capacity)
+	{
+	  break;
+	}
+
+      if (fread (&entry_header, sizeof (entry_header), 1, fp) != 1 || entry_header.n_related_objects < 0
+	  || entry_header.sql_hash_text_len <= 0 || entry_header.sql_user_text_len < 0
+	  || entry_header.sql_plan_text_len < 0 || entry_header.stream_size <= 0)
+	{
+	  break;
+	}
+
+      if (xcache_load_entry (thread_p, fp, &entry_header, &n_loaded, &n_discarded) != NO_ERROR)
+	{
+	  er_clear ();
+	  break;
+	}
+    }
+
+  er_log_debug (ARG_FILE_LINE, "xcache_load: loaded %d and discarded %d of %d entries from %s\n", n_loaded,
+		n_discarded, header.n_entries, xcache_name);
+
+end:
+  if (fp != NULL)
+    {
+      fclose (fp);
+    }
+  thread_p->tran_index = save_tran_index;
+  xcache_Loading = false;
+}
+
+/*
+ * xcache_load_entry () - Read one saved entry and insert it into XASL cache, if its related objects were not changed.
+ *
+ * return	     : Error code (read errors only).
+ * thread_p (in)     : Thread entry.
+ * fp (in)	     : Saved file, positioned after entry header.
+ * entry_header (in) : Entry header.
+ * n_loaded (in/out) : Incremented if entry is inserted.
+ * n_discarded (in/out) : Incremented if entry is discarded.
+ */
+static int
+xcache_load_entry (THREAD_ENTRY * thread_p, FILE * fp, const XCACHE_PERSIST_ENTRY * entry_header, int *n_loaded,
+		   int *n_discarded)
+{
+  XCACHE_PERSIST_OBJECT *objects = NULL;
+  OID *class_oids = NULL;
+  int *class_locks = NULL;
+  int *tcards = NULL;
+  int n_oid = entry_header->n_related_objects;
+  int oid_index;
+  char *strbuf = NULL;
+  size_t strbuf_size;
+  char *stream_buffer = NULL;
+  COMPILE_CONTEXT context;
+  XASL_ID xid;
+  XASL_STREAM stream;
+  XASL_CACHE_ENTRY *xcache_entry = NULL;
+  int error_code = NO_ERROR;
+
+  strbuf_size = (size_t) entry_header->sql_hash_text_len + (size_t) entry_header->sql_user_text_len
+    + (size_t) entry_header->sql_plan_text_len;
+  strbuf = (char *) malloc (strbuf_size);
+  stream_buffer = (char *) malloc ((size_t) entry_header->stream_size);
+  if (n_oid > 0)
+    {
+      objects = (XCACHE_PERSIST_OBJECT *) malloc (n_oid * sizeof (XCACHE_PERSIST_OBJECT));
+      class_oids = (OID *) malloc (n_oid * sizeof (OID));
+      class_locks = (int *) malloc (n_oid * sizeof (int));
+      tcards = (int *) malloc (n_oid * sizeof (int));
+    }
+  if (strbuf == NULL || stream_buffer == NULL
+      || (n_oid > 0 && (objects == NULL || class_oids == NULL || class_locks == NULL || tcards == NULL)))
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      strbuf_size + (size_t) entry_header->stream_size);
+      error_code = ER_OUT_OF_VIRTUAL_MEMORY;
+      goto end;
+    }
+
+  if ((n_oid > 0 && fread (objects, sizeof (XCACHE_PERSIST_OBJECT), (size_t) n_oid, fp) != (size_t) n_oid)
+      || fread (strbuf, 1, strbuf_size, fp) != strbuf_size
+      || fread (stream_buffer, 1, (size_t) entry_header->stream_size, fp) != (size_t) entry_header->stream_size)
+    {
+      error_code = ER_FAILED;
+      goto end;
+    }
+
+  /* the whole entry is read; from here on, the next entry can be read even if this one is discarded */
+  for (oid_index = 0; oid_index < n_oid; oid_index++)
+    {
+      if (!xcache_check_object_signature (thread_p, &objects[oid_index]))
+	{
+	  (*n_discarded)++;
+	  perfmon_inc_stat (thread_p, PSTAT_PC_NUM_LOAD_DISCARDED);
+	  goto end;
+	}
+      class_oids[oid_index] = objects[oid_index].oid;
+      class_locks[oid_index] = objects[oid_index].lock;
+      tcards[oid_index] = objects[oid_index].tcard;
+    }
+
+  memset (&context, 0, sizeof (context));
+  context.sha1 = entry_header->sha1;
+  context.sql_hash_text = strbuf;
+  strbuf[entry_header->sql_hash_text_len - 1] = '\0';
+  if (entry_header->sql_user_text_len > 0)
+    {
+      context.sql_user_text = strbuf + entry_header->sql_hash_text_len;
+      context.sql_user_text[entry_header->sql_user_text_len - 1] = '\0';
+    }
+  if (entry_header->sql_plan_text_len > 0)
+    {
+      context.sql_plan_text = strbuf + entry_header->sql_hash_text_len + entry_header->sql_user_text_len;
+      context.sql_plan_text[entry_header->sql_plan_text_len - 1] = '\0';
+    }
+  context.recompile_xasl = false;
+
+  XASL_ID_SET_NULL (&xid);
+  stream.xasl_id = &xid;
+  stream.xasl_header = NULL;
+  stream.buffer = stream_buffer;
+  stream.buffer_size = entry_header->stream_size;
+
+  error_code = xcache_insert (thread_p, &context, &stream, n_oid, class_oids, class_locks, tcards, &xcache_entry);
+  if (error_code != NO_ERROR || xcache_entry == NULL)
+    {
+      /* not a read error; go on with next entry. the stream buffer is not consumed on error. */
+      stream_buffer = stream.buffer;
+      er_clear ();
+      error_code = NO_ERROR;
+      goto end;
+    }
+
+  /* the stream buffer is consumed: kept by the new entry, or freed if the entry was compiled again meanwhile */
+  if (xcache_entry->stream.buffer == stream_buffer)
+    {
+      /* a class may have been changed after it was checked and before the entry was inserted; check it again */
+      for (oid_index = 0; oid_index < n_oid; oid_index++)
+	{
+	  if (!xcache_check_object_signature (thread_p, &objects[oid_index]))
+	    {
+	      break;
+	    }
+	}
+      if (oid_index < n_oid)
+	{
+	  xcache_unfix (thread_p, xcache_entry);
+	  xcache_remove_by_oid (thread_p, &objects[oid_index].oid);
+	  (*n_discarded)++;
+	  perfmon_inc_stat (thread_p, PSTAT_PC_NUM_LOAD_DISCARDED);
+	  stream_buffer = NULL;
+	  goto end;
+	}
+
+      xcache_entry->loaded_from_file = true;
+      (*n_loaded)++;
+      perfmon_inc_stat (thread_p, PSTAT_PC_NUM_LOADED);
+    }
+  stream_buffer = NULL;
+  xcache_unfix (thread_p, xcache_entry);
+
+end:
+  if (stream_buffer != NULL)
+    {
+      free (stream_buffer);
+    }
+  if (strbuf != NULL)
+    {
+      free (strbuf);
+    }
+  if (objects != NULL)
+    {
+      free (objects);
+    }
+  if (class_oids != NULL)
+    {
+      free (class_oids);
+    }
+  if (class_locks != NULL)
+    {
+      free (class_locks);
+    }
+  if (tcards != NULL)
+    {
+      free (tcards);
+    }
+  return error_code;
+}
+#endif /* SERVER_MODE */
@@ -114,6 +114,7 @@ struct xasl_cache_ent
   int list_ht_no;		/* memory hash table for query result(list file) cache generated by this XASL
 				 * referencing by DB_VALUE parameters bound to the result */
   bool free_data_on_uninit;	/* set to free entry data on uninit. */
+  bool loaded_from_file;	/* entry was loaded from the file saved before restart */
 
   /* Cache clones */
   XASL_CLONE *cache_clones;
@@ -151,6 +152,7 @@ extern int xcache_find_sha1 (THREAD_ENTRY * thread_p, const SHA1Hash * sha1, con
 			     XASL_CACHE_ENTRY ** xcache_entry, xasl_cache_rt_check_result * rt_check);
 extern int xcache_find_xasl_id_for_execute (THREAD_ENTRY * thread_p, const XASL_ID * xid,
 					    XASL_CACHE_ENTRY ** xcache_entry, XASL_CLONE * xclone);
+extern int xcache_get_clone (THREAD_ENTRY * thread_p, XASL_CACHE_ENTRY * xcache_entry, XASL_CLONE * xclone);
 extern void xcache_unfix (THREAD_ENTRY * thread_p, XASL_CACHE_ENTRY * xcache_entry);
 extern int xcache_insert (THREAD_ENTRY * thread_p, const compile_context * context, XASL_STREAM * stream,
 			  int n_oid, const OID * class_oids, const int *class_locks,
@@ -158,6 +160,8 @@ extern int xcache_insert (THREAD_ENTRY * thread_p, const compile_context * conte
 extern void xcache_remove_by_oid (THREAD_ENTRY * thread_p, const OID * oid);
 extern void xcache_drop_all (THREAD_ENTRY * thread_p);
 extern void xcache_dump (THREAD_ENTRY * thread_p, FILE * fp);
+extern int xcache_save (THREAD_ENTRY * thread_p);
+extern void xcache_start_load (void);
 
 extern bool xcache_can_entry_cache_list (XASL_CACHE_ENTRY * xcache_entry);
 
@@ -3089,6 +3089,7 @@ xts_process_xasl_node (char *ptr, const XASL_NODE * xasl)
   ptr = or_pack_double (ptr, xasl->cardinality);
 
   ptr = or_pack_int (ptr, (int) xasl->iscan_oid_order);
+  ptr = or_pack_int (ptr, xasl->parallel_degree);
 
   if (xasl->query_alias)
     {
@@ -3535,6 +3536,8 @@ xts_process_ls_merge_info (char *ptr, const QFILE_LIST_MERGE_INFO * qfile_list_m
 
   ptr = or_pack_int (ptr, qfile_list_merge_info->single_fetch);
 
+  ptr = or_pack_int (ptr, qfile_list_merge_info->join_method);
+
   ptr = or_pack_int (ptr, qfile_list_merge_info->ls_column_cnt);
 
   offset = xts_save_int_array (qfile_list_merge_info->ls_outer_column, qfile_list_merge_info->ls_column_cnt);
@@ -5848,6 +5851,7 @@ xts_sizeof_xasl_node (const XASL_NODE * xasl)
   size += (OR_INT_SIZE		/* projected_size */
 	   + OR_DOUBLE_ALIGNED_SIZE	/* cardinality */
 	   + OR_INT_SIZE	/* iscan_oid_order */
+	   + OR_INT_SIZE	/* parallel_degree */
 	   + PTR_SIZE		/* query_alias */
 	   + PTR_SIZE);		/* next */
 
@@ -6008,6 +6012,7 @@ xts_sizeof_ls_merge_info (const QFILE_LIST_MERGE_INFO * qfile_list_merge_info)
 
   size += (OR_INT_SIZE		/* join_type */
 	   + OR_INT_SIZE	/* single_fetch */
+	   + OR_INT_SIZE	/* join_method */
 	   + OR_INT_SIZE	/* ls_column_cnt */
 	   + PTR_SIZE		/* ls_outer_column */
 	   + PTR_SIZE		/* ls_outer_unique */
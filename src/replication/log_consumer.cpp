@@ -26,9 +26,14 @@
 #include "log_consumer.hpp"
 
 #include "error_manager.h"
+#include "heap_file.h"
 #include "locator_sr.h"
+#include "memory_hash.h"
 #include "multi_thread_stream.hpp"
+#include "object_representation_sr.h"
+#include "perf_monitor.h"
 #include "replication_common.hpp"
+#include "replication_object.hpp"
 #include "replication_stream_entry.hpp"
 #include "replication_subtran_apply.hpp"
 #include "stream_entry_fetcher.hpp"
@@ -38,15 +43,29 @@
 #include "thread_daemon.hpp"
 #include "thread_entry_task.hpp"
 #include "thread_task.hpp"
+#include "xserver_interface.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <functional>
 #include <unordered_map>
 
 namespace cubreplication
 {
+  /* dispatched and not applied tasks, per applier worker */
+  const std::size_t APPLY_DISPATCHED_TASKS_PER_WORKER = 8;
+  /* a task changing more rows is applied alone */
+  const std::size_t APPLY_MAX_TASK_KEYS = 65536;
+  /* key of all changes of classes having or referenced by foreign keys */
+  const apply_dependency_graph::key FOREIGN_KEY_APPLY_KEY = 0;
+
   class applier_worker_task : public cubthread::entry_task
   {
     public:
       applier_worker_task (stream_entry *repl_stream_entry, log_consumer &lc)
 	: m_lc (lc)
+	, m_ticket (0)
+	, m_dispatch_time ()
       {
 	add_repl_stream_entry (repl_stream_entry);
       }
@@ -64,10 +83,9 @@ namespace cubreplication
       {
 	(void) locator_repl_start_tran (&thread_ref);
 
+	/* stream entries were unpacked by dispatcher */
 	for (stream_entry *&curr_stream_entry : m_repl_stream_entries)
 	  {
-	    curr_stream_entry->unpack ();
-
 	    if (prm_get_bool_value (PRM_ID_DEBUG_REPLICATION_DATA))
 	      {
 		string_buffer sb;
@@ -96,6 +114,7 @@ namespace cubreplication
 	m_repl_stream_entries.clear ();
 
 	(void) locator_repl_end_tran (&thread_ref, true);
+	m_lc.finish_task (this);
 	m_lc.end_one_task ();
       }
 
@@ -125,6 +144,34 @@ namespace cubreplication
 	return m_repl_stream_entries.size ();
       }
 
+      const std::vector<stream_entry *> &get_stream_entries (void) const
+      {
+	return m_repl_stream_entries;
+      }
+
+      /* tasks are dispatched in order of their commit stream entries */
+      cubstream::stream_position get_commit_position (void) const
+      {
+	assert (!m_repl_stream_entries.empty ());
+	return m_repl_stream_entries.back ()->get_stream_entry_start_position ();
+      }
+
+      void set_dispatched (apply_dependency_graph::ticket ticket)
+      {
+	m_ticket = ticket;
+	m_dispatch_time = std::chrono::steady_clock::now ();
+      }
+
+      apply_dependency_graph::ticket get_ticket (void) const
+      {
+	return m_ticket;
+      }
+
+      std::chrono::steady_clock::time_point get_dispatch_time (void) const
+      {
+	return m_dispatch_time;
+      }
+
       void stringify (string_buffer &sb)
       {
 	sb ("apply_task: stream_entries:%d\n", get_entries_cnt ());
@@ -137,6 +184,8 @@ namespace cubreplication
     private:
       std::vector<stream_entry *> m_repl_stream_entries;
       log_consumer &m_lc;
+      apply_dependency_graph::ticket m_ticket;
+      std::chrono::steady_clock::time_point m_dispatch_time;
   };
 
   class dispatch_daemon_task : public cubthread::entry_task
@@ -147,6 +196,7 @@ namespace cubreplication
 	, m_entry_fetcher (*lc.get_stream ())
 	, m_lc (lc)
 	, m_stop (false)
+	, m_class_scopes ()
       {
       }
 
@@ -209,27 +259,23 @@ namespace cubreplication
 		_er_log_debug (ARG_FILE_LINE, "dispatch_daemon_task execute pop_entry:\n%s", sb.get_buffer ());
 	      }
 
-	    /* TODO[replication] : on-the-fly applier & multi-threaded applier */
+	    /* TODO[replication] : on-the-fly applier */
 	    if (se->is_group_commit ())
 	      {
 		assert (se->get_data_packed_size () == 0);
-
-		/* wait for all started tasks to finish */
-		er_log_debug_replication (ARG_FILE_LINE, "dispatch_daemon_task wait for all working tasks to finish\n");
 		assert (se->get_stream_entry_start_position () < se->get_stream_entry_end_position ());
 
-		m_lc.wait_for_tasks ();
-
 		// apply all sub-transaction first
 		m_lc.get_subtran_applier ().apply ();
 
+		std::vector<applier_worker_task *> committed_tasks;
 		for (tasks_map::iterator it = repl_tasks.begin (); it != repl_tasks.end (); it++)
 		  {
 		    /* check last stream entry of task */
 		    applier_worker_task *my_repl_applier_worker_task = it->second;
 		    if (my_repl_applier_worker_task->has_commit ())
 		      {
-			m_lc.execute_task (it->second);
+			committed_tasks.push_back (it->second);
 		      }
 		    else if (my_repl_applier_worker_task->has_abort ())
 		      {
@@ -253,6 +299,9 @@ namespace cubreplication
 		    nonexecutable_repl_tasks.clear ();
 		  }
 
+		/* tasks are not waited; they are applied after the dispatched tasks they conflict with */
+		dispatch_committed_tasks (thread_ref, committed_tasks);
+
 		/* delete the group commit stream entry */
 		assert (se->is_group_commit ());
 		delete se;
@@ -272,6 +321,23 @@ namespace cubreplication
 	      }
 	    else
 	      {
+		/* unpacked here, since dispatch needs the changed rows */
+		err = se->unpack ();
+		if (err != NO_ERROR)
+		  {
+		    /* the transactions of the entry cannot be applied; nor can those after it, which may depend on
+		     * them */
+		    char msg[256];
+
+		    snprintf (msg, sizeof (msg), "cannot unpack stream entry at position %llu (error %d); "
+			      "replication apply is stopped",
+			      (unsigned long long) se->get_stream_entry_start_position (), err);
+		    er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_REPL_ERROR, 1, msg);
+		    m_stop = true;
+		    delete se;
+		    break;
+		  }
+
 		MVCCID mvccid = se->get_mvccid ();
 		auto it = repl_tasks.find (mvccid);
 
@@ -302,11 +368,211 @@ namespace cubreplication
 	    repl_task.second = NULL;
 	  }
 	// wait for the applying tasks
+	m_lc.wait_for_dispatched_tasks ();
 	m_lc.wait_for_tasks ();
 	m_lc.set_dispatcher_finished ();
       }
 
     private:
+      /* how transactions changing rows of a class are ordered */
+      enum apply_scope
+      {
+	APPLY_SCOPE_ROW,                /* by primary key */
+	APPLY_SCOPE_CLASS,              /* by class; class has other unique indexes */
+	APPLY_SCOPE_FOREIGN_KEY         /* with all classes having or referenced by foreign keys */
+      };
+
+      struct class_apply_info
+      {
+	apply_scope scope;
+	std::vector<int> pk_attr_ids;   /* attributes of primary key, for APPLY_SCOPE_ROW */
+      };
+
+      void dispatch_committed_tasks (cubthread::entry &thread_ref, std::vector<applier_worker_task *> &tasks)
+      {
+	std::vector<apply_dependency_graph::key> exclusive_keys;
+	std::vector<apply_dependency_graph::key> shared_keys;
+	bool is_barrier;
+
+	std::sort (tasks.begin (), tasks.end (), [] (applier_worker_task *a, applier_worker_task *b)
+	{
+	  return a->get_commit_position () < b->get_commit_position ();
+	});
+
+	for (applier_worker_task *task : tasks)
+	  {
+	    exclusive_keys.clear ();
+	    shared_keys.clear ();
+	    is_barrier = get_apply_keys (thread_ref, *task, exclusive_keys, shared_keys);
+
+	    m_lc.dispatch_task (task, exclusive_keys, shared_keys, is_barrier);
+
+	    if (is_barrier)
+	      {
+		/* schema may change; it is read again after barrier is applied */
+		m_lc.wait_for_dispatched_tasks ();
+		m_class_scopes.clear ();
+	      }
+	  }
+      }
+
+      /* keys of rows changed by task; returns true if task must be applied alone */
+      bool get_apply_keys (cubthread::entry &thread_ref, applier_worker_task &task,
+			   std::vector<apply_dependency_graph::key> &exclusive_keys,
+			   std::vector<apply_dependency_graph::key> &shared_keys)
+      {
+	for (stream_entry *se : task.get_stream_entries ())
+	  {
+	    for (int i = 0; i < se->get_packable_entry_count_from_header (); i++)
+	      {
+		replication_object *obj = se->get_object_at (i);
+
+		single_row_repl_entry *row_obj = dynamic_cast<single_row_repl_entry *> (obj);
+		if (row_obj != NULL)
+		  {
+		    const std::string &class_name = row_obj->get_class_name ();
+
+		    /* rows of class are changed; conflicts with changes of whole class */
+		    shared_keys.push_back (get_class_key (class_name));
+
+		    const class_apply_info &info = get_class_apply_info (thread_ref, class_name);
+		    switch (info.scope)
+		      {
+		      case APPLY_SCOPE_ROW:
+			if (may_change_primary_key (*row_obj, info))
+			  {
+			    /* the row moves to a key that is not known here; conflicts with the rows of both keys */
+			    exclusive_keys.push_back (get_class_key (class_name));
+			  }
+			else
+			  {
+			    exclusive_keys.push_back (get_row_key (class_name, row_obj->get_key_value ()));
+			  }
+			break;
+		      case APPLY_SCOPE_CLASS:
+			exclusive_keys.push_back (get_class_key (class_name));
+			break;
+		      case APPLY_SCOPE_FOREIGN_KEY:
+			exclusive_keys.push_back (FOREIGN_KEY_APPLY_KEY);
+			break;
+		      }
+		    continue;
+		  }
+
+		multirow_object *multirow_obj = dynamic_cast<multirow_object *> (obj);
+		if (multirow_obj != NULL)
+		  {
+		    exclusive_keys.push_back (get_class_key (multirow_obj->get_class_name ()));
+		    continue;
+		  }
+
+		if (dynamic_cast<savepoint_object *> (obj) != NULL)
+		  {
+		    /* changes nothing others can see */
+		    continue;
+		  }
+
+		/* statement replication or unknown object */
+		return true;
+	      }
+	  }
+
+	return exclusive_keys.size () > APPLY_MAX_TASK_KEYS;
+      }
+
+      const class_apply_info &get_class_apply_info (cubthread::entry &thread_ref, const std::string &class_name)
+      {
+	static const class_apply_info unknown_class_info = { APPLY_SCOPE_CLASS, {} };
+	OID class_oid;
+	OR_CLASSREP *classrep = NULL;
+	int idx_incache = -1;
+	class_apply_info info = { APPLY_SCOPE_ROW, {} };
+
+	auto found = m_class_scopes.find (class_name);
+	if (found != m_class_scopes.end ())
+	  {
+	    return found->second;
+	  }
+
+	if (xlocator_find_class_oid (&thread_ref, class_name.c_str (), &class_oid, NULL_LOCK) != LC_CLASSNAME_EXIST)
+	  {
+	    /* apply will fail anyway */
+	    er_clear ();
+	    return unknown_class_info;
+	  }
+
+	classrep = heap_classrepr_get (&thread_ref, &class_oid, NULL, NULL_REPRID, &idx_incache);
+	if (classrep == NULL)
+	  {
+	    er_clear ();
+	    return unknown_class_info;
+	  }
+
+	for (int i = 0; i < classrep->n_indexes; i++)
+	  {
+	    const OR_INDEX &index = classrep->indexes[i];
+
+	    if (index.type == BTREE_FOREIGN_KEY || (index.type == BTREE_PRIMARY_KEY && index.fk != NULL))
+	      {
+		info.scope = APPLY_SCOPE_FOREIGN_KEY;
+		break;
+	      }
+	    if (index.type == BTREE_UNIQUE || index.type == BTREE_REVERSE_UNIQUE)
+	      {
+		info.scope = APPLY_SCOPE_CLASS;
+	      }
+	    if (index.type == BTREE_PRIMARY_KEY)
+	      {
+		for (int j = 0; j < index.n_atts; j++)
+		  {
+		    info.pk_attr_ids.push_back (index.atts[j]->id);
+		  }
+	      }
+	  }
+	heap_classrepr_free_and_init (classrep, &idx_incache);
+
+	return m_class_scopes.emplace (class_name, std::move (info)).first->second;
+      }
+
+      /* true if the row may be moved to another primary key; its key value is the key before the change */
+      static bool may_change_primary_key (const single_row_repl_entry &row_obj, const class_apply_info &info)
+      {
+	if (row_obj.get_type () != REPL_UPDATE)
+	  {
+	    return false;
+	  }
+
+	const changed_attrs_row_repl_entry *changed_attrs_obj =
+		dynamic_cast<const changed_attrs_row_repl_entry *> (&row_obj);
+	if (changed_attrs_obj == NULL)
+	  {
+	    /* the whole record is replaced */
+	    return true;
+	  }
+
+	for (int attr_id : changed_attrs_obj->get_changed_attributes ())
+	  {
+	    if (std::find (info.pk_attr_ids.begin (), info.pk_attr_ids.end (), attr_id) != info.pk_attr_ids.end ())
+	      {
+		return true;
+	      }
+	  }
+	return false;
+      }
+
+      static apply_dependency_graph::key get_class_key (const std::string &class_name)
+      {
+	return std::hash<std::string> () (class_name);
+      }
+
+      static apply_dependency_graph::key get_row_key (const std::string &class_name, const DB_VALUE &key_value)
+      {
+	apply_dependency_graph::key class_key = get_class_key (class_name);
+	apply_dependency_graph::key value_key = mht_get_hash_number (INT_MAX, &key_value);
+
+	return class_key ^ (value_key + 0x9e3779b97f4a7c15ULL + (class_key << 6) + (class_key >> 2));
+      }
+
 
       bool is_filtered_apply_segment (cubstream::stream_position stream_entry_end) const
       {
@@ -333,6 +599,7 @@ namespace cubreplication
       stream_entry_fetcher m_entry_fetcher;
       log_consumer &m_lc;
       bool m_stop;
+      std::unordered_map<std::string, class_apply_info> m_class_scopes;
   };
 
   log_consumer::~log_consumer ()
@@ -362,6 +629,7 @@ namespace cubreplication
 			     m_applier_worker_threads_count,
 			     "replication_apply_workers",
 			     NULL, 1, 1);
+    m_max_dispatched_tasks = m_applier_worker_threads_count * APPLY_DISPATCHED_TASKS_PER_WORKER;
 
     m_use_daemons = true;
   }
@@ -400,6 +668,89 @@ namespace cubreplication
     push_task (task);
   }
 
+  void log_consumer::dispatch_task (applier_worker_task *task,
+				    const std::vector<apply_dependency_graph::key> &exclusive_keys,
+				    const std::vector<apply_dependency_graph::key> &shared_keys, bool is_barrier)
+  {
+    std::unique_lock<std::mutex> ulock (m_apply_mutex);
+    apply_dependency_graph::ticket ticket;
+    bool is_ready;
+    std::size_t waiting_count, dispatched_count;
+
+    /* limit memory of tasks not applied yet */
+    m_apply_cv.wait (ulock, [this] { return m_apply_graph.get_count () < m_max_dispatched_tasks; });
+
+    ticket = m_next_ticket++;
+    task->set_dispatched (ticket);
+    is_ready = m_apply_graph.add (ticket, exclusive_keys, shared_keys, is_barrier);
+    if (!is_ready)
+      {
+	m_waiting_tasks.emplace (ticket, task);
+      }
+    waiting_count = m_waiting_tasks.size ();
+    dispatched_count = m_apply_graph.get_count ();
+    ulock.unlock ();
+
+    perfmon_add_stat_to_global (PSTAT_REPL_APPLY_NUM_TRANS, 1);
+    if (is_barrier)
+      {
+	perfmon_add_stat_to_global (PSTAT_REPL_APPLY_NUM_BARRIER_TRANS, 1);
+      }
+    else if (!is_ready)
+      {
+	perfmon_add_stat_to_global (PSTAT_REPL_APPLY_NUM_DEPENDENT_TRANS, 1);
+      }
+    perfmon_set_stat_to_global (PSTAT_REPL_APPLY_PENDING_TRANS, (int) waiting_count);
+    perfmon_set_stat_to_global (PSTAT_REPL_APPLY_RUNNING_TRANS, (int) (dispatched_count - waiting_count));
+
+    if (is_ready)
+      {
+	execute_task (task);
+      }
+  }
+
+  void log_consumer::finish_task (applier_worker_task *task)
+  {
+    std::vector<apply_dependency_graph::ticket> ready_tickets;
+    std::vector<applier_worker_task *> ready_tasks;
+    std::size_t waiting_count, dispatched_count;
+
+    if (perfmon_is_perf_tracking ())
+      {
+	std::chrono::steady_clock::duration lag = std::chrono::steady_clock::now () - task->get_dispatch_time ();
+	perfmon_collect_latency (PERFMON_LATENCY_REPL_APPLY_LAG,
+				 std::chrono::duration_cast<std::chrono::microseconds> (lag).count ());
+      }
+
+    std::unique_lock<std::mutex> ulock (m_apply_mutex);
+    m_apply_graph.finish (task->get_ticket (), ready_tickets);
+    for (apply_dependency_graph::ticket ready : ready_tickets)
+      {
+	auto found = m_waiting_tasks.find (ready);
+	assert (found != m_waiting_tasks.end ());
+	ready_tasks.push_back (found->second);
+	m_waiting_tasks.erase (found);
+      }
+    waiting_count = m_waiting_tasks.size ();
+    dispatched_count = m_apply_graph.get_count ();
+    ulock.unlock ();
+    m_apply_cv.notify_all ();
+
+    perfmon_set_stat_to_global (PSTAT_REPL_APPLY_PENDING_TRANS, (int) waiting_count);
+    perfmon_set_stat_to_global (PSTAT_REPL_APPLY_RUNNING_TRANS, (int) (dispatched_count - waiting_count));
+
+    for (applier_worker_task *ready_task : ready_tasks)
+      {
+	execute_task (ready_task);
+      }
+  }
+
+  void log_consumer::wait_for_dispatched_tasks (void)
+  {
+    std::unique_lock<std::mutex> ulock (m_apply_mutex);
+    m_apply_cv.wait (ulock, [this] { return m_apply_graph.is_empty (); });
+  }
+
   void log_consumer::wait_for_tasks (void)
   {
     while (m_started_tasks > 0)
@@ -27,11 +27,14 @@
 #define _LOG_CONSUMER_HPP_
 
 #include "cubstream.hpp"
+#include "replication_apply_dependency.hpp"
 #include "semaphore.hpp"
 #include "stream_entry_fetcher.hpp"
 #include "thread_manager.hpp"
 #include <cstddef>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace cubthread
 {
@@ -65,11 +68,14 @@ namespace cubreplication
    *  - a dispatch daemon which extracts replication stream entry from stream and builds applier_worker_task
    *    objects; each applier_worker_task contains a list of stream_entries belonging to the same transaction;
    *    when a group commit special stream entry is encoutered by dispatch daemon, all gathered commited
-   *    applier_worker_task are pushed to a worker thread pool (m_applier_workers_pool);
+   *    applier_worker_task are dispatched in commit order (see dispatch_task);
    *    the remainder of applier_worker_task objects (not having coommit), are copied to next cycle (until next
    *    group commit) : see dispatch_daemon_task::execute;
-   *  - a thread pool for applying applier_worker_task; all replication stream entries are unpacked and then
-   *    each replication object from a stream entry is applied
+   *  - an apply dependency graph (m_apply_graph) : a dispatched task is pushed to worker thread pool
+   *    (m_applier_workers_pool) when all tasks dispatched before it and changing same rows have finished; tasks of
+   *    consecutive group commits do not wait for each other unless they conflict
+   *  - a thread pool for applying applier_worker_task; each replication object from the stream entries (already
+   *    unpacked by dispatch daemon) is applied
    */
   class log_consumer
   {
@@ -87,6 +93,14 @@ namespace cubreplication
 
       std::atomic<int> m_started_tasks;
 
+      /* dispatched tasks, ordered by changed data; m_apply_mutex protects graph and waiting tasks */
+      apply_dependency_graph m_apply_graph;
+      std::unordered_map<apply_dependency_graph::ticket, applier_worker_task *> m_waiting_tasks;
+      apply_dependency_graph::ticket m_next_ticket;
+      std::size_t m_max_dispatched_tasks;
+      std::mutex m_apply_mutex;
+      std::condition_variable m_apply_cv;
+
       /* fetch suspend flag : this is required in context of replication with copy phase :
        * while replication copy is running the fetch from online replication must be suspended
        * (although the stream contents are received and stored on local slave node)
@@ -109,6 +123,12 @@ namespace cubreplication
 	, m_subtran_applier (NULL)
 	, m_use_daemons (false)
 	, m_started_tasks (0)
+	, m_apply_graph ()
+	, m_waiting_tasks ()
+	, m_next_ticket (0)
+	, m_max_dispatched_tasks (0)
+	, m_apply_mutex ()
+	, m_apply_cv ()
 	, m_dispatch_finished (false)
 	, ack_produce ([] (cubstream::stream_position)
       {
@@ -127,6 +147,14 @@ namespace cubreplication
       void execute_task (applier_worker_task *task);
       void push_task (cubthread::entry_task *task);
 
+      /* dispatch committed task, in commit order; it is executed after the dispatched tasks it conflicts with */
+      void dispatch_task (applier_worker_task *task, const std::vector<apply_dependency_graph::key> &exclusive_keys,
+			  const std::vector<apply_dependency_graph::key> &shared_keys, bool is_barrier);
+      /* called by worker after task was applied */
+      void finish_task (applier_worker_task *task);
+      /* wait until all dispatched tasks are applied */
+      void wait_for_dispatched_tasks (void);
+
       void set_stream (cubstream::multi_thread_stream *stream)
       {
 	m_stream = stream;
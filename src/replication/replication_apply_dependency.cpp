@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// Replication apply dependencies - orders apply of replicated transactions that change the same data
+//
+
+#include "replication_apply_dependency.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace cubreplication
+{
+  static void
+  sort_unique (std::vector<apply_dependency_graph::key> &keys)
+  {
+    std::sort (keys.begin (), keys.end ());
+    keys.erase (std::unique (keys.begin (), keys.end ()), keys.end ());
+  }
+
+  apply_dependency_graph::apply_dependency_graph ()
+    : m_nodes ()
+    , m_key_holders ()
+    , m_last_barrier (0)
+    , m_has_barrier (false)
+  {
+  }
+
+  bool
+  apply_dependency_graph::add (ticket tran, const std::vector<key> &exclusive_keys,
+			       const std::vector<key> &shared_keys, bool is_barrier)
+  {
+    assert (m_nodes.find (tran) == m_nodes.end ());
+    node &tran_node = m_nodes[tran];
+
+    tran_node.m_wait_count = 0;
+
+    if (is_barrier)
+      {
+	// wait for everything before; everything after waits for barrier, so keys are not needed
+	for (auto &it : m_nodes)
+	  {
+	    if (it.first != tran)
+	      {
+		add_dependency (tran, tran_node, it.first);
+	      }
+	  }
+	m_last_barrier = tran;
+	m_has_barrier = true;
+
+	return tran_node.m_wait_count == 0;
+      }
+
+    if (m_has_barrier)
+      {
+	add_dependency (tran, tran_node, m_last_barrier);
+      }
+
+    tran_node.m_exclusive_keys = exclusive_keys;
+    sort_unique (tran_node.m_exclusive_keys);
+    for (key k : shared_keys)
+      {
+	if (!std::binary_search (tran_node.m_exclusive_keys.begin (), tran_node.m_exclusive_keys.end (), k))
+	  {
+	    tran_node.m_shared_keys.push_back (k);
+	  }
+      }
+    sort_unique (tran_node.m_shared_keys);
+
+    for (key k : tran_node.m_exclusive_keys)
+      {
+	add_exclusive_key (tran, tran_node, k);
+      }
+    for (key k : tran_node.m_shared_keys)
+      {
+	add_shared_key (tran, tran_node, k);
+      }
+
+    return tran_node.m_wait_count == 0;
+  }
+
+  void
+  apply_dependency_graph::add_exclusive_key (ticket tran, node &tran_node, key k)
+  {
+    key_holders &holders = m_key_holders[k];
+
+    if (!holders.m_shared.empty ())
+      {
+	// shared holders already wait for the exclusive one
+	for (ticket shared : holders.m_shared)
+	  {
+	    add_dependency (tran, tran_node, shared);
+	  }
+	holders.m_shared.clear ();
+      }
+    else if (holders.m_has_exclusive)
+      {
+	add_dependency (tran, tran_node, holders.m_exclusive);
+      }
+
+    holders.m_has_exclusive = true;
+    holders.m_exclusive = tran;
+  }
+
+  void
+  apply_dependency_graph::add_shared_key (ticket tran, node &tran_node, key k)
+  {
+    key_holders &holders = m_key_holders[k];
+
+    if (holders.m_has_exclusive)
+      {
+	add_dependency (tran, tran_node, holders.m_exclusive);
+      }
+    holders.m_shared.push_back (tran);
+  }
+
+  void
+  apply_dependency_graph::add_dependency (ticket tran, node &tran_node, ticket dependency)
+  {
+    node &dependency_node = m_nodes[dependency];
+
+    // several keys may lead to the same transaction; it is always the last one added to its list
+    if (!dependency_node.m_dependents.empty () && dependency_node.m_dependents.back () == tran)
+      {
+	return;
+      }
+    dependency_node.m_dependents.push_back (tran);
+    tran_node.m_wait_count++;
+  }
+
+  void
+  apply_dependency_graph::finish (ticket tran, std::vector<ticket> &ready)
+  {
+    auto found = m_nodes.find (tran);
+
+    assert (found != m_nodes.end ());
+    assert (found->second.m_wait_count == 0);
+
+    for (ticket dependent : found->second.m_dependents)
+      {
+	node &dependent_node = m_nodes[dependent];
+
+	assert (dependent_node.m_wait_count > 0);
+	if (--dependent_node.m_wait_count == 0)
+	  {
+	    ready.push_back (dependent);
+	  }
+      }
+
+    for (key k : found->second.m_exclusive_keys)
+      {
+	remove_key (tran, k);
+      }
+    for (key k : found->second.m_shared_keys)
+      {
+	remove_key (tran, k);
+      }
+
+    if (m_has_barrier && m_last_barrier == tran)
+      {
+	m_has_barrier = false;
+      }
+
+    m_nodes.erase (found);
+  }
+
+  void
+  apply_dependency_graph::remove_key (ticket tran, key k)
+  {
+    auto found = m_key_holders.find (k);
+
+    if (found == m_key_holders.end ())
+      {
+	assert (false);
+	return;
+      }
+
+    key_holders &holders = found->second;
+    if (holders.m_has_exclusive && holders.m_exclusive == tran)
+      {
+	holders.m_has_exclusive = false;
+      }
+    else
+      {
+	auto shared = std::find (holders.m_shared.begin (), holders.m_shared.end (), tran);
+	if (shared != holders.m_shared.end ())
+	  {
+	    holders.m_shared.erase (shared);
+	  }
+      }
+
+    if (!holders.m_has_exclusive && holders.m_shared.empty ())
+      {
+	m_key_holders.erase (found);
+      }
+  }
+
+  std::size_t
+  apply_dependency_graph::get_count () const
+  {
+    return m_nodes.size ();
+  }
+
+  bool
+  apply_dependency_graph::is_empty () const
+  {
+    return m_nodes.empty ();
+  }
+} // namespace cubreplication
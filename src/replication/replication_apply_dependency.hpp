@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// Replication apply dependencies - orders apply of replicated transactions that change the same data
+//
+//  Transactions are added in commit order, each with the keys of the data it changes. A key is either exclusive
+//  (e.g. hash of class name and primary key of a changed row) or shared (e.g. hash of class name of a changed row).
+//  A transaction may start when all transactions added before it and having one of its keys have finished, unless
+//  both have the key shared. Transactions without conflicting keys are applied concurrently.
+//
+//  A barrier transaction (e.g. one that changes the schema) waits for all transactions added before it, and all
+//  transactions added after it wait for the barrier.
+//
+//  How it works:
+//    - for each key, the last unfinished transaction having it exclusive is kept, with the unfinished transactions
+//      having it shared since. a new transaction with the key shared waits for the exclusive one; a new transaction
+//      with the key exclusive waits for the shared ones, or for the exclusive one if there are none. waited
+//      transactions already wait for the ones before them, so commit order is preserved for every conflict.
+//    - each transaction counts the transactions it waits for and keeps the list of transactions waiting for it.
+//      when it finishes, the waiting transactions that have no other dependency are returned as ready.
+//
+//  Keys are hashes; a collision only orders two transactions that could have been applied concurrently.
+//
+//  The class is not synchronized; its user must serialize calls.
+//
+
+#ifndef _REPLICATION_APPLY_DEPENDENCY_HPP_
+#define _REPLICATION_APPLY_DEPENDENCY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace cubreplication
+{
+  class apply_dependency_graph
+  {
+    public:
+      using ticket = std::uint64_t;     // identifier of transaction, given by user
+      using key = std::uint64_t;        // hash of changed data
+
+      apply_dependency_graph ();
+
+      // add transaction in commit order; returns true if it may start immediately
+      // a key found in both exclusive_keys and shared_keys is exclusive
+      bool add (ticket tran, const std::vector<key> &exclusive_keys, const std::vector<key> &shared_keys,
+		bool is_barrier);
+      // transaction was applied; transactions that may start now are appended to ready
+      void finish (ticket tran, std::vector<ticket> &ready);
+
+      // number of added and not finished transactions
+      std::size_t get_count () const;
+      bool is_empty () const;
+
+    private:
+      struct node
+      {
+	std::vector<key> m_exclusive_keys;
+	std::vector<key> m_shared_keys;
+	std::vector<ticket> m_dependents;     // transactions waiting for this one
+	std::size_t m_wait_count;             // number of transactions this one waits for
+      };
+
+      struct key_holders
+      {
+	bool m_has_exclusive;
+	ticket m_exclusive;                   // last unfinished transaction with key exclusive
+	std::vector<ticket> m_shared;         // unfinished transactions with key shared, added after m_exclusive
+      };
+
+      void add_dependency (ticket tran, node &tran_node, ticket dependency);
+      void add_exclusive_key (ticket tran, node &tran_node, key k);
+      void add_shared_key (ticket tran, node &tran_node, key k);
+      void remove_key (ticket tran, key k);
+
+      std::unordered_map<ticket, node> m_nodes;             // unfinished transactions
+      std::unordered_map<key, key_holders> m_key_holders;
+      ticket m_last_barrier;
+      bool m_has_barrier;                                   // true if m_last_barrier is not finished
+  };
+} // namespace cubreplication
+
+#endif // !_REPLICATION_APPLY_DEPENDENCY_HPP_
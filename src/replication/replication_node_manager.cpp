@@ -72,6 +72,8 @@ namespace cubreplication
 
       std::string replication_path = replication_node::get_replication_file_path ();
       g_stream_file = new cubstream::stream_file (*g_stream, replication_path);
+      g_stream_file->set_compression ((cubstream::compression_codec)
+				      prm_get_integer_value (PRM_ID_REPL_STREAM_FILE_COMPRESSION));
     }
 
     void finalize ()
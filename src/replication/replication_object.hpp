@@ -120,6 +120,21 @@ namespace cubreplication
       single_row_repl_entry (const repl_entry_type type, const char *class_name, const LOG_LSA &lsa_stamp);
       single_row_repl_entry () = default;
 
+      const std::string &get_class_name () const
+      {
+	return m_class_name;
+      }
+
+      const DB_VALUE &get_key_value () const
+      {
+	return m_key_value;
+      }
+
+      repl_entry_type get_type () const
+      {
+	return m_type;
+      }
+
     protected:
       virtual ~single_row_repl_entry ();
 
@@ -184,6 +199,11 @@ namespace cubreplication
       void stringify (string_buffer &str) override final;
       bool is_instance_changing_attr (const OID &inst_oid) override final;
 
+      const std::vector <int> &get_changed_attributes () const
+      {
+	return m_changed_attributes;
+      }
+
       inline bool compare_inst_oid (const OID &other)
       {
 	return (m_inst_oid.pageid == other.pageid && m_inst_oid.slotid == other.slotid
@@ -262,6 +282,11 @@ namespace cubreplication
 	return m_rec_des_list.size ();
       }
 
+      const std::string &get_class_name () const
+      {
+	return m_class_name;
+      }
+
     private:
       std::vector<record_descriptor> m_rec_des_list;
       std::string m_class_name;
@@ -701,6 +701,7 @@ struct btree_insert_helper
   int op_type;			/* Single-multi insert/modify operation type. */
   btree_unique_stats *unique_stats_info;	/* Unique statistics kept when operation type is not single. */
   int key_len_in_page;		/* Packed length of key being inserted. */
+  BTREE_INSERT_LEAF_HINT *leaf_hint;	/* Leaf of previous key, when keys are inserted in key order. Can be NULL. */
 
   PGBUF_LATCH_MODE nonleaf_latch_mode;	/* Default page latch mode while advancing through non-leaf nodes. */
 
@@ -753,6 +754,7 @@ struct btree_insert_helper
     0 /* op_type */, \
     NULL /* unique_stats_info */, \
     0 /* key_len_in_page */, \
+    NULL /* leaf_hint */, \
     PGBUF_LATCH_READ /* latch_mode */, \
     true /* is_first_try */, \
     false /* need_update_max_key_len */, \
@@ -785,6 +787,7 @@ struct btree_insert_helper
     0 /* op_type */, \
     NULL /* unique_stats_info */, \
     0 /* key_len_in_page */, \
+    NULL /* leaf_hint */, \
     PGBUF_LATCH_READ /* latch_mode */, \
     true /* is_first_try */, \
     false /* need_update_max_key_len */, \
@@ -1566,12 +1569,24 @@ static int btree_fk_object_does_exist (THREAD_ENTRY * thread_p, BTID_INT * btid_
 
 static int btree_insert_internal (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * class_oid, OID * oid,
 				  int op_type, btree_unique_stats * unique_stat_info, int *unique,
-				  BTREE_MVCC_INFO * mvcc_info, LOG_LSA * undo_nxlsa, BTREE_OP_PURPOSE purpose);
+				  BTREE_MVCC_INFO * mvcc_info, LOG_LSA * undo_nxlsa, BTREE_OP_PURPOSE purpose,
+				  BTREE_INSERT_LEAF_HINT * leaf_hint);
 static int btree_undo_delete_physical (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * class_oid, OID * oid,
 				       BTREE_MVCC_INFO * mvcc_info, LOG_LSA * undo_nxlsa);
 static int btree_fix_root_for_insert (THREAD_ENTRY * thread_p, BTID * btid, BTID_INT * btid_int, DB_VALUE * key,
 				      PAGE_PTR * root_page, bool * is_leaf, BTREE_SEARCH_KEY_HELPER * search_key,
 				      bool * stop, bool * restart, void *other_args);
+static int btree_fix_root_or_leaf_hint_for_insert (THREAD_ENTRY * thread_p, BTID * btid, BTID_INT * btid_int,
+						   DB_VALUE * key, PAGE_PTR * root_page, bool * is_leaf,
+						   BTREE_SEARCH_KEY_HELPER * search_key, bool * stop, bool * restart,
+						   void *other_args);
+static int btree_fix_leaf_hint_for_insert (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VALUE * key,
+					   BTREE_INSERT_HELPER * insert_helper, PAGE_PTR * leaf_page,
+					   BTREE_SEARCH_KEY_HELPER * search_key);
+static int btree_leaf_hint_search_key (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VALUE * key,
+				       BTREE_INSERT_HELPER * insert_helper, PAGE_PTR leaf_page,
+				       BTREE_SEARCH_KEY_HELPER * search_key, bool * is_key_in_page,
+				       bool * is_key_after_page);
 static int btree_split_node_and_advance (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VALUE * key,
 					 PAGE_PTR * crt_page, PAGE_PTR * advance_to_page, bool * is_leaf,
 					 BTREE_SEARCH_KEY_HELPER * search_key, bool * stop, bool * restart,
@@ -25863,7 +25878,7 @@ btree_undo_delete_physical (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key
 		     btid->vfid.fileid);
     }
   return btree_insert_internal (thread_p, btid, key, class_oid, oid, SINGLE_ROW_INSERT, NULL, NULL, mvcc_info,
-				undo_nxlsa, BTREE_OP_INSERT_UNDO_PHYSICAL_DELETE);
+				undo_nxlsa, BTREE_OP_INSERT_UNDO_PHYSICAL_DELETE, NULL);
 }
 
 /*
@@ -25883,6 +25898,35 @@ btree_undo_delete_physical (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key
 int
 btree_insert (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * cls_oid, OID * oid, int op_type,
 	      btree_unique_stats * unique_stat_info, int *unique, MVCC_REC_HEADER * p_mvcc_rec_header)
+{
+  return btree_insert_with_leaf_hint (thread_p, btid, key, cls_oid, oid, op_type, unique_stat_info, unique,
+				      p_mvcc_rec_header, NULL);
+}
+
+/*
+ * btree_insert_with_leaf_hint () - Insert new object into b-tree, starting with the leaf of previous key.
+ *
+ * return		  : Error code.
+ * thread_p (in)	  : Thread entry.
+ * btid (in)		  : B-tree identifier.
+ * key (in)		  : Key value.
+ * cls_oid (in)		  : Class OID.
+ * oid (in)		  : Instance OID.
+ * op_type (in)		  : Single-multi row operations.
+ * unique_stat_info (in)  : Statistics collector used multi row operations.
+ * unique (out)		  : Outputs if b-tree is unique when not NULL.
+ * p_mvcc_rec_header (in) : Heap MVCC record header.
+ * leaf_hint (in/out)	  : Leaf of previous key inserted in this b-tree; it is updated with the leaf of key. Can be
+ *			    NULL.
+ *
+ * NOTE: Keys inserted in key order usually belong to the leaf of previous key or to its next leaf. If the hinted leaf
+ *	 did not change since previous key was inserted and key fits in it, the traversal from root is skipped. Only
+ *	 non-unique indexes use the hint.
+ */
+int
+btree_insert_with_leaf_hint (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * cls_oid, OID * oid,
+			     int op_type, btree_unique_stats * unique_stat_info, int *unique,
+			     MVCC_REC_HEADER * p_mvcc_rec_header, BTREE_INSERT_LEAF_HINT * leaf_hint)
 {
   BTREE_MVCC_INFO mvcc_info = BTREE_MVCC_INFO_INITIALIZER;
 
@@ -25915,7 +25959,7 @@ btree_insert (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * cls_oi
   assert (!BTREE_MVCC_INFO_IS_DELID_VALID (&mvcc_info));
 
   return btree_insert_internal (thread_p, btid, key, cls_oid, oid, op_type, unique_stat_info, unique, &mvcc_info, NULL,
-				BTREE_OP_INSERT_NEW_OBJECT);
+				BTREE_OP_INSERT_NEW_OBJECT, leaf_hint);
 }
 
 /*
@@ -25961,7 +26005,7 @@ btree_mvcc_delete (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * c
   assert (BTREE_MVCC_INFO_IS_DELID_VALID (&mvcc_info));
 
   return btree_insert_internal (thread_p, btid, key, class_oid, oid, op_type, unique_stat_info, unique, &mvcc_info,
-				NULL, BTREE_OP_INSERT_MVCC_DELID);
+				NULL, BTREE_OP_INSERT_MVCC_DELID, NULL);
 }
 
 /*
@@ -25979,11 +26023,12 @@ btree_mvcc_delete (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * c
  * mvcc_info (in)	     : B-tree MVCC information.
  * undo_nxlsa (in)	     : UNDO next lsa for logical compensate.
  * purpose (in)		     : B-tree insert purpose
+ * leaf_hint (in/out)	     : Leaf of previous key inserted in key order. Can be NULL.
  */
 static int
 btree_insert_internal (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * class_oid, OID * oid, int op_type,
 		       btree_unique_stats * unique_stat_info, int *unique, BTREE_MVCC_INFO * mvcc_info,
-		       LOG_LSA * undo_nxlsa, BTREE_OP_PURPOSE purpose)
+		       LOG_LSA * undo_nxlsa, BTREE_OP_PURPOSE purpose, BTREE_INSERT_LEAF_HINT * leaf_hint)
 {
   int error_code = NO_ERROR;	/* Error code. */
   BTID_INT btid_int;		/* B-tree info. */
@@ -25993,10 +26038,15 @@ btree_insert_internal (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID
   BTREE_INSERT_HELPER insert_helper = BTREE_INSERT_HELPER_INITIALIZER;
   /* Processing key function: can insert an object or just a delete MVCCID. */
   BTREE_PROCESS_KEY_FUNCTION *key_insert_func = NULL;
+  /* Root function: can start with the hinted leaf. */
+  BTREE_ROOT_WITH_KEY_FUNCTION *root_func = btree_fix_root_for_insert;
+  /* Leaf of key, to update leaf hint. */
+  PAGE_PTR leaf_page = NULL;
 
   /* Assert expected arguments. */
   assert (btid != NULL);
   assert (oid != NULL);
+  assert (leaf_hint == NULL || purpose == BTREE_OP_INSERT_NEW_OBJECT);
   /* Assert class OID is valid or not required; not required for undo delete */
   assert (purpose == BTREE_OP_INSERT_UNDO_PHYSICAL_DELETE || (class_oid != NULL && !OID_ISNULL (class_oid)));
 
@@ -26056,13 +26106,33 @@ btree_insert_internal (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID
   /* Is HA enabled? The above exception will no longer apply. */
   insert_helper.is_ha_enabled = !HA_DISABLED ();
 
+  /* Set leaf hint. */
+  if (leaf_hint != NULL)
+    {
+      insert_helper.leaf_hint = leaf_hint;
+      root_func = btree_fix_root_or_leaf_hint_for_insert;
+    }
+
   /* Add more insert_helper initialization here. */
 
   /* Search for key leaf page and insert data. */
   error_code =
-    btree_search_key_and_apply_functions (thread_p, btid, &btid_int, key, btree_fix_root_for_insert, &insert_helper,
+    btree_search_key_and_apply_functions (thread_p, btid, &btid_int, key, root_func, &insert_helper,
 					  btree_split_node_and_advance, &insert_helper, key_insert_func, &insert_helper,
-					  &search_key, NULL);
+					  &search_key, leaf_hint != NULL ? &leaf_page : NULL);
+
+  if (leaf_page != NULL)
+    {
+      /* Next key starts with this leaf. Its LSA tells if the leaf changed meanwhile. */
+      assert (leaf_hint != NULL);
+      VPID_COPY (&leaf_hint->vpid, pgbuf_get_vpid_ptr (leaf_page));
+      LSA_COPY (&leaf_hint->lsa, pgbuf_get_lsa (leaf_page));
+      pgbuf_unfix_and_init (thread_p, leaf_page);
+    }
+  else if (leaf_hint != NULL && error_code != NO_ERROR)
+    {
+      VPID_SET_NULL (&leaf_hint->vpid);
+    }
 
   /* Free allocated resources. */
   if (insert_helper.printed_key != NULL)
@@ -26421,6 +26491,328 @@ error:
   return error_code;
 }
 
+/*
+ * btree_fix_root_or_leaf_hint_for_insert () - BTREE_ROOT_WITH_KEY_FUNCTION - fix root before inserting data in b-tree,
+ *					       or fix the hinted leaf if key belongs to it.
+ *
+ * return	       : Error code.
+ * thread_p (in)       : Thread entry.
+ * btid (in)	       : B-tree identifier.
+ * btid_int (out)      : BTID_INT (B-tree data).
+ * key (in)	       : Key value.
+ * root_page (out)     : Output b-tree root page, or the leaf page of key.
+ * is_leaf (out)       : Output true if output page is leaf page.
+ * search_key (out)    : Output key search result (if output page is leaf).
+ * stop (out)	       : Output true if advancing in b-tree should stop.
+ * restart (out)       : Output true if advancing in b-tree should be restarted.
+ * other_args (in/out) : BTREE_INSERT_HELPER *.
+ *
+ * NOTE: The hinted leaf is tried only on first try. A restart traverses b-tree from root.
+ */
+static int
+btree_fix_root_or_leaf_hint_for_insert (THREAD_ENTRY * thread_p, BTID * btid, BTID_INT * btid_int, DB_VALUE * key,
+					PAGE_PTR * root_page, bool * is_leaf, BTREE_SEARCH_KEY_HELPER * search_key,
+					bool * stop, bool * restart, void *other_args)
+{
+  BTREE_INSERT_HELPER *insert_helper = (BTREE_INSERT_HELPER *) other_args;
+  BTREE_NODE_HEADER *root_header = NULL;
+  PAGE_PTR leaf_page = NULL;
+  bool is_first_try = insert_helper->is_first_try;
+  int error_code;
+
+  assert (insert_helper->leaf_hint != NULL);
+
+  /* Root is fixed anyway; first try also loads b-tree info and does the additional operations. */
+  error_code =
+    btree_fix_root_for_insert (thread_p, btid, btid_int, key, root_page, is_leaf, search_key, stop, restart,
+			       other_args);
+  if (error_code != NO_ERROR || *stop || *restart || !is_first_try)
+    {
+      return error_code;
+    }
+  assert (*root_page != NULL);
+
+  if (insert_helper->purpose != BTREE_OP_INSERT_NEW_OBJECT || BTREE_IS_UNIQUE (btid_int->unique_pk)
+      || VPID_ISNULL (&insert_helper->leaf_hint->vpid))
+    {
+      /* Unique keys must be locked and checked as usual. */
+      return NO_ERROR;
+    }
+  root_header = btree_get_node_header (thread_p, *root_page);
+  if (root_header == NULL)
+    {
+      assert_release (false);
+      pgbuf_unfix_and_init (thread_p, *root_page);
+      return ER_FAILED;
+    }
+  if (root_header->node_level <= 1)
+    {
+      /* Root is the leaf. */
+      return NO_ERROR;
+    }
+
+  /* Leaves are fixed without holding root. */
+  pgbuf_unfix_and_init (thread_p, *root_page);
+
+  error_code = btree_fix_leaf_hint_for_insert (thread_p, btid_int, key, insert_helper, &leaf_page, search_key);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      return error_code;
+    }
+  if (leaf_page != NULL)
+    {
+      /* Skip traversal. */
+      *root_page = leaf_page;
+      *is_leaf = true;
+      insert_helper->is_root = false;
+      insert_helper->is_crt_node_write_latched = true;
+      return NO_ERROR;
+    }
+
+  /* Traverse b-tree from root. This is not the first try anymore, just root is fixed. */
+  assert (!insert_helper->is_first_try);
+  return btree_fix_root_for_insert (thread_p, btid, btid_int, key, root_page, is_leaf, search_key, stop, restart,
+				    other_args);
+}
+
+/*
+ * btree_fix_leaf_hint_for_insert () - Fix the hinted leaf, or its next leaf, if key can be inserted there without a
+ *				       split.
+ *
+ * return	       : Error code.
+ * thread_p (in)       : Thread entry.
+ * btid_int (in)       : B-tree info.
+ * key (in)	       : Key value.
+ * insert_helper (in)  : Insert helper.
+ * leaf_page (out)     : Write latched leaf page of key, or NULL if b-tree must be traversed from root.
+ * search_key (out)    : Output key search result in leaf page.
+ *
+ * NOTE: The hinted leaf is used only if its LSA did not change since previous key was inserted. Otherwise it may have
+ *	 been split, merged or even deallocated meanwhile.
+ *	 Next leaf is fixed while the hinted leaf is still fixed, left to right like range scans, and conditionally.
+ *	 Only one leaf to the right is tried; keys further away are found by traversing b-tree.
+ */
+static int
+btree_fix_leaf_hint_for_insert (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VALUE * key,
+				BTREE_INSERT_HELPER * insert_helper, PAGE_PTR * leaf_page,
+				BTREE_SEARCH_KEY_HELPER * search_key)
+{
+  BTREE_INSERT_LEAF_HINT *leaf_hint = insert_helper->leaf_hint;
+  BTREE_NODE_HEADER *node_header = NULL;
+  PAGE_PTR page = NULL;
+  PAGE_PTR next_page = NULL;
+  VPID next_vpid;
+  bool is_key_in_page = false;
+  bool is_key_after_page = false;
+  int error_code = NO_ERROR;
+
+  assert (leaf_page != NULL && *leaf_page == NULL);
+  assert (leaf_hint != NULL && !VPID_ISNULL (&leaf_hint->vpid));
+
+  page = pgbuf_fix (thread_p, &leaf_hint->vpid, OLD_PAGE_MAYBE_DEALLOCATED, PGBUF_LATCH_WRITE,
+		    PGBUF_UNCONDITIONAL_LATCH);
+  if (page == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error_code);
+      if (error_code != ER_PB_BAD_PAGEID)
+	{
+	  return error_code;
+	}
+      /* Leaf was deallocated. */
+      er_clear ();
+      VPID_SET_NULL (&leaf_hint->vpid);
+      return NO_ERROR;
+    }
+  if (!LSA_EQ (pgbuf_get_lsa (page), &leaf_hint->lsa))
+    {
+      /* Leaf changed. */
+      pgbuf_unfix_and_init (thread_p, page);
+      return NO_ERROR;
+    }
+  (void) pgbuf_check_page_ptype (thread_p, page, PAGE_BTREE);
+
+  error_code =
+    btree_leaf_hint_search_key (thread_p, btid_int, key, insert_helper, page, search_key, &is_key_in_page,
+				&is_key_after_page);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      goto exit;
+    }
+  if (is_key_in_page)
+    {
+      *leaf_page = page;
+      return NO_ERROR;
+    }
+  if (!is_key_after_page)
+    {
+      goto exit;
+    }
+
+  /* Try next leaf. */
+  node_header = btree_get_node_header (thread_p, page);
+  if (node_header == NULL)
+    {
+      assert_release (false);
+      error_code = ER_FAILED;
+      goto exit;
+    }
+  VPID_COPY (&next_vpid, &node_header->next_vpid);
+  assert (!VPID_ISNULL (&next_vpid));
+  next_page = pgbuf_fix (thread_p, &next_vpid, OLD_PAGE, PGBUF_LATCH_WRITE, PGBUF_CONDITIONAL_LATCH);
+  if (next_page == NULL)
+    {
+      /* Next leaf is busy. */
+      er_clear ();
+      goto exit;
+    }
+  pgbuf_unfix_and_init (thread_p, page);
+  (void) pgbuf_check_page_ptype (thread_p, next_page, PAGE_BTREE);
+
+  error_code =
+    btree_leaf_hint_search_key (thread_p, btid_int, key, insert_helper, next_page, search_key, &is_key_in_page,
+				&is_key_after_page);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      goto exit;
+    }
+  if (is_key_in_page)
+    {
+      *leaf_page = next_page;
+      return NO_ERROR;
+    }
+
+exit:
+  if (page != NULL)
+    {
+      pgbuf_unfix_and_init (thread_p, page);
+    }
+  if (next_page != NULL)
+    {
+      pgbuf_unfix_and_init (thread_p, next_page);
+    }
+  return error_code;
+}
+
+/*
+ * btree_leaf_hint_search_key () - Search key in a leaf that was not reached by traversing b-tree and check that key
+ *				   can be inserted in it.
+ *
+ * return		  : Error code.
+ * thread_p (in)	  : Thread entry.
+ * btid_int (in)	  : B-tree info.
+ * key (in)		  : Key value.
+ * insert_helper (in)	  : Insert helper.
+ * leaf_page (in)	  : Write latched leaf page.
+ * search_key (out)	  : Output key search result in leaf page.
+ * is_key_in_page (out)	  : Output true if key belongs to leaf and there is room to insert it.
+ * is_key_after_page (out) : Output true if key belongs to one of next leaves.
+ *
+ * NOTE: A traversal from root would have reached this leaf only if key is within leaf bounds: key is not smaller than
+ *	 the first key unless leaf is the first, and not bigger than the last key unless leaf is the last. The
+ *	 traversal also splits the leaf when there is no room for a new key; that case is left to the traversal too.
+ */
+static int
+btree_leaf_hint_search_key (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VALUE * key,
+			    BTREE_INSERT_HELPER * insert_helper, PAGE_PTR leaf_page,
+			    BTREE_SEARCH_KEY_HELPER * search_key, bool * is_key_in_page, bool * is_key_after_page)
+{
+  BTREE_NODE_HEADER *node_header = NULL;
+  int max_new_data_size;
+  int error_code;
+
+  *is_key_in_page = false;
+  *is_key_after_page = false;
+
+  node_header = btree_get_node_header (thread_p, leaf_page);
+  if (node_header == NULL)
+    {
+      assert_release (false);
+      return ER_FAILED;
+    }
+  if (node_header->node_level != 1 || btree_node_number_of_keys (thread_p, leaf_page) < 1)
+    {
+      return NO_ERROR;
+    }
+
+  /* Fence keys are compared here, before btree_search_leaf_page expects key to be between them. */
+  error_code = btree_leaf_is_key_between_min_max (thread_p, btid_int, leaf_page, key, search_key);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      return error_code;
+    }
+  switch (search_key->result)
+    {
+    case BTREE_KEY_FOUND:
+    case BTREE_KEY_BETWEEN:
+      break;
+    case BTREE_KEY_SMALLER:
+      if (!VPID_ISNULL (&node_header->prev_vpid))
+	{
+	  return NO_ERROR;
+	}
+      break;
+    case BTREE_KEY_BIGGER:
+      if (!VPID_ISNULL (&node_header->next_vpid))
+	{
+	  *is_key_after_page = true;
+	  return NO_ERROR;
+	}
+      break;
+    default:
+      return NO_ERROR;
+    }
+
+  error_code = btree_search_leaf_page (thread_p, btid_int, leaf_page, key, search_key);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      return error_code;
+    }
+  switch (search_key->result)
+    {
+    case BTREE_KEY_FOUND:
+    case BTREE_KEY_BETWEEN:
+      break;
+    case BTREE_KEY_SMALLER:
+      if (!VPID_ISNULL (&node_header->prev_vpid))
+	{
+	  return NO_ERROR;
+	}
+      break;
+    case BTREE_KEY_BIGGER:
+      if (!VPID_ISNULL (&node_header->next_vpid))
+	{
+	  *is_key_after_page = true;
+	  return NO_ERROR;
+	}
+      break;
+    default:
+      return NO_ERROR;
+    }
+
+  /* Same room check as btree_split_node_and_advance. */
+  if (insert_helper->key_len_in_page > node_header->max_key_len)
+    {
+      /* Max key length of ancestors must be updated too. */
+      return NO_ERROR;
+    }
+  max_new_data_size =
+    btree_get_max_new_data_size (thread_p, btid_int, leaf_page, BTREE_LEAF_NODE, node_header->max_key_len,
+				 insert_helper, false);
+  if (max_new_data_size > spage_get_free_space_without_saving (thread_p, leaf_page, NULL))
+    {
+      /* Leaf must be split. */
+      return NO_ERROR;
+    }
+
+  *is_key_in_page = true;
+  return NO_ERROR;
+}
+
 /*
  * btree_get_max_new_data_size () - Get new data size required based on node type and operation.
  *
@@ -29278,7 +29670,7 @@ btree_physical_delete (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID
       BTREE_MVCC_INFO_SET_DELID (&mvcc_info, tran_mvccid);
 
       return btree_insert_internal (thread_p, btid, key, class_oid, oid, op_type, unique_stat_info, unique, &mvcc_info,
-				    NULL, BTREE_OP_INSERT_MARK_DELETED);
+				    NULL, BTREE_OP_INSERT_MARK_DELETED, NULL);
     }
   else
     {
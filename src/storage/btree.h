@@ -532,6 +532,20 @@ struct btree_object_info
 #define BTREE_OBJECT_INFO_INITIALIZER \
   { OID_INITIALIZER, OID_INITIALIZER, BTREE_MVCC_INFO_INITIALIZER }
 
+/* BTREE_INSERT_LEAF_HINT -
+ * Leaf page of the previous key, kept by who inserts keys in key order.
+ * Next key is inserted in the same leaf, or in its next leaf, without
+ * traversing the b-tree, if the leaf did not change meanwhile.
+ */
+typedef struct btree_insert_leaf_hint BTREE_INSERT_LEAF_HINT;
+struct btree_insert_leaf_hint
+{
+  VPID vpid;			/* Leaf of previous key or NULL VPID. */
+  LOG_LSA lsa;			/* Leaf LSA after previous key was inserted. */
+};
+#define BTREE_INSERT_LEAF_HINT_INITIALIZER \
+  { VPID_INITIALIZER, LSA_INITIALIZER }
+
 /* BTREE_RANGE_SCAN_PROCESS_KEY_FUNC -
  * btree_range_scan internal function that is called for each key that passes
  * range/filter checks.
@@ -668,6 +682,9 @@ extern void btree_leaf_change_first_object (THREAD_ENTRY * thread_p, RECDES * re
 					    char **rv_undo_data_ptr, char **rv_redo_data_ptr);
 extern int btree_insert (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * cls_oid, OID * oid, int op_type,
 			 btree_unique_stats * unique_stat_info, int *unique, MVCC_REC_HEADER * p_mvcc_rec_header);
+extern int btree_insert_with_leaf_hint (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * cls_oid, OID * oid,
+					int op_type, btree_unique_stats * unique_stat_info, int *unique,
+					MVCC_REC_HEADER * p_mvcc_rec_header, BTREE_INSERT_LEAF_HINT * leaf_hint);
 extern int btree_mvcc_delete (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * class_oid, OID * oid,
 			      int op_type, btree_unique_stats * unique_stat_info, int *unique,
 			      MVCC_REC_HEADER * p_mvcc_rec_header);
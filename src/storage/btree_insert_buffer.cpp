@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// btree_insert_buffer - buffer the keys inserted by a statement and insert them into each index in key order
+//
+
+#include "btree_insert_buffer.hpp"
+
+#include "btree.h"
+#include "btree_unique.hpp"
+#include "error_manager.h"
+#include "log_impl.h"
+#include "object_primitive.h"
+
+#include <algorithm>
+
+btree_insert_buffer::btree_insert_buffer (std::size_t max_keys)
+  : m_indexes ()
+  , m_key_count (0)
+  , m_max_keys (max_keys)
+{
+}
+
+btree_insert_buffer::~btree_insert_buffer ()
+{
+  clear ();
+}
+
+void
+btree_insert_buffer::add_key (const BTID &btid, const DB_VALUE &key, const OID &class_oid, const OID &oid,
+			      bool use_mvcc)
+{
+  index_keys &index = get_index_keys (btid, use_mvcc);
+  key_entry entry;
+
+  (void) pr_clone_value (&key, &entry.m_key);
+  entry.m_class_oid = class_oid;
+  entry.m_oid = oid;
+
+  index.m_entries.push_back (entry);
+  m_key_count++;
+}
+
+bool
+btree_insert_buffer::is_full () const
+{
+  return m_key_count >= m_max_keys;
+}
+
+bool
+btree_insert_buffer::empty () const
+{
+  return m_key_count == 0;
+}
+
+int
+btree_insert_buffer::flush (THREAD_ENTRY *thread_p, int op_type, multi_index_unique_stats *unique_stats)
+{
+  int error_code = NO_ERROR;
+
+  for (index_keys &index : m_indexes)
+    {
+      error_code = flush_index (thread_p, index, op_type, unique_stats);
+      if (error_code != NO_ERROR)
+	{
+	  // the statement fails; the keys already inserted are rolled back with it
+	  break;
+	}
+    }
+
+  clear ();
+  return error_code;
+}
+
+void
+btree_insert_buffer::clear ()
+{
+  for (index_keys &index : m_indexes)
+    {
+      for (key_entry &entry : index.m_entries)
+	{
+	  pr_clear_value (&entry.m_key);
+	}
+    }
+  m_indexes.clear ();
+  m_key_count = 0;
+}
+
+btree_insert_buffer::index_keys &
+btree_insert_buffer::get_index_keys (const BTID &btid, bool use_mvcc)
+{
+  for (index_keys &index : m_indexes)
+    {
+      if (BTID_IS_EQUAL (&index.m_btid, &btid))
+	{
+	  assert (index.m_use_mvcc == use_mvcc);
+	  return index;
+	}
+    }
+
+  m_indexes.emplace_back ();
+  m_indexes.back ().m_btid = btid;
+  m_indexes.back ().m_use_mvcc = use_mvcc;
+  return m_indexes.back ();
+}
+
+int
+btree_insert_buffer::flush_index (THREAD_ENTRY *thread_p, index_keys &index, int op_type,
+				  multi_index_unique_stats *unique_stats)
+{
+  TP_DOMAIN *key_type = NULL;
+  btree_unique_stats *unique_stat_info = NULL;
+  MVCC_REC_HEADER mvcc_rec_header[2];
+  MVCC_REC_HEADER *p_mvcc_rec_header = NULL;
+  MVCCID mvccid;
+  BTREE_INSERT_LEAF_HINT leaf_hint = BTREE_INSERT_LEAF_HINT_INITIALIZER;
+  int unique;
+  int error_code = NO_ERROR;
+
+  error_code = xbtree_get_key_type (thread_p, index.m_btid, &key_type);
+  if (error_code != NO_ERROR)
+    {
+      return error_code;
+    }
+
+  // null keys first; they are not stored in the index, only counted
+  auto key_less = [key_type] (const key_entry & a, const key_entry & b)
+  {
+    DB_VALUE *a_key = const_cast<DB_VALUE *> (&a.m_key);
+    DB_VALUE *b_key = const_cast<DB_VALUE *> (&b.m_key);
+    bool a_is_null = DB_IS_NULL (a_key) || btree_multicol_key_is_null (a_key);
+    bool b_is_null = DB_IS_NULL (b_key) || btree_multicol_key_is_null (b_key);
+
+    if (a_is_null || b_is_null)
+      {
+	return a_is_null && !b_is_null;
+      }
+    return btree_compare_key (a_key, b_key, key_type, 1, 1, NULL) == DB_LT;
+  };
+  // stable sort keeps the order of rows for equal keys
+  std::stable_sort (index.m_entries.begin (), index.m_entries.end (), key_less);
+
+  if (index.m_use_mvcc)
+    {
+      mvccid = logtb_get_current_mvccid (thread_p);
+      btree_set_mvcc_header_ids_for_update (thread_p, false, true, &mvccid, mvcc_rec_header);
+      p_mvcc_rec_header = mvcc_rec_header;
+    }
+  if (unique_stats != NULL)
+    {
+      unique_stat_info = &unique_stats->get_stats_of (index.m_btid);
+    }
+
+  // each key starts with the leaf of the previous one
+  for (key_entry &entry : index.m_entries)
+    {
+      error_code = btree_insert_with_leaf_hint (thread_p, &index.m_btid, &entry.m_key, &entry.m_class_oid,
+						&entry.m_oid, op_type, unique_stat_info, &unique, p_mvcc_rec_header,
+						&leaf_hint);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  return error_code;
+	}
+    }
+
+  return NO_ERROR;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// btree_insert_buffer - buffer the keys inserted by a statement and insert them into each index in key order
+//
+//  how it works:
+//    instead of inserting the keys of each new row into the indexes right after the row is inserted in heap, keys are
+//    collected per index. when the buffer is full or when the statement ends, the keys of each index are sorted and
+//    inserted in key order. consecutive keys go to the same leaf page, or to its right neighbour: each key is inserted
+//    with btree_insert_with_leaf_hint, which starts with the leaf of the previous key and walks to the next leaf if
+//    needed, instead of descending from root. the b-tree is traversed only when that leaf changed meanwhile, when it
+//    must be split or when the key is further away.
+//
+//    each key is inserted under the same statement system operation, with the same locks, MVCC info and logging. the
+//    only difference is the time when the key is inserted, so the buffer is only used by statements that do not look
+//    up the index of the rows they insert: no REPLACE or ON DUPLICATE KEY UPDATE, no foreign keys and no indexes being
+//    loaded online. only keys of non-unique indexes are buffered; unique keys are inserted with the row, so a unique
+//    violation is reported for the row that caused it.
+//
+//    client flushes that only insert objects of one class (loaddb flushes them this way) are buffered too, unless
+//    each object has its own error handling.
+//
+
+#ifndef _BTREE_INSERT_BUFFER_HPP_
+#define _BTREE_INSERT_BUFFER_HPP_
+
+#if !defined (SERVER_MODE) && !defined (SA_MODE)
+#error Belongs to server module
+#endif /* !defined (SERVER_MODE) && !defined (SA_MODE) */
+
+#include "dbtype_def.h"
+#include "storage_common.h"
+#include "thread_compat.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// forward definitions
+class multi_index_unique_stats;
+
+class btree_insert_buffer
+{
+  public:
+    btree_insert_buffer (std::size_t max_keys);
+    btree_insert_buffer (const btree_insert_buffer &) = delete;
+    btree_insert_buffer &operator= (const btree_insert_buffer &) = delete;
+    ~btree_insert_buffer ();
+
+    // add a key to insert into index; key is copied
+    void add_key (const BTID &btid, const DB_VALUE &key, const OID &class_oid, const OID &oid, bool use_mvcc);
+    bool is_full () const;
+    bool empty () const;
+
+    // insert all buffered keys, in key order of each index; the buffer is empty after
+    int flush (THREAD_ENTRY *thread_p, int op_type, multi_index_unique_stats *unique_stats);
+    // discard all buffered keys
+    void clear ();
+
+  private:
+    struct key_entry
+    {
+      DB_VALUE m_key;
+      OID m_class_oid;
+      OID m_oid;
+    };
+
+    struct index_keys
+    {
+      BTID m_btid;
+      bool m_use_mvcc;
+      std::vector<key_entry> m_entries;
+    };
+
+    index_keys &get_index_keys (const BTID &btid, bool use_mvcc);
+    int flush_index (THREAD_ENTRY *thread_p, index_keys &index, int op_type, multi_index_unique_stats *unique_stats);
+
+    std::vector<index_keys> m_indexes;	// one per index of the class; few, so searched linearly
+    std::size_t m_key_count;
+    std::size_t m_max_keys;
+};
+
+#endif // _BTREE_INSERT_BUFFER_HPP_
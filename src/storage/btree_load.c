@@ -52,6 +52,34 @@
 #include "xserver_interface.h"
 #include "xasl.h"
 #include "xasl_unpack_info.hpp"
+#if defined (SERVER_MODE)
+#include "server_support.h"
+#include "thread_task_group.hpp"
+#endif /* SERVER_MODE */
+
+#if defined (SERVER_MODE)
+#include <functional>
+#endif /* SERVER_MODE */
+
+#if defined (SERVER_MODE)
+/* Minimum number of heap pages for each participant of a parallel heap extraction. */
+#define BTREE_LOAD_PX_MIN_PAGES 64
+/* Number of chunks of heap pages for each participant; a participant claims a chunk at a time. */
+#define BTREE_LOAD_PX_CHUNKS_PER_PARTICIPANT 4
+/* Size of the batches of sort records passed by extraction workers to the loading thread. */
+#define BTREE_LOAD_PX_BATCH_SIZE (256 * 1024)
+/* Maximum number of batches queued for each extraction worker. */
+#define BTREE_LOAD_PX_BATCHES_PER_WORKER 4
+/* Size of the ranges of sort items whose leaves are built by one task of a parallel leaf build. */
+#define BTREE_LOAD_RANGE_SIZE (1024 * 1024)
+/* Maximum number of ranges queued for each worker of a parallel leaf build. */
+#define BTREE_LOAD_RANGES_PER_WORKER 2
+#endif /* SERVER_MODE */
+
+typedef struct btree_load_pages BTREE_LOAD_PAGES;
+typedef struct btree_load_px BTREE_LOAD_PX;
+typedef struct btree_load_range BTREE_LOAD_RANGE;
+typedef struct btree_load_leaves BTREE_LOAD_LEAVES;
 
 typedef struct sort_args SORT_ARGS;
 struct sort_args
@@ -85,6 +113,8 @@ struct sort_args
   FUNCTION_INDEX_INFO *func_index_info;
 
   MVCCID lowest_active_mvccid;
+
+  BTREE_LOAD_PX *px;		/* not NULL for the extraction workers of a parallel load */
 };
 
 typedef struct btree_page BTREE_PAGE;
@@ -137,6 +167,10 @@ struct load_args
   PGSLOTID last_leaf_insert_slotid;	/* Slotid of last inserted leaf record. */
 
   VPID vpid_first_leaf;
+
+#if defined (SERVER_MODE)
+  BTREE_LOAD_RANGE *range;	/* Not NULL when the leaves of a range of a parallel leaf build are built. */
+#endif				/* SERVER_MODE */
 };
 
 typedef struct btree_scan_partition_info BTREE_SCAN_PART;
@@ -158,11 +192,57 @@ struct btree_scan_partition_info
   BTID btid;			/* BTID of the current partition. */
 };
 
+#if defined (SERVER_MODE)
+struct btree_load_pages
+{				/* Heap pages of a parallel extraction, split in chunks claimed by the participants. */
+  VPID *pages;			/* Pages of all heap files, grouped by class and sorted by VPID for each class. */
+  int *class_pages;		/* Index in pages of the first page of each class; n_classes + 1 entries. */
+  int n_classes;
+  int n_pages;
+  int chunk_size;
+  int next_page;		/* First page not claimed yet. */
+  int claim_class;		/* Class of next_page. */
+  pthread_mutex_t mutex;
+};
+
+typedef struct btree_load_batch BTREE_LOAD_BATCH;
+struct btree_load_batch
+{				/* Sort records extracted by a worker; each record is preceded by its length. */
+  BTREE_LOAD_BATCH *next;
+  char *area;
+  int area_size;
+  int length;			/* Bytes used in area. */
+  int pos;			/* Read position of the loading thread. */
+};
+
+struct btree_load_range
+{				/* Sort items of consecutive keys and the leaves built of them; a key never spans two ranges. */
+  BTREE_LOAD_RANGE *next;
+  char *area;			/* Sort items, each one preceded by its length; freed when the leaves are built. */
+  int area_size;
+  int length;			/* Bytes used in area. */
+  int last_item;		/* Offset in area of the last sort item. */
+  bool has_overflow_key;	/* Some key may need the overflow key file; the loading thread builds the range. */
+  BTID_INT btid_int;		/* Copy of the index for the worker. */
+
+  VPID first_leaf;		/* The leaves of the range are linked to each other, not to the other ranges. */
+  VPID last_leaf;
+  int n_keys;
+  char *vacuum_data;		/* Undo data of RVBT_MVCC_NOTIFY_VACUUM records, each one preceded by its length. They are
+				 * logged by the loading thread, on behalf of its transaction. */
+  int vacuum_data_size;
+  int vacuum_data_length;
+  int error_code;
+  OR_ALIGNED_BUF (1024) error_area;
+};
+#endif /* SERVER_MODE */
+
 // *INDENT-OFF*
 class index_builder_loader_context : public cubthread::entry_manager
 {
   public:
     std::atomic_bool m_has_error;
+    std::atomic<std::uint64_t> m_tasks_started;
     std::atomic<std::uint64_t> m_tasks_executed;
     int m_error_code;
     const TP_DOMAIN* m_key_type;
@@ -213,6 +293,63 @@ class index_builder_loader_task: public cubthread::entry_task
     void clear_keys ();
 };
 
+#if defined (SERVER_MODE)
+struct btree_load_px
+{				/* Parallel extraction of index keys from heap files. */
+  int tran_index;		/* Workers work on behalf of the loading transaction. */
+  BTREE_LOAD_PAGES pages;
+  char *pred_stream;		/* Each worker unpacks its own filter predicate... */
+  int pred_stream_size;
+  FUNCTION_INDEX_INFO *func_index_info;	/* ... and its own function index expression. */
+
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  int ref_count;		/* The loading thread and the pushed workers; the last one frees px. */
+  bool is_closed;		/* Workers that did not start yet must exit without working. */
+  int n_running;		/* Started workers not finished yet. */
+  bool stop;			/* Workers must stop. */
+  bool has_error;
+  OR_ALIGNED_BUF (1024) error_area;	/* First error of a worker. */
+
+  /* Offline load: workers produce sort records for the loading thread. */
+  SORT_ARGS *sort_args;		/* Sort arguments of the loading thread. */
+  SORT_ARGS worker_args;	/* Copied by the workers; the loading thread changes its own. */
+  bool loader_started;		/* The loading thread extracts chunks no worker has claimed... */
+  bool loader_done;		/* ... until all chunks are claimed. */
+  BTREE_LOAD_BATCH *batch_head;	/* Queue of full batches. */
+  BTREE_LOAD_BATCH *batch_tail;
+  int n_batches;
+  int max_batches;
+  BTREE_LOAD_BATCH *curr_batch;	/* Batch consumed by the loading thread. */
+  int n_oids;			/* Statistics of the workers. */
+  int n_nulls;
+
+  /* Online load: workers dispatch the keys to the loader pool themselves. */
+  BTID_INT *btid_int;
+  HFID *hfid;
+  OID *class_oid;
+  int *attrids;
+  int n_attrs;
+  int *attrs_prefix_length;
+  MVCC_SNAPSHOT *snapshot;
+  int unique_pk;
+  index_builder_loader_context *load_context;
+  cubthread::entry_workpool *ib_workpool;
+};
+
+using btree_load_task_group = cubthread::task_group<cubthread::entry>;
+
+struct btree_load_leaves
+{				/* Parallel build of the leaf level from ranges of the sort output. */
+  THREAD_ENTRY *loader;		/* The loading thread. */
+  LOAD_ARGS *load_args;		/* Of the loading thread; it links the leaves of all ranges. */
+  int degree;
+  BTREE_LOAD_RANGE *range_head;	/* Ranges in the order of the keys. */
+  BTREE_LOAD_RANGE *range_tail;	/* The range filled by the loading thread. */
+  btree_load_task_group *group;
+};
+#endif /* SERVER_MODE */
+
 // *INDENT-ON*
 
 
@@ -233,8 +370,48 @@ static int btree_get_value_from_leaf_slot (THREAD_ENTRY * thread_p, BTID_INT * b
 #if defined(CUBRID_DEBUG)
 static int btree_dump_sort_output (const RECDES * recdes, LOAD_ARGS * load_args);
 #endif /* defined(CUBRID_DEBUG) */
-static int btree_index_sort (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args, SORT_PUT_FUNC * out_func, void *out_args);
+static int btree_index_sort (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args, BTREE_LOAD_PX * px,
+			     SORT_PUT_FUNC * out_func, void *out_args);
 static SORT_STATUS btree_sort_get_next (THREAD_ENTRY * thread_p, RECDES * temp_recdes, void *arg);
+#if defined (SERVER_MODE)
+static int btree_load_pages_collect (THREAD_ENTRY * thread_p, HFID * hfids, int n_classes, int *degree,
+				     BTREE_LOAD_PAGES * pages);
+static bool btree_load_pages_claim (BTREE_LOAD_PAGES * pages, int *cur_class, int *first_page, int *n_pages);
+static void btree_load_pages_stop (BTREE_LOAD_PAGES * pages);
+static void btree_load_pages_free (BTREE_LOAD_PAGES * pages);
+static int btree_load_px_init (THREAD_ENTRY * thread_p, BTREE_LOAD_PX * px, HFID * hfids, int n_classes,
+			       char *pred_stream, int pred_stream_size, FUNCTION_INDEX_INFO * func_index_info,
+			       int *degree);
+static void btree_load_px_set_error (BTREE_LOAD_PX * px);
+static bool btree_load_px_enter (BTREE_LOAD_PX * px);
+static void btree_load_px_leave (BTREE_LOAD_PX * px);
+static void btree_load_px_wait_workers (BTREE_LOAD_PX * px);
+static void btree_load_px_release (BTREE_LOAD_PX * px);
+static void btree_load_px_destroy (BTREE_LOAD_PX * px);
+static int btree_sort_px_start (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args, char *pred_stream,
+				int pred_stream_size, BTREE_LOAD_PX ** px_out);
+static void btree_sort_px_end (THREAD_ENTRY * thread_p, BTREE_LOAD_PX * px, SORT_ARGS * sort_args, bool is_success);
+static SORT_STATUS btree_sort_px_next_chunk (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args);
+static void btree_sort_px_end_scan (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args);
+static bool btree_sort_px_publish (BTREE_LOAD_PX * px, BTREE_LOAD_BATCH * batch);
+static BTREE_LOAD_BATCH *btree_sort_px_alloc_batch (int area_size);
+static void btree_sort_px_free_batch (BTREE_LOAD_BATCH * batch);
+static SORT_STATUS btree_sort_px_extract (THREAD_ENTRY * thread_p, RECDES * temp_recdes, BTREE_LOAD_PX * px);
+static SORT_STATUS btree_sort_px_get_next (THREAD_ENTRY * thread_p, RECDES * temp_recdes, void *arg);
+static int btree_load_leaves_start (THREAD_ENTRY * thread_p, LOAD_ARGS * load_args, BTREE_LOAD_LEAVES ** leaves_out);
+static int btree_load_leaves_end (THREAD_ENTRY * thread_p, BTREE_LOAD_LEAVES * leaves, bool is_success);
+static int btree_load_leaves_put (THREAD_ENTRY * thread_p, const RECDES * in_recdes, void *arg);
+static int btree_load_leaves_close_range (THREAD_ENTRY * thread_p, BTREE_LOAD_LEAVES * leaves, bool is_last);
+static int btree_load_leaves_link (THREAD_ENTRY * thread_p, BTREE_LOAD_LEAVES * leaves);
+static int btree_load_link_pages (THREAD_ENTRY * thread_p, BTID_INT * btid, VPID * prev_vpid, VPID * next_vpid);
+static BTREE_LOAD_RANGE *btree_load_range_alloc (BTID_INT * btid);
+static void btree_load_range_free (BTREE_LOAD_RANGE * range);
+static int btree_load_range_add_item (BTREE_LOAD_RANGE * range, char *item, int length);
+static int btree_load_range_save_vacuum_data (BTREE_LOAD_RANGE * range, char *data, int length);
+static int btree_load_range_build (THREAD_ENTRY * thread_p, BTREE_LOAD_LEAVES * leaves, BTREE_LOAD_RANGE * range,
+				   BTID_INT * btid);
+static int btree_load_read_sort_key (BTID_INT * btid, char *item, int length, DB_VALUE * key);
+#endif /* SERVER_MODE */
 static int compare_driver (const void *first, const void *second, void *arg);
 static int list_add (BTREE_NODE ** list, VPID * pageid);
 static void list_remove_first (BTREE_NODE ** list);
@@ -258,9 +435,24 @@ static int online_index_builder (THREAD_ENTRY * thread_p, BTID_INT * btid_int, H
 				 int n_classes, int *attrids, int n_attrs, FUNCTION_INDEX_INFO func_idx_info,
 				 PRED_EXPR_WITH_CONTEXT * filter_pred, int *attrs_prefix_length,
 				 HEAP_CACHE_ATTRINFO * attr_info, HEAP_SCANCACHE * scancache, int unique_pk,
-				 int ib_thread_count, const TP_DOMAIN * key_type);
+				 int ib_thread_count, const TP_DOMAIN * key_type, char *pred_stream, int pred_stream_size);
 static bool btree_is_worker_pool_logging_true ();
 
+// *INDENT-OFF*
+static int online_index_builder_extract (THREAD_ENTRY * thread_p, BTID_INT * btid_int, HFID * hfid, OID * class_oid,
+                                         int *attrids, int n_attrs, FUNCTION_INDEX_INFO * func_idx_info,
+                                         PRED_EXPR_WITH_CONTEXT * filter_pred, int *attrs_prefix_length,
+                                         HEAP_CACHE_ATTRINFO * attr_info, HEAP_SCANCACHE * scancache, int unique_pk,
+                                         index_builder_loader_context & load_context,
+                                         cubthread::entry_workpool * ib_workpool, BTREE_LOAD_PAGES * pages);
+#if defined (SERVER_MODE)
+static void btree_sort_px_execute (cubthread::entry & thread_ref, BTREE_LOAD_PX * px);
+static void online_index_builder_px_execute (cubthread::entry & thread_ref, BTREE_LOAD_PX * px);
+static void btree_load_range_execute (cubthread::entry & thread_ref, BTREE_LOAD_LEAVES * leaves,
+                                      BTREE_LOAD_RANGE * range);
+#endif /* SERVER_MODE */
+// *INDENT-ON*
+
 /*
  * btree_get_node_header () -
  *
@@ -719,7 +911,13 @@ xbtree_load_index (THREAD_ENTRY * thread_p, BTID * btid, const char *bt_name, TP
   LOG_TDES *tdes = NULL;
   SORT_ARGS sort_args_info, *sort_args;
   LOAD_ARGS load_args_info, *load_args;
+  BTREE_LOAD_PX *px = NULL;
+#if defined (SERVER_MODE)
+  BTREE_LOAD_LEAVES *leaves = NULL;
+  int leaves_ret;
+#endif /* SERVER_MODE */
   int cur_class, attr_offset;
+  int ret;
   VPID root_vpid;
   BTID_INT btid_int;
   PRED_EXPR_WITH_CONTEXT *filter_pred = NULL;
@@ -809,6 +1007,7 @@ xbtree_load_index (THREAD_ENTRY * thread_p, BTID * btid, const char *bt_name, TP
   sort_args->fk_refcls_oid = fk_refcls_oid;
   sort_args->fk_refcls_pk_btid = fk_refcls_pk_btid;
   sort_args->fk_name = fk_name;
+  sort_args->px = NULL;
   if (pred_stream && pred_stream_size > 0)
     {
       if (stx_map_stream_to_filter_pred (thread_p, &filter_pred, pred_stream, pred_stream_size) != NO_ERROR)
@@ -909,6 +1108,10 @@ xbtree_load_index (THREAD_ENTRY * thread_p, BTID * btid, const char *bt_name, TP
   load_args->ovf.pgptr = NULL;
   load_args->n_keys = 0;
   load_args->curr_non_del_obj_count = 0;
+  VPID_SET_NULL (&load_args->vpid_first_leaf);
+#if defined (SERVER_MODE)
+  load_args->range = NULL;
+#endif /* SERVER_MODE */
 
   load_args->leaf_nleaf_recdes.area_size = BTREE_MAX_KEYLEN_INPAGE + BTREE_MAX_OIDLEN_INPAGE;
   load_args->leaf_nleaf_recdes.length = 0;
@@ -943,8 +1146,50 @@ xbtree_load_index (THREAD_ENTRY * thread_p, BTID * btid, const char *bt_name, TP
 		     sort_args->btid->sys_btid->vfid.volid, sort_args->btid->sys_btid->vfid.fileid);
     }
 
-  /* Build the leaf pages of the btree as the output of the sort. We do not estimate the number of pages required. */
-  if (btree_index_sort (thread_p, sort_args, btree_construct_leafs, load_args) != NO_ERROR)
+#if defined (SERVER_MODE)
+  /* Extract the keys from heap in parallel if the heap files are large enough. */
+  if (btree_sort_px_start (thread_p, sort_args, pred_stream, pred_stream_size, &px) != NO_ERROR)
+    {
+      goto error;
+    }
+#endif /* SERVER_MODE */
+
+#if defined (SERVER_MODE)
+  /* Build the leaves of ranges of the sort output in parallel, if requested. */
+  if (btree_load_leaves_start (thread_p, load_args, &leaves) != NO_ERROR)
+    {
+      if (px != NULL)
+	{
+	  btree_sort_px_end (thread_p, px, sort_args, false);
+	  px = NULL;
+	}
+      goto error;
+    }
+  if (leaves != NULL)
+    {
+      ret = btree_index_sort (thread_p, sort_args, px, btree_load_leaves_put, leaves);
+      leaves_ret = btree_load_leaves_end (thread_p, leaves, ret == NO_ERROR);
+      leaves = NULL;
+      if (ret == NO_ERROR)
+	{
+	  ret = leaves_ret;
+	}
+    }
+  else
+#endif /* SERVER_MODE */
+    {
+      /* Build the leaf pages of the btree as the output of the sort. We do not estimate the number of pages
+       * required. */
+      ret = btree_index_sort (thread_p, sort_args, px, btree_construct_leafs, load_args);
+    }
+#if defined (SERVER_MODE)
+  if (px != NULL)
+    {
+      btree_sort_px_end (thread_p, px, sort_args, ret == NO_ERROR);
+      px = NULL;
+    }
+#endif /* SERVER_MODE */
+  if (ret != NO_ERROR)
     {
       goto error;
     }
@@ -976,11 +1221,10 @@ xbtree_load_index (THREAD_ENTRY * thread_p, BTID * btid, const char *bt_name, TP
   sort_args->scancache_inited = 0;
 
   /* Just to make sure that there were entries to put into the tree */
-  if (load_args->leaf.pgptr != NULL)
+  if (!VPID_ISNULL (&load_args->vpid_first_leaf))
     {
-      /* Save the last leaf record */
-
-      if (btree_save_last_leafrec (thread_p, load_args) != NO_ERROR)
+      /* Save the last leaf record; a parallel leaf build saved the last record of each range already. */
+      if (load_args->leaf.pgptr != NULL && btree_save_last_leafrec (thread_p, load_args) != NO_ERROR)
 	{
 	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_BTREE_LOAD_FAILED, 0);
 	  goto error;
@@ -2166,6 +2410,15 @@ btree_first_oid (THREAD_ENTRY * thread_p, DB_VALUE * this_key, OID * class_oid,
   else
     {
       key_type = BTREE_OVERFLOW_KEY;
+#if defined (SERVER_MODE)
+      if (load_args->range != NULL && !load_args->range->has_overflow_key)
+	{
+	  /* only the loading thread may create and fill the overflow key file */
+	  assert_release (false);
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_GENERIC_ERROR, 0);
+	  return ER_GENERIC_ERROR;
+	}
+#endif /* SERVER_MODE */
       if (VFID_ISNULL (&load_args->btid->ovfid))
 	{
 	  error = btree_create_overflow_key_file (thread_p, load_args->btid);
@@ -2249,8 +2502,12 @@ btree_construct_leafs (THREAD_ENTRY * thread_p, const RECDES * in_recdes, void *
   load_args = (LOAD_ARGS *) arg;
 
 #if defined (SERVER_MODE)
-  /* Make sure MVCCID for current transaction is generated. */
-  (void) logtb_get_current_mvccid (thread_p);
+  /* Make sure MVCCID for current transaction is generated. The ranges of a parallel leaf build may be built by workers
+   * in system transactions; btree_load_leaves_put generates it for them. */
+  if (load_args->range == NULL)
+    {
+      (void) logtb_get_current_mvccid (thread_p);
+    }
 #endif /* SERVER_MODE */
 
   fixed_mvccid_size = 2 * OR_MVCCID_SIZE;
@@ -2785,8 +3042,23 @@ btree_construct_leafs (THREAD_ENTRY * thread_p, const RECDES * in_recdes, void *
 	    {
 	      goto error;
 	    }
-	  log_append_undo_data2 (thread_p, RVBT_MVCC_NOTIFY_VACUUM, &load_args->btid->sys_btid->vfid, NULL, -1,
-				 notify_vacuum_rv_data_length, notify_vacuum_rv_data);
+#if defined (SERVER_MODE)
+	  if (load_args->range != NULL)
+	    {
+	      /* logged by the loading thread when the ranges are linked */
+	      ret = btree_load_range_save_vacuum_data (load_args->range, notify_vacuum_rv_data,
+						       notify_vacuum_rv_data_length);
+	      if (ret != NO_ERROR)
+		{
+		  goto error;
+		}
+	    }
+	  else
+#endif /* SERVER_MODE */
+	    {
+	      log_append_undo_data2 (thread_p, RVBT_MVCC_NOTIFY_VACUUM, &load_args->btid->sys_btid->vfid, NULL, -1,
+				     notify_vacuum_rv_data_length, notify_vacuum_rv_data);
+	    }
 	  pgbuf_set_dirty (thread_p, pgptr, DONT_FREE);
 	}
 
@@ -2919,11 +3191,21 @@ exit_on_error:
  * Note: This function supports the initial loading phase of B+tree
  * indices by providing an ordered list of (index-attribute
  * value, object address) pairs. It uses the general sorting
- * facility provided in the "sr" module.
+ * facility provided in the "sr" module. If px is not NULL, the
+ * sort items are produced by its extraction workers.
  */
 static int
-btree_index_sort (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args, SORT_PUT_FUNC * out_func, void *out_args)
+btree_index_sort (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args, BTREE_LOAD_PX * px, SORT_PUT_FUNC * out_func,
+		  void *out_args)
 {
+#if defined (SERVER_MODE)
+  if (px != NULL)
+    {
+      return sort_listfile (thread_p, sort_args->hfids[0].vfid.volid, 0, &btree_sort_px_get_next, px, out_func,
+			    out_args, compare_driver, sort_args, SORT_DUP, NO_SORT_LIMIT);
+    }
+#endif /* SERVER_MODE */
+
   return sort_listfile (thread_p, sort_args->hfids[0].vfid.volid, 0 /* TODO - support parallelism */ ,
 			&btree_sort_get_next, sort_args, out_func, out_args, compare_driver, sort_args, SORT_DUP,
 			NO_SORT_LIMIT);
@@ -2962,6 +3244,9 @@ btree_sort_get_next (THREAD_ENTRY * thread_p, RECDES * temp_recdes, void *arg)
   MVCC_REC_HEADER mvcc_header = MVCC_REC_HEADER_INITIALIZER;
   MVCC_SNAPSHOT mvcc_snapshot_dirty;
   MVCC_SATISFIES_SNAPSHOT_RESULT snapshot_dirty_satisfied;
+#if defined (SERVER_MODE)
+  SORT_STATUS status;
+#endif /* SERVER_MODE */
 
   db_make_null (&dbvalue);
 
@@ -3009,6 +3294,20 @@ btree_sort_get_next (THREAD_ENTRY * thread_p, RECDES * temp_recdes, void *arg)
 	{
 
 	case S_END:
+#if defined (SERVER_MODE)
+	  if (sort_args->px != NULL)
+	    {
+	      /* Extraction worker of a parallel load; continue with the next chunk of heap pages. */
+	      status = btree_sort_px_next_chunk (thread_p, sort_args);
+	      if (status != SORT_SUCCESS)
+		{
+		  return status;
+		}
+	      OID_SET_NULL (&prev_oid);
+	      continue;
+	    }
+#endif /* SERVER_MODE */
+
 	  /* No more objects in this heap, finish the current scan */
 	  if (sort_args->attrinfo_inited)
 	    {
@@ -3345,141 +3644,1789 @@ nofit:
   return SORT_REC_DOESNT_FIT;
 }
 
+#if defined (SERVER_MODE)
 /*
- * compare_driver () -
- *   return:
- *   first(in):
- *   second(in):
- *   arg(in):
+ * btree_load_pages_collect () - collect the heap pages for a parallel extraction
+ *   return: error code
+ *   hfids(in): heap files of the classes; may contain NULL HFIDs
+ *   n_classes(in): number of classes
+ *   degree(in/out): requested degree of parallelism; set to 1 if the extraction should be serial
+ *   pages(out): heap pages split in chunks
+ *
+ * Note: The degree is bounded by the number of CPUs and by the size of the heap files, each participant getting
+ *       at least BTREE_LOAD_PX_MIN_PAGES pages. The pages are collected from the file tables; if the heap files
+ *       grow too much meanwhile, the extraction is serial.
  */
 static int
-compare_driver (const void *first, const void *second, void *arg)
+btree_load_pages_collect (THREAD_ENTRY * thread_p, HFID * hfids, int n_classes, int *degree, BTREE_LOAD_PAGES * pages)
 {
-  char *mem1 = *(char **) first;
-  char *mem2 = *(char **) second;
-  int has_null;
-  SORT_ARGS *sort_args;
-  TP_DOMAIN *key_type;
-  int c = DB_UNK;
-
-  sort_args = (SORT_ARGS *) arg;
-  key_type = sort_args->key_type;
-
-  assert (PTR_ALIGN (mem1, MAX_ALIGNMENT) == mem1);
-  assert (PTR_ALIGN (mem2, MAX_ALIGNMENT) == mem2);
+  int cur_class, n_user_pages, n_class_pages, max_pages, total_pages, n_chunks;
+  int error_code = NO_ERROR;
 
-  /* Skip next link */
-  mem1 += sizeof (char *);
-  mem2 += sizeof (char *);
+  pages->pages = NULL;
+  pages->class_pages = NULL;
+  pages->n_classes = n_classes;
+  pages->n_pages = 0;
+  pages->chunk_size = 0;
+  pages->next_page = 0;
+  pages->claim_class = 0;
 
-  /* Read value_has_null */
-  assert (OR_GET_BYTE (mem1) == 0 || OR_GET_BYTE (mem1) == 1);
-  assert (OR_GET_BYTE (mem2) == 0 || OR_GET_BYTE (mem2) == 1);
-  has_null = (OR_GET_BYTE (mem1) || OR_GET_BYTE (mem2)) ? 1 : 0;
+  *degree = MIN (*degree, fileio_os_sysconf ());
+  if (*degree <= 1)
+    {
+      *degree = 1;
+      return NO_ERROR;
+    }
 
-  mem1 += OR_INT_SIZE;
-  mem2 += OR_INT_SIZE;
+  /* leave room for pages allocated meanwhile */
+  total_pages = 0;
+  max_pages = 0;
+  for (cur_class = 0; cur_class < n_classes; cur_class++)
+    {
+      if (HFID_IS_NULL (&hfids[cur_class]))
+	{
+	  continue;
+	}
+      error_code = file_get_num_user_pages (thread_p, &hfids[cur_class].vfid, &n_user_pages);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  return error_code;
+	}
+      total_pages += n_user_pages;
+      max_pages += n_user_pages + DISK_SECTOR_NPAGES;
+    }
 
-  assert (PTR_ALIGN (mem1, INT_ALIGNMENT) == mem1);
-  assert (PTR_ALIGN (mem2, INT_ALIGNMENT) == mem2);
+  *degree = MIN (*degree, total_pages / BTREE_LOAD_PX_MIN_PAGES);
+  if (*degree <= 1)
+    {
+      *degree = 1;
+      return NO_ERROR;
+    }
 
-  /* Skip the oids */
-  if (BTREE_IS_UNIQUE (sort_args->unique_pk))
-    {				/* unique index */
-      mem1 += (2 * OR_OID_SIZE);
-      mem2 += (2 * OR_OID_SIZE);
+  pages->class_pages = (int *) malloc ((n_classes + 1) * sizeof (int));
+  if (pages->class_pages == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (n_classes + 1) * sizeof (int));
+      error_code = ER_OUT_OF_VIRTUAL_MEMORY;
+      goto exit_on_error;
     }
-  else
-    {				/* non-unique index */
-      mem1 += OR_OID_SIZE;
-      mem2 += OR_OID_SIZE;
+  pages->pages = (VPID *) malloc (max_pages * sizeof (VPID));
+  if (pages->pages == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, max_pages * sizeof (VPID));
+      error_code = ER_OUT_OF_VIRTUAL_MEMORY;
+      goto exit_on_error;
     }
 
-  assert (PTR_ALIGN (mem1, INT_ALIGNMENT) == mem1);
-  assert (PTR_ALIGN (mem2, INT_ALIGNMENT) == mem2);
-
-  /* Skip the MVCCID's */
-  mem1 += 2 * OR_MVCCID_SIZE;
-  mem2 += 2 * OR_MVCCID_SIZE;
-
-  assert (PTR_ALIGN (mem1, INT_ALIGNMENT) == mem1);
-  assert (PTR_ALIGN (mem2, INT_ALIGNMENT) == mem2);
-
-  if (TP_DOMAIN_TYPE (key_type) == DB_TYPE_MIDXKEY)
+  for (cur_class = 0; cur_class < n_classes; cur_class++)
     {
-      int i;
-      char *bitptr1, *bitptr2;
-      int bitmap_size;
-      TP_DOMAIN *dom;
-
-      /* fast implementation of pr_midxkey_compare (). do not use DB_VALUE container for speed-up */
-
-      bitptr1 = mem1;
-      bitptr2 = mem2;
-
-      bitmap_size = OR_MULTI_BOUND_BIT_BYTES (key_type->precision);
-
-      mem1 += bitmap_size;
-      mem2 += bitmap_size;
-
-#if !defined(NDEBUG)
-      for (i = 0, dom = key_type->setdomain; dom; dom = dom->next, i++);
-      assert (i == key_type->precision);
-#endif
+      pages->class_pages[cur_class] = pages->n_pages;
+      if (HFID_IS_NULL (&hfids[cur_class]))
+	{
+	  continue;
+	}
 
-      if (sort_args->func_index_info != NULL)
+      error_code = file_sample_pages (thread_p, &hfids[cur_class].vfid, max_pages - pages->n_pages,
+				      &pages->pages[pages->n_pages], &n_class_pages);
+      if (error_code != NO_ERROR)
 	{
-	  assert (sort_args->n_attrs <= key_type->precision);
+	  ASSERT_ERROR ();
+	  goto exit_on_error;
 	}
-      else
+      if (pages->n_pages + n_class_pages >= max_pages)
 	{
-	  assert (sort_args->n_attrs == key_type->precision);
+	  /* the array is full, pages may be missing */
+	  *degree = 1;
+	  goto exit_on_error;
 	}
-      assert (key_type->setdomain != NULL);
+      pages->n_pages += n_class_pages;
+    }
+  pages->class_pages[n_classes] = pages->n_pages;
 
-      for (i = 0, dom = key_type->setdomain; i < key_type->precision && dom; i++, dom = dom->next)
-	{
-	  /* val1 or val2 is NULL */
-	  if (has_null)
-	    {
-	      if (OR_MULTI_ATT_IS_UNBOUND (bitptr1, i))
-		{		/* element val is null? */
-		  if (OR_MULTI_ATT_IS_UNBOUND (bitptr2, i))
-		    {
-		      continue;
-		    }
+  n_chunks = *degree * BTREE_LOAD_PX_CHUNKS_PER_PARTICIPANT;
+  pages->chunk_size = MAX (BTREE_LOAD_PX_MIN_PAGES / BTREE_LOAD_PX_CHUNKS_PER_PARTICIPANT,
+			   (pages->n_pages + n_chunks - 1) / n_chunks);
 
-		  c = DB_LT;
-		  break;	/* exit for-loop */
-		}
-	      else if (OR_MULTI_ATT_IS_UNBOUND (bitptr2, i))
-		{
-		  c = DB_GT;
-		  break;	/* exit for-loop */
-		}
-	    }
+  if (pthread_mutex_init (&pages->mutex, NULL) != 0)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CSS_PTHREAD_MUTEX_INIT, 0);
+      error_code = ER_CSS_PTHREAD_MUTEX_INIT;
+      goto exit_on_error;
+    }
 
-	  /* check for val1 and val2 same domain */
-	  c = dom->type->index_cmpdisk (mem1, mem2, dom, 0, 1, NULL);
-	  assert (c == DB_LT || c == DB_EQ || c == DB_GT);
+  return NO_ERROR;
 
-	  if (c != DB_EQ)
-	    {
-	      break;		/* exit for-loop */
-	    }
+exit_on_error:
+  if (pages->pages != NULL)
+    {
+      free_and_init (pages->pages);
+    }
+  if (pages->class_pages != NULL)
+    {
+      free_and_init (pages->class_pages);
+    }
+  pages->n_pages = 0;
 
-	  mem1 += pr_midxkey_element_disk_size (mem1, dom);
-	  mem2 += pr_midxkey_element_disk_size (mem2, dom);
-	}			/* for (i = 0; ... ) */
-      assert (c == DB_LT || c == DB_EQ || c == DB_GT);
+  return error_code;
+}
 
-      if (dom && dom->is_desc)
+/*
+ * btree_load_pages_claim () - claim the next chunk of heap pages
+ *   return: false if all pages are claimed
+ *   pages(in): heap pages
+ *   cur_class(out): class of the chunk
+ *   first_page(out): index of the first page of the chunk
+ *   n_pages(out): number of pages of the chunk
+ *
+ * Note: A chunk never spans two heap files.
+ */
+static bool
+btree_load_pages_claim (BTREE_LOAD_PAGES * pages, int *cur_class, int *first_page, int *n_pages)
+{
+  bool claimed = false;
+
+  pthread_mutex_lock (&pages->mutex);
+  if (pages->next_page < pages->n_pages)
+    {
+      while (pages->class_pages[pages->claim_class + 1] <= pages->next_page)
 	{
-	  c = ((c == DB_GT) ? DB_LT : (c == DB_LT) ? DB_GT : c);
+	  pages->claim_class++;
 	}
+      *cur_class = pages->claim_class;
+      *first_page = pages->next_page;
+      *n_pages = MIN (pages->chunk_size, pages->class_pages[pages->claim_class + 1] - pages->next_page);
+      pages->next_page += *n_pages;
+      claimed = true;
     }
-  else
-    {
+  pthread_mutex_unlock (&pages->mutex);
+
+  return claimed;
+}
+
+/*
+ * btree_load_pages_stop () - let no more chunks be claimed
+ *   return: void
+ *   pages(in): heap pages
+ */
+static void
+btree_load_pages_stop (BTREE_LOAD_PAGES * pages)
+{
+  pthread_mutex_lock (&pages->mutex);
+  pages->next_page = pages->n_pages;
+  pthread_mutex_unlock (&pages->mutex);
+}
+
+/*
+ * btree_load_pages_free () - free the heap pages collected by btree_load_pages_collect
+ *   return: void
+ *   pages(in): heap pages
+ */
+static void
+btree_load_pages_free (BTREE_LOAD_PAGES * pages)
+{
+  if (pages->pages != NULL)
+    {
+      pthread_mutex_destroy (&pages->mutex);
+      free_and_init (pages->pages);
+      free_and_init (pages->class_pages);
+    }
+}
+
+/*
+ * btree_load_px_init () - initialize a parallel extraction
+ *   return: error code
+ *   px(out): parallel extraction; allocated with malloc by the caller
+ *   hfids(in): heap files of the classes
+ *   n_classes(in): number of classes
+ *   pred_stream(in): filter predicate stream; may be NULL
+ *   pred_stream_size(in): size of pred_stream
+ *   func_index_info(in): function index information; may be NULL
+ *   degree(in/out): requested degree of parallelism; set to 1 if the extraction should be serial
+ *
+ * Note: Nothing needs to be destroyed if degree is set to 1. Otherwise the caller holds the only reference to px and
+ *       adds one for each worker it pushes.
+ */
+static int
+btree_load_px_init (THREAD_ENTRY * thread_p, BTREE_LOAD_PX * px, HFID * hfids, int n_classes, char *pred_stream,
+		    int pred_stream_size, FUNCTION_INDEX_INFO * func_index_info, int *degree)
+{
+  int error_code;
+
+  memset (px, 0, sizeof (BTREE_LOAD_PX));
+  px->tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  px->pred_stream = (pred_stream != NULL && pred_stream_size > 0) ? pred_stream : NULL;
+  px->pred_stream_size = pred_stream_size;
+  px->func_index_info = (func_index_info != NULL && func_index_info->expr != NULL) ? func_index_info : NULL;
+
+  error_code = btree_load_pages_collect (thread_p, hfids, n_classes, degree, &px->pages);
+  if (error_code != NO_ERROR || *degree <= 1)
+    {
+      return error_code;
+    }
+
+  if (pthread_mutex_init (&px->mutex, NULL) != 0)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CSS_PTHREAD_MUTEX_INIT, 0);
+      btree_load_pages_free (&px->pages);
+      return ER_CSS_PTHREAD_MUTEX_INIT;
+    }
+  if (pthread_cond_init (&px->cond, NULL) != 0)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CSS_PTHREAD_COND_INIT, 0);
+      pthread_mutex_destroy (&px->mutex);
+      btree_load_pages_free (&px->pages);
+      return ER_CSS_PTHREAD_COND_INIT;
+    }
+  px->ref_count = 1;
+
+  return NO_ERROR;
+}
+
+/*
+ * btree_load_px_set_error () - stop a parallel extraction on error
+ *   return: void
+ *   px(in): parallel extraction
+ *
+ * Note: The first error is saved to be raised again by the loading thread.
+ */
+static void
+btree_load_px_set_error (BTREE_LOAD_PX * px)
+{
+  int length = 1024;
+
+  btree_load_pages_stop (&px->pages);
+
+  pthread_mutex_lock (&px->mutex);
+  if (!px->has_error)
+    {
+      if (er_errid () == NO_ERROR)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_GENERIC_ERROR, 0);
+	}
+      (void) er_get_area_error (OR_ALIGNED_BUF_START (px->error_area), &length);
+      px->has_error = true;
+    }
+  px->stop = true;
+  pthread_cond_broadcast (&px->cond);
+  pthread_mutex_unlock (&px->mutex);
+}
+
+/*
+ * btree_load_px_enter () - start a worker of a parallel extraction
+ *   return: false if the extraction is closed; the reference of the worker is released and px must not be used
+ *   px(in): parallel extraction
+ *
+ * Note: The workers are pushed to the shared worker pool and may start long after they were pushed, or after the
+ *       loading thread extracted all heap pages itself.
+ */
+static bool
+btree_load_px_enter (BTREE_LOAD_PX * px)
+{
+  pthread_mutex_lock (&px->mutex);
+  if (px->is_closed)
+    {
+      pthread_mutex_unlock (&px->mutex);
+      btree_load_px_release (px);
+      return false;
+    }
+  px->n_running++;
+  pthread_mutex_unlock (&px->mutex);
+
+  return true;
+}
+
+/*
+ * btree_load_px_leave () - finish a worker started by btree_load_px_enter
+ *   return: void
+ *   px(in): parallel extraction; must not be used afterwards
+ */
+static void
+btree_load_px_leave (BTREE_LOAD_PX * px)
+{
+  pthread_mutex_lock (&px->mutex);
+  px->n_running--;
+  pthread_cond_broadcast (&px->cond);
+  pthread_mutex_unlock (&px->mutex);
+
+  btree_load_px_release (px);
+}
+
+/*
+ * btree_load_px_wait_workers () - close a parallel extraction and wait for its started workers to finish
+ *   return: void
+ *   px(in): parallel extraction
+ *
+ * Note: The workers that did not start yet exit without working (see btree_load_px_enter), so this never waits for
+ *       a worker that is still queued behind busy threads.
+ */
+static void
+btree_load_px_wait_workers (BTREE_LOAD_PX * px)
+{
+  pthread_mutex_lock (&px->mutex);
+  px->is_closed = true;
+  while (px->n_running > 0)
+    {
+      pthread_cond_wait (&px->cond, &px->mutex);
+    }
+  pthread_mutex_unlock (&px->mutex);
+}
+
+/*
+ * btree_load_px_release () - release a reference to a parallel extraction; the last one frees it
+ *   return: void
+ *   px(in): parallel extraction
+ */
+static void
+btree_load_px_release (BTREE_LOAD_PX * px)
+{
+  bool is_last;
+
+  pthread_mutex_lock (&px->mutex);
+  assert (px->ref_count > 0);
+  is_last = (--px->ref_count == 0);
+  pthread_mutex_unlock (&px->mutex);
+
+  if (is_last)
+    {
+      pthread_cond_destroy (&px->cond);
+      pthread_mutex_destroy (&px->mutex);
+      free_and_init (px);
+    }
+}
+
+/*
+ * btree_load_px_destroy () - destroy a parallel extraction initialized by btree_load_px_init
+ *   return: void
+ *   px(in): parallel extraction; closed by btree_load_px_wait_workers. px is freed with its last reference.
+ */
+static void
+btree_load_px_destroy (BTREE_LOAD_PX * px)
+{
+  assert (px->is_closed && px->n_running == 0);
+
+  /* workers that start from now on do not touch the pages */
+  btree_load_pages_free (&px->pages);
+  btree_load_px_release (px);
+}
+
+/*
+ * btree_sort_px_start () - start extracting the sort items of an index load in parallel
+ *   return: error code
+ *   sort_args(in): sort arguments of the loading thread
+ *   pred_stream(in): filter predicate stream; may be NULL
+ *   pred_stream_size(in): size of pred_stream
+ *   px_out(out): parallel extraction or NULL if the extraction should be serial
+ *
+ * Note: The degree of parallelism is given by parallel_scan_degree. The workers scan their chunks of heap pages and
+ *       pass the sort items to the loading thread in batches (see btree_sort_px_get_next). The loading thread
+ *       sorts and builds the leaves (see btree_load_leaves_start); when no batch is ready it extracts the chunks no
+ *       worker has claimed itself, so the load does not depend on free threads in the worker pool.
+ */
+static int
+btree_sort_px_start (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args, char *pred_stream, int pred_stream_size,
+		     BTREE_LOAD_PX ** px_out)
+{
+  BTREE_LOAD_PX *px;
+  int degree, i;
+  int error_code;
+
+  *px_out = NULL;
+
+  degree = prm_get_integer_value (PRM_ID_PARALLEL_SCAN_DEGREE);
+  if (degree <= 1)
+    {
+      return NO_ERROR;
+    }
+
+  px = (BTREE_LOAD_PX *) malloc (sizeof (BTREE_LOAD_PX));
+  if (px == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (BTREE_LOAD_PX));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  error_code = btree_load_px_init (thread_p, px, sort_args->hfids, sort_args->n_classes, pred_stream,
+				   pred_stream_size, sort_args->func_index_info, &degree);
+  if (error_code != NO_ERROR || degree <= 1)
+    {
+      free_and_init (px);
+      return error_code;
+    }
+
+  px->sort_args = sort_args;
+  px->worker_args = *sort_args;
+  px->max_batches = degree * BTREE_LOAD_PX_BATCHES_PER_WORKER;
+  px->ref_count += degree;
+
+  if (prm_get_bool_value (PRM_ID_LOG_BTREE_OPS))
+    {
+      _er_log_debug (ARG_FILE_LINE, "DEBUG_BTREE: load extracts %d heap pages with %d workers, btid(%d, (%d, %d)).",
+		     px->pages.n_pages, degree, sort_args->btid->sys_btid->root_pageid,
+		     sort_args->btid->sys_btid->vfid.volid, sort_args->btid->sys_btid->vfid.fileid);
+    }
+
+  for (i = 0; i < degree; i++)
+    {
+      // *INDENT-OFF*
+      cubthread::entry_callable_task *task =
+	new cubthread::entry_callable_task (std::bind (btree_sort_px_execute, std::placeholders::_1, px));
+      // *INDENT-ON*
+      css_push_external_task (css_get_current_conn_entry (), task);
+    }
+
+  *px_out = px;
+  return NO_ERROR;
+}
+
+/*
+ * btree_sort_px_end () - end a parallel extraction started by btree_sort_px_start
+ *   return: void
+ *   px(in): parallel extraction; freed with its last reference
+ *   sort_args(in/out): sort arguments of the loading thread; statistics of the workers are added on success
+ *   is_success(in): true if the sort was successful
+ *
+ * Note: The heap scan of the loading thread, if any, is ended with the other resources of sort_args.
+ */
+static void
+btree_sort_px_end (THREAD_ENTRY * thread_p, BTREE_LOAD_PX * px, SORT_ARGS * sort_args, bool is_success)
+{
+  BTREE_LOAD_BATCH *batch;
+
+  /* workers may wait for the queue to drain */
+  pthread_mutex_lock (&px->mutex);
+  px->stop = true;
+  pthread_cond_broadcast (&px->cond);
+  pthread_mutex_unlock (&px->mutex);
+  btree_load_pages_stop (&px->pages);
+
+  btree_load_px_wait_workers (px);
+
+  while (px->batch_head != NULL)
+    {
+      batch = px->batch_head;
+      px->batch_head = batch->next;
+      btree_sort_px_free_batch (batch);
+    }
+  if (px->curr_batch != NULL)
+    {
+      btree_sort_px_free_batch (px->curr_batch);
+    }
+
+  if (is_success)
+    {
+      assert (!px->has_error);
+      sort_args->n_oids += px->n_oids;
+      sort_args->n_nulls += px->n_nulls;
+    }
+
+  sort_args->px = NULL;
+  btree_load_px_destroy (px);
+}
+
+/*
+ * btree_sort_px_next_chunk () - move the heap scan of an extraction worker to its next chunk of pages
+ *   return: SORT_SUCCESS, SORT_NOMORE_RECS if all pages are claimed or SORT_ERROR_OCCURRED
+ *   sort_args(in/out): sort arguments of the worker
+ */
+static SORT_STATUS
+btree_sort_px_next_chunk (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args)
+{
+  BTREE_LOAD_PX *px = sort_args->px;
+  int cur_class, first_page, n_pages, attr_offset;
+
+  assert (px != NULL);
+
+  if (!btree_load_pages_claim (&px->pages, &cur_class, &first_page, &n_pages))
+    {
+      return SORT_NOMORE_RECS;
+    }
+
+  if (cur_class != sort_args->cur_class)
+    {
+      /* start up the scan of this heap */
+      btree_sort_px_end_scan (thread_p, sort_args);
+
+      sort_args->cur_class = cur_class;
+      attr_offset = cur_class * sort_args->n_attrs;
+
+      /* do not keep pages fixed while waiting for the loading thread */
+      if (heap_scancache_start (thread_p, &sort_args->hfscan_cache, &sort_args->hfids[cur_class],
+				&sort_args->class_ids[cur_class], false, false, NULL) != NO_ERROR)
+	{
+	  return SORT_ERROR_OCCURRED;
+	}
+      sort_args->scancache_inited = 1;
+
+      if (heap_attrinfo_start (thread_p, &sort_args->class_ids[cur_class], sort_args->n_attrs,
+			       &sort_args->attr_ids[attr_offset], &sort_args->attr_info) != NO_ERROR)
+	{
+	  return SORT_ERROR_OCCURRED;
+	}
+      if (sort_args->filter)
+	{
+	  if (heap_attrinfo_start (thread_p, &sort_args->class_ids[cur_class], sort_args->filter->num_attrs_pred,
+				   sort_args->filter->attrids_pred, sort_args->filter->cache_pred) != NO_ERROR)
+	    {
+	      return SORT_ERROR_OCCURRED;
+	    }
+	}
+      if (sort_args->func_index_info)
+	{
+	  if (heap_attrinfo_start (thread_p, &sort_args->class_ids[cur_class], sort_args->n_attrs,
+				   &sort_args->attr_ids[attr_offset],
+				   sort_args->func_index_info->expr->cache_attrinfo) != NO_ERROR)
+	    {
+	      return SORT_ERROR_OCCURRED;
+	    }
+	}
+      sort_args->attrinfo_inited = 1;
+    }
+
+  heap_scancache_set_page_set (&sort_args->hfscan_cache, &px->pages.pages[first_page], n_pages);
+  OID_SET_NULL (&sort_args->cur_oid);
+
+  return SORT_SUCCESS;
+}
+
+/*
+ * btree_sort_px_end_scan () - end the heap scan of an extraction worker
+ *   return: void
+ *   sort_args(in/out): sort arguments of the worker
+ */
+static void
+btree_sort_px_end_scan (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args)
+{
+  if (sort_args->attrinfo_inited)
+    {
+      heap_attrinfo_end (thread_p, &sort_args->attr_info);
+      if (sort_args->filter)
+	{
+	  heap_attrinfo_end (thread_p, sort_args->filter->cache_pred);
+	}
+      if (sort_args->func_index_info)
+	{
+	  heap_attrinfo_end (thread_p, sort_args->func_index_info->expr->cache_attrinfo);
+	}
+    }
+  sort_args->attrinfo_inited = 0;
+  if (sort_args->scancache_inited)
+    {
+      (void) heap_scancache_end (thread_p, &sort_args->hfscan_cache);
+    }
+  sort_args->scancache_inited = 0;
+}
+
+/*
+ * btree_sort_px_publish () - queue a full batch of sort items for the loading thread
+ *   return: false if the extraction is stopped; the batch is not queued
+ *   px(in): parallel extraction
+ *   batch(in): batch of sort items
+ *
+ * Note: Waits while the queue is full.
+ */
+static bool
+btree_sort_px_publish (BTREE_LOAD_PX * px, BTREE_LOAD_BATCH * batch)
+{
+  bool published = false;
+
+  pthread_mutex_lock (&px->mutex);
+  while (px->n_batches >= px->max_batches && !px->stop)
+    {
+      pthread_cond_wait (&px->cond, &px->mutex);
+    }
+  if (!px->stop)
+    {
+      batch->next = NULL;
+      if (px->batch_tail == NULL)
+	{
+	  px->batch_head = batch;
+	}
+      else
+	{
+	  px->batch_tail->next = batch;
+	}
+      px->batch_tail = batch;
+      px->n_batches++;
+      published = true;
+      pthread_cond_broadcast (&px->cond);
+    }
+  pthread_mutex_unlock (&px->mutex);
+
+  return published;
+}
+
+/*
+ * btree_sort_px_alloc_batch () - allocate a batch of sort items
+ *   return: batch or NULL on error
+ *   area_size(in): size of the record area
+ */
+static BTREE_LOAD_BATCH *
+btree_sort_px_alloc_batch (int area_size)
+{
+  BTREE_LOAD_BATCH *batch;
+  size_t size = sizeof (BTREE_LOAD_BATCH) + MAX_ALIGNMENT + area_size;
+
+  batch = (BTREE_LOAD_BATCH *) malloc (size);
+  if (batch == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, size);
+      return NULL;
+    }
+
+  batch->next = NULL;
+  batch->area = PTR_ALIGN ((char *) (batch + 1), MAX_ALIGNMENT);
+  batch->area_size = area_size;
+  batch->length = 0;
+  batch->pos = 0;
+
+  return batch;
+}
+
+/*
+ * btree_sort_px_free_batch () - free a batch of sort items
+ *   return: void
+ *   batch(in): batch
+ */
+static void
+btree_sort_px_free_batch (BTREE_LOAD_BATCH * batch)
+{
+  free (batch);
+}
+
+/*
+ * btree_sort_px_extract () - extract the next sort item in the loading thread of a parallel extraction
+ *   return: SORT_STATUS; SORT_NOMORE_RECS if all chunks are claimed
+ *   temp_recdes(in): temporary record descriptor; specifies where to put the next sort item.
+ *   px(in): parallel extraction
+ *
+ * Note: The loading thread claims chunks like the workers do, using its own heap scan and predicates.
+ */
+static SORT_STATUS
+btree_sort_px_extract (THREAD_ENTRY * thread_p, RECDES * temp_recdes, BTREE_LOAD_PX * px)
+{
+  SORT_ARGS *sort_args = px->sort_args;
+  SORT_STATUS status;
+
+  if (!px->loader_started)
+    {
+      /* the serial scan started by btree_load_index is replaced by the chunks */
+      btree_sort_px_end_scan (thread_p, sort_args);
+      sort_args->cur_class = -1;
+      sort_args->px = px;
+      px->loader_started = true;
+
+      status = btree_sort_px_next_chunk (thread_p, sort_args);
+      if (status != SORT_SUCCESS)
+	{
+	  return status;
+	}
+    }
+
+  return btree_sort_get_next (thread_p, temp_recdes, sort_args);
+}
+
+/*
+ * btree_sort_px_get_next () - Get_key function for index sorting with parallel extraction
+ *   return: SORT_STATUS
+ *   temp_recdes(in): temporary record descriptor; specifies where to put the next sort item.
+ *   arg(in): parallel extraction
+ *
+ * Note: Sort items are taken from the batches queued by the extraction workers, in no particular order. When no batch
+ *       is ready, the loading thread extracts the next sort item itself from the chunks no worker has claimed. It
+ *       waits for batches only once all chunks are claimed and only for workers that are running, so a worker
+ *       still queued in the worker pool never blocks the load.
+ */
+static SORT_STATUS
+btree_sort_px_get_next (THREAD_ENTRY * thread_p, RECDES * temp_recdes, void *arg)
+{
+  BTREE_LOAD_PX *px = (BTREE_LOAD_PX *) arg;
+  BTREE_LOAD_BATCH *batch;
+  SORT_STATUS status;
+  int length;
+
+  batch = px->curr_batch;
+  if (batch != NULL && batch->pos >= batch->length)
+    {
+      btree_sort_px_free_batch (batch);
+      px->curr_batch = batch = NULL;
+    }
+
+  if (batch == NULL)
+    {
+      pthread_mutex_lock (&px->mutex);
+      while (px->batch_head == NULL && !px->has_error)
+	{
+	  if (!px->loader_done)
+	    {
+	      pthread_mutex_unlock (&px->mutex);
+	      status = btree_sort_px_extract (thread_p, temp_recdes, px);
+	      if (status == SORT_ERROR_OCCURRED)
+		{
+		  /* also stop the workers */
+		  btree_load_px_set_error (px);
+		}
+	      if (status != SORT_NOMORE_RECS)
+		{
+		  return status;
+		}
+	      pthread_mutex_lock (&px->mutex);
+	      px->loader_done = true;
+	      continue;
+	    }
+	  if (px->n_running == 0)
+	    {
+	      break;
+	    }
+	  pthread_cond_wait (&px->cond, &px->mutex);
+	}
+      if (px->has_error)
+	{
+	  pthread_mutex_unlock (&px->mutex);
+	  (void) er_set_area_error (OR_ALIGNED_BUF_START (px->error_area));
+	  return SORT_ERROR_OCCURRED;
+	}
+      batch = px->batch_head;
+      if (batch == NULL)
+	{
+	  /* all chunks are extracted and the started workers are finished */
+	  pthread_mutex_unlock (&px->mutex);
+	  return SORT_NOMORE_RECS;
+	}
+      px->batch_head = batch->next;
+      if (px->batch_head == NULL)
+	{
+	  px->batch_tail = NULL;
+	}
+      px->n_batches--;
+      pthread_cond_broadcast (&px->cond);
+      pthread_mutex_unlock (&px->mutex);
+
+      px->curr_batch = batch;
+    }
+
+  length = *(int *) (batch->area + batch->pos);
+  if (temp_recdes->area_size < length)
+    {
+      temp_recdes->length = length;
+      return SORT_REC_DOESNT_FIT;
+    }
+
+  memcpy (temp_recdes->data, batch->area + batch->pos + MAX_ALIGNMENT, length);
+  temp_recdes->length = length;
+  batch->pos += MAX_ALIGNMENT + DB_ALIGN (length, MAX_ALIGNMENT);
+
+  return SORT_SUCCESS;
+}
+
+/*
+ * btree_sort_px_execute () - extraction worker of a parallel index load
+ *   return: void
+ *   thread_ref(in): worker thread
+ *   px(in): parallel extraction
+ *
+ * Note: The worker produces the sort items of its chunks with btree_sort_get_next, using its own heap scan, attribute
+ *       caches and predicates.
+ */
+// *INDENT-OFF*
+static void
+btree_sort_px_execute (cubthread::entry &thread_ref, BTREE_LOAD_PX * px)
+{
+  THREAD_ENTRY *thread_p = &thread_ref;
+  SORT_ARGS sort_args;
+  PRED_EXPR_WITH_CONTEXT *filter_pred = NULL;
+  FUNCTION_INDEX_INFO func_index_info;
+  XASL_UNPACK_INFO *func_unpack_info = NULL;
+  DB_TYPE single_node_type = DB_TYPE_NULL;
+  BTREE_LOAD_BATCH *batch = NULL;
+  RECDES recdes;
+  SORT_STATUS status = SORT_SUCCESS;
+
+  if (!btree_load_px_enter (px))
+    {
+      /* the loading thread is done with the extraction */
+      return;
+    }
+
+  /* read on behalf of the loading transaction; the worker never locks, logs or builds a snapshot (see
+   * logtb_check_tran_owner) */
+  thread_share_tran (&thread_ref, px->tran_index);
+  pthread_mutex_unlock (&thread_ref.tran_index_lock);
+
+  sort_args = px->worker_args;
+  sort_args.px = px;
+  sort_args.cur_class = -1;
+  sort_args.scancache_inited = 0;
+  sort_args.attrinfo_inited = 0;
+  sort_args.n_nulls = 0;
+  sort_args.n_oids = 0;
+  sort_args.filter = NULL;
+  sort_args.filter_eval_func = NULL;
+  sort_args.func_index_info = NULL;
+  func_index_info.expr = NULL;
+
+  if (px->pred_stream != NULL)
+    {
+      if (stx_map_stream_to_filter_pred (thread_p, &filter_pred, px->pred_stream, px->pred_stream_size) != NO_ERROR)
+	{
+	  status = SORT_ERROR_OCCURRED;
+	  goto end;
+	}
+      sort_args.filter = filter_pred;
+      sort_args.filter_eval_func = eval_fnc (thread_p, filter_pred->pred, &single_node_type);
+    }
+  if (px->func_index_info != NULL)
+    {
+      func_index_info = *px->func_index_info;
+      func_index_info.expr = NULL;
+      if (stx_map_stream_to_func_pred (thread_p, &func_index_info.expr, func_index_info.expr_stream,
+				       func_index_info.expr_stream_size, &func_unpack_info) != NO_ERROR)
+	{
+	  status = SORT_ERROR_OCCURRED;
+	  goto end;
+	}
+      sort_args.func_index_info = &func_index_info;
+    }
+
+  status = btree_sort_px_next_chunk (thread_p, &sort_args);
+  while (status == SORT_SUCCESS)
+    {
+      if (batch == NULL)
+	{
+	  batch = btree_sort_px_alloc_batch (BTREE_LOAD_PX_BATCH_SIZE);
+	  if (batch == NULL)
+	    {
+	      status = SORT_ERROR_OCCURRED;
+	      break;
+	    }
+	}
+
+      /* each sort item is preceded by its length */
+      recdes.data = batch->area + batch->length + MAX_ALIGNMENT;
+      recdes.area_size = batch->area_size - batch->length - MAX_ALIGNMENT;
+      recdes.length = 0;
+
+      status = btree_sort_get_next (thread_p, &recdes, &sort_args);
+      if (status == SORT_SUCCESS)
+	{
+	  *(int *) (batch->area + batch->length) = recdes.length;
+	  batch->length += MAX_ALIGNMENT + DB_ALIGN (recdes.length, MAX_ALIGNMENT);
+	}
+      else if (status == SORT_REC_DOESNT_FIT)
+	{
+	  if (batch->length == 0)
+	    {
+	      /* the sort item is larger than a batch */
+	      btree_sort_px_free_batch (batch);
+	      batch = btree_sort_px_alloc_batch (recdes.length + MAX_ALIGNMENT);
+	      if (batch == NULL)
+		{
+		  status = SORT_ERROR_OCCURRED;
+		  break;
+		}
+	    }
+	  else
+	    {
+	      if (!btree_sort_px_publish (px, batch))
+		{
+		  /* stopped by the loading thread */
+		  status = SORT_NOMORE_RECS;
+		  break;
+		}
+	      batch = NULL;
+	    }
+	  status = SORT_SUCCESS;
+	}
+    }
+
+  if (status == SORT_NOMORE_RECS && batch != NULL && batch->length > 0 && btree_sort_px_publish (px, batch))
+    {
+      batch = NULL;
+    }
+
+end:
+  if (status == SORT_ERROR_OCCURRED)
+    {
+      btree_load_px_set_error (px);
+    }
+  if (batch != NULL)
+    {
+      btree_sort_px_free_batch (batch);
+    }
+
+  btree_sort_px_end_scan (thread_p, &sort_args);
+  if (filter_pred != NULL)
+    {
+      qexec_clear_pred_context (thread_p, filter_pred, true);
+      if (filter_pred->unpack_info != NULL)
+	{
+	  free_xasl_unpack_info (thread_p, filter_pred->unpack_info);
+	}
+      db_private_free_and_init (thread_p, filter_pred);
+    }
+  if (func_index_info.expr != NULL)
+    {
+      (void) qexec_clear_func_pred (thread_p, func_index_info.expr);
+    }
+  if (func_unpack_info != NULL)
+    {
+      free_xasl_unpack_info (thread_p, func_unpack_info);
+    }
+  er_clear ();
+  thread_end_share_tran (&thread_ref);
+
+  pthread_mutex_lock (&px->mutex);
+  px->n_oids += sort_args.n_oids;
+  px->n_nulls += sort_args.n_nulls;
+  pthread_mutex_unlock (&px->mutex);
+
+  /* px may be freed as soon as the worker is reported; do not touch it afterwards */
+  btree_load_px_leave (px);
+}
+// *INDENT-ON*
+
+/*
+ * btree_load_leaves_start () - start building the leaves of an index load in parallel
+ *   return: error code
+ *   load_args(in): loading arguments of the loading thread
+ *   leaves_out(out): parallel leaf build or NULL if the leaves should be built serially
+ *
+ * Note: The degree of parallelism is given by parallel_scan_degree. The sort output is cut in ranges of consecutive
+ *       keys (see btree_load_leaves_put) and the leaves of each range are built by a worker; the loading thread links
+ *       the leaves of all ranges and builds the upper levels serially. The ranges no worker has claimed are built by
+ *       the loading thread, so the load does not depend on free threads in the worker pool.
+ */
+static int
+btree_load_leaves_start (THREAD_ENTRY * thread_p, LOAD_ARGS * load_args, BTREE_LOAD_LEAVES ** leaves_out)
+{
+  BTREE_LOAD_LEAVES *leaves;
+  int degree;
+
+  *leaves_out = NULL;
+
+  degree = prm_get_integer_value (PRM_ID_PARALLEL_SCAN_DEGREE);
+  if (degree <= 1)
+    {
+      return NO_ERROR;
+    }
+
+  leaves = (BTREE_LOAD_LEAVES *) malloc (sizeof (BTREE_LOAD_LEAVES));
+  if (leaves == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (BTREE_LOAD_LEAVES));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  leaves->loader = thread_p;
+  leaves->load_args = load_args;
+  leaves->degree = degree;
+  leaves->range_head = NULL;
+  leaves->range_tail = NULL;
+
+  // *INDENT-OFF*
+  leaves->group = new btree_load_task_group ([] (const btree_load_task_group::task_func & task)
+    {
+      cubthread::entry_callable_task *callable =
+        new cubthread::entry_callable_task ([task] (cubthread::entry & thread_ref)
+          {
+            /* the worker gets its own system transaction; see btree_load_range_execute */
+            pthread_mutex_unlock (&thread_ref.tran_index_lock);
+            task (thread_ref);
+          });
+      css_push_external_task (css_get_current_conn_entry (), callable);
+    });
+  // *INDENT-ON*
+
+  if (prm_get_bool_value (PRM_ID_LOG_BTREE_OPS))
+    {
+      _er_log_debug (ARG_FILE_LINE, "DEBUG_BTREE: load builds leaves with %d workers, btid(%d, (%d, %d)).", degree,
+		     load_args->btid->sys_btid->root_pageid, load_args->btid->sys_btid->vfid.volid,
+		     load_args->btid->sys_btid->vfid.fileid);
+    }
+
+  *leaves_out = leaves;
+  return NO_ERROR;
+}
+
+/*
+ * btree_load_leaves_end () - end a parallel leaf build started by btree_load_leaves_start
+ *   return: error code
+ *   leaves(in): parallel leaf build; freed
+ *   is_success(in): true if the sort was successful
+ *
+ * Note: On success, the leaves of all ranges are linked and load_args is left as after a serial build of the leaves,
+ *       with the last leaf record already saved.
+ */
+static int
+btree_load_leaves_end (THREAD_ENTRY * thread_p, BTREE_LOAD_LEAVES * leaves, bool is_success)
+{
+  BTREE_LOAD_RANGE *range;
+  int error_code = NO_ERROR;
+
+  if (is_success && leaves->range_tail != NULL)
+    {
+      error_code = btree_load_leaves_close_range (thread_p, leaves, true);
+      is_success = (error_code == NO_ERROR);
+    }
+  if (is_success)
+    {
+      leaves->group->run_queued (*thread_p);
+    }
+  else
+    {
+      (void) leaves->group->cancel_queued ();
+    }
+
+  /* workers must be done with their ranges before the ranges are read or freed */
+  leaves->group->wait_claimed ();
+  delete leaves->group;
+  leaves->group = NULL;
+
+  if (is_success)
+    {
+      for (range = leaves->range_head; range != NULL; range = range->next)
+	{
+	  if (range->error_code != NO_ERROR)
+	    {
+	      /* raise the error of the range again on the loading thread */
+	      (void) er_set_area_error (OR_ALIGNED_BUF_START (range->error_area));
+	      error_code = range->error_code;
+	      break;
+	    }
+	}
+    }
+  if (is_success && error_code == NO_ERROR)
+    {
+      error_code = btree_load_leaves_link (thread_p, leaves);
+    }
+
+  while (leaves->range_head != NULL)
+    {
+      range = leaves->range_head;
+      leaves->range_head = range->next;
+      btree_load_range_free (range);
+    }
+  free_and_init (leaves);
+
+  return error_code;
+}
+
+/*
+ * btree_load_leaves_put () - output function of the index sort for a parallel leaf build
+ *   return: error code
+ *   in_recdes(in): next sort item; its duplicates are linked to it
+ *   arg(in): parallel leaf build
+ *
+ * Note: The sort items are copied to the range filled by the loading thread. A full range is closed before the first
+ *       item of the next key, so all objects of a key are built by the same task and the unique constraint is checked
+ *       as in a serial build.
+ */
+static int
+btree_load_leaves_put (THREAD_ENTRY * thread_p, const RECDES * in_recdes, void *arg)
+{
+  BTREE_LOAD_LEAVES *leaves = (BTREE_LOAD_LEAVES *) arg;
+  BTID_INT *btid = leaves->load_args->btid;
+  BTREE_LOAD_RANGE *range = leaves->range_tail;
+  char *item = in_recdes->data;
+  int length = in_recdes->length;
+  char *last_item, *next;
+  DB_VALUE key, last_key;
+  int c = DB_UNK;
+  int error_code;
+
+  /* Make sure MVCCID for current transaction is generated; workers build their ranges in system transactions. */
+  (void) logtb_get_current_mvccid (thread_p);
+
+  if (range != NULL && range->length >= BTREE_LOAD_RANGE_SIZE)
+    {
+      last_item = range->area + range->last_item;
+      db_make_null (&key);
+      db_make_null (&last_key);
+
+      error_code = btree_load_read_sort_key (btid, item, length, &key);
+      if (error_code == NO_ERROR)
+	{
+	  error_code = btree_load_read_sort_key (btid, last_item, *(int *) (last_item - MAX_ALIGNMENT), &last_key);
+	}
+      if (error_code == NO_ERROR)
+	{
+	  c = btree_compare_key (&key, &last_key, btid->key_type, 0, 1, NULL);
+	}
+
+      if (DB_NEED_CLEAR (&key))
+	{
+	  pr_clear_value (&key);
+	}
+      if (DB_NEED_CLEAR (&last_key))
+	{
+	  pr_clear_value (&last_key);
+	}
+      if (error_code != NO_ERROR)
+	{
+	  return error_code;
+	}
+
+      if (c != DB_EQ)
+	{
+	  error_code = btree_load_leaves_close_range (thread_p, leaves, false);
+	  if (error_code != NO_ERROR)
+	    {
+	      return error_code;
+	    }
+	  range = NULL;
+	}
+    }
+
+  if (range == NULL)
+    {
+      range = btree_load_range_alloc (btid);
+      if (range == NULL)
+	{
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
+	}
+      if (leaves->range_tail == NULL)
+	{
+	  leaves->range_head = range;
+	}
+      else
+	{
+	  leaves->range_tail->next = range;
+	}
+      leaves->range_tail = range;
+    }
+
+  for (;;)
+    {
+      next = *(char **) item;	/* save forward link */
+
+      error_code = btree_load_range_add_item (range, item, length);
+      if (error_code != NO_ERROR)
+	{
+	  return error_code;
+	}
+
+      if (next == NULL)
+	{
+	  break;
+	}
+      item = next;
+      length = SORT_RECORD_LENGTH (next);
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * btree_load_leaves_close_range () - close the range filled by the loading thread
+ *   return: error code
+ *   leaves(in): parallel leaf build
+ *   is_last(in): true for the last range of the load
+ *
+ * Note: The loading thread builds the last range itself, and every range that may have overflow keys, because the
+ *       overflow key file is created and filled by the loading transaction. The other ranges are handed over to the
+ *       workers; when too many are queued, the loading thread builds the oldest one.
+ */
+static int
+btree_load_leaves_close_range (THREAD_ENTRY * thread_p, BTREE_LOAD_LEAVES * leaves, bool is_last)
+{
+  BTREE_LOAD_RANGE *range = leaves->range_tail;
+
+  if (is_last || range->has_overflow_key)
+    {
+      btree_load_range_execute (*thread_p, leaves, range);
+      return range->error_code;
+    }
+
+  // *INDENT-OFF*
+  leaves->group->hand_over (std::bind (btree_load_range_execute, std::placeholders::_1, leaves, range));
+
+  while (leaves->group->get_queued_count () > (std::size_t) leaves->degree * BTREE_LOAD_RANGES_PER_WORKER)
+    {
+      (void) leaves->group->run_oldest_queued (*thread_p);
+    }
+  // *INDENT-ON*
+
+  return NO_ERROR;
+}
+
+/*
+ * btree_load_leaves_link () - link the leaves of the ranges of a parallel leaf build
+ *   return: error code
+ *   leaves(in): parallel leaf build; all ranges are built
+ *
+ * Note: The last leaf of each range is linked to the first leaf of the next one, which makes the same leaf chain as a
+ *       serial build. The vacuum notifications of the ranges are logged on behalf of the loading transaction.
+ */
+static int
+btree_load_leaves_link (THREAD_ENTRY * thread_p, BTREE_LOAD_LEAVES * leaves)
+{
+  LOAD_ARGS *load_args = leaves->load_args;
+  BTREE_LOAD_RANGE *range;
+  VPID prev_vpid;
+  int pos, length;
+  int error_code;
+
+  VPID_SET_NULL (&prev_vpid);
+  load_args->n_keys = 0;
+
+  for (range = leaves->range_head; range != NULL; range = range->next)
+    {
+      for (pos = 0; pos < range->vacuum_data_length; pos += MAX_ALIGNMENT + DB_ALIGN (length, MAX_ALIGNMENT))
+	{
+	  length = *(int *) (range->vacuum_data + pos);
+	  log_append_undo_data2 (thread_p, RVBT_MVCC_NOTIFY_VACUUM, &load_args->btid->sys_btid->vfid, NULL, -1, length,
+				 range->vacuum_data + pos + MAX_ALIGNMENT);
+	}
+
+      load_args->n_keys += range->n_keys;
+      if (VPID_ISNULL (&range->first_leaf))
+	{
+	  continue;
+	}
+
+      if (VPID_ISNULL (&prev_vpid))
+	{
+	  load_args->vpid_first_leaf = range->first_leaf;
+	}
+      else
+	{
+	  error_code = btree_load_link_pages (thread_p, load_args->btid, &prev_vpid, &range->first_leaf);
+	  if (error_code != NO_ERROR)
+	    {
+	      return error_code;
+	    }
+	}
+      prev_vpid = range->last_leaf;
+    }
+
+  /* the current leaf of a serial build is the last one */
+  load_args->leaf.vpid = prev_vpid;
+
+  return NO_ERROR;
+}
+
+/*
+ * btree_load_link_pages () - link two consecutive leaves of different ranges
+ *   return: error code
+ *   btid(in): the index
+ *   prev_vpid(in): last leaf of a range
+ *   next_vpid(in): first leaf of the next range
+ */
+static int
+btree_load_link_pages (THREAD_ENTRY * thread_p, BTID_INT * btid, VPID * prev_vpid, VPID * next_vpid)
+{
+  PAGE_PTR page;
+  BTREE_NODE_HEADER *header;
+  int error_code = NO_ERROR;
+
+  page = pgbuf_fix (thread_p, prev_vpid, OLD_PAGE, PGBUF_LATCH_WRITE, PGBUF_UNCONDITIONAL_LATCH);
+  if (page == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error_code);
+      return error_code;
+    }
+  header = btree_get_node_header (thread_p, page);
+  if (header == NULL)
+    {
+      pgbuf_unfix_and_init (thread_p, page);
+      assert_release (false);
+      return ER_FAILED;
+    }
+  assert (VPID_ISNULL (&header->next_vpid));
+  header->next_vpid = *next_vpid;
+  btree_log_page (thread_p, &btid->sys_btid->vfid, page);
+
+  page = pgbuf_fix (thread_p, next_vpid, OLD_PAGE, PGBUF_LATCH_WRITE, PGBUF_UNCONDITIONAL_LATCH);
+  if (page == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error_code);
+      return error_code;
+    }
+  header = btree_get_node_header (thread_p, page);
+  if (header == NULL)
+    {
+      pgbuf_unfix_and_init (thread_p, page);
+      assert_release (false);
+      return ER_FAILED;
+    }
+  assert (VPID_ISNULL (&header->prev_vpid));
+  header->prev_vpid = *prev_vpid;
+  btree_log_page (thread_p, &btid->sys_btid->vfid, page);
+
+  return NO_ERROR;
+}
+
+/*
+ * btree_load_range_alloc () - allocate an empty range of a parallel leaf build
+ *   return: range or NULL on error
+ *   btid(in): the index; copied for the worker of the range
+ */
+static BTREE_LOAD_RANGE *
+btree_load_range_alloc (BTID_INT * btid)
+{
+  BTREE_LOAD_RANGE *range;
+
+  range = (BTREE_LOAD_RANGE *) malloc (sizeof (BTREE_LOAD_RANGE));
+  if (range == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (BTREE_LOAD_RANGE));
+      return NULL;
+    }
+
+  range->next = NULL;
+  range->area = NULL;
+  range->area_size = 0;
+  range->length = 0;
+  range->last_item = 0;
+  range->has_overflow_key = false;
+  range->btid_int = *btid;
+  range->btid_int.copy_buf = NULL;
+  range->btid_int.copy_buf_len = 0;
+  VPID_SET_NULL (&range->first_leaf);
+  VPID_SET_NULL (&range->last_leaf);
+  range->n_keys = 0;
+  range->vacuum_data = NULL;
+  range->vacuum_data_size = 0;
+  range->vacuum_data_length = 0;
+  range->error_code = NO_ERROR;
+
+  return range;
+}
+
+/*
+ * btree_load_range_free () - free a range allocated by btree_load_range_alloc
+ *   return: void
+ *   range(in): range
+ */
+static void
+btree_load_range_free (BTREE_LOAD_RANGE * range)
+{
+  if (range->area != NULL)
+    {
+      free_and_init (range->area);
+    }
+  if (range->vacuum_data != NULL)
+    {
+      free_and_init (range->vacuum_data);
+    }
+  free_and_init (range);
+}
+
+/*
+ * btree_load_range_add_item () - copy a sort item to a range
+ *   return: error code
+ *   range(in): range filled by the loading thread
+ *   item(in): sort item
+ *   length(in): length of the sort item
+ *
+ * Note: The copy is not linked to the other items of the range; the leaves are built one item at a time.
+ */
+static int
+btree_load_range_add_item (BTREE_LOAD_RANGE * range, char *item, int length)
+{
+  int size = MAX_ALIGNMENT + DB_ALIGN (length, MAX_ALIGNMENT);
+  int new_size;
+  char *new_area;
+  char *copy;
+
+  if (range->length + size > range->area_size)
+    {
+      new_size = MAX (2 * range->area_size, BTREE_LOAD_RANGE_SIZE + DB_PAGESIZE);
+      new_size = MAX (new_size, range->length + size);
+      new_area = (char *) realloc (range->area, new_size);
+      if (new_area == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) new_size);
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
+	}
+      range->area = new_area;
+      range->area_size = new_size;
+    }
+
+  *(int *) (range->area + range->length) = length;
+  copy = range->area + range->length + MAX_ALIGNMENT;
+  memcpy (copy, item, length);
+  *(char **) copy = NULL;
+
+  /* a key can not be longer than its sort item */
+  if (length >= BTREE_MAX_KEYLEN_INPAGE)
+    {
+      range->has_overflow_key = true;
+    }
+
+  range->last_item = range->length + MAX_ALIGNMENT;
+  range->length += size;
+
+  return NO_ERROR;
+}
+
+/*
+ * btree_load_range_save_vacuum_data () - save the undo data of a RVBT_MVCC_NOTIFY_VACUUM record of a range
+ *   return: error code
+ *   range(in): range
+ *   data(in): undo data
+ *   length(in): length of the undo data
+ */
+static int
+btree_load_range_save_vacuum_data (BTREE_LOAD_RANGE * range, char *data, int length)
+{
+  int size = MAX_ALIGNMENT + DB_ALIGN (length, MAX_ALIGNMENT);
+  int new_size;
+  char *new_data;
+
+  if (range->vacuum_data_length + size > range->vacuum_data_size)
+    {
+      new_size = MAX (2 * range->vacuum_data_size, DB_PAGESIZE);
+      new_size = MAX (new_size, range->vacuum_data_length + size);
+      new_data = (char *) realloc (range->vacuum_data, new_size);
+      if (new_data == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) new_size);
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
+	}
+      range->vacuum_data = new_data;
+      range->vacuum_data_size = new_size;
+    }
+
+  *(int *) (range->vacuum_data + range->vacuum_data_length) = length;
+  memcpy (range->vacuum_data + range->vacuum_data_length + MAX_ALIGNMENT, data, length);
+  range->vacuum_data_length += size;
+
+  return NO_ERROR;
+}
+
+/*
+ * btree_load_range_build () - build the leaves of the sort items of a range
+ *   return: error code
+ *   leaves(in): parallel leaf build
+ *   range(in): range; its sort items are freed
+ *   btid(in): the index
+ *
+ * Note: The leaves are built by btree_construct_leafs, like in a serial build, and the last leaf record is saved.
+ */
+static int
+btree_load_range_build (THREAD_ENTRY * thread_p, BTREE_LOAD_LEAVES * leaves, BTREE_LOAD_RANGE * range,
+			BTID_INT * btid)
+{
+  LOAD_ARGS load_args_info, *load_args;
+  RECDES recdes;
+  int pos, size;
+  int error_code = NO_ERROR;
+
+  load_args = &load_args_info;
+
+  load_args->btid = btid;
+  load_args->bt_name = leaves->load_args->bt_name;
+  db_make_null (&load_args->current_key);
+  VPID_SET_NULL (&load_args->nleaf.vpid);
+  load_args->nleaf.pgptr = NULL;
+  VPID_SET_NULL (&load_args->leaf.vpid);
+  load_args->leaf.pgptr = NULL;
+  VPID_SET_NULL (&load_args->ovf.vpid);
+  load_args->ovf.pgptr = NULL;
+  load_args->out_recdes = NULL;
+  load_args->push_list = NULL;
+  load_args->pop_list = NULL;
+  load_args->n_keys = 0;
+  load_args->curr_non_del_obj_count = 0;
+  VPID_SET_NULL (&load_args->vpid_first_leaf);
+  load_args->range = range;
+
+  load_args->leaf_nleaf_recdes.area_size = BTREE_MAX_KEYLEN_INPAGE + BTREE_MAX_OIDLEN_INPAGE;
+  load_args->leaf_nleaf_recdes.length = 0;
+  load_args->leaf_nleaf_recdes.type = REC_HOME;
+  load_args->leaf_nleaf_recdes.data = (char *) os_malloc (load_args->leaf_nleaf_recdes.area_size);
+  load_args->ovf_recdes.area_size = DB_PAGESIZE;
+  load_args->ovf_recdes.length = 0;
+  load_args->ovf_recdes.type = REC_HOME;
+  load_args->ovf_recdes.data = (char *) os_malloc (load_args->ovf_recdes.area_size);
+  if (load_args->leaf_nleaf_recdes.data == NULL || load_args->ovf_recdes.data == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      load_args->leaf_nleaf_recdes.area_size + load_args->ovf_recdes.area_size);
+      error_code = ER_OUT_OF_VIRTUAL_MEMORY;
+      goto end;
+    }
+
+  for (pos = 0; pos < range->length; pos += size)
+    {
+      recdes.length = recdes.area_size = *(int *) (range->area + pos);
+      recdes.type = REC_HOME;
+      recdes.data = range->area + pos + MAX_ALIGNMENT;
+      size = MAX_ALIGNMENT + DB_ALIGN (recdes.length, MAX_ALIGNMENT);
+
+      error_code = btree_construct_leafs (thread_p, &recdes, load_args);
+      if (error_code != NO_ERROR)
+	{
+	  goto end;
+	}
+    }
+
+  if (load_args->leaf.pgptr != NULL)
+    {
+      error_code = btree_save_last_leafrec (thread_p, load_args);
+      if (error_code != NO_ERROR)
+	{
+	  goto end;
+	}
+    }
+
+  range->first_leaf = load_args->vpid_first_leaf;
+  range->last_leaf = load_args->leaf.vpid;
+  range->n_keys = load_args->n_keys;
+
+end:
+  if (load_args->leaf.pgptr != NULL)
+    {
+      pgbuf_unfix_and_init (thread_p, load_args->leaf.pgptr);
+    }
+  if (load_args->ovf.pgptr != NULL)
+    {
+      pgbuf_unfix_and_init (thread_p, load_args->ovf.pgptr);
+    }
+  if (load_args->leaf_nleaf_recdes.data != NULL)
+    {
+      os_free_and_init (load_args->leaf_nleaf_recdes.data);
+    }
+  if (load_args->ovf_recdes.data != NULL)
+    {
+      os_free_and_init (load_args->ovf_recdes.data);
+    }
+  pr_clear_value (&load_args->current_key);
+
+  /* the sort items are not needed anymore */
+  free_and_init (range->area);
+
+  return error_code;
+}
+
+/*
+ * btree_load_range_execute () - build the leaves of a range of a parallel leaf build
+ *   return: void
+ *   thread_ref(in): a worker or the loading thread
+ *   leaves(in): parallel leaf build
+ *   range(in): range
+ *
+ * Note: The loading thread builds the range within the system operation of the load. A worker builds it in a system
+ *       transaction of its own and never changes the loading transaction: the pages it allocates and logs need no
+ *       undo, since the file of the index is destroyed with all its pages when the load fails, and the vacuum
+ *       notifications are logged by the loading thread (see btree_load_leaves_link). A worker uses its own copy of
+ *       the index, and never builds overflow keys.
+ */
+// *INDENT-OFF*
+static void
+btree_load_range_execute (cubthread::entry &thread_ref, BTREE_LOAD_LEAVES * leaves, BTREE_LOAD_RANGE * range)
+{
+  THREAD_ENTRY *thread_p = &thread_ref;
+  int length = 1024;
+
+  if (thread_p == leaves->loader)
+    {
+      range->error_code = btree_load_range_build (thread_p, leaves, range, leaves->load_args->btid);
+      if (range->error_code != NO_ERROR)
+	{
+	  (void) er_get_area_error (OR_ALIGNED_BUF_START (range->error_area), &length);
+	}
+      return;
+    }
+
+  thread_ref.claim_system_worker ();
+  log_sysop_start (thread_p);
+
+  range->error_code = btree_load_range_build (thread_p, leaves, range, &range->btid_int);
+  if (range->error_code != NO_ERROR)
+    {
+      if (er_errid () == NO_ERROR)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_GENERIC_ERROR, 0);
+	}
+      (void) er_get_area_error (OR_ALIGNED_BUF_START (range->error_area), &length);
+      log_sysop_abort (thread_p);
+    }
+  else
+    {
+      log_sysop_commit (thread_p);
+    }
+  er_clear ();
+
+  thread_ref.retire_system_worker ();
+}
+// *INDENT-ON*
+
+/*
+ * btree_load_read_sort_key () - read the key of a sort item, without copying it
+ *   return: error code
+ *   btid(in): the index
+ *   item(in): sort item
+ *   length(in): length of the sort item
+ *   key(out): key
+ */
+static int
+btree_load_read_sort_key (BTID_INT * btid, char *item, int length, DB_VALUE * key)
+{
+  OR_BUF buf;
+  int key_size = -1;
+  int oid_size = BTREE_IS_UNIQUE (btid->unique_pk) ? 2 * OR_OID_SIZE : OR_OID_SIZE;
+
+  or_init (&buf, item, length);
+
+  /* Skip forward link, value_has_null, OIDs and MVCCIDs; see btree_construct_leafs. */
+  if (or_advance (&buf, (int) sizeof (char *) + OR_INT_SIZE + oid_size + 2 * OR_MVCCID_SIZE) != NO_ERROR)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_TF_CORRUPTED, 0);
+      return ER_TF_CORRUPTED;
+    }
+
+  if (TP_DOMAIN_TYPE (btid->key_type) == DB_TYPE_MIDXKEY)
+    {
+      key_size = CAST_STRLEN (buf.endptr - buf.ptr);
+    }
+
+  if (btid->key_type->type->data_readval (&buf, key, btid->key_type, key_size, false, NULL, 0) != NO_ERROR)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_TF_CORRUPTED, 0);
+      return ER_TF_CORRUPTED;
+    }
+
+  return NO_ERROR;
+}
+#endif /* SERVER_MODE */
+
+/*
+ * compare_driver () -
+ *   return:
+ *   first(in):
+ *   second(in):
+ *   arg(in):
+ */
+static int
+compare_driver (const void *first, const void *second, void *arg)
+{
+  char *mem1 = *(char **) first;
+  char *mem2 = *(char **) second;
+  int has_null;
+  SORT_ARGS *sort_args;
+  TP_DOMAIN *key_type;
+  int c = DB_UNK;
+
+  sort_args = (SORT_ARGS *) arg;
+  key_type = sort_args->key_type;
+
+  assert (PTR_ALIGN (mem1, MAX_ALIGNMENT) == mem1);
+  assert (PTR_ALIGN (mem2, MAX_ALIGNMENT) == mem2);
+
+  /* Skip next link */
+  mem1 += sizeof (char *);
+  mem2 += sizeof (char *);
+
+  /* Read value_has_null */
+  assert (OR_GET_BYTE (mem1) == 0 || OR_GET_BYTE (mem1) == 1);
+  assert (OR_GET_BYTE (mem2) == 0 || OR_GET_BYTE (mem2) == 1);
+  has_null = (OR_GET_BYTE (mem1) || OR_GET_BYTE (mem2)) ? 1 : 0;
+
+  mem1 += OR_INT_SIZE;
+  mem2 += OR_INT_SIZE;
+
+  assert (PTR_ALIGN (mem1, INT_ALIGNMENT) == mem1);
+  assert (PTR_ALIGN (mem2, INT_ALIGNMENT) == mem2);
+
+  /* Skip the oids */
+  if (BTREE_IS_UNIQUE (sort_args->unique_pk))
+    {				/* unique index */
+      mem1 += (2 * OR_OID_SIZE);
+      mem2 += (2 * OR_OID_SIZE);
+    }
+  else
+    {				/* non-unique index */
+      mem1 += OR_OID_SIZE;
+      mem2 += OR_OID_SIZE;
+    }
+
+  assert (PTR_ALIGN (mem1, INT_ALIGNMENT) == mem1);
+  assert (PTR_ALIGN (mem2, INT_ALIGNMENT) == mem2);
+
+  /* Skip the MVCCID's */
+  mem1 += 2 * OR_MVCCID_SIZE;
+  mem2 += 2 * OR_MVCCID_SIZE;
+
+  assert (PTR_ALIGN (mem1, INT_ALIGNMENT) == mem1);
+  assert (PTR_ALIGN (mem2, INT_ALIGNMENT) == mem2);
+
+  if (TP_DOMAIN_TYPE (key_type) == DB_TYPE_MIDXKEY)
+    {
+      int i;
+      char *bitptr1, *bitptr2;
+      int bitmap_size;
+      TP_DOMAIN *dom;
+
+      /* fast implementation of pr_midxkey_compare (). do not use DB_VALUE container for speed-up */
+
+      bitptr1 = mem1;
+      bitptr2 = mem2;
+
+      bitmap_size = OR_MULTI_BOUND_BIT_BYTES (key_type->precision);
+
+      mem1 += bitmap_size;
+      mem2 += bitmap_size;
+
+#if !defined(NDEBUG)
+      for (i = 0, dom = key_type->setdomain; dom; dom = dom->next, i++);
+      assert (i == key_type->precision);
+#endif
+
+      if (sort_args->func_index_info != NULL)
+	{
+	  assert (sort_args->n_attrs <= key_type->precision);
+	}
+      else
+	{
+	  assert (sort_args->n_attrs == key_type->precision);
+	}
+      assert (key_type->setdomain != NULL);
+
+      for (i = 0, dom = key_type->setdomain; i < key_type->precision && dom; i++, dom = dom->next)
+	{
+	  /* val1 or val2 is NULL */
+	  if (has_null)
+	    {
+	      if (OR_MULTI_ATT_IS_UNBOUND (bitptr1, i))
+		{		/* element val is null? */
+		  if (OR_MULTI_ATT_IS_UNBOUND (bitptr2, i))
+		    {
+		      continue;
+		    }
+
+		  c = DB_LT;
+		  break;	/* exit for-loop */
+		}
+	      else if (OR_MULTI_ATT_IS_UNBOUND (bitptr2, i))
+		{
+		  c = DB_GT;
+		  break;	/* exit for-loop */
+		}
+	    }
+
+	  /* check for val1 and val2 same domain */
+	  c = dom->type->index_cmpdisk (mem1, mem2, dom, 0, 1, NULL);
+	  assert (c == DB_LT || c == DB_EQ || c == DB_GT);
+
+	  if (c != DB_EQ)
+	    {
+	      break;		/* exit for-loop */
+	    }
+
+	  mem1 += pr_midxkey_element_disk_size (mem1, dom);
+	  mem2 += pr_midxkey_element_disk_size (mem2, dom);
+	}			/* for (i = 0; ... ) */
+      assert (c == DB_LT || c == DB_EQ || c == DB_GT);
+
+      if (dom && dom->is_desc)
+	{
+	  c = ((c == DB_GT) ? DB_LT : (c == DB_LT) ? DB_GT : c);
+	}
+    }
+  else
+    {
       OR_BUF buf_val1, buf_val2;
       DB_VALUE val1, val2;
 
@@ -4592,7 +6539,7 @@ xbtree_load_online_index (THREAD_ENTRY * thread_p, BTID * btid, const char *bt_n
       ret =
 	online_index_builder (thread_p, &btid_int, &hfids[cur_class], &class_oids[cur_class], n_classes, attr_ids,
 			      n_attrs, func_index_info, filter_pred, attrs_prefix_length, &attr_info, &scan_cache,
-			      unique_pk, ib_thread_count, key_type);
+			      unique_pk, ib_thread_count, key_type, pred_stream, pred_stream_size);
       if (ret != NO_ERROR)
 	{
 	  break;
@@ -4805,49 +6752,188 @@ static int
 online_index_builder (THREAD_ENTRY * thread_p, BTID_INT * btid_int, HFID * hfids, OID * class_oids, int n_classes,
 		      int *attrids, int n_attrs, FUNCTION_INDEX_INFO func_idx_info,
 		      PRED_EXPR_WITH_CONTEXT * filter_pred, int *attrs_prefix_length, HEAP_CACHE_ATTRINFO * attr_info,
-		      HEAP_SCANCACHE * scancache, int unique_pk, int ib_thread_count, const TP_DOMAIN * key_type)
+		      HEAP_SCANCACHE * scancache, int unique_pk, int ib_thread_count, const TP_DOMAIN * key_type,
+		      char *pred_stream, int pred_stream_size)
+{
+  int ret = NO_ERROR;
+  FUNCTION_INDEX_INFO *p_func_idx_info;
+  BTREE_LOAD_PAGES *pages = NULL;
+  index_builder_loader_context load_context;
+  bool is_parallel = ib_thread_count > 0;
+#if defined (SERVER_MODE)
+  BTREE_LOAD_PX *px = NULL;
+  int degree, i;
+#endif /* SERVER_MODE */
+
+  // a worker pool is built only of loading is done in parallel
+  cubthread::entry_workpool *ib_workpool =
+    is_parallel ?
+    thread_get_manager()->create_worker_pool (ib_thread_count, 32, "Online index loader pool", &load_context, 1,
+                                              btree_is_worker_pool_logging_true ())
+    : NULL;
+
+  p_func_idx_info = func_idx_info.expr ? &func_idx_info : NULL;
+
+  load_context.m_has_error = false;
+  load_context.m_error_code = NO_ERROR;
+  load_context.m_tasks_started = 0UL;
+  load_context.m_tasks_executed = 0UL;
+  load_context.m_key_type = key_type;
+
+#if defined (SERVER_MODE)
+  /* Extract the keys with parallel_scan_degree participants if the heap file is large enough; the keys are
+   * dispatched by each participant. */
+  degree = is_parallel ? prm_get_integer_value (PRM_ID_PARALLEL_SCAN_DEGREE) : 1;
+  if (degree > 1)
+    {
+      /* workers that start late still hold a reference to px */
+      px = (BTREE_LOAD_PX *) malloc (sizeof (BTREE_LOAD_PX));
+      if (px == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (BTREE_LOAD_PX));
+	  thread_get_manager ()->destroy_worker_pool (ib_workpool);
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
+	}
+      ret = btree_load_px_init (thread_p, px, hfids, 1, pred_stream, pred_stream_size, p_func_idx_info, &degree);
+      if (ret != NO_ERROR || degree <= 1)
+	{
+	  free_and_init (px);
+	}
+      if (ret != NO_ERROR)
+	{
+	  thread_get_manager ()->destroy_worker_pool (ib_workpool);
+	  return ret;
+	}
+    }
+  if (px != NULL)
+    {
+      px->btid_int = btid_int;
+      px->hfid = hfids;
+      px->class_oid = class_oids;
+      px->attrids = attrids;
+      px->n_attrs = n_attrs;
+      px->attrs_prefix_length = attrs_prefix_length;
+      px->snapshot = scancache->mvcc_snapshot;
+      px->unique_pk = unique_pk;
+      px->load_context = &load_context;
+      px->ib_workpool = ib_workpool;
+      px->ref_count += degree - 1;
+      pages = &px->pages;
+
+      for (i = 0; i < degree - 1; i++)
+	{
+	  cubthread::entry_callable_task *task =
+	    new cubthread::entry_callable_task (std::bind (online_index_builder_px_execute, std::placeholders::_1,
+							   px));
+	  css_push_external_task (css_get_current_conn_entry (), task);
+	}
+    }
+#endif /* SERVER_MODE */
+
+  /* Extract from heap and dispatch the keys. */
+  ret = online_index_builder_extract (thread_p, btid_int, hfids, class_oids, attrids, n_attrs, p_func_idx_info,
+				      filter_pred, attrs_prefix_length, attr_info, scancache, unique_pk, load_context,
+				      ib_workpool, pages);
+
+#if defined (SERVER_MODE)
+  if (pages != NULL)
+    {
+      if (ret != NO_ERROR)
+	{
+	  /* Also stop the other participants. */
+	  btree_load_pages_stop (pages);
+	  load_context.m_has_error = true;
+	}
+      btree_load_px_wait_workers (px);
+      btree_load_px_destroy (px);
+      px = NULL;
+    }
+#endif /* SERVER_MODE */
+
+  /* Check if the worker pool is empty */
+  if (ret == NO_ERROR)
+    {
+      do
+	{
+	  bool dummy_continue_checking = true;
+
+	  if (load_context.m_has_error != NO_ERROR)
+	    {
+	      /* Also stop all threads. */
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_IB_ERROR_ABORT, 0);
+	      ret = load_context.m_error_code;
+	      break;
+	    }
+
+	  /* Wait for threads to finish. */
+	  thread_sleep (10);
+
+	  /* Check for interrupts. */
+	  if (logtb_is_interrupted (thread_p, true, &dummy_continue_checking))
+	    {
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_INTERRUPTED, 0);
+	      ret = ER_INTERRUPTED;
+	      break;
+	    }
+	}
+      while (load_context.m_tasks_executed != load_context.m_tasks_started);
+    }
+
+  thread_get_manager ()->destroy_worker_pool (ib_workpool);
+
+  return ret;
+}
+
+/*
+ * online_index_builder_extract () - extract the keys of a heap file and dispatch them to the loader pool
+ *   return: error code
+ *   pages(in): chunks of heap pages to claim for parallel extraction; NULL to extract the whole heap file
+ *
+ * Note: Other arguments are those of online_index_builder, owned by the calling thread.
+ */
+static int
+online_index_builder_extract (THREAD_ENTRY * thread_p, BTID_INT * btid_int, HFID * hfid, OID * class_oid,
+			      int *attrids, int n_attrs, FUNCTION_INDEX_INFO * func_idx_info,
+			      PRED_EXPR_WITH_CONTEXT * filter_pred, int *attrs_prefix_length,
+			      HEAP_CACHE_ATTRINFO * attr_info, HEAP_SCANCACHE * scancache, int unique_pk,
+			      index_builder_loader_context & load_context, cubthread::entry_workpool * ib_workpool,
+			      BTREE_LOAD_PAGES * pages)
 {
   int ret = NO_ERROR, eval_res;
   OID cur_oid;
   RECDES cur_record;
-  int cur_class;
   SCAN_CODE sc;
-  FUNCTION_INDEX_INFO *p_func_idx_info;
   PR_EVAL_FNC filter_eval_fnc;
   DB_TYPE single_node_type = DB_TYPE_NULL;
-  int attr_offset;
   DB_VALUE *p_dbvalue;
   int *p_prefix_length;
-  uint64_t tasks_started = 0;
   char midxkey_buf[DBVAL_BUFSIZE + MAX_ALIGNMENT], *aligned_midxkey_buf;
-  index_builder_loader_context load_context;
-  bool is_parallel = ib_thread_count > 0;
+#if defined (SERVER_MODE)
+  int cur_class, first_page, n_pages;
+#endif /* SERVER_MODE */
 
   std::unique_ptr<index_builder_loader_task> load_task = NULL;
 
-  // a worker pool is built only of loading is done in parallel
-  cubthread::entry_workpool *ib_workpool =
-    is_parallel ?
-    thread_get_manager()->create_worker_pool (ib_thread_count, 32, "Online index loader pool", &load_context, 1,
-                                              btree_is_worker_pool_logging_true ())
-    : NULL;
-
   aligned_midxkey_buf = PTR_ALIGN (midxkey_buf, MAX_ALIGNMENT);
-  p_func_idx_info = func_idx_info.expr ? &func_idx_info : NULL;
   filter_eval_fnc = (filter_pred != NULL) ? eval_fnc (thread_p, filter_pred->pred, &single_node_type) : NULL;
 
   /* Get the first entry from heap. */
-  cur_class = 0;
   OID_SET_NULL (&cur_oid);
-  cur_oid.volid = hfids[cur_class].vfid.volid;
+  cur_oid.volid = hfid->vfid.volid;
 
   /* Do not let the page fixed after an extract. */
   scancache->cache_last_fix_page = false;
 
-  load_context.m_has_error = false;
-  load_context.m_error_code = NO_ERROR;
-  load_context.m_tasks_executed = 0UL;
-  load_context.m_key_type = key_type;
+#if defined (SERVER_MODE)
+  if (pages != NULL)
+    {
+      if (!btree_load_pages_claim (pages, &cur_class, &first_page, &n_pages))
+	{
+	  return NO_ERROR;
+	}
+      heap_scancache_set_page_set (scancache, &pages->pages[first_page], n_pages);
+    }
+#endif /* SERVER_MODE */
 
   /* Start extracting from heap. */
   for (;;)
@@ -4857,11 +6943,9 @@ online_index_builder (THREAD_ENTRY * thread_p, BTID_INT * btid_int, HFID * hfids
       db_make_null (&dbvalue);
 
       /* Scan from heap and insert into the index. */
-      attr_offset = cur_class * n_attrs;
-
       cur_record.data = NULL;
 
-      sc = heap_next (thread_p, &hfids[cur_class], &class_oids[cur_class], &cur_oid, &cur_record, scancache, COPY);
+      sc = heap_next (thread_p, hfid, class_oid, &cur_oid, &cur_record, scancache, COPY);
       if (sc == S_ERROR)
 	{
 	  ASSERT_ERROR_AND_SET (ret);
@@ -4869,6 +6953,15 @@ online_index_builder (THREAD_ENTRY * thread_p, BTID_INT * btid_int, HFID * hfids
 	}
       else if (sc == S_END)
 	{
+#if defined (SERVER_MODE)
+	  if (pages != NULL && btree_load_pages_claim (pages, &cur_class, &first_page, &n_pages))
+	    {
+	      /* Continue with the next chunk. */
+	      heap_scancache_set_page_set (scancache, &pages->pages[first_page], n_pages);
+	      OID_SET_NULL (&cur_oid);
+	      continue;
+	    }
+#endif /* SERVER_MODE */
 	  break;
 	}
 
@@ -4896,10 +6989,9 @@ online_index_builder (THREAD_ENTRY * thread_p, BTID_INT * btid_int, HFID * hfids
 	    }
 	}
 
-      if (p_func_idx_info && p_func_idx_info->expr)
+      if (func_idx_info && func_idx_info->expr)
 	{
-	  ret = heap_attrinfo_read_dbvalues (thread_p, &cur_oid, &cur_record, NULL,
-					     p_func_idx_info->expr->cache_attrinfo);
+	  ret = heap_attrinfo_read_dbvalues (thread_p, &cur_oid, &cur_record, NULL, func_idx_info->expr->cache_attrinfo);
 	  if (ret != NO_ERROR)
 	    {
 	      break;
@@ -4923,8 +7015,8 @@ online_index_builder (THREAD_ENTRY * thread_p, BTID_INT * btid_int, HFID * hfids
 	}
 
       /* Generate the key. */
-      p_dbvalue = heap_attrinfo_generate_key (thread_p, n_attrs, &attrids[attr_offset], p_prefix_length, attr_info,
-					      &cur_record, &dbvalue, aligned_midxkey_buf, p_func_idx_info);
+      p_dbvalue = heap_attrinfo_generate_key (thread_p, n_attrs, attrids, p_prefix_length, attr_info, &cur_record,
+					      &dbvalue, aligned_midxkey_buf, func_idx_info);
       if (p_dbvalue == NULL)
 	{
 	  ret = ER_FAILED;
@@ -4935,15 +7027,14 @@ online_index_builder (THREAD_ENTRY * thread_p, BTID_INT * btid_int, HFID * hfids
       if (load_task == NULL)
         {
           // create a new task
-	  load_task.reset (new index_builder_loader_task (btid_int->sys_btid, &class_oids[cur_class], unique_pk,
-							  load_context));
+	  load_task.reset (new index_builder_loader_task (btid_int->sys_btid, class_oid, unique_pk, load_context));
         }
       if (load_task->add_key (p_dbvalue, cur_oid) == index_builder_loader_task::BATCH_FULL)
         {
           // send task to worker pool for execution
 	  thread_get_manager ()->push_task (ib_workpool, load_task.release ());
 	  /* Increment tasks started. */
-	  tasks_started++;
+	  load_context.m_tasks_started++;
         }
 
       /* Clear index key. */
@@ -4959,46 +7050,160 @@ online_index_builder (THREAD_ENTRY * thread_p, BTID_INT * btid_int, HFID * hfids
 	}
     }
 
-  /* Check if the worker pool is empty */
-  if (ret == NO_ERROR)
+  if (ret == NO_ERROR && load_task != NULL && load_task->has_keys ())
     {
-      if (load_task != NULL && load_task->has_keys ())
-        {
-          // one last task
-          thread_get_manager ()->push_task (ib_workpool, load_task.release ());
-          /* Increment tasks started. */
-          tasks_started++;
-        }
-      do
+      // one last task
+      thread_get_manager ()->push_task (ib_workpool, load_task.release ());
+      /* Increment tasks started. */
+      load_context.m_tasks_started++;
+    }
+
+  return ret;
+}
+
+#if defined (SERVER_MODE)
+/*
+ * online_index_builder_px_execute () - extraction worker of a parallel online index load
+ *   return: void
+ *   thread_ref(in): worker thread
+ *   px(in): parallel extraction
+ *
+ * Note: The worker has its own heap scan, attribute caches and predicates; it uses the snapshot of the builder.
+ *       Errors are reported through the loader context, like those of the loader tasks.
+ */
+static void
+online_index_builder_px_execute (cubthread::entry &thread_ref, BTREE_LOAD_PX * px)
+{
+  THREAD_ENTRY *thread_p = &thread_ref;
+  HEAP_SCANCACHE scan_cache;
+  HEAP_CACHE_ATTRINFO attr_info;
+  PRED_EXPR_WITH_CONTEXT *filter_pred = NULL;
+  FUNCTION_INDEX_INFO func_index_info;
+  XASL_UNPACK_INFO *func_unpack_info = NULL;
+  bool scan_cache_inited = false;
+  bool attr_info_inited = false;
+  int ret = NO_ERROR;
+
+  if (!btree_load_px_enter (px))
+    {
+      /* the builder already extracted the whole heap */
+      return;
+    }
+
+  /* read on behalf of the builder transaction, with its snapshot; the keys are inserted by the loader tasks */
+  thread_share_tran (&thread_ref, px->tran_index);
+  pthread_mutex_unlock (&thread_ref.tran_index_lock);
+
+  func_index_info.expr = NULL;
+
+  if (px->pred_stream != NULL)
+    {
+      ret = stx_map_stream_to_filter_pred (thread_p, &filter_pred, px->pred_stream, px->pred_stream_size);
+      if (ret != NO_ERROR)
 	{
-	  bool dummy_continue_checking = true;
+	  goto end;
+	}
+    }
+  if (px->func_index_info != NULL)
+    {
+      func_index_info = *px->func_index_info;
+      func_index_info.expr = NULL;
+      ret = stx_map_stream_to_func_pred (thread_p, &func_index_info.expr, func_index_info.expr_stream,
+					 func_index_info.expr_stream_size, &func_unpack_info);
+      if (ret != NO_ERROR)
+	{
+	  goto end;
+	}
+    }
 
-	  if (load_context.m_has_error != NO_ERROR)
-	    {
-	      /* Also stop all threads. */
-	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_IB_ERROR_ABORT, 0);
-	      ret = load_context.m_error_code;
-	      break;
-	    }
+  ret = heap_scancache_start (thread_p, &scan_cache, px->hfid, px->class_oid, false, false, NULL);
+  if (ret != NO_ERROR)
+    {
+      goto end;
+    }
+  scan_cache_inited = true;
+  scan_cache.mvcc_snapshot = px->snapshot;
 
-	  /* Wait for threads to finish. */
-	  thread_sleep (10);
+  ret = heap_attrinfo_start (thread_p, px->class_oid, px->n_attrs, px->attrids, &attr_info);
+  if (ret != NO_ERROR)
+    {
+      goto end;
+    }
+  attr_info_inited = true;
+  if (filter_pred != NULL)
+    {
+      ret = heap_attrinfo_start (thread_p, px->class_oid, filter_pred->num_attrs_pred, filter_pred->attrids_pred,
+				 filter_pred->cache_pred);
+      if (ret != NO_ERROR)
+	{
+	  goto end;
+	}
+    }
+  if (func_index_info.expr != NULL)
+    {
+      ret = heap_attrinfo_start (thread_p, px->class_oid, px->n_attrs, px->attrids,
+				 func_index_info.expr->cache_attrinfo);
+      if (ret != NO_ERROR)
+	{
+	  goto end;
+	}
+    }
 
-	  /* Check for interrupts. */
-	  if (logtb_is_interrupted (thread_p, true, &dummy_continue_checking))
-	    {
-	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_INTERRUPTED, 0);
-	      ret = ER_INTERRUPTED;
-	      break;
-	    }
+  ret = online_index_builder_extract (thread_p, px->btid_int, px->hfid, px->class_oid, px->attrids, px->n_attrs,
+				      func_index_info.expr != NULL ? &func_index_info : NULL, filter_pred,
+				      px->attrs_prefix_length, &attr_info, &scan_cache, px->unique_pk,
+				      *px->load_context, px->ib_workpool, &px->pages);
+
+end:
+  if (ret != NO_ERROR)
+    {
+      btree_load_pages_stop (&px->pages);
+      if (!px->load_context->m_has_error.exchange (true))
+	{
+	  px->load_context->m_error_code = ret;
 	}
-      while (load_context.m_tasks_executed != tasks_started);
     }
 
-  thread_get_manager ()->destroy_worker_pool (ib_workpool);
+  if (attr_info_inited)
+    {
+      heap_attrinfo_end (thread_p, &attr_info);
+      if (filter_pred != NULL)
+	{
+	  heap_attrinfo_end (thread_p, filter_pred->cache_pred);
+	}
+      if (func_index_info.expr != NULL)
+	{
+	  heap_attrinfo_end (thread_p, func_index_info.expr->cache_attrinfo);
+	}
+    }
+  if (scan_cache_inited)
+    {
+      heap_scancache_end (thread_p, &scan_cache);
+    }
+  if (filter_pred != NULL)
+    {
+      qexec_clear_pred_context (thread_p, filter_pred, true);
+      if (filter_pred->unpack_info != NULL)
+	{
+	  free_xasl_unpack_info (thread_p, filter_pred->unpack_info);
+	}
+      db_private_free_and_init (thread_p, filter_pred);
+    }
+  if (func_index_info.expr != NULL)
+    {
+      (void) qexec_clear_func_pred (thread_p, func_index_info.expr);
+    }
+  if (func_unpack_info != NULL)
+    {
+      free_xasl_unpack_info (thread_p, func_unpack_info);
+    }
+  er_clear ();
+  thread_end_share_tran (&thread_ref);
 
-  return ret;
+  /* px may be freed as soon as the worker is reported; do not touch it afterwards */
+  btree_load_px_leave (px);
 }
+#endif /* SERVER_MODE */
 
 static bool
 btree_is_worker_pool_logging_true ()
@@ -5031,7 +7236,6 @@ index_builder_loader_task::index_builder_loader_task (const BTID *btid, const OI
   BTID_COPY (&m_btid, btid);
   COPY_OID (&m_class_oid, class_oid);
   m_unique_pk = unique_pk;
-  m_load_context.m_has_error = false;
   m_memsize = 0;
 }
 
@@ -2072,8 +2072,10 @@ dwb_write_block (THREAD_ENTRY * thread_p, DWB_BLOCK * block, DWB_SLOT * p_dwb_or
   VPID *vpid;
   int error_code = NO_ERROR;
   int count_writes = 0, num_pages_to_sync;
+  int count_queued = 0, count_written, queue_depth;
   FLUSH_VOLUME_INFO *current_flush_volume_info = NULL;
   bool can_flush_volume = false;
+  FILEIO_BATCH batch;
 
   assert (block != NULL && p_dwb_ordered_slots != NULL);
 
@@ -2091,6 +2093,10 @@ dwb_write_block (THREAD_ENTRY * thread_p, DWB_BLOCK * block, DWB_SLOT * p_dwb_or
   last_written_volid = NULL_VOLID;
   last_written_vol_fd = NULL_VOLDES;
 
+  /* with io_uring backend, the writes of consecutive pages of a volume are submitted together */
+  queue_depth = prm_get_integer_value (PRM_ID_IO_QUEUE_DEPTH);
+  fileio_batch_begin (thread_p, &batch, prm_get_integer_value (PRM_ID_IO_BACKEND), queue_depth);
+
   for (i = 0; i < block->count_wb_pages; i++)
     {
       vpid = &p_dwb_ordered_slots[i].vpid;
@@ -2135,14 +2141,44 @@ dwb_write_block (THREAD_ENTRY * thread_p, DWB_BLOCK * block, DWB_SLOT * p_dwb_or
 	      && p_dwb_ordered_slots[i].vpid.volid == p_dwb_ordered_slots[i].io_page->prv.volid);
 
       /* Write the data. */
-      if (fileio_write (thread_p, last_written_vol_fd, p_dwb_ordered_slots[i].io_page, vpid->pageid, IO_PAGESIZE,
-			FILEIO_WRITE_NO_COMPENSATE_WRITE) == NULL)
+      if (fileio_batch_is_async (&batch))
+	{
+	  (void) fileio_batch_add_write (&batch, last_written_vol_fd, p_dwb_ordered_slots[i].io_page, vpid->pageid,
+					 IO_PAGESIZE, NULL);
+	  count_queued++;
+
+	  dwb_log ("dwb_write_block: queued page = (%d,%d) LSA=(%lld,%d)\n",
+		   vpid->volid, vpid->pageid, p_dwb_ordered_slots[i].io_page->prv.lsa.pageid,
+		   (int) p_dwb_ordered_slots[i].io_page->prv.lsa.offset);
+
+	  if (count_queued < queue_depth && p_dwb_ordered_slots[i + 1].vpid.volid == vpid->volid)
+	    {
+	      /* next page is of same volume; keep queueing */
+	      continue;
+	    }
+
+	  /* the pages are counted for volume flush only after they were written */
+	  count_written = count_queued;
+	  count_queued = 0;
+	  error_code = fileio_batch_wait (&batch);
+	}
+      else
+	{
+	  count_written = 1;
+	  if (fileio_write (thread_p, last_written_vol_fd, p_dwb_ordered_slots[i].io_page, vpid->pageid, IO_PAGESIZE,
+			    FILEIO_WRITE_NO_COMPENSATE_WRITE) == NULL)
+	    {
+	      ASSERT_ERROR_AND_SET (error_code);
+	    }
+	}
+
+      if (error_code != NO_ERROR)
 	{
-	  ASSERT_ERROR ();
 	  dwb_log_error ("DWB write page VPID=(%d, %d) LSA=(%lld,%d) with %d error: \n",
 			 vpid->volid, vpid->pageid, p_dwb_ordered_slots[i].io_page->prv.lsa.pageid,
-			 (int) p_dwb_ordered_slots[i].io_page->prv.lsa.offset, er_errid ());
+			 (int) p_dwb_ordered_slots[i].io_page->prv.lsa.offset, error_code);
 	  assert (false);
+	  (void) fileio_batch_end (&batch);
 	  /* Something wrong happened. */
 	  return ER_FAILED;
 	}
@@ -2154,8 +2190,8 @@ dwb_write_block (THREAD_ENTRY * thread_p, DWB_BLOCK * block, DWB_SLOT * p_dwb_or
 #if defined (SERVER_MODE)
       assert (current_flush_volume_info != NULL);
 
-      ATOMIC_INC_32 (&current_flush_volume_info->num_pages, 1);
-      count_writes++;
+      ATOMIC_INC_32 (&current_flush_volume_info->num_pages, count_written);
+      count_writes += count_written;
 
       if (helper_can_flush && (count_writes >= num_pages_to_sync || can_flush_volume == true)
 	  && dwb_is_flush_block_helper_daemon_available ())
@@ -2173,6 +2209,9 @@ dwb_write_block (THREAD_ENTRY * thread_p, DWB_BLOCK * block, DWB_SLOT * p_dwb_or
 #endif
     }
 
+  assert (count_queued == 0);
+  (void) fileio_batch_end (&batch);
+
   /* the last written volume */
   if (current_flush_volume_info != NULL)
     {
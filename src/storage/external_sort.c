@@ -51,6 +51,7 @@
 #include "server_support.h"
 #include "thread_entry_task.hpp"
 #include "thread_manager.hpp"	// for thread_get_thread_entry_info and thread_sleep
+#include "parallel_sort.hpp"
 
 #include <functional>
 
@@ -71,6 +72,9 @@
  */
 #define SORT_MIN_HALF_FILES      2
 
+/* Partitions of the internal memory sorted in parallel have at least this many records */
+#define SORT_PARTITION_RUN_SIZE_MIN (16 * ONE_K)
+
 /* Initial size of the dynamic array that keeps the file contents list */
 #define SORT_INITIAL_DYN_ARRAY_SIZE 30
 
@@ -118,30 +122,6 @@ struct vol_list
   VOL_INFO *vol_info;		/* array of volume information */
 };
 
-/* Parallel eXecution and communition node */
-typedef struct px_tree_node PX_TREE_NODE;
-struct px_tree_node
-{
-  int px_id;			/* node ID */
-#if defined(SERVER_MODE)
-  int px_status;		/* node status; access through px_mtx */
-#endif				/* SERVER_MODE */
-
-  int px_height;		/* tournament tree: node level */
-  int px_myself;		/* tournament tree: node ID */
-
-  int px_tran_index;
-
-  void *px_arg;			/* operation info */
-
-  char **px_buff;
-  char **px_vector;
-  long px_vector_size;
-
-  char **px_result;		/* output */
-  long px_result_size;		/* output */
-};
-
 typedef struct sort_param SORT_PARAM;
 struct sort_param
 {
@@ -176,12 +156,7 @@ struct sort_param
   int limit;
 
   /* support parallelism */
-#if defined(SERVER_MODE)
-  pthread_mutex_t px_mtx;	/* px_node status mutex */
-#endif
-  int px_height_max;		/* px_node tournament tree max level */
-  int px_array_size;		/* px_node array size */
-  PX_TREE_NODE *px_array;	/* px_node array */
+  parallel_sort *px_sort;	/* sorts the internal memory on worker threads */
 };
 
 typedef struct sort_rec_list SORT_REC_LIST;
@@ -243,12 +218,9 @@ typedef void MERGE_RUN_FN (char **, char **, SORT_STACK *, SORT_CMP_FUNC *, void
 #if !defined(NDEBUG)
 static int sort_validate (char **vector, long size, SORT_CMP_FUNC * compare, void *comp_arg);
 #endif
-static PX_TREE_NODE *px_sort_assign (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, int px_id, char **px_buff,
-				     char **px_vector, long px_vector_size, int px_height, int px_myself);
-static int px_sort_myself (THREAD_ENTRY * thread_p, PX_TREE_NODE * px_node);
-#if defined(SERVER_MODE)
-static int px_sort_communicate (PX_TREE_NODE * px_node);
-#endif
+static void px_sort_create (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param);
+static char **px_sort_partitions (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, char **buff, char **vector,
+				  long vector_size, long *result_size);
 
 static int sort_inphase_sort (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, SORT_GET_FUNC * get_next,
 			      void *arguments, unsigned int *total_numrecs);
@@ -1343,16 +1315,10 @@ sort_listfile (THREAD_ENTRY * thread_p, INT16 volid, int est_inp_pg_cnt, SORT_GE
 {
   int error = NO_ERROR;
   SORT_PARAM *sort_param = NULL;
-  bool prm_enable_sort_parallel = false;	/* TODO - PRM_SORT_PARALLEL_SORT */
   INT32 input_pages;
   int i;
   int file_pg_cnt_est;
   unsigned int total_numrecs = 0;
-#if defined(SERVER_MODE)
-  int num_cpus;
-  int rv;
-#endif /* SERVER_MODE */
-
   thread_set_sort_stats_active (thread_p, true);
 
 #if defined(ENABLE_SYSTEMTAP)
@@ -1367,19 +1333,6 @@ sort_listfile (THREAD_ENTRY * thread_p, INT16 volid, int est_inp_pg_cnt, SORT_GE
       return error;
     }
 
-#if defined(SERVER_MODE)
-  rv = pthread_mutex_init (&(sort_param->px_mtx), NULL);
-  if (rv != 0)
-    {
-      error = ER_CSS_PTHREAD_MUTEX_INIT;
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, error, 0);
-
-      free_and_init (sort_param);
-
-      return error;
-    }
-#endif /* SERVER_MODE */
-
   sort_param->cmp_fn = cmp_fn;
   sort_param->cmp_arg = cmp_arg;
   sort_param->option = option;
@@ -1397,8 +1350,7 @@ sort_listfile (THREAD_ENTRY * thread_p, INT16 volid, int est_inp_pg_cnt, SORT_GE
       sort_param->file_contents[i].num_pages = NULL;
     }
   sort_param->internal_memory = NULL;
-  sort_param->px_height_max = sort_param->px_array_size = 0;
-  sort_param->px_array = NULL;
+  sort_param->px_sort = NULL;
 
   /* initialize temp. overflow file. Real value will be assigned in sort_inphase_sort function, if long size sorting
    * records are encountered. */
@@ -1468,34 +1420,7 @@ sort_listfile (THREAD_ENTRY * thread_p, INT16 volid, int est_inp_pg_cnt, SORT_GE
   sort_param->tmp_file_pgs = CEIL_PTVDIV (input_pages, sort_param->half_files);
   sort_param->tmp_file_pgs = MAX (1, sort_param->tmp_file_pgs);
 
-  sort_param->px_height_max = 0;	/* init */
-  sort_param->px_array_size = 1;	/* init */
-
-#if 1				/* TODO - currently, disable parallelism */
-  prm_enable_sort_parallel = false;
-#endif
-
-#if defined(SERVER_MODE)
-  if (prm_enable_sort_parallel == true)
-    {
-      /* TODO - calc n, 2^^n get the number of CPUs TODO - fileio_os_sysconf really get #cores instead of #CPUs -
-       * NEED MORE CONSIDERATION */
-      num_cpus = fileio_os_sysconf ();
-
-      sort_param->px_height_max = (int) sqrt ((double) num_cpus);	/* n */
-      sort_param->px_array_size = num_cpus;	/* 2^^n */
-
-      assert_release (sort_param->px_array_size == pow ((double) 2, (double) sort_param->px_height_max));
-    }
-#endif /* SERVER_MODE */
-
-  sort_param->px_array = (PX_TREE_NODE *) malloc (sort_param->px_array_size * sizeof (PX_TREE_NODE));
-  if (sort_param->px_array == NULL)
-    {
-      error = ER_OUT_OF_VIRTUAL_MEMORY;
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, error, 1, (sort_param->px_array_size * sizeof (PX_TREE_NODE)));
-      goto cleanup;
-    }
+  px_sort_create (thread_p, sort_param);
 
   /*
    * Don't allocate any temp files yet, since we may not need them.
@@ -1590,553 +1515,99 @@ sort_validate (char **vector, long size, SORT_CMP_FUNC * compare, void *comp_arg
 #endif
 
 /*
- * px_sort_assign() -
+ * px_sort_create() - create the sorter of the internal memory
  *   return:
  *   thread_p(in):
  *   sort_param(in): sort parameters
- *   px_id(in):
- *   px_buff(in):
- *   px_vector(in):
- *   px_vector_size(in):
- *   px_height(in):
- *   px_myself(in):
  *
  * NOTE: support parallelism
+ *
+ * The degree of parallelism is limited by the number of CPUs. Workers run on behalf of the sorting transaction, but
+ * they only compare records of the internal memory; they never fix pages, take locks or log. The transaction is
+ * marked as shared by them, so logtb_check_tran_owner rejects any change they would try.
  */
-static PX_TREE_NODE *
-px_sort_assign (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, int px_id, char **px_buff, char **px_vector,
-		long px_vector_size, int px_height, int px_myself)
+static void
+px_sort_create (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param)
 {
-  PX_TREE_NODE *px_node;
-#if defined(SERVER_MODE)
-  int rv = NO_ERROR;
-#endif
-
-  assert (sort_param != NULL);
+  int px_degree = 1;
+  int tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
 
-  if (px_height < 0 || px_height > sort_param->px_height_max)
+  // *INDENT-OFF*
+  parallel_sort::push_func push;
+  parallel_sort::run_sort_func run_sort =
+    [sort_param] (THREAD_ENTRY * thread_p, char **vector, long size, char **buff, long *result_size)
     {
-      assert_release (false);
-      return NULL;
-    }
-
-  if (px_id < 0 || px_id >= sort_param->px_array_size)
-    {
-      assert_release (false);
-      return NULL;
-    }
-
-  if (px_myself < 0 || px_myself > px_id)
-    {
-      assert_release (false);
-      return NULL;
-    }
-
-  px_node = &(sort_param->px_array[px_id]);
+      *result_size = size;
+      return sort_run_sort (thread_p, sort_param, vector, size, 0 /* dummy */ , buff, result_size);
+    };
 
 #if defined(SERVER_MODE)
-  rv = pthread_mutex_lock (&(sort_param->px_mtx));
-  assert (rv == NO_ERROR);
-
-#if !defined(NDEBUG)
-  if (px_node->px_status != 0)
+  px_degree = MIN (prm_get_integer_value (PRM_ID_SORT_PARALLEL_DEGREE), fileio_os_sysconf ());
+  push = [tran_index] (const parallel_sort::task_func & task)
     {
-      assert (false);
-      pthread_mutex_unlock (&(sort_param->px_mtx));
-      return NULL;
-    }
-#endif
-
-  px_node->px_status = 0;
-
-  pthread_mutex_unlock (&(sort_param->px_mtx));
+      cubthread::entry_callable_task *callable =
+        new cubthread::entry_callable_task ([tran_index, task] (cubthread::entry & thread_ref)
+          {
+            bool old_check_interrupt;
+
+            /* compare on behalf of the sorting transaction, which the worker must never change */
+            thread_share_tran (&thread_ref, tran_index);
+            pthread_mutex_unlock (&thread_ref.tran_index_lock);
+
+            old_check_interrupt = logtb_set_check_interrupt (&thread_ref, false);
+            task (&thread_ref);
+            (void) logtb_set_check_interrupt (&thread_ref, old_check_interrupt);
+
+            thread_end_share_tran (&thread_ref);
+          });
+      css_push_external_task (css_get_current_conn_entry (), callable);
+    };
 #else /* SERVER_MODE */
-  assert (sort_param->px_height_max == 0);
-  assert (sort_param->px_array_size == 1);
-
-  assert (px_id == 0);
-  assert (px_height == 0);
-  assert (px_myself == 0);
+  (void) tran_index;
 #endif /* SERVER_MODE */
 
-  /* set node info */
-
-  px_node->px_id = px_id;
-
-  px_node->px_height = px_height;
-  px_node->px_myself = px_myself;
-
-  px_node->px_tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
-
-  /* set operation info */
-
-  px_node->px_arg = (void *) sort_param;
-
-  px_node->px_buff = px_buff;
-  px_node->px_vector = px_vector;
-  px_node->px_vector_size = px_vector_size;
-
-  px_node->px_result = px_node->px_vector;	/* init */
-  px_node->px_result_size = px_node->px_vector_size;	/* init */
-
-  return px_node;
-}
-
-#if defined(SERVER_MODE)
-// *INDENT-OFF*
-static void
-px_sort_myself_execute (cubthread::entry &thread_ref, PX_TREE_NODE * px_node)
-{
-  (void) px_sort_myself (&thread_ref, px_node);
-}
-
-/*
- * px_sort_communicate() -
- *   return:
- *   thread_p(in):
- *   px_node(in):
- *
- * NOTE: support parallelism
- */
-static int
-px_sort_communicate (PX_TREE_NODE * px_node)
-{
-  SORT_PARAM *sort_param;
-
-  assert_release (px_node != NULL);
-  assert_release (px_node->px_arg != NULL);
-
-  sort_param = (SORT_PARAM *) (px_node->px_arg);
-  assert_release (px_node->px_height <= sort_param->px_height_max);
-  assert_release (px_node->px_id < sort_param->px_array_size);
-  assert_release (px_node->px_vector_size > 1);
-
-  cubthread::entry_callable_task *task =
-    new cubthread::entry_callable_task (std::bind (px_sort_myself_execute, std::placeholders::_1, px_node));
-  css_push_external_task (css_get_current_conn_entry (), task);
-
-  return NO_ERROR;
+  sort_param->px_sort =
+    new parallel_sort (px_degree, SORT_PARTITION_RUN_SIZE_MIN, run_sort, sort_param->cmp_fn, sort_param->cmp_arg,
+                       sort_param->option == SORT_DUP ? sort_append : NULL, push);
+  // *INDENT-ON*
 }
-// *INDENT-ON*
-#endif /* SERVER_MODE */
 
 /*
- * px_sort_myself() -
- *   return:
+ * px_sort_partitions() - sort the vector of record pointers, in parallel when possible
+ *   return: sorted vector (inside vector or buff), NULL on error
  *   thread_p(in):
- *   px_node(in):
+ *   sort_param(in): sort parameters
+ *   buff(in): buffer area, with the same size as vector
+ *   vector(in): record pointers to sort
+ *   vector_size(in): number of record pointers
+ *   result_size(out): number of sorted record pointers
  *
  * NOTE: support parallelism
  *
- * Partitioned merge logic
- *
- * The working core: each internal node recurses on this function
- * both for its left side and its right side, as nodes one closer to
- * the leaf level.  It then merges the results into the vector
- *
- * Leaf level nodes just sort the vector.
+ * See parallel_sort.hpp. The sorting thread takes a share of the work at every level and runs the nodes no worker
+ * has started, so a busy worker pool never blocks the sort.
  */
-static int
-px_sort_myself (THREAD_ENTRY * thread_p, PX_TREE_NODE * px_node)
+static char **
+px_sort_partitions (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, char **buff, char **vector, long vector_size,
+		    long *result_size)
 {
-#define SORT_PARTITION_RUN_SIZE_MIN (ONE_M)
-
-  int ret = NO_ERROR;
-  bool old_check_interrupt;
-
-#if defined(SERVER_MODE)
-  int parent;
-  int child_right = 0;
-  int child_height;
-
-  int cmp;
-
-  int rv = NO_ERROR;
-#endif /* SERVER_MODE */
-
-  SORT_PARAM *sort_param;
-
-  char **buff;
-  char **vector;
-  long vector_size;
-
-  char **result = NULL;
-  long result_size = -1;
-
-  assert_release (px_node != NULL);
-  assert_release (px_node->px_id >= 0);
-  assert_release (px_node->px_arg != NULL);
-
-  if (thread_p == NULL)
-    {
-      thread_p = thread_get_thread_entry_info ();
-    }
-
-  sort_param = (SORT_PARAM *) (px_node->px_arg);
-
-#if defined(SERVER_MODE)
-  if (px_node->px_id > 0)
-    {
-      /* is new childs */
-      thread_p->tran_index = px_node->px_tran_index;
-      pthread_mutex_unlock (&thread_p->tran_index_lock);
-    }
-
-#if !defined(NDEBUG)
-  rv = pthread_mutex_lock (&(sort_param->px_mtx));
-  assert (rv == NO_ERROR);
-
-  assert (px_node->px_status == 0);
-
-  pthread_mutex_unlock (&(sort_param->px_mtx));
-#endif
-#endif /* SERVER_MODE */
-
-  old_check_interrupt = logtb_set_check_interrupt (thread_p, false);
-
-  buff = px_node->px_buff;
-  vector = px_node->px_vector;
-  vector_size = px_node->px_vector_size;
-
-  assert_release (px_node->px_result == vector);
-  assert_release (px_node->px_result_size == vector_size);
-
-  result = px_node->px_result;
-  result_size = px_node->px_result_size;
-
-  assert_release (vector_size > 0);
-
-#if defined(SERVER_MODE)
-  parent = px_node->px_id & ~(1 << px_node->px_height);
-  child_height = px_node->px_height - 1;
-  if (child_height >= 0)
-    {
-      child_right = px_node->px_myself | (1 << child_height);
-      assert_release (child_right > 0);
-    }
-
-  if (vector_size <= 1)
-    {
-      assert_release (px_node->px_result == vector);
-      assert_release (px_node->px_result_size == vector_size);
-
-      result = px_node->px_result = vector;
-      result_size = px_node->px_result_size = vector_size;
-
-      /* mark as finished */
-
-      rv = pthread_mutex_lock (&(sort_param->px_mtx));
-      assert (rv == NO_ERROR);
-
-      assert_release (px_node->px_status == 0);
-      px_node->px_status = 1;	/* done */
-
-      pthread_mutex_unlock (&(sort_param->px_mtx));
-
-      goto exit_on_end;
-    }
-
-  if (px_node->px_height > 0 && vector_size > SORT_PARTITION_RUN_SIZE_MIN)
-    {
-      long left_vector_size, right_vector_size;
-      char **left_vector, **right_vector;
-      PX_TREE_NODE *left_px_node, *right_px_node;
-      int i, j, k;		/* Used in the merge logic */
-
-      assert_release (child_right > 0);
-
-      left_vector_size = vector_size / 2;
-      right_vector_size = vector_size - left_vector_size;
-
-      assert_release (vector_size == left_vector_size + right_vector_size);
-
-      /* do new child first */
-      right_vector = vector + left_vector_size;
-      right_px_node = px_sort_assign (thread_p, sort_param, px_node->px_id + child_right, buff + left_vector_size,
-				      right_vector, right_vector_size, child_height, 0 /* px_myself: set as root */ );
-      if (right_px_node == NULL)
-	{
-	  goto exit_on_error;
-	}
-
-      if (right_vector_size > 1)
-	{
-	  /* launch new worker */
-	  if (px_sort_communicate (right_px_node) != NO_ERROR)
-	    {
-	      goto exit_on_error;
-	    }
-	}
-      else
-	{
-	  /* mark as finished */
-
-	  rv = pthread_mutex_lock (&(sort_param->px_mtx));
-	  assert (rv == NO_ERROR);
-
-	  assert_release (right_px_node->px_status == 0);
-	  right_px_node->px_status = 1;	/* done */
-
-	  pthread_mutex_unlock (&(sort_param->px_mtx));
-	}
-
-      left_vector = vector;
-      left_px_node =
-	px_sort_assign (thread_p, sort_param, px_node->px_id, buff, left_vector, left_vector_size, child_height,
-			px_node->px_myself);
-      if (left_px_node == NULL)
-	{
-	  goto exit_on_error;
-	}
-
-      assert_release (px_node == left_px_node);
-#if !defined(NDEBUG)
-      rv = pthread_mutex_lock (&(sort_param->px_mtx));
-      assert (rv == NO_ERROR);
-
-      assert (px_node->px_status == 0);
-
-      pthread_mutex_unlock (&(sort_param->px_mtx));
-#endif
-
-      if (left_vector_size > 1)
-	{
-	  if (px_sort_myself (thread_p, left_px_node) != NO_ERROR)
-	    {
-	      goto exit_on_error;
-	    }
-	}
-
-      /* wait for right-child finished */
-      do
-	{
-	  rv = pthread_mutex_lock (&(sort_param->px_mtx));
-	  assert (rv == NO_ERROR);
-
-	  if (right_px_node->px_status != 0)
-	    {
-	      assert (right_px_node->px_status == 1);
-	      pthread_mutex_unlock (&(sort_param->px_mtx));
-	      break;
-	    }
-
-	  pthread_mutex_unlock (&(sort_param->px_mtx));
-
-#if 1				/* TODO */
-	  thread_sleep (10);	/* 10 msec */
-#endif
-	}
-      while (1);
-
-      assert_release (px_node == left_px_node);
-#if !defined(NDEBUG)
-      rv = pthread_mutex_lock (&(sort_param->px_mtx));
-      assert (rv == NO_ERROR);
-
-      assert (right_px_node->px_status == 1);
-      assert (px_node->px_status == 0);
-
-      pthread_mutex_unlock (&(sort_param->px_mtx));
-#endif
-
-      right_vector = right_px_node->px_result;
-      right_vector_size = right_px_node->px_result_size;
-      if (right_vector == NULL || right_vector_size < 0)
-	{
-	  goto exit_on_error;
-	}
-
-      left_vector = left_px_node->px_result;
-      left_vector_size = left_px_node->px_result_size;
-      if (left_vector == NULL || left_vector_size < 0)
-	{
-	  goto exit_on_error;
-	}
-
-      assert_release (vector_size >= left_vector_size + right_vector_size);
-
-      result_size = px_node->px_result_size = left_vector_size + right_vector_size;
-      if (left_vector < vector)
-	{
-	  assert_release (left_vector + left_vector_size <= vector);
-	  result = px_node->px_result = vector;
-	}
-      else
-	{
-	  result = px_node->px_result = buff;
-	}
-
-      /* Merge the two sub-results back into upper result */
-
-      i = j = k = 0;
-
-#if 1
-      /* STEP 2: check CON conditions if (left_max < right_min) do FORWARD-CON. we use '<' instead of '<=' */
-      cmp = (*(sort_param->cmp_fn)) (&(left_vector[left_vector_size - 1]), &(right_vector[0]), sort_param->cmp_arg);
-
-      if (cmp == DB_LT || cmp == DB_EQ || cmp == DB_GT)
-	{
-	  ;			/* ok */
-	}
-      else
-	{
-	  assert_release (cmp == DB_LT || cmp == DB_EQ || cmp == DB_GT);
-	  goto exit_on_error;
-	}
-
-      if (cmp == DB_LT)
-	{
-	  while (i < left_vector_size)
-	    {
-	      result[k++] = left_vector[i++];
-	    }
-	  while (j < right_vector_size)
-	    {
-	      result[k++] = right_vector[j++];
-	    }
-	}
-      else
-	{
-	  /* STEP 3: check CON conditions if (right_max < left_min) do BACKWARD-CON. we use '<' instead of '<=' */
-	  cmp =
-	    (*(sort_param->cmp_fn)) (&(right_vector[right_vector_size - 1]), &(left_vector[0]), sort_param->cmp_arg);
-
-	  if (cmp == DB_LT || cmp == DB_EQ || cmp == DB_GT)
-	    {
-	      ;			/* ok */
-	    }
-	  else
-	    {
-	      assert_release (cmp == DB_LT || cmp == DB_EQ || cmp == DB_GT);
-	      goto exit_on_error;
-	    }
-
-	  if (cmp == DB_LT)
-	    {
-	      while (j < right_vector_size)
-		{
-		  result[k++] = right_vector[j++];
-		}
-	      while (i < left_vector_size)
-		{
-		  result[k++] = left_vector[i++];
-		}
-	    }
-	  else
-	    {
-#endif
-	      /* STEP 4: do the actual merge */
-	      while (i < left_vector_size && j < right_vector_size)
-		{
-		  cmp = (*(sort_param->cmp_fn)) (&(left_vector[i]), &(right_vector[j]), sort_param->cmp_arg);
-
-		  if (cmp == DB_LT || cmp == DB_EQ || cmp == DB_GT)
-		    {
-		      ;		/* ok */
-		    }
-		  else
-		    {
-		      assert_release (cmp == DB_LT || cmp == DB_EQ || cmp == DB_GT);
-		      goto exit_on_error;
-		    }
-
-		  if (cmp == DB_EQ)
-		    {
-		      if (sort_param->option == SORT_DUP)	/* allow duplicate */
-			{
-			  sort_append (&(left_vector[i]), &(right_vector[j]));
-			}
-
-		      result[k++] = right_vector[j++];	/* temp */
-		      i++;	/* skip left-side dup */
-		    }
-		  else if (cmp == DB_GT)
-		    {
-		      result[k++] = right_vector[j++];
-		    }
-		  else
-		    {
-		      assert_release (cmp == DB_LT);
-		      result[k++] = left_vector[i++];
-		    }
-		}
-	      while (i < left_vector_size)
-		{
-		  result[k++] = left_vector[i++];
-		}
-	      while (j < right_vector_size)
-		{
-		  result[k++] = right_vector[j++];
-		}
-#if 1
-	    }			/* else */
-	}			/* else */
-#endif
-
-      assert_release (result_size >= k);
-
-      result_size = px_node->px_result_size = k;
-
-#if !defined(NDEBUG)
-      if (sort_validate (result, result_size, sort_param->cmp_fn, sort_param->cmp_arg) != NO_ERROR)
-	{
-	  goto exit_on_error;
-	}
-#endif
-    }
-  else
-    {
-      result = px_node->px_result = sort_run_sort (thread_p, sort_param, vector, vector_size, 0 /* dummy */ ,
-						   buff, &(px_node->px_result_size));
-      result_size = px_node->px_result_size;
-    }
-
-#else /* SERVER_MODE */
-
-  result = px_node->px_result = sort_run_sort (thread_p, sort_param, vector, vector_size, 0 /* dummy */ ,
-					       buff, &(px_node->px_result_size));
-  result_size = px_node->px_result_size;
-
-#endif /* SERVER_MODE */
+  char **result;
 
-  if (result == NULL || result_size < 0)
+  result = sort_param->px_sort->sort (thread_p, buff, vector, vector_size, result_size);
+  if (result == NULL)
     {
-      assert_release (false);
-      goto exit_on_error;
+      return NULL;
     }
 
-exit_on_end:
-
-  assert_release (result == px_node->px_result);
-  assert_release (result_size == px_node->px_result_size);
-
-#if defined(SERVER_MODE)
-  if (parent != px_node->px_id)
+  if (sort_param->option == SORT_ELIM_DUP && (result < vector || result >= vector + vector_size))
     {
-      /* mark as finished */
-
-      rv = pthread_mutex_lock (&(sort_param->px_mtx));
-      assert (rv == NO_ERROR);
-
-      assert_release (px_node->px_status == 0);
-      px_node->px_status = 1;	/* done */
-
-      pthread_mutex_unlock (&(sort_param->px_mtx));
+      /* keep the sorted keys in the vector area, as sort_run_sort does; the internal sorting phase may go on adding
+       * records below it */
+      memcpy (vector, result, *result_size * sizeof (char *));
+      result = vector;
     }
-#endif /* SERVER_MODE */
-
-  (void) logtb_set_check_interrupt (thread_p, old_check_interrupt);
-
-  return ret;
-
-exit_on_error:
-
-  result = px_node->px_result = NULL;
-  result_size = px_node->px_result_size = -1;
-
-  ret = (ret == NO_ERROR && (ret = er_errid ()) == NO_ERROR) ? ER_FAILED : ret;
 
-  goto exit_on_end;
+  return result;
 }
 
 /*
@@ -2175,15 +1646,9 @@ sort_inphase_sort (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, SORT_GET_FU
   int i;
   int error = NO_ERROR;
 
-  PX_TREE_NODE *px_node;
-#if defined (SERVER_MODE)
-  int rv = NO_ERROR;
-#endif /* SERVER_MODE */
-
   assert (sort_param->half_files <= SORT_MAX_HALF_FILES);
 
-  assert (sort_param->px_height_max >= 0);
-  assert (sort_param->px_array_size >= 1);
+  assert (sort_param->px_sort != NULL);
 
   /* Initialize the current pages of all temp files to 0 */
   for (i = 0; i < sort_param->half_files; i++)
@@ -2258,36 +1723,7 @@ sort_inphase_sort (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, SORT_GET_FU
 
 	      if (sort_numrecs == 0)
 		{
-		  assert (sort_param->px_height_max >= 0);
-		  assert (sort_param->px_array_size >= 1);
-#if defined(SERVER_MODE)
-		  rv = pthread_mutex_lock (&(sort_param->px_mtx));
-		  assert (rv == NO_ERROR);
-
-		  for (i = 0; i < sort_param->px_array_size; i++)
-		    {
-		      sort_param->px_array[i].px_status = 0;	/* init */
-		    }
-
-		  pthread_mutex_unlock (&(sort_param->px_mtx));
-#endif /* SERVER_MODE */
-
-		  px_node = px_sort_assign (thread_p, sort_param, 0, index_buff, index_area, numrecs,
-					    sort_param->px_height_max, 0 /* px_myself: set as root */ );
-		  if (px_node == NULL)
-		    {
-		      error = ER_FAILED;
-		      goto exit_on_error;
-		    }
-
-		  error = px_sort_myself (thread_p, px_node);
-		  if (error != NO_ERROR)
-		    {
-		      goto exit_on_error;
-		    }
-
-		  index_area = px_node->px_result;
-		  numrecs = px_node->px_result_size;
+		  index_area = px_sort_partitions (thread_p, sort_param, index_buff, index_area, numrecs, &numrecs);
 		  *total_numrecs += numrecs;
 		}
 	      else
@@ -2502,36 +1938,7 @@ sort_inphase_sort (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, SORT_GET_FU
 
       if (sort_numrecs == 0)
 	{
-	  assert (sort_param->px_height_max >= 0);
-	  assert (sort_param->px_array_size >= 1);
-#if defined(SERVER_MODE)
-	  rv = pthread_mutex_lock (&(sort_param->px_mtx));
-	  assert (rv == NO_ERROR);
-
-	  for (i = 0; i < sort_param->px_array_size; i++)
-	    {
-	      sort_param->px_array[i].px_status = 0;	/* init */
-	    }
-
-	  pthread_mutex_unlock (&(sort_param->px_mtx));
-#endif /* SERVER_MODE */
-
-	  px_node = px_sort_assign (thread_p, sort_param, 0, index_buff, index_area, numrecs, sort_param->px_height_max,
-				    0 /* px_myself: set as root */ );
-	  if (px_node == NULL)
-	    {
-	      error = ER_FAILED;
-	      goto exit_on_error;
-	    }
-
-	  if (px_sort_myself (thread_p, px_node) != NO_ERROR)
-	    {
-	      error = ER_FAILED;
-	      goto exit_on_error;
-	    }
-
-	  index_area = px_node->px_result;
-	  numrecs = px_node->px_result_size;
+	  index_area = px_sort_partitions (thread_p, sort_param, index_buff, index_area, numrecs, &numrecs);
 	  *total_numrecs += numrecs;
 	}
       else
@@ -3595,6 +3002,11 @@ bailout:
  *   return:
  *   sort_param(in): sort parameters
  *
+ * Note: The merge runs on the sorting thread only. Every pass shares the internal memory between the input sections
+ *       of all active runs and one output section, and writes its runs one after the other in the output temp files,
+ *       whose pages the next pass reads in order. The last pass hands the records to put_fn, which needs them in key
+ *       order. Run generation is parallel (px_sort_partitions), and runs are as long as the internal memory, so most
+ *       sorts need one or two passes here.
  */
 static int
 sort_exphase_merge (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param)
@@ -4378,9 +3790,6 @@ static void
 sort_return_used_resources (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param)
 {
   int k;
-#if defined(SERVER_MODE)
-  int rv;
-#endif /* SERVER_MODE */
 
   if (sort_param == NULL)
     {
@@ -4413,19 +3822,9 @@ sort_return_used_resources (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param)
 	}
     }
 
-  if (sort_param->px_array)
-    {
-      free_and_init (sort_param->px_array);
-    }
-  sort_param->px_height_max = sort_param->px_array_size = 0;
-
-#if defined(SERVER_MODE)
-  rv = pthread_mutex_destroy (&(sort_param->px_mtx));
-  if (rv != 0)
-    {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CSS_PTHREAD_MUTEX_DESTROY, 0);
-    }
-#endif
+  /* tasks still queued keep their own reference to the parallel sort state; they exit without touching sort_param */
+  delete sort_param->px_sort;
+  sort_param->px_sort = NULL;
 
   free_and_init (sort_param);
 }
@@ -63,6 +63,18 @@
 #include <aio.h>
 #endif /* HPUX */
 
+#if defined (__linux__) && defined (__has_include)
+#if __has_include (<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined (__NR_io_uring_setup) && defined (__NR_io_uring_enter)
+/* io_uring is used through raw system calls; the kernel interface is all that is needed */
+#define FILEIO_HAVE_IO_URING
+#endif /* __NR_io_uring_setup && __NR_io_uring_enter */
+#endif /* __has_include (<linux/io_uring.h>) */
+#endif /* __linux__ && __has_include */
+
 #include "porting.h"
 
 #include "chartype.h"
@@ -446,6 +458,59 @@ static TOKEN_BUCKET fc_Token_bucket_s;
 static TOKEN_BUCKET *fc_Token_bucket = NULL;
 static FLUSH_STATS fc_Stats;
 
+#if defined (FILEIO_HAVE_IO_URING)
+/* page read or write of a batch, prepared into a submission entry */
+typedef struct fileio_io_request FILEIO_IO_REQUEST;
+struct fileio_io_request
+{
+  int vol_fd;
+  PAGEID page_id;
+  bool is_write;
+  bool is_busy;			/* queued or in flight */
+  struct iovec iov;		/* the page; referenced by the submission entry */
+  int *error_p;			/* where to store the result of the request; may be NULL */
+};
+
+struct fileio_io_ring
+{
+  FILEIO_IO_RING *next;		/* next ring in pool */
+  int ring_fd;
+  unsigned int queue_depth;	/* maximum number of requests that are queued or in flight */
+  bool is_broken;		/* submission failed; the ring is not reused */
+
+  /* submission queue, shared with kernel */
+  unsigned int *sq_head;
+  unsigned int *sq_tail;
+  unsigned int sq_mask;
+  unsigned int *sq_array;
+  struct io_uring_sqe *sqes;
+  unsigned int sq_local_tail;	/* tail including the entries the kernel was not told about yet */
+
+  /* completion queue, shared with kernel */
+  unsigned int *cq_head;
+  unsigned int *cq_tail;
+  unsigned int cq_mask;
+  struct io_uring_cqe *cqes;
+
+  void *sq_map;
+  size_t sq_map_size;
+  void *cq_map;
+  size_t cq_map_size;
+  size_t sqes_size;
+
+  FILEIO_IO_REQUEST *requests;	/* queue_depth requests; the index of request is the user data of its entry */
+  int *free_requests;		/* stack of free request indexes */
+  int n_free;
+  int n_queued;			/* prepared and not submitted */
+  int n_inflight;		/* submitted and not completed */
+};
+
+/* rings are expensive to set up; they are kept for the next batches */
+static FILEIO_IO_RING *fileio_Io_ring_pool = NULL;
+static pthread_mutex_t fileio_Io_ring_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static bool fileio_Io_uring_is_unsupported = false;
+#endif /* FILEIO_HAVE_IO_URING */
+
 #if defined(CUBRID_DEBUG)
 /* Set this to get various levels of io information regarding
  * backup and restore activity.
@@ -505,6 +570,17 @@ static bool fileio_is_terminated_process (int pid);
 
 static ssize_t fileio_os_read (THREAD_ENTRY * thread_p, int vol_fd, void *io_page_p, size_t count, off_t offset);
 static ssize_t fileio_os_write (THREAD_ENTRY * thread_p, int vol_fd, void *io_page_p, size_t count, off_t offset);
+static int fileio_batch_add (FILEIO_BATCH * batch, bool is_write, int vol_fd, void *io_page_p, PAGEID page_id,
+			     size_t page_size, int *error_p);
+static int fileio_batch_execute (THREAD_ENTRY * thread_p, bool is_write, int vol_fd, void *io_page_p, PAGEID page_id,
+				 size_t page_size);
+#if defined (FILEIO_HAVE_IO_URING)
+static FILEIO_IO_RING *fileio_io_ring_create (unsigned int queue_depth);
+static void fileio_io_ring_destroy (FILEIO_IO_RING * ring);
+static int fileio_io_ring_enter (FILEIO_IO_RING * ring, unsigned int min_complete);
+static void fileio_io_ring_reap (FILEIO_BATCH * batch);
+static void fileio_io_ring_execute_outstanding (FILEIO_BATCH * batch);
+#endif /* FILEIO_HAVE_IO_URING */
 #if !defined (WINDOWS)
 static ssize_t pwrite_with_injected_fault (THREAD_ENTRY * thread_p, int fd, const void *buf, size_t count,
 					   off_t offset);
@@ -4414,6 +4490,555 @@ fileio_writev (THREAD_ENTRY * thread_p, int vol_fd, void **io_page_array, PAGEID
   return io_page_array[0];
 }
 
+/*
+ * fileio_batch_begin () - start a batch of page reads and writes
+ *   return: void
+ *   batch(out): the batch
+ *   backend(in): IO_BACKEND_IO_URING to submit the requests asynchronously, IO_BACKEND_PREAD to execute them at once
+ *   queue_depth(in): maximum number of requests in flight
+ *
+ * Note: if io_uring cannot be used, the batch silently falls back to synchronous pread/pwrite. The batch must be
+ *       closed with fileio_batch_end.
+ */
+void
+fileio_batch_begin (THREAD_ENTRY * thread_p, FILEIO_BATCH * batch, int backend, int queue_depth)
+{
+#if defined (FILEIO_HAVE_IO_URING)
+  FILEIO_IO_RING *ring;
+#endif /* FILEIO_HAVE_IO_URING */
+
+  batch->thread_p = thread_p;
+  batch->ring = NULL;
+  batch->n_requests = 0;
+  batch->error_code = NO_ERROR;
+
+#if defined (FILEIO_HAVE_IO_URING)
+  if (backend != IO_BACKEND_IO_URING || queue_depth <= 0 || fileio_Io_uring_is_unsupported)
+    {
+      return;
+    }
+
+  pthread_mutex_lock (&fileio_Io_ring_pool_mutex);
+  ring = fileio_Io_ring_pool;
+  if (ring != NULL)
+    {
+      fileio_Io_ring_pool = ring->next;
+    }
+  pthread_mutex_unlock (&fileio_Io_ring_pool_mutex);
+
+  if (ring != NULL && ring->queue_depth != (unsigned int) queue_depth)
+    {
+      /* queue depth was changed */
+      fileio_io_ring_destroy (ring);
+      ring = NULL;
+    }
+
+  if (ring == NULL)
+    {
+      ring = fileio_io_ring_create ((unsigned int) queue_depth);
+      if (ring == NULL)
+	{
+	  if (errno == ENOSYS || errno == EPERM)
+	    {
+	      /* kernel without io_uring, or forbidden; do not try again */
+	      fileio_Io_uring_is_unsupported = true;
+	    }
+	  er_log_debug (ARG_FILE_LINE, "fileio_batch_begin: io_uring setup failed with errno %d. Using pread/pwrite.\n",
+			errno);
+	  return;
+	}
+    }
+
+  ring->next = NULL;
+  batch->ring = ring;
+#endif /* FILEIO_HAVE_IO_URING */
+}
+
+/*
+ * fileio_batch_add_read () - add the read of a page to batch
+ *   return: error code of a synchronous read; NO_ERROR otherwise
+ *   batch(in): the batch
+ *   vol_fd(in): volume descriptor
+ *   io_page_p(out): where the page is read; must not be used before the batch is waited
+ *   page_id(in): page identifier
+ *   page_size(in): page size
+ *   error_p(out): result of the read, set when the read completes; may be NULL
+ */
+int
+fileio_batch_add_read (FILEIO_BATCH * batch, int vol_fd, void *io_page_p, PAGEID page_id, size_t page_size,
+		       int *error_p)
+{
+  return fileio_batch_add (batch, false, vol_fd, io_page_p, page_id, page_size, error_p);
+}
+
+/*
+ * fileio_batch_add_write () - add the write of a page to batch
+ *   return: error code of a synchronous write; NO_ERROR otherwise
+ *   batch(in): the batch
+ *   vol_fd(in): volume descriptor
+ *   io_page_p(in): the page; must not be changed before the batch is waited
+ *   page_id(in): page identifier
+ *   page_size(in): page size
+ *   error_p(out): result of the write, set when the write completes; may be NULL
+ *
+ * Note: like FILEIO_WRITE_NO_COMPENSATE_WRITE writes, batched writes do not use flush control tokens.
+ */
+int
+fileio_batch_add_write (FILEIO_BATCH * batch, int vol_fd, void *io_page_p, PAGEID page_id, size_t page_size,
+			int *error_p)
+{
+  return fileio_batch_add (batch, true, vol_fd, io_page_p, page_id, page_size, error_p);
+}
+
+/*
+ * fileio_batch_add () - add a page read or write to batch
+ *   return: error code of a synchronous request; NO_ERROR otherwise
+ *   batch(in): the batch
+ *   is_write(in): true for write, false for read
+ *   vol_fd(in): volume descriptor
+ *   io_page_p(in/out): the page
+ *   page_id(in): page identifier
+ *   page_size(in): page size
+ *   error_p(out): result of the request; may be NULL
+ */
+static int
+fileio_batch_add (FILEIO_BATCH * batch, bool is_write, int vol_fd, void *io_page_p, PAGEID page_id, size_t page_size,
+		  int *error_p)
+{
+#if defined (FILEIO_HAVE_IO_URING)
+  FILEIO_IO_RING *ring = batch->ring;
+  FILEIO_IO_REQUEST *request;
+  struct io_uring_sqe *sqe;
+  unsigned int sq_index;
+  int request_index;
+#endif /* FILEIO_HAVE_IO_URING */
+  int error_code;
+
+  batch->n_requests++;
+
+#if defined (FILEIO_HAVE_IO_URING)
+  if (ring != NULL)
+    {
+      while (ring->n_free == 0)
+	{
+	  /* the queue is full; submit what is queued and wait for a request to complete */
+	  if (fileio_io_ring_enter (ring, 1) != NO_ERROR)
+	    {
+	      fileio_io_ring_execute_outstanding (batch);
+	      break;
+	    }
+	  fileio_io_ring_reap (batch);
+	}
+    }
+
+  if (ring != NULL && !ring->is_broken)
+    {
+      request_index = ring->free_requests[--ring->n_free];
+      request = &ring->requests[request_index];
+      request->vol_fd = vol_fd;
+      request->page_id = page_id;
+      request->is_write = is_write;
+      request->is_busy = true;
+      request->iov.iov_base = io_page_p;
+      request->iov.iov_len = page_size;
+      request->error_p = error_p;
+
+      sq_index = ring->sq_local_tail & ring->sq_mask;
+      sqe = &ring->sqes[sq_index];
+      memset (sqe, 0, sizeof (*sqe));
+      sqe->opcode = is_write ? IORING_OP_WRITEV : IORING_OP_READV;
+      sqe->fd = vol_fd;
+      sqe->addr = (unsigned long) &request->iov;
+      sqe->len = 1;
+      sqe->off = (unsigned long long) FILEIO_GET_FILE_SIZE (page_size, page_id);
+      sqe->user_data = (unsigned long long) request_index;
+      ring->sq_array[sq_index] = sq_index;
+
+      ring->sq_local_tail++;
+      ring->n_queued++;
+      return NO_ERROR;
+    }
+#endif /* FILEIO_HAVE_IO_URING */
+
+  error_code = fileio_batch_execute (batch->thread_p, is_write, vol_fd, io_page_p, page_id, page_size);
+  if (error_code != NO_ERROR && batch->error_code == NO_ERROR)
+    {
+      batch->error_code = error_code;
+    }
+  if (error_p != NULL)
+    {
+      *error_p = error_code;
+    }
+  return error_code;
+}
+
+/*
+ * fileio_batch_execute () - execute a page read or write synchronously
+ *   return: error code
+ */
+static int
+fileio_batch_execute (THREAD_ENTRY * thread_p, bool is_write, int vol_fd, void *io_page_p, PAGEID page_id,
+		      size_t page_size)
+{
+  void *result;
+  int error_code = NO_ERROR;
+
+  if (is_write)
+    {
+      result = fileio_write (thread_p, vol_fd, io_page_p, page_id, page_size, FILEIO_WRITE_NO_COMPENSATE_WRITE);
+    }
+  else
+    {
+      result = fileio_read (thread_p, vol_fd, io_page_p, page_id, page_size);
+    }
+
+  if (result == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error_code);
+    }
+  return error_code;
+}
+
+/*
+ * fileio_batch_wait () - submit the queued requests of batch and wait for all requests to complete
+ *   return: error code of the first failed request of batch
+ *   batch(in): the batch
+ *
+ * Note: the batch can be reused after waiting.
+ */
+int
+fileio_batch_wait (FILEIO_BATCH * batch)
+{
+#if defined (FILEIO_HAVE_IO_URING)
+  FILEIO_IO_RING *ring = batch->ring;
+
+  while (ring != NULL && ring->n_queued + ring->n_inflight > 0)
+    {
+      if (fileio_io_ring_enter (ring, ring->n_queued + ring->n_inflight) != NO_ERROR)
+	{
+	  fileio_io_ring_execute_outstanding (batch);
+	  break;
+	}
+      fileio_io_ring_reap (batch);
+    }
+#endif /* FILEIO_HAVE_IO_URING */
+
+  return batch->error_code;
+}
+
+/*
+ * fileio_batch_end () - wait for the requests of batch and release it
+ *   return: error code of the first failed request of batch
+ *   batch(in): the batch
+ */
+int
+fileio_batch_end (FILEIO_BATCH * batch)
+{
+  int error_code;
+
+  error_code = fileio_batch_wait (batch);
+
+#if defined (FILEIO_HAVE_IO_URING)
+  if (batch->ring != NULL)
+    {
+      if (batch->ring->is_broken)
+	{
+	  fileio_io_ring_destroy (batch->ring);
+	}
+      else
+	{
+	  pthread_mutex_lock (&fileio_Io_ring_pool_mutex);
+	  batch->ring->next = fileio_Io_ring_pool;
+	  fileio_Io_ring_pool = batch->ring;
+	  pthread_mutex_unlock (&fileio_Io_ring_pool_mutex);
+	}
+      batch->ring = NULL;
+    }
+#endif /* FILEIO_HAVE_IO_URING */
+
+  return error_code;
+}
+
+/*
+ * fileio_batch_is_async () - are the requests of batch submitted asynchronously?
+ *   return: true if batch uses io_uring
+ *   batch(in): the batch
+ */
+bool
+fileio_batch_is_async (const FILEIO_BATCH * batch)
+{
+  return batch->ring != NULL;
+}
+
+/*
+ * fileio_batch_finalize () - destroy the io_uring instances kept for batches
+ *   return: void
+ */
+void
+fileio_batch_finalize (void)
+{
+#if defined (FILEIO_HAVE_IO_URING)
+  FILEIO_IO_RING *ring;
+
+  pthread_mutex_lock (&fileio_Io_ring_pool_mutex);
+  while (fileio_Io_ring_pool != NULL)
+    {
+      ring = fileio_Io_ring_pool;
+      fileio_Io_ring_pool = ring->next;
+      fileio_io_ring_destroy (ring);
+    }
+  pthread_mutex_unlock (&fileio_Io_ring_pool_mutex);
+#endif /* FILEIO_HAVE_IO_URING */
+}
+
+#if defined (FILEIO_HAVE_IO_URING)
+/*
+ * fileio_io_ring_create () - set up an io_uring instance and map its queues
+ *   return: the ring, NULL on failure (errno is set)
+ *   queue_depth(in): maximum number of requests queued or in flight
+ */
+static FILEIO_IO_RING *
+fileio_io_ring_create (unsigned int queue_depth)
+{
+  FILEIO_IO_RING *ring;
+  struct io_uring_params params;
+  char *sq_ptr, *cq_ptr;
+  unsigned int i;
+  int save_errno;
+
+  ring = (FILEIO_IO_RING *) malloc (sizeof (FILEIO_IO_RING));
+  if (ring == NULL)
+    {
+      errno = ENOMEM;
+      return NULL;
+    }
+  memset (ring, 0, sizeof (FILEIO_IO_RING));
+  ring->sq_map = MAP_FAILED;
+  ring->cq_map = MAP_FAILED;
+  ring->sqes = (struct io_uring_sqe *) MAP_FAILED;
+
+  memset (&params, 0, sizeof (params));
+  ring->ring_fd = (int) syscall (__NR_io_uring_setup, queue_depth, &params);
+  if (ring->ring_fd < 0)
+    {
+      save_errno = errno;
+      free (ring);
+      errno = save_errno;
+      return NULL;
+    }
+  ring->queue_depth = queue_depth;
+
+  ring->sq_map_size = params.sq_off.array + params.sq_entries * sizeof (unsigned int);
+  ring->sq_map = mmap (NULL, ring->sq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ring_fd,
+		       IORING_OFF_SQ_RING);
+  ring->cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof (struct io_uring_cqe);
+  ring->cq_map = mmap (NULL, ring->cq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ring_fd,
+		       IORING_OFF_CQ_RING);
+  ring->sqes_size = params.sq_entries * sizeof (struct io_uring_sqe);
+  ring->sqes = (struct io_uring_sqe *) mmap (NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+					     ring->ring_fd, IORING_OFF_SQES);
+  ring->requests = (FILEIO_IO_REQUEST *) malloc (queue_depth * sizeof (FILEIO_IO_REQUEST));
+  ring->free_requests = (int *) malloc (queue_depth * sizeof (int));
+  if (ring->sq_map == MAP_FAILED || ring->cq_map == MAP_FAILED || ring->sqes == MAP_FAILED || ring->requests == NULL
+      || ring->free_requests == NULL)
+    {
+      save_errno = errno;
+      fileio_io_ring_destroy (ring);
+      errno = save_errno;
+      return NULL;
+    }
+
+  sq_ptr = (char *) ring->sq_map;
+  ring->sq_head = (unsigned int *) (sq_ptr + params.sq_off.head);
+  ring->sq_tail = (unsigned int *) (sq_ptr + params.sq_off.tail);
+  ring->sq_mask = *(unsigned int *) (sq_ptr + params.sq_off.ring_mask);
+  ring->sq_array = (unsigned int *) (sq_ptr + params.sq_off.array);
+  ring->sq_local_tail = *ring->sq_tail;
+
+  cq_ptr = (char *) ring->cq_map;
+  ring->cq_head = (unsigned int *) (cq_ptr + params.cq_off.head);
+  ring->cq_tail = (unsigned int *) (cq_ptr + params.cq_off.tail);
+  ring->cq_mask = *(unsigned int *) (cq_ptr + params.cq_off.ring_mask);
+  ring->cqes = (struct io_uring_cqe *) (cq_ptr + params.cq_off.cqes);
+
+  for (i = 0; i < queue_depth; i++)
+    {
+      ring->requests[i].is_busy = false;
+      ring->free_requests[i] = (int) (queue_depth - 1 - i);
+    }
+  ring->n_free = (int) queue_depth;
+
+  return ring;
+}
+
+/*
+ * fileio_io_ring_destroy () - unmap the queues of ring and close it
+ *   return: void
+ *   ring(in): the ring
+ */
+static void
+fileio_io_ring_destroy (FILEIO_IO_RING * ring)
+{
+  if (ring->sqes != MAP_FAILED)
+    {
+      munmap (ring->sqes, ring->sqes_size);
+    }
+  if (ring->cq_map != MAP_FAILED)
+    {
+      munmap (ring->cq_map, ring->cq_map_size);
+    }
+  if (ring->sq_map != MAP_FAILED)
+    {
+      munmap (ring->sq_map, ring->sq_map_size);
+    }
+  if (ring->ring_fd >= 0)
+    {
+      close (ring->ring_fd);
+    }
+  free_and_init (ring->requests);
+  free_and_init (ring->free_requests);
+  free (ring);
+}
+
+/*
+ * fileio_io_ring_enter () - submit the queued requests of ring and wait for completions
+ *   return: error code
+ *   ring(in): the ring
+ *   min_complete(in): number of completions to wait for
+ */
+static int
+fileio_io_ring_enter (FILEIO_IO_RING * ring, unsigned int min_complete)
+{
+  int n_submitted;
+
+  /* make the prepared entries visible to kernel */
+  __atomic_store_n (ring->sq_tail, ring->sq_local_tail, __ATOMIC_RELEASE);
+
+  while (true)
+    {
+      n_submitted = (int) syscall (__NR_io_uring_enter, ring->ring_fd, (unsigned int) ring->n_queued, min_complete,
+				   IORING_ENTER_GETEVENTS, NULL, 0);
+      if (n_submitted >= 0)
+	{
+	  ring->n_queued -= n_submitted;
+	  ring->n_inflight += n_submitted;
+	  return NO_ERROR;
+	}
+
+      if (errno == EINTR || ((errno == EAGAIN || errno == EBUSY) && ring->n_inflight > 0))
+	{
+	  /* interrupted, or kernel is short of resources until some requests complete */
+	  if (errno != EINTR)
+	    {
+	      min_complete = 1;
+	    }
+	  continue;
+	}
+
+      er_log_debug (ARG_FILE_LINE, "fileio_io_ring_enter: io_uring_enter failed with errno %d.\n", errno);
+      return ER_FAILED;
+    }
+}
+
+/*
+ * fileio_io_ring_reap () - consume the completions of the batch ring
+ *   return: void
+ *   batch(in): the batch
+ *
+ * Note: the requests that were not completed in full are executed again synchronously; that also reports their
+ *       error the way fileio_read and fileio_write do.
+ */
+static void
+fileio_io_ring_reap (FILEIO_BATCH * batch)
+{
+  FILEIO_IO_RING *ring = batch->ring;
+  FILEIO_IO_REQUEST *request;
+  struct io_uring_cqe *cqe;
+  unsigned int head, tail;
+  int request_index, error_code;
+
+  head = *ring->cq_head;
+  tail = __atomic_load_n (ring->cq_tail, __ATOMIC_ACQUIRE);
+
+  while (head != tail)
+    {
+      cqe = &ring->cqes[head & ring->cq_mask];
+      request_index = (int) cqe->user_data;
+      request = &ring->requests[request_index];
+      assert (request->is_busy);
+
+      if (cqe->res == (int) request->iov.iov_len)
+	{
+	  perfmon_inc_stat (batch->thread_p, request->is_write ? PSTAT_FILE_NUM_IOWRITES : PSTAT_FILE_NUM_IOREADS);
+	  error_code = NO_ERROR;
+	}
+      else
+	{
+	  error_code = fileio_batch_execute (batch->thread_p, request->is_write, request->vol_fd,
+					     request->iov.iov_base, request->page_id, request->iov.iov_len);
+	}
+
+      if (error_code != NO_ERROR && batch->error_code == NO_ERROR)
+	{
+	  batch->error_code = error_code;
+	}
+      if (request->error_p != NULL)
+	{
+	  *request->error_p = error_code;
+	}
+
+      request->is_busy = false;
+      ring->free_requests[ring->n_free++] = request_index;
+      ring->n_inflight--;
+      head++;
+    }
+
+  __atomic_store_n (ring->cq_head, head, __ATOMIC_RELEASE);
+}
+
+/*
+ * fileio_io_ring_execute_outstanding () - give up the batch ring after a submission failure; execute its outstanding
+ *					   requests synchronously
+ *   return: void
+ *   batch(in): the batch
+ */
+static void
+fileio_io_ring_execute_outstanding (FILEIO_BATCH * batch)
+{
+  FILEIO_IO_RING *ring = batch->ring;
+  FILEIO_IO_REQUEST *request;
+  unsigned int i;
+  int error_code;
+
+  ring->is_broken = true;
+
+  for (i = 0; i < ring->queue_depth; i++)
+    {
+      request = &ring->requests[i];
+      if (!request->is_busy)
+	{
+	  continue;
+	}
+
+      error_code = fileio_batch_execute (batch->thread_p, request->is_write, request->vol_fd, request->iov.iov_base,
+					 request->page_id, request->iov.iov_len);
+      if (error_code != NO_ERROR && batch->error_code == NO_ERROR)
+	{
+	  batch->error_code = error_code;
+	}
+      if (request->error_p != NULL)
+	{
+	  *request->error_p = error_code;
+	}
+      request->is_busy = false;
+      ring->free_requests[ring->n_free++] = (int) i;
+    }
+
+  ring->n_queued = 0;
+  ring->n_inflight = 0;
+}
+#endif /* FILEIO_HAVE_IO_URING */
+
 /*
  * fileio_synchronize () - Synchronize a database volume's state with that on disk
  *   return: vdes or NULL_VOLDES
@@ -5857,6 +6482,40 @@ fileio_make_dwb_name (char *dwb_name_p, const char *dwb_path_p, const char *db_n
   sprintf (dwb_name_p, "%s%s%s%s", dwb_path_p, FILEIO_PATH_SEPARATOR (dwb_path_p), db_name_p, FILEIO_SUFFIX_DWB);
 }
 
+/*
+ * fileio_make_warmup_name () - Build the name of the file with the pages to load at page buffer warm-up
+ *   return: void
+ *   warmup_name_p(out): the name of the file
+ *   warmup_path_p(in): path of the file
+ *   db_name_p(in): database name
+ *
+ * Note: The caller must have enough space to store the name of the file that is constructed(sprintf). It is
+ *       recommended to have at least DB_MAX_PATH_LENGTH length.
+ */
+void
+fileio_make_warmup_name (char *warmup_name_p, const char *warmup_path_p, const char *db_name_p)
+{
+  sprintf (warmup_name_p, "%s%s%s%s", warmup_path_p, FILEIO_PATH_SEPARATOR (warmup_path_p), db_name_p,
+	   FILEIO_SUFFIX_WARMUP);
+}
+
+/*
+ * fileio_make_xcache_name () - Build the name of the file with the saved XASL cache entries
+ *   return: void
+ *   xcache_name_p(out): the name of the file
+ *   xcache_path_p(in): path of the file
+ *   db_name_p(in): database name
+ *
+ * Note: The caller must have enough space to store the name of the file that is constructed(sprintf). It is
+ *       recommended to have at least DB_MAX_PATH_LENGTH length.
+ */
+void
+fileio_make_xcache_name (char *xcache_name_p, const char *xcache_path_p, const char *db_name_p)
+{
+  sprintf (xcache_name_p, "%s%s%s%s", xcache_path_p, FILEIO_PATH_SEPARATOR (xcache_path_p), db_name_p,
+	   FILEIO_SUFFIX_XCACHE);
+}
+
 
 /*
  * fileio_cache () - Cache information related to a mounted volume
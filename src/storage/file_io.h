@@ -85,6 +85,8 @@
 #define FILEIO_VOLINFO_SUFFIX        "_vinf"
 #define FILEIO_VOLLOCK_SUFFIX        "__lock"
 #define FILEIO_SUFFIX_DWB            "_dwb"
+#define FILEIO_SUFFIX_WARMUP         "_bfwarm"
+#define FILEIO_SUFFIX_XCACHE         "_xcache"
 #define FILEIO_MAX_SUFFIX_LENGTH     7
 
 typedef enum
@@ -451,6 +453,22 @@ struct flush_stats
   unsigned int num_tokens;
 };
 
+/* io_uring instance; the requests of a batch are queued into its submission ring */
+typedef struct fileio_io_ring FILEIO_IO_RING;
+
+/*
+ * Page reads and writes submitted to the kernel together and reaped when the caller waits for them. Without a ring
+ * (pread backend, or io_uring not available) every request is executed synchronously when it is added.
+ */
+typedef struct fileio_batch FILEIO_BATCH;
+struct fileio_batch
+{
+  THREAD_ENTRY *thread_p;
+  FILEIO_IO_RING *ring;		/* NULL for synchronous requests */
+  int n_requests;		/* requests added since fileio_batch_begin */
+  int error_code;		/* error of the first failed request */
+};
+
 extern int fileio_open (const char *vlabel, int flags, int mode);
 extern void fileio_close (int vdes);
 extern int fileio_format (THREAD_ENTRY * thread_p, const char *db_fullname, const char *vlabel, VOLID volid,
@@ -486,6 +504,15 @@ extern void *fileio_write_pages (THREAD_ENTRY * thread_p, int vol_fd, char *io_p
 				 size_t page_size, FILEIO_WRITE_MODE write_mode);
 extern void *fileio_writev (THREAD_ENTRY * thread_p, int vdes, void **arrayof_io_pgptr, PAGEID start_pageid,
 			    DKNPAGES npages, size_t page_size);
+extern void fileio_batch_begin (THREAD_ENTRY * thread_p, FILEIO_BATCH * batch, int backend, int queue_depth);
+extern int fileio_batch_add_read (FILEIO_BATCH * batch, int vol_fd, void *io_page_p, PAGEID page_id, size_t page_size,
+				  int *error_p);
+extern int fileio_batch_add_write (FILEIO_BATCH * batch, int vol_fd, void *io_page_p, PAGEID page_id,
+				   size_t page_size, int *error_p);
+extern int fileio_batch_wait (FILEIO_BATCH * batch);
+extern int fileio_batch_end (FILEIO_BATCH * batch);
+extern bool fileio_batch_is_async (const FILEIO_BATCH * batch);
+extern void fileio_batch_finalize (void);
 extern int fileio_synchronize (THREAD_ENTRY * thread_p, int vdes, const char *vlabel,
 			       FILEIO_SYNC_OPTION check_sync_dwb);
 extern int fileio_synchronize_all (THREAD_ENTRY * thread_p, bool include_log);
@@ -537,6 +564,8 @@ extern void fileio_make_backup_volume_info_name (char *backup_volinfo_name, cons
 extern void fileio_make_backup_name (char *backup_name, const char *nopath_volname, const char *backup_path,
 				     FILEIO_BACKUP_LEVEL level, int unit_num);
 extern void fileio_make_dwb_name (char *dwb_name_p, const char *dwb_path_p, const char *db_name_p);
+extern void fileio_make_warmup_name (char *warmup_name_p, const char *warmup_path_p, const char *db_name_p);
+extern void fileio_make_xcache_name (char *xcache_name_p, const char *xcache_path_p, const char *db_name_p);
 extern void fileio_remove_all_backup (THREAD_ENTRY * thread_p, int level);
 extern FILEIO_BACKUP_SESSION *fileio_initialize_backup (const char *db_fullname, const char *backup_destination,
 							FILEIO_BACKUP_SESSION * session, FILEIO_BACKUP_LEVEL level,
@@ -423,6 +423,18 @@ struct file_map_context
   void *args;
 };
 
+typedef struct file_sample_context FILE_SAMPLE_CONTEXT;
+struct file_sample_context
+{
+  bool is_partial;
+  FILE_FTAB_COLLECTOR ftab_collector;
+
+  VPID *vpids;			/* sample reservoir */
+  int max_vpids;		/* reservoir size */
+  int n_vpids;			/* number of pages in reservoir */
+  INT64 n_seen;			/* number of user pages visited so far */
+};
+
 /************************************************************************/
 /* Numerable files section                                              */
 /************************************************************************/
@@ -711,6 +723,7 @@ static int file_rv_dealloc_internal (THREAD_ENTRY * thread_p, LOG_RCV * rcv, boo
 STATIC_INLINE int file_create_temp_internal (THREAD_ENTRY * thread_p, int npages, FILE_TYPE ftype, bool is_numerable,
 					     VFID * vfid_out) __attribute__ ((ALWAYS_INLINE));
 static int file_sector_map_pages (THREAD_ENTRY * thread_p, const void *data, int index, bool * stop, void *args);
+static int file_sector_sample_pages (THREAD_ENTRY * thread_p, const void *data, int index, bool * stop, void *args);
 static DISK_ISVALID file_table_check (THREAD_ENTRY * thread_p, const VFID * vfid, DISK_VOLMAP_CLONE * disk_map_clone);
 
 STATIC_INLINE int file_table_dump (THREAD_ENTRY * thread_p, const FILE_HEADER * fhead, FILE * fp)
@@ -6922,6 +6935,161 @@ exit:
   return error_code;
 }
 
+/*
+ * file_sector_sample_pages () - FILE_EXTDATA_ITEM_FUNC used to sample user pages of a sector
+ *
+ * return        : NO_ERROR
+ * thread_p (in) : thread entry
+ * data (in)     : FILE_PARTIAL_SECTOR or VSID
+ * index (in)    : ignored
+ * stop (out)    : ignored
+ * args (in)     : sample context
+ */
+static int
+file_sector_sample_pages (THREAD_ENTRY * thread_p, const void *data, int index, bool * stop, void *args)
+{
+  FILE_SAMPLE_CONTEXT *context = (FILE_SAMPLE_CONTEXT *) args;
+  FILE_PARTIAL_SECTOR partsect = FILE_PARTIAL_SECTOR_INITIALIZER;
+  INT64 slot;
+  int iter;
+  VPID vpid;
+
+  /* same hack as file_sector_map_pages */
+  if (context->is_partial)
+    {
+      partsect = *(FILE_PARTIAL_SECTOR *) data;
+    }
+  else
+    {
+      partsect.vsid = *(VSID *) data;
+    }
+
+  vpid.volid = partsect.vsid.volid;
+  for (iter = 0, vpid.pageid = SECTOR_FIRST_PAGEID (partsect.vsid.sectid); iter < FILE_ALLOC_BITMAP_NBITS;
+       iter++, vpid.pageid++)
+    {
+      if (context->is_partial && !file_partsect_is_bit_set (&partsect, iter))
+	{
+	  /* not allocated */
+	  continue;
+	}
+
+      if (file_table_collector_has_page (&context->ftab_collector, &vpid))
+	{
+	  /* skip table pages */
+	  continue;
+	}
+
+      /* reservoir sampling: every user page ends up in the sample with the same probability */
+      context->n_seen++;
+      if (context->n_vpids < context->max_vpids)
+	{
+	  context->vpids[context->n_vpids++] = vpid;
+	}
+      else
+	{
+	  slot = (INT64) (drand48 () * context->n_seen);
+	  if (slot < context->max_vpids)
+	    {
+	      context->vpids[slot] = vpid;
+	    }
+	}
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * file_sample_pages () - pick a uniform random sample of user pages without fixing them
+ *
+ * return          : error code
+ * thread_p (in)   : thread entry
+ * vfid (in)       : file identifier
+ * max_pages (in)  : maximum number of pages in sample
+ * vpids_out (out) : sampled pages sorted by VPID; must have room for max_pages entries
+ * n_pages_out (out) : number of sampled pages
+ *
+ * note: only the file header and table pages are fixed. this makes the cost of sampling proportional to the size of
+ *       the file table (one entry for each sector) instead of the size of the file.
+ */
+int
+file_sample_pages (THREAD_ENTRY * thread_p, const VFID * vfid, int max_pages, VPID * vpids_out, int *n_pages_out)
+{
+  VPID vpid_fhead;
+  PAGE_PTR page_fhead = NULL;
+  FILE_HEADER *fhead = NULL;
+  FILE_EXTENSIBLE_DATA *extdata_ftab;
+  FILE_SAMPLE_CONTEXT context;
+  int error_code = NO_ERROR;
+
+  assert (vfid != NULL && !VFID_ISNULL (vfid));
+  assert (max_pages > 0 && vpids_out != NULL && n_pages_out != NULL);
+
+  *n_pages_out = 0;
+
+  FILE_GET_HEADER_VPID (vfid, &vpid_fhead);
+  page_fhead = pgbuf_fix (thread_p, &vpid_fhead, OLD_PAGE, PGBUF_LATCH_READ, PGBUF_UNCONDITIONAL_LATCH);
+  if (page_fhead == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error_code);
+      return error_code;
+    }
+  fhead = (FILE_HEADER *) page_fhead;
+  file_header_sanity_check (thread_p, fhead);
+
+  context.ftab_collector.partsect_ftab = NULL;
+  context.vpids = vpids_out;
+  context.max_vpids = max_pages;
+  context.n_vpids = 0;
+  context.n_seen = 0;
+
+  error_code = file_table_collect_ftab_pages (thread_p, page_fhead, true, &context.ftab_collector);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      goto exit;
+    }
+
+  FILE_HEADER_GET_PART_FTAB (fhead, extdata_ftab);
+  context.is_partial = true;
+  error_code = file_extdata_apply_funcs (thread_p, extdata_ftab, NULL, NULL, file_sector_sample_pages, &context, false,
+					 NULL, NULL);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      goto exit;
+    }
+
+  if (!FILE_IS_TEMPORARY (fhead))
+    {
+      context.is_partial = false;
+      FILE_HEADER_GET_FULL_FTAB (fhead, extdata_ftab);
+      error_code = file_extdata_apply_funcs (thread_p, extdata_ftab, NULL, NULL, file_sector_sample_pages, &context,
+					     false, NULL, NULL);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  goto exit;
+	}
+    }
+
+  /* visit the sampled pages in disk order */
+  qsort (context.vpids, context.n_vpids, sizeof (VPID), pgbuf_compare_vpid);
+  *n_pages_out = context.n_vpids;
+
+exit:
+  if (page_fhead != NULL)
+    {
+      pgbuf_unfix (thread_p, page_fhead);
+    }
+  if (context.ftab_collector.partsect_ftab != NULL)
+    {
+      db_private_free (thread_p, context.ftab_collector.partsect_ftab);
+    }
+
+  return error_code;
+}
+
 /*
  * file_table_check () - check file table is valid
  *
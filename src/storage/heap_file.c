@@ -44,6 +44,7 @@
 #include "boot_sr.h"
 #include "locator_sr.h"
 #include "btree.h"
+#include "btree_insert_buffer.hpp"
 #include "btree_unique.hpp"
 #include "transform.h"		/* for CT_SERIAL_NAME */
 #include "serial.h"
@@ -759,6 +760,8 @@ static int fill_string_to_buffer (char **start, char *end, const char *str);
 static SCAN_CODE heap_get_record_info (THREAD_ENTRY * thread_p, const OID oid, RECDES * recdes, RECDES forward_recdes,
 				       PGBUF_WATCHER * page_watcher, HEAP_SCANCACHE * scan_cache, bool ispeeking,
 				       DB_VALUE ** record_info);
+static void heap_scancache_page_set_next (HEAP_SCANCACHE * scan_cache, VPID * vpid);
+static void heap_scancache_page_set_seek (HEAP_SCANCACHE * scan_cache, const OID * oid);
 static SCAN_CODE heap_next_internal (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid, OID * next_oid,
 				     RECDES * recdes, HEAP_SCANCACHE * scan_cache, bool ispeeking,
 				     bool reversed_direction, DB_VALUE ** cache_recordinfo);
@@ -6751,9 +6754,14 @@ heap_scancache_start_internal (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_ca
   scan_cache->start_area ();
   scan_cache->num_btids = 0;
   scan_cache->m_index_stats = NULL;
+  scan_cache->m_insert_buffer = NULL;
   scan_cache->debug_initpattern = HEAP_DEBUG_SCANCACHE_INITPATTERN;
   scan_cache->mvcc_snapshot = mvcc_snapshot;
   scan_cache->partition_list = NULL;
+  VPID_SET_NULL (&scan_cache->read_ahead_vpid);
+  scan_cache->page_set = NULL;
+  scan_cache->n_page_set = 0;
+  scan_cache->page_set_pos = 0;
 
   return ret;
 
@@ -6767,10 +6775,15 @@ exit_on_error:
   PGBUF_INIT_WATCHER (&(scan_cache->page_watcher), PGBUF_ORDERED_RANK_UNDEFINED, PGBUF_ORDERED_NULL_HFID);
   scan_cache->num_btids = 0;
   scan_cache->m_index_stats = NULL;
+  scan_cache->m_insert_buffer = NULL;
   scan_cache->file_type = FILE_UNKNOWN_TYPE;
   scan_cache->debug_initpattern = 0;
   scan_cache->mvcc_snapshot = NULL;
   scan_cache->partition_list = NULL;
+  VPID_SET_NULL (&scan_cache->read_ahead_vpid);
+  scan_cache->page_set = NULL;
+  scan_cache->n_page_set = 0;
+  scan_cache->page_set_pos = 0;
 
   return (ret == NO_ERROR && (ret = er_errid ()) == NO_ERROR) ? ER_FAILED : ret;
 }
@@ -7047,10 +7060,15 @@ heap_scancache_quick_start_internal (HEAP_SCANCACHE * scan_cache, const HFID * h
   scan_cache->start_area ();
   scan_cache->num_btids = 0;
   scan_cache->m_index_stats = NULL;
+  scan_cache->m_insert_buffer = NULL;
   scan_cache->file_type = FILE_UNKNOWN_TYPE;
   scan_cache->debug_initpattern = HEAP_DEBUG_SCANCACHE_INITPATTERN;
   scan_cache->mvcc_snapshot = NULL;
   scan_cache->partition_list = NULL;
+  VPID_SET_NULL (&scan_cache->read_ahead_vpid);
+  scan_cache->page_set = NULL;
+  scan_cache->n_page_set = 0;
+  scan_cache->page_set_pos = 0;
 
   return NO_ERROR;
 }
@@ -7079,6 +7097,8 @@ heap_scancache_quick_end (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache)
     {
       delete scan_cache->m_index_stats;
       scan_cache->m_index_stats = NULL;
+      delete scan_cache->m_insert_buffer;
+      scan_cache->m_insert_buffer = NULL;
       scan_cache->num_btids = 0;
 
       if (scan_cache->cache_last_fix_page == true)
@@ -7140,6 +7160,99 @@ heap_scancache_end_internal (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cach
   return ret;
 }
 
+/*
+ * heap_scancache_set_page_set () - Restrict a sequential heap scan to a set of pages
+ *   return: void
+ *   scan_cache(in/out): Scan cache
+ *   page_set(in): Pages of the heap file to scan, sorted by VPID; NULL to scan the whole heap
+ *   n_page_set(in): Number of pages in page_set
+ *
+ * Note: Used by parallel scans, each worker visiting its own share of the heap pages (see file_sample_pages).
+ *       Pages that are deallocated by the time the scan reaches them are skipped. Only forward scans honor the
+ *       page set. The array must outlive the scan.
+ */
+void
+heap_scancache_set_page_set (HEAP_SCANCACHE * scan_cache, const VPID * page_set, int n_page_set)
+{
+  assert (scan_cache != NULL);
+  assert (page_set != NULL || n_page_set == 0);
+
+  scan_cache->page_set = page_set;
+  scan_cache->n_page_set = n_page_set;
+  scan_cache->page_set_pos = 0;
+}
+
+/*
+ * heap_scancache_page_set_next () - Advance to the next page of the scan page set
+ *   return: void
+ *   scan_cache(in/out): Scan cache
+ *   vpid(out): Next page in set or NULL VPID if there are no more pages
+ */
+static void
+heap_scancache_page_set_next (HEAP_SCANCACHE * scan_cache, VPID * vpid)
+{
+  assert (scan_cache->page_set != NULL);
+
+  if (scan_cache->page_set_pos + 1 < scan_cache->n_page_set)
+    {
+      *vpid = scan_cache->page_set[++scan_cache->page_set_pos];
+    }
+  else
+    {
+      scan_cache->page_set_pos = scan_cache->n_page_set;
+      VPID_SET_NULL (vpid);
+    }
+}
+
+/*
+ * heap_scancache_page_set_seek () - Position the page set on the page of given object
+ *   return: void
+ *   scan_cache(in/out): Scan cache
+ *   oid(in): Object the scan continues from
+ *
+ * Note: A scan may be resumed from an object on an earlier page than the last one visited (e.g. when the caller
+ *       backtracks a record that did not fit its buffer).
+ */
+static void
+heap_scancache_page_set_seek (HEAP_SCANCACHE * scan_cache, const OID * oid)
+{
+  const VPID *page;
+  int low, high, mid;
+
+  assert (scan_cache->page_set != NULL);
+
+  if (scan_cache->page_set_pos < scan_cache->n_page_set)
+    {
+      page = &scan_cache->page_set[scan_cache->page_set_pos];
+      if (page->volid == oid->volid && page->pageid == oid->pageid)
+	{
+	  return;
+	}
+    }
+
+  /* page set is sorted by VPID */
+  low = 0;
+  high = scan_cache->n_page_set - 1;
+  while (low <= high)
+    {
+      mid = (low + high) / 2;
+      page = &scan_cache->page_set[mid];
+      if (page->volid == oid->volid && page->pageid == oid->pageid)
+	{
+	  scan_cache->page_set_pos = mid;
+	  return;
+	}
+      if (page->volid < oid->volid || (page->volid == oid->volid && page->pageid < oid->pageid))
+	{
+	  low = mid + 1;
+	}
+      else
+	{
+	  high = mid - 1;
+	}
+    }
+}
+
 /*
  * heap_scancache_end () - Stop caching information for a heap scan
  *   return: NO_ERROR
@@ -7732,7 +7845,7 @@ static SCAN_CODE
 heap_next_internal (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid, OID * next_oid, RECDES * recdes,
 		    HEAP_SCANCACHE * scan_cache, bool ispeeking, bool reversed_direction, DB_VALUE ** cache_recordinfo)
 {
-  VPID vpid;
+  VPID vpid, next_vpid;
   VPID *vpidptr_incache;
   INT16 type = REC_UNKNOWN;
   OID oid;
@@ -7740,6 +7853,7 @@ heap_next_internal (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid,
   SCAN_CODE scan = S_ERROR;
   int get_rec_info = cache_recordinfo != NULL;
   bool is_null_recdata;
+  bool use_page_set;
   PGBUF_WATCHER curr_page_watcher;
   PGBUF_WATCHER old_page_watcher;
 
@@ -7786,6 +7900,18 @@ heap_next_internal (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid,
 	  oid.pageid = vpid.pageid;
 	  oid.slotid = NULL_SLOTID;
 	}
+      else if (scan_cache->page_set != NULL)
+	{
+	  /* Retrieve the first object of the page set */
+	  if (scan_cache->n_page_set <= 0)
+	    {
+	      return S_END;
+	    }
+	  scan_cache->page_set_pos = 0;
+	  oid.volid = scan_cache->page_set[0].volid;
+	  oid.pageid = scan_cache->page_set[0].pageid;
+	  oid.slotid = 0;	/* i.e., will get slot 1 */
+	}
       else
 	{
 	  /* Retrieve the first object of the heap */
@@ -7797,8 +7923,13 @@ heap_next_internal (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid,
   else
     {
       oid = *next_oid;
+      if (scan_cache->page_set != NULL && !reversed_direction)
+	{
+	  heap_scancache_page_set_seek (scan_cache, &oid);
+	}
     }
 
+  use_page_set = (scan_cache->page_set != NULL && !reversed_direction);
 
   is_null_recdata = (recdes->data == NULL);
 
@@ -7832,13 +7963,30 @@ heap_next_internal (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid,
 	    }
 	  if (curr_page_watcher.pgptr == NULL)
 	    {
+	      /* pages of a page set are collected before the scan; vacuum may deallocate them in the meantime */
 	      curr_page_watcher.pgptr =
-		heap_scan_pb_lock_and_fetch (thread_p, &vpid, OLD_PAGE_PREVENT_DEALLOC, S_LOCK, scan_cache,
-					     &curr_page_watcher);
+		heap_scan_pb_lock_and_fetch (thread_p, &vpid,
+					     use_page_set ? OLD_PAGE_MAYBE_DEALLOCATED : OLD_PAGE_PREVENT_DEALLOC, S_LOCK,
+					     scan_cache, &curr_page_watcher);
 	      if (old_page_watcher.pgptr != NULL)
 		{
 		  pgbuf_ordered_unfix (thread_p, &old_page_watcher);
 		}
+	      if (curr_page_watcher.pgptr == NULL && use_page_set && er_errid () == ER_PB_BAD_PAGEID)
+		{
+		  /* deallocated, skip it */
+		  er_clear ();
+		  heap_scancache_page_set_next (scan_cache, &vpid);
+		  if (VPID_ISNULL (&vpid))
+		    {
+		      OID_SET_NULL (next_oid);
+		      return S_END;
+		    }
+		  oid.volid = vpid.volid;
+		  oid.pageid = vpid.pageid;
+		  oid.slotid = -1;
+		  continue;
+		}
 	      if (curr_page_watcher.pgptr == NULL)
 		{
 		  if (er_errid () == ER_PB_BAD_PAGEID)
@@ -7851,6 +7999,21 @@ heap_next_internal (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid,
 		  assert (scan_cache->page_watcher.pgptr == NULL);
 		  return S_ERROR;
 		}
+
+	      if (use_page_set)
+		{
+		  if (scan_cache->page_set_pos + 1 < scan_cache->n_page_set)
+		    {
+		      pgbuf_read_ahead (thread_p, &scan_cache->page_set[scan_cache->page_set_pos + 1],
+					&scan_cache->read_ahead_vpid);
+		    }
+		}
+	      else if (!reversed_direction
+		       && heap_vpid_next (thread_p, hfid, curr_page_watcher.pgptr, &next_vpid) == NO_ERROR)
+		{
+		  /* let page buffer read the following pages while this one is scanned */
+		  pgbuf_read_ahead (thread_p, &next_vpid, &scan_cache->read_ahead_vpid);
+		}
 	    }
 
 	  if (get_rec_info)
@@ -7918,6 +8081,10 @@ heap_next_internal (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid,
 		    {
 		      (void) heap_vpid_prev (thread_p, hfid, curr_page_watcher.pgptr, &vpid);
 		    }
+		  else if (use_page_set)
+		    {
+		      heap_scancache_page_set_next (scan_cache, &vpid);
+		    }
 		  else
 		    {
 		      (void) heap_vpid_next (thread_p, hfid, curr_page_watcher.pgptr, &vpid);
@@ -16345,6 +16512,93 @@ xheap_get_class_num_objects_pages (THREAD_ENTRY * thread_p, const HFID * hfid, i
   return NO_ERROR;
 }
 
+/*
+ * xheap_get_pages () - Get pages of a heap file in VPID order
+ *   return: NO_ERROR or error code
+ *   hfid(in): Heap file
+ *   lower(in): Pages before this one are skipped; NULL VPID to start with the first page
+ *   upper(in): Pages from this one on are skipped; NULL VPID to go on to the last page
+ *   step(in): Every step-th page of the range is returned
+ *   pages_out(out): The pages, allocated with malloc; NULL when there are none
+ *   n_pages_out(out): Number of pages
+ *
+ * Note: unloaddb splits big heaps in parts: every step-th page of the whole heap gives the bounds of the parts, and
+ *       each worker asks for the pages between two bounds. The pages are read from the file table without being
+ *       fixed (see file_sample_pages).
+ */
+int
+xheap_get_pages (THREAD_ENTRY * thread_p, const HFID * hfid, const VPID * lower, const VPID * upper, int step,
+		 VPID ** pages_out, int *n_pages_out)
+{
+  VPID *pages;
+  int n_user_pages, max_pages, n_pages;
+  int in_range;
+  int i, n;
+  int error_code;
+
+  assert (!HFID_IS_NULL (hfid));
+  assert (step > 0);
+
+  *pages_out = NULL;
+  *n_pages_out = 0;
+
+  error_code = file_get_num_user_pages (thread_p, &hfid->vfid, &n_user_pages);
+  if (error_code != NO_ERROR)
+    {
+      return error_code;
+    }
+
+  /* leave room for pages allocated meanwhile; if the array still fills up, pages may be missing */
+  max_pages = n_user_pages + DISK_SECTOR_NPAGES;
+  pages = (VPID *) malloc (max_pages * sizeof (VPID));
+  if (pages == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) (max_pages * sizeof (VPID)));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  error_code = file_sample_pages (thread_p, &hfid->vfid, max_pages, pages, &n_pages);
+  if (error_code != NO_ERROR)
+    {
+      free_and_init (pages);
+      return error_code;
+    }
+  if (n_pages >= max_pages)
+    {
+      free_and_init (pages);
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_GENERIC_ERROR, 0);
+      return ER_GENERIC_ERROR;
+    }
+
+  /* the pages are sorted; keep every step-th page between the bounds */
+  in_range = 0;
+  for (i = 0, n = 0; i < n_pages; i++)
+    {
+      if (!VPID_ISNULL (lower) && pgbuf_compare_vpid (&pages[i], lower) < 0)
+	{
+	  continue;
+	}
+      if (!VPID_ISNULL (upper) && pgbuf_compare_vpid (&pages[i], upper) >= 0)
+	{
+	  break;
+	}
+      if (in_range++ % step == 0)
+	{
+	  pages[n++] = pages[i];
+	}
+    }
+
+  if (n == 0)
+    {
+      free_and_init (pages);
+    }
+
+  *pages_out = pages;
+  *n_pages_out = n;
+
+  return NO_ERROR;
+}
+
 /*
  * xheap_has_instance () -
  *   return:
@@ -42,6 +42,7 @@
 #include "thread_compat.hpp"
 
 // forward declarations
+class btree_insert_buffer;
 class multi_index_unique_stats;
 class record_descriptor;
 
@@ -148,11 +149,16 @@ struct heap_scancache
     PGBUF_WATCHER page_watcher;
     int num_btids;		/* Total number of indexes defined on the scanning class */
     multi_index_unique_stats *m_index_stats;	// does this really belong to scan cache??
+    btree_insert_buffer *m_insert_buffer;	// if not NULL, keys of inserted rows are buffered and inserted in key order
     FILE_TYPE file_type;		/* The file type of the heap file being scanned. Can be FILE_HEAP or
 				         * FILE_HEAP_REUSE_SLOTS */
     MVCC_SNAPSHOT *mvcc_snapshot;	/* mvcc snapshot */
     HEAP_SCANCACHE_NODE_LIST *partition_list;	/* list holding the heap file information for partition nodes involved
 						 * in the scan */
+    VPID read_ahead_vpid;	/* read-ahead cursor of sequential scans (see pgbuf_read_ahead) */
+    const VPID *page_set;	/* if not NULL, forward scans visit only these pages, in this order */
+    int n_page_set;		/* number of pages in page_set */
+    int page_set_pos;		/* position of current page in page_set */
 
 
     void start_area ();
@@ -408,6 +414,7 @@ extern int heap_scancache_quick_start_modify (HEAP_SCANCACHE * scan_cache);
 extern int heap_scancache_end (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache);
 extern int heap_scancache_end_when_scan_will_resume (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache);
 extern void heap_scancache_end_modify (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache);
+extern void heap_scancache_set_page_set (HEAP_SCANCACHE * scan_cache, const VPID * page_set, int n_page_set);
 extern SCAN_CODE heap_get_class_oid (THREAD_ENTRY * thread_p, const OID * oid, OID * class_oid);
 extern SCAN_CODE heap_next (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid, OID * next_oid,
 			    RECDES * recdes, HEAP_SCANCACHE * scan_cache, int ispeeking);
@@ -521,6 +528,8 @@ extern void heap_chnguess_clear (THREAD_ENTRY * thread_p, int tran_index);
 /* Misc */
 extern int xheap_get_class_num_objects_pages (THREAD_ENTRY * thread_p, const HFID * hfid, int approximation, int *nobjs,
 					      int *npages);
+extern int xheap_get_pages (THREAD_ENTRY * thread_p, const HFID * hfid, const VPID * lower, const VPID * upper,
+			    int step, VPID ** pages_out, int *n_pages_out);
 
 extern int xheap_has_instance (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid, int has_visible_instance);
 
@@ -31,6 +31,7 @@
 #include <assert.h>
 
 #include "page_buffer.h"
+#include "page_buffer_latch.hpp"
 
 #include "storage_common.h"
 #include "memory_alloc.h"
@@ -221,6 +222,8 @@ typedef enum
 #define PGBUF_BCB_TO_VACUUM_FLAG            ((int) 0x04000000)
 /* flag for asynchronous flush request */
 #define PGBUF_BCB_ASYNC_FLUSH_REQ           ((int) 0x02000000)
+/* flag for pages loaded by read-ahead and not fixed since. */
+#define PGBUF_BCB_READ_AHEAD_FLAG           ((int) 0x01000000)
 
 /* add all flags here */
 #define PGBUF_BCB_FLAGS_MASK \
@@ -230,7 +233,8 @@ typedef enum
    | PGBUF_BCB_INVALIDATE_DIRECT_VICTIM_FLAG \
    | PGBUF_BCB_MOVE_TO_LRU_BOTTOM_FLAG \
    | PGBUF_BCB_TO_VACUUM_FLAG \
-   | PGBUF_BCB_ASYNC_FLUSH_REQ)
+   | PGBUF_BCB_ASYNC_FLUSH_REQ \
+   | PGBUF_BCB_READ_AHEAD_FLAG)
 
 /* add flags that invalidate a victim candidate here */
 /* 1. dirty bcb's cannot be victimized.
@@ -429,7 +433,7 @@ struct pgbuf_bcb
   int owner_mutex;		/* mutex owner */
 #endif				/* SERVER_MODE */
   VPID vpid;			/* Volume and page identifier of resident page */
-  int fcnt;			/* Fix count */
+  volatile int fcnt;		/* Fix count; changed atomically, see page_buffer_latch.hpp */
   PGBUF_LATCH_MODE latch_mode;	/* page latch mode */
   volatile int flags;
 #if defined(SERVER_MODE)
@@ -773,6 +777,7 @@ struct pgbuf_monitor_bcb_mutex
 };
 #if defined (SERVER_MODE)
 static bool pgbuf_Monitor_locks = false;
+static bool pgbuf_Optimistic_fix = false;
 #endif /* SERVER_MODE */
 
 #if defined (SERVER_MODE)
@@ -935,6 +940,11 @@ STATIC_INLINE int pgbuf_latch_bcb_upon_fix (THREAD_ENTRY * thread_p, PGBUF_BCB *
 					    int buf_lock_acquired, PGBUF_LATCH_CONDITION condition,
 					    bool * is_latch_wait) __attribute__ ((ALWAYS_INLINE));
 static int pgbuf_latch_idle_page (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr, PGBUF_LATCH_MODE request_mode);
+STATIC_INLINE int pgbuf_register_read_holder (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr, bool buf_is_dirty)
+  __attribute__ ((ALWAYS_INLINE));
+#if defined (SERVER_MODE)
+static PGBUF_BCB *pgbuf_fix_optimistic (THREAD_ENTRY * thread_p, PGBUF_BUFFER_HASH * hash_anchor, const VPID * vpid);
+#endif /* SERVER_MODE */
 
 STATIC_INLINE PGBUF_BCB *pgbuf_search_hash_chain (THREAD_ENTRY * thread_p, PGBUF_BUFFER_HASH * hash_anchor,
 						  const VPID * vpid) __attribute__ ((ALWAYS_INLINE));
@@ -1110,6 +1120,7 @@ STATIC_INLINE bool pgbuf_bcb_is_direct_victim (const PGBUF_BCB * bcb) __attribut
 STATIC_INLINE bool pgbuf_bcb_is_invalid_direct_victim (const PGBUF_BCB * bcb) __attribute__ ((ALWAYS_INLINE));
 STATIC_INLINE bool pgbuf_bcb_is_async_flush_request (const PGBUF_BCB * bcb) __attribute__ ((ALWAYS_INLINE));
 STATIC_INLINE bool pgbuf_bcb_is_to_vacuum (const PGBUF_BCB * bcb) __attribute__ ((ALWAYS_INLINE));
+STATIC_INLINE bool pgbuf_bcb_is_read_ahead (const PGBUF_BCB * bcb) __attribute__ ((ALWAYS_INLINE));
 STATIC_INLINE bool pgbuf_bcb_should_be_moved_to_bottom_lru (const PGBUF_BCB * bcb) __attribute__ ((ALWAYS_INLINE));
 STATIC_INLINE bool pgbuf_bcb_avoid_victim (const PGBUF_BCB * bcb) __attribute__ ((ALWAYS_INLINE));
 STATIC_INLINE void pgbuf_bcb_set_dirty (THREAD_ENTRY * thread_p, PGBUF_BCB * bcb) __attribute__ ((ALWAYS_INLINE));
@@ -1155,9 +1166,82 @@ static cubthread::daemon *pgbuf_Page_maintenance_daemon = NULL;
 static cubthread::daemon *pgbuf_Page_flush_daemon = NULL;
 static cubthread::daemon *pgbuf_Page_post_flush_daemon = NULL;
 static cubthread::daemon *pgbuf_Flush_control_daemon = NULL;
+static cubthread::daemon *pgbuf_Read_ahead_daemon = NULL;
 // *INDENT-ON*
 #endif /* SERVER_MODE */
 
+#if defined (SERVER_MODE)
+/* Read-ahead: sequential scans tell the page buffer which pages they are going to need next. The requests are queued
+ * and the read-ahead daemon loads the pages into free BCBs with one multi-page read per contiguous run, so that the
+ * scan finds them already in buffer. A request never crosses a disk sector; sectors belong to a single file. */
+#define PGBUF_READ_AHEAD_MAX_PAGES DISK_SECTOR_NPAGES
+#define PGBUF_READ_AHEAD_QUEUE_SIZE 64
+
+typedef struct pgbuf_read_ahead_request PGBUF_READ_AHEAD_REQUEST;
+struct pgbuf_read_ahead_request
+{
+  VPID vpid;			/* first page to read */
+  int npages;			/* number of pages to read */
+};
+
+typedef struct pgbuf_read_ahead_queue PGBUF_READ_AHEAD_QUEUE;
+struct pgbuf_read_ahead_queue
+{
+  pthread_mutex_t mutex;	/* protects the requests queue */
+  PGBUF_READ_AHEAD_REQUEST requests[PGBUF_READ_AHEAD_QUEUE_SIZE];
+  int head;			/* index of the oldest request */
+  int count;			/* number of queued requests */
+
+  /* used only by the read-ahead daemon */
+  PGBUF_BUFFER_LOCK locks[PGBUF_READ_AHEAD_MAX_PAGES];	/* buffer locks on the pages being read */
+  char *io_pages;		/* area for multi-page reads */
+};
+
+static PGBUF_READ_AHEAD_QUEUE pgbuf_Read_ahead;
+
+/* Warm-up: the pages of the LRU lists are saved to a file at shutdown (and periodically, if configured). After restart,
+ * the read-ahead daemon loads them back into free BCBs, hottest first and by VPID, at a bounded rate. */
+#define PGBUF_WARMUP_MAGIC 0x42465741	/* "BFWA" */
+
+typedef struct pgbuf_warmup_header PGBUF_WARMUP_HEADER;
+struct pgbuf_warmup_header
+{
+  int magic;
+  int io_pagesize;
+  int npages;
+};
+
+typedef struct pgbuf_warmup_page PGBUF_WARMUP_PAGE;
+struct pgbuf_warmup_page
+{
+  VPID vpid;
+  INT16 lru_zone;		/* 1, 2 or 3 */
+  INT16 is_hot;			/* pgbuf_bcb_is_hot when saved */
+};
+
+typedef struct pgbuf_warmup PGBUF_WARMUP;
+struct pgbuf_warmup
+{
+  PGBUF_WARMUP_PAGE *pages;	/* saved pages, ordered by priority and VPID */
+  int npages;
+  volatile int next_page;	/* index of the next page to load */
+  INT64 last_load_msec;		/* paces loads to data_buffer_warmup_rate */
+  INT64 last_save_msec;		/* time of the last periodic save */
+};
+
+static PGBUF_WARMUP pgbuf_Warmup;
+
+static bool pgbuf_read_ahead_dequeue (PGBUF_READ_AHEAD_REQUEST * request);
+static void pgbuf_read_ahead_pages (THREAD_ENTRY * thread_p, const VPID * first_vpid, int npages);
+static bool pgbuf_read_ahead_claim_bcb (THREAD_ENTRY * thread_p, const VPID * vpid, bool can_victimize,
+					PGBUF_BUFFER_LOCK * buffer_lock, PGBUF_BCB ** bufptr_out, bool * stop);
+static void pgbuf_read_ahead_load_run (THREAD_ENTRY * thread_p, PGBUF_BCB ** bcbs, int npages, const bool * is_hot);
+static void pgbuf_read_ahead_daemon_init ();
+static int pgbuf_warmup_compare_pages (const void *a, const void *b);
+static void pgbuf_warmup_read_list (void);
+static void pgbuf_warmup_load_pages (THREAD_ENTRY * thread_p);
+#endif /* SERVER_MODE */
+
 static bool pgbuf_is_page_flush_daemon_available ();
 
 /*
@@ -1264,6 +1348,7 @@ pgbuf_initialize (void)
 #else /* !NDEBUG */
   pgbuf_Monitor_locks = true;
 #endif /* !NDEBUG */
+  pgbuf_Optimistic_fix = prm_get_bool_value (PRM_ID_PB_OPTIMISTIC_FIX);
 #endif /* SERVER_MODE */
 
   /* set ratios for lru zones */
@@ -1793,6 +1878,22 @@ try_again:
   /* latch_mode = PGBUF_LATCH_READ/PGBUF_LATCH_WRITE */
   hash_anchor = &pgbuf_Pool.buf_hash_table[PGBUF_HASH_VALUE (vpid)];
 
+#if defined (SERVER_MODE)
+  if (pgbuf_Optimistic_fix && request_mode == PGBUF_LATCH_READ && fetch_mode == OLD_PAGE)
+    {
+      /* hot pages are usually read latched by others already; join them without any mutex */
+      bufptr = pgbuf_fix_optimistic (thread_p, hash_anchor, vpid);
+      if (bufptr != NULL)
+	{
+#if !defined (NDEBUG)
+	  holder = pgbuf_find_thrd_holder (thread_p, bufptr);
+	  pgbuf_add_fixed_at (holder, caller_file, caller_line, holder->fix_count == 1);
+#endif /* NDEBUG */
+	  goto fixed;
+	}
+    }
+#endif /* SERVER_MODE */
+
   buf_lock_acquired = false;
   bufptr = pgbuf_search_hash_chain (thread_p, hash_anchor, vpid);
   if (bufptr != NULL && pgbuf_bcb_is_direct_victim (bufptr))
@@ -1807,6 +1908,13 @@ try_again:
       pgbuf_hit = true;
 #endif /* ENABLE_SYSTEMTAP */
 
+      if (pgbuf_bcb_is_read_ahead (bufptr))
+	{
+	  /* first fix of a page loaded by read-ahead */
+	  pgbuf_bcb_update_flags (thread_p, bufptr, 0, PGBUF_BCB_READ_AHEAD_FLAG);
+	  perfmon_inc_stat (thread_p, PSTAT_PB_READ_AHEAD_NUM_HITS);
+	}
+
       if (fetch_mode == NEW_PAGE)
 	{
 	  /* Fix a page as NEW_PAGE, when oldest_unflush_lsa of the page is not NULL_LSA, it should be dirty. */
@@ -1927,6 +2035,9 @@ try_again:
   pgbuf_add_fixed_at (pgbuf_find_thrd_holder (thread_p, bufptr), caller_file, caller_line, !had_holder);
 #endif /* NDEBUG */
 
+#if defined (SERVER_MODE)
+fixed:
+#endif /* SERVER_MODE */
   if (perf.is_perf_tracking && is_latch_wait)
     {
       tsc_getticks (&perf.end_tick);
@@ -2079,6 +2190,10 @@ try_again:
 	  perfmon_pbx_fix_acquire_time (thread_p, perf.perf_page_type, perf.perf_page_found, perf.perf_latch_mode,
 					perf.perf_cond_type, perf.fix_wait_time);
 	}
+      if (is_latch_wait || perf.lock_wait_time > 0)
+	{
+	  perfmon_collect_latency (PERFMON_LATENCY_PB_FIX_WAIT, perf.fix_wait_time);
+	}
     }
 
   if (VACUUM_IS_THREAD_VACUUM_WORKER (thread_p))
@@ -2202,23 +2317,13 @@ pgbuf_promote_read_latch_release (THREAD_ENTRY * thread_p, PAGE_PTR * pgptr_p, P
   /* check if we're the single read latch holder */
   holder = pgbuf_find_thrd_holder (thread_p, bufptr);
   assert_release (holder != NULL);
-  if (holder->fix_count == bufptr->fcnt)
+try_in_place:
+  if (holder->fix_count == bufptr->fcnt
+      && !(bufptr->next_wait_thrd != NULL && bufptr->next_wait_thrd->wait_for_latch_promote)
+      && pgbuf_latch_try_exclusive (bufptr, holder->fix_count))
     {
-      assert (bufptr->latch_mode == PGBUF_LATCH_READ);
-
-      /* check for waiters for promotion */
-      if (bufptr->next_wait_thrd != NULL && bufptr->next_wait_thrd->wait_for_latch_promote)
-	{
-	  PGBUF_BCB_UNLOCK (bufptr);
-	  rv = ER_PAGE_LATCH_PROMOTE_FAIL;
-#if !defined(NDEBUG)
-	  er_set (ER_NOTIFICATION_SEVERITY, ARG_FILE_LINE, ER_PAGE_LATCH_PROMOTE_FAIL, 2, vpid.pageid, vpid.volid);
-#endif
-	  goto end;
-	}
-
-      /* we're the single holder of the read latch, do an in-place promotion */
-      bufptr->latch_mode = PGBUF_LATCH_WRITE;
+      /* we're the single holder of the read latch, the promotion was done in-place */
+      assert (bufptr->latch_mode == PGBUF_LATCH_WRITE);
       holder->perf_stat.hold_has_write_latch = 1;
       /* NOTE: no need to set the promoted flag as long as we don't wait */
       PGBUF_BCB_UNLOCK (bufptr);
@@ -2247,7 +2352,11 @@ pgbuf_promote_read_latch_release (THREAD_ENTRY * thread_p, PAGE_PTR * pgptr_p, P
 	  int fix_count = holder->fix_count;
 	  PGBUF_HOLDER_STAT perf_stat = holder->perf_stat;
 
-	  bufptr->fcnt -= fix_count;
+	  if (!pgbuf_latch_release_holder (bufptr, fix_count))
+	    {
+	      /* other fixes were optimistic and are gone */
+	      goto try_in_place;
+	    }
 	  holder->fix_count = 0;
 	  if (pgbuf_remove_thrd_holder (thread_p, holder) != NO_ERROR)
 	    {
@@ -2464,6 +2573,19 @@ pgbuf_unfix (THREAD_ENTRY * thread_p, PAGE_PTR pgptr)
 			 holder_perf_stat.dirtied_by_holder, perf_holder_latch);
     }
 
+#if defined (SERVER_MODE)
+  if (pgbuf_Optimistic_fix && holder_status == NO_ERROR && bufptr->latch_mode == PGBUF_LATCH_READ
+      && !pgbuf_bcb_is_async_flush_request (bufptr) && pgbuf_latch_try_unfix_shared (bufptr))
+    {
+      /* not the last fix of a read latched page; the last one does the rest, under mutex */
+#if !defined (NDEBUG)
+      thread_p->get_pgbuf_tracker ().decrement (pgptr);
+#endif // !NDEBUG
+      perfmon_inc_stat (thread_p, PSTAT_PB_NUM_OPTIMISTIC_UNFIXES);
+      return;
+    }
+#endif /* SERVER_MODE */
+
   PGBUF_BCB_LOCK (bufptr);
 
 #if !defined (NDEBUG)
@@ -5532,6 +5654,119 @@ pgbuf_latch_idle_page (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr, PGBUF_LATCH_
   return NO_ERROR;
 }
 
+/*
+ * pgbuf_register_read_holder () - register read fix of bcb in the holder entries of thread
+ *   return: NO_ERROR, or ER_code
+ *   bufptr(in): bcb that was read fixed
+ *   buf_is_dirty(in): was bcb dirty before the fix
+ *
+ * Note: bcb mutex is not required.
+ */
+STATIC_INLINE int
+pgbuf_register_read_holder (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr, bool buf_is_dirty)
+{
+  PGBUF_HOLDER *holder;
+
+  holder = pgbuf_find_thrd_holder (thread_p, bufptr);
+  if (holder != NULL)
+    {
+      /* the caller is the holder of the buffer page */
+      holder->fix_count++;
+      /* holder->dirty_before_holder not changed */
+      holder->perf_stat.hold_has_read_latch = 1;
+    }
+#if defined(SERVER_MODE)
+  else
+    {
+      /* the caller is not the holder of the buffer page */
+      /* allocate a BCB holder entry */
+      holder = pgbuf_allocate_thrd_holder_entry (thread_p);
+      if (holder == NULL)
+	{
+	  /* This situation must not be occurred. */
+	  assert (false);
+	  return ER_FAILED;
+	}
+
+      holder->fix_count = 1;
+      holder->bufptr = bufptr;
+      holder->perf_stat.hold_has_read_latch = 1;
+      holder->perf_stat.hold_has_write_latch = 0;
+      holder->perf_stat.dirtied_by_holder = 0;
+      holder->perf_stat.dirty_before_hold = buf_is_dirty;
+    }
+#endif /* SERVER_MODE */
+
+  return NO_ERROR;
+}
+
+#if defined (SERVER_MODE)
+/*
+ * pgbuf_fix_optimistic () - read fix a page that is already read latched by others, without hash or bcb mutex
+ *   return: fixed bcb, or NULL if the page must be fixed the regular way
+ *   hash_anchor(in): hash anchor of vpid
+ *   vpid(in): page identifier
+ *
+ * Note: bcb's are never freed, so hash chain can be walked without its mutex; a bcb that is moved to another chain
+ *       meanwhile is caught by the checks of pgbuf_latch_try_fix_shared. see page_buffer_latch.hpp for the protocol.
+ */
+static PGBUF_BCB *
+pgbuf_fix_optimistic (THREAD_ENTRY * thread_p, PGBUF_BUFFER_HASH * hash_anchor, const VPID * vpid)
+{
+  PGBUF_BCB *bufptr;
+  int chain_length = 0;
+
+  for (bufptr = hash_anchor->hash_next; bufptr != NULL; bufptr = bufptr->hash_next)
+    {
+      if (VPID_EQ (&bufptr->vpid, vpid))
+	{
+	  break;
+	}
+      if (++chain_length > pgbuf_Pool.num_buffers)
+	{
+	  /* chain is changing under us */
+	  return NULL;
+	}
+    }
+  if (bufptr == NULL)
+    {
+      return NULL;
+    }
+
+  switch (pgbuf_latch_try_fix_shared (bufptr, vpid))
+    {
+    case PGBUF_LATCH_OPTIMISTIC_FIXED:
+      break;
+
+    case PGBUF_LATCH_OPTIMISTIC_RELEASE:
+      /* we hold the last fix of a bcb we do not want */
+      PGBUF_BCB_LOCK (bufptr);
+      (void) pgbuf_unlatch_bcb_upon_unfix (thread_p, bufptr, NO_ERROR);
+      /* fall through */
+
+    case PGBUF_LATCH_OPTIMISTIC_MISS:
+    default:
+      return NULL;
+    }
+
+  /* no bcb mutex is needed here: the fix counter is only incremented atomically, on the regular path too, and it is
+   * reset only when the bcb is victimized or invalidated, which requires it to have no fixers. we hold a fix now. */
+  pgbuf_bcb_register_fix (bufptr);
+  if (pgbuf_register_read_holder (thread_p, bufptr, pgbuf_bcb_is_dirty (bufptr)) != NO_ERROR)
+    {
+      if (!pgbuf_latch_try_unfix_shared (bufptr))
+	{
+	  PGBUF_BCB_LOCK (bufptr);
+	  (void) pgbuf_unlatch_bcb_upon_unfix (thread_p, bufptr, NO_ERROR);
+	}
+      return NULL;
+    }
+
+  perfmon_inc_stat (thread_p, PSTAT_PB_NUM_OPTIMISTIC_FIXES);
+  return bufptr;
+}
+#endif /* SERVER_MODE */
+
 /*
  * pgbuf_latch_bcb_upon_fix () -
  *   return: NO_ERROR, or ER_code
@@ -5603,59 +5838,12 @@ pgbuf_latch_bcb_upon_fix (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr, PGBUF_LAT
 	  /* grant the request */
 
 	  /* increment the fix count */
-	  bufptr->fcnt++;
+	  ATOMIC_INC_32 (&bufptr->fcnt, 1);
 	  assert (0 < bufptr->fcnt);
 
 	  PGBUF_BCB_UNLOCK (bufptr);
 
-	  /* allocate a BCB holder entry */
-
-	  holder = pgbuf_find_thrd_holder (thread_p, bufptr);
-	  if (holder != NULL)
-	    {
-	      /* the caller is the holder of the buffer page */
-	      holder->fix_count++;
-	      /* holder->dirty_before_holder not changed */
-	      if (request_mode == PGBUF_LATCH_WRITE)
-		{
-		  holder->perf_stat.hold_has_write_latch = 1;
-		}
-	      else
-		{
-		  holder->perf_stat.hold_has_read_latch = 1;
-		}
-	    }
-#if defined(SERVER_MODE)
-	  else
-	    {
-	      /* the caller is not the holder of the buffer page */
-	      /* allocate a BCB holder entry */
-	      holder = pgbuf_allocate_thrd_holder_entry (thread_p);
-	      if (holder == NULL)
-		{
-		  /* This situation must not be occurred. */
-		  assert (false);
-		  return ER_FAILED;
-		}
-
-	      holder->fix_count = 1;
-	      holder->bufptr = bufptr;
-	      if (request_mode == PGBUF_LATCH_WRITE)
-		{
-		  holder->perf_stat.hold_has_write_latch = 1;
-		  holder->perf_stat.hold_has_read_latch = 0;
-		}
-	      else
-		{
-		  holder->perf_stat.hold_has_read_latch = 1;
-		  holder->perf_stat.hold_has_write_latch = 0;
-		}
-	      holder->perf_stat.dirtied_by_holder = 0;
-	      holder->perf_stat.dirty_before_hold = buf_is_dirty;
-	    }
-#endif /* SERVER_MODE */
-
-	  return NO_ERROR;
+	  return pgbuf_register_read_holder (thread_p, bufptr, buf_is_dirty);
 	}
 
 #if defined (SA_MODE)
@@ -5673,7 +5861,7 @@ pgbuf_latch_bcb_upon_fix (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr, PGBUF_LAT
 	}
 
       /* in case that the caller is the holder */
-      bufptr->fcnt++;
+      ATOMIC_INC_32 (&bufptr->fcnt, 1);
       assert (0 < bufptr->fcnt);
 
       PGBUF_BCB_UNLOCK (bufptr);
@@ -5726,9 +5914,10 @@ pgbuf_latch_bcb_upon_fix (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr, PGBUF_LAT
 
   if (bufptr->latch_mode == PGBUF_LATCH_WRITE)
     {				/* only the holder */
-      assert (bufptr->fcnt == holder->fix_count);
+      /* optimistic readers that are backing off may still be counted */
+      assert (bufptr->fcnt >= holder->fix_count);
 
-      bufptr->fcnt++;
+      ATOMIC_INC_32 (&bufptr->fcnt, 1);
       assert (0 < bufptr->fcnt);
 
       PGBUF_BCB_UNLOCK (bufptr);
@@ -5756,10 +5945,11 @@ pgbuf_latch_bcb_upon_fix (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr, PGBUF_LAT
 
       assert (request_mode == PGBUF_LATCH_WRITE);
 
-      if (bufptr->fcnt == holder->fix_count)
+    try_exclusive:
+      if (pgbuf_latch_try_exclusive (bufptr, holder->fix_count))
 	{
-	  bufptr->latch_mode = request_mode;	/* PGBUF_LATCH_WRITE */
-	  bufptr->fcnt++;
+	  /* bufptr->latch_mode is PGBUF_LATCH_WRITE */
+	  ATOMIC_INC_32 (&bufptr->fcnt, 1);
 	  assert (0 < bufptr->fcnt);
 
 	  PGBUF_BCB_UNLOCK (bufptr);
@@ -5780,8 +5970,6 @@ pgbuf_latch_bcb_upon_fix (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr, PGBUF_LAT
 	  return NO_ERROR;
 	}
 
-      assert (bufptr->fcnt > holder->fix_count);
-
       if (condition == PGBUF_CONDITIONAL_LATCH)
 	{
 	  goto do_block;	/* will return immediately */
@@ -5789,8 +5977,12 @@ pgbuf_latch_bcb_upon_fix (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr, PGBUF_LAT
 
       assert (request_fcnt == 1);
 
+      if (!pgbuf_latch_release_holder (bufptr, holder->fix_count))
+	{
+	  /* other fixes were optimistic and are gone */
+	  goto try_exclusive;
+	}
       request_fcnt += holder->fix_count;
-      bufptr->fcnt -= holder->fix_count;
       holder->fix_count = 0;
 
       INIT_HOLDER_STAT (&holder->perf_stat);
@@ -5933,8 +6125,7 @@ pgbuf_unlatch_bcb_upon_unfix (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr, int h
   CAST_BFPTR_TO_PGPTR (pgptr, bufptr);
 
   /* decrement the fix count */
-  bufptr->fcnt--;
-  if (bufptr->fcnt < 0)
+  if (ATOMIC_INC_32 (&bufptr->fcnt, -1) < 0)
     {
       /* This situation must not be occurred. */
       assert (false);
@@ -6445,7 +6636,7 @@ pgbuf_timed_sleep_error_handling (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr, T
 	  thread_lock_entry (curr_thrd_entry);
 	  if (curr_thrd_entry->request_latch_mode == PGBUF_LATCH_READ)
 	    {
-	      bufptr->fcnt += curr_thrd_entry->request_fix_count;
+	      ATOMIC_INC_32 (&bufptr->fcnt, curr_thrd_entry->request_fix_count);
 
 	      /* do not handle BCB holder entry, at here. refer pgbuf_latch_bcb_upon_fix () */
 
@@ -6715,7 +6906,7 @@ pgbuf_wakeup_reader_writer (THREAD_ENTRY * thread_p, PGBUF_BCB * bufptr)
 	    {
 	      /* grant the request */
 	      bufptr->latch_mode = (PGBUF_LATCH_MODE) thrd_entry->request_latch_mode;
-	      bufptr->fcnt += thrd_entry->request_fix_count;
+	      ATOMIC_INC_32 (&bufptr->fcnt, thrd_entry->request_fix_count);
 
 	      /* do not handle BCB holder entry, at here. refer pgbuf_latch_bcb_upon_fix () */
 
@@ -7554,7 +7745,8 @@ pgbuf_claim_bcb_for_fix (THREAD_ENTRY * thread_p, const VPID * vpid, PAGE_FETCH_
   bufptr->vpid = *vpid;
   assert (!pgbuf_bcb_avoid_victim (bufptr));
   bufptr->latch_mode = PGBUF_NO_LATCH;
-  pgbuf_bcb_update_flags (thread_p, bufptr, 0, PGBUF_BCB_ASYNC_FLUSH_REQ);	/* todo: why this?? */
+  /* todo: why this?? */
+  pgbuf_bcb_update_flags (thread_p, bufptr, 0, PGBUF_BCB_ASYNC_FLUSH_REQ | PGBUF_BCB_READ_AHEAD_FLAG);
   pgbuf_bcb_check_and_reset_fix_and_avoid_dealloc (bufptr, ARG_FILE_LINE);
   LSA_SET_NULL (&bufptr->oldest_unflush_lsa);
 
@@ -13803,7 +13995,8 @@ pgbuf_dealloc_page (THREAD_ENTRY * thread_p, PAGE_PTR page_dealloc)
    *       victimized. */
 
   CAST_PGPTR_TO_BFPTR (bcb, page_dealloc);
-  assert (bcb->fcnt == 1);
+  /* optimistic readers that are backing off may still be counted */
+  assert (bcb->fcnt >= 1);
 
   ptype = (PAGE_TYPE) (bcb->iopage_buffer->iopage.prv.ptype);
   assert (ptype != PAGE_UNKNOWN);
@@ -14707,6 +14900,18 @@ pgbuf_bcb_is_async_flush_request (const PGBUF_BCB * bcb)
   return (bcb->flags & PGBUF_BCB_ASYNC_FLUSH_REQ) != 0;
 }
 
+/*
+ * pgbuf_bcb_is_read_ahead () - was bcb loaded by read-ahead and not fixed since?
+ *
+ * return   : true/false
+ * bcb (in) : bcb
+ */
+STATIC_INLINE bool
+pgbuf_bcb_is_read_ahead (const PGBUF_BCB * bcb)
+{
+  return (bcb->flags & PGBUF_BCB_READ_AHEAD_FLAG) != 0;
+}
+
 /*
  * pgbuf_bcb_should_be_moved_to_bottom_lru () - is bcb supposed to be moved to the bottom of lru?
  *
@@ -15502,76 +15707,723 @@ pgbuf_find_current_wait_msecs (THREAD_ENTRY * thread_p)
 }
 
 /*
- * pgbuf_get_page_flush_interval () - setup page flush daemon period based on system parameter
+ * pgbuf_read_ahead () - tell the page buffer that a page is going to be needed by a sequential scan.
+ *
+ * return                  : void
+ * thread_p (in)           : thread entry
+ * vpid (in)               : page the scan needs next
+ * read_ahead_vpid (in/out): caller's read-ahead cursor; first page after the last read-ahead request. initialize it
+ *                           with VPID_SET_NULL before the scan starts.
+ *
+ * Note: if the page is not covered by a previous request of the same scan, a read of the next
+ *       data_buffer_read_ahead_pages pages (up to the end of the page's sector) is queued for the read-ahead daemon.
+ *       when the scan has consumed half of the window, the window is extended. the request is only a hint; it is
+ *       dropped if the queue is full or if there are no free buffers.
  */
 void
-pgbuf_get_page_flush_interval (bool & is_timed_wait, cubthread::delta_time & period)
+pgbuf_read_ahead (THREAD_ENTRY * thread_p, const VPID * vpid, VPID * read_ahead_vpid)
 {
-  int page_flush_interval_msecs = prm_get_integer_value (PRM_ID_PAGE_BG_FLUSH_INTERVAL_MSECS);
+#if defined (SERVER_MODE)
+  PGBUF_READ_AHEAD_REQUEST *request;
+  VPID start_vpid;
+  int window, sector_end, npages;
 
-  assert (page_flush_interval_msecs >= 0);
+  window = prm_get_integer_value (PRM_ID_PB_READ_AHEAD_PAGES);
+  if (window <= 0 || pgbuf_Read_ahead_daemon == NULL || VPID_ISNULL (vpid) || vpid->volid == NULL_VOLID)
+    {
+      return;
+    }
+  window = MIN (window, PGBUF_READ_AHEAD_MAX_PAGES);
 
-  if (page_flush_interval_msecs > 0)
+  sector_end = (vpid->pageid / DISK_SECTOR_NPAGES + 1) * DISK_SECTOR_NPAGES;
+
+  if (read_ahead_vpid->volid == vpid->volid && read_ahead_vpid->pageid > vpid->pageid
+      && read_ahead_vpid->pageid <= sector_end)
     {
-      // if page_flush_interval_msecs > 0 (zero) then loop for fixed interval
-      is_timed_wait = true;
-      period = std::chrono::milliseconds (page_flush_interval_msecs);
+      /* already requested */
+      if (read_ahead_vpid->pageid >= sector_end || read_ahead_vpid->pageid - vpid->pageid > window / 2)
+	{
+	  return;
+	}
+      /* extend the window */
+      start_vpid = *read_ahead_vpid;
     }
   else
     {
-      // infinite wait
-      is_timed_wait = false;
+      start_vpid = *vpid;
     }
-}
 
-// *INDENT-OFF*
-#if defined (SERVER_MODE)
-static void
-pgbuf_page_maintenance_execute (cubthread::entry & thread_ref)
-{
-  if (!BO_IS_SERVER_RESTARTED ())
+  npages = MIN (window, sector_end - start_vpid.pageid);
+  assert (npages > 0);
+
+  pthread_mutex_lock (&pgbuf_Read_ahead.mutex);
+  if (pgbuf_Read_ahead.count >= PGBUF_READ_AHEAD_QUEUE_SIZE)
     {
-      // wait for boot to finish
+      /* the daemon cannot keep up; drop the request */
+      pthread_mutex_unlock (&pgbuf_Read_ahead.mutex);
       return;
     }
+  request =
+    &pgbuf_Read_ahead.requests[(pgbuf_Read_ahead.head + pgbuf_Read_ahead.count) % PGBUF_READ_AHEAD_QUEUE_SIZE];
+  request->vpid = start_vpid;
+  request->npages = npages;
+  pgbuf_Read_ahead.count++;
+  pthread_mutex_unlock (&pgbuf_Read_ahead.mutex);
 
-  /* page buffer maintenance thread adjust quota's based on thread activity. */
-  pgbuf_adjust_quotas (&thread_ref);
+  read_ahead_vpid->volid = start_vpid.volid;
+  read_ahead_vpid->pageid = start_vpid.pageid + npages;
 
-  /* search lists and assign victims directly */
-  pgbuf_direct_victims_maintenance (&thread_ref);
-}
+  pgbuf_Read_ahead_daemon->wakeup ();
 #endif /* SERVER_MODE */
+}
 
 #if defined (SERVER_MODE)
-// class pgbuf_page_flush_daemon_task
-//
-//  description:
-//    page flush daemon task
-//
-class pgbuf_page_flush_daemon_task : public cubthread::entry_task
+/*
+ * pgbuf_read_ahead_dequeue () - get the oldest read-ahead request
+ *
+ * return        : false if there are no requests
+ * request (out) : read-ahead request
+ */
+static bool
+pgbuf_read_ahead_dequeue (PGBUF_READ_AHEAD_REQUEST * request)
 {
-  private:
-    PERF_UTIME_TRACKER m_perf_track;
+  bool found = false;
 
-  public:
-    pgbuf_page_flush_daemon_task ()
+  pthread_mutex_lock (&pgbuf_Read_ahead.mutex);
+  if (pgbuf_Read_ahead.count > 0)
     {
-      PERF_UTIME_TRACKER_START (NULL, &m_perf_track);
+      *request = pgbuf_Read_ahead.requests[pgbuf_Read_ahead.head];
+      pgbuf_Read_ahead.head = (pgbuf_Read_ahead.head + 1) % PGBUF_READ_AHEAD_QUEUE_SIZE;
+      pgbuf_Read_ahead.count--;
+      found = true;
     }
+  pthread_mutex_unlock (&pgbuf_Read_ahead.mutex);
 
-    void execute (cubthread::entry & thread_ref) override
+  return found;
+}
+
+/*
+ * pgbuf_read_ahead_pages () - load into buffer the pages of a read-ahead request that are not there yet
+ *
+ * return          : void
+ * thread_p (in)   : thread entry
+ * first_vpid (in) : first page of request
+ * npages (in)     : number of pages of request
+ *
+ * Note: the pages that are missing from buffer are grouped in runs of consecutive pages; every run is read from disk
+ *       with a single I/O.
+ */
+static void
+pgbuf_read_ahead_pages (THREAD_ENTRY * thread_p, const VPID * first_vpid, int npages)
+{
+  PGBUF_BCB *bcbs[PGBUF_READ_AHEAD_MAX_PAGES];
+  VPID vpid;
+  int i, nrun = 0;
+  bool stop = false;
+
+  assert (npages <= PGBUF_READ_AHEAD_MAX_PAGES);
+
+  vpid.volid = first_vpid->volid;
+  for (i = 0; i <= npages; i++)
     {
-      if (!BO_IS_SERVER_RESTARTED ())
+      if (i < npages && !stop)
 	{
-	  // wait for boot to finish
-	  return;
+	  vpid.pageid = first_vpid->pageid + i;
+	  if (pgbuf_read_ahead_claim_bcb (thread_p, &vpid, true, &pgbuf_Read_ahead.locks[nrun], &bcbs[nrun], &stop))
+	    {
+	      /* extend current run */
+	      nrun++;
+	      continue;
+	    }
 	}
 
-      // did not timeout, someone requested flush... run at least once
-      bool force_one_run = pgbuf_Page_flush_daemon->was_woken_up ();
-      bool stop_iteration = false;
-
+      /* current run ends here */
+      if (nrun > 0)
+	{
+	  pgbuf_read_ahead_load_run (thread_p, bcbs, nrun, NULL);
+	  nrun = 0;
+	}
+      if (stop)
+	{
+	  break;
+	}
+    }
+}
+
+/*
+ * pgbuf_read_ahead_claim_bcb () - claim a bcb to read a page into, if the page is not already in buffer
+ *
+ * return            : true if a bcb was claimed
+ * thread_p (in)     : thread entry
+ * vpid (in)         : page identifier
+ * can_victimize (in): false to use only bcb's of the invalid list
+ * buffer_lock (in)  : buffer lock record to lock the page with
+ * bufptr_out (out)  : claimed bcb, locked
+ * stop (out)        : output true when read-ahead should give up the request
+ *
+ * Note: like pgbuf_claim_bcb_for_fix, the page is buffer locked until it is read and connected to hash chain, so that
+ *       others wait for it instead of reading it again. unlike pgbuf_claim_bcb_for_fix, this never waits: not for
+ *       other threads reading the page and not for victims when there are no free bcb's.
+ */
+static bool
+pgbuf_read_ahead_claim_bcb (THREAD_ENTRY * thread_p, const VPID * vpid, bool can_victimize,
+			    PGBUF_BUFFER_LOCK * buffer_lock, PGBUF_BCB ** bufptr_out, bool * stop)
+{
+  PGBUF_BUFFER_HASH *hash_anchor;
+  PGBUF_BUFFER_LOCK *cur_buffer_lock;
+  PGBUF_BCB *bufptr;
+
+  *bufptr_out = NULL;
+
+  hash_anchor = &pgbuf_Pool.buf_hash_table[PGBUF_HASH_VALUE (vpid)];
+  bufptr = pgbuf_search_hash_chain (thread_p, hash_anchor, vpid);
+  if (bufptr != NULL)
+    {
+      /* already in buffer */
+      PGBUF_BCB_UNLOCK (bufptr);
+      return false;
+    }
+  if (er_errid () == ER_CSS_PTHREAD_MUTEX_TRYLOCK)
+    {
+      /* hash mutex is not held */
+      er_clear ();
+      *stop = true;
+      return false;
+    }
+
+  /* the caller is holding hash_anchor->hash_mutex. is someone else reading the page? */
+  for (cur_buffer_lock = hash_anchor->lock_next; cur_buffer_lock != NULL; cur_buffer_lock = cur_buffer_lock->lock_next)
+    {
+      if (VPID_EQ (&cur_buffer_lock->vpid, vpid))
+	{
+	  pthread_mutex_unlock (&hash_anchor->hash_mutex);
+	  return false;
+	}
+    }
+
+  /* buffer lock the page */
+  buffer_lock->vpid = *vpid;
+  buffer_lock->next_wait_thrd = NULL;
+  buffer_lock->lock_next = hash_anchor->lock_next;
+  hash_anchor->lock_next = buffer_lock;
+  pthread_mutex_unlock (&hash_anchor->hash_mutex);
+
+  /* get a free bcb; do not wait for one */
+  bufptr = pgbuf_get_bcb_from_invalid_list (thread_p);
+  if (bufptr == NULL && can_victimize)
+    {
+      bufptr = pgbuf_get_victim (thread_p);
+      if (bufptr != NULL && pgbuf_victimize_bcb (thread_p, bufptr) != NO_ERROR)
+	{
+	  assert (false);
+	  bufptr = NULL;
+	}
+    }
+  if (bufptr == NULL)
+    {
+      (void) pgbuf_unlock_page (thread_p, hash_anchor, vpid, true);
+      er_clear ();
+      *stop = true;
+      return false;
+    }
+
+  /* initialize the BCB */
+  bufptr->vpid = *vpid;
+  assert (!pgbuf_bcb_avoid_victim (bufptr));
+  bufptr->latch_mode = PGBUF_NO_LATCH;
+  pgbuf_bcb_update_flags (thread_p, bufptr, 0, PGBUF_BCB_ASYNC_FLUSH_REQ | PGBUF_BCB_READ_AHEAD_FLAG);
+  pgbuf_bcb_check_and_reset_fix_and_avoid_dealloc (bufptr, ARG_FILE_LINE);
+  LSA_SET_NULL (&bufptr->oldest_unflush_lsa);
+
+  *bufptr_out = bufptr;
+  return true;
+}
+
+/*
+ * pgbuf_read_ahead_load_run () - read a run of consecutive pages and connect their bcb's to buffer
+ *
+ * return        : void
+ * thread_p (in) : thread entry
+ * bcbs (in)     : claimed bcb's of consecutive pages
+ * npages (in)   : number of pages
+ * is_hot (in)   : for warm-up, which pages were hot when saved; NULL for read-ahead
+ */
+static void
+pgbuf_read_ahead_load_run (THREAD_ENTRY * thread_p, PGBUF_BCB ** bcbs, int npages, const bool * is_hot)
+{
+  PGBUF_BUFFER_HASH *hash_anchor;
+  PGBUF_BCB *bufptr;
+  FILEIO_PAGE *io_page;
+  PERF_UTIME_TRACKER time_track = PERF_UTIME_TRACKER_INITIALIZER;
+  bool from_dwb[PGBUF_READ_AHEAD_MAX_PAGES];
+  int read_error[PGBUF_READ_AHEAD_MAX_PAGES];
+  FILEIO_BATCH batch;
+  bool success, read_ok, is_page_read;
+  int vol_fd;
+  int i;
+
+  /* pages still in double write buffer were not written to volume yet. check them before reading the volume, like
+   * pgbuf_claim_bcb_for_fix does. */
+  for (i = 0; i < npages; i++)
+    {
+      from_dwb[i] = (dwb_read_page (thread_p, &bcbs[i]->vpid, &bcbs[i]->iopage_buffer->iopage, &success) == NO_ERROR
+		     && success);
+    }
+
+  vol_fd = fileio_get_volume_descriptor (bcbs[0]->vpid.volid);
+
+  PERF_UTIME_TRACKER_START (thread_p, &time_track);
+  fileio_batch_begin (thread_p, &batch, prm_get_integer_value (PRM_ID_IO_BACKEND),
+		      prm_get_integer_value (PRM_ID_IO_QUEUE_DEPTH));
+  if (fileio_batch_is_async (&batch))
+    {
+      /* submit the reads of all pages together, straight into their bcb's */
+      for (i = 0; i < npages; i++)
+	{
+	  read_error[i] = NO_ERROR;
+	  if (!from_dwb[i])
+	    {
+	      (void) fileio_batch_add_read (&batch, vol_fd, &bcbs[i]->iopage_buffer->iopage, bcbs[i]->vpid.pageid,
+					    IO_PAGESIZE, &read_error[i]);
+	    }
+	}
+      read_ok = (fileio_batch_end (&batch) == NO_ERROR);
+    }
+  else
+    {
+      (void) fileio_batch_end (&batch);
+      read_ok = (fileio_read_pages (thread_p, vol_fd, pgbuf_Read_ahead.io_pages, bcbs[0]->vpid.pageid, npages,
+				    IO_PAGESIZE) != NULL);
+      for (i = 0; i < npages; i++)
+	{
+	  read_error[i] = read_ok ? NO_ERROR : ER_FAILED;
+	  if (!from_dwb[i] && read_ok)
+	    {
+	      memcpy (&bcbs[i]->iopage_buffer->iopage, pgbuf_Read_ahead.io_pages + i * IO_PAGESIZE, IO_PAGESIZE);
+	    }
+	}
+    }
+  PERF_UTIME_TRACKER_TIME (thread_p, &time_track, is_hot == NULL ? PSTAT_PB_READ_AHEAD_IO : PSTAT_PB_WARMUP_IO);
+  if (!read_ok)
+    {
+      er_clear ();
+    }
+
+  for (i = 0; i < npages; i++)
+    {
+      bufptr = bcbs[i];
+      hash_anchor = &pgbuf_Pool.buf_hash_table[PGBUF_HASH_VALUE (&bufptr->vpid)];
+      io_page = &bufptr->iopage_buffer->iopage;
+      is_page_read = from_dwb[i] || read_error[i] == NO_ERROR;
+
+      /* keep only pages that are in use. unallocated and deallocated pages of the sector and temporary pages that
+       * were never written are left for regular fix to handle. */
+      if (!is_page_read || io_page->prv.volid != bufptr->vpid.volid
+	  || io_page->prv.pageid != bufptr->vpid.pageid || io_page->prv.ptype == PAGE_UNKNOWN
+	  || (pgbuf_is_temporary_volume (bufptr->vpid.volid) && !pgbuf_is_temp_lsa (io_page->prv.lsa)))
+	{
+	  VPID vpid = bufptr->vpid;
+
+	  /* bufptr->mutex will be released in following function. */
+	  pgbuf_put_bcb_into_invalid_list (thread_p, bufptr);
+	  (void) pgbuf_unlock_page (thread_p, hash_anchor, &vpid, true);
+	  continue;
+	}
+
+      if (is_hot == NULL)
+	{
+	  pgbuf_bcb_update_flags (thread_p, bufptr, PGBUF_BCB_READ_AHEAD_FLAG, 0);
+	}
+
+      /* connect to hash chain and wake up the threads waiting for the page. the hash mutex is released in
+       * pgbuf_unlock_page (). */
+      pgbuf_insert_into_hash_chain (thread_p, hash_anchor, bufptr);
+      (void) pgbuf_unlock_page (thread_p, hash_anchor, &bufptr->vpid, false);
+
+      /* the page has not been used yet; it does not belong to any thread's private list. pages that were hot before
+       * restart go to top. */
+      if (is_hot != NULL && is_hot[i])
+	{
+	  pgbuf_lru_add_new_bcb_to_top (thread_p, bufptr, pgbuf_get_shared_lru_index_for_add ());
+	}
+      else
+	{
+	  pgbuf_lru_add_new_bcb_to_middle (thread_p, bufptr, pgbuf_get_shared_lru_index_for_add ());
+	}
+      PGBUF_BCB_UNLOCK (bufptr);
+
+      perfmon_inc_stat (thread_p, is_hot == NULL ? PSTAT_PB_READ_AHEAD_NUM_PAGES : PSTAT_PB_WARMUP_NUM_PAGES);
+    }
+}
+
+/*
+ * pgbuf_warmup_compare_pages () - order warm-up pages: hot and lru 1 zone pages first, then lru 2 and lru 3 zone pages;
+ *				   by VPID within same priority
+ *
+ * return : negative, zero or positive
+ * a (in) : first page
+ * b (in) : second page
+ */
+static int
+pgbuf_warmup_compare_pages (const void *a, const void *b)
+{
+  const PGBUF_WARMUP_PAGE *page_a = (const PGBUF_WARMUP_PAGE *) a;
+  const PGBUF_WARMUP_PAGE *page_b = (const PGBUF_WARMUP_PAGE *) b;
+  int priority_a = page_a->is_hot ? 1 : page_a->lru_zone;
+  int priority_b = page_b->is_hot ? 1 : page_b->lru_zone;
+
+  if (priority_a != priority_b)
+    {
+      return priority_a - priority_b;
+    }
+  if (page_a->vpid.volid != page_b->vpid.volid)
+    {
+      return page_a->vpid.volid - page_b->vpid.volid;
+    }
+  return (page_a->vpid.pageid > page_b->vpid.pageid) - (page_a->vpid.pageid < page_b->vpid.pageid);
+}
+
+/*
+ * pgbuf_warmup_read_list () - read the pages saved before restart; they are loaded by the read-ahead daemon
+ *
+ * return : void
+ *
+ * Note: warm-up is best effort; a missing or bad file only means the buffer starts cold.
+ */
+static void
+pgbuf_warmup_read_list (void)
+{
+  char warmup_name[PATH_MAX];
+  PGBUF_WARMUP_HEADER header;
+  PGBUF_WARMUP_PAGE *pages;
+  FILE *fp;
+
+  pgbuf_Warmup.pages = NULL;
+  pgbuf_Warmup.npages = 0;
+  pgbuf_Warmup.next_page = 0;
+  pgbuf_Warmup.last_load_msec = log_get_clock_msec ();
+  pgbuf_Warmup.last_save_msec = pgbuf_Warmup.last_load_msec;
+
+  if (!prm_get_bool_value (PRM_ID_PB_WARMUP))
+    {
+      return;
+    }
+
+  fileio_make_warmup_name (warmup_name, log_Path, log_Prefix);
+  fp = fopen (warmup_name, "rb");
+  if (fp == NULL)
+    {
+      return;
+    }
+
+  if (fread (&header, sizeof (header), 1, fp) != 1 || header.magic != PGBUF_WARMUP_MAGIC
+      || header.io_pagesize != IO_PAGESIZE || header.npages <= 0)
+    {
+      fclose (fp);
+      return;
+    }
+
+  pages = (PGBUF_WARMUP_PAGE *) malloc ((size_t) header.npages * sizeof (PGBUF_WARMUP_PAGE));
+  if (pages == NULL)
+    {
+      fclose (fp);
+      return;
+    }
+  if (fread (pages, sizeof (PGBUF_WARMUP_PAGE), (size_t) header.npages, fp) != (size_t) header.npages)
+    {
+      free (pages);
+      fclose (fp);
+      return;
+    }
+  fclose (fp);
+
+  qsort (pages, (size_t) header.npages, sizeof (PGBUF_WARMUP_PAGE), pgbuf_warmup_compare_pages);
+
+  pgbuf_Warmup.pages = pages;
+  pgbuf_Warmup.npages = header.npages;
+
+  er_log_debug (ARG_FILE_LINE, "pgbuf_warmup_read_list: %d pages to load from %s\n", header.npages, warmup_name);
+}
+
+/*
+ * pgbuf_warmup_load_pages () - load the next saved pages into buffer, as many as data_buffer_warmup_rate allows since
+ *				the last load
+ *
+ * return        : void
+ * thread_p (in) : thread entry
+ *
+ * Note: only free bcb's are used; the warm-up ends when there are none left. runs of consecutive pages are read with
+ *       a single I/O.
+ */
+static void
+pgbuf_warmup_load_pages (THREAD_ENTRY * thread_p)
+{
+  PGBUF_BCB *bcbs[PGBUF_READ_AHEAD_MAX_PAGES];
+  bool is_hot[PGBUF_READ_AHEAD_MAX_PAGES];
+  PGBUF_WARMUP_PAGE *page;
+  INT64 now, rate, budget;
+  int nrun = 0;
+  bool stop = false;
+
+  if (pgbuf_Warmup.next_page >= pgbuf_Warmup.npages)
+    {
+      return;
+    }
+
+  if (pgbuf_Pool.buf_invalid_list.invalid_cnt == 0)
+    {
+      /* the buffer is full; the rest is not needed */
+      pgbuf_Warmup.next_page = pgbuf_Warmup.npages;
+      return;
+    }
+
+  now = log_get_clock_msec ();
+  rate = prm_get_integer_value (PRM_ID_PB_WARMUP_RATE);
+  budget = MIN ((now - pgbuf_Warmup.last_load_msec) * rate / 1000, rate);
+  if (budget <= 0)
+    {
+      return;
+    }
+  pgbuf_Warmup.last_load_msec = now;
+
+  while (pgbuf_Warmup.next_page < pgbuf_Warmup.npages && budget > 0)
+    {
+      page = &pgbuf_Warmup.pages[pgbuf_Warmup.next_page];
+
+      if (nrun > 0 && (nrun == PGBUF_READ_AHEAD_MAX_PAGES || page->vpid.volid != bcbs[nrun - 1]->vpid.volid
+		       || page->vpid.pageid != bcbs[nrun - 1]->vpid.pageid + 1))
+	{
+	  /* current run ends here */
+	  pgbuf_read_ahead_load_run (thread_p, bcbs, nrun, is_hot);
+	  budget -= nrun;
+	  nrun = 0;
+	  continue;
+	}
+
+      if (fileio_get_volume_descriptor (page->vpid.volid) == NULL_VOLDES)
+	{
+	  /* volume was removed */
+	  pgbuf_Warmup.next_page++;
+	  continue;
+	}
+
+      if (pgbuf_read_ahead_claim_bcb (thread_p, &page->vpid, false, &pgbuf_Read_ahead.locks[nrun], &bcbs[nrun], &stop))
+	{
+	  is_hot[nrun] = page->is_hot || page->lru_zone == 1;
+	  nrun++;
+	}
+      else if (stop)
+	{
+	  /* try the page again next time */
+	  break;
+	}
+      pgbuf_Warmup.next_page++;
+    }
+
+  if (nrun > 0)
+    {
+      pgbuf_read_ahead_load_run (thread_p, bcbs, nrun, is_hot);
+    }
+
+  if (pgbuf_Warmup.next_page >= pgbuf_Warmup.npages)
+    {
+      er_log_debug (ARG_FILE_LINE, "pgbuf_warmup_load_pages: warm-up of page buffer is complete\n");
+      free_and_init (pgbuf_Warmup.pages);
+    }
+}
+
+/*
+ * pgbuf_save_warmup_list () - save the pages of the lru lists, to load them back after restart
+ *
+ * return        : void
+ * thread_p (in) : thread entry
+ *
+ * Note: the list is written to a temporary file first and renamed, so a crash never leaves a partial list.
+ */
+void
+pgbuf_save_warmup_list (THREAD_ENTRY * thread_p)
+{
+  char warmup_name[PATH_MAX], tmp_name[PATH_MAX];
+  PGBUF_WARMUP_HEADER header;
+  PGBUF_WARMUP_PAGE *pages;
+  PGBUF_BCB *bufptr;
+  PGBUF_ZONE zone;
+  FILE *fp;
+  int i, npages = 0;
+  bool is_written;
+
+  if (!prm_get_bool_value (PRM_ID_PB_WARMUP))
+    {
+      return;
+    }
+
+  pages = (PGBUF_WARMUP_PAGE *) malloc ((size_t) pgbuf_Pool.num_buffers * sizeof (PGBUF_WARMUP_PAGE));
+  if (pages == NULL)
+    {
+      return;
+    }
+
+  for (i = 0; i < pgbuf_Pool.num_buffers; i++)
+    {
+      bufptr = PGBUF_FIND_BCB_PTR (i);
+      PGBUF_BCB_LOCK (bufptr);
+      zone = pgbuf_bcb_get_zone (bufptr);
+      if ((zone == PGBUF_LRU_1_ZONE || zone == PGBUF_LRU_2_ZONE || zone == PGBUF_LRU_3_ZONE)
+	  && !VPID_ISNULL (&bufptr->vpid) && !pgbuf_is_temporary_volume (bufptr->vpid.volid))
+	{
+	  pages[npages].vpid = bufptr->vpid;
+	  pages[npages].lru_zone = zone == PGBUF_LRU_1_ZONE ? 1 : (zone == PGBUF_LRU_2_ZONE ? 2 : 3);
+	  pages[npages].is_hot = pgbuf_bcb_is_hot (bufptr) ? 1 : 0;
+	  npages++;
+	}
+      PGBUF_BCB_UNLOCK (bufptr);
+    }
+
+  fileio_make_warmup_name (warmup_name, log_Path, log_Prefix);
+  snprintf (tmp_name, sizeof (tmp_name), "%s.tmp", warmup_name);
+
+  header.magic = PGBUF_WARMUP_MAGIC;
+  header.io_pagesize = IO_PAGESIZE;
+  header.npages = npages;
+
+  is_written = false;
+  fp = fopen (tmp_name, "wb");
+  if (fp != NULL)
+    {
+      is_written = (fwrite (&header, sizeof (header), 1, fp) == 1
+		     && fwrite (pages, sizeof (PGBUF_WARMUP_PAGE), (size_t) npages, fp) == (size_t) npages);
+      is_written = (fclose (fp) == 0) && is_written;
+    }
+  free (pages);
+
+  if (!is_written || rename (tmp_name, warmup_name) != 0)
+    {
+      er_log_debug (ARG_FILE_LINE, "pgbuf_save_warmup_list: cannot save %s\n", warmup_name);
+      (void) remove (tmp_name);
+      return;
+    }
+
+  er_log_debug (ARG_FILE_LINE, "pgbuf_save_warmup_list: saved %d pages to %s\n", npages, warmup_name);
+}
+#endif /* SERVER_MODE */
+
+/*
+ * pgbuf_peek_warmup_stats () - number of saved pages not loaded yet by warm-up
+ *
+ * return :
+ * remaining_cnt (out) : remaining pages
+ */
+void
+pgbuf_peek_warmup_stats (UINT64 * remaining_cnt)
+{
+#if defined (SERVER_MODE)
+  *remaining_cnt = (pgbuf_Warmup.pages != NULL) ? (UINT64) (pgbuf_Warmup.npages - pgbuf_Warmup.next_page) : 0;
+#else /* !SERVER_MODE */
+  *remaining_cnt = 0;
+#endif /* !SERVER_MODE */
+}
+
+/*
+ * pgbuf_get_page_flush_interval () - setup page flush daemon period based on system parameter
+ */
+void
+pgbuf_get_page_flush_interval (bool & is_timed_wait, cubthread::delta_time & period)
+{
+  int page_flush_interval_msecs = prm_get_integer_value (PRM_ID_PAGE_BG_FLUSH_INTERVAL_MSECS);
+
+  assert (page_flush_interval_msecs >= 0);
+
+  if (page_flush_interval_msecs > 0)
+    {
+      // if page_flush_interval_msecs > 0 (zero) then loop for fixed interval
+      is_timed_wait = true;
+      period = std::chrono::milliseconds (page_flush_interval_msecs);
+    }
+  else
+    {
+      // infinite wait
+      is_timed_wait = false;
+    }
+}
+
+// *INDENT-OFF*
+#if defined (SERVER_MODE)
+static void
+pgbuf_page_maintenance_execute (cubthread::entry & thread_ref)
+{
+  if (!BO_IS_SERVER_RESTARTED ())
+    {
+      // wait for boot to finish
+      return;
+    }
+
+  /* page buffer maintenance thread adjust quota's based on thread activity. */
+  pgbuf_adjust_quotas (&thread_ref);
+
+  /* search lists and assign victims directly */
+  pgbuf_direct_victims_maintenance (&thread_ref);
+}
+#endif /* SERVER_MODE */
+
+#if defined (SERVER_MODE)
+static void
+pgbuf_read_ahead_execute (cubthread::entry & thread_ref)
+{
+  PGBUF_READ_AHEAD_REQUEST request;
+
+  if (!BO_IS_SERVER_RESTARTED ())
+    {
+      // wait for boot to finish
+      return;
+    }
+
+  while (pgbuf_read_ahead_dequeue (&request))
+    {
+      pgbuf_read_ahead_pages (&thread_ref, &request.vpid, request.npages);
+    }
+
+  /* read-ahead requests come first; warm-up uses what is left of the daemon time */
+  pgbuf_warmup_load_pages (&thread_ref);
+
+  if (prm_get_integer_value (PRM_ID_PB_WARMUP_SAVE_INTERVAL) > 0
+      && log_get_clock_msec () - pgbuf_Warmup.last_save_msec
+      >= (INT64) prm_get_integer_value (PRM_ID_PB_WARMUP_SAVE_INTERVAL) * 1000)
+    {
+      pgbuf_save_warmup_list (&thread_ref);
+      pgbuf_Warmup.last_save_msec = log_get_clock_msec ();
+    }
+}
+#endif /* SERVER_MODE */
+
+#if defined (SERVER_MODE)
+// class pgbuf_page_flush_daemon_task
+//
+//  description:
+//    page flush daemon task
+//
+class pgbuf_page_flush_daemon_task : public cubthread::entry_task
+{
+  private:
+    PERF_UTIME_TRACKER m_perf_track;
+
+  public:
+    pgbuf_page_flush_daemon_task ()
+    {
+      PERF_UTIME_TRACKER_START (NULL, &m_perf_track);
+    }
+
+    void execute (cubthread::entry & thread_ref) override
+    {
+      if (!BO_IS_SERVER_RESTARTED ())
+	{
+	  // wait for boot to finish
+	  return;
+	}
+
+      // did not timeout, someone requested flush... run at least once
+      bool force_one_run = pgbuf_Page_flush_daemon->was_woken_up ();
+      bool stop_iteration = false;
+
       /* flush pages as long as necessary */
       while (force_one_run || pgbuf_keep_victim_flush_thread_running ())
 	{
@@ -15697,6 +16549,36 @@ pgbuf_page_maintenance_daemon_init ()
 }
 #endif /* SERVER_MODE */
 
+#if defined (SERVER_MODE)
+/*
+ * pgbuf_read_ahead_daemon_init () - initialize read-ahead daemon thread
+ */
+static void
+pgbuf_read_ahead_daemon_init ()
+{
+  assert (pgbuf_Read_ahead_daemon == NULL);
+
+  pgbuf_Read_ahead.io_pages = (char *) malloc ((size_t) PGBUF_READ_AHEAD_MAX_PAGES * IO_PAGESIZE);
+  if (pgbuf_Read_ahead.io_pages == NULL)
+    {
+      /* read-ahead is disabled */
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      (size_t) PGBUF_READ_AHEAD_MAX_PAGES * IO_PAGESIZE);
+      return;
+    }
+  pthread_mutex_init (&pgbuf_Read_ahead.mutex, NULL);
+  pgbuf_Read_ahead.head = 0;
+  pgbuf_Read_ahead.count = 0;
+
+  pgbuf_warmup_read_list ();
+
+  cubthread::looper looper = cubthread::looper (std::chrono::milliseconds (100));
+  cubthread::entry_callable_task *daemon_task = new cubthread::entry_callable_task (pgbuf_read_ahead_execute);
+
+  pgbuf_Read_ahead_daemon = cubthread::get_manager ()->create_daemon (looper, daemon_task, "pgbuf_read_ahead");
+}
+#endif /* SERVER_MODE */
+
 #if defined (SERVER_MODE)
 /*
  * pgbuf_page_flush_daemon_init () - initialize page flush daemon thread
@@ -15770,6 +16652,7 @@ pgbuf_daemons_init ()
   pgbuf_page_flush_daemon_init ();
   pgbuf_page_post_flush_daemon_init ();
   pgbuf_flush_control_daemon_init ();
+  pgbuf_read_ahead_daemon_init ();
 }
 #endif /* SERVER_MODE */
 
@@ -15784,6 +16667,16 @@ pgbuf_daemons_destroy ()
   cubthread::get_manager ()->destroy_daemon (pgbuf_Page_flush_daemon);
   cubthread::get_manager ()->destroy_daemon (pgbuf_Page_post_flush_daemon);
   cubthread::get_manager ()->destroy_daemon (pgbuf_Flush_control_daemon);
+  if (pgbuf_Read_ahead_daemon != NULL)
+    {
+      cubthread::get_manager ()->destroy_daemon (pgbuf_Read_ahead_daemon);
+      pthread_mutex_destroy (&pgbuf_Read_ahead.mutex);
+      free_and_init (pgbuf_Read_ahead.io_pages);
+    }
+  if (pgbuf_Warmup.pages != NULL)
+    {
+      free_and_init (pgbuf_Warmup.pages);
+    }
 }
 #endif /* SERVER_MODE */
 
@@ -406,6 +406,7 @@ extern void pgbuf_peek_stats (UINT64 * fixed_cnt, UINT64 * dirty_cnt, UINT64 * l
 			      UINT64 * alloc_bcb_waiter_high, UINT64 * alloc_bcb_waiter_med,
 			      UINT64 * alloc_bcb_waiter_low, UINT64 * lfcq_big_prv_num, UINT64 * lfcq_prv_num,
 			      UINT64 * lfcq_shr_num);
+extern void pgbuf_peek_warmup_stats (UINT64 * remaining_cnt);
 extern void pgbuf_daemons_get_stats (UINT64 * stats_out);
 
 extern int pgbuf_flush_control_from_dirty_ratio (void);
@@ -446,11 +447,13 @@ extern bool pgbuf_assign_flushed_pages (THREAD_ENTRY * thread_p);
 #endif /* !SERVER_MODE */
 
 extern void pgbuf_notify_vacuum_follows (THREAD_ENTRY * thread_p, PAGE_PTR page);
+extern void pgbuf_read_ahead (THREAD_ENTRY * thread_p, const VPID * vpid, VPID * read_ahead_vpid);
 extern bool pgbuf_is_io_stressful (void);
 
 #if defined (SERVER_MODE)
 extern void pgbuf_daemons_init ();
 extern void pgbuf_daemons_destroy ();
+extern void pgbuf_save_warmup_list (THREAD_ENTRY * thread_p);
 #endif /* SERVER_MODE */
 
 #endif /* _PAGE_BUFFER_H_ */
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// page_buffer_latch - optimistic read fix of buffered pages, without BCB mutex
+//
+//  how it works:
+//    fix count of a BCB is only changed with atomic operations. without holding the BCB mutex, a thread may:
+//
+//    1. add a read fix to a page that is already read latched, has no blocked waiters and has fix count > 0. the fix
+//       count is never raised from 0 this way, so a BCB that nobody fixes (the only kind that can be latched from
+//       idle, victimized or invalidated) is never touched.
+//    2. remove a read fix, if it is not the last fix. the last fix is always removed under BCB mutex, which is when
+//       LRU lists are updated and blocked waiters are woken.
+//
+//    the page may be replaced or promoted to write latch between the checks of 1. and the increment. after the
+//    increment, the BCB can no longer be replaced, so vpid and latch mode are checked again. promotion of a read latch
+//    to write latch, done under mutex by the single holder, must use pgbuf_latch_try_exclusive, which stores the
+//    latch mode before it checks the fix count. together with the check after increment, at least one of the two
+//    threads sees the other and backs off.
+//
+//    a thread that backed off may keep its fix a little while on a write latched page, until it removes it. the
+//    fix count of a write latched page can therefore transiently exceed the fix count of its holder.
+//
+//  BCB template argument must have the members: vpid, volatile int fcnt, latch_mode and next_wait_thrd.
+//
+
+#ifndef _PAGE_BUFFER_LATCH_HPP_
+#define _PAGE_BUFFER_LATCH_HPP_
+
+#include "page_buffer.h"
+#include "porting.h"
+#include "storage_common.h"
+
+enum pgbuf_latch_optimistic_result
+{
+  PGBUF_LATCH_OPTIMISTIC_FIXED,		// page is fixed
+  PGBUF_LATCH_OPTIMISTIC_MISS,		// page cannot be fixed without mutex
+  PGBUF_LATCH_OPTIMISTIC_RELEASE	// a fix was added to a replaced or promoted BCB and it is the last fix; caller
+					// must remove it under BCB mutex
+};
+
+//
+// pgbuf_latch_try_unfix_shared () - remove a read fix, if it is not the last
+//
+// return : true if fix was removed, false if caller must remove it under BCB mutex
+// bcb (in) : BCB
+//
+template <typename Bcb>
+inline bool
+pgbuf_latch_try_unfix_shared (Bcb *bcb)
+{
+  int fcnt;
+
+  do
+    {
+      fcnt = bcb->fcnt;
+      if (fcnt <= 1)
+	{
+	  return false;
+	}
+    }
+  while (!ATOMIC_CAS_32 (&bcb->fcnt, fcnt, fcnt - 1));
+
+  return true;
+}
+
+//
+// pgbuf_latch_try_fix_shared () - add a read fix to a page that is already read latched
+//
+// return : PGBUF_LATCH_OPTIMISTIC_FIXED, PGBUF_LATCH_OPTIMISTIC_MISS or PGBUF_LATCH_OPTIMISTIC_RELEASE
+// bcb (in) : BCB found in hash chain
+// vpid (in) : page identifier
+//
+template <typename Bcb>
+inline pgbuf_latch_optimistic_result
+pgbuf_latch_try_fix_shared (Bcb *bcb, const VPID *vpid)
+{
+  int fcnt;
+
+  do
+    {
+      fcnt = bcb->fcnt;
+      if (fcnt <= 0 || bcb->latch_mode != PGBUF_LATCH_READ || bcb->next_wait_thrd != NULL
+	  || !VPID_EQ (&bcb->vpid, vpid))
+	{
+	  return PGBUF_LATCH_OPTIMISTIC_MISS;
+	}
+    }
+  while (!ATOMIC_CAS_32 (&bcb->fcnt, fcnt, fcnt + 1));
+
+  // the BCB cannot be replaced now; check again
+  if (bcb->latch_mode == PGBUF_LATCH_READ && VPID_EQ (&bcb->vpid, vpid))
+    {
+      return PGBUF_LATCH_OPTIMISTIC_FIXED;
+    }
+
+  // back off
+  return pgbuf_latch_try_unfix_shared (bcb) ? PGBUF_LATCH_OPTIMISTIC_MISS : PGBUF_LATCH_OPTIMISTIC_RELEASE;
+}
+
+//
+// pgbuf_latch_try_exclusive () - change read latch into write latch, if all fixes belong to holder
+//
+// return : true if latch was changed, false otherwise
+// bcb (in) : read latched BCB; caller holds BCB mutex
+// holder_fcnt (in) : fix count of holder
+//
+template <typename Bcb>
+inline bool
+pgbuf_latch_try_exclusive (Bcb *bcb, int holder_fcnt)
+{
+  if (bcb->fcnt != holder_fcnt)
+    {
+      return false;
+    }
+
+  bcb->latch_mode = PGBUF_LATCH_WRITE;
+  MEMORY_BARRIER ();
+  if (bcb->fcnt == holder_fcnt)
+    {
+      return true;
+    }
+
+  // an optimistic fix came in between; it will back off
+  bcb->latch_mode = PGBUF_LATCH_READ;
+  return false;
+}
+
+//
+// pgbuf_latch_release_holder () - remove the fixes of a read latch holder that will wait for write latch
+//
+// return : true if fixes were removed, false if holder is the only one left
+// bcb (in) : read latched BCB; caller holds BCB mutex
+// holder_fcnt (in) : fix count of holder
+//
+// note: others are left holding the page, so the last of them will wake up the holder.
+//
+template <typename Bcb>
+inline bool
+pgbuf_latch_release_holder (Bcb *bcb, int holder_fcnt)
+{
+  int fcnt;
+
+  do
+    {
+      fcnt = bcb->fcnt;
+      if (fcnt <= holder_fcnt)
+	{
+	  return false;
+	}
+    }
+  while (!ATOMIC_CAS_32 (&bcb->fcnt, fcnt, fcnt - holder_fcnt));
+
+  return true;
+}
+
+#endif // _PAGE_BUFFER_LATCH_HPP_
@@ -0,0 +1,397 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// parallel_sort - sort an array of record pointers on several threads
+//
+
+#include "parallel_sort.hpp"
+
+#include "dbtype_def.h"
+#include "error_code.h"
+
+#include <cassert>
+#include <cstdint>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+struct parallel_sort::node
+{
+  enum
+  {
+    IDLE,			// not handed over, or finished
+    QUEUED,			// handed over to a worker that has not claimed it yet
+    RUNNING			// claimed by a worker or by the sorting thread
+  } m_status;			// protected by shared_state::m_mutex
+
+  int m_height;			// leaves (height 0) sort, internal nodes merge
+  char **m_buff;
+  char **m_vector;
+  long m_vector_size;
+  char **m_result;
+  long m_result_size;		// negative on error
+};
+
+struct parallel_sort::shared_state
+{
+  std::mutex m_mutex;
+  std::condition_variable m_cond;	// notified when m_running drops to zero
+  int m_running;		// nodes claimed by workers and not finished yet
+  bool m_is_closed;		// sort is done; workers must not touch anything else
+  std::vector<node> m_nodes;
+
+  run_sort_func m_run_sort;
+  compare_func *m_compare;
+  void *m_compare_arg;
+  append_dup_func *m_append_dup;
+};
+
+parallel_sort::parallel_sort (int degree, long min_run_size, const run_sort_func &run_sort, compare_func *compare,
+			      void *compare_arg, append_dup_func *append_dup, const push_func &push)
+  : m_state (std::make_shared<shared_state> ())
+  , m_push (push)
+  , m_height_max (0)
+  , m_min_run_size (min_run_size)
+{
+  if (m_push)
+    {
+      while (degree >= (2 << m_height_max))
+	{
+	  m_height_max++;
+	}
+    }
+
+  m_state->m_running = 0;
+  m_state->m_is_closed = false;
+  m_state->m_nodes.resize (1 << m_height_max);
+  for (node &n : m_state->m_nodes)
+    {
+      n.m_status = node::IDLE;
+    }
+  m_state->m_run_sort = run_sort;
+  m_state->m_compare = compare;
+  m_state->m_compare_arg = compare_arg;
+  m_state->m_append_dup = append_dup;
+}
+
+parallel_sort::~parallel_sort ()
+{
+  // workers that have not started yet keep the state alive; they must not touch the sort arguments
+  std::unique_lock<std::mutex> ulock (m_state->m_mutex);
+  assert (m_state->m_running == 0);
+  m_state->m_is_closed = true;
+}
+
+int
+parallel_sort::get_degree () const
+{
+  return 1 << m_height_max;
+}
+
+char **
+parallel_sort::sort (THREAD_ENTRY *thread_p, char **buff, char **vector, long vector_size, long *result_size)
+{
+  int height_max;
+  int node_count;
+  int height;
+  int step;
+  int i;
+  long start, stop;
+
+  // do not split in partitions too small to pay off the hand over to workers
+  height_max = m_height_max;
+  while (height_max > 0 && (vector_size >> height_max) < m_min_run_size)
+    {
+      height_max--;
+    }
+  if (height_max == 0)
+    {
+      return m_state->m_run_sort (thread_p, vector, vector_size, buff, result_size);
+    }
+  node_count = 1 << height_max;
+
+  // run generation; the first leaf is sorted by this thread
+  for (i = node_count - 1; i >= 0; i--)
+    {
+      node &n = m_state->m_nodes[i];
+
+      start = (long) (((std::int64_t) vector_size * i) >> height_max);
+      stop = (long) (((std::int64_t) vector_size * (i + 1)) >> height_max);
+
+      n.m_height = 0;
+      n.m_buff = buff + start;
+      n.m_vector = vector + start;
+      n.m_vector_size = stop - start;
+      n.m_result = n.m_vector;
+      n.m_result_size = n.m_vector_size;
+
+      if (i > 0)
+	{
+	  hand_over (i);
+	}
+      else
+	{
+	  run_node (*m_state, thread_p, i);
+	}
+    }
+  wait_level (thread_p);
+
+  // merge siblings, one tree level at a time
+  for (height = 1; height <= height_max; height++)
+    {
+      step = 1 << height;
+      for (i = node_count - step; i >= 0; i -= step)
+	{
+	  m_state->m_nodes[i].m_height = height;
+
+	  if (i > 0)
+	    {
+	      hand_over (i);
+	    }
+	  else
+	    {
+	      run_node (*m_state, thread_p, i);
+	    }
+	}
+      wait_level (thread_p);
+    }
+
+  const node &root = m_state->m_nodes[0];
+  if (root.m_result == NULL || root.m_result_size < 0)
+    {
+      return NULL;
+    }
+
+  *result_size = root.m_result_size;
+  return root.m_result;
+}
+
+//
+// run_node () - sort the partition of a leaf, or merge the result of an internal node with its right sibling, which is
+//               one level closer to the leaves. nodes never wait for each other; sort () runs a level at a time.
+//
+void
+parallel_sort::run_node (shared_state &state, THREAD_ENTRY *thread_p, int node_id)
+{
+  node &n = state.m_nodes[node_id];
+  int error = NO_ERROR;
+
+  if (n.m_height == 0)
+    {
+      n.m_result = state.m_run_sort (thread_p, n.m_vector, n.m_vector_size, n.m_buff, &n.m_result_size);
+    }
+  else
+    {
+      assert (node_id + (1 << n.m_height) <= (int) state.m_nodes.size ());
+      error = merge (state, n, state.m_nodes[node_id + (1 << (n.m_height - 1))]);
+    }
+
+  if (error != NO_ERROR || n.m_result == NULL || n.m_result_size < 0)
+    {
+      n.m_result = NULL;
+      n.m_result_size = -1;
+    }
+}
+
+//
+// execute_handed_over () - run a node on a worker, unless the sorting thread has claimed it first
+//
+void
+parallel_sort::execute_handed_over (const std::shared_ptr<shared_state> &state, THREAD_ENTRY *thread_p, int node_id)
+{
+  std::unique_lock<std::mutex> ulock (state->m_mutex);
+
+  if (state->m_is_closed || state->m_nodes[node_id].m_status != node::QUEUED)
+    {
+      return;
+    }
+  state->m_nodes[node_id].m_status = node::RUNNING;
+  state->m_running++;
+  ulock.unlock ();
+
+  run_node (*state, thread_p, node_id);
+
+  ulock.lock ();
+  state->m_nodes[node_id].m_status = node::IDLE;
+  assert (state->m_running > 0);
+  if (--state->m_running == 0)
+    {
+      state->m_cond.notify_all ();
+    }
+}
+
+void
+parallel_sort::hand_over (int node_id)
+{
+  std::shared_ptr<shared_state> state = m_state;
+
+  {
+    std::unique_lock<std::mutex> ulock (m_state->m_mutex);
+    assert (m_state->m_nodes[node_id].m_status == node::IDLE);
+    m_state->m_nodes[node_id].m_status = node::QUEUED;
+  }
+
+  m_push ([state, node_id] (THREAD_ENTRY *thread_p)
+  {
+    execute_handed_over (state, thread_p, node_id);
+  });
+}
+
+//
+// wait_level () - run the nodes of the level that no worker has claimed, then wait for those that workers run
+//
+void
+parallel_sort::wait_level (THREAD_ENTRY *thread_p)
+{
+  std::unique_lock<std::mutex> ulock (m_state->m_mutex);
+
+  for (std::size_t i = 0; i < m_state->m_nodes.size (); i++)
+    {
+      if (m_state->m_nodes[i].m_status != node::QUEUED)
+	{
+	  continue;
+	}
+
+      // the worker of this node will find it claimed and exit
+      m_state->m_nodes[i].m_status = node::RUNNING;
+      ulock.unlock ();
+
+      run_node (*m_state, thread_p, (int) i);
+
+      ulock.lock ();
+      m_state->m_nodes[i].m_status = node::IDLE;
+    }
+
+  m_state->m_cond.wait (ulock, [this] { return m_state->m_running == 0; });
+}
+
+//
+// merge () - merge the sorted results of two sibling nodes into the left node
+//
+// the merged result is written to the area opposite to the one holding the left result, so a pointer is never
+// overwritten before it is read.
+//
+int
+parallel_sort::merge (shared_state &state, node &left, const node &right)
+{
+  char **result;
+  char **left_vector = left.m_result;
+  char **right_vector = right.m_result;
+  long left_size = left.m_result_size;
+  long right_size = right.m_result_size;
+  long i = 0, j = 0, k = 0;
+  int cmp;
+
+  if (left_vector == NULL || left_size < 0 || right_vector == NULL || right_size < 0)
+    {
+      return ER_FAILED;
+    }
+
+  assert (right.m_vector == left.m_vector + left.m_vector_size);
+  assert (right.m_buff == left.m_buff + left.m_vector_size);
+  assert (left_size > 0 && right_size > 0);
+
+  if (left_vector >= left.m_vector && left_vector < left.m_vector + left.m_vector_size)
+    {
+      result = left.m_buff;
+    }
+  else
+    {
+      result = left.m_vector;
+    }
+
+  // the two results often do not overlap at all; then they are just concatenated
+  cmp = state.m_compare (&left_vector[left_size - 1], &right_vector[0], state.m_compare_arg);
+  if (cmp == DB_LT)
+    {
+      while (i < left_size)
+	{
+	  result[k++] = left_vector[i++];
+	}
+      while (j < right_size)
+	{
+	  result[k++] = right_vector[j++];
+	}
+    }
+  else if (state.m_compare (&right_vector[right_size - 1], &left_vector[0], state.m_compare_arg) == DB_LT)
+    {
+      while (j < right_size)
+	{
+	  result[k++] = right_vector[j++];
+	}
+      while (i < left_size)
+	{
+	  result[k++] = left_vector[i++];
+	}
+    }
+  else
+    {
+      while (i < left_size && j < right_size)
+	{
+	  cmp = state.m_compare (&left_vector[i], &right_vector[j], state.m_compare_arg);
+	  if (cmp == DB_EQ)
+	    {
+	      if (state.m_append_dup != NULL)
+		{
+		  state.m_append_dup (&left_vector[i], &right_vector[j]);
+		}
+	      // keep right, which carries left if duplicates are kept
+	      result[k++] = right_vector[j++];
+	      i++;
+	    }
+	  else if (cmp == DB_GT)
+	    {
+	      result[k++] = right_vector[j++];
+	    }
+	  else if (cmp == DB_LT)
+	    {
+	      result[k++] = left_vector[i++];
+	    }
+	  else
+	    {
+	      assert (false);
+	      return ER_FAILED;
+	    }
+	}
+      while (i < left_size)
+	{
+	  result[k++] = left_vector[i++];
+	}
+      while (j < right_size)
+	{
+	  result[k++] = right_vector[j++];
+	}
+    }
+
+  assert (k <= left.m_vector_size + right.m_vector_size);
+
+#if !defined (NDEBUG)
+  for (long n = 0; n + 1 < k; n++)
+    {
+      assert (state.m_compare (&result[n], &result[n + 1], state.m_compare_arg) == DB_LT);
+    }
+#endif // !NDEBUG
+
+  left.m_vector_size += right.m_vector_size;
+  left.m_result = result;
+  left.m_result_size = k;
+
+  return NO_ERROR;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// parallel_sort - sort an array of record pointers on several threads
+//
+//  how it works:
+//    the array is split in 2^n partitions. the partitions are sorted concurrently (run generation), then sorted
+//    siblings are merged pairwise, one tree level at a time; the merges of one level run concurrently too. partitions
+//    are sorted by a function of the caller (external sort uses its run sort), merges are done here.
+//
+//    every node of a level, except the first, is handed over to a worker with the push function of the caller. a
+//    worker claims its node before it runs it. the sorting thread runs the first node, then every node that no worker
+//    has claimed yet, and only then waits for the nodes that workers are running. a saturated worker pool makes the
+//    sort slower, but it never blocks it.
+//
+//    the state shared with workers is reference counted. a worker that starts after the sort is done finds the state
+//    closed and exits without touching the sort arguments.
+//
+//    with degree 1, without a push function, or for arrays too small to pay off the hand over, everything runs on the
+//    sorting thread.
+//
+
+#ifndef _PARALLEL_SORT_HPP_
+#define _PARALLEL_SORT_HPP_
+
+#include "thread_compat.hpp"
+
+#include <functional>
+#include <memory>
+
+class parallel_sort
+{
+  public:
+    // compare the elements two pointers of the array point to; returns DB_LT, DB_EQ or DB_GT, like SORT_CMP_FUNC
+    using compare_func = int (const void *left, const void *right, void *arg);
+    // merging keeps right of two equal elements; when duplicates are kept, left is appended to right
+    using append_dup_func = void (const void *left, const void *right);
+    // sort vector[0, size), using buff of the same size as work area. returns the sorted pointers, in vector or in
+    // buff, and their count in result_size (equal elements are combined); NULL on error
+    using run_sort_func = std::function<char ** (THREAD_ENTRY *thread_p, char **vector, long size, char **buff,
+				       long *result_size)>;
+    // a task for a worker; it gets the thread entry of the worker
+    using task_func = std::function<void (THREAD_ENTRY *thread_p)>;
+    // hand over a task to a worker
+    using push_func = std::function<void (const task_func &task)>;
+
+    // degree is rounded down to a power of two; partitions are not split below min_run_size elements.
+    // append_dup is NULL when duplicates are eliminated. push may be empty; the sort is serial then.
+    parallel_sort (int degree, long min_run_size, const run_sort_func &run_sort, compare_func *compare,
+		   void *compare_arg, append_dup_func *append_dup, const push_func &push);
+    parallel_sort (const parallel_sort &) = delete;
+    parallel_sort &operator= (const parallel_sort &) = delete;
+    ~parallel_sort ();
+
+    // sort vector[0, vector_size), using buff of the same size as work area. returns the sorted pointers, in vector
+    // or in buff, and their count in result_size; NULL on error
+    char **sort (THREAD_ENTRY *thread_p, char **buff, char **vector, long vector_size, long *result_size);
+
+    int get_degree () const;
+
+  private:
+    struct node;
+    struct shared_state;
+
+    static void run_node (shared_state &state, THREAD_ENTRY *thread_p, int node_id);
+    static void execute_handed_over (const std::shared_ptr<shared_state> &state, THREAD_ENTRY *thread_p,
+				     int node_id);
+    static int merge (shared_state &state, node &left, const node &right);
+
+    void hand_over (int node_id);
+    void wait_level (THREAD_ENTRY *thread_p);
+
+    std::shared_ptr<shared_state> m_state;
+    push_func m_push;
+    int m_height_max;		// the tree has up to 2^m_height_max leaves
+    long m_min_run_size;
+};
+
+#endif // _PARALLEL_SORT_HPP_
@@ -44,6 +44,10 @@
 
 #define STATS_MIN_MAX_SIZE    sizeof(DB_DATA)
 
+/* column statistics gathered from heap page samples */
+#define STATS_HISTOGRAM_MAX_BUCKETS  32	/* equi-depth buckets per column */
+#define STATS_HISTOGRAM_MAX_BOUNDS   (STATS_HISTOGRAM_MAX_BUCKETS + 1)
+
 /* free_and_init routine */
 #define stats_free_statistics_and_init(stats) \
   do \
@@ -80,6 +84,10 @@ struct attr_stats
   DB_TYPE type;
   int n_btstats;		/* number of B+tree statistics information */
   BTREE_STATS *bt_stats;	/* pointer to array of BTREE_STATS[n_btstats] */
+  int ndv;			/* estimated number of distinct non-null values; 0 if unknown */
+  int null_count;		/* estimated number of null values */
+  int n_bounds;			/* number of histogram bounds; 0 if no histogram */
+  double *bounds;		/* equi-depth histogram bounds; bounds[0] is min, bounds[n_bounds-1] is max */
 };
 
 /* Statistical Information about the class */
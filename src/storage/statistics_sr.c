@@ -35,10 +35,21 @@
 #include "boot_sr.h"
 #include "partition_sr.h"
 #include "object_primitive.h"
+#include "memory_hash.h"
+#include "slotted_page.h"
+#include "system_parameter.h"
 #include "thread_entry.hpp"
 
 #define SQUARE(n) ((n)*(n))
 
+/* column statistics are built from a bounded random sample of heap pages */
+#define STATS_FULLSCAN_SAMPLING_FACTOR  16	/* WITH FULLSCAN samples this many times more pages */
+#define STATS_HISTOGRAM_MAX_KEYS        30000	/* reservoir of values a histogram is built from */
+
+/* HyperLogLog sketch used to estimate the number of distinct values */
+#define STATS_HLL_PRECISION    11
+#define STATS_HLL_REGISTERS    (1 << STATS_HLL_PRECISION)
+
 /* Used by the "stats_update_all_statistics" routine to create the list of all
    classes from the extensible hashing directory used by the catalog manager. */
 typedef struct class_id_list CLASS_ID_LIST;
@@ -60,6 +71,21 @@ struct partition_stats_acumulator
 				 * # of {a, b} ... pkeys[pkeys_size-1] -> # of {a, b, ..., x} */
 };
 
+/* Sampled values of one attribute, used by "stats_sample_column_statistics" */
+typedef struct stats_column_sample STATS_COLUMN_SAMPLE;
+struct stats_column_sample
+{
+  DISK_ATTR *disk_attr_p;	/* attribute of the last representation */
+  int n_values;			/* number of sampled non-null values */
+  int n_nulls;			/* number of sampled null values */
+  bool has_hll;			/* values of the attribute were hashed into hll[] */
+  unsigned char hll[STATS_HLL_REGISTERS];	/* HyperLogLog registers */
+  bool no_keys;			/* values of the attribute have no histogram key */
+  double *keys;			/* reservoir of histogram keys */
+  int n_keys;			/* number of keys in reservoir */
+  int n_keys_seen;		/* number of keys offered to reservoir */
+};
+
 #if defined(ENABLE_UNUSED_FUNCTION)
 static int stats_compare_data (DB_DATA * data1, DB_DATA * data2, DB_TYPE type);
 static int stats_compare_date (DB_DATE * date1, DB_DATE * date2);
@@ -70,6 +96,14 @@ static int stats_compare_money (DB_MONETARY * mn1, DB_MONETARY * mn2);
 #endif
 static int stats_update_partitioned_statistics (THREAD_ENTRY * thread_p, OID * class_oid, OID * partitions, int count,
 						bool with_fullscan);
+static int stats_sample_column_statistics (THREAD_ENTRY * thread_p, OID * class_id_p, HFID * hfid_p,
+					   DISK_REPR * disk_repr_p, int tot_pages, int tot_objects, bool with_fullscan);
+static bool stats_is_hashable_type (DB_TYPE type);
+static void stats_sample_add_value (STATS_COLUMN_SAMPLE * sample, DB_VALUE * value);
+static double stats_hll_estimate (const unsigned char *hll);
+static int stats_compare_keys (const void *key1, const void *key2);
+static int stats_build_column_statistics (THREAD_ENTRY * thread_p, STATS_COLUMN_SAMPLE * sample, int n_rows,
+					  int tot_objects, bool is_complete);
 
 /*
  * xstats_update_statistics () -  Updates the statistics for the objects
@@ -276,6 +310,14 @@ xstats_update_statistics (THREAD_ENTRY * thread_p, OID * class_id_p, bool with_f
 	}			/* for (j = 0; ...) */
     }				/* for (i = 0; ...) */
 
+  /* distinct values, nulls and histograms of each attribute */
+  error_code = stats_sample_column_statistics (thread_p, class_id_p, &cls_info_p->ci_hfid, disk_repr_p, npages,
+					       cls_info_p->ci_tot_objects, with_fullscan);
+  if (error_code != NO_ERROR)
+    {
+      goto error;
+    }
+
   error_code = catalog_start_access_with_dir_oid (thread_p, &catalog_access_info, X_LOCK);
   if (error_code != NO_ERROR)
     {
@@ -447,7 +489,7 @@ xstats_get_statistics_from_server (THREAD_ENTRY * thread_p, OID * class_id_p, un
   BTREE_STATS *btree_stats_p;
   OID dir_oid;
   int npages, estimated_nobjs, max_unique_keys;
-  int i, j, k, size, n_attrs, tot_n_btstats, tot_key_info_size;
+  int i, j, k, size, n_attrs, tot_n_btstats, tot_key_info_size, tot_n_bounds;
   char *buf_p, *start_p;
   int key_size;
   int lk_grant_code;
@@ -524,7 +566,7 @@ xstats_get_statistics_from_server (THREAD_ENTRY * thread_p, OID * class_id_p, un
 
   n_attrs = disk_repr_p->n_fixed + disk_repr_p->n_variable;
 
-  tot_n_btstats = tot_key_info_size = 0;
+  tot_n_btstats = tot_key_info_size = tot_n_bounds = 0;
   for (i = 0; i < n_attrs; i++)
     {
       if (i < disk_repr_p->n_fixed)
@@ -537,6 +579,7 @@ xstats_get_statistics_from_server (THREAD_ENTRY * thread_p, OID * class_id_p, un
 	}
 
       tot_n_btstats += disk_attr_p->n_btstats;
+      tot_n_bounds += disk_attr_p->n_bounds;
       for (j = 0, btree_stats_p = disk_attr_p->bt_stats; j < disk_attr_p->n_btstats; j++, btree_stats_p++)
 	{
 	  tot_key_info_size += or_packed_domain_size (btree_stats_p->key_type, 0);
@@ -552,8 +595,13 @@ xstats_get_statistics_from_server (THREAD_ENTRY * thread_p, OID * class_id_p, un
 	  + (OR_INT_SIZE	/* id of DISK_ATTR */
 	     + OR_INT_SIZE	/* type of DISK_ATTR */
 	     + OR_INT_SIZE	/* n_btstats of DISK_ATTR */
+	     + OR_INT_SIZE	/* ndv of DISK_ATTR */
+	     + OR_INT_SIZE	/* null_count of DISK_ATTR */
+	     + OR_INT_SIZE	/* n_bounds of DISK_ATTR */
 	  ) * n_attrs);		/* number of attributes */
 
+  size += OR_DOUBLE_SIZE * tot_n_bounds;	/* histogram bounds of DISK_ATTR */
+
   size += ((OR_BTID_ALIGNED_SIZE	/* btid of BTREE_STATS */
 	    + OR_INT_SIZE	/* leafs of BTREE_STATS */
 	    + OR_INT_SIZE	/* pages of BTREE_STATS */
@@ -652,6 +700,21 @@ xstats_get_statistics_from_server (THREAD_ENTRY * thread_p, OID * class_id_p, un
       OR_PUT_INT (buf_p, disk_attr_p->n_btstats);
       buf_p += OR_INT_SIZE;
 
+      OR_PUT_INT (buf_p, disk_attr_p->ndv);
+      buf_p += OR_INT_SIZE;
+
+      OR_PUT_INT (buf_p, disk_attr_p->null_count);
+      buf_p += OR_INT_SIZE;
+
+      OR_PUT_INT (buf_p, disk_attr_p->n_bounds);
+      buf_p += OR_INT_SIZE;
+
+      for (j = 0; j < disk_attr_p->n_bounds; j++)
+	{
+	  OR_PUT_DOUBLE (buf_p, &disk_attr_p->bounds[j]);
+	  buf_p += OR_DOUBLE_SIZE;
+	}
+
       for (j = 0, btree_stats_p = disk_attr_p->bt_stats; j < disk_attr_p->n_btstats; j++, btree_stats_p++)
 	{
 	  /* collect maximum unique keys info */
@@ -795,6 +858,507 @@ exit_on_error:
   return NULL;
 }
 
+/*
+ * stats_sample_column_statistics () - Estimates distinct values, nulls and
+ *                                     histograms of the class attributes
+ *   return: error code
+ *   class_id_p(in): class identifier
+ *   hfid_p(in): heap file of the class
+ *   disk_repr_p(in/out): last disk representation; receives column statistics
+ *   tot_pages(in): number of heap pages
+ *   tot_objects(in): estimated number of objects
+ *   with_fullscan(in): true iff WITH FULLSCAN
+ *
+ * Note: Only a bounded random sample of heap pages is read, so the cost does
+ *       not depend on the size of the class. The pages are picked from the
+ *       heap file table without fixing any other page (see file_sample_pages)
+ *       and the visible objects of each sampled page are read. The number of
+ *       distinct values is estimated with a HyperLogLog sketch of the sample
+ *       and scaled to the class; equi-depth histograms are built from a
+ *       reservoir of the sampled values of numeric and date/time attributes.
+ */
+static int
+stats_sample_column_statistics (THREAD_ENTRY * thread_p, OID * class_id_p, HFID * hfid_p, DISK_REPR * disk_repr_p,
+				int tot_pages, int tot_objects, bool with_fullscan)
+{
+  STATS_COLUMN_SAMPLE *samples = NULL;
+  int *value_samples = NULL;
+  VPID *vpids = NULL;
+  OID *oids = NULL;
+  int max_oids = 0, n_oids;
+  int n_attrs, max_pages, n_pages, n_rows = 0;
+  int i, j, k;
+  PAGE_PTR page_p;
+  PGSLOTID slot_id;
+  RECDES recdes;
+  OID class_oid;
+  HEAP_SCANCACHE scan_cache;
+  HEAP_CACHE_ATTRINFO attr_info;
+  bool scan_cache_started = false, attr_info_started = false;
+  MVCC_SNAPSHOT *mvcc_snapshot;
+  SCAN_CODE scan;
+  int error_code = NO_ERROR;
+
+  n_attrs = disk_repr_p->n_fixed + disk_repr_p->n_variable;
+
+  max_pages = prm_get_integer_value (PRM_ID_STATS_SAMPLING_PAGES);
+  if (with_fullscan)
+    {
+      max_pages *= STATS_FULLSCAN_SAMPLING_FACTOR;
+    }
+  max_pages = MIN (max_pages, tot_pages);
+  if (n_attrs <= 0 || max_pages <= 0)
+    {
+      return NO_ERROR;
+    }
+
+  vpids = (VPID *) db_private_alloc (thread_p, max_pages * sizeof (VPID));
+  samples = (STATS_COLUMN_SAMPLE *) db_private_alloc (thread_p, n_attrs * sizeof (STATS_COLUMN_SAMPLE));
+  if (vpids == NULL || samples == NULL)
+    {
+      error_code = ER_OUT_OF_VIRTUAL_MEMORY;
+      goto exit;
+    }
+
+  memset (samples, 0, n_attrs * sizeof (STATS_COLUMN_SAMPLE));
+  for (i = 0; i < n_attrs; i++)
+    {
+      if (i < disk_repr_p->n_fixed)
+	{
+	  samples[i].disk_attr_p = disk_repr_p->fixed + i;
+	}
+      else
+	{
+	  samples[i].disk_attr_p = disk_repr_p->variable + (i - disk_repr_p->n_fixed);
+	}
+      samples[i].has_hll = stats_is_hashable_type (samples[i].disk_attr_p->type);
+    }
+
+  error_code = file_sample_pages (thread_p, &hfid_p->vfid, max_pages, vpids, &n_pages);
+  if (error_code != NO_ERROR)
+    {
+      goto exit;
+    }
+
+  mvcc_snapshot = logtb_get_mvcc_snapshot (thread_p);
+  if (mvcc_snapshot == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error_code);
+      goto exit;
+    }
+
+  error_code = heap_scancache_start (thread_p, &scan_cache, hfid_p, class_id_p, true, false, mvcc_snapshot);
+  if (error_code != NO_ERROR)
+    {
+      goto exit;
+    }
+  scan_cache_started = true;
+
+  error_code = heap_attrinfo_start (thread_p, class_id_p, -1, NULL, &attr_info);
+  if (error_code != NO_ERROR)
+    {
+      goto exit;
+    }
+  attr_info_started = true;
+
+  /* map each value of attr_info to the sample of its attribute */
+  if (attr_info.num_values > 0)
+    {
+      value_samples = (int *) db_private_alloc (thread_p, attr_info.num_values * sizeof (int));
+      if (value_samples == NULL)
+	{
+	  error_code = ER_OUT_OF_VIRTUAL_MEMORY;
+	  goto exit;
+	}
+    }
+  for (j = 0; j < attr_info.num_values; j++)
+    {
+      value_samples[j] = -1;
+      for (i = 0; i < n_attrs; i++)
+	{
+	  if (samples[i].disk_attr_p->id == attr_info.values[j].attrid)
+	    {
+	      value_samples[j] = i;
+	      break;
+	    }
+	}
+    }
+
+  for (i = 0; i < n_pages; i++)
+    {
+      page_p = pgbuf_fix (thread_p, &vpids[i], OLD_PAGE, PGBUF_LATCH_READ, PGBUF_CONDITIONAL_LATCH);
+      if (page_p == NULL)
+	{
+	  if (er_errid () == ER_INTERRUPTED)
+	    {
+	      error_code = ER_INTERRUPTED;
+	      goto exit;
+	    }
+	  /* the sample does not need this page */
+	  er_clear ();
+	  continue;
+	}
+
+      if (pgbuf_get_page_ptype (thread_p, page_p) != PAGE_HEAP)
+	{
+	  pgbuf_unfix_and_init (thread_p, page_p);
+	  continue;
+	}
+
+      if (spage_number_of_slots (page_p) > max_oids)
+	{
+	  max_oids = spage_number_of_slots (page_p);
+	  if (oids != NULL)
+	    {
+	      db_private_free_and_init (thread_p, oids);
+	    }
+	  oids = (OID *) db_private_alloc (thread_p, max_oids * sizeof (OID));
+	  if (oids == NULL)
+	    {
+	      pgbuf_unfix_and_init (thread_p, page_p);
+	      error_code = ER_OUT_OF_VIRTUAL_MEMORY;
+	      goto exit;
+	    }
+	}
+
+      /* collect the objects of the page; they are read after the page is unfixed */
+      n_oids = 0;
+      slot_id = NULL_SLOTID;
+      while (spage_next_record (page_p, &slot_id, &recdes, PEEK) == S_SUCCESS)
+	{
+	  if (slot_id == HEAP_HEADER_AND_CHAIN_SLOTID)
+	    {
+	      continue;
+	    }
+	  if (recdes.type == REC_HOME || recdes.type == REC_RELOCATION || recdes.type == REC_BIGONE)
+	    {
+	      assert (n_oids < max_oids);
+	      oids[n_oids].volid = vpids[i].volid;
+	      oids[n_oids].pageid = vpids[i].pageid;
+	      oids[n_oids].slotid = slot_id;
+	      n_oids++;
+	    }
+	}
+      pgbuf_unfix_and_init (thread_p, page_p);
+
+      for (j = 0; j < n_oids; j++)
+	{
+	  COPY_OID (&class_oid, class_id_p);
+	  recdes.data = NULL;
+	  scan = heap_get_visible_version (thread_p, &oids[j], &class_oid, &recdes, &scan_cache, PEEK, NULL_CHN);
+	  if (scan == S_ERROR)
+	    {
+	      ASSERT_ERROR_AND_SET (error_code);
+	      goto exit;
+	    }
+	  if (scan != S_SUCCESS)
+	    {
+	      continue;
+	    }
+
+	  error_code = heap_attrinfo_read_dbvalues (thread_p, &oids[j], &recdes, NULL, &attr_info);
+	  if (error_code != NO_ERROR)
+	    {
+	      goto exit;
+	    }
+
+	  for (k = 0; k < attr_info.num_values; k++)
+	    {
+	      if (value_samples[k] >= 0 && attr_info.values[k].attr_type == HEAP_INSTANCE_ATTR)
+		{
+		  stats_sample_add_value (&samples[value_samples[k]], &attr_info.values[k].dbvalue);
+		}
+	    }
+	  n_rows++;
+	}
+    }
+
+  for (i = 0; i < n_attrs; i++)
+    {
+      error_code = stats_build_column_statistics (thread_p, &samples[i], n_rows, tot_objects, n_pages >= tot_pages);
+      if (error_code != NO_ERROR)
+	{
+	  goto exit;
+	}
+    }
+
+exit:
+  if (attr_info_started)
+    {
+      heap_attrinfo_end (thread_p, &attr_info);
+    }
+  if (scan_cache_started)
+    {
+      (void) heap_scancache_end (thread_p, &scan_cache);
+    }
+  if (samples != NULL)
+    {
+      for (i = 0; i < n_attrs; i++)
+	{
+	  if (samples[i].keys != NULL)
+	    {
+	      db_private_free_and_init (thread_p, samples[i].keys);
+	    }
+	}
+      db_private_free_and_init (thread_p, samples);
+    }
+  if (value_samples != NULL)
+    {
+      db_private_free_and_init (thread_p, value_samples);
+    }
+  if (oids != NULL)
+    {
+      db_private_free_and_init (thread_p, oids);
+    }
+  if (vpids != NULL)
+    {
+      db_private_free_and_init (thread_p, vpids);
+    }
+
+  return error_code;
+}
+
+/*
+ * stats_is_hashable_type () - true if the distinct values of the type can be
+ *                             counted by hashing them
+ *   return: bool
+ *   type(in): attribute type
+ */
+static bool
+stats_is_hashable_type (DB_TYPE type)
+{
+  switch (type)
+    {
+    case DB_TYPE_INTEGER:
+    case DB_TYPE_SHORT:
+    case DB_TYPE_BIGINT:
+    case DB_TYPE_FLOAT:
+    case DB_TYPE_DOUBLE:
+    case DB_TYPE_MONETARY:
+    case DB_TYPE_NUMERIC:
+    case DB_TYPE_DATE:
+    case DB_TYPE_TIME:
+    case DB_TYPE_TIMESTAMP:
+    case DB_TYPE_TIMESTAMPLTZ:
+    case DB_TYPE_TIMESTAMPTZ:
+    case DB_TYPE_DATETIME:
+    case DB_TYPE_DATETIMELTZ:
+    case DB_TYPE_DATETIMETZ:
+    case DB_TYPE_OID:
+    case DB_TYPE_OBJECT:
+    case DB_TYPE_BIT:
+    case DB_TYPE_VARBIT:
+    case DB_TYPE_CHAR:
+    case DB_TYPE_VARCHAR:
+    case DB_TYPE_NCHAR:
+    case DB_TYPE_VARNCHAR:
+    case DB_TYPE_ENUMERATION:
+      return true;
+
+    default:
+      return false;
+    }
+}
+
+/*
+ * stats_sample_add_value () - Add a sampled value to the sample of its attribute
+ *   return: nothing
+ *   sample(in/out): attribute sample
+ *   value(in): sampled value
+ */
+static void
+stats_sample_add_value (STATS_COLUMN_SAMPLE * sample, DB_VALUE * value)
+{
+  unsigned int hash, rank;
+  double key;
+  int slot;
+
+  if (DB_IS_NULL (value))
+    {
+      sample->n_nulls++;
+      return;
+    }
+
+  sample->n_values++;
+
+  if (sample->has_hll && DB_VALUE_TYPE (value) != DB_TYPE_OBJECT)
+    {
+      /* spread the bits of the hash (murmur3 finalizer); the first bits select the register and the rank of the
+       * first set bit among the others is kept */
+      hash = mht_get_hash_number (INT_MAX, value);
+      hash ^= hash >> 16;
+      hash *= 0x85ebca6b;
+      hash ^= hash >> 13;
+      hash *= 0xc2b2ae35;
+      hash ^= hash >> 16;
+
+      for (rank = 1; rank <= 32 - STATS_HLL_PRECISION; rank++)
+	{
+	  if (hash & (1U << (32 - STATS_HLL_PRECISION - rank)))
+	    {
+	      break;
+	    }
+	}
+      if (sample->hll[hash >> (32 - STATS_HLL_PRECISION)] < rank)
+	{
+	  sample->hll[hash >> (32 - STATS_HLL_PRECISION)] = (unsigned char) rank;
+	}
+    }
+
+  if (sample->no_keys || !tp_value_to_histogram_key (value, &key))
+    {
+      sample->no_keys = true;
+      return;
+    }
+
+  if (sample->keys == NULL)
+    {
+      sample->keys = (double *) db_private_alloc (NULL, STATS_HISTOGRAM_MAX_KEYS * sizeof (double));
+      if (sample->keys == NULL)
+	{
+	  /* go on without histogram */
+	  er_clear ();
+	  sample->no_keys = true;
+	  return;
+	}
+    }
+
+  /* reservoir sampling keeps a uniform sample of the keys */
+  sample->n_keys_seen++;
+  if (sample->n_keys < STATS_HISTOGRAM_MAX_KEYS)
+    {
+      sample->keys[sample->n_keys++] = key;
+    }
+  else
+    {
+      slot = (int) (drand48 () * sample->n_keys_seen);
+      if (slot < STATS_HISTOGRAM_MAX_KEYS)
+	{
+	  sample->keys[slot] = key;
+	}
+    }
+}
+
+/*
+ * stats_hll_estimate () - Estimate the number of distinct hashed values
+ *   return: estimated cardinality
+ *   hll(in): HyperLogLog registers
+ */
+static double
+stats_hll_estimate (const unsigned char *hll)
+{
+  double sum = 0.0, estimate;
+  int i, n_zeros = 0;
+
+  for (i = 0; i < STATS_HLL_REGISTERS; i++)
+    {
+      sum += ldexp (1.0, -hll[i]);
+      if (hll[i] == 0)
+	{
+	  n_zeros++;
+	}
+    }
+
+  estimate = (0.7213 / (1.0 + 1.079 / STATS_HLL_REGISTERS)) * STATS_HLL_REGISTERS * STATS_HLL_REGISTERS / sum;
+  if (estimate <= 2.5 * STATS_HLL_REGISTERS && n_zeros > 0)
+    {
+      /* small range correction */
+      estimate = STATS_HLL_REGISTERS * log ((double) STATS_HLL_REGISTERS / n_zeros);
+    }
+
+  return estimate;
+}
+
+/*
+ * stats_compare_keys () - qsort comparator of histogram keys
+ */
+static int
+stats_compare_keys (const void *key1, const void *key2)
+{
+  double k1 = *(const double *) key1;
+  double k2 = *(const double *) key2;
+
+  return (k1 < k2) ? -1 : ((k1 > k2) ? 1 : 0);
+}
+
+/*
+ * stats_build_column_statistics () - Set column statistics of an attribute
+ *                                    from its sample
+ *   return: error code
+ *   sample(in): attribute sample
+ *   n_rows(in): number of sampled objects
+ *   tot_objects(in): estimated number of objects of the class
+ *   is_complete(in): true if the whole heap was sampled
+ *
+ * Note: The distinct values of the sample are scaled to the class as
+ *       d * (N / n) ^ (d / n), where d are the distinct values among n sampled
+ *       values and N the estimated number of non-null values of the class:
+ *       a sample made of unique values scales linearly, while a sample with
+ *       few repeated values is assumed to already contain all of them.
+ */
+static int
+stats_build_column_statistics (THREAD_ENTRY * thread_p, STATS_COLUMN_SAMPLE * sample, int n_rows, int tot_objects,
+			       bool is_complete)
+{
+  DISK_ATTR *disk_attr_p = sample->disk_attr_p;
+  double distinct, scale, tot_values;
+  int i, n_bounds;
+
+  disk_attr_p->ndv = 0;
+  disk_attr_p->null_count = 0;
+  disk_attr_p->n_bounds = 0;
+  if (disk_attr_p->bounds != NULL)
+    {
+      db_private_free_and_init (thread_p, disk_attr_p->bounds);
+    }
+
+  if (n_rows <= 0)
+    {
+      return NO_ERROR;
+    }
+
+  scale = (is_complete || tot_objects <= n_rows) ? 1.0 : (double) tot_objects / n_rows;
+  disk_attr_p->null_count = (int) MIN (sample->n_nulls * scale, (double) INT_MAX);
+
+  if (sample->n_values <= 0)
+    {
+      return NO_ERROR;
+    }
+
+  if (sample->has_hll)
+    {
+      distinct = MIN (stats_hll_estimate (sample->hll), (double) sample->n_values);
+      distinct = MAX (distinct, 1.0);
+      tot_values = sample->n_values * scale;
+      if (scale > 1.0)
+	{
+	  distinct *= pow (scale, distinct / sample->n_values);
+	}
+      disk_attr_p->ndv = (int) MIN (MIN (distinct, tot_values), (double) INT_MAX);
+    }
+
+  if (sample->keys != NULL && !sample->no_keys && sample->n_keys >= 2)
+    {
+      n_bounds = MIN (sample->n_keys, STATS_HISTOGRAM_MAX_BOUNDS);
+      disk_attr_p->bounds = (double *) db_private_alloc (thread_p, n_bounds * sizeof (double));
+      if (disk_attr_p->bounds == NULL)
+	{
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
+	}
+
+      qsort (sample->keys, sample->n_keys, sizeof (double), stats_compare_keys);
+
+      /* equi-depth: each bucket holds the same number of sampled values */
+      for (i = 0; i < n_bounds; i++)
+	{
+	  disk_attr_p->bounds[i] = sample->keys[(INT64) (sample->n_keys - 1) * i / (n_bounds - 1)];
+	}
+      disk_attr_p->n_bounds = n_bounds;
+    }
+
+  return NO_ERROR;
+}
+
 #if defined(ENABLE_UNUSED_FUNCTION)
 /*
  * stats_compare_date () -
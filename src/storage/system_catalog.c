@@ -96,7 +96,7 @@ static int rv;
 #define CATALOG_DISK_REPR_N_FIXED_OFF        4
 #define CATALOG_DISK_REPR_FIXED_LENGTH_OFF   8
 #define CATALOG_DISK_REPR_N_VARIABLE_OFF     12
-#define CATALOG_DISK_REPR_RESERVED_1_OFF     16	/* reserved for future use */
+#define CATALOG_DISK_REPR_FLAGS_OFF          16	/* zero in representations stored by older releases */
 #define CATALOG_DISK_REPR_SIZE               56
 
 /* Each disk attribute is aligned with MAX_ALIGNMENT
@@ -110,6 +110,9 @@ static int rv;
 #define CATALOG_DISK_ATTR_POSITION_OFF   16
 #define CATALOG_DISK_ATTR_CLASSOID_OFF   20
 #define CATALOG_DISK_ATTR_N_BTSTATS_OFF  28
+#define CATALOG_DISK_ATTR_NDV_OFF        32	/* valid only with CATALOG_REPR_HAS_COLUMN_STATS */
+#define CATALOG_DISK_ATTR_NULL_COUNT_OFF 36	/* valid only with CATALOG_REPR_HAS_COLUMN_STATS */
+#define CATALOG_DISK_ATTR_N_BOUNDS_OFF   40	/* valid only with CATALOG_REPR_HAS_COLUMN_STATS */
 #define CATALOG_DISK_ATTR_SIZE           80
 
 #define CATALOG_BT_STATS_BTID_OFF        0
@@ -317,9 +320,14 @@ static int catalog_store_btree_statistics (THREAD_ENTRY * thread_p, BTREE_STATS
 static int catalog_get_record_from_page (THREAD_ENTRY * thread_p, CATALOG_RECORD * ct_recordp);
 static int catalog_fetch_disk_representation (THREAD_ENTRY * thread_p, DISK_REPR * disk_reprp,
 					      CATALOG_RECORD * ct_recordp);
-static int catalog_fetch_disk_attribute (THREAD_ENTRY * thread_p, DISK_ATTR * disk_attrp, CATALOG_RECORD * ct_recordp);
+static int catalog_fetch_disk_attribute (THREAD_ENTRY * thread_p, DISK_ATTR * disk_attrp, CATALOG_RECORD * ct_recordp,
+					 bool has_column_stats);
 static int catalog_fetch_attribute_value (THREAD_ENTRY * thread_p, void *value, int length,
 					  CATALOG_RECORD * ct_recordp);
+static int catalog_store_histogram_bounds (THREAD_ENTRY * thread_p, DISK_ATTR * disk_attrp,
+					   CATALOG_RECORD * ct_recordp, PGSLOTID * remembered_slotid);
+static int catalog_fetch_histogram_bounds (THREAD_ENTRY * thread_p, DISK_ATTR * disk_attrp,
+					   CATALOG_RECORD * ct_recordp);
 static int catalog_fetch_btree_statistics (THREAD_ENTRY * thread_p, BTREE_STATS * bt_statsp,
 					   CATALOG_RECORD * ct_recordp);
 static int catalog_drop_disk_representation_from_page (THREAD_ENTRY * thread_p, VPID * page_id, PGSLOTID slot_id);
@@ -363,7 +371,7 @@ static void catalog_clear_hash_table (THREAD_ENTRY * thread_p);
 static void catalog_put_page_header (char *rec_p, CATALOG_PAGE_HEADER * header_p);
 static void catalog_get_disk_representation (DISK_REPR * disk_repr_p, char *rec_p);
 static void catalog_put_disk_representation (char *rec_p, DISK_REPR * disk_repr_p);
-static void catalog_get_disk_attribute (DISK_ATTR * attr_p, char *rec_p);
+static void catalog_get_disk_attribute (DISK_ATTR * attr_p, char *rec_p, bool has_column_stats);
 static void catalog_put_disk_attribute (char *rec_p, DISK_ATTR * attr_p);
 static void catalog_put_btree_statistics (char *rec_p, BTREE_STATS * stat_p);
 static void catalog_get_class_info_from_record (CLS_INFO * class_info_p, char *rec_p);
@@ -371,7 +379,7 @@ static void catalog_put_class_info_to_record (char *rec_p, CLS_INFO * class_info
 static void catalog_get_repr_item_from_record (CATALOG_REPR_ITEM * item_p, char *rec_p);
 static void catalog_put_repr_item_to_record (char *rec_p, CATALOG_REPR_ITEM * item_p);
 static int catalog_assign_attribute (THREAD_ENTRY * thread_p, DISK_ATTR * disk_attr_p,
-				     CATALOG_RECORD * catalog_record_p);
+				     CATALOG_RECORD * catalog_record_p, bool has_column_stats);
 
 #if defined (SA_MODE)
 static int catalog_file_map_is_empty (THREAD_ENTRY * thread_p, PAGE_PTR * page, bool * stop, void *args);
@@ -397,10 +405,7 @@ catalog_get_disk_representation (DISK_REPR * disk_repr_p, char *rec_p)
   disk_repr_p->fixed_length = OR_GET_INT (rec_p + CATALOG_DISK_REPR_FIXED_LENGTH_OFF);
   disk_repr_p->n_variable = OR_GET_INT (rec_p + CATALOG_DISK_REPR_N_VARIABLE_OFF);
   disk_repr_p->variable = NULL;
-
-#if 0				/* reserved for future use */
-  disk_repr_p->repr_reserved_1 = OR_GET_INT (rec_p + CATALOG_DISK_REPR_RESERVED_1_OFF);
-#endif
+  disk_repr_p->flags = OR_GET_INT (rec_p + CATALOG_DISK_REPR_FLAGS_OFF);
 }
 
 static void
@@ -411,13 +416,12 @@ catalog_put_disk_representation (char *rec_p, DISK_REPR * disk_repr_p)
   OR_PUT_INT (rec_p + CATALOG_DISK_REPR_FIXED_LENGTH_OFF, disk_repr_p->fixed_length);
   OR_PUT_INT (rec_p + CATALOG_DISK_REPR_N_VARIABLE_OFF, disk_repr_p->n_variable);
 
-#if 1				/* reserved for future use */
-  OR_PUT_INT (rec_p + CATALOG_DISK_REPR_RESERVED_1_OFF, 0);
-#endif
+  /* every attribute stored from now on carries column statistics, even if they are all zero */
+  OR_PUT_INT (rec_p + CATALOG_DISK_REPR_FLAGS_OFF, CATALOG_REPR_HAS_COLUMN_STATS);
 }
 
 static void
-catalog_get_disk_attribute (DISK_ATTR * attr_p, char *rec_p)
+catalog_get_disk_attribute (DISK_ATTR * attr_p, char *rec_p, bool has_column_stats)
 {
   attr_p->id = OR_GET_INT (rec_p + CATALOG_DISK_ATTR_ID_OFF);
   attr_p->location = OR_GET_INT (rec_p + CATALOG_DISK_ATTR_LOCATION_OFF);
@@ -428,6 +432,20 @@ catalog_get_disk_attribute (DISK_ATTR * attr_p, char *rec_p)
   OR_GET_OID (rec_p + CATALOG_DISK_ATTR_CLASSOID_OFF, &attr_p->classoid);
   attr_p->n_btstats = OR_GET_INT (rec_p + CATALOG_DISK_ATTR_N_BTSTATS_OFF);
   attr_p->bt_stats = NULL;
+
+  if (has_column_stats)
+    {
+      attr_p->ndv = OR_GET_INT (rec_p + CATALOG_DISK_ATTR_NDV_OFF);
+      attr_p->null_count = OR_GET_INT (rec_p + CATALOG_DISK_ATTR_NULL_COUNT_OFF);
+      attr_p->n_bounds = OR_GET_INT (rec_p + CATALOG_DISK_ATTR_N_BOUNDS_OFF);
+    }
+  else
+    {
+      attr_p->ndv = 0;
+      attr_p->null_count = 0;
+      attr_p->n_bounds = 0;
+    }
+  attr_p->bounds = NULL;
 }
 
 static void
@@ -465,6 +483,11 @@ catalog_put_disk_attribute (char *rec_p, DISK_ATTR * attr_p)
 
   OR_PUT_OID (rec_p + CATALOG_DISK_ATTR_CLASSOID_OFF, &attr_p->classoid);
   OR_PUT_INT (rec_p + CATALOG_DISK_ATTR_N_BTSTATS_OFF, attr_p->n_btstats);
+
+  assert (attr_p->n_bounds >= 0 && attr_p->n_bounds <= STATS_HISTOGRAM_MAX_BOUNDS);
+  OR_PUT_INT (rec_p + CATALOG_DISK_ATTR_NDV_OFF, attr_p->ndv);
+  OR_PUT_INT (rec_p + CATALOG_DISK_ATTR_NULL_COUNT_OFF, attr_p->null_count);
+  OR_PUT_INT (rec_p + CATALOG_DISK_ATTR_N_BOUNDS_OFF, attr_p->n_bounds);
 }
 
 static void
@@ -842,6 +865,11 @@ catalog_free_representation (DISK_REPR * repr_p)
 	      db_private_free_and_init (NULL, attr_p->value);
 	    }
 
+	  if (attr_p->bounds != NULL)
+	    {
+	      db_private_free_and_init (NULL, attr_p->bounds);
+	    }
+
 	  if (attr_p->bt_stats != NULL)
 	    {
 	      for (j = 0; j < attr_p->n_btstats; j++)
@@ -1402,19 +1430,22 @@ catalog_fetch_disk_representation (THREAD_ENTRY * thread_p, DISK_REPR * disk_rep
  *   return: NO_ERROR or ER_FAILED
  *   disk_attrp(in): pointer to DISK_ATTR structure (disk representation)
  *   ct_recordp(in): pointer to CATALOG_RECORD structure (catalog record)
+ *   has_column_stats(in): true if the stored attribute carries column statistics
  *
  * Note: Transforms catalog disk form into disk representation form.
  * Fetch DISK_ATTR structure from catalog record.
  */
 static int
-catalog_fetch_disk_attribute (THREAD_ENTRY * thread_p, DISK_ATTR * disk_attr_p, CATALOG_RECORD * catalog_record_p)
+catalog_fetch_disk_attribute (THREAD_ENTRY * thread_p, DISK_ATTR * disk_attr_p, CATALOG_RECORD * catalog_record_p,
+			      bool has_column_stats)
 {
   if (catalog_read_unread_portion (thread_p, catalog_record_p, CATALOG_DISK_ATTR_SIZE) != NO_ERROR)
     {
       return ER_FAILED;
     }
 
-  catalog_get_disk_attribute (disk_attr_p, catalog_record_p->recdes.data + catalog_record_p->offset);
+  catalog_get_disk_attribute (disk_attr_p, catalog_record_p->recdes.data + catalog_record_p->offset,
+			      has_column_stats);
   catalog_record_p->offset += CATALOG_DISK_ATTR_SIZE;
 
   return NO_ERROR;
@@ -1475,6 +1506,76 @@ catalog_fetch_attribute_value (THREAD_ENTRY * thread_p, void *value, int length,
   return NO_ERROR;
 }
 
+/*
+ * catalog_store_histogram_bounds () -
+ *   return: NO_ERROR or ER_FAILED
+ *   disk_attrp(in): pointer to DISK_ATTR structure (disk representation)
+ *   ct_recordp(in): pointer to CATALOG_RECORD structure (catalog record)
+ *   remembered_slotid(in):
+ *
+ * Note: The histogram bounds follow the default value of the attribute and are stored as packed doubles.
+ */
+static int
+catalog_store_histogram_bounds (THREAD_ENTRY * thread_p, DISK_ATTR * disk_attr_p, CATALOG_RECORD * catalog_record_p,
+				PGSLOTID * remembered_slot_id_p)
+{
+  char buf[STATS_HISTOGRAM_MAX_BOUNDS * OR_DOUBLE_SIZE];
+  int i;
+
+  assert (disk_attr_p->n_bounds >= 0 && disk_attr_p->n_bounds <= STATS_HISTOGRAM_MAX_BOUNDS);
+  if (disk_attr_p->n_bounds == 0)
+    {
+      return NO_ERROR;
+    }
+
+  for (i = 0; i < disk_attr_p->n_bounds; i++)
+    {
+      OR_PUT_DOUBLE (buf + (OR_DOUBLE_SIZE * i), &disk_attr_p->bounds[i]);
+    }
+
+  return catalog_store_attribute_value (thread_p, buf, disk_attr_p->n_bounds * OR_DOUBLE_SIZE, catalog_record_p,
+					remembered_slot_id_p);
+}
+
+/*
+ * catalog_fetch_histogram_bounds () -
+ *   return: NO_ERROR or ER_FAILED
+ *   disk_attrp(in/out): pointer to DISK_ATTR structure (disk representation)
+ *   ct_recordp(in): pointer to CATALOG_RECORD structure (catalog record)
+ */
+static int
+catalog_fetch_histogram_bounds (THREAD_ENTRY * thread_p, DISK_ATTR * disk_attr_p, CATALOG_RECORD * catalog_record_p)
+{
+  char buf[STATS_HISTOGRAM_MAX_BOUNDS * OR_DOUBLE_SIZE];
+  int i;
+
+  if (disk_attr_p->n_bounds <= 0 || disk_attr_p->n_bounds > STATS_HISTOGRAM_MAX_BOUNDS)
+    {
+      assert (disk_attr_p->n_bounds == 0);
+      disk_attr_p->n_bounds = 0;
+      return NO_ERROR;
+    }
+
+  if (catalog_fetch_attribute_value (thread_p, buf, disk_attr_p->n_bounds * OR_DOUBLE_SIZE, catalog_record_p) !=
+      NO_ERROR)
+    {
+      return ER_FAILED;
+    }
+
+  disk_attr_p->bounds = (double *) db_private_alloc (thread_p, disk_attr_p->n_bounds * sizeof (double));
+  if (disk_attr_p->bounds == NULL)
+    {
+      return ER_FAILED;
+    }
+
+  for (i = 0; i < disk_attr_p->n_bounds; i++)
+    {
+      OR_GET_DOUBLE (buf + (OR_DOUBLE_SIZE * i), &disk_attr_p->bounds[i]);
+    }
+
+  return NO_ERROR;
+}
+
 /*
  * catalog_fetch_btree_statistics () -
  *   return: NO_ERROR or ER_FAILED
@@ -2522,6 +2623,23 @@ catalog_copy_disk_attributes (DISK_ATTR * new_attrs_p, int new_attr_count, DISK_
 
 	  catalog_copy_btree_statistic (new_attr_p->bt_stats, new_attr_p->n_btstats, pre_attr_p->bt_stats,
 					pre_attr_p->n_btstats);
+
+	  /* column statistics are meaningless once the attribute changed its type */
+	  if (new_attr_p->type == pre_attr_p->type && new_attr_p->bounds == NULL)
+	    {
+	      new_attr_p->ndv = pre_attr_p->ndv;
+	      new_attr_p->null_count = pre_attr_p->null_count;
+	      if (pre_attr_p->n_bounds > 0)
+		{
+		  /* the new representation comes from orc_diskrep_from_record and is freed by orc_free_diskrep */
+		  new_attr_p->bounds = (double *) malloc (pre_attr_p->n_bounds * sizeof (double));
+		  if (new_attr_p->bounds != NULL)
+		    {
+		      memcpy (new_attr_p->bounds, pre_attr_p->bounds, pre_attr_p->n_bounds * sizeof (double));
+		      new_attr_p->n_bounds = pre_attr_p->n_bounds;
+		    }
+		}
+	    }
 	}
     }
 }
@@ -2762,6 +2880,7 @@ catalog_sum_disk_attribute_size (DISK_ATTR * attrs_p, int count)
     {
       size += CATALOG_DISK_ATTR_SIZE;
       size += disk_attrp->val_length + (MAX_ALIGNMENT * 2);
+      size += disk_attrp->n_bounds * OR_DOUBLE_SIZE;
       for (j = 0; j < disk_attrp->n_btstats; j++)
 	{
 	  size += CATALOG_BT_STATS_SIZE;
@@ -2926,6 +3045,18 @@ catalog_add_representation (THREAD_ENTRY * thread_p, OID * class_id_p, REPR_ID r
 	  return error_code;
 	}
 
+      if (catalog_store_histogram_bounds (thread_p, disk_attr_p, &catalog_record, &remembered_slot_id) != NO_ERROR)
+	{
+	  db_private_free_and_init (thread_p, data);
+
+	  ASSERT_ERROR_AND_SET (error_code);
+	  if (do_end_access)
+	    {
+	      catalog_end_access_with_dir_oid (thread_p, catalog_access_info_p, ER_FAILED);
+	    }
+	  return error_code;
+	}
+
       for (j = 0; j < disk_attr_p->n_btstats; j++)
 	{
 	  btree_stats_p = &disk_attr_p->bt_stats[j];
@@ -3764,14 +3895,16 @@ catalog_fixup_missing_disk_representation (THREAD_ENTRY * thread_p, OID * class_
  *   return: NO_ERROR or ER_FAILED
  *   disk_attrp(in): pointer to DISK_ATTR structure (disk representation)
  *   catalog_record_p(in): pointer to CATALOG_RECORD structure (catalog record)
+ *   has_column_stats(in): true if the stored attribute carries column statistics
  */
 static int
-catalog_assign_attribute (THREAD_ENTRY * thread_p, DISK_ATTR * disk_attr_p, CATALOG_RECORD * catalog_record_p)
+catalog_assign_attribute (THREAD_ENTRY * thread_p, DISK_ATTR * disk_attr_p, CATALOG_RECORD * catalog_record_p,
+			  bool has_column_stats)
 {
   BTREE_STATS *btree_stats_p;
   int i, n_btstats;
 
-  if (catalog_fetch_disk_attribute (thread_p, disk_attr_p, catalog_record_p) != NO_ERROR)
+  if (catalog_fetch_disk_attribute (thread_p, disk_attr_p, catalog_record_p, has_column_stats) != NO_ERROR)
     {
       return ER_FAILED;
     }
@@ -3791,6 +3924,11 @@ catalog_assign_attribute (THREAD_ENTRY * thread_p, DISK_ATTR * disk_attr_p, CATA
       return ER_FAILED;
     }
 
+  if (catalog_fetch_histogram_bounds (thread_p, disk_attr_p, catalog_record_p) != NO_ERROR)
+    {
+      return ER_FAILED;
+    }
+
   n_btstats = disk_attr_p->n_btstats;
   if (n_btstats > 0)
     {
@@ -4001,7 +4139,8 @@ catalog_get_representation (THREAD_ENTRY * thread_p, OID * class_id_p, REPR_ID r
 
   for (i = 0; i < disk_repr_p->n_fixed; i++)
     {
-      if (catalog_assign_attribute (thread_p, &disk_repr_p->fixed[i], &catalog_record) != NO_ERROR)
+      if (catalog_assign_attribute (thread_p, &disk_repr_p->fixed[i], &catalog_record,
+				    (disk_repr_p->flags & CATALOG_REPR_HAS_COLUMN_STATS) != 0) != NO_ERROR)
 	{
 	  goto exit_on_error;
 	}
@@ -4009,7 +4148,8 @@ catalog_get_representation (THREAD_ENTRY * thread_p, OID * class_id_p, REPR_ID r
 
   for (i = 0; i < disk_repr_p->n_variable; i++)
     {
-      if (catalog_assign_attribute (thread_p, &disk_repr_p->variable[i], &catalog_record) != NO_ERROR)
+      if (catalog_assign_attribute (thread_p, &disk_repr_p->variable[i], &catalog_record,
+				    (disk_repr_p->flags & CATALOG_REPR_HAS_COLUMN_STATS) != 0) != NO_ERROR)
 	{
 	  goto exit_on_error;
 	}
@@ -4851,6 +4991,9 @@ catalog_dump_disk_attribute (DISK_ATTR * attr_p)
       fprintf (stdout, " \n");
     }
 
+  fprintf (stdout, " Distinct values: %d , Nulls: %d , Histogram bounds: %d\n", attr_p->ndv, attr_p->null_count,
+	   attr_p->n_bounds);
+
   fprintf (stdout, " BTree statistics:\n");
 
   for (k = 0; k < attr_p->n_btstats; k++)
@@ -72,11 +72,12 @@ struct disk_representation
   int fixed_length;		/* total length of fixed attributes */
   int n_variable;		/* number of variable attributes */
   struct disk_attribute *variable;	/* variable attribute structures */
-#if 0				/* reserved for future use */
-  int repr_reserved_1;
-#endif
+  int flags;			/* CATALOG_REPR_* flags of the stored representation */
 };				/* object disk representation */
 
+/* the attributes of the representation carry column statistics (ndv, null count and histogram) */
+#define CATALOG_REPR_HAS_COLUMN_STATS   0x1
+
 
 
 
@@ -93,6 +94,10 @@ struct disk_attribute
   OID classoid;			/* source class object id */
   int n_btstats;		/* number of B+tree statistics information */
   BTREE_STATS *bt_stats;	/* pointer to array of BTREE_STATS; BTREE_STATS[n_btstats] */
+  int ndv;			/* estimated number of distinct non-null values; 0 if unknown */
+  int null_count;		/* estimated number of null values */
+  int n_bounds;			/* number of equi-depth histogram bounds; 0 if no histogram */
+  double *bounds;		/* histogram bounds; double[n_bounds] */
 };				/* disk attribute structure */
 
 typedef struct cls_info CLS_INFO;
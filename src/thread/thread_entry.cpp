@@ -81,6 +81,7 @@ namespace cubthread
     , emulate_tid ()
     , client_id (-1)
     , tran_index (NULL_TRAN_INDEX)
+    , is_tran_shared (false)
     , private_lru_index (-1)
     , tran_index_lock ()
     , rid (0)
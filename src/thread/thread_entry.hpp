@@ -214,6 +214,8 @@ namespace cubthread
 				   * thread */
       int client_id;		/* client id whom this thread is responding */
       int tran_index;		/* tran index to which this thread belongs */
+      bool is_tran_shared;	/* works for the transaction of another thread (a parallel worker); may only read on
+				 * its behalf */
       int private_lru_index;	/* private lru index when transaction quota is used */
       pthread_mutex_t tran_index_lock;
       unsigned int rid;		/* request id which this thread is processing */
@@ -437,6 +439,30 @@ thread_set_sort_stats_active (cubthread::entry *thread_p, bool new_flag)
   return old_flag;
 }
 
+/*
+ * a parallel worker shares the transaction of the thread that handed it work: it reads with the snapshot that thread
+ * took and is interrupted with it, but it must not change the transaction (no locks, no logging, no new snapshot).
+ * see logtb_check_tran_owner.
+ */
+inline void
+thread_share_tran (cubthread::entry *thread_p, int tran_index)
+{
+  thread_p->tran_index = tran_index;
+  thread_p->is_tran_shared = true;
+}
+
+inline void
+thread_end_share_tran (cubthread::entry *thread_p)
+{
+  thread_p->is_tran_shared = false;
+}
+
+inline bool
+thread_is_tran_shared (cubthread::entry *thread_p)
+{
+  return thread_p->is_tran_shared;
+}
+
 inline void
 thread_lock_entry (cubthread::entry *thread_p)
 {
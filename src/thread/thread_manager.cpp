@@ -141,7 +141,7 @@ namespace cubthread
   entry_workpool *
   manager::create_worker_pool (size_t pool_size, size_t task_max_count, const char *name,
 			       entry_manager *context_manager, std::size_t core_count, bool debug_logging,
-			       bool pool_threads, wait_seconds wait_for_task_time)
+			       bool pool_threads, wait_seconds wait_for_task_time, bool work_stealing)
   {
 #if defined (SERVER_MODE)
     if (is_single_thread ())
@@ -156,7 +156,7 @@ namespace cubthread
 	  }
 	// reserve pool_size entries and add to m_worker_pools
 	return create_and_track_resource (m_worker_pools, pool_size, pool_size, task_max_count, *context_manager,
-					  name, core_count, debug_logging, pool_threads, wait_for_task_time);
+					  name, core_count, debug_logging, pool_threads, wait_for_task_time, work_stealing);
       }
 #else // not SERVER_MODE = SA_MODE
     return NULL;
@@ -120,7 +120,7 @@ namespace cubthread
       entry_workpool *create_worker_pool (std::size_t pool_size, std::size_t task_max_count, const char *name,
 					  entry_manager *context_manager, std::size_t core_count,
 					  bool debug_logging, bool pool_threads = false,
-					  wait_seconds wait_for_task_time = std::chrono::seconds (5));
+					  wait_seconds wait_for_task_time = std::chrono::seconds (5), bool work_stealing = false);
 
       // destroy worker pool
       void destroy_worker_pool (entry_workpool *&worker_pool_arg);
@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/*
+ * thread_task_group.hpp
+ */
+
+#ifndef _THREAD_TASK_GROUP_HPP_
+#define _THREAD_TASK_GROUP_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <cassert>
+
+namespace cubthread
+{
+  // cubthread::task_group<Context>
+  //
+  //  templates
+  //    Context - thread context; cubthread::entry in CUBRID
+  //
+  //  description
+  //    the tasks one thread (the owner) hands over to the workers of a worker pool, without ever depending on those
+  //    workers to make progress.
+  //
+  //    a handed over task is queued until a worker claims it. the owner never waits for a task that no worker has
+  //    claimed: it claims and runs such tasks itself (run_oldest_queued, run_queued) or cancels them (cancel_queued),
+  //    and waits only for the tasks that workers claimed (wait_claimed). a saturated worker pool makes the work
+  //    slower, it never blocks it.
+  //
+  // how to use
+  //    // push is called by hand_over, on the owner thread; it must eventually call the task with the context of a
+  //    // worker. the task may be called after the group is destroyed; it returns at once then.
+  //    cubthread::task_group<entry> group ([] (const task_group<entry>::task_func & task)
+  //      {
+  //        push_to_some_pool (new entry_callable_task (task));
+  //      });
+  //
+  //    for (...)
+  //      {
+  //        group.hand_over (std::bind (do_work, std::placeholders::_1, work_item));
+  //      }
+  //    do_own_share_of_work ();
+  //    group.run_queued (owner_context);   // or cancel_queued () if only the claimed ones matter
+  //    group.wait_claimed ();
+  //
+  // implementation
+  //    the state shared with the workers is reference counted; the copies of the task functions pushed to workers
+  //    hold a reference. a task is claimed under the mutex of the state, by the first of the owner and the worker;
+  //    the other one finds it claimed (or cancelled) and forgets about it. the destructor cancels the queued tasks
+  //    and waits for the claimed ones, so nothing a task refers to is touched after the group is destroyed.
+  //
+  template <typename Context>
+  class task_group
+  {
+    public:
+      using context_type = Context;
+      // a task; it gets the context of the thread that runs it, a worker or the owner
+      using task_func = std::function<void (context_type &)>;
+      // hand over a task to a worker
+      using push_func = std::function<void (const task_func &)>;
+
+      explicit task_group (const push_func &push);
+      task_group (const task_group &) = delete;
+      task_group &operator= (const task_group &) = delete;
+      ~task_group ();
+
+      // queue task and push it to a worker
+      void hand_over (const task_func &task);
+
+      // claim the oldest task no worker has claimed yet and run it on this thread; false if there is none
+      bool run_oldest_queued (context_type &context);
+      // run all tasks no worker has claimed yet on this thread
+      void run_queued (context_type &context);
+      // drop all tasks no worker has claimed yet; returns their count
+      std::size_t cancel_queued ();
+      // wait until the tasks claimed by workers are finished
+      void wait_claimed ();
+
+      // tasks handed over and not claimed yet
+      std::size_t get_queued_count ();
+      // tasks claimed by workers so far, running or finished
+      std::size_t get_worker_claimed_count ();
+
+    private:
+      enum class task_status
+      {
+	QUEUED,
+	RUNNING,
+	DONE,
+	CANCELLED
+      };
+
+      struct shared_state
+      {
+	std::mutex m_mutex;
+	std::condition_variable m_cond;		// notified when m_running drops to zero
+	std::vector<task_status> m_status;	// of each task, by the order it was handed over
+	std::vector<task_func> m_tasks;		// emptied when claimed or cancelled
+	std::size_t m_oldest_queued;		// tasks before it are not queued
+	std::size_t m_queued;
+	std::size_t m_running;			// claimed by workers, not finished
+	std::size_t m_worker_claimed;
+      };
+
+      static void execute_handed_over (const std::shared_ptr<shared_state> &state, context_type &context,
+				       std::size_t task_id);
+      static bool claim (shared_state &state, std::size_t task_id, task_func &task);
+
+      std::shared_ptr<shared_state> m_state;
+      push_func m_push;
+  };
+
+  /************************************************************************/
+  /* template implementation                                              */
+  /************************************************************************/
+
+  template <typename Context>
+  task_group<Context>::task_group (const push_func &push)
+    : m_state (std::make_shared<shared_state> ())
+    , m_push (push)
+  {
+    m_state->m_oldest_queued = 0;
+    m_state->m_queued = 0;
+    m_state->m_running = 0;
+    m_state->m_worker_claimed = 0;
+  }
+
+  template <typename Context>
+  task_group<Context>::~task_group ()
+  {
+    (void) cancel_queued ();
+    wait_claimed ();
+  }
+
+  template <typename Context>
+  void
+  task_group<Context>::hand_over (const task_func &task)
+  {
+    std::shared_ptr<shared_state> state = m_state;
+    std::size_t task_id;
+
+    {
+      std::unique_lock<std::mutex> ulock (m_state->m_mutex);
+      task_id = m_state->m_status.size ();
+      m_state->m_status.push_back (task_status::QUEUED);
+      m_state->m_tasks.push_back (task);
+      m_state->m_queued++;
+    }
+
+    m_push ([state, task_id] (context_type & context)
+    {
+      execute_handed_over (state, context, task_id);
+    });
+  }
+
+  template <typename Context>
+  bool
+  task_group<Context>::run_oldest_queued (context_type &context)
+  {
+    task_func task;
+    std::size_t task_id;
+
+    {
+      std::unique_lock<std::mutex> ulock (m_state->m_mutex);
+
+      while (m_state->m_oldest_queued < m_state->m_status.size ()
+	     && m_state->m_status[m_state->m_oldest_queued] != task_status::QUEUED)
+	{
+	  m_state->m_oldest_queued++;
+	}
+      if (m_state->m_oldest_queued == m_state->m_status.size ())
+	{
+	  return false;
+	}
+
+      task_id = m_state->m_oldest_queued;
+      // the worker of this task will find it claimed and exit
+      (void) claim (*m_state, task_id, task);
+    }
+
+    task (context);
+
+    std::unique_lock<std::mutex> ulock (m_state->m_mutex);
+    m_state->m_status[task_id] = task_status::DONE;
+    return true;
+  }
+
+  template <typename Context>
+  void
+  task_group<Context>::run_queued (context_type &context)
+  {
+    while (run_oldest_queued (context))
+      {
+	;
+      }
+  }
+
+  template <typename Context>
+  std::size_t
+  task_group<Context>::cancel_queued ()
+  {
+    std::unique_lock<std::mutex> ulock (m_state->m_mutex);
+    std::size_t cancelled = 0;
+
+    for (std::size_t i = m_state->m_oldest_queued; i < m_state->m_status.size (); i++)
+      {
+	if (m_state->m_status[i] == task_status::QUEUED)
+	  {
+	    m_state->m_status[i] = task_status::CANCELLED;
+	    m_state->m_tasks[i] = nullptr;
+	    cancelled++;
+	  }
+      }
+    assert (cancelled == m_state->m_queued);
+    m_state->m_queued = 0;
+    m_state->m_oldest_queued = m_state->m_status.size ();
+
+    return cancelled;
+  }
+
+  template <typename Context>
+  void
+  task_group<Context>::wait_claimed ()
+  {
+    std::unique_lock<std::mutex> ulock (m_state->m_mutex);
+    m_state->m_cond.wait (ulock, [this] { return m_state->m_running == 0; });
+  }
+
+  template <typename Context>
+  std::size_t
+  task_group<Context>::get_queued_count ()
+  {
+    std::unique_lock<std::mutex> ulock (m_state->m_mutex);
+    return m_state->m_queued;
+  }
+
+  template <typename Context>
+  std::size_t
+  task_group<Context>::get_worker_claimed_count ()
+  {
+    std::unique_lock<std::mutex> ulock (m_state->m_mutex);
+    return m_state->m_worker_claimed;
+  }
+
+  //
+  // execute_handed_over () - run a task on a worker, unless the owner has claimed or cancelled it first
+  //
+  template <typename Context>
+  void
+  task_group<Context>::execute_handed_over (const std::shared_ptr<shared_state> &state, context_type &context,
+      std::size_t task_id)
+  {
+    task_func task;
+
+    {
+      std::unique_lock<std::mutex> ulock (state->m_mutex);
+      if (!claim (*state, task_id, task))
+	{
+	  return;
+	}
+      state->m_running++;
+      state->m_worker_claimed++;
+    }
+
+    task (context);
+
+    std::unique_lock<std::mutex> ulock (state->m_mutex);
+    state->m_status[task_id] = task_status::DONE;
+    assert (state->m_running > 0);
+    if (--state->m_running == 0)
+      {
+	state->m_cond.notify_all ();
+      }
+  }
+
+  //
+  // claim () - claim a queued task; the mutex of the state must be locked
+  //
+  template <typename Context>
+  bool
+  task_group<Context>::claim (shared_state &state, std::size_t task_id, task_func &task)
+  {
+    if (state.m_status[task_id] != task_status::QUEUED)
+      {
+	return false;
+      }
+
+    state.m_status[task_id] = task_status::RUNNING;
+    task = std::move (state.m_tasks[task_id]);
+    state.m_tasks[task_id] = nullptr;
+    assert (state.m_queued > 0);
+    state.m_queued--;
+    return true;
+  }
+
+} // namespace cubthread
+
+#endif // _THREAD_TASK_GROUP_HPP_
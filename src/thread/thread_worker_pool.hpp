@@ -125,6 +125,19 @@ namespace cubthread
   //          note: 3.2. and 3.3. together is an atomic operation (protected by mutex)
   //          Worker stops if waiting for new task times out (and becomes inactive).
   //
+  //    work stealing (optional, set on construction):
+  //
+  //      without it, a task queued on a core waits for a worker of that core, even if workers of other cores are
+  //      free. with work stealing, cores are only a preference:
+  //          - a worker that finds no task in its core queue takes the oldest task queued on another core, before
+  //            becoming available.
+  //          - a task that is queued on a core is handed to an available worker of another core, if there is one.
+  //      the pool counts queued tasks and available workers. a pusher queues its task before it checks for available
+  //      workers and a worker becomes available before it checks for queued tasks, so at least one of them sees the
+  //      other and no task is left in queue while a worker waits.
+  //      cores are locked one at a time, so stealing does not need a lock order. note that tasks that must run on a
+  //      given core (e.g. because each core has one worker and their order matters) need a pool without stealing.
+  //
   //    NOTE: core class is private nested to worker pool and cannot be instantiated outside it.
   //          worker class is private nested to core class.
   //
@@ -144,7 +157,7 @@ namespace cubthread
 
       worker_pool (std::size_t pool_size, std::size_t task_max_count, context_manager_type &context_mgr,
 		   const char *name, std::size_t core_count = 1, bool debug_logging = false, bool pool_threads = false,
-		   wait_seconds wait_for_task_time = std::chrono::seconds (5));
+		   wait_seconds wait_for_task_time = std::chrono::seconds (5), bool work_stealing = false);
       ~worker_pool ();
 
       // try to execute task; executes only if the maximum number of tasks is not reached.
@@ -158,6 +171,8 @@ namespace cubthread
       // note: regular execute chooses a core through round robin scheduling. this may not be a good fit for all
       //       execution patterns.
       //       execute_on_core provides control on core scheduling.
+      //       if pool does work stealing, the core is only an affinity hint: task is queued there if the core has no
+      //       available worker, but it may then be executed by a worker of another core.
       void execute_on_core (task_type *work_arg, std::size_t core_hash);
 
       // stop worker pool; stop all running threads; discard any tasks in queue
@@ -189,6 +204,10 @@ namespace cubthread
       {
 	return m_pool_threads;
       }
+      inline bool is_work_stealing () const
+      {
+	return m_work_stealing;
+      }
       inline const wait_seconds &get_wait_for_task_time () const
       {
 	return m_wait_for_task_time;
@@ -233,6 +252,11 @@ namespace cubthread
       // get next core by round robin scheduling
       std::size_t get_round_robin_core_hash (void);
 
+      // work stealing: hand queued tasks to available workers of any core; cores are scanned from start_core
+      void dispatch_queued_tasks (std::size_t start_core);
+      // work stealing: take the oldest task queued on another core than thief_core; NULL if there is none
+      task_type *steal_queued_task (std::size_t thief_core);
+
       // maximum number of concurrent workers
       std::size_t m_max_workers;
 
@@ -261,6 +285,11 @@ namespace cubthread
       wait_seconds m_wait_for_task_time;
 
       std::string m_name;
+
+      // work stealing; counters are only kept if it is enabled
+      bool m_work_stealing;
+      std::atomic<std::size_t> m_queued_task_count;         // tasks queued on all cores
+      std::atomic<std::size_t> m_available_worker_count;    // available workers of all cores
   };
 
   // worker_pool<Context>::core
@@ -298,6 +327,12 @@ namespace cubthread
 
       void start_all_workers (void);
 
+      // work stealing
+      // claim an available worker; NULL if there is none
+      worker *claim_available_worker (void);
+      // claim the oldest queued task; NULL if there is none
+      task_type *claim_queued_task (void);
+
       // statistics
       void get_stats (cubperf::stat_value *sum_inout) const;
 
@@ -328,7 +363,14 @@ namespace cubthread
       core ();
       ~core (void);
 
+      // available workers and queued tasks; caller must hold m_workers_mutex
+      void push_available_worker (worker &worker_arg);
+      worker *pop_available_worker (void);
+      void push_queued_task (task_type *task_p);
+      task_type *pop_queued_task (void);
+
       worker_pool_type *m_parent_pool;                // pointer to parent pool
+      std::size_t m_index;                            // index in parent pool cores
       std::size_t m_max_workers;                      // maximum number of workers running at once
       worker *m_worker_array;                         // all core workers
       worker **m_available_workers;
@@ -442,6 +484,10 @@ namespace cubthread
       {
 	return m_has_thread;
       }
+      core_type &get_core (void)
+      {
+	return *m_parent_core;
+      }
       void set_has_thread (void)
       {
 	m_has_thread = true;
@@ -536,7 +582,8 @@ namespace cubthread
   template <typename Context>
   worker_pool<Context>::worker_pool (std::size_t pool_size, std::size_t task_max_count,
 				     context_manager_type &context_mgr, const char *name, std::size_t core_count,
-				     bool debug_log, bool pool_threads, wait_seconds wait_for_task_time)
+				     bool debug_log, bool pool_threads, wait_seconds wait_for_task_time,
+				     bool work_stealing)
     : m_max_workers (pool_size)
     , m_task_max_count (task_max_count)
     , m_task_count (0)
@@ -549,6 +596,9 @@ namespace cubthread
     , m_pool_threads (pool_threads)
     , m_wait_for_task_time (wait_for_task_time)
     , m_name (name == NULL ? "" : name)
+    , m_work_stealing (work_stealing)
+    , m_queued_task_count (0)
+    , m_available_worker_count (0)
   {
     // initialize cores; we'll try to distribute pool evenly to all cores. if core count is not fully contained in
     // pool size, some cores will have one additional worker
@@ -566,6 +616,12 @@ namespace cubthread
 
     m_core_array = new core[m_core_count];
 
+    if (m_core_count == 1)
+      {
+	// nothing to steal from
+	m_work_stealing = false;
+      }
+
     std::size_t quotient = m_max_workers / m_core_count;
     std::size_t remainder = m_max_workers % m_core_count;
     std::size_t it = 0;
@@ -825,6 +881,64 @@ namespace cubthread
     return index;
   }
 
+  template <typename Context>
+  void
+  worker_pool<Context>::dispatch_queued_tasks (std::size_t start_core)
+  {
+    typename core::worker *worker_p;
+    task_type *task_p;
+    std::size_t it;
+
+    assert (m_work_stealing);
+
+    while (m_queued_task_count > 0 && m_available_worker_count > 0 && !m_stopped)
+      {
+	worker_p = NULL;
+	for (it = 0; it < m_core_count && worker_p == NULL; it++)
+	  {
+	    worker_p = m_core_array[(start_core + it) % m_core_count].claim_available_worker ();
+	  }
+	if (worker_p == NULL)
+	  {
+	    // all were claimed by others; they also take the tasks
+	    return;
+	  }
+
+	task_p = NULL;
+	for (it = 0; it < m_core_count && task_p == NULL; it++)
+	  {
+	    task_p = m_core_array[(start_core + it) % m_core_count].claim_queued_task ();
+	  }
+	if (task_p == NULL)
+	  {
+	    // all were taken by others; the worker is available again, check if new tasks were queued meanwhile
+	    worker_p->get_core ().become_available (*worker_p);
+	    continue;
+	  }
+
+	worker_p->assign_task (task_p, cubperf::clock::now ());
+      }
+  }
+
+  template <typename Context>
+  typename worker_pool<Context>::task_type *
+  worker_pool<Context>::steal_queued_task (std::size_t thief_core)
+  {
+    task_type *task_p;
+
+    assert (m_work_stealing);
+
+    for (std::size_t it = 1; it < m_core_count && m_queued_task_count > 0; it++)
+      {
+	task_p = m_core_array[(thief_core + it) % m_core_count].claim_queued_task ();
+	if (task_p != NULL)
+	  {
+	    return task_p;
+	  }
+      }
+    return NULL;
+  }
+
   //////////////////////////////////////////////////////////////////////////
   // worker_pool::core
   //////////////////////////////////////////////////////////////////////////
@@ -832,6 +946,7 @@ namespace cubthread
   template <typename Context>
   worker_pool<Context>::core::core ()
     : m_parent_pool (NULL)
+    , m_index (0)
     , m_max_workers (0)
     , m_worker_array (NULL)
     , m_available_workers (NULL)
@@ -859,6 +974,7 @@ namespace cubthread
     assert (worker_count > 0);
 
     m_parent_pool = &parent;
+    m_index = this - parent.m_core_array;
     m_max_workers = worker_count;
 
     // allocate workers array
@@ -877,7 +993,7 @@ namespace cubthread
 	else
 	  {
 	    // add to available workers
-	    m_available_workers[m_available_count++] = &m_worker_array[it];
+	    push_available_worker (m_worker_array[it]);
 	  }
       }
   }
@@ -915,7 +1031,7 @@ namespace cubthread
 
     if (m_available_count > 0)
       {
-	refp = m_available_workers[--m_available_count];
+	refp = pop_available_worker ();
 	ulock.unlock ();
 
 	assert (refp != NULL);
@@ -924,7 +1040,15 @@ namespace cubthread
     else
       {
 	// save to queue
-	m_task_queue.push (task_p);
+	push_queued_task (task_p);
+
+	if (m_parent_pool->m_work_stealing)
+	  {
+	    ulock.unlock ();
+
+	    // a worker of another core may be available
+	    m_parent_pool->dispatch_queued_tasks (m_index);
+	  }
       }
   }
 
@@ -933,17 +1057,39 @@ namespace cubthread
   worker_pool<Context>::core::get_task_or_become_available (worker &worker_arg)
   {
     std::unique_lock<std::mutex> ulock (m_workers_mutex);
+    task_type *task_p;
 
     if (!m_task_queue.empty ())
       {
-	task_type *task_p = m_task_queue.front ();
-	assert (task_p != NULL);
-	m_task_queue.pop ();
-	return task_p;
+	return pop_queued_task ();
       }
 
-    m_available_workers[m_available_count++] = &worker_arg;
-    assert (m_available_count <= m_max_workers);
+    if (m_parent_pool->m_work_stealing)
+      {
+	ulock.unlock ();
+
+	// own queue is empty; help cores that have queued tasks before becoming available
+	task_p = m_parent_pool->steal_queued_task (m_index);
+	if (task_p != NULL)
+	  {
+	    return task_p;
+	  }
+
+	ulock.lock ();
+	if (!m_task_queue.empty ())
+	  {
+	    return pop_queued_task ();
+	  }
+
+	push_available_worker (worker_arg);
+	ulock.unlock ();
+
+	// a task may have been queued after it was checked; it may be assigned to this worker too
+	m_parent_pool->dispatch_queued_tasks (m_index);
+	return NULL;
+      }
+
+    push_available_worker (worker_arg);
     return NULL;
   }
 
@@ -952,8 +1098,87 @@ namespace cubthread
   worker_pool<Context>::core::become_available (worker &worker_arg)
   {
     std::unique_lock<std::mutex> ulock (m_workers_mutex);
+    push_available_worker (worker_arg);
+  }
+
+  template <typename Context>
+  typename worker_pool<Context>::core::worker *
+  worker_pool<Context>::core::claim_available_worker (void)
+  {
+    std::unique_lock<std::mutex> ulock (m_workers_mutex);
+
+    if (m_available_count == 0)
+      {
+	return NULL;
+      }
+    return pop_available_worker ();
+  }
+
+  template <typename Context>
+  typename worker_pool<Context>::core::task_type *
+  worker_pool<Context>::core::claim_queued_task (void)
+  {
+    std::unique_lock<std::mutex> ulock (m_workers_mutex);
+
+    if (m_task_queue.empty ())
+      {
+	return NULL;
+      }
+    return pop_queued_task ();
+  }
+
+  template <typename Context>
+  void
+  worker_pool<Context>::core::push_available_worker (worker &worker_arg)
+  {
     m_available_workers[m_available_count++] = &worker_arg;
     assert (m_available_count <= m_max_workers);
+
+    if (m_parent_pool->m_work_stealing)
+      {
+	++m_parent_pool->m_available_worker_count;
+      }
+  }
+
+  template <typename Context>
+  typename worker_pool<Context>::core::worker *
+  worker_pool<Context>::core::pop_available_worker (void)
+  {
+    assert (m_available_count > 0);
+
+    if (m_parent_pool->m_work_stealing)
+      {
+	--m_parent_pool->m_available_worker_count;
+      }
+    return m_available_workers[--m_available_count];
+  }
+
+  template <typename Context>
+  void
+  worker_pool<Context>::core::push_queued_task (task_type *task_p)
+  {
+    m_task_queue.push (task_p);
+
+    if (m_parent_pool->m_work_stealing)
+      {
+	++m_parent_pool->m_queued_task_count;
+      }
+  }
+
+  template <typename Context>
+  typename worker_pool<Context>::core::task_type *
+  worker_pool<Context>::core::pop_queued_task (void)
+  {
+    task_type *task_p = m_task_queue.front ();
+
+    assert (task_p != NULL);
+    m_task_queue.pop ();
+
+    if (m_parent_pool->m_work_stealing)
+      {
+	--m_parent_pool->m_queued_task_count;
+      }
+    return task_p;
   }
 
   template <typename Context>
@@ -1046,7 +1271,7 @@ namespace cubthread
 	  {
 	    break;
 	  }
-	refp = m_available_workers[--m_available_count];
+	refp = pop_available_worker ();
 	core_lock.unlock ();
 
 	if (refp->has_thread ())
@@ -1081,6 +1306,10 @@ namespace cubthread
 
 	// update available count
 	m_available_count += available_stack.get_size ();
+	if (m_parent_pool->m_work_stealing)
+	  {
+	    m_parent_pool->m_available_worker_count += available_stack.get_size ();
+	  }
       }
   }
 
@@ -1092,8 +1321,7 @@ namespace cubthread
 
     while (!m_task_queue.empty ())
       {
-	m_task_queue.front ()->retire ();
-	m_task_queue.pop ();
+	pop_queued_task ()->retire ();
       }
   }
 
@@ -2752,6 +2752,11 @@ boot_restart_server (THREAD_ENTRY * thread_p, bool print_restart, const char *db
       log_set_db_restore_time (thread_p, (INT64) (time (0)));
     }
 
+#if defined(SERVER_MODE)
+  /* load the plans cached before shutdown */
+  xcache_start_load ();
+#endif
+
   /* server status could be changed by css_change_ha_server_state */
   if (boot_Server_status == BOOT_SERVER_DOWN)
     {
@@ -2933,6 +2938,10 @@ xboot_shutdown_server (REFPTR (THREAD_ENTRY, thread_p), ER_FINAL_CODE is_er_fina
   /* before removing temp vols */
   (void) logtb_reflect_global_unique_stats_to_btree (thread_p);
   qfile_finalize_list_cache (thread_p);
+#if defined(SERVER_MODE)
+  /* remember the cached plans to load them back on next restart */
+  (void) xcache_save (thread_p);
+#endif
   xcache_finalize (thread_p);
   fpcache_finalize (thread_p);
   session_states_finalize (thread_p);
@@ -2941,6 +2950,8 @@ xboot_shutdown_server (REFPTR (THREAD_ENTRY, thread_p), ER_FINAL_CODE is_er_fina
 
 #if defined(SERVER_MODE)
   pgbuf_daemons_destroy ();
+  /* remember the buffered pages to warm up the buffer on next restart */
+  pgbuf_save_warmup_list (thread_p);
 #endif
 
 #if defined (SA_MODE)
@@ -3700,6 +3711,7 @@ boot_server_all_finalize (THREAD_ENTRY * thread_p, ER_FINAL_CODE is_er_final,
   (void) heap_manager_finalize ();
   perfmon_finalize ();
   fileio_dismount_all (thread_p);
+  fileio_batch_finalize ();
   disk_manager_final ();
   boot_server_status (BOOT_SERVER_DOWN);
 
@@ -495,6 +495,7 @@ locator_reallocate_copy_area_by_length (LC_COPYAREA * old_area, int new_length)
   new_mobjs->num_objs = old_mobjs->num_objs;
   new_mobjs->start_multi_update = old_mobjs->start_multi_update;
   new_mobjs->end_multi_update = old_mobjs->end_multi_update;
+  new_mobjs->sort_index_keys = old_mobjs->sort_index_keys;
 
   for (i = 0; i < old_mobjs->num_objs; i++)
     {
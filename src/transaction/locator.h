@@ -232,6 +232,7 @@ struct lc_copyarea_manyobjs
   LC_COPYAREA_ONEOBJ objs;
   int start_multi_update;	/* the start of flush request */
   int end_multi_update;		/* the end of flush request */
+  int sort_index_keys;		/* insert index keys in key order after the objects; set by loaddb */
   int num_objs;			/* How many objects */
 };
 
@@ -114,6 +114,9 @@ struct locator_list_keep_mops
 
 static volatile sig_atomic_t lc_Is_siginterrupt = false;
 
+/* set by loaddb: the index keys of flushed objects may be inserted in key order after the objects */
+bool locator_Sort_flush_index_keys = false;
+
 #if defined(CUBRID_DEBUG)
 static void locator_dump_mflush (FILE * out_fp, LOCATOR_MFLUSH_CACHE * mflush);
 #endif /* CUBRID_DEBUG */
@@ -3878,6 +3881,7 @@ locator_mflush_reallocate_copy_area (LOCATOR_MFLUSH_CACHE * mflush, int minsize)
   mflush->mobjs = LC_MANYOBJS_PTR_IN_COPYAREA (mflush->copy_area);
   mflush->mobjs->start_multi_update = 0;
   mflush->mobjs->end_multi_update = 0;
+  mflush->mobjs->sort_index_keys = locator_Sort_flush_index_keys ? 1 : 0;
   mflush->mobjs->num_objs = 0;
   mflush->obj = LC_START_ONEOBJ_PTR_IN_COPYAREA (mflush->mobjs);
   LC_RECDES_IN_COPYAREA (mflush->copy_area, &mflush->recdes);
@@ -75,6 +75,8 @@ typedef enum
   LC_INSTANCE			/* An instance */
 } LC_OBJTYPE;
 
+extern bool locator_Sort_flush_index_keys;
+
 extern bool locator_is_root (MOP mop);
 extern int locator_is_class (MOP mop, DB_FETCH_MODE hint_purpose);
 extern LOCK locator_fetch_mode_to_lock (DB_FETCH_MODE purpose, LC_OBJTYPE type,
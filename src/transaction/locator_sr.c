@@ -34,6 +34,7 @@
 #include "locator_sr.h"
 
 #include "boot_sr.h"
+#include "btree_insert_buffer.hpp"
 #include "btree_load.h"
 #include "critical_section.h"
 #include "dbtype.h"
@@ -81,6 +82,9 @@ static const int LOCATOR_GUESS_NUM_NESTED_REFERENCES = 100;
 
 #define HA_DDL_PROXY_MAX_STATEMENT_LENGTH 2000
 
+/* pages of objects sent to client in one fetch of all instances; fewer round trips for unloaddb and compactdb */
+static const int LOCATOR_FETCH_ALL_AREA_PAGES = 16;
+
 /* flag for INSERT/UPDATE/DELETE statement */
 typedef enum
 {
@@ -183,6 +187,8 @@ static int locator_delete_force_internal (THREAD_ENTRY * thread_p, HFID * hfid,
 					  MVCC_REEV_DATA * mvcc_reev_data, LOCATOR_INDEX_ACTION_FLAG idx_action_flag,
 					  OID * new_obj_oid, OID * partition_oid, bool need_locking);
 static int locator_force_for_multi_update (THREAD_ENTRY * thread_p, LC_COPYAREA * force_area);
+static bool locator_can_buffer_force_keys (THREAD_ENTRY * thread_p, LC_COPYAREA_MANYOBJS * mobjs,
+					   int num_ignore_error);
 
 #if defined(ENABLE_UNUSED_FUNCTION)
 static void locator_increase_catalog_count (THREAD_ENTRY * thread_p, OID * cls_oid);
@@ -2776,11 +2782,16 @@ xlocator_get_class (THREAD_ENTRY * thread_p, OID * class_oid, int class_chn, con
  *   nfetched(out): Current number of object fetched.
  *   last_oid(out): Object identifier of last fetched object
  *   fetch_area(in/out): Pointer to area where the objects are placed
+ *   page_set(in): Pages of the heap to fetch from, sorted by VPID; NULL for the whole heap
+ *   n_page_set(in): Number of pages in page_set
  *
+ * Note: With a page set, the scan ends at the last page of the set (see heap_scancache_set_page_set). The caller
+ *       must send the same set until then.
  */
 int
 xlocator_fetch_all (THREAD_ENTRY * thread_p, const HFID * hfid, LOCK * lock, LC_FETCH_VERSION_TYPE fetch_version_type,
-		    OID * class_oid, int *nobjects, int *nfetched, OID * last_oid, LC_COPYAREA ** fetch_area)
+		    OID * class_oid, int *nobjects, int *nfetched, OID * last_oid, LC_COPYAREA ** fetch_area,
+		    const VPID * page_set, int n_page_set)
 {
   LC_COPYAREA_DESC prefetch_des;	/* Descriptor for decache of objects related to transaction isolation level */
   LC_COPYAREA_MANYOBJS *mobjs;	/* Describe multiple objects in area */
@@ -2879,9 +2890,13 @@ xlocator_fetch_all (THREAD_ENTRY * thread_p, const HFID * hfid, LOCK * lock, LC_
 
       goto error;
     }
+  if (n_page_set > 0)
+    {
+      heap_scancache_set_page_set (&scan_cache, page_set, n_page_set);
+    }
 
-  /* Assume that the next object can fit in one page */
-  copyarea_length = DB_PAGESIZE;
+  /* Assume that the next objects can fit in a few pages */
+  copyarea_length = LOCATOR_FETCH_ALL_AREA_PAGES * DB_PAGESIZE;
 
   while (true)
     {
@@ -4010,6 +4025,92 @@ locator_end_force_scan_cache (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cac
   heap_scancache_end_modify (thread_p, scan_cache);
 }
 
+/*
+ * locator_start_insert_buffer () - buffer the index keys of the rows inserted with scan cache, to insert them into
+ *				    each index in key order
+ *
+ * return: NO_ERROR if all OK, ER_ status otherwise
+ *
+ *   scan_cache(in/out): scan cache started for MULTI_ROW_INSERT, or for the single row inserts of a flush
+ *   class_oid(in): class of inserted rows
+ *
+ * Note: Keys are inserted by locator_flush_insert_buffer (), which must be called before the statement ends. Only
+ *	 keys of non-unique indexes are buffered. Nothing is buffered if the class has indexes that are looked up while
+ *	 rows are inserted (foreign keys) or indexes being loaded online, or if btree_insert_buffer_size is 0.
+ */
+int
+locator_start_insert_buffer (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache, const OID * class_oid)
+{
+  OR_CLASSREP *classrepr = NULL;
+  int classrepr_cacheindex = -1;
+  int max_keys;
+  bool can_buffer;
+  int error_code;
+  int i;
+
+  assert (scan_cache->m_insert_buffer == NULL);
+
+  max_keys = prm_get_integer_value (PRM_ID_BTREE_INSERT_BUFFER_SIZE);
+  if (max_keys <= 0)
+    {
+      return NO_ERROR;
+    }
+
+  classrepr = heap_classrepr_get (thread_p, class_oid, NULL, NULL_REPRID, &classrepr_cacheindex);
+  if (classrepr == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error_code);
+      return error_code;
+    }
+
+  can_buffer = false;
+  for (i = 0; i < classrepr->n_indexes; i++)
+    {
+      if (classrepr->indexes[i].type == BTREE_FOREIGN_KEY
+	  || classrepr->indexes[i].index_status != OR_NORMAL_INDEX)
+	{
+	  can_buffer = false;
+	  break;
+	}
+      if (classrepr->indexes[i].type == BTREE_INDEX || classrepr->indexes[i].type == BTREE_REVERSE_INDEX)
+	{
+	  can_buffer = true;
+	}
+    }
+  heap_classrepr_free_and_init (classrepr, &classrepr_cacheindex);
+
+  if (can_buffer)
+    {
+      // *INDENT-OFF*
+      scan_cache->m_insert_buffer = new btree_insert_buffer ((std::size_t) max_keys);
+      // *INDENT-ON*
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * locator_flush_insert_buffer () - insert the index keys buffered in scan cache
+ *
+ * return: NO_ERROR if all OK, ER_ status otherwise
+ *
+ *   scan_cache(in/out): scan cache
+ */
+int
+locator_flush_insert_buffer (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache)
+{
+  int op_type;
+
+  if (scan_cache->m_insert_buffer == NULL || scan_cache->m_insert_buffer->empty ())
+    {
+      return NO_ERROR;
+    }
+
+  /* unique statistics are collected in scan cache only for multi row operations */
+  op_type = (scan_cache->m_index_stats != NULL) ? MULTI_ROW_INSERT : SINGLE_ROW_INSERT;
+  return scan_cache->m_insert_buffer->flush (thread_p, op_type, scan_cache->m_index_stats);
+}
+
 /*
  * locator_check_foreign_key () -
  *
@@ -5173,15 +5274,9 @@ locator_insert_force (THREAD_ENTRY * thread_p, HFID * hfid, OID * class_oid, OID
       locator_increase_catalog_count (thread_p, &real_class_oid);
 #endif
 
-      /* remove query result cache entries which are relevant with this class */
+      /* query result cache entries which are relevant with this class are removed when the transaction ends */
       if (!QFILE_IS_LIST_CACHE_DISABLED)
 	{
-	  if (qexec_clear_list_cache_by_class (thread_p, &real_class_oid) != NO_ERROR)
-	    {
-	      er_log_debug (ARG_FILE_LINE,
-			    "locator_insert_force: qexec_clear_list_cache_by_class failed for class { %d %d %d }\n",
-			    real_class_oid.pageid, real_class_oid.slotid, real_class_oid.volid);
-	    }
 	  qmgr_add_modified_class (thread_p, &real_class_oid);
 	}
 #if 0				/* TODO - dead code; do not delete me */
@@ -5957,15 +6052,9 @@ locator_update_force (THREAD_ENTRY * thread_p, HFID * hfid, OID * class_oid, OID
 	}
 #endif
 
-      /* remove query result cache entries which are relevant with this class */
+      /* query result cache entries which are relevant with this class are removed when the transaction ends */
       if (!QFILE_IS_LIST_CACHE_DISABLED)
 	{
-	  if (qexec_clear_list_cache_by_class (thread_p, class_oid) != NO_ERROR)
-	    {
-	      er_log_debug (ARG_FILE_LINE,
-			    "locator_update_force: qexec_clear_list_cache_by_class failed for class { %d %d %d }\n",
-			    class_oid->pageid, class_oid->slotid, class_oid->volid);
-	    }
 	  qmgr_add_modified_class (thread_p, class_oid);
 	}
     }
@@ -6257,15 +6346,9 @@ locator_delete_force_internal (THREAD_ENTRY * thread_p, HFID * hfid, OID * oid,
 	    }
 	}
 
-      /* remove query result cache entries which are relevant with this class */
+      /* query result cache entries which are relevant with this class are removed when the transaction ends */
       if (!QFILE_IS_LIST_CACHE_DISABLED)
 	{
-	  if (qexec_clear_list_cache_by_class (thread_p, &class_oid) != NO_ERROR)
-	    {
-	      er_log_debug (ARG_FILE_LINE,
-			    "locator_delete_force: qexec_clear_list_cache_by_class failed for class { %d %d %d }\n",
-			    class_oid.pageid, class_oid.slotid, class_oid.volid);
-	    }
 	  qmgr_add_modified_class (thread_p, &class_oid);
 	}
     }
@@ -6986,6 +7069,51 @@ exit_on_error:
   return error_code;
 }
 
+/*
+ * locator_can_buffer_force_keys () - can the index keys of the objects forced be inserted after all objects are
+ *				      inserted in heap, in key order?
+ *
+ * return: true if loaddb flushes only inserts of one class and each object does not need its own error handling
+ *
+ *   mobjs(in): objects in force area
+ *   num_ignore_error(in): number of errors to ignore for each object
+ *
+ * Note: Only loaddb asks for it (see locator_Sort_flush_index_keys); the flushes of other clients keep inserting
+ *       the keys of each object with the object.
+ */
+static bool
+locator_can_buffer_force_keys (THREAD_ENTRY * thread_p, LC_COPYAREA_MANYOBJS * mobjs, int num_ignore_error)
+{
+  LC_COPYAREA_ONEOBJ *obj;
+  LC_COPYAREA_ONEOBJ *first_obj;
+  int i;
+
+  if (!mobjs->sort_index_keys || mobjs->num_objs < 2 || mobjs->start_multi_update || num_ignore_error > 0
+      || LOG_CHECK_LOG_APPLIER (thread_p))
+    {
+      return false;
+    }
+
+  first_obj = LC_START_ONEOBJ_PTR_IN_COPYAREA (mobjs);
+  if (OID_EQ (&first_obj->class_oid, oid_Root_class_oid))
+    {
+      return false;
+    }
+
+  obj = first_obj;
+  for (i = 0; i < mobjs->num_objs; i++)
+    {
+      /* partitioned classes are pruned to other scan caches */
+      if (obj->operation != LC_FLUSH_INSERT || !OID_EQ (&obj->class_oid, &first_obj->class_oid))
+	{
+	  return false;
+	}
+      obj = LC_NEXT_ONEOBJ_PTR_IN_COPYAREA (obj);
+    }
+
+  return true;
+}
+
 /*
  * xlocator_force () - Updates objects placed on page
  *
@@ -7010,6 +7138,7 @@ xlocator_force (THREAD_ENTRY * thread_p, LC_COPYAREA * force_area, int num_ignor
   int error_code = NO_ERROR;
   int pruning_type = 0;
   int has_index;
+  bool use_insert_buffer;
 #if !defined(NDEBUG)
   bool disabled_row_replication = false;
 #endif
@@ -7036,6 +7165,8 @@ xlocator_force (THREAD_ENTRY * thread_p, LC_COPYAREA * force_area, int num_ignor
   obj = LC_PRIOR_ONEOBJ_PTR_IN_COPYAREA (obj);
   LC_RECDES_IN_COPYAREA (force_area, &recdes);
 
+  use_insert_buffer = locator_can_buffer_force_keys (thread_p, mobjs, num_ignore_error);
+
   for (i = 0; i < mobjs->num_objs; i++)
     {
       obj = LC_NEXT_ONEOBJ_PTR_IN_COPYAREA (obj);
@@ -7053,6 +7184,16 @@ xlocator_force (THREAD_ENTRY * thread_p, LC_COPYAREA * force_area, int num_ignor
 	      goto error;
 	    }
 	  force_scancache = &scan_cache;
+
+	  if (use_insert_buffer)
+	    {
+	      /* keys are inserted after the loop, in key order */
+	      error_code = locator_start_insert_buffer (thread_p, force_scancache, &obj->class_oid);
+	      if (error_code != NO_ERROR)
+		{
+		  goto error;
+		}
+	    }
 	}
 
       has_index = LC_ONEOBJ_GET_INDEX_FLAG (obj);
@@ -7185,6 +7326,11 @@ xlocator_force (THREAD_ENTRY * thread_p, LC_COPYAREA * force_area, int num_ignor
 
   if (force_scancache != NULL)
     {
+      error_code = locator_flush_insert_buffer (thread_p, force_scancache);
+      if (error_code != NO_ERROR)
+	{
+	  goto error;
+	}
       locator_end_force_scan_cache (thread_p, force_scancache);
       force_scancache = NULL;
     }
@@ -7878,6 +8024,13 @@ locator_add_or_remove_index_internal (THREAD_ENTRY * thread_p, RECDES * recdes,
 		    btree_online_index_dispatcher (thread_p, &btid, key_dbvalue, class_oid, inst_oid, unique_pk,
 						   BTREE_OP_ONLINE_INDEX_TRAN_INSERT, NULL);
 		}
+	      else if (scan_cache != NULL && scan_cache->m_insert_buffer != NULL && !BTREE_IS_UNIQUE (unique_pk))
+		{
+		  /* inserted later, in key order; unique keys are inserted now, to fail the row that violates them */
+		  assert (op_type == MULTI_ROW_INSERT || op_type == SINGLE_ROW_INSERT);
+		  scan_cache->m_insert_buffer->add_key (btid, *key_dbvalue, *class_oid, *inst_oid, use_mvcc);
+		  error_code = NO_ERROR;
+		}
 	      else
 		{
 		  error_code =
@@ -8033,6 +8186,12 @@ locator_add_or_remove_index_internal (THREAD_ENTRY * thread_p, RECDES * recdes,
 	}
     }
 
+  if (is_insert && scan_cache != NULL && scan_cache->m_insert_buffer != NULL
+      && scan_cache->m_insert_buffer->is_full ())
+    {
+      error_code = locator_flush_insert_buffer (thread_p, scan_cache);
+    }
+
 error:
 
   heap_attrinfo_end (thread_p, &index_attrinfo);
@@ -74,6 +74,8 @@ extern int xlc_fetch_allrefslockset (OID * oid, int chn, OID * class_oid, int cl
 extern int locator_start_force_scan_cache (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache, const HFID * hfid,
 					   const OID * class_oid, int op_type);
 extern void locator_end_force_scan_cache (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache);
+extern int locator_start_insert_buffer (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache, const OID * class_oid);
+extern int locator_flush_insert_buffer (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache);
 extern int locator_attribute_info_force (THREAD_ENTRY * thread_p, const HFID * hfid, OID * oid,
 					 HEAP_CACHE_ATTRINFO * attr_info, ATTR_ID * att_id, int n_att_id,
 					 LC_COPYAREA_OPERATION operation, int op_type, HEAP_SCANCACHE * scan_cache,
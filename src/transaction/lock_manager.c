@@ -34,6 +34,7 @@
 #include <string.h>
 #include <time.h>
 
+#include "bit.h"
 #include "boot_sr.h"
 #include "critical_section.h"
 #include "environment_variable.h"
@@ -307,6 +308,30 @@ struct lk_res_block
   int count;			/* # of entries in lock res block */
 };
 
+/*
+ * Fast Path Class Lock Structure
+ *
+ * IS and IX locks on classes may be kept by the transaction, in a few slots of its own, instead of the shared lock
+ * table. They are compatible with each other, so they only have to be seen by stronger class lock requests. These
+ * first block the fast path of the class partition (see lk_Gl.fastpath_strong_count) and then move the fast path
+ * locks of all transactions on that class into the lock table. From there on, they are regular lock entries that
+ * are checked for compatibility and seen by deadlock detection.
+ *
+ * The slots of a transaction are changed under its fastpath_mutex; only the transaction adds slots, other
+ * transactions may move them to the lock table.
+ */
+#define LK_FASTPATH_SLOT_COUNT 16
+#define LK_FASTPATH_PARTITION_COUNT 1024
+
+typedef struct lk_fastpath_slot LK_FASTPATH_SLOT;
+struct lk_fastpath_slot
+{
+  OID class_oid;		/* class or root class; NULL if slot is free */
+  LOCK granted_mode;		/* IS_LOCK or IX_LOCK */
+  int count;			/* number of lock requests */
+  int ngranules;		/* number of instance locks requested under the class lock */
+};
+
 /*
  * Transaction Lock Entry Structure
  */
@@ -335,6 +360,13 @@ struct lk_tran_lock
 
   /* locking on manual duration */
   bool is_instant_duration;
+
+  /* fast path class locks */
+  pthread_mutex_t fastpath_mutex;	/* mutex for fast path slots */
+  LK_FASTPATH_SLOT fastpath_slots[LK_FASTPATH_SLOT_COUNT];
+  int fastpath_count;		/* # of used fast path slots */
+  int fastpath_blocked_count;	/* # of partitions whose fast path is blocked by the transaction */
+  UINT64 fastpath_blocked[LK_FASTPATH_PARTITION_COUNT / 64];	/* bitmap of these partitions */
 };
 /* Max size of transaction local pool of lock entries. */
 #define LOCK_TRAN_LOCAL_POOL_MAX_SIZE 10
@@ -372,6 +404,10 @@ struct lk_global_data
   // *INDENT-OFF*
   std::atomic_int deadlock_and_timeout_detector;
   // *INDENT-ON*
+
+  /* fast path class locks */
+  bool fastpath_enabled;
+  int fastpath_strong_count[LK_FASTPATH_PARTITION_COUNT];	/* # of transactions blocking each partition */
 #if defined(LK_DUMP)
   bool dump_level;
 #endif				/* LK_DUMP */
@@ -381,7 +417,7 @@ LK_GLOBAL_DATA lk_Gl = {
   0, LF_HASH_TABLE_INITIALIZER,
   LF_FREELIST_INITIALIZER, LF_FREELIST_INITIALIZER,
   0, NULL, PTHREAD_MUTEX_INITIALIZER, {0, 0},
-  NULL, NULL, 0, 0, 0, 0, false, {0}
+  NULL, NULL, 0, 0, 0, 0, false, {0}, false, {0}
 #if defined(LK_DUMP)
   , 0
 #endif /* LK_DUMP */
@@ -522,6 +558,20 @@ static void lock_increment_class_granules (LK_ENTRY * class_entry);
 
 static void lock_decrement_class_granules (LK_ENTRY * class_entry);
 static LK_ENTRY *lock_find_class_entry (int tran_index, const OID * class_oid);
+static bool lock_fastpath_is_strong (LOCK lock);
+static LK_FASTPATH_SLOT *lock_fastpath_find_slot (LK_TRAN_LOCK * tran_lock, const OID * class_oid);
+static bool lock_fastpath_acquire (THREAD_ENTRY * thread_p, int tran_index, const OID * class_oid, LOCK lock);
+static LOCK lock_fastpath_get_mode (int tran_index, const OID * class_oid);
+static bool lock_fastpath_release (int tran_index, const OID * class_oid, bool release_flag);
+static void lock_fastpath_add_granule (THREAD_ENTRY * thread_p, int tran_index, const OID * class_oid);
+static int lock_fastpath_transfer_slot (THREAD_ENTRY * thread_p, int tran_index, int owner_tran_index,
+					LK_FASTPATH_SLOT * slot);
+static int lock_fastpath_transfer_class (THREAD_ENTRY * thread_p, int tran_index, const OID * class_oid,
+					 bool all_trans);
+static int lock_fastpath_block_class (THREAD_ENTRY * thread_p, int tran_index, const OID * class_oid);
+static void lock_fastpath_release_all (int tran_index);
+static void lock_fastpath_unblock_all (int tran_index);
+static int lock_fastpath_transfer_all (THREAD_ENTRY * thread_p, int tran_index);
 
 static void lock_event_log_tran_locks (THREAD_ENTRY * thread_p, FILE * log_fp, int tran_index);
 static void lock_event_log_blocked_lock (THREAD_ENTRY * thread_p, FILE * log_fp, LK_ENTRY * entry);
@@ -1040,6 +1090,11 @@ lock_initialize_tran_lock_table (void)
       tran_lock = &lk_Gl.tran_lock_table[i];
       pthread_mutex_init (&tran_lock->hold_mutex, NULL);
       pthread_mutex_init (&tran_lock->non2pl_mutex, NULL);
+      pthread_mutex_init (&tran_lock->fastpath_mutex, NULL);
+      for (j = 0; j < LK_FASTPATH_SLOT_COUNT; j++)
+	{
+	  OID_SET_NULL (&tran_lock->fastpath_slots[j].class_oid);
+	}
 
       for (j = 0; j < LOCK_TRAN_LOCAL_POOL_MAX_SIZE; j++)
 	{
@@ -1618,6 +1673,540 @@ lock_find_class_entry (int tran_index, const OID * class_oid)
 }
 #endif /* SERVER_MODE */
 
+#if defined(SERVER_MODE)
+/*
+ *  Private Functions Group: fast path class locks
+ *   - lock_fastpath_acquire()
+ *   - lock_fastpath_release()
+ *   - lock_fastpath_transfer_class()
+ *   - lock_fastpath_block_class()
+ */
+
+/*
+ * lock_fastpath_is_strong - Check if a class lock mode conflicts with fast path class locks
+ *
+ * return: true if lock is not compatible with both IS_LOCK and IX_LOCK
+ *
+ *   lock(in): class lock mode
+ */
+static bool
+lock_fastpath_is_strong (LOCK lock)
+{
+  assert (lock >= NULL_LOCK);
+  return (lock_Comp[lock][IS_LOCK] != LOCK_COMPAT_YES || lock_Comp[lock][IX_LOCK] != LOCK_COMPAT_YES);
+}
+
+/*
+ * lock_fastpath_find_slot - Find the fast path slot of a class
+ *
+ * return: slot or NULL
+ *
+ *   tran_lock(in): transaction lock entry; caller holds its fastpath_mutex
+ *   class_oid(in): class or root class
+ */
+static LK_FASTPATH_SLOT *
+lock_fastpath_find_slot (LK_TRAN_LOCK * tran_lock, const OID * class_oid)
+{
+  int i;
+
+  for (i = 0; i < LK_FASTPATH_SLOT_COUNT; i++)
+    {
+      if (OID_EQ (&tran_lock->fastpath_slots[i].class_oid, class_oid))
+	{
+	  return &tran_lock->fastpath_slots[i];
+	}
+    }
+
+  return NULL;
+}
+
+/*
+ * lock_fastpath_acquire - Lock a class in a fast path slot of transaction
+ *
+ * return: true if the lock is granted, false if it must be requested from the lock table
+ *
+ *   tran_index(in): transaction table index
+ *   class_oid(in): class or root class
+ *   lock(in): requested lock mode
+ *
+ * Note: only IS_LOCK and IX_LOCK are granted this way, and only if no transaction blocks the fast path of class
+ *       partition, the transaction has no lock entry for the class and a free slot is left.
+ */
+static bool
+lock_fastpath_acquire (THREAD_ENTRY * thread_p, int tran_index, const OID * class_oid, LOCK lock)
+{
+  LK_TRAN_LOCK *tran_lock;
+  LK_FASTPATH_SLOT *slot;
+  unsigned int partition;
+  int i;
+
+  if (!lk_Gl.fastpath_enabled || (lock != IS_LOCK && lock != IX_LOCK))
+    {
+      return false;
+    }
+
+  if (thread_p != NULL && thread_is_tran_shared (thread_p))
+    {
+      /* parallel workers must not lock; the lock table rejects them */
+      return false;
+    }
+
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  if (tran_lock->is_instant_duration)
+    {
+      /* instant locks are counted in lock entries */
+      return false;
+    }
+
+  partition = lock_get_hash_value (class_oid, LK_FASTPATH_PARTITION_COUNT);
+
+  pthread_mutex_lock (&tran_lock->fastpath_mutex);
+
+  slot = lock_fastpath_find_slot (tran_lock, class_oid);
+  if (slot == NULL)
+    {
+      /* a strong locker increments the counter before it looks at the slots of transactions under their mutex.
+       * either it sees the new slot or we see the counter. */
+      if (tran_lock->fastpath_count >= LK_FASTPATH_SLOT_COUNT
+	  || ATOMIC_LOAD (&lk_Gl.fastpath_strong_count[partition]) > 0
+	  || lock_find_class_entry (tran_index, class_oid) != NULL)
+	{
+	  pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+	  return false;
+	}
+
+      for (i = 0; i < LK_FASTPATH_SLOT_COUNT; i++)
+	{
+	  if (OID_ISNULL (&tran_lock->fastpath_slots[i].class_oid))
+	    {
+	      slot = &tran_lock->fastpath_slots[i];
+	      break;
+	    }
+	}
+      assert (slot != NULL);
+
+      COPY_OID (&slot->class_oid, class_oid);
+      slot->granted_mode = NULL_LOCK;
+      slot->count = 0;
+      slot->ngranules = 0;
+      tran_lock->fastpath_count++;
+    }
+
+  /* IS and IX convert to IS or IX; they stay compatible with each other */
+  slot->granted_mode = lock_Conv[lock][slot->granted_mode];
+  assert (slot->granted_mode == IS_LOCK || slot->granted_mode == IX_LOCK);
+  slot->count++;
+
+  pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+
+  perfmon_inc_stat (thread_p, PSTAT_LK_NUM_FASTPATH_ON_CLASSES);
+  return true;
+}
+
+/*
+ * lock_fastpath_get_mode - Get the mode of fast path lock of transaction on class
+ *
+ * return: IS_LOCK, IX_LOCK or NULL_LOCK
+ *
+ *   tran_index(in): transaction table index
+ *   class_oid(in): class or root class
+ */
+static LOCK
+lock_fastpath_get_mode (int tran_index, const OID * class_oid)
+{
+  LK_TRAN_LOCK *tran_lock;
+  LK_FASTPATH_SLOT *slot;
+  LOCK lock = NULL_LOCK;
+
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  if (tran_lock->fastpath_count == 0)
+    {
+      /* only the transaction adds slots */
+      return NULL_LOCK;
+    }
+
+  pthread_mutex_lock (&tran_lock->fastpath_mutex);
+  slot = lock_fastpath_find_slot (tran_lock, class_oid);
+  if (slot != NULL)
+    {
+      lock = slot->granted_mode;
+    }
+  pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+
+  return lock;
+}
+
+/*
+ * lock_fastpath_release - Release a fast path lock of current transaction
+ *
+ * return: true if transaction had a fast path lock on the class
+ *
+ *   tran_index(in): transaction table index
+ *   class_oid(in): class or root class
+ *   release_flag(in): release the lock, or just decrement its count
+ */
+static bool
+lock_fastpath_release (int tran_index, const OID * class_oid, bool release_flag)
+{
+  LK_TRAN_LOCK *tran_lock;
+  LK_FASTPATH_SLOT *slot;
+
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  if (tran_lock->fastpath_count == 0)
+    {
+      return false;
+    }
+
+  pthread_mutex_lock (&tran_lock->fastpath_mutex);
+  slot = lock_fastpath_find_slot (tran_lock, class_oid);
+  if (slot == NULL)
+    {
+      pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+      return false;
+    }
+
+  slot->count--;
+  if (release_flag || slot->count <= 0)
+    {
+      OID_SET_NULL (&slot->class_oid);
+      tran_lock->fastpath_count--;
+    }
+  pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+
+  return true;
+}
+
+/*
+ * lock_fastpath_add_granule - Count an instance lock requested under a fast path class lock
+ *
+ * return: nothing
+ *
+ *   thread_p(in):
+ *   tran_index(in): transaction table index
+ *   class_oid(in): class of instance
+ *
+ * Note: instance locks under a fast path class lock have no class entry to count them. Once there are as many as
+ *       the lock escalation threshold, the class lock is moved to lock table, so the next instance locks are
+ *       counted by its entry and may be escalated.
+ */
+static void
+lock_fastpath_add_granule (THREAD_ENTRY * thread_p, int tran_index, const OID * class_oid)
+{
+  LK_TRAN_LOCK *tran_lock;
+  LK_FASTPATH_SLOT *slot;
+
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  if (tran_lock->fastpath_count == 0)
+    {
+      return;
+    }
+
+  pthread_mutex_lock (&tran_lock->fastpath_mutex);
+  slot = lock_fastpath_find_slot (tran_lock, class_oid);
+  if (slot != NULL && ++slot->ngranules >= prm_get_integer_value (PRM_ID_LK_ESCALATION_AT))
+    {
+      if (lock_fastpath_transfer_slot (thread_p, tran_index, tran_index, slot) != NO_ERROR)
+	{
+	  /* try again with next instance lock */
+	  ASSERT_ERROR ();
+	  er_clear ();
+	}
+    }
+  pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+}
+
+/*
+ * lock_fastpath_transfer_slot - Move a fast path lock to lock table
+ *
+ * return: error code
+ *
+ *   thread_p(in):
+ *   tran_index(in): transaction table index of current thread
+ *   owner_tran_index(in): transaction that holds the fast path lock; caller holds its fastpath_mutex
+ *   slot(in): fast path slot of owner; it is free when the lock is moved
+ *
+ * Note: the fast path lock is compatible with the holders of lock table, since stronger locks cannot be granted
+ *       before they transfer it. It is added as a granted holder, with the instance locks counted by the slot, so
+ *       lock escalation keeps its threshold.
+ *       The lock entry comes from the local pool of the owner only if the owner is current transaction; the local
+ *       pool of another transaction is used by its threads without mutex, so the entry is claimed from the shared
+ *       free list instead.
+ */
+static int
+lock_fastpath_transfer_slot (THREAD_ENTRY * thread_p, int tran_index, int owner_tran_index, LK_FASTPATH_SLOT * slot)
+{
+  LF_TRAN_ENTRY *t_entry_res = thread_get_tran_entry (thread_p, THREAD_TS_OBJ_LOCK_RES);
+  LF_TRAN_ENTRY *t_entry_ent = thread_get_tran_entry (thread_p, THREAD_TS_OBJ_LOCK_ENT);
+  LK_TRAN_LOCK *owner_tran_lock;
+  LK_RES_KEY search_key;
+  LK_RES *res_ptr;
+  LK_ENTRY *entry_ptr;
+  int rv;
+
+  owner_tran_lock = &lk_Gl.tran_lock_table[owner_tran_index];
+
+  search_key = lock_create_search_key (&slot->class_oid, NULL);
+  rv = lf_hash_find_or_insert (t_entry_res, &lk_Gl.obj_hash_table, (void *) &search_key, (void **) &res_ptr, NULL);
+  if (rv != NO_ERROR)
+    {
+      return rv;
+    }
+  else if (res_ptr == NULL)
+    {
+      return ER_FAILED;
+    }
+  /* resource mutex is locked */
+
+  if (res_ptr->holder == NULL && res_ptr->waiter == NULL && res_ptr->non2pl == NULL)
+    {
+      lock_initialize_resource_as_allocated (res_ptr, NULL_LOCK);
+    }
+
+  for (entry_ptr = res_ptr->holder; entry_ptr != NULL; entry_ptr = entry_ptr->next)
+    {
+      if (entry_ptr->tran_index == owner_tran_index)
+	{
+	  break;
+	}
+    }
+
+  if (entry_ptr != NULL)
+    {
+      /* another thread of the owner has locked the class through lock table; merge the locks */
+      assert (entry_ptr->granted_mode >= NULL_LOCK);
+      entry_ptr->granted_mode = lock_Conv[slot->granted_mode][entry_ptr->granted_mode];
+      assert (entry_ptr->granted_mode != NA_LOCK);
+      entry_ptr->count += slot->count;
+      entry_ptr->ngranules += slot->ngranules;
+    }
+  else
+    {
+      if (owner_tran_index == tran_index)
+	{
+	  entry_ptr = lock_get_new_entry (owner_tran_index, t_entry_ent, &lk_Gl.obj_free_entry_list);
+	}
+      else
+	{
+	  entry_ptr = (LK_ENTRY *) lf_freelist_claim (t_entry_ent, &lk_Gl.obj_free_entry_list);
+	}
+      if (entry_ptr == NULL)
+	{
+	  pthread_mutex_unlock (&res_ptr->res_mutex);
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_ALLOC_RESOURCE, 1, "lock heap entry");
+	  return ER_LK_ALLOC_RESOURCE;
+	}
+
+      lock_initialize_entry_as_granted (entry_ptr, owner_tran_index, res_ptr, slot->granted_mode);
+      entry_ptr->count = slot->count;
+      entry_ptr->ngranules = slot->ngranules;
+
+      /* add the lock entry into the holder list */
+      lock_position_holder_entry (res_ptr, entry_ptr);
+
+      /* add the lock entry into the transaction hold list */
+      lock_insert_into_tran_hold_list (entry_ptr, owner_tran_index);
+    }
+
+  assert (res_ptr->total_holders_mode >= NULL_LOCK);
+  res_ptr->total_holders_mode = lock_Conv[slot->granted_mode][res_ptr->total_holders_mode];
+  assert (res_ptr->total_holders_mode != NA_LOCK);
+
+  pthread_mutex_unlock (&res_ptr->res_mutex);
+
+  OID_SET_NULL (&slot->class_oid);
+  owner_tran_lock->fastpath_count--;
+
+  perfmon_inc_stat (thread_p, PSTAT_LK_NUM_FASTPATH_TRANSFERRED);
+  return NO_ERROR;
+}
+
+/*
+ * lock_fastpath_transfer_class - Move fast path locks on a class to lock table
+ *
+ * return: error code
+ *
+ *   thread_p(in):
+ *   tran_index(in): transaction table index of current thread
+ *   class_oid(in): class or root class
+ *   all_trans(in): move the locks of all transactions, or only the lock of current transaction
+ */
+static int
+lock_fastpath_transfer_class (THREAD_ENTRY * thread_p, int tran_index, const OID * class_oid, bool all_trans)
+{
+  LK_TRAN_LOCK *owner_tran_lock;
+  LK_FASTPATH_SLOT *slot;
+  int owner_tran_index, first, last;
+  int error_code = NO_ERROR;
+
+  if (all_trans)
+    {
+      first = 0;
+      last = lk_Gl.num_trans - 1;
+    }
+  else
+    {
+      first = last = tran_index;
+    }
+
+  for (owner_tran_index = first; owner_tran_index <= last && error_code == NO_ERROR; owner_tran_index++)
+    {
+      owner_tran_lock = &lk_Gl.tran_lock_table[owner_tran_index];
+
+      /* the count cannot be read without mutex; a slot may be added right now */
+      pthread_mutex_lock (&owner_tran_lock->fastpath_mutex);
+      if (owner_tran_lock->fastpath_count > 0)
+	{
+	  slot = lock_fastpath_find_slot (owner_tran_lock, class_oid);
+	  if (slot != NULL)
+	    {
+	      error_code = lock_fastpath_transfer_slot (thread_p, tran_index, owner_tran_index, slot);
+	    }
+	}
+      pthread_mutex_unlock (&owner_tran_lock->fastpath_mutex);
+    }
+
+  return error_code;
+}
+
+/*
+ * lock_fastpath_block_class - Block fast path locks on a class and move existing ones to lock table
+ *
+ * return: error code
+ *
+ *   thread_p(in):
+ *   tran_index(in): transaction table index of current thread
+ *   class_oid(in): class or root class that is locked with a strong lock mode
+ *
+ * Note: the fast path of the class partition stays blocked until the transaction ends, so it covers every strong
+ *       lock the transaction may hold on the classes of partition.
+ */
+static int
+lock_fastpath_block_class (THREAD_ENTRY * thread_p, int tran_index, const OID * class_oid)
+{
+  LK_TRAN_LOCK *tran_lock;
+  unsigned int partition;
+  UINT64 bit;
+
+  if (!lk_Gl.fastpath_enabled)
+    {
+      return NO_ERROR;
+    }
+
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  partition = lock_get_hash_value (class_oid, LK_FASTPATH_PARTITION_COUNT);
+  bit = ((UINT64) 1) << (partition % 64);
+
+  if ((tran_lock->fastpath_blocked[partition / 64] & bit) == 0)
+    {
+      tran_lock->fastpath_blocked[partition / 64] |= bit;
+      tran_lock->fastpath_blocked_count++;
+      ATOMIC_INC_32 (&lk_Gl.fastpath_strong_count[partition], 1);
+    }
+
+  /* locks acquired before the partition was blocked may still be in slots; slots of other classes of partition may
+   * be left there, they are moved when these classes are locked with strong locks */
+  return lock_fastpath_transfer_class (thread_p, tran_index, class_oid, true);
+}
+
+/*
+ * lock_fastpath_transfer_all - Move all fast path locks of current transaction to lock table
+ *
+ * return: error code
+ *
+ *   thread_p(in):
+ *   tran_index(in): transaction table index of current thread
+ */
+static int
+lock_fastpath_transfer_all (THREAD_ENTRY * thread_p, int tran_index)
+{
+  LK_TRAN_LOCK *tran_lock;
+  int i;
+  int error_code = NO_ERROR;
+
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  if (tran_lock->fastpath_count == 0)
+    {
+      return NO_ERROR;
+    }
+
+  pthread_mutex_lock (&tran_lock->fastpath_mutex);
+  for (i = 0; i < LK_FASTPATH_SLOT_COUNT && error_code == NO_ERROR; i++)
+    {
+      if (!OID_ISNULL (&tran_lock->fastpath_slots[i].class_oid))
+	{
+	  error_code = lock_fastpath_transfer_slot (thread_p, tran_index, tran_index, &tran_lock->fastpath_slots[i]);
+	}
+    }
+  pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+
+  return error_code;
+}
+
+/*
+ * lock_fastpath_release_all - Release the fast path locks of transaction
+ *
+ * return: nothing
+ *
+ *   tran_index(in): transaction table index
+ *
+ * Note: must be called before the locks of lock table are released. A strong lock request may move a slot of the
+ *       transaction to lock table up to the moment the slots are cleared; the moved lock is then in the hold lists
+ *       and released with them. Once the slots are cleared, nothing is added to the hold lists anymore.
+ */
+static void
+lock_fastpath_release_all (int tran_index)
+{
+  LK_TRAN_LOCK *tran_lock;
+  int i;
+
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+
+  /* only the transaction adds slots, so the count cannot grow meanwhile */
+  if (tran_lock->fastpath_count > 0)
+    {
+      pthread_mutex_lock (&tran_lock->fastpath_mutex);
+      for (i = 0; i < LK_FASTPATH_SLOT_COUNT; i++)
+	{
+	  OID_SET_NULL (&tran_lock->fastpath_slots[i].class_oid);
+	}
+      tran_lock->fastpath_count = 0;
+      pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+    }
+}
+
+/*
+ * lock_fastpath_unblock_all - Unblock the fast path partitions blocked by the strong locks of transaction
+ *
+ * return: nothing
+ *
+ *   tran_index(in): transaction table index
+ *
+ * Note: must be called after the locks of lock table are released.
+ */
+static void
+lock_fastpath_unblock_all (int tran_index)
+{
+  LK_TRAN_LOCK *tran_lock;
+  int i, partition;
+
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+
+  if (tran_lock->fastpath_blocked_count > 0)
+    {
+      for (i = 0; i < LK_FASTPATH_PARTITION_COUNT / 64; i++)
+	{
+	  while (tran_lock->fastpath_blocked[i] != 0)
+	    {
+	      partition = i * 64 + bit64_count_trailing_zeros (tran_lock->fastpath_blocked[i]);
+	      tran_lock->fastpath_blocked[i] &= tran_lock->fastpath_blocked[i] - 1;
+	      ATOMIC_INC_32 (&lk_Gl.fastpath_strong_count[partition], -1);
+	    }
+	}
+      tran_lock->fastpath_blocked_count = 0;
+    }
+}
+#endif /* SERVER_MODE */
+
 #if defined(SERVER_MODE)
 /*
  * lock_add_non2pl_lock - Add a release lock which has never been acquired
@@ -3257,6 +3846,7 @@ lock_internal_perform_lock_object (THREAD_ENTRY * thread_p, int tran_index, cons
   TSC_TICKS start_tick, end_tick;
   TSCTIMEVAL tv_diff;
   UINT64 lock_wait_time;
+  bool is_perf_tracking;
 
 #if defined(ENABLE_SYSTEMTAP)
   const OID *class_oid_for_marker_p;
@@ -3299,6 +3889,11 @@ lock_internal_perform_lock_object (THREAD_ENTRY * thread_p, int tran_index, cons
       return LK_GRANTED;
     }
 
+  if (logtb_check_tran_owner (thread_p) != NO_ERROR)
+    {
+      return LK_NOTGRANTED_DUE_ERROR;
+    }
+
   thrd_entry = thread_p;
 
   new_mode = group_mode = old_mode = NULL_LOCK;
@@ -3354,6 +3949,25 @@ start:
   else
     {
       /* Class lock request. */
+      if (lock_fastpath_is_strong (lock))
+	{
+	  /* fast path locks of other transactions conflict with this lock; they must be in lock table */
+	  if (lock_fastpath_block_class (thread_p, tran_index, oid) != NO_ERROR)
+	    {
+	      ret_val = LK_NOTGRANTED_DUE_ERROR;
+	      goto end;
+	    }
+	}
+      else if (tran_lock->fastpath_count > 0)
+	{
+	  /* the class may be locked in a fast path slot; keep all locks of the transaction on it in one place */
+	  if (lock_fastpath_transfer_class (thread_p, tran_index, oid, false) != NO_ERROR)
+	    {
+	      ret_val = LK_NOTGRANTED_DUE_ERROR;
+	      goto end;
+	    }
+	}
+
       /* Try to find class lock entry if it already exists to avoid using the expensive resource mutex. */
       entry_ptr = lock_find_class_entry (tran_index, oid);
       if (entry_ptr != NULL)
@@ -3846,7 +4460,8 @@ lock_tran_lk_entry:
 
 blocked:
 
-  if (perfmon_is_perf_tracking_and_active (PERFMON_ACTIVATION_FLAG_LOCK_OBJECT))
+  is_perf_tracking = perfmon_is_perf_tracking ();
+  if (is_perf_tracking)
     {
       tsc_getticks (&start_tick);
     }
@@ -3864,12 +4479,16 @@ blocked:
     }
   ret_val = lock_suspend (thread_p, entry_ptr, wait_msecs);
 
-  if (perfmon_is_perf_tracking_and_active (PERFMON_ACTIVATION_FLAG_LOCK_OBJECT))
+  if (is_perf_tracking)
     {
       tsc_getticks (&end_tick);
       tsc_elapsed_time_usec (&tv_diff, end_tick, start_tick);
       lock_wait_time = tv_diff.tv_sec * 1000000LL + tv_diff.tv_usec;
-      perfmon_lk_waited_time_on_objects (thread_p, lock, lock_wait_time);
+      perfmon_collect_latency (PERFMON_LATENCY_LK_WAIT, lock_wait_time);
+      if (perfmon_is_perf_tracking_and_active (PERFMON_ACTIVATION_FLAG_LOCK_OBJECT))
+	{
+	  perfmon_lk_waited_time_on_objects (thread_p, lock, lock_wait_time);
+	}
     }
 
   if (ret_val != LOCK_RESUMED)
@@ -5931,6 +6550,10 @@ lock_initialize (void)
       goto error;
     }
 
+  /* fast path class locks are enabled or disabled for the whole server life */
+  lk_Gl.fastpath_enabled = prm_get_bool_value (PRM_ID_LK_FASTPATH);
+  memset (lk_Gl.fastpath_strong_count, 0, sizeof (lk_Gl.fastpath_strong_count));
+
   /* initialize some parameters */
 #if defined(CUBRID_DEBUG)
   lk_Gl.verbose_mode = true;
@@ -6124,6 +6747,7 @@ lock_finalize (void)
 	  tran_lock = &lk_Gl.tran_lock_table[i];
 	  pthread_mutex_destroy (&tran_lock->hold_mutex);
 	  pthread_mutex_destroy (&tran_lock->non2pl_mutex);
+	  pthread_mutex_destroy (&tran_lock->fastpath_mutex);
 	  while (tran_lock->lk_entry_pool != NULL)
 	    {
 	      LK_ENTRY *entry = tran_lock->lk_entry_pool;
@@ -6283,11 +6907,11 @@ lock_object (THREAD_ENTRY * thread_p, const OID * oid, const OID * class_oid, LO
   /* Check if current transaction has already held the class lock. If the class lock is not held, hold the class lock,
    * now. */
   class_entry = lock_get_class_lock (thread_p, class_oid, tran_index);
-  old_class_lock = (class_entry) ? class_entry->granted_mode : NULL_LOCK;
+  old_class_lock = (class_entry) ? class_entry->granted_mode : lock_fastpath_get_mode (tran_index, class_oid);
 
   if (OID_IS_ROOTOID (class_oid))
     {
-      if (old_class_lock < new_class_lock)
+      if (old_class_lock < new_class_lock && !lock_fastpath_acquire (thread_p, tran_index, class_oid, new_class_lock))
 	{
 	  granted = lock_internal_perform_lock_object (thread_p, tran_index, class_oid, NULL, new_class_lock,
 						       wait_msecs, &root_class_entry, NULL);
@@ -6301,13 +6925,18 @@ lock_object (THREAD_ENTRY * thread_p, const OID * oid, const OID * class_oid, LO
 
       /* NOTE that in case of acquiring a lock on a class object, the higher lock granule of the class object must not
        * be given. */
+      if (lock_fastpath_acquire (thread_p, tran_index, oid, lock))
+	{
+	  granted = LK_GRANTED;
+	  goto end;
+	}
       granted = lock_internal_perform_lock_object (thread_p, tran_index, oid, NULL, lock, wait_msecs, &class_entry,
 						   root_class_entry);
       goto end;
     }
   else
     {
-      if (old_class_lock < new_class_lock)
+      if (old_class_lock < new_class_lock && !lock_fastpath_acquire (thread_p, tran_index, class_oid, new_class_lock))
 	{
 	  if (class_entry != NULL && class_entry->class_entry != NULL
 	      && !OID_IS_ROOTOID (&class_entry->class_entry->res_head->key.oid))
@@ -6343,6 +6972,11 @@ lock_object (THREAD_ENTRY * thread_p, const OID * oid, const OID * class_oid, LO
        * given. */
       granted = lock_internal_perform_lock_object (thread_p, tran_index, oid, class_oid, lock, wait_msecs, &inst_entry,
 						   class_entry);
+      if (granted == LK_GRANTED && class_entry == NULL)
+	{
+	  /* the class is locked in fast path slot */
+	  lock_fastpath_add_granule (thread_p, tran_index, class_oid);
+	}
       goto end;
     }
 
@@ -6831,6 +7465,17 @@ lock_unlock_object_lock_internal (THREAD_ENTRY * thread_p, const OID * oid, cons
   tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
   entry_ptr = lock_find_tran_hold_entry (thread_p, tran_index, oid, is_class);
 
+  if (entry_ptr == NULL && is_class)
+    {
+      /* fast path class locks have no entry */
+      if (lock_fastpath_release (tran_index, oid, release_flag))
+	{
+	  return;
+	}
+      /* unless a strong lock request moved the fast path lock to lock table meanwhile */
+      entry_ptr = lock_find_tran_hold_entry (thread_p, tran_index, oid, is_class);
+    }
+
   if (entry_ptr != NULL)
     {
       lock_internal_perform_unlock_object (thread_p, entry_ptr, release_flag, move_to_non2pl);
@@ -6913,6 +7558,11 @@ lock_unlock_object (THREAD_ENTRY * thread_p, const OID * oid, const OID * class_
 #endif /* ENABLE_SYSTEMTAP */
 
       entry_ptr = lock_find_tran_hold_entry (thread_p, tran_index, oid, is_class);
+      if (entry_ptr == NULL && is_class && !lock_fastpath_release (tran_index, oid, false))
+	{
+	  /* the fast path lock was moved to lock table meanwhile by a strong lock request */
+	  entry_ptr = lock_find_tran_hold_entry (thread_p, tran_index, oid, is_class);
+	}
 
       if (entry_ptr != NULL)
 	{
@@ -7116,6 +7766,9 @@ lock_unlock_all (THREAD_ENTRY * thread_p)
   tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
   tran_lock = &lk_Gl.tran_lock_table[tran_index];
 
+  /* remove fast path class locks first; those moved to lock table meanwhile are removed with the class locks */
+  lock_fastpath_release_all (tran_index);
+
   /* remove all instance locks */
   entry_ptr = tran_lock->inst_hold_list;
   while (entry_ptr != NULL)
@@ -7145,6 +7798,9 @@ lock_unlock_all (THREAD_ENTRY * thread_p)
       lock_internal_perform_unlock_object (thread_p, entry_ptr, true, false);
     }
 
+  /* unblock the fast path for others */
+  lock_fastpath_unblock_all (tran_index);
+
   /* remove non2pl locks */
   while (tran_lock->non2pl_list != NULL)
     {
@@ -7274,6 +7930,10 @@ lock_get_object_lock (const OID * oid, const OID * class_oid, int tran_index)
 	  lock_mode = tran_lock->root_class_hold->granted_mode;
 	}
       pthread_mutex_unlock (&tran_lock->hold_mutex);
+      if (lock_mode == NULL_LOCK)
+	{
+	  lock_mode = lock_fastpath_get_mode (tran_index, oid);
+	}
       return lock_mode;		/* might be NULL_LOCK */
     }
 
@@ -7288,6 +7948,10 @@ lock_get_object_lock (const OID * oid, const OID * class_oid, int tran_index)
 	{
 	  lock_mode = entry_ptr->granted_mode;
 	}
+      else
+	{
+	  lock_mode = lock_fastpath_get_mode (tran_index, oid);
+	}
       return lock_mode;		/* might be NULL_LOCK */
     }
 
@@ -7296,6 +7960,10 @@ lock_get_object_lock (const OID * oid, const OID * class_oid, int tran_index)
     {
       lock_mode = entry_ptr->granted_mode;
     }
+  else
+    {
+      lock_mode = lock_fastpath_get_mode (tran_index, class_oid);
+    }
 
   /* If the class lock mode is one of S_LOCK, X_LOCK or SCH_M_LOCK, the lock is held on the instance implicitly. In
    * this case, there is no need to check instance lock. If the class lock mode is SIX_LOCK, S_LOCK is held on the
@@ -7384,6 +8052,10 @@ lock_has_lock_on_object (const OID * oid, const OID * class_oid, int tran_index,
 	  granted_lock_mode = tran_lock->root_class_hold->granted_mode;
 	}
       pthread_mutex_unlock (&tran_lock->hold_mutex);
+      if (granted_lock_mode == NULL_LOCK)
+	{
+	  granted_lock_mode = lock_fastpath_get_mode (tran_index, oid);
+	}
       return (lock_Conv[lock][granted_lock_mode] == granted_lock_mode);
     }
 
@@ -7398,6 +8070,10 @@ lock_has_lock_on_object (const OID * oid, const OID * class_oid, int tran_index,
 	{
 	  granted_lock_mode = entry_ptr->granted_mode;
 	}
+      else
+	{
+	  granted_lock_mode = lock_fastpath_get_mode (tran_index, oid);
+	}
       return (lock_Conv[lock][granted_lock_mode] == granted_lock_mode);
     }
 
@@ -7444,7 +8120,8 @@ lock_has_xlock (THREAD_ENTRY * thread_p)
   LK_TRAN_LOCK *tran_lock;
   LOCK lock_mode;
   LK_ENTRY *entry_ptr;
-  int rv;
+  bool has_xlock = false;
+  int i, rv;
 
   /*
    * Exclusive locks in this context mean IX_LOCK, SIX_LOCK, X_LOCK and
@@ -7483,6 +8160,20 @@ lock_has_xlock (THREAD_ENTRY * thread_p)
    * with intention mode before an exclusive instance is acquired. */
 
   pthread_mutex_unlock (&tran_lock->hold_mutex);
+
+  /* 4. check fast path class locks; fastpath_mutex is never locked under hold_mutex */
+  if (tran_lock->fastpath_count > 0)
+    {
+      pthread_mutex_lock (&tran_lock->fastpath_mutex);
+      for (i = 0; i < LK_FASTPATH_SLOT_COUNT && !has_xlock; i++)
+	{
+	  has_xlock = (!OID_ISNULL (&tran_lock->fastpath_slots[i].class_oid)
+		       && tran_lock->fastpath_slots[i].granted_mode == IX_LOCK);
+	}
+      pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+      return has_xlock;
+    }
+
   return false;
 #endif /* !SERVER_MODE */
 }
@@ -8547,6 +9238,18 @@ lock_unlock_all_shared_get_all_exclusive (THREAD_ENTRY * thread_p, LK_ACQUIRED_L
   /* some preparation */
   tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
 
+  /* fast path class locks are collected from lock table below */
+  if (lock_fastpath_transfer_all (thread_p, tran_index) != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      if (acqlocks != NULL)
+	{
+	  acqlocks->nobj_locks = 0;
+	  acqlocks->obj = NULL;
+	}
+      return;
+    }
+
   /************************************/
   /* phase 1: unlock all shared locks */
   /************************************/
@@ -8693,6 +9396,9 @@ xlock_dump (THREAD_ENTRY * thread_p, FILE * outfp)
   int num_locked;
   float lock_timeout_sec;
   char lock_timeout_string[64];
+  LK_TRAN_LOCK *tran_lock;
+  LK_FASTPATH_SLOT *slot;
+  int i;
 
   if (outfp == NULL)
     {
@@ -8768,6 +9474,30 @@ xlock_dump (THREAD_ENTRY * thread_p, FILE * outfp)
       lock_dump_resource (thread_p, outfp, res_ptr);
     }
 
+  /* dump class locks that are held in fast path slots of transactions */
+  if (lk_Gl.fastpath_enabled)
+    {
+      fprintf (outfp, "Fast Path Class Locks:\n");
+      for (tran_index = 0; tran_index < lk_Gl.num_trans; tran_index++)
+	{
+	  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+
+	  pthread_mutex_lock (&tran_lock->fastpath_mutex);
+	  for (i = 0; i < LK_FASTPATH_SLOT_COUNT && tran_lock->fastpath_count > 0; i++)
+	    {
+	      slot = &tran_lock->fastpath_slots[i];
+	      if (!OID_ISNULL (&slot->class_oid))
+		{
+		  fprintf (outfp, "\tTran_index = %3d, OID = %2d|%4d|%2d, Lock = %s, Count = %d\n", tran_index,
+			   slot->class_oid.volid, slot->class_oid.pageid, slot->class_oid.slotid,
+			   LOCK_TO_LOCKMODE_STRING (slot->granted_mode), slot->count);
+		}
+	    }
+	  pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+	}
+      fprintf (outfp, "\n");
+    }
+
   /* Reset the wait back to the way it was */
   (void) xlogtb_reset_wait_msecs (thread_p, old_wait_msecs);
 
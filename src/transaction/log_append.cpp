@@ -71,6 +71,7 @@ static int prior_lsa_copy_redo_crumbs_to_node (LOG_PRIOR_NODE *node, int num_cru
 static void prior_lsa_start_append (THREAD_ENTRY *thread_p, LOG_PRIOR_NODE *node, LOG_TDES *tdes);
 static void prior_lsa_end_append (THREAD_ENTRY *thread_p, LOG_PRIOR_NODE *node);
 static void prior_lsa_append_data (int length);
+static LOG_LSA prior_lsa_append_to_list (THREAD_ENTRY *thread_p, LOG_PRIOR_NODE *node, LOG_TDES *tdes);
 static LOG_LSA prior_lsa_next_record_internal (THREAD_ENTRY *thread_p, LOG_PRIOR_NODE *node, LOG_TDES *tdes,
     int with_lock);
 static LOG_ZIP *log_append_get_zip_undo (THREAD_ENTRY *thread_p);
@@ -123,6 +124,7 @@ log_prior_lsa_info::log_prior_lsa_info ()
   , list_size (0)
   , prior_flush_list_header (NULL)
   , prior_lsa_mutex ()
+  , prior_combiner ()
 {
 }
 
@@ -283,6 +285,11 @@ prior_lsa_alloc_and_copy_data (THREAD_ENTRY *thread_p, LOG_RECTYPE rec_type, LOG
   LOG_PRIOR_NODE *node;
   int error_code = NO_ERROR;
 
+  if (logtb_check_tran_owner (thread_p) != NO_ERROR)
+    {
+      return NULL;
+    }
+
   node = (LOG_PRIOR_NODE *) malloc (sizeof (LOG_PRIOR_NODE));
   if (node == NULL)
     {
@@ -425,6 +432,11 @@ prior_lsa_alloc_and_copy_crumbs (THREAD_ENTRY *thread_p, LOG_RECTYPE rec_type, L
   LOG_PRIOR_NODE *node;
   int error = NO_ERROR;
 
+  if (logtb_check_tran_owner (thread_p) != NO_ERROR)
+    {
+      return NULL;
+    }
+
   node = (LOG_PRIOR_NODE *) malloc (sizeof (LOG_PRIOR_NODE));
   if (node == NULL)
     {
@@ -1338,16 +1350,17 @@ prior_lsa_gen_record (THREAD_ENTRY *thread_p, LOG_PRIOR_NODE *node, LOG_RECTYPE
 }
 
 /*
- * prior_lsa_next_record_internal -
+ * prior_lsa_append_to_list - reserve lsa for log record and append it to prior list
  *
  * return: start lsa of log record
  *
  *   node(in/out):
  *   tdes(in/out):
- *   with_lock(in):
+ *
+ * NOTE: caller must hold prior_lsa_mutex. tdes may belong to another thread, which waits for its record to be appended.
  */
 static LOG_LSA
-prior_lsa_next_record_internal (THREAD_ENTRY *thread_p, LOG_PRIOR_NODE *node, LOG_TDES *tdes, int with_lock)
+prior_lsa_append_to_list (THREAD_ENTRY *thread_p, LOG_PRIOR_NODE *node, LOG_TDES *tdes)
 {
   LOG_LSA start_lsa;
   LOG_REC_MVCC_UNDO *mvcc_undo = NULL;
@@ -1355,11 +1368,6 @@ prior_lsa_next_record_internal (THREAD_ENTRY *thread_p, LOG_PRIOR_NODE *node, LO
   LOG_VACUUM_INFO *vacuum_info = NULL;
   MVCCID mvccid = MVCCID_NULL;
 
-  if (with_lock == LOG_PRIOR_LSA_WITHOUT_LOCK)
-    {
-      log_Gl.prior_info.prior_lsa_mutex.lock ();
-    }
-
   prior_lsa_start_append (thread_p, node, tdes);
 
   LSA_COPY (&start_lsa, &node->start_lsa);
@@ -1519,10 +1527,41 @@ prior_lsa_next_record_internal (THREAD_ENTRY *thread_p, LOG_PRIOR_NODE *node, LO
   /* list_size in bytes */
   log_Gl.prior_info.list_size += (sizeof (LOG_PRIOR_NODE) + node->data_header_length + node->ulength + node->rlength);
 
-  if (with_lock == LOG_PRIOR_LSA_WITHOUT_LOCK)
+  return start_lsa;
+}
+
+/*
+ * prior_lsa_next_record_internal -
+ *
+ * return: start lsa of log record
+ *
+ *   node(in/out):
+ *   tdes(in/out):
+ *   with_lock(in):
+ */
+static LOG_LSA
+prior_lsa_next_record_internal (THREAD_ENTRY *thread_p, LOG_PRIOR_NODE *node, LOG_TDES *tdes, int with_lock)
+{
+  LOG_PRIOR_APPEND_REQUEST request;
+  auto append_func = [thread_p] (LOG_PRIOR_APPEND_REQUEST & pending)
+  {
+    pending.start_lsa = prior_lsa_append_to_list (thread_p, pending.node, pending.tdes);
+  };
+
+  if (with_lock == LOG_PRIOR_LSA_WITH_LOCK)
     {
-      log_Gl.prior_info.prior_lsa_mutex.unlock ();
+      request.start_lsa = prior_lsa_append_to_list (thread_p, node, tdes);
+    }
+  else
+    {
+      request.node = node;
+      request.tdes = tdes;
+      LSA_SET_NULL (&request.start_lsa);
 
+      /* concurrent appends are done in groups by the thread that gets prior_lsa_mutex */
+      log_Gl.prior_info.prior_combiner.append (log_Gl.prior_info.prior_lsa_mutex, request, append_func);
+
+      /* node may be already consumed by log flush */
       if (log_Gl.prior_info.list_size >= (INT64) logpb_get_memsize ())
 	{
 	  perfmon_inc_stat (thread_p, PSTAT_PRIOR_LSA_LIST_MAXED);
@@ -1550,7 +1589,7 @@ prior_lsa_next_record_internal (THREAD_ENTRY *thread_p, LOG_PRIOR_NODE *node, LO
 
   tdes->num_log_records_written++;
 
-  return start_lsa;
+  return request.start_lsa;
 }
 
 LOG_LSA
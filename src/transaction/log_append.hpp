@@ -28,6 +28,7 @@
 #error Wrong module
 #endif
 
+#include "log_append_combiner.hpp"
 #include "log_lsa.hpp"
 #include "log_record.hpp"
 #include "log_storage.hpp"
@@ -104,6 +105,15 @@ struct log_prior_node
   LOG_PRIOR_NODE *next;
 };
 
+/* append of a node to prior list, possibly done by another thread (see log_append_combiner) */
+typedef struct log_prior_append_request LOG_PRIOR_APPEND_REQUEST;
+struct log_prior_append_request
+{
+  LOG_PRIOR_NODE *node;
+  log_tdes *tdes;
+  LOG_LSA start_lsa;		/* output: start lsa of log record */
+};
+
 typedef struct log_prior_lsa_info LOG_PRIOR_LSA_INFO;
 struct log_prior_lsa_info
 {
@@ -120,6 +130,7 @@ struct log_prior_lsa_info
   LOG_PRIOR_NODE *prior_flush_list_header;
 
   std::mutex prior_lsa_mutex;
+  log_append_combiner<LOG_PRIOR_APPEND_REQUEST> prior_combiner;	/* appends without lock are combined */
 
   log_prior_lsa_info ();
 };
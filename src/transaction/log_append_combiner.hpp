@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// log_append_combiner - combine concurrent appends to prior list under one acquisition of prior_lsa_mutex
+//
+//  how it works:
+//    an appender publishes its request in a lock-free stack and tries to take the mutex. whoever gets the mutex takes
+//    all published requests and appends them in the order they were published, on behalf of their owners; the owners
+//    only wait for their request to be marked done. under contention, one acquisition of the mutex appends a whole
+//    group of records, instead of handing the mutex from thread to thread for each of them.
+//
+//    everything the mutex protected before is still done under mutex: LSA reservation, links of the transaction,
+//    vacuum MVCC op chain and recovery LSA's of the transaction. appends that already hold the mutex (with lock) go
+//    straight to the list.
+//
+//    the request, with its result, belongs to the appender; the combiner must not touch it after it was marked done.
+//    the appender is blocked until then, so its transaction descriptor can be changed by the combiner.
+//
+
+#ifndef _LOG_APPEND_COMBINER_HPP_
+#define _LOG_APPEND_COMBINER_HPP_
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+template <typename Request>
+class log_append_combiner
+{
+  public:
+    log_append_combiner ();
+    log_append_combiner (const log_append_combiner &) = delete;
+    log_append_combiner &operator= (const log_append_combiner &) = delete;
+
+    // append request; func (request) is called under mutex, by this thread or by another appender
+    template <typename Func>
+    void append (std::mutex &mutex, Request &request, Func &&func);
+
+  private:
+    struct pending_request
+    {
+      Request *m_request;
+      pending_request *m_next;
+      std::atomic<bool> m_is_done;
+    };
+
+    // number of times a waiter tries the mutex and yields, before it blocks on it
+    static const int SPIN_COUNT = 64;
+
+    template <typename Func>
+    void combine (Func &func);
+
+    std::atomic<pending_request *> m_pending_head;
+};
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Inline/templates
+//
+//////////////////////////////////////////////////////////////////////////
+
+template <typename Request>
+log_append_combiner<Request>::log_append_combiner ()
+  : m_pending_head (NULL)
+{
+}
+
+template <typename Request>
+template <typename Func>
+void
+log_append_combiner<Request>::append (std::mutex &mutex, Request &request, Func &&func)
+{
+  pending_request pending;
+  pending_request *head;
+
+  pending.m_request = &request;
+  pending.m_is_done.store (false, std::memory_order_relaxed);
+
+  head = m_pending_head.load (std::memory_order_relaxed);
+  do
+    {
+      pending.m_next = head;
+    }
+  while (!m_pending_head.compare_exchange_weak (head, &pending, std::memory_order_release, std::memory_order_relaxed));
+
+  for (int spins = 0; !pending.m_is_done.load (std::memory_order_acquire); spins++)
+    {
+      if (spins < SPIN_COUNT)
+	{
+	  if (!mutex.try_lock ())
+	    {
+	      // a combiner may be appending our request
+	      std::this_thread::yield ();
+	      continue;
+	    }
+	}
+      else
+	{
+	  // mutex is held for long (e.g. by checkpoint); stop spinning
+	  mutex.lock ();
+	}
+
+      // our request is either appended by now or it is in the stack; it is done after combine
+      combine (func);
+      mutex.unlock ();
+    }
+}
+
+template <typename Request>
+template <typename Func>
+void
+log_append_combiner<Request>::combine (Func &func)
+{
+  pending_request *stack;
+  pending_request *list = NULL;
+  pending_request *next;
+
+  stack = m_pending_head.exchange (NULL, std::memory_order_acquire);
+
+  // stack is last published first; reverse it
+  while (stack != NULL)
+    {
+      next = stack->m_next;
+      stack->m_next = list;
+      list = stack;
+      stack = next;
+    }
+
+  while (list != NULL)
+    {
+      // once done, the owner may return and release the request
+      next = list->m_next;
+      func (*list->m_request);
+      list->m_is_done.store (true, std::memory_order_release);
+      list = next;
+    }
+}
+
+#endif // _LOG_APPEND_COMBINER_HPP_
@@ -3492,6 +3492,11 @@ log_sysop_start (THREAD_ENTRY * thread_p)
       thread_p = thread_get_thread_entry_info ();
     }
 
+  if (logtb_check_tran_owner (thread_p) != NO_ERROR)
+    {
+      return;
+    }
+
   tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
   tdes = LOG_FIND_TDES (tran_index);
   if (tdes == NULL)
@@ -3689,6 +3689,7 @@ logpb_flush_pages (THREAD_ENTRY * thread_p, LOG_LSA * flush_lsa)
   bool async_commit, group_commit;
   LOG_LSA nxio_lsa;
   LOG_GROUP_COMMIT_INFO *group_commit_info = &log_Gl.group_commit_info;
+  PERF_UTIME_TRACKER time_track = PERF_UTIME_TRACKER_INITIALIZER;
 
   assert (flush_lsa != NULL && !LSA_ISNULL (flush_lsa));
 
@@ -3760,6 +3761,11 @@ logpb_flush_pages (THREAD_ENTRY * thread_p, LOG_LSA * flush_lsa)
 	  need_wakeup_LFT = true;
 	}
 
+      if (LSA_LT (&nxio_lsa, flush_lsa))
+	{
+	  /* only commits that wait are counted */
+	  PERF_UTIME_TRACKER_START (thread_p, &time_track);
+	}
       while (LSA_LT (&nxio_lsa, flush_lsa))
 	{
 	  gettimeofday (&start_time, NULL);
@@ -3784,6 +3790,7 @@ logpb_flush_pages (THREAD_ENTRY * thread_p, LOG_LSA * flush_lsa)
 	  need_wakeup_LFT = true;
 	  nxio_lsa = log_Gl.append.get_nxio_lsa ();
 	}
+      PERF_UTIME_TRACKER_LATENCY (thread_p, &time_track, PERFMON_LATENCY_LOG_FLUSH_WAIT);
     }
 #endif /* SERVER_MODE */
 }
@@ -26,6 +26,9 @@
 #include "config.h"
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <unordered_set>
 #include <stdio.h>
 #include <stddef.h>
@@ -54,6 +57,7 @@
 #include "porting_inline.hpp"
 #include "log_compress.h"
 #include "thread_entry.hpp"
+#include "thread_entry_task.hpp"
 #include "thread_manager.hpp"
 
 static void log_rv_undo_record (THREAD_ENTRY * thread_p, LOG_LSA * log_lsa, LOG_PAGE * log_page_p,
@@ -62,6 +66,18 @@ static void log_rv_undo_record (THREAD_ENTRY * thread_p, LOG_LSA * log_lsa, LOG_
 static void log_rv_redo_record (THREAD_ENTRY * thread_p, LOG_LSA * log_lsa, LOG_PAGE * log_page_p,
 				int (*redofun) (THREAD_ENTRY * thread_p, LOG_RCV *), LOG_RCV * rcv,
 				LOG_LSA * rcv_lsa_ptr, int undo_length, char *undo_data, LOG_ZIP * redo_unzip_ptr);
+static bool log_rv_read_redo_data (THREAD_ENTRY * thread_p, LOG_LSA * log_lsa, LOG_PAGE * log_page_p, LOG_RCV * rcv,
+				   int undo_length, char *undo_data, LOG_ZIP * redo_unzip_ptr, char **area_p);
+static void log_rv_apply_redo (THREAD_ENTRY * thread_p, int (*redofun) (THREAD_ENTRY * thread_p, LOG_RCV *),
+			       LOG_RCV * rcv, const LOG_LSA * rcv_lsa_ptr);
+static void log_rv_redo_page (THREAD_ENTRY * thread_p, const VPID * rcv_vpid, LOG_RCVINDEX rcvindex, LOG_RCV * rcv,
+			      const LOG_LSA * rcv_lsa_ptr);
+static void log_rv_redo_parallel_start (THREAD_ENTRY * thread_p);
+static void log_rv_redo_parallel_stop (THREAD_ENTRY * thread_p);
+static bool log_rv_redo_parallel_is_on (void);
+static void log_rv_redo_parallel_wait (THREAD_ENTRY * thread_p, size_t max_pending);
+static void log_rv_redo_parallel_dispatch (THREAD_ENTRY * thread_p, const VPID * rcv_vpid, LOG_RCVINDEX rcvindex,
+					   LOG_RCV * rcv, const LOG_LSA * rcv_lsa_ptr);
 static bool log_rv_find_checkpoint (THREAD_ENTRY * thread_p, VOLID volid, LOG_LSA * rcv_lsa);
 static bool log_rv_get_unzip_log_data (THREAD_ENTRY * thread_p, int length, LOG_LSA * log_lsa, LOG_PAGE * log_page_p,
 				       LOG_ZIP * undo_unzip_ptr);
@@ -435,11 +451,47 @@ log_rv_redo_record (THREAD_ENTRY * thread_p, LOG_LSA * log_lsa, LOG_PAGE * log_p
 		    int undo_length, char *undo_data, LOG_ZIP * redo_unzip_ptr)
 {
   char *area = NULL;
-  bool is_zip = false;
-  int error_code;
 
   /* Note the the data page rcv->pgptr has been fetched by the caller */
 
+  if (!log_rv_read_redo_data (thread_p, log_lsa, log_page_p, rcv, undo_length, undo_data, redo_unzip_ptr, &area))
+    {
+      return;
+    }
+
+  log_rv_apply_redo (thread_p, redofun, rcv, rcv_lsa_ptr);
+
+  if (area != NULL)
+    {
+      free_and_init (area);
+    }
+}
+
+/*
+ * log_rv_read_redo_data - read the redo data of a log record into the recovery structure
+ *
+ * return: false if data could not be read, true otherwise
+ *
+ *   log_lsa(in/out): Log address identifier containing the log record
+ *   log_page_p(in/out): Pointer to page where data starts (Set as a side
+ *               effect to the page where data ends)
+ *   rcv(in/out): Recovery structure; data and length are set as a side effect
+ *   undo_length(in): length of undo data for diff records
+ *   undo_data(in): undo data for diff records
+ *   redo_unzip_ptr(in): unzip buffer
+ *   area_p(out): allocated area that must be freed by the caller, or NULL
+ *
+ * NOTE: rcv->data may point to log_page_p or to redo_unzip_ptr, it is valid only until these are reused.
+ */
+static bool
+log_rv_read_redo_data (THREAD_ENTRY * thread_p, LOG_LSA * log_lsa, LOG_PAGE * log_page_p, LOG_RCV * rcv,
+		       int undo_length, char *undo_data, LOG_ZIP * redo_unzip_ptr, char **area_p)
+{
+  char *area = NULL;
+  bool is_zip = false;
+
+  *area_p = NULL;
+
   /*
    * If data is contained in only one buffer, pass pointer directly.
    * Otherwise, allocate a contiguous area, copy the data and pass this area.
@@ -463,11 +515,12 @@ log_rv_redo_record (THREAD_ENTRY * thread_p, LOG_LSA * log_lsa, LOG_PAGE * log_p
       if (area == NULL)
 	{
 	  logpb_fatal_error (thread_p, true, ARG_FILE_LINE, "log_rvredo_rec");
-	  return;
+	  return false;
 	}
       /* Copy the data */
       logpb_copy_from_log (thread_p, area, rcv->length, log_lsa, log_page_p);
       rcv->data = area;
+      *area_p = area;
     }
 
   if (is_zip)
@@ -492,6 +545,24 @@ log_rv_redo_record (THREAD_ENTRY * thread_p, LOG_LSA * log_lsa, LOG_PAGE * log_p
 	}
     }
 
+  return true;
+}
+
+/*
+ * log_rv_apply_redo - apply redo data to the page fixed in the recovery structure
+ *
+ * return: nothing
+ *
+ *   redofun(in): Function to invoke to redo the data
+ *   rcv(in/out): Recovery structure for recovery function
+ *   rcv_lsa_ptr(in): Reset data page (rcv->pgptr) to this LSA
+ */
+static void
+log_rv_apply_redo (THREAD_ENTRY * thread_p, int (*redofun) (THREAD_ENTRY * thread_p, LOG_RCV *), LOG_RCV * rcv,
+		   const LOG_LSA * rcv_lsa_ptr)
+{
+  int error_code;
+
   if (redofun != NULL)
     {
       error_code = (*redofun) (thread_p, rcv);
@@ -526,11 +597,276 @@ log_rv_redo_record (THREAD_ENTRY * thread_p, LOG_LSA * log_lsa, LOG_PAGE * log_p
     {
       (void) pgbuf_set_lsa (thread_p, rcv->pgptr, rcv_lsa_ptr);
     }
+}
 
-  if (area != NULL)
+/*
+ * log_rv_redo_page - fix the page of a redo record and apply the redo if the page is not already up to date
+ *
+ * return: nothing
+ *
+ *   rcv_vpid(in): page to redo
+ *   rcvindex(in): recovery index of log record
+ *   rcv(in/out): Recovery structure with redo data; rcv->pgptr is set and released as a side effect
+ *   rcv_lsa_ptr(in): LSA of log record
+ */
+static void
+log_rv_redo_page (THREAD_ENTRY * thread_p, const VPID * rcv_vpid, LOG_RCVINDEX rcvindex, LOG_RCV * rcv,
+		  const LOG_LSA * rcv_lsa_ptr)
+{
+  rcv->pgptr = log_rv_redo_fix_page (thread_p, rcv_vpid, rcvindex);
+  if (rcv->pgptr == NULL)
     {
-      free_and_init (area);
+      /* deallocated */
+      return;
     }
+
+  if (LSA_LE (rcv_lsa_ptr, pgbuf_get_lsa (rcv->pgptr)))
+    {
+      /* It is already done */
+      pgbuf_unfix_and_init (thread_p, rcv->pgptr);
+      return;
+    }
+
+  log_rv_apply_redo (thread_p, RV_fun[rcvindex].redofun, rcv, rcv_lsa_ptr);
+
+  pgbuf_unfix_and_init (thread_p, rcv->pgptr);
+}
+
+/*
+ * PARALLEL REDO
+ *
+ * When recovery_redo_parallel_count is set, the recovery thread keeps reading and decoding the log, but redo records
+ * that change a single page (see rv_is_parallel_redo) are handed to a pool of redo workers. The worker is chosen by
+ * hashing the page VPID and each worker executes its tasks in FIFO order, so all records of a page are redone by the
+ * same worker and in LSA order, while different pages are redone concurrently.
+ *
+ * All other records that change pages are applied by the recovery thread after waiting for all pending page redo to
+ * finish. The same barrier is used at the end of redo phase.
+ */
+
+#define LOG_RV_REDO_PARALLEL_MAX_PENDING_PER_WORKER 1024
+
+// *INDENT-OFF*
+class log_rv_redo_task : public cubthread::entry_task
+{
+  public:
+    log_rv_redo_task (const VPID &rcv_vpid, LOG_RCVINDEX rcvindex, const LOG_RCV &rcv, const LOG_LSA &rcv_lsa,
+		      char *data)
+      : m_rcv_vpid (rcv_vpid)
+      , m_rcvindex (rcvindex)
+      , m_rcv (rcv)
+      , m_rcv_lsa (rcv_lsa)
+      , m_data (data)
+    {
+      m_rcv.data = m_data;
+    }
+
+    ~log_rv_redo_task ()
+    {
+      free (m_data);
+    }
+
+    void execute (context_type &thread_ref) final;
+
+  private:
+    VPID m_rcv_vpid;
+    LOG_RCVINDEX m_rcvindex;
+    LOG_RCV m_rcv;
+    LOG_LSA m_rcv_lsa;
+    char *m_data;		/* owned copy of redo data */
+};
+
+struct log_rv_redo_parallel
+{
+  cubthread::entry_workpool *worker_pool;
+  size_t worker_count;
+
+  std::mutex pending_mutex;
+  std::condition_variable pending_cond;
+  size_t pending_count;
+  size_t wait_max_pending;	/* recovery thread waits until pending_count drops to this value */
+  bool is_waiting;
+
+  /* counters to compare parallel and serial redo */
+  INT64 parallel_records;
+  INT64 serial_records;
+  INT64 barrier_count;
+  std::chrono::steady_clock::time_point start_time;
+};
+
+static log_rv_redo_parallel log_Rv_redo_parallel;
+
+void
+log_rv_redo_task::execute (context_type &thread_ref)
+{
+  LOG_SET_CURRENT_TRAN_INDEX (&thread_ref, LOG_SYSTEM_TRAN_INDEX);
+
+  log_rv_redo_page (&thread_ref, &m_rcv_vpid, m_rcvindex, &m_rcv, &m_rcv_lsa);
+
+  std::unique_lock<std::mutex> ulock (log_Rv_redo_parallel.pending_mutex);
+  assert (log_Rv_redo_parallel.pending_count > 0);
+  log_Rv_redo_parallel.pending_count--;
+  if (log_Rv_redo_parallel.is_waiting && log_Rv_redo_parallel.pending_count <= log_Rv_redo_parallel.wait_max_pending)
+    {
+      ulock.unlock ();
+      log_Rv_redo_parallel.pending_cond.notify_one ();
+    }
+}
+// *INDENT-ON*
+
+/*
+ * log_rv_redo_parallel_start - start redo workers if parallel redo is configured
+ *
+ * return: nothing
+ */
+static void
+log_rv_redo_parallel_start (THREAD_ENTRY * thread_p)
+{
+  int worker_count = prm_get_integer_value (PRM_ID_RECOVERY_REDO_PARALLEL_COUNT);
+
+  log_Rv_redo_parallel.worker_pool = NULL;
+  log_Rv_redo_parallel.worker_count = 0;
+  log_Rv_redo_parallel.pending_count = 0;
+  log_Rv_redo_parallel.wait_max_pending = 0;
+  log_Rv_redo_parallel.is_waiting = false;
+  log_Rv_redo_parallel.parallel_records = 0;
+  log_Rv_redo_parallel.serial_records = 0;
+  log_Rv_redo_parallel.barrier_count = 0;
+  log_Rv_redo_parallel.start_time = std::chrono::steady_clock::now ();
+
+  if (worker_count > 1)
+    {
+      /* one worker per core, so tasks of the same page are executed in order. in SA_MODE the pool is not created
+       * and redo is serial. */
+      log_Rv_redo_parallel.worker_pool =
+	cubthread::get_manager ()->create_worker_pool (worker_count,
+						       worker_count * LOG_RV_REDO_PARALLEL_MAX_PENDING_PER_WORKER,
+						       "log_recovery_redo_workers", NULL, worker_count, false);
+      if (log_Rv_redo_parallel.worker_pool != NULL)
+	{
+	  log_Rv_redo_parallel.worker_count = worker_count;
+	}
+    }
+}
+
+/*
+ * log_rv_redo_parallel_stop - wait for all pending redo, stop redo workers and report redo counters
+ *
+ * return: nothing
+ */
+static void
+log_rv_redo_parallel_stop (THREAD_ENTRY * thread_p)
+{
+  INT64 elapsed_msec;
+
+  if (log_Rv_redo_parallel.worker_pool != NULL)
+    {
+      log_rv_redo_parallel_wait (thread_p, 0);
+      cubthread::get_manager ()->destroy_worker_pool (log_Rv_redo_parallel.worker_pool);
+    }
+
+  // *INDENT-OFF*
+  elapsed_msec = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now ()
+									 - log_Rv_redo_parallel.start_time).count ();
+  // *INDENT-ON*
+
+  er_set (ER_NOTIFICATION_SEVERITY, ARG_FILE_LINE, ER_LOG_RECOVERY_REDO_STATS, 5, (long long int) elapsed_msec,
+	  (int) log_Rv_redo_parallel.worker_count, (long long int) log_Rv_redo_parallel.parallel_records,
+	  (long long int) log_Rv_redo_parallel.serial_records, (long long int) log_Rv_redo_parallel.barrier_count);
+
+  log_Rv_redo_parallel.worker_pool = NULL;
+  log_Rv_redo_parallel.worker_count = 0;
+}
+
+/*
+ * log_rv_redo_parallel_is_on - are redo workers running?
+ *
+ * return: true if page redo records are dispatched to redo workers
+ */
+static bool
+log_rv_redo_parallel_is_on (void)
+{
+  return log_Rv_redo_parallel.worker_pool != NULL;
+}
+
+/*
+ * log_rv_redo_parallel_wait - wait until redo workers have at most max_pending records left to redo
+ *
+ * return: nothing
+ *
+ *   max_pending(in): 0 to wait for all dispatched records to be redone
+ */
+static void
+log_rv_redo_parallel_wait (THREAD_ENTRY * thread_p, size_t max_pending)
+{
+  if (log_Rv_redo_parallel.worker_pool == NULL)
+    {
+      return;
+    }
+
+  // *INDENT-OFF*
+  std::unique_lock<std::mutex> ulock (log_Rv_redo_parallel.pending_mutex);
+  if (max_pending == 0 && log_Rv_redo_parallel.pending_count > 0)
+    {
+      log_Rv_redo_parallel.barrier_count++;
+    }
+  /* workers notify only while somebody waits and only when pending_count reached the value waited for */
+  log_Rv_redo_parallel.wait_max_pending = max_pending;
+  log_Rv_redo_parallel.is_waiting = true;
+  log_Rv_redo_parallel.pending_cond.wait (ulock, [max_pending] {
+    return log_Rv_redo_parallel.pending_count <= max_pending;
+  });
+  log_Rv_redo_parallel.is_waiting = false;
+  // *INDENT-ON*
+}
+
+/*
+ * log_rv_redo_parallel_dispatch - hand a page redo record to the redo worker of its page
+ *
+ * return: nothing
+ *
+ *   rcv_vpid(in): page to redo
+ *   rcvindex(in): recovery index of log record
+ *   rcv(in): Recovery structure with redo data; data is copied
+ *   rcv_lsa_ptr(in): LSA of log record
+ */
+static void
+log_rv_redo_parallel_dispatch (THREAD_ENTRY * thread_p, const VPID * rcv_vpid, LOG_RCVINDEX rcvindex, LOG_RCV * rcv,
+			       const LOG_LSA * rcv_lsa_ptr)
+{
+  char *data = NULL;
+  log_rv_redo_task *task = NULL;
+  size_t max_pending;
+
+  assert (log_rv_redo_parallel_is_on ());
+
+  if (rcv->length > 0)
+    {
+      data = (char *) malloc (rcv->length);
+      if (data == NULL)
+	{
+	  /* redo it here */
+	  log_rv_redo_parallel_wait (thread_p, 0);
+	  log_rv_redo_page (thread_p, rcv_vpid, rcvindex, rcv, rcv_lsa_ptr);
+	  log_Rv_redo_parallel.serial_records++;
+	  return;
+	}
+      memcpy (data, rcv->data, rcv->length);
+    }
+
+  /* do not let the workers fall too far behind */
+  max_pending = log_Rv_redo_parallel.worker_count * LOG_RV_REDO_PARALLEL_MAX_PENDING_PER_WORKER;
+  log_rv_redo_parallel_wait (thread_p, max_pending - 1);
+
+  task = new log_rv_redo_task (*rcv_vpid, rcvindex, *rcv, *rcv_lsa_ptr, data);
+
+  log_Rv_redo_parallel.pending_mutex.lock ();
+  log_Rv_redo_parallel.pending_count++;
+  log_Rv_redo_parallel.pending_mutex.unlock ();
+  log_Rv_redo_parallel.parallel_records++;
+
+  cubthread::get_manager ()->push_task_on_core (log_Rv_redo_parallel.worker_pool, task,
+						pgbuf_hash_vpid (rcv_vpid, (unsigned int) log_Rv_redo_parallel.worker_count));
 }
 
 /*
@@ -3064,6 +3400,7 @@ log_recovery_redo (THREAD_ENTRY * thread_p, const LOG_LSA * start_redolsa, const
   LOG_ZIP *redo_unzip_ptr = NULL;
   bool is_diff_rec;
   bool is_mvcc_op = false;
+  bool is_parallel_redo = false;
 
   aligned_log_pgbuf = PTR_ALIGN (log_pgbuf, MAX_ALIGNMENT);
 
@@ -3105,6 +3442,8 @@ log_recovery_redo (THREAD_ENTRY * thread_p, const LOG_LSA * start_redolsa, const
       return;
     }
 
+  log_rv_redo_parallel_start (thread_p);
+
   while (!LSA_ISNULL (&lsa))
     {
       /* Fetch the page where the LSA record to undo is located */
@@ -3277,8 +3616,14 @@ log_recovery_redo (THREAD_ENTRY * thread_p, const LOG_LSA * start_redolsa, const
 
 	      rcv.pgptr = NULL;
 	      rcvindex = undoredo->data.rcvindex;
-	      /* If the page does not exit, there is nothing to redo */
-	      if (rcv_vpid.pageid != NULL_PAGEID && rcv_vpid.volid != NULL_VOLID)
+	      is_parallel_redo = log_rv_redo_parallel_is_on () && rv_is_parallel_redo (&rcv_vpid, rcvindex);
+	      if (!is_parallel_redo)
+		{
+		  /* page is redone by this thread; all previously dispatched redo must be done first */
+		  log_rv_redo_parallel_wait (thread_p, 0);
+		}
+	      /* If the page does not exit, there is nothing to redo; if redo is parallel, the worker checks the page */
+	      if (!is_parallel_redo && rcv_vpid.pageid != NULL_PAGEID && rcv_vpid.volid != NULL_VOLID)
 		{
 		  rcv.pgptr = log_rv_redo_fix_page (thread_p, &rcv_vpid, rcvindex);
 		  if (rcv.pgptr == NULL)
@@ -3387,6 +3732,31 @@ log_recovery_redo (THREAD_ENTRY * thread_p, const LOG_LSA * start_redolsa, const
 		}
 #endif /* !NDEBUG */
 
+	      if (is_parallel_redo)
+		{
+		  char *area = NULL;
+
+		  if (is_diff_rec)
+		    {
+		      /* XOR Process */
+		      if (log_rv_read_redo_data (thread_p, &log_lsa, log_pgptr, &rcv, (int) undo_unzip_ptr->data_length,
+						 (char *) undo_unzip_ptr->log_data, redo_unzip_ptr, &area))
+			{
+			  log_rv_redo_parallel_dispatch (thread_p, &rcv_vpid, rcvindex, &rcv, &rcv_lsa);
+			}
+		    }
+		  else if (log_rv_read_redo_data (thread_p, &log_lsa, log_pgptr, &rcv, 0, NULL, redo_unzip_ptr, &area))
+		    {
+		      log_rv_redo_parallel_dispatch (thread_p, &rcv_vpid, rcvindex, &rcv, &rcv_lsa);
+		    }
+		  if (area != NULL)
+		    {
+		      free_and_init (area);
+		    }
+		  break;
+		}
+
+	      log_Rv_redo_parallel.serial_records++;
 	      if (is_diff_rec)
 		{
 		  /* XOR Process */
@@ -3463,8 +3833,14 @@ log_recovery_redo (THREAD_ENTRY * thread_p, const LOG_LSA * start_redolsa, const
 
 	      rcv.pgptr = NULL;
 	      rcvindex = redo->data.rcvindex;
-	      /* If the page does not exit, there is nothing to redo */
-	      if (rcv_vpid.pageid != NULL_PAGEID && rcv_vpid.volid != NULL_VOLID)
+	      is_parallel_redo = log_rv_redo_parallel_is_on () && rv_is_parallel_redo (&rcv_vpid, rcvindex);
+	      if (!is_parallel_redo)
+		{
+		  /* page is redone by this thread; all previously dispatched redo must be done first */
+		  log_rv_redo_parallel_wait (thread_p, 0);
+		}
+	      /* If the page does not exit, there is nothing to redo; if redo is parallel, the worker checks the page */
+	      if (!is_parallel_redo && rcv_vpid.pageid != NULL_PAGEID && rcv_vpid.volid != NULL_VOLID)
 		{
 		  rcv.pgptr = log_rv_redo_fix_page (thread_p, &rcv_vpid, rcvindex);
 		  if (rcv.pgptr == NULL)
@@ -3520,6 +3896,22 @@ log_recovery_redo (THREAD_ENTRY * thread_p, const LOG_LSA * start_redolsa, const
 		}
 #endif /* !NDEBUG */
 
+	      if (is_parallel_redo)
+		{
+		  char *area = NULL;
+
+		  if (log_rv_read_redo_data (thread_p, &log_lsa, log_pgptr, &rcv, 0, NULL, redo_unzip_ptr, &area))
+		    {
+		      log_rv_redo_parallel_dispatch (thread_p, &rcv_vpid, rcvindex, &rcv, &rcv_lsa);
+		    }
+		  if (area != NULL)
+		    {
+		      free_and_init (area);
+		    }
+		  break;
+		}
+
+	      log_Rv_redo_parallel.serial_records++;
 	      log_rv_redo_record (thread_p, &log_lsa, log_pgptr, RV_fun[rcvindex].redofun, &rcv, &rcv_lsa, 0, NULL,
 				  redo_unzip_ptr);
 
@@ -3542,6 +3934,9 @@ log_recovery_redo (THREAD_ENTRY * thread_p, const LOG_LSA * start_redolsa, const
 	      rcv.offset = -1;
 	      rcv.pgptr = NULL;
 
+	      log_rv_redo_parallel_wait (thread_p, 0);
+	      log_Rv_redo_parallel.serial_records++;
+
 	      rcvindex = dbout_redo->rcvindex;
 	      rcv.length = dbout_redo->length;
 
@@ -3581,6 +3976,7 @@ log_recovery_redo (THREAD_ENTRY * thread_p, const LOG_LSA * start_redolsa, const
 
 	      rcv.pgptr = NULL;
 	      rcvindex = run_posp->data.rcvindex;
+	      log_rv_redo_parallel_wait (thread_p, 0);
 	      /* If the page does not exit, there is nothing to redo */
 	      if (rcv_vpid.pageid != NULL_PAGEID && rcv_vpid.volid != NULL_VOLID)
 		{
@@ -3639,6 +4035,7 @@ log_recovery_redo (THREAD_ENTRY * thread_p, const LOG_LSA * start_redolsa, const
 		}
 #endif /* !NDEBUG */
 
+	      log_Rv_redo_parallel.serial_records++;
 	      log_rv_redo_record (thread_p, &log_lsa, log_pgptr, RV_fun[rcvindex].redofun, &rcv, &rcv_lsa, 0, NULL,
 				  NULL);
 
@@ -3668,6 +4065,7 @@ log_recovery_redo (THREAD_ENTRY * thread_p, const LOG_LSA * start_redolsa, const
 
 	      rcv.pgptr = NULL;
 	      rcvindex = compensate->data.rcvindex;
+	      log_rv_redo_parallel_wait (thread_p, 0);
 	      /* If the page does not exit, there is nothing to redo */
 	      if (rcv_vpid.pageid != NULL_PAGEID && rcv_vpid.volid != NULL_VOLID)
 		{
@@ -3725,6 +4123,7 @@ log_recovery_redo (THREAD_ENTRY * thread_p, const LOG_LSA * start_redolsa, const
 		}
 #endif /* !NDEBUG */
 
+	      log_Rv_redo_parallel.serial_records++;
 	      log_rv_redo_record (thread_p, &log_lsa, log_pgptr, RV_fun[rcvindex].undofun, &rcv, &rcv_lsa, 0, NULL,
 				  NULL);
 	      if (rcv.pgptr != NULL)
@@ -4075,6 +4474,9 @@ log_recovery_redo (THREAD_ENTRY * thread_p, const LOG_LSA * start_redolsa, const
   log_zip_free (undo_unzip_ptr);
   log_zip_free (redo_unzip_ptr);
 
+  /* all page redo must be done before aborting system operations and finishing postpones */
+  log_rv_redo_parallel_stop (thread_p);
+
   log_Gl.mvcc_table.reset_start_mvccid ();
 
   /* Abort all atomic system operations that were open when server crashed */
@@ -4090,6 +4492,10 @@ log_recovery_redo (THREAD_ENTRY * thread_p, const LOG_LSA * start_redolsa, const
   (void) pgbuf_flush_all (thread_p, NULL_VOLID);
 
 exit:
+  if (log_rv_redo_parallel_is_on ())
+    {
+      log_rv_redo_parallel_stop (thread_p);
+    }
   LSA_SET_NULL (&log_Gl.unique_stats_table.curr_rcv_rec_lsa);
 
   return;
@@ -3898,6 +3898,36 @@ logtb_find_current_mvccid (THREAD_ENTRY * thread_p)
   return id;
 }
 
+/*
+ * logtb_check_tran_owner - check that the thread may change its transaction
+ *
+ * return: NO_ERROR, or ER_PARALLEL_WORKER_CHANGES_TRAN if the thread is a parallel worker
+ *
+ *   thread_p(in): thread entry
+ *
+ * Note: a parallel worker shares the transaction of the thread that handed it work (see thread_share_tran), so it is
+ *	 interrupted together with the transaction. Sharing is safe only because workers read, with the snapshot that
+ *	 was taken before they started; locks, log records, MVCC ids, snapshots and temporary files are the business of
+ *	 the owner thread. This check is placed where those are acquired.
+ */
+int
+logtb_check_tran_owner (THREAD_ENTRY * thread_p)
+{
+  if (thread_p == NULL)
+    {
+      thread_p = thread_get_thread_entry_info ();
+    }
+
+  if (thread_is_tran_shared (thread_p))
+    {
+      assert_release (false);
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_PARALLEL_WORKER_CHANGES_TRAN, 1, thread_p->tran_index);
+      return ER_PARALLEL_WORKER_CHANGES_TRAN;
+    }
+
+  return NO_ERROR;
+}
+
 /*
  * logtb_get_current_mvccid - return current transaction MVCC id. Assign
  *			      a new ID if not previously set.
@@ -3920,6 +3950,10 @@ logtb_get_current_mvccid (THREAD_ENTRY * thread_p)
 
   if (MVCCID_IS_VALID (curr_mvcc_info->id) == false)
     {
+      if (logtb_check_tran_owner (thread_p) != NO_ERROR)
+	{
+	  return MVCCID_NULL;
+	}
       curr_mvcc_info->id = log_Gl.mvcc_table.get_new_mvccid ();
       tdes->get_replication_generator ().apply_tran_mvccid ();
     }
@@ -3989,6 +4023,11 @@ logtb_get_mvcc_snapshot (THREAD_ENTRY * thread_p)
 
   if (!tdes->mvccinfo.snapshot.valid)
     {
+      /* parallel workers read with the snapshot their owner took before handing work over */
+      if (logtb_check_tran_owner (thread_p) != NO_ERROR)
+	{
+	  return NULL;
+	}
       log_Gl.mvcc_table.build_mvcc_info (*tdes);
     }
 
@@ -832,6 +832,94 @@ rv_rcvindex_string (LOG_RCVINDEX rcvindex)
   return RV_fun[rcvindex].recv_string;
 }
 
+/*
+ * rv_is_parallel_redo - CAN REDO OF GIVEN RECORD BE APPLIED BY A PARALLEL REDO WORKER
+ *
+ * return: true if redo changes only the page the record was logged for, false otherwise
+ *
+ *   vpid(in): Page the record was logged for
+ *   rcvindex(in): Numeric recovery index
+ *
+ * NOTE: Every recovery index that may be redone in parallel is listed explicitly, so that new recovery indexes are
+ *       applied by the recovery thread until they are added here. Disk and file manager records, vacuum records,
+ *       logical records and records that update global recovery state are applied by the recovery thread after all
+ *       pending page redo is done.
+ */
+bool
+rv_is_parallel_redo (const VPID * vpid, LOG_RCVINDEX rcvindex)
+{
+  if (RCV_IS_LOGICAL_LOG (vpid, rcvindex))
+    {
+      return false;
+    }
+
+  switch (rcvindex)
+    {
+    case RVHF_CREATE_HEADER:
+    case RVHF_NEWPAGE:
+    case RVHF_STATS:
+    case RVHF_CHAIN:
+    case RVHF_INSERT:
+    case RVHF_DELETE:
+    case RVHF_UPDATE:
+    case RVHF_REUSE_PAGE:
+    case RVHF_REUSE_PAGE_REUSE_OID:
+    case RVHF_MARK_REUSABLE_SLOT:
+    case RVHF_MVCC_INSERT:
+    case RVHF_MVCC_DELETE_REC_HOME:
+    case RVHF_MVCC_DELETE_OVERFLOW:
+    case RVHF_MVCC_DELETE_REC_NEWHOME:
+    case RVHF_MVCC_DELETE_MODIFY_HOME:
+    case RVHF_MVCC_NO_MODIFY_HOME:
+    case RVHF_UPDATE_NOTIFY_VACUUM:
+    case RVHF_INSERT_NEWHOME:
+    case RVHF_MVCC_REDISTRIBUTE:
+    case RVHF_MVCC_UPDATE_OVERFLOW:
+
+    case RVOVF_NEWPAGE_INSERT:
+    case RVOVF_NEWPAGE_LINK:
+    case RVOVF_PAGE_UPDATE:
+    case RVOVF_CHANGE_LINK:
+
+    case RVEH_REPLACE:
+    case RVEH_INSERT:
+    case RVEH_DELETE:
+    case RVEH_INIT_BUCKET:
+    case RVEH_CONNECT_BUCKET:
+    case RVEH_INC_COUNTER:
+    case RVEH_INIT_DIR:
+    case RVEH_INIT_NEW_DIR_PAGE:
+
+    case RVBT_NDHEADER_UPD:
+    case RVBT_NDHEADER_INS:
+    case RVBT_NDRECORD_UPD:
+    case RVBT_NDRECORD_INS:
+    case RVBT_NDRECORD_DEL:
+    case RVBT_DEL_PGRECORDS:
+    case RVBT_GET_NEWPAGE:
+    case RVBT_COPYPAGE:
+    case RVBT_ROOTHEADER_UPD:
+    case RVBT_UPDATE_OVFID:
+    case RVBT_INS_PGRECORDS:
+    case RVBT_RECORD_MODIFY_UNDOREDO:
+    case RVBT_RECORD_MODIFY_NO_UNDO:
+    case RVBT_RECORD_MODIFY_COMPENSATE:
+    case RVBT_MARK_DEALLOC_PAGE:
+
+    case RVCT_NEWPAGE:
+    case RVCT_INSERT:
+    case RVCT_DELETE:
+    case RVCT_UPDATE:
+
+    case RVPGBUF_NEW_PAGE:
+    case RVPGBUF_COMPENSATE_DEALLOC:
+      return true;
+
+    default:
+      return false;
+    }
+}
+
 #if !defined (NDEBUG)
 /*
  * rv_check_rvfuns - CHECK ORDERING OF RECOVERY FUNCTIONS
@@ -222,6 +222,7 @@ struct rvfun
 extern struct rvfun RV_fun[];
 
 extern const char *rv_rcvindex_string (LOG_RCVINDEX rcvindex);
+extern bool rv_is_parallel_redo (const VPID * vpid, LOG_RCVINDEX rcvindex);
 #if !defined (NDEBUG)
 extern void rv_check_rvfuns (void);
 #endif /* !NDEBUG */
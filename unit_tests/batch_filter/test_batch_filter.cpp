@@ -0,0 +1,500 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/* own header */
+#include "test_batch_filter.hpp"
+
+/* header in same module */
+#include "test_perf_compare.hpp"
+
+/* headers from cubrid */
+#include "batch_filter.h"
+#include "dbtype.h"
+#include "numeric_opfunc.h"
+#include "object_domain.h"
+#include "object_representation.h"
+
+/* system headers */
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace test_batch_filter
+{
+  /* synthetic representation: five fixed attributes and no variable attributes */
+  struct synthetic_attribute
+  {
+    DB_TYPE type;
+    int location;
+  };
+
+  static const synthetic_attribute SYNTHETIC_ATTRS[] =
+  {
+    { DB_TYPE_INTEGER, 0 },
+    { DB_TYPE_DATE, 4 },
+    { DB_TYPE_BIGINT, 8 },
+    { DB_TYPE_DOUBLE, 16 },
+    { DB_TYPE_DATETIME, 24 }
+  };
+  static const int SYNTHETIC_ATTR_COUNT = sizeof (SYNTHETIC_ATTRS) / sizeof (SYNTHETIC_ATTRS[0]);
+  static const int SYNTHETIC_FIXED_LENGTH = 32;
+  static const REPR_ID SYNTHETIC_REPR_ID = 7;
+  static const int SYNTHETIC_HEADER_SIZE = OR_MVCC_REP_SIZE + OR_CHN_SIZE + OR_MVCC_INSERT_ID_SIZE;
+  static const int SYNTHETIC_RECORD_SIZE =
+	  DB_ALIGN (SYNTHETIC_HEADER_SIZE + SYNTHETIC_FIXED_LENGTH + OR_BOUND_BIT_BYTES (SYNTHETIC_ATTR_COUNT), 8);
+  /* about the number of such records on a 16K heap page */
+  static const int SYNTHETIC_RECORDS_PER_PAGE = 256;
+  static const int SYNTHETIC_BASE_DATE = 2458000;
+
+  enum
+  {
+    ATTR_INT,
+    ATTR_DATE,
+    ATTR_BIGINT,
+    ATTR_DOUBLE,
+    ATTR_DATETIME
+  };
+
+  /* a term of a test predicate */
+  struct term_desc
+  {
+    int attr;
+    BATCH_FILTER_OP op;
+    std::vector<DB_VALUE> values;
+  };
+  typedef std::vector<term_desc> predicate_desc;
+
+  /* synthetic_page - records of a heap page, as returned by a heap scan */
+  class synthetic_page
+  {
+    public:
+      synthetic_page (std::mt19937 &gen, int null_percent, int other_repr_percent);
+
+      int get_count () const
+      {
+	return (int) m_records.size ();
+      }
+
+      const RECDES *get_records () const
+      {
+	return m_records.data ();
+      }
+
+    private:
+      std::vector<char> m_area;
+      std::vector<RECDES> m_records;
+  };
+
+  synthetic_page::synthetic_page (std::mt19937 &gen, int null_percent, int other_repr_percent)
+    : m_area (SYNTHETIC_RECORDS_PER_PAGE * SYNTHETIC_RECORD_SIZE)
+    , m_records (SYNTHETIC_RECORDS_PER_PAGE)
+  {
+    std::uniform_int_distribution<int> percent (0, 99);
+    std::uniform_int_distribution<int> small_int (0, 999);
+    std::uniform_int_distribution<int> day (0, 364);
+    std::uniform_int_distribution<int> msec (0, MILLISECONDS_OF_ONE_DAY - 1);
+    std::uniform_real_distribution<double> real (0, 1);
+
+    for (int i = 0; i < SYNTHETIC_RECORDS_PER_PAGE; i++)
+      {
+	char *data = m_area.data () + i * SYNTHETIC_RECORD_SIZE;
+	char *fixed = data + SYNTHETIC_HEADER_SIZE;
+	char *bound_bits = fixed + SYNTHETIC_FIXED_LENGTH;
+	REPR_ID repr_id = percent (gen) < other_repr_percent ? SYNTHETIC_REPR_ID - 1 : SYNTHETIC_REPR_ID;
+	INT64 mvccid = 1000 + i;
+	INT64 bigint_value = small_int (gen) % 100;
+	double double_value = real (gen);
+	DB_DATETIME datetime;
+
+	OR_PUT_INT (data, repr_id | OR_BOUND_BIT_FLAG | OR_OFFSET_SIZE_4BYTE
+		    | (OR_MVCC_FLAG_VALID_INSID << OR_MVCC_FLAG_SHIFT_BITS));
+	OR_PUT_INT (data + OR_CHN_OFFSET, 0);
+	OR_PUT_BIGINT (data + OR_MVCC_INSERT_ID_OFFSET, &mvccid);
+
+	datetime.date = SYNTHETIC_BASE_DATE + day (gen);
+	datetime.time = msec (gen);
+
+	OR_PUT_INT (fixed + SYNTHETIC_ATTRS[ATTR_INT].location, small_int (gen));
+	OR_PUT_INT (fixed + SYNTHETIC_ATTRS[ATTR_DATE].location, SYNTHETIC_BASE_DATE + day (gen));
+	OR_PUT_BIGINT (fixed + SYNTHETIC_ATTRS[ATTR_BIGINT].location, &bigint_value);
+	OR_PUT_DOUBLE (fixed + SYNTHETIC_ATTRS[ATTR_DOUBLE].location, &double_value);
+	OR_PUT_DATETIME (fixed + SYNTHETIC_ATTRS[ATTR_DATETIME].location, &datetime);
+
+	memset (bound_bits, 0, OR_BOUND_BIT_BYTES (SYNTHETIC_ATTR_COUNT));
+	for (int attr = 0; attr < SYNTHETIC_ATTR_COUNT; attr++)
+	  {
+	    if (percent (gen) >= null_percent)
+	      {
+		OR_ENABLE_BOUND_BIT (bound_bits, attr);
+	      }
+	  }
+
+	m_records[i].data = data;
+	m_records[i].length = SYNTHETIC_RECORD_SIZE;
+	m_records[i].area_size = SYNTHETIC_RECORD_SIZE;
+	m_records[i].type = REC_HOME;
+      }
+  }
+
+  /* read_attribute - read an attribute into a DB_VALUE, the way the heap attribute cache does */
+  static void
+  read_attribute (const RECDES &recdes, int attr, DB_VALUE *value)
+  {
+    char *fixed = recdes.data + OR_HEADER_SIZE (recdes.data);
+    char *bound_bits = fixed + SYNTHETIC_FIXED_LENGTH;
+    char *ptr = fixed + SYNTHETIC_ATTRS[attr].location;
+    DB_DATE date;
+    DB_BIGINT bigint_value;
+    double double_value;
+    DB_DATETIME datetime;
+
+    if (!OR_GET_BOUND_BIT (bound_bits, attr))
+      {
+	db_make_null (value);
+	return;
+      }
+
+    switch (SYNTHETIC_ATTRS[attr].type)
+      {
+      case DB_TYPE_INTEGER:
+	db_make_int (value, OR_GET_INT (ptr));
+	break;
+      case DB_TYPE_DATE:
+	date = OR_GET_INT (ptr);
+	db_value_put_encoded_date (value, &date);
+	break;
+      case DB_TYPE_BIGINT:
+	OR_GET_BIGINT (ptr, &bigint_value);
+	db_make_bigint (value, bigint_value);
+	break;
+      case DB_TYPE_DOUBLE:
+	OR_GET_DOUBLE (ptr, &double_value);
+	db_make_double (value, double_value);
+	break;
+      case DB_TYPE_DATETIME:
+	OR_GET_DATETIME (ptr, &datetime);
+	db_make_datetime (value, &datetime);
+	break;
+      default:
+	db_make_null (value);
+	break;
+      }
+  }
+
+  /* evaluate_record - record-at-a-time evaluation of a predicate with DB_VALUE comparisons */
+  static bool
+  evaluate_record (const RECDES &recdes, const predicate_desc &pred)
+  {
+    if (OR_GET_REPID (recdes.data) != SYNTHETIC_REPR_ID)
+      {
+	/* left to the regular evaluation */
+	return true;
+      }
+
+    for (const term_desc &term : pred)
+      {
+	DB_VALUE value;
+	DB_VALUE_COMPARE_RESULT cmp;
+	bool satisfied = false;
+
+	read_attribute (recdes, term.attr, &value);
+	if (DB_IS_NULL (&value))
+	  {
+	    return false;
+	  }
+
+	if (term.op == BATCH_FILTER_IN)
+	  {
+	    for (const DB_VALUE &constant : term.values)
+	      {
+		if (tp_value_compare (&value, &constant, 0, 0) == DB_EQ)
+		  {
+		    satisfied = true;
+		    break;
+		  }
+	      }
+	  }
+	else
+	  {
+	    cmp = tp_value_compare (&value, &term.values[0], 0, 0);
+	    switch (term.op)
+	      {
+	      case BATCH_FILTER_EQ:
+		satisfied = cmp == DB_EQ;
+		break;
+	      case BATCH_FILTER_NE:
+		satisfied = cmp == DB_LT || cmp == DB_GT;
+		break;
+	      case BATCH_FILTER_LT:
+		satisfied = cmp == DB_LT;
+		break;
+	      case BATCH_FILTER_LE:
+		satisfied = cmp == DB_LT || cmp == DB_EQ;
+		break;
+	      case BATCH_FILTER_GT:
+		satisfied = cmp == DB_GT;
+		break;
+	      case BATCH_FILTER_GE:
+		satisfied = cmp == DB_GT || cmp == DB_EQ;
+		break;
+	      default:
+		break;
+	      }
+	  }
+
+	if (!satisfied)
+	  {
+	    return false;
+	  }
+      }
+
+    return true;
+  }
+
+  /* make_filter - build the batch filter of a predicate */
+  static BATCH_FILTER *
+  make_filter (const predicate_desc &pred)
+  {
+    BATCH_FILTER *filter = batch_filter_create (SYNTHETIC_REPR_ID, 0, SYNTHETIC_FIXED_LENGTH);
+
+    if (filter == NULL)
+      {
+	return NULL;
+      }
+
+    for (const term_desc &term : pred)
+      {
+	if (batch_filter_add_term (filter, SYNTHETIC_ATTRS[term.attr].type, SYNTHETIC_ATTRS[term.attr].location,
+				   term.attr, term.op, term.values.data (), (int) term.values.size ()) != NO_ERROR)
+	  {
+	    batch_filter_destroy (filter);
+	    return NULL;
+	  }
+      }
+
+    return filter;
+  }
+
+  static term_desc
+  make_int_term (int attr, BATCH_FILTER_OP op, std::initializer_list<INT64> constants)
+  {
+    term_desc term;
+
+    term.attr = attr;
+    term.op = op;
+    for (INT64 constant : constants)
+      {
+	DB_VALUE value;
+	DB_DATE date = (DB_DATE) constant;
+	DB_DATETIME datetime;
+
+	switch (SYNTHETIC_ATTRS[attr].type)
+	  {
+	  case DB_TYPE_INTEGER:
+	    db_make_int (&value, (int) constant);
+	    break;
+	  case DB_TYPE_DATE:
+	    db_value_put_encoded_date (&value, &date);
+	    break;
+	  case DB_TYPE_DATETIME:
+	    datetime.date = (unsigned int) (constant / MILLISECONDS_OF_ONE_DAY);
+	    datetime.time = (unsigned int) (constant % MILLISECONDS_OF_ONE_DAY);
+	    db_make_datetime (&value, &datetime);
+	    break;
+	  default:
+	    db_make_bigint (&value, constant);
+	    break;
+	  }
+	term.values.push_back (value);
+      }
+
+    return term;
+  }
+
+  static term_desc
+  make_double_term (BATCH_FILTER_OP op, double constant)
+  {
+    term_desc term;
+    DB_VALUE value;
+
+    term.attr = ATTR_DOUBLE;
+    term.op = op;
+    db_make_double (&value, constant);
+    term.values.push_back (value);
+
+    return term;
+  }
+
+  /* the predicates of the tests; their names are the performance steps */
+  test_common::string_collection predicate_names ("BETWEEN", "IN", "NE and double", "Four types");
+
+  static std::vector<predicate_desc>
+  make_predicates ()
+  {
+    const INT64 noon = (INT64) (SYNTHETIC_BASE_DATE + 200) * MILLISECONDS_OF_ONE_DAY + MILLISECONDS_OF_ONE_DAY / 2;
+    std::vector<predicate_desc> preds (4);
+
+    /* int_attr BETWEEN 100 AND 700 */
+    preds[0].push_back (make_int_term (ATTR_INT, BATCH_FILTER_GE, { 100 }));
+    preds[0].push_back (make_int_term (ATTR_INT, BATCH_FILTER_LE, { 700 }));
+
+    /* bigint_attr IN (1, 5, 7, 11, 13, 42, 64, 99) */
+    preds[1].push_back (make_int_term (ATTR_BIGINT, BATCH_FILTER_IN, { 1, 5, 7, 11, 13, 42, 64, 99 }));
+
+    /* int_attr <> 500 AND double_attr >= 0.25 */
+    preds[2].push_back (make_int_term (ATTR_INT, BATCH_FILTER_NE, { 500 }));
+    preds[2].push_back (make_double_term (BATCH_FILTER_GE, 0.25));
+
+    /* int_attr > 250 AND date_attr >= base + 30 AND double_attr < 0.5 AND datetime_attr < base + 200 12:00 */
+    preds[3].push_back (make_int_term (ATTR_INT, BATCH_FILTER_GT, { 250 }));
+    preds[3].push_back (make_int_term (ATTR_DATE, BATCH_FILTER_GE, { SYNTHETIC_BASE_DATE + 30 }));
+    preds[3].push_back (make_double_term (BATCH_FILTER_LT, 0.5));
+    preds[3].push_back (make_int_term (ATTR_DATETIME, BATCH_FILTER_LT, { noon }));
+
+    return preds;
+  }
+
+  static std::vector<synthetic_page>
+  make_pages (int page_count, int null_percent, int other_repr_percent)
+  {
+    std::mt19937 gen (1234);
+    std::vector<synthetic_page> pages;
+
+    pages.reserve (page_count);
+    for (int i = 0; i < page_count; i++)
+      {
+	pages.emplace_back (gen, null_percent, other_repr_percent);
+      }
+
+    return pages;
+  }
+
+  int
+  test_batch_filter_correctness (void)
+  {
+    std::vector<predicate_desc> preds = make_predicates ();
+    std::vector<synthetic_page> pages = make_pages (16, 10, 5);
+    unsigned char sel[BATCH_FILTER_CAPACITY];
+
+    std::cout << "batch filter correctness" << std::endl;
+
+    for (size_t p = 0; p < preds.size (); p++)
+      {
+	BATCH_FILTER *filter = make_filter (preds[p]);
+	int selected = 0;
+
+	if (filter == NULL)
+	  {
+	    std::cout << "  ERROR: cannot make filter " << predicate_names.get_name (p) << std::endl;
+	    return ER_FAILED;
+	  }
+
+	for (const synthetic_page &page : pages)
+	  {
+	    batch_filter_decode (filter, page.get_records (), page.get_count ());
+	    selected += batch_filter_evaluate (filter, page.get_count (), sel);
+
+	    for (int i = 0; i < page.get_count (); i++)
+	      {
+		if ((sel[i] != 0) != evaluate_record (page.get_records ()[i], preds[p]))
+		  {
+		    std::cout << "  ERROR: predicate " << predicate_names.get_name (p) << " differs for record " << i << std::endl;
+		    batch_filter_destroy (filter);
+		    return ER_FAILED;
+		  }
+	      }
+	  }
+
+	std::cout << "    " << predicate_names.get_name (p) << ": " << selected << " records selected" << std::endl;
+	batch_filter_destroy (filter);
+      }
+
+    return NO_ERROR;
+  }
+
+  enum
+  {
+    SCENARIO_BATCH,
+    SCENARIO_RECORD
+  };
+  test_common::string_collection scenario_names ("Batch filter", "Record at a time");
+
+  int
+  test_batch_filter_performance (void)
+  {
+    const int page_count = 400;
+    const int repeat_count = 10;
+    std::vector<predicate_desc> preds = make_predicates ();
+    std::vector<synthetic_page> pages = make_pages (page_count, 5, 0);
+    test_common::perf_compare compare_result (scenario_names, predicate_names);
+    unsigned char sel[BATCH_FILTER_CAPACITY];
+
+    std::cout << "batch filter performance over " << page_count << " pages of " << SYNTHETIC_RECORDS_PER_PAGE
+	      << " records" << std::endl;
+
+    for (size_t p = 0; p < preds.size (); p++)
+      {
+	BATCH_FILTER *filter = make_filter (preds[p]);
+	long long batch_selected = 0;
+	long long record_selected = 0;
+
+	if (filter == NULL)
+	  {
+	    return ER_FAILED;
+	  }
+
+	test_common::us_timer timer;
+	for (int r = 0; r < repeat_count; r++)
+	  {
+	    for (const synthetic_page &page : pages)
+	      {
+		batch_filter_decode (filter, page.get_records (), page.get_count ());
+		batch_selected += batch_filter_evaluate (filter, page.get_count (), sel);
+	      }
+	  }
+	compare_result.register_time (timer, SCENARIO_BATCH, p);
+
+	for (int r = 0; r < repeat_count; r++)
+	  {
+	    for (const synthetic_page &page : pages)
+	      {
+		for (int i = 0; i < page.get_count (); i++)
+		  {
+		    record_selected += evaluate_record (page.get_records ()[i], preds[p]) ? 1 : 0;
+		  }
+	      }
+	  }
+	compare_result.register_time (timer, SCENARIO_RECORD, p);
+
+	batch_filter_destroy (filter);
+
+	if (batch_selected != record_selected)
+	  {
+	    std::cout << "  ERROR: predicate " << predicate_names.get_name (p) << " selects " << batch_selected
+		      << " records in batches and " << record_selected << " one at a time" << std::endl;
+	    return ER_FAILED;
+	  }
+      }
+
+    std::cout << std::endl;
+    compare_result.print_results_and_warnings (std::cout);
+
+    return NO_ERROR;
+  }
+}
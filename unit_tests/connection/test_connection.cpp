@@ -0,0 +1,728 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/* own header */
+#include "test_connection.hpp"
+
+/* header in same module */
+#include "test_perf_compare.hpp"
+
+/* headers from cubrid */
+#include "connection_multiplexer.hpp"
+#include "critical_section.h"
+#include "error_code.h"
+#include "error_manager.h"
+#include "lock_free.h"
+#include "thread_manager.hpp"
+
+/* system headers */
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace test_connection
+{
+  const int MAX_THREADS = 16;
+  const int MESSAGE_SIZE = 16;
+
+  /* one client connection; fd is watched, peer_fd plays the client */
+  struct mock_conn
+  {
+    int fd;
+    int peer_fd;
+    std::atomic<int> received;
+    std::atomic<int> idle_count;
+    std::atomic<bool> is_removed;
+
+    mock_conn ()
+      : fd (-1)
+      , peer_fd (-1)
+      , received (0)
+      , idle_count (0)
+      , is_removed (false)
+    {
+    }
+  };
+
+  static bool
+  open_conns (std::vector<mock_conn *> &conns, int count)
+  {
+    int sv[2];
+
+    for (int i = 0; i < count; i++)
+      {
+	if (socketpair (AF_UNIX, SOCK_STREAM, 0, sv) != 0)
+	  {
+	    return false;
+	  }
+	conns.push_back (new mock_conn ());
+	conns.back ()->fd = sv[0];
+	conns.back ()->peer_fd = sv[1];
+      }
+    return true;
+  }
+
+  static void
+  close_conns (std::vector<mock_conn *> &conns)
+  {
+    for (mock_conn *conn : conns)
+      {
+	if (conn->fd >= 0)
+	  {
+	    close (conn->fd);
+	  }
+	if (conn->peer_fd >= 0)
+	  {
+	    close (conn->peer_fd);
+	  }
+	delete conn;
+      }
+    conns.clear ();
+  }
+
+  /* wait until cond is true or timeout */
+  template <typename Cond>
+  static bool
+  wait_for (Cond &&cond, std::chrono::milliseconds timeout)
+  {
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now () + timeout;
+
+    while (!cond ())
+      {
+	if (std::chrono::steady_clock::now () >= deadline)
+	  {
+	    return false;
+	  }
+	std::this_thread::sleep_for (std::chrono::milliseconds (1));
+      }
+    return true;
+  }
+
+  int
+  init_thread_system (void)
+  {
+    THREAD_ENTRY *thread_p = NULL;
+    cubthread::manager *cub_th_m;
+    int error_code;
+
+    signal (SIGPIPE, SIG_IGN);
+
+    error_code = er_init ("connection_test.log", ER_NEVER_EXIT);
+    if (error_code != NO_ERROR)
+      {
+	return error_code;
+      }
+
+    lf_initialize_transaction_systems (MAX_THREADS);
+    error_code = csect_initialize_static_critical_sections ();
+    if (error_code != NO_ERROR)
+      {
+	return error_code;
+      }
+
+    cubthread::initialize (thread_p);
+    cub_th_m = cubthread::get_manager ();
+    cub_th_m->set_max_thread_count (100);
+
+    cub_th_m->alloc_entries ();
+    cub_th_m->init_entries (false);
+
+    return NO_ERROR;
+  }
+
+  /* read one message and check its sequence; false if peer closed connection or on error */
+  static bool
+  read_message (mock_conn *conn, std::atomic<int> &error_count)
+  {
+    char message[MESSAGE_SIZE];
+    ssize_t nbytes;
+    int seq;
+
+    nbytes = recv (conn->fd, message, MESSAGE_SIZE, MSG_WAITALL);
+    if (nbytes == 0)
+      {
+	/* closed by peer */
+	return false;
+      }
+    std::memcpy (&seq, message, sizeof (seq));
+    if (nbytes != MESSAGE_SIZE || seq != conn->received.load ())
+      {
+	error_count++;
+	return false;
+      }
+    conn->received++;
+    return true;
+  }
+
+  int
+  test_multiplexer_correctness (void)
+  {
+    const int conn_count = 64;
+    const int writer_count = 4;
+    const int message_count = 2000;
+    std::vector<mock_conn *> conns;
+    std::vector<std::thread> writers;
+    std::atomic<int> removed_count (0);
+    std::atomic<int> error_count (0);
+    cubconn::multiplexer::handlers handlers;
+    int total_received;
+    int error_code = NO_ERROR;
+
+    handlers.on_readable = [&error_count] (void *arg, cubconn::multiplexer::watch *w)
+    {
+      /* one message per call, like one request per call in server */
+      return read_message ((mock_conn *) arg, error_count) ? cubconn::multiplexer::read_action::REARM
+	     : cubconn::multiplexer::read_action::REMOVE;
+    };
+    handlers.on_timer = [] (void *arg, bool is_idle)
+    {
+      mock_conn *conn = (mock_conn *) arg;
+
+      if (is_idle)
+	{
+	  conn->idle_count++;
+	}
+      return true;
+    };
+    handlers.on_removed = [&removed_count, &error_count] (void *arg)
+    {
+      mock_conn *conn = (mock_conn *) arg;
+
+      if (conn->is_removed.exchange (true))
+	{
+	  error_count++;
+	}
+      removed_count++;
+    };
+
+    cubconn::multiplexer mux (4, std::chrono::milliseconds (10), std::chrono::milliseconds (50), handlers);
+
+    if (!open_conns (conns, conn_count) || !mux.start ())
+      {
+	std::cout << "  ERROR: cannot open sockets or start multiplexer" << std::endl;
+	close_conns (conns);
+	return ER_FAILED;
+      }
+    for (mock_conn *conn : conns)
+      {
+	if (!mux.add (conn->fd, conn))
+	  {
+	    std::cout << "  ERROR: cannot add socket" << std::endl;
+	    mux.stop ();
+	    close_conns (conns);
+	    return ER_FAILED;
+	  }
+      }
+
+    /* each writer sends all its messages on its own connections, several messages at once on each */
+    for (int w = 0; w < writer_count; w++)
+      {
+	writers.emplace_back ([&conns, w, writer_count, message_count] ()
+	{
+	  char message[MESSAGE_SIZE];
+
+	  std::memset (message, 0, sizeof (message));
+	  for (int seq = 0; seq < message_count; seq++)
+	    {
+	      std::memcpy (message, &seq, sizeof (seq));
+	      for (size_t i = w; i < conns.size (); i += writer_count)
+		{
+		  (void) send (conns[i]->peer_fd, message, MESSAGE_SIZE, 0);
+		}
+	    }
+	});
+      }
+    for (std::thread &th : writers)
+      {
+	th.join ();
+      }
+
+    auto get_total_received = [&conns] ()
+    {
+      int total = 0;
+
+      for (mock_conn *conn : conns)
+	{
+	  total += conn->received.load ();
+	}
+      return total;
+    };
+    (void) wait_for ([&] ()
+    {
+      return get_total_received () == conn_count * message_count || error_count.load () != 0;
+    }, std::chrono::seconds (10));
+
+    total_received = get_total_received ();
+    if (total_received != conn_count * message_count)
+      {
+	std::cout << "  ERROR: read " << total_received << " messages out of " << conn_count * message_count << std::endl;
+	error_code = ER_FAILED;
+      }
+
+    /* nothing is sent anymore; every connection becomes idle */
+    if (!wait_for ([&conns] ()
+    {
+      for (mock_conn *conn : conns)
+	  {
+	    if (conn->idle_count.load () == 0)
+	      {
+		return false;
+	      }
+	  }
+	  return true;
+	}, std::chrono::seconds (5)))
+      {
+	std::cout << "  ERROR: idle connections were not reported" << std::endl;
+	error_code = ER_FAILED;
+      }
+
+    /* peer closes half of connections; they are removed */
+    for (int i = 0; i < conn_count / 2; i++)
+      {
+	close (conns[i]->peer_fd);
+	conns[i]->peer_fd = -1;
+      }
+    if (!wait_for ([&] ()
+    {
+      return removed_count.load () == conn_count / 2;
+      }, std::chrono::seconds (5)))
+      {
+	std::cout << "  ERROR: removed " << removed_count.load () << " closed connections out of " << conn_count / 2
+		  << std::endl;
+	error_code = ER_FAILED;
+      }
+    for (int i = 0; i < conn_count; i++)
+      {
+	if (conns[i]->is_removed.load () != (i < conn_count / 2))
+	  {
+	    std::cout << "  ERROR: connection " << i << " was wrongly removed or kept" << std::endl;
+	    error_code = ER_FAILED;
+	    break;
+	  }
+      }
+    if (mux.get_watched_count () != (size_t) (conn_count - conn_count / 2))
+      {
+	std::cout << "  ERROR: multiplexer watches " << mux.get_watched_count () << " connections" << std::endl;
+	error_code = ER_FAILED;
+      }
+
+    /* the rest is removed by stop */
+    mux.stop ();
+    if (removed_count.load () != conn_count || error_count.load () != 0)
+      {
+	std::cout << "  ERROR: removed " << removed_count.load () << " connections out of " << conn_count << ", "
+		  << error_count.load () << " errors" << std::endl;
+	error_code = ER_FAILED;
+      }
+
+    close_conns (conns);
+
+    if (error_code == NO_ERROR)
+      {
+	std::cout << "  multiplexer: " << total_received << " messages read once and in order, " << conn_count
+		  << " connections removed" << std::endl;
+      }
+    return error_code;
+  }
+
+  int
+  test_multiplexer_handoff (void)
+  {
+    const int conn_count = 16;
+    const int message_count = 100;
+    const int reader_count = 2;
+    std::vector<mock_conn *> conns;
+    std::vector<std::thread> readers;
+    std::mutex queue_mutex;
+    std::condition_variable queue_cond;
+    std::deque<std::pair<mock_conn *, cubconn::multiplexer::watch *>> queue;
+    bool is_stopped = false;
+    std::atomic<int> removed_count (0);
+    std::atomic<int> error_count (0);
+    cubconn::multiplexer::handlers handlers;
+    char message[MESSAGE_SIZE];
+    int error_code = NO_ERROR;
+
+    handlers.on_readable = [&] (void *arg, cubconn::multiplexer::watch *w)
+    {
+      std::lock_guard<std::mutex> lockg (queue_mutex);
+      queue.emplace_back ((mock_conn *) arg, w);
+      queue_cond.notify_one ();
+      return cubconn::multiplexer::read_action::HANDED_OFF;
+    };
+    handlers.on_timer = [] (void *arg, bool is_idle)
+    {
+      return true;
+    };
+    handlers.on_removed = [&removed_count] (void *arg)
+    {
+      ((mock_conn *) arg)->is_removed = true;
+      removed_count++;
+    };
+
+    /* one I/O thread; it must not wait for the partial message */
+    cubconn::multiplexer mux (1, std::chrono::milliseconds (10), std::chrono::milliseconds (50), handlers);
+
+    if (!open_conns (conns, conn_count) || !mux.start ())
+      {
+	std::cout << "  ERROR: cannot open sockets or start multiplexer" << std::endl;
+	close_conns (conns);
+	return ER_FAILED;
+      }
+    for (mock_conn *conn : conns)
+      {
+	if (!mux.add (conn->fd, conn))
+	  {
+	    std::cout << "  ERROR: cannot add socket" << std::endl;
+	    mux.stop ();
+	    close_conns (conns);
+	    return ER_FAILED;
+	  }
+      }
+
+    for (int r = 0; r < reader_count; r++)
+      {
+	readers.emplace_back ([&] ()
+	{
+	  std::unique_lock<std::mutex> ulock (queue_mutex);
+
+	  while (true)
+	    {
+	      queue_cond.wait (ulock, [&] { return !queue.empty () || is_stopped; });
+	      if (queue.empty ())
+		{
+		  return;
+		}
+	      std::pair<mock_conn *, cubconn::multiplexer::watch *> item = queue.front ();
+	      queue.pop_front ();
+	      ulock.unlock ();
+
+	      mux.end_handoff (item.second, read_message (item.first, error_count));
+
+	      ulock.lock ();
+	    }
+	});
+      }
+
+    /* first connection sends half a message; the others are served meanwhile */
+    std::memset (message, 0, sizeof (message));
+    (void) send (conns[0]->peer_fd, message, MESSAGE_SIZE / 2, 0);
+    for (int seq = 0; seq < message_count; seq++)
+      {
+	std::memcpy (message, &seq, sizeof (seq));
+	for (int i = 1; i < conn_count; i++)
+	  {
+	    (void) send (conns[i]->peer_fd, message, MESSAGE_SIZE, 0);
+	  }
+      }
+    if (!wait_for ([&] ()
+    {
+      for (int i = 1; i < conn_count; i++)
+	  {
+	    if (conns[i]->received.load () != message_count)
+	      {
+		return false;
+	      }
+	  }
+	  return true;
+	}, std::chrono::seconds (10)) || conns[0]->received.load () != 0)
+      {
+	std::cout << "  ERROR: connections were not served while a partial message was read" << std::endl;
+	error_code = ER_FAILED;
+      }
+
+    /* rest of the message */
+    (void) send (conns[0]->peer_fd, message + MESSAGE_SIZE / 2, MESSAGE_SIZE - MESSAGE_SIZE / 2, 0);
+    if (!wait_for ([&conns] ()
+    {
+      return conns[0]->received.load () == 1;
+      }, std::chrono::seconds (5)))
+      {
+	std::cout << "  ERROR: partial message was not completed" << std::endl;
+	error_code = ER_FAILED;
+      }
+
+    /* peer closes all connections; readers hand them back to be removed */
+    for (mock_conn *conn : conns)
+      {
+	close (conn->peer_fd);
+	conn->peer_fd = -1;
+      }
+    if (!wait_for ([&] ()
+    {
+      return removed_count.load () == conn_count;
+      }, std::chrono::seconds (5)))
+      {
+	std::cout << "  ERROR: removed " << removed_count.load () << " closed connections out of " << conn_count
+		  << std::endl;
+	error_code = ER_FAILED;
+      }
+
+    mux.stop ();
+    {
+      std::lock_guard<std::mutex> lockg (queue_mutex);
+      is_stopped = true;
+      queue_cond.notify_all ();
+    }
+    for (std::thread &th : readers)
+      {
+	th.join ();
+      }
+    if (error_count.load () != 0)
+      {
+	std::cout << "  ERROR: " << error_count.load () << " messages read out of order" << std::endl;
+	error_code = ER_FAILED;
+      }
+
+    close_conns (conns);
+
+    if (error_code == NO_ERROR)
+      {
+	std::cout << "  multiplexer: connections served while another one was read by a blocked reader" << std::endl;
+      }
+    return error_code;
+  }
+
+  /* echo one byte back; what the server does with a request, without the work */
+  static bool
+  echo (int fd)
+  {
+    char c;
+
+    if (recv (fd, &c, 1, 0) != 1)
+      {
+	return false;
+      }
+    return send (fd, &c, 1, 0) == 1;
+  }
+
+  /* connection handler thread, like css_connection_handler_thread: poll one socket with a 100 ms timeout */
+  static void
+  run_conn_thread (mock_conn *conn, std::atomic<bool> &is_stopped)
+  {
+    struct pollfd po;
+
+    while (!is_stopped.load ())
+      {
+	po.fd = conn->fd;
+	po.events = POLLIN;
+	po.revents = 0;
+	if (poll (&po, 1, 100) > 0 && !echo (conn->fd))
+	  {
+	    break;
+	  }
+      }
+  }
+
+  /* clients send one byte on random connections and wait for it back; return round trips done */
+  static std::int64_t
+  run_clients (std::vector<mock_conn *> &conns, int client_count, int round_trips)
+  {
+    std::vector<std::thread> clients;
+    std::atomic<std::int64_t> done (0);
+
+    for (int c = 0; c < client_count; c++)
+      {
+	clients.emplace_back ([&conns, &done, c, client_count, round_trips] ()
+	{
+	  std::mt19937 gen ((unsigned int) c);
+	  /* each client has its own connections */
+	  std::uniform_int_distribution<size_t> conn_dist (0, (conns.size () - 1 - c) / client_count);
+	  char ch = 'x';
+
+	  for (int i = 0; i < round_trips; i++)
+	    {
+	      mock_conn *conn = conns[c + conn_dist (gen) * client_count];
+
+	      if (send (conn->peer_fd, &ch, 1, 0) != 1 || recv (conn->peer_fd, &ch, 1, 0) != 1)
+		{
+		  return;
+		}
+	      done++;
+	    }
+	});
+      }
+    for (std::thread &th : clients)
+      {
+	th.join ();
+      }
+    return done.load ();
+  }
+
+  /* open conn_count connections, serve round trips and close them; return false if the step cannot run */
+  static bool
+  run_storm (int conn_count, bool use_multiplexer, int client_count, int round_trips, std::int64_t &done,
+	     std::uint64_t &connect_us)
+  {
+    std::vector<mock_conn *> conns;
+    std::vector<std::thread> conn_threads;
+    std::atomic<bool> is_stopped (false);
+    cubconn::multiplexer::handlers handlers;
+    bool is_ok = true;
+
+    handlers.on_readable = [] (void *arg, cubconn::multiplexer::watch *w)
+    {
+      return echo (((mock_conn *) arg)->fd) ? cubconn::multiplexer::read_action::REARM
+	     : cubconn::multiplexer::read_action::REMOVE;
+    };
+    handlers.on_timer = [] (void *arg, bool is_idle)
+    {
+      return true;
+    };
+    handlers.on_removed = [] (void *arg)
+    {
+    };
+    cubconn::multiplexer mux (4, std::chrono::milliseconds (100), std::chrono::milliseconds (5000), handlers);
+
+    test_common::us_timer timer;
+    if (!open_conns (conns, conn_count))
+      {
+	close_conns (conns);
+	return false;
+      }
+
+    /* the storm: all connections arrive at once */
+    if (use_multiplexer)
+      {
+	is_ok = mux.start ();
+	for (size_t i = 0; is_ok && i < conns.size (); i++)
+	  {
+	    is_ok = mux.add (conns[i]->fd, conns[i]);
+	  }
+      }
+    else
+      {
+	try
+	  {
+	    for (mock_conn *conn : conns)
+	      {
+		conn_threads.emplace_back (run_conn_thread, conn, std::ref (is_stopped));
+	      }
+	  }
+	catch (std::system_error &)
+	  {
+	    is_ok = false;
+	  }
+      }
+    connect_us = timer.time ().count ();
+
+    done = is_ok ? run_clients (conns, client_count, round_trips) : 0;
+
+    mux.stop ();
+    is_stopped = true;
+    for (std::thread &th : conn_threads)
+      {
+	th.join ();
+      }
+    close_conns (conns);
+
+    return is_ok;
+  }
+
+  const int CONN_COUNTS[] = { 100, 1000, 5000, 20000 };
+  test_common::string_collection step_names ("100 connections", "1000 connections", "5000 connections",
+      "20000 connections");
+  /* a thread per connection is not tried beyond this */
+  const int MAX_CONN_THREADS = 5000;
+
+  enum
+  {
+    SCENARIO_MULTIPLEXER,
+    SCENARIO_THREAD_PER_CONNECTION
+  };
+  test_common::string_collection scenario_names ("multiplexer", "thread per connection");
+
+  int
+  test_multiplexer_performance (void)
+  {
+    const int client_count = 4;
+    const int round_trips = 20000;
+    struct rlimit fd_limit;
+    test_common::perf_compare compare_result (scenario_names, step_names);
+
+    /* each connection takes three descriptors: two ends and the duplicate watched by multiplexer */
+    if (getrlimit (RLIMIT_NOFILE, &fd_limit) == 0)
+      {
+	fd_limit.rlim_cur = fd_limit.rlim_max;
+	(void) setrlimit (RLIMIT_NOFILE, &fd_limit);
+	(void) getrlimit (RLIMIT_NOFILE, &fd_limit);
+      }
+
+    std::cout << "connection storm: open connections at once, then " << client_count << " clients do " << round_trips
+	      << " round trips each" << std::endl;
+
+    for (size_t scenario = 0; scenario < scenario_names.get_count (); scenario++)
+      {
+	for (size_t step = 0; step < step_names.get_count (); step++)
+	  {
+	    int conn_count = CONN_COUNTS[step];
+	    std::int64_t done = 0;
+	    std::uint64_t connect_us = 0;
+
+	    if ((rlim_t) conn_count * 3 + 64 > fd_limit.rlim_cur
+		|| (scenario == SCENARIO_THREAD_PER_CONNECTION && conn_count > MAX_CONN_THREADS))
+	      {
+		std::cout << "  " << scenario_names.get_name (scenario) << ", " << step_names.get_name (step)
+			  << ": skipped" << std::endl;
+		continue;
+	      }
+
+	    test_common::us_timer timer;
+	    if (!run_storm (conn_count, scenario == SCENARIO_MULTIPLEXER, client_count, round_trips, done, connect_us))
+	      {
+		std::cout << "  " << scenario_names.get_name (scenario) << ", " << step_names.get_name (step)
+			  << ": cannot open connections" << std::endl;
+		continue;
+	      }
+	    std::uint64_t elapsed_us = timer.time ().count ();
+	    compare_result.register_time (timer, scenario, step);
+
+	    if (done != (std::int64_t) client_count * round_trips)
+	      {
+		std::cout << "  ERROR: " << done << " round trips out of " << client_count * round_trips << std::endl;
+		return ER_FAILED;
+	      }
+
+	    std::cout << "  " << scenario_names.get_name (scenario) << ", " << step_names.get_name (step) << ": connect "
+		      << connect_us / 1000 << " ms, " << (elapsed_us > connect_us ? elapsed_us - connect_us : 0) * 1000 / done
+		      << " ns per round trip" << std::endl;
+	  }
+      }
+
+    std::cout << std::endl;
+    compare_result.print_results_and_warnings (std::cout);
+
+    return NO_ERROR;
+  }
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _TEST_CONNECTION_HPP_
+#define _TEST_CONNECTION_HPP_
+
+namespace test_connection
+{
+  /* start thread manager, so multiplexer can create its I/O daemons */
+  int init_thread_system (void);
+
+  /* writers send messages over socket pairs watched by multiplexer; check each message is read once, idle sockets are
+   * reported and closed sockets are removed */
+  int test_multiplexer_correctness (void);
+
+  /* sockets are handed off to reader threads; check a reader blocked on a partial message does not stall the other
+   * sockets of the I/O thread, and sockets handed back closed are removed */
+  int test_multiplexer_handoff (void);
+
+  /* open many connections at once and measure round trips, with multiplexer and with a thread per connection */
+  int test_multiplexer_performance (void);
+}
+
+#endif // _TEST_CONNECTION_HPP_
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/* own header */
+#include "test_io_backend.hpp"
+
+/* header in same module */
+#include "test_perf_compare.hpp"
+
+/* headers from cubrid */
+#include "error_code.h"
+#include "file_io.h"
+#include "system_parameter.h"
+
+/* system headers */
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace test_io_backend
+{
+  const size_t TEST_PAGE_SIZE = 16 * 1024;
+  const size_t TEST_ALIGNMENT = 4096;	/* for direct I/O */
+  const int TEST_QUEUE_DEPTH = 64;
+  const char *TEST_FILE_NAME = "test_io_backend.tmp";
+
+  /* page aligned area for a number of pages */
+  class page_area
+  {
+    public:
+      page_area (int page_count)
+	: m_buffer (page_count * TEST_PAGE_SIZE + TEST_ALIGNMENT)
+      {
+	size_t misalign = (size_t) m_buffer.data () % TEST_ALIGNMENT;
+	m_pages = m_buffer.data () + (misalign == 0 ? 0 : TEST_ALIGNMENT - misalign);
+      }
+
+      char *get_page (int page_id)
+      {
+	return m_pages + page_id * TEST_PAGE_SIZE;
+      }
+
+    private:
+      std::vector<char> m_buffer;
+      char *m_pages;
+  };
+
+  /* scratch volume; direct I/O is used when file system allows it, so reads are not served from OS cache */
+  static int
+  open_scratch_file (bool &is_direct)
+  {
+    int vol_fd = NULL_VOLDES;
+
+#if defined (O_DIRECT)
+    vol_fd = fileio_open (TEST_FILE_NAME, O_RDWR | O_CREAT | O_TRUNC | O_DIRECT, 0600);
+#endif
+    is_direct = vol_fd != NULL_VOLDES;
+    if (!is_direct)
+      {
+	vol_fd = fileio_open (TEST_FILE_NAME, O_RDWR | O_CREAT | O_TRUNC, 0600);
+      }
+    if (vol_fd == NULL_VOLDES)
+      {
+	std::cout << "  ERROR: cannot create " << TEST_FILE_NAME << std::endl;
+      }
+    return vol_fd;
+  }
+
+  static void
+  close_scratch_file (int vol_fd)
+  {
+    fileio_close (vol_fd);
+    (void) std::remove (TEST_FILE_NAME);
+  }
+
+  static void
+  stamp_page (char *page, int page_id, int generation)
+  {
+    std::memset (page, (page_id + generation) % 251, TEST_PAGE_SIZE);
+    std::memcpy (page, &page_id, sizeof (page_id));
+  }
+
+  static bool
+  check_page (const char *page, int page_id, int generation)
+  {
+    int stamped_id;
+
+    std::memcpy (&stamped_id, page, sizeof (stamped_id));
+    return stamped_id == page_id && page[TEST_PAGE_SIZE - 1] == (char) ((page_id + generation) % 251);
+  }
+
+  /* read or write the given pages of the scratch file in one batch */
+  static int
+  run_batch (int backend, bool is_write, int vol_fd, page_area &area, const std::vector<int> &page_ids)
+  {
+    FILEIO_BATCH batch;
+    int error_code = NO_ERROR;
+
+    fileio_batch_begin (NULL, &batch, backend, TEST_QUEUE_DEPTH);
+    for (int page_id : page_ids)
+      {
+	if (is_write)
+	  {
+	    error_code = fileio_batch_add_write (&batch, vol_fd, area.get_page (page_id), page_id, TEST_PAGE_SIZE,
+						 NULL);
+	  }
+	else
+	  {
+	    error_code = fileio_batch_add_read (&batch, vol_fd, area.get_page (page_id), page_id, TEST_PAGE_SIZE, NULL);
+	  }
+	if (error_code != NO_ERROR)
+	  {
+	    break;
+	  }
+      }
+    if (fileio_batch_end (&batch) != NO_ERROR && error_code == NO_ERROR)
+      {
+	error_code = ER_FAILED;
+      }
+    return error_code;
+  }
+
+  static std::vector<int>
+  make_page_order (int page_count, bool shuffle)
+  {
+    std::vector<int> page_ids (page_count);
+    std::mt19937 generator (page_count);
+
+    for (int i = 0; i < page_count; i++)
+      {
+	page_ids[i] = i;
+      }
+    if (shuffle)
+      {
+	std::shuffle (page_ids.begin (), page_ids.end (), generator);
+      }
+    return page_ids;
+  }
+
+  static bool
+  is_io_uring_available (void)
+  {
+    FILEIO_BATCH batch;
+    bool is_async;
+
+    fileio_batch_begin (NULL, &batch, IO_BACKEND_IO_URING, TEST_QUEUE_DEPTH);
+    is_async = fileio_batch_is_async (&batch);
+    (void) fileio_batch_end (&batch);
+    return is_async;
+  }
+
+  int
+  test_io_backend_correctness (void)
+  {
+    const int page_count = 300;	/* not a multiple of queue depth */
+    const int backends[] = { IO_BACKEND_PREAD, IO_BACKEND_IO_URING };
+    std::vector<int> write_order = make_page_order (page_count, false);
+    std::vector<int> read_order = make_page_order (page_count, true);
+    page_area write_area (page_count);
+    page_area read_area (page_count);
+    bool is_direct;
+    int generation = 0;
+    int vol_fd;
+
+    std::cout << "I/O backend correctness; io_uring is " << (is_io_uring_available () ? "" : "not ") << "available"
+	      << std::endl;
+
+    vol_fd = open_scratch_file (is_direct);
+    if (vol_fd == NULL_VOLDES)
+      {
+	return ER_FAILED;
+      }
+
+    for (int write_backend : backends)
+      {
+	for (int read_backend : backends)
+	  {
+	    generation++;
+	    for (int page_id = 0; page_id < page_count; page_id++)
+	      {
+		stamp_page (write_area.get_page (page_id), page_id, generation);
+		std::memset (read_area.get_page (page_id), 0, TEST_PAGE_SIZE);
+	      }
+
+	    if (run_batch (write_backend, true, vol_fd, write_area, write_order) != NO_ERROR
+		|| run_batch (read_backend, false, vol_fd, read_area, read_order) != NO_ERROR)
+	      {
+		std::cout << "  ERROR: batch failed" << std::endl;
+		close_scratch_file (vol_fd);
+		return ER_FAILED;
+	      }
+
+	    for (int page_id = 0; page_id < page_count; page_id++)
+	      {
+		if (!check_page (read_area.get_page (page_id), page_id, generation))
+		  {
+		    std::cout << "  ERROR: page " << page_id << " written with backend " << write_backend
+			      << " and read with backend " << read_backend << " does not match" << std::endl;
+		    close_scratch_file (vol_fd);
+		    return ER_FAILED;
+		  }
+	      }
+	  }
+      }
+
+    close_scratch_file (vol_fd);
+    return NO_ERROR;
+  }
+
+  enum
+  {
+    STEP_SEQUENTIAL_WRITE,
+    STEP_RANDOM_WRITE,
+    STEP_RANDOM_READ
+  };
+  test_common::string_collection step_names ("Sequential write", "Random write", "Random read");
+
+  enum
+  {
+    SCENARIO_IO_URING,
+    SCENARIO_PREAD
+  };
+  test_common::string_collection scenario_names ("io_uring", "pread/pwrite");
+
+  int
+  test_io_backend_performance (void)
+  {
+    const int page_count = 2048;
+    const int repeat_count = 4;
+    const int backends[] = { IO_BACKEND_IO_URING, IO_BACKEND_PREAD };
+    std::vector<int> sequential_order = make_page_order (page_count, false);
+    std::vector<int> random_order = make_page_order (page_count, true);
+    test_common::perf_compare compare_result (scenario_names, step_names);
+    page_area area (page_count);
+    bool is_direct;
+    int vol_fd;
+
+    vol_fd = open_scratch_file (is_direct);
+    if (vol_fd == NULL_VOLDES)
+      {
+	return ER_FAILED;
+      }
+
+    std::cout << "I/O backend performance over " << page_count << " pages of " << TEST_PAGE_SIZE << " bytes, "
+	      << (is_direct ? "direct I/O" : "buffered I/O") << ", queue depth " << TEST_QUEUE_DEPTH << std::endl;
+    if (!is_io_uring_available ())
+      {
+	std::cout << "  io_uring is not available; both scenarios use pread/pwrite" << std::endl;
+      }
+
+    for (int page_id = 0; page_id < page_count; page_id++)
+      {
+	stamp_page (area.get_page (page_id), page_id, 0);
+      }
+
+    for (size_t scenario = 0; scenario < sizeof (backends) / sizeof (backends[0]); scenario++)
+      {
+	int error_code = NO_ERROR;
+
+	test_common::us_timer timer;
+	for (int r = 0; r < repeat_count && error_code == NO_ERROR; r++)
+	  {
+	    error_code = run_batch (backends[scenario], true, vol_fd, area, sequential_order);
+	  }
+	compare_result.register_time (timer, scenario, STEP_SEQUENTIAL_WRITE);
+
+	for (int r = 0; r < repeat_count && error_code == NO_ERROR; r++)
+	  {
+	    error_code = run_batch (backends[scenario], true, vol_fd, area, random_order);
+	  }
+	compare_result.register_time (timer, scenario, STEP_RANDOM_WRITE);
+
+	for (int r = 0; r < repeat_count && error_code == NO_ERROR; r++)
+	  {
+	    error_code = run_batch (backends[scenario], false, vol_fd, area, random_order);
+	  }
+	compare_result.register_time (timer, scenario, STEP_RANDOM_READ);
+
+	if (error_code != NO_ERROR)
+	  {
+	    std::cout << "  ERROR: batch failed in scenario " << scenario_names.get_name (scenario) << std::endl;
+	    close_scratch_file (vol_fd);
+	    return ER_FAILED;
+	  }
+      }
+
+    close_scratch_file (vol_fd);
+
+    std::cout << std::endl;
+    compare_result.print_results_and_warnings (std::cout);
+
+    return NO_ERROR;
+  }
+}
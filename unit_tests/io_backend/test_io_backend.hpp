@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _TEST_IO_BACKEND_HPP_
+#define _TEST_IO_BACKEND_HPP_
+
+namespace test_io_backend
+{
+  /* write pages with one backend and read them back with the other */
+  int test_io_backend_correctness (void);
+
+  /* time page reads and writes of a scratch file with pread/pwrite and with io_uring */
+  int test_io_backend_performance (void);
+}
+
+#endif // _TEST_IO_BACKEND_HPP_
@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/* own header */
+#include "test_log_append.hpp"
+
+/* header in same module */
+#include "test_perf_compare.hpp"
+
+/* headers from cubrid */
+#include "error_code.h"
+#include "log_append_combiner.hpp"
+
+/* system headers */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace test_log_append
+{
+  /* log page area and record header, about the sizes of LOGAREA_SIZE and LOG_RECORD_HEADER */
+  const int MOCK_LOGAREA_SIZE = 16 * 1024 - 32;
+  const int MOCK_HEADER_SIZE = 40;
+  const int MOCK_ALIGNMENT = 8;
+  const int MOCK_MAX_DATA_LENGTH = 512;
+
+  struct mock_lsa
+  {
+    std::int64_t pageid;
+    int offset;
+
+    bool operator== (const mock_lsa &other) const
+    {
+      return pageid == other.pageid && offset == other.offset;
+    }
+
+    bool operator!= (const mock_lsa &other) const
+    {
+      return !(*this == other);
+    }
+  };
+
+  const mock_lsa MOCK_NULL_LSA = { -1, -1 };
+
+  /* the members of LOG_PRIOR_NODE used by prior list append */
+  struct mock_node
+  {
+    mock_lsa start_lsa;
+    mock_lsa back_lsa;
+    mock_lsa forw_lsa;
+    mock_lsa prev_tranlsa;
+    int owner;
+    int length;
+    char *data;
+    mock_node *next;
+  };
+
+  struct mock_tdes
+  {
+    int owner;
+    mock_lsa tail_lsa;
+  };
+
+  struct mock_request
+  {
+    mock_node *node;
+    mock_tdes *tdes;
+    mock_lsa start_lsa;
+  };
+
+  /* the members of LOG_PRIOR_LSA_INFO used by prior list append */
+  struct mock_prior_info
+  {
+    std::mutex prior_lsa_mutex;
+    log_append_combiner<mock_request> prior_combiner;
+    mock_lsa prior_lsa;
+    mock_lsa prev_lsa;
+    mock_node *prior_list_header;
+    mock_node *prior_list_tail;
+    std::int64_t list_size;
+
+    mock_prior_info ()
+      : prior_lsa_mutex ()
+      , prior_combiner ()
+      , prior_lsa { 0, 0 }
+      , prev_lsa (MOCK_NULL_LSA)
+      , prior_list_header (NULL)
+      , prior_list_tail (NULL)
+      , list_size (0)
+    {
+    }
+  };
+
+  /* log flush daemon: takes the prior list and checks it, like logpb_prior_lsa_append_all_list */
+  struct mock_flusher
+  {
+    mock_lsa expected_lsa;
+    mock_lsa last_lsa;
+    std::vector<mock_lsa> owner_last_lsa;
+    std::int64_t record_count;
+    std::int64_t error_count;
+
+    explicit mock_flusher (int owner_count)
+      : expected_lsa { 0, 0 }
+      , last_lsa (MOCK_NULL_LSA)
+      , owner_last_lsa (owner_count, MOCK_NULL_LSA)
+      , record_count (0)
+      , error_count (0)
+    {
+    }
+  };
+
+  static void
+  mock_align (mock_lsa &lsa)
+  {
+    lsa.offset = (lsa.offset + MOCK_ALIGNMENT - 1) & ~(MOCK_ALIGNMENT - 1);
+    if (lsa.offset >= MOCK_LOGAREA_SIZE)
+      {
+	lsa.pageid++;
+	lsa.offset = 0;
+      }
+  }
+
+  static void
+  mock_advance_when_doesnot_fit (mock_lsa &lsa, int length)
+  {
+    if (lsa.offset + length >= MOCK_LOGAREA_SIZE)
+      {
+	lsa.pageid++;
+	lsa.offset = 0;
+      }
+  }
+
+  /* reserve lsa and append node, like prior_lsa_append_to_list; caller holds prior_lsa_mutex */
+  static mock_lsa
+  mock_append_to_list (mock_prior_info &info, mock_node *node, mock_tdes *tdes)
+  {
+    int remaining;
+
+    mock_advance_when_doesnot_fit (info.prior_lsa, MOCK_HEADER_SIZE);
+    node->start_lsa = info.prior_lsa;
+    node->prev_tranlsa = tdes->tail_lsa;
+    tdes->tail_lsa = info.prior_lsa;
+    node->back_lsa = info.prev_lsa;
+    info.prev_lsa = info.prior_lsa;
+    info.prior_lsa.offset += MOCK_HEADER_SIZE;
+    mock_align (info.prior_lsa);
+
+    /* data may span several pages */
+    for (remaining = node->length; remaining > 0;)
+      {
+	int copy_length = std::min (remaining, MOCK_LOGAREA_SIZE - info.prior_lsa.offset);
+
+	info.prior_lsa.offset += copy_length;
+	remaining -= copy_length;
+	mock_align (info.prior_lsa);
+      }
+
+    mock_advance_when_doesnot_fit (info.prior_lsa, MOCK_HEADER_SIZE);
+    node->forw_lsa = info.prior_lsa;
+
+    if (info.prior_list_tail == NULL)
+      {
+	info.prior_list_header = node;
+      }
+    else
+      {
+	info.prior_list_tail->next = node;
+      }
+    info.prior_list_tail = node;
+    info.list_size += sizeof (mock_node) + node->length;
+
+    return node->start_lsa;
+  }
+
+  static void
+  mock_flush (mock_prior_info &info, mock_flusher &flusher)
+  {
+    mock_node *list;
+    mock_node *next;
+
+    info.prior_lsa_mutex.lock ();
+    list = info.prior_list_header;
+    info.prior_list_header = NULL;
+    info.prior_list_tail = NULL;
+    info.list_size = 0;
+    info.prior_lsa_mutex.unlock ();
+
+    for (; list != NULL; list = next)
+      {
+	next = list->next;
+
+	if (list->start_lsa != flusher.expected_lsa || list->back_lsa != flusher.last_lsa
+	    || list->prev_tranlsa != flusher.owner_last_lsa[list->owner])
+	  {
+	    flusher.error_count++;
+	  }
+	flusher.expected_lsa = list->forw_lsa;
+	flusher.last_lsa = list->start_lsa;
+	flusher.owner_last_lsa[list->owner] = list->start_lsa;
+	flusher.record_count++;
+
+	delete [] list->data;
+	delete list;
+      }
+  }
+
+  /* each thread builds records and appends them to prior list, like log_append_undoredo_data */
+  static void
+  run_append (mock_prior_info &info, int owner, bool is_combined, int op_count, std::atomic<std::int64_t> &errors)
+  {
+    mock_tdes tdes = { owner, MOCK_NULL_LSA };
+    mock_lsa last_start_lsa = MOCK_NULL_LSA;
+    char source[MOCK_MAX_DATA_LENGTH];
+    std::mt19937 gen ((unsigned int) owner);
+    std::uniform_int_distribution<int> length_dist (16, MOCK_MAX_DATA_LENGTH);
+    auto append_func = [&info] (mock_request & pending)
+    {
+      pending.start_lsa = mock_append_to_list (info, pending.node, pending.tdes);
+    };
+
+    std::memset (source, owner, sizeof (source));
+
+    for (int op = 0; op < op_count; op++)
+      {
+	mock_node *node = new mock_node ();
+	mock_request request = { node, &tdes, MOCK_NULL_LSA };
+
+	/* data is copied out of the mutex, like prior_lsa_alloc_and_copy_data */
+	node->owner = owner;
+	node->length = length_dist (gen);
+	node->data = new char[node->length];
+	std::memcpy (node->data, source, node->length);
+
+	if (is_combined)
+	  {
+	    info.prior_combiner.append (info.prior_lsa_mutex, request, append_func);
+	  }
+	else
+	  {
+	    std::lock_guard<std::mutex> lock (info.prior_lsa_mutex);
+	    append_func (request);
+	  }
+
+	/* node may be flushed by now; only request may be used */
+	if (request.start_lsa != tdes.tail_lsa
+	    || (last_start_lsa.pageid > request.start_lsa.pageid
+		|| (last_start_lsa.pageid == request.start_lsa.pageid && last_start_lsa.offset >= request.start_lsa.offset)))
+	  {
+	    errors++;
+	  }
+	last_start_lsa = request.start_lsa;
+      }
+  }
+
+  /* run thread_count appenders and a flusher; return number of errors */
+  static std::int64_t
+  run_appenders_and_flusher (int thread_count, bool is_combined, int op_count, std::int64_t &record_count)
+  {
+    mock_prior_info info;
+    mock_flusher flusher (thread_count);
+    std::atomic<bool> is_stopped (false);
+    std::atomic<std::int64_t> errors (0);
+    std::vector<std::thread> threads;
+
+    std::thread flush_thread ([&] ()
+    {
+      while (!is_stopped.load ())
+	{
+	  mock_flush (info, flusher);
+	  std::this_thread::sleep_for (std::chrono::microseconds (200));
+	}
+    });
+
+    for (int i = 0; i < thread_count; i++)
+      {
+	threads.emplace_back (run_append, std::ref (info), i, is_combined, op_count, std::ref (errors));
+      }
+    for (std::thread &th : threads)
+      {
+	th.join ();
+      }
+    is_stopped = true;
+    flush_thread.join ();
+
+    /* the last of the list */
+    mock_flush (info, flusher);
+
+    record_count = flusher.record_count;
+    return errors.load () + flusher.error_count;
+  }
+
+  int
+  test_combined_append_correctness (void)
+  {
+    const int thread_count = 8;
+    const int op_count = 100000;
+    std::int64_t record_count = 0;
+    std::int64_t error_count;
+
+    error_count = run_appenders_and_flusher (thread_count, true, op_count, record_count);
+    if (error_count != 0)
+      {
+	std::cout << "  ERROR: " << error_count << " records are out of order or badly linked" << std::endl;
+	return ER_FAILED;
+      }
+    if (record_count != (std::int64_t) thread_count * op_count)
+      {
+	std::cout << "  ERROR: flushed " << record_count << " records out of " << (std::int64_t) thread_count * op_count
+		  << std::endl;
+	return ER_FAILED;
+      }
+
+    std::cout << "  combined append: " << record_count << " records contiguous and linked" << std::endl;
+    return NO_ERROR;
+  }
+
+  const int THREAD_COUNTS[] = { 1, 2, 4, 8, 16, 32 };
+  test_common::string_collection step_names ("1 thread", "2 threads", "4 threads", "8 threads", "16 threads",
+      "32 threads");
+
+  enum
+  {
+    SCENARIO_COMBINED,
+    SCENARIO_MUTEX
+  };
+  test_common::string_collection scenario_names ("combined", "mutex");
+
+  int
+  test_combined_append_performance (void)
+  {
+    const int op_count = 50000;
+    test_common::perf_compare compare_result (scenario_names, step_names);
+
+    std::cout << "append records to prior list, " << op_count << " per thread" << std::endl;
+
+    for (size_t scenario = 0; scenario < scenario_names.get_count (); scenario++)
+      {
+	for (size_t step = 0; step < step_names.get_count (); step++)
+	  {
+	    int thread_count = THREAD_COUNTS[step];
+	    std::int64_t record_count = 0;
+	    std::int64_t error_count;
+
+	    test_common::us_timer timer;
+	    error_count = run_appenders_and_flusher (thread_count, scenario == SCENARIO_COMBINED, op_count, record_count);
+	    std::uint64_t elapsed_us = timer.time ().count ();
+	    compare_result.register_time (timer, scenario, step);
+
+	    if (error_count != 0)
+	      {
+		std::cout << "  ERROR: " << error_count << " records are out of order or badly linked" << std::endl;
+		return ER_FAILED;
+	      }
+
+	    std::cout << "  " << scenario_names.get_name (scenario) << ", " << step_names.get_name (step) << ": "
+		      << (elapsed_us > 0 ? (std::uint64_t) record_count * 1000 / elapsed_us : 0)
+		      << " appends per millisecond" << std::endl;
+	  }
+      }
+
+    std::cout << std::endl;
+    compare_result.print_results_and_warnings (std::cout);
+
+    return NO_ERROR;
+  }
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _TEST_LOG_APPEND_HPP_
+#define _TEST_LOG_APPEND_HPP_
+
+namespace test_log_append
+{
+  /* threads append records through combiner while a flusher takes the list; check records are contiguous, linked
+   * backward and in transaction order */
+  int test_combined_append_correctness (void);
+
+  /* time concurrent appends, with prior_lsa_mutex only and with combined appends, for growing number of threads */
+  int test_combined_append_performance (void);
+}
+
+#endif // _TEST_LOG_APPEND_HPP_
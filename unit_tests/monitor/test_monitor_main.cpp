@@ -19,11 +19,17 @@
 
 #include "monitor_collect.hpp"
 #include "monitor_registration.hpp"
+#include "monitor_sharded.hpp"
 #include "monitor_transaction.hpp"
 #include "thread_manager.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
 #include <thread>
 #include <iostream>
+#include <vector>
 
 #include <cassert>
 
@@ -33,6 +39,7 @@ static void test_transaction (void);
 static void test_registration (void);
 static void test_collect (void);
 static void test_boot_mockup (void);
+static void test_sharded (void);
 
 int
 main (int, char **)
@@ -43,6 +50,7 @@ main (int, char **)
   test_registration ();
   test_collect ();
   test_boot_mockup ();
+  test_sharded ();
 
   std::cout << "test successful" << std::endl;
 }
@@ -668,3 +676,205 @@ test_boot_mockup (void)
   delete peek_values;
   delete ctm_stats;
 }
+
+//////////////////////////////////////////////////////////////////////////
+// test_sharded
+//////////////////////////////////////////////////////////////////////////
+
+// sharded statistics are big; keep them out of the stack
+static cubmonitor::amount_accumulator_sharded_statistic Test_sharded_accumulator;
+static cubmonitor::latency_histogram_statistic Test_latency_histogram;
+
+static void
+test_sharded_accumulation_task (cubmonitor::amount_accumulator_sharded_statistic &acc)
+{
+  using namespace cubmonitor;
+  for (amount_rep amount = 1; amount < 1000; amount++)
+    {
+      acc.collect (amount);
+    }
+}
+
+static void
+test_sharded_accumulation (void)
+{
+  using namespace cubmonitor;
+
+  // more threads than shards
+  const std::size_t THREAD_COUNT = SHARD_COUNT * 2 + 3;
+
+  execute_multi_thread (THREAD_COUNT, test_sharded_accumulation_task, std::ref (Test_sharded_accumulator));
+
+  amount_rep expected = THREAD_COUNT * 999 * 500;
+  statistic_value fetched;
+  Test_sharded_accumulator.fetch (&fetched);
+  assert (expected == fetched);
+  Test_sharded_accumulator.fetch (&fetched, FETCH_TRANSACTION_SHEET);
+  assert (fetched == 0);
+
+  std::cout << "test_sharded_accumulation passed" << std::endl;
+}
+
+static void
+test_latency_histogram_buckets (void)
+{
+  using namespace cubmonitor;
+  using histogram = latency_histogram_statistic;
+
+  std::size_t index;
+
+  // small values are exact
+  for (std::uint64_t value = 0; value < 2 * histogram::SUB_BUCKET_COUNT; value++)
+    {
+      assert (histogram::get_bucket_index (value) == value);
+      assert (histogram::get_bucket_highest (value) == value);
+    }
+
+  // each value falls in a bucket that starts after the previous one and covers it, with 1 / SUB_BUCKET_COUNT error
+  for (std::uint64_t value = 1; value >> histogram::MAX_VALUE_BITS == 0; value += value / 37 + 1)
+    {
+      index = histogram::get_bucket_index (value);
+      assert (index < histogram::BUCKET_COUNT);
+      assert (value <= histogram::get_bucket_highest (index));
+      assert (index == 0 || value > histogram::get_bucket_highest (index - 1));
+      assert (histogram::get_bucket_highest (index) - value <= value / histogram::SUB_BUCKET_COUNT);
+    }
+
+  // too long durations go to last bucket
+  assert (histogram::get_bucket_index (std::uint64_t (1) << histogram::MAX_VALUE_BITS) == histogram::BUCKET_COUNT - 1);
+  assert (histogram::get_bucket_index (std::numeric_limits<std::uint64_t>::max ()) == histogram::BUCKET_COUNT - 1);
+}
+
+static void
+test_latency_histogram_task (std::size_t seed, std::size_t count, std::vector<std::uint64_t> &values)
+{
+  // latencies usually have a long tail
+  std::mt19937_64 generator (seed);
+  std::lognormal_distribution<double> distribution (10, 1.5);
+
+  for (std::size_t i = 0; i < count; i++)
+    {
+      values[i] = (std::uint64_t) distribution (generator);
+      Test_latency_histogram.collect (cubmonitor::time_rep (values[i]));
+    }
+}
+
+static void
+test_latency_histogram (void)
+{
+  using namespace cubmonitor;
+
+  const std::size_t THREAD_COUNT = 8;
+  const std::size_t VALUES_PER_THREAD = 100000;
+  std::vector<std::vector<std::uint64_t>> thread_values (THREAD_COUNT, std::vector<std::uint64_t> (VALUES_PER_THREAD));
+  std::vector<std::thread> threads;
+  std::vector<std::uint64_t> all_values;
+  std::uint64_t total = 0;
+  std::uint64_t exact;
+  std::uint64_t found;
+  monitor my_monitor;
+  statistic_value *statsp;
+
+  assert (Test_latency_histogram.get_count () == 0);
+  assert (Test_latency_histogram.get_percentile_time (99).count () == 0);
+
+  test_latency_histogram_buckets ();
+
+  for (std::size_t i = 0; i < THREAD_COUNT; i++)
+    {
+      threads.emplace_back (test_latency_histogram_task, i, VALUES_PER_THREAD, std::ref (thread_values[i]));
+    }
+  for (std::size_t i = 0; i < THREAD_COUNT; i++)
+    {
+      threads[i].join ();
+      all_values.insert (all_values.end (), thread_values[i].begin (), thread_values[i].end ());
+    }
+  std::sort (all_values.begin (), all_values.end ());
+  for (std::uint64_t value : all_values)
+    {
+      total += value;
+    }
+
+  assert (Test_latency_histogram.get_count () == all_values.size ());
+  assert ((std::uint64_t) Test_latency_histogram.get_time ().count () == total);
+  assert ((std::uint64_t) Test_latency_histogram.get_max_time ().count () == all_values.back ());
+
+  // percentiles are never below the exact ones and at most one bucket above
+  for (double percent : { 1.0, 50.0, 90.0, 99.0, 99.9, 99.99, 100.0 })
+    {
+      exact = all_values[(std::size_t) std::ceil (percent / 100 * all_values.size ()) - 1];
+      found = (std::uint64_t) Test_latency_histogram.get_percentile_time (percent).count ();
+      assert (found >= exact && found - exact <= exact / latency_histogram_statistic::SUB_BUCKET_COUNT);
+    }
+
+  // fetch through monitor, in microseconds
+  Test_latency_histogram.register_to_monitor (my_monitor, "mylatency");
+  assert (my_monitor.get_statistics_count () == 6);
+  assert (my_monitor.get_statistic_name (0) == "Num_mylatency");
+  assert (my_monitor.get_statistic_name (3) == "P99_time_mylatency");
+
+  statsp = my_monitor.allocate_statistics_buffer ();
+  my_monitor.fetch_global_statistics (statsp);
+  assert (statsp[0] == all_values.size ());
+  assert (statsp[1] == total / 1000);
+  assert (statsp[2] == statistic_value_cast (Test_latency_histogram.get_percentile_time (50)));
+  assert (statsp[3] == statistic_value_cast (Test_latency_histogram.get_percentile_time (99)));
+  assert (statsp[4] == statistic_value_cast (Test_latency_histogram.get_percentile_time (99.9)));
+  assert (statsp[5] == all_values.back () / 1000);
+  delete [] statsp;
+
+  std::cout << "test_latency_histogram passed" << std::endl;
+}
+
+template <typename S>
+static void
+test_sharded_performance_task (S &stat, std::size_t count)
+{
+  for (std::size_t i = 0; i < count; i++)
+    {
+      stat.collect (1);
+    }
+}
+
+template <typename S>
+static double
+test_sharded_performance_run (S &stat, std::size_t thread_count, std::size_t count)
+{
+  cubmonitor::time_point start_timept = cubmonitor::clock_type::now ();
+
+  execute_multi_thread (thread_count, test_sharded_performance_task<S>, std::ref (stat), count);
+
+  return std::chrono::duration<double, std::milli> (cubmonitor::clock_type::now () - start_timept).count ();
+}
+
+static void
+test_sharded_performance (void)
+{
+  using namespace cubmonitor;
+
+  // compare contended collect on one atomic with sharded collect; only reported, as it depends on machine
+  const std::size_t COLLECT_COUNT = 2000000;
+  std::size_t thread_count = std::max<std::size_t> (std::thread::hardware_concurrency (), 2);
+  amount_accumulator_atomic_statistic atomic_acc;
+  amount_accumulator_sharded_statistic *sharded_acc = new amount_accumulator_sharded_statistic ();
+  double atomic_msecs;
+  double sharded_msecs;
+
+  atomic_msecs = test_sharded_performance_run (atomic_acc, thread_count, COLLECT_COUNT);
+  sharded_msecs = test_sharded_performance_run (*sharded_acc, thread_count, COLLECT_COUNT);
+
+  assert (atomic_acc.get_value () == thread_count * COLLECT_COUNT);
+  assert (sharded_acc->get_value () == thread_count * COLLECT_COUNT);
+  delete sharded_acc;
+
+  std::cout << "test_sharded_performance: " << thread_count << " threads x " << COLLECT_COUNT << " collects: atomic "
+	    << atomic_msecs << " ms, sharded " << sharded_msecs << " ms" << std::endl;
+}
+
+void
+test_sharded (void)
+{
+  test_sharded_accumulation ();
+  test_latency_histogram ();
+  test_sharded_performance ();
+}
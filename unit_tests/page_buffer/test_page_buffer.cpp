@@ -0,0 +1,342 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/* own header */
+#include "test_page_buffer.hpp"
+
+/* header in same module */
+#include "test_perf_compare.hpp"
+
+/* headers from cubrid */
+#include "error_code.h"
+#include "page_buffer_latch.hpp"
+
+/* system headers */
+#include <atomic>
+#include <iostream>
+#include <pthread.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace test_page_buffer
+{
+  /* the members of PGBUF_BCB used by the fix protocol */
+  struct mock_bcb
+  {
+    pthread_mutex_t mutex;
+    VPID vpid;
+    volatile int fcnt;
+    PGBUF_LATCH_MODE latch_mode;
+    THREAD_ENTRY *next_wait_thrd;
+
+    /* test only: detect readers and writers inside the page at the same time */
+    std::atomic<int> readers_inside;
+    std::atomic<int> writers_inside;
+
+    mock_bcb ()
+      : fcnt (0)
+      , latch_mode (PGBUF_NO_LATCH)
+      , next_wait_thrd (NULL)
+      , readers_inside (0)
+      , writers_inside (0)
+    {
+      pthread_mutex_init (&mutex, NULL);
+      vpid.volid = 0;
+      vpid.pageid = 0;
+    }
+
+    ~mock_bcb ()
+    {
+      pthread_mutex_destroy (&mutex);
+    }
+  };
+
+  /* read fix under bcb mutex, like pgbuf_latch_bcb_upon_fix; false if page is write latched */
+  static bool
+  fix_read_with_mutex (mock_bcb &bcb)
+  {
+    bool granted = false;
+
+    pthread_mutex_lock (&bcb.mutex);
+    if (bcb.latch_mode == PGBUF_NO_LATCH || bcb.latch_mode == PGBUF_LATCH_READ)
+      {
+	bcb.latch_mode = PGBUF_LATCH_READ;
+	ATOMIC_INC_32 (&bcb.fcnt, 1);
+	granted = true;
+      }
+    pthread_mutex_unlock (&bcb.mutex);
+    return granted;
+  }
+
+  /* write fix of an idle page under bcb mutex; false if page is latched */
+  static bool
+  fix_write_with_mutex (mock_bcb &bcb)
+  {
+    bool granted = false;
+
+    pthread_mutex_lock (&bcb.mutex);
+    if (bcb.latch_mode == PGBUF_NO_LATCH && bcb.fcnt == 0)
+      {
+	bcb.latch_mode = PGBUF_LATCH_WRITE;
+	ATOMIC_INC_32 (&bcb.fcnt, 1);
+	granted = true;
+      }
+    pthread_mutex_unlock (&bcb.mutex);
+    return granted;
+  }
+
+  /* unfix under bcb mutex, like pgbuf_unlatch_bcb_upon_unfix */
+  static void
+  unfix_with_mutex (mock_bcb &bcb)
+  {
+    pthread_mutex_lock (&bcb.mutex);
+    if (ATOMIC_INC_32 (&bcb.fcnt, -1) == 0)
+      {
+	bcb.latch_mode = PGBUF_NO_LATCH;
+      }
+    pthread_mutex_unlock (&bcb.mutex);
+  }
+
+  /* read fix like pgbuf_fix with optimistic fix enabled */
+  static bool
+  fix_read_optimistic (mock_bcb &bcb)
+  {
+    switch (pgbuf_latch_try_fix_shared (&bcb, &bcb.vpid))
+      {
+      case PGBUF_LATCH_OPTIMISTIC_FIXED:
+	return true;
+      case PGBUF_LATCH_OPTIMISTIC_RELEASE:
+	unfix_with_mutex (bcb);
+	break;
+      default:
+	break;
+      }
+    return fix_read_with_mutex (bcb);
+  }
+
+  /* read unfix like pgbuf_unfix with optimistic fix enabled */
+  static void
+  unfix_read_optimistic (mock_bcb &bcb)
+  {
+    if (!pgbuf_latch_try_unfix_shared (&bcb))
+      {
+	unfix_with_mutex (bcb);
+      }
+  }
+
+  /* read fix and promote to write latch in-place, like pgbuf_promote_read_latch; false if page is not fixed */
+  static bool
+  fix_and_promote (mock_bcb &bcb)
+  {
+    bool is_promoted;
+
+    if (!fix_read_with_mutex (bcb))
+      {
+	return false;
+      }
+
+    pthread_mutex_lock (&bcb.mutex);
+    is_promoted = pgbuf_latch_try_exclusive (&bcb, 1);
+    pthread_mutex_unlock (&bcb.mutex);
+
+    if (!is_promoted)
+      {
+	/* other readers */
+	unfix_with_mutex (bcb);
+      }
+    return is_promoted;
+  }
+
+  static bool
+  enter_as_reader (mock_bcb &bcb)
+  {
+    bcb.readers_inside++;
+    return bcb.writers_inside.load () == 0;
+  }
+
+  static bool
+  enter_as_writer (mock_bcb &bcb)
+  {
+    bcb.writers_inside++;
+    return bcb.readers_inside.load () == 0 && bcb.writers_inside.load () == 1;
+  }
+
+  int
+  test_optimistic_fix_correctness (void)
+  {
+    const int reader_count = 6;
+    const int writer_count = 2;
+    const int op_count = 200000;
+    mock_bcb bcb;
+    std::atomic<int> violations (0);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < reader_count; i++)
+      {
+	threads.emplace_back ([&] ()
+	{
+	  for (int op = 0; op < op_count; op++)
+	    {
+	      if (!fix_read_optimistic (bcb))
+		{
+		  continue;
+		}
+	      if (!enter_as_reader (bcb))
+		{
+		  violations++;
+		}
+	      bcb.readers_inside--;
+	      unfix_read_optimistic (bcb);
+	    }
+	});
+      }
+
+    for (int i = 0; i < writer_count; i++)
+      {
+	threads.emplace_back ([&, i] ()
+	{
+	  for (int op = 0; op < op_count / 10; op++)
+	    {
+	      bool is_fixed = ((op + i) % 2 == 0) ? fix_write_with_mutex (bcb) : fix_and_promote (bcb);
+
+	      if (!is_fixed)
+		{
+		  continue;
+		}
+	      if (!enter_as_writer (bcb))
+		{
+		  violations++;
+		}
+	      bcb.writers_inside--;
+	      unfix_with_mutex (bcb);
+	    }
+	});
+      }
+
+    for (std::thread &th : threads)
+      {
+	th.join ();
+      }
+
+    if (violations.load () != 0)
+      {
+	std::cout << "  ERROR: readers and writers were inside the page together " << violations.load () << " times"
+		  << std::endl;
+	return ER_FAILED;
+      }
+    if (bcb.fcnt != 0 || bcb.latch_mode != PGBUF_NO_LATCH)
+      {
+	std::cout << "  ERROR: page is left fixed, fcnt = " << bcb.fcnt << std::endl;
+	return ER_FAILED;
+      }
+
+    std::cout << "  optimistic fix: no conflicts between " << reader_count << " readers and " << writer_count
+	      << " writers" << std::endl;
+    return NO_ERROR;
+  }
+
+  const int THREAD_COUNTS[] = { 1, 2, 4, 8, 16, 32 };
+  test_common::string_collection step_names ("1 thread", "2 threads", "4 threads", "8 threads", "16 threads",
+      "32 threads");
+
+  enum
+  {
+    SCENARIO_OPTIMISTIC,
+    SCENARIO_MUTEX
+  };
+  test_common::string_collection scenario_names ("optimistic", "mutex");
+
+  /* each thread fixes and unfixes pages, mostly the hot few; a b-tree root and heap headers are the typical case */
+  static void
+  run_fix_unfix (std::vector<mock_bcb> &bcbs, bool is_optimistic, int op_count, unsigned int seed)
+  {
+    const int hot_count = 4;
+    std::mt19937 gen (seed);
+    std::uniform_int_distribution<int> hot_dist (0, hot_count - 1);
+    std::uniform_int_distribution<int> cold_dist (0, (int) bcbs.size () - 1);
+
+    for (int op = 0; op < op_count; op++)
+      {
+	mock_bcb &bcb = bcbs[(op % 8 == 0) ? cold_dist (gen) : hot_dist (gen)];
+
+	if (is_optimistic)
+	  {
+	    if (fix_read_optimistic (bcb))
+	      {
+		unfix_read_optimistic (bcb);
+	      }
+	  }
+	else
+	  {
+	    if (fix_read_with_mutex (bcb))
+	      {
+		unfix_with_mutex (bcb);
+	      }
+	  }
+      }
+  }
+
+  int
+  test_optimistic_fix_performance (void)
+  {
+    const int op_count = 200000;
+    const int page_count = 256;
+    test_common::perf_compare compare_result (scenario_names, step_names);
+
+    std::cout << "read fix/unfix of " << page_count << " pages, " << op_count << " per thread" << std::endl;
+
+    for (size_t scenario = 0; scenario < scenario_names.get_count (); scenario++)
+      {
+	for (size_t step = 0; step < step_names.get_count (); step++)
+	  {
+	    std::vector<mock_bcb> bcbs (page_count);
+	    std::vector<std::thread> threads;
+	    int thread_count = THREAD_COUNTS[step];
+
+	    for (int page_id = 0; page_id < page_count; page_id++)
+	      {
+		bcbs[page_id].vpid.pageid = page_id;
+	      }
+
+	    test_common::us_timer timer;
+	    for (int i = 0; i < thread_count; i++)
+	      {
+		threads.emplace_back (run_fix_unfix, std::ref (bcbs), scenario == SCENARIO_OPTIMISTIC, op_count,
+				      (unsigned int) i);
+	      }
+	    for (std::thread &th : threads)
+	      {
+		th.join ();
+	      }
+	    std::uint64_t elapsed_us = timer.time ().count ();
+	    compare_result.register_time (timer, scenario, step);
+
+	    std::cout << "  " << scenario_names.get_name (scenario) << ", " << step_names.get_name (step) << ": "
+		      << (elapsed_us > 0 ? (std::uint64_t) thread_count * op_count / elapsed_us : 0)
+		      << " fixes per microsecond" << std::endl;
+	  }
+      }
+
+    std::cout << std::endl;
+    compare_result.print_results_and_warnings (std::cout);
+
+    return NO_ERROR;
+  }
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _TEST_PAGE_BUFFER_HPP_
+#define _TEST_PAGE_BUFFER_HPP_
+
+namespace test_page_buffer
+{
+  /* readers fix optimistically while writers latch and promote; check they never overlap */
+  int test_optimistic_fix_correctness (void);
+
+  /* time concurrent read fix/unfix of hot pages, with bcb mutex only and with optimistic fix, for growing number of
+   * threads */
+  int test_optimistic_fix_performance (void);
+}
+
+#endif // _TEST_PAGE_BUFFER_HPP_
@@ -0,0 +1,410 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/* own header */
+#include "test_parallel_sort.hpp"
+
+/* header in same module */
+#include "test_perf_compare.hpp"
+
+/* headers from cubrid */
+#include "dbtype_def.h"
+#include "error_code.h"
+#include "parallel_sort.hpp"
+
+/* system headers */
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace test_parallel_sort
+{
+  /* the records sorted by the test; like SORT_REC, duplicates are chained */
+  struct test_record
+  {
+    int key;
+    test_record *next;
+  };
+
+  static int
+  compare_records (const void *left, const void *right, void *arg)
+  {
+    const test_record *left_rec = * (test_record *const *) left;
+    const test_record *right_rec = * (test_record *const *) right;
+
+    (void) arg;
+    return left_rec->key < right_rec->key ? DB_LT : (left_rec->key > right_rec->key ? DB_GT : DB_EQ);
+  }
+
+  /* append left and its chain to the chain of right, like sort_append */
+  static void
+  append_record (const void *left, const void *right)
+  {
+    test_record *node = * (test_record * const *) left;
+    test_record *list = * (test_record * const *) right;
+
+    while (list->next != NULL)
+      {
+	list = list->next;
+      }
+    list->next = node;
+  }
+
+  /* sort a partition into buff and combine equal records, as the run sort of external sort does */
+  static char **
+  run_sort (char **vector, long size, char **buff, long *result_size, bool keep_dup)
+  {
+    long count = 0;
+
+    std::stable_sort (vector, vector + size, [] (char *left, char *right)
+    {
+      return compare_records (&left, &right, NULL) == DB_LT;
+    });
+
+    for (long i = 0; i < size; i++)
+      {
+	if (count > 0 && compare_records (&buff[count - 1], &vector[i], NULL) == DB_EQ)
+	  {
+	    if (keep_dup)
+	      {
+		append_record (&buff[count - 1], &vector[i]);
+	      }
+	    buff[count - 1] = vector[i];
+	  }
+	else
+	  {
+	    buff[count++] = vector[i];
+	  }
+      }
+
+    *result_size = count;
+    return buff;
+  }
+
+  /* a few threads running pushed tasks in order */
+  class worker_pool
+  {
+    public:
+      worker_pool (int thread_count)
+	: m_stop (false)
+      {
+	for (int i = 0; i < thread_count; i++)
+	  {
+	    m_threads.emplace_back (&worker_pool::run, this);
+	  }
+      }
+
+      ~worker_pool ()
+      {
+	{
+	  std::unique_lock<std::mutex> ulock (m_mutex);
+	  m_stop = true;
+	}
+	m_cond.notify_all ();
+	for (std::thread &t : m_threads)
+	  {
+	    t.join ();
+	  }
+      }
+
+      void push (const parallel_sort::task_func &task)
+      {
+	{
+	  std::unique_lock<std::mutex> ulock (m_mutex);
+	  m_tasks.push_back (task);
+	}
+	m_cond.notify_one ();
+      }
+
+    private:
+      void run ()
+      {
+	std::unique_lock<std::mutex> ulock (m_mutex);
+
+	while (true)
+	  {
+	    m_cond.wait (ulock, [this] { return m_stop || !m_tasks.empty (); });
+	    if (m_tasks.empty ())
+	      {
+		return;
+	      }
+	    parallel_sort::task_func task = m_tasks.front ();
+	    m_tasks.pop_front ();
+
+	    ulock.unlock ();
+	    task (NULL);
+	    ulock.lock ();
+	  }
+      }
+
+      std::mutex m_mutex;
+      std::condition_variable m_cond;
+      std::deque<parallel_sort::task_func> m_tasks;
+      std::vector<std::thread> m_threads;
+      bool m_stop;
+  };
+
+  /* records with random keys and the arrays sorted by parallel_sort */
+  struct sort_input
+  {
+    std::vector<test_record> records;
+    std::vector<char *> vector;
+    std::vector<char *> buff;
+    std::set<int> keys;
+
+    sort_input (long count, int key_range)
+      : records (count)
+      , vector (count)
+      , buff (count)
+    {
+      std::mt19937 gen (static_cast<unsigned int> (count));
+      std::uniform_int_distribution<int> dist (0, key_range - 1);
+
+      for (long i = 0; i < count; i++)
+	{
+	  records[i].key = dist (gen);
+	  records[i].next = NULL;
+	  vector[i] = reinterpret_cast<char *> (&records[i]);
+	  keys.insert (records[i].key);
+	}
+    }
+  };
+
+  /* check result holds every key once in order and, if duplicates are kept, every record */
+  static bool
+  check_result (const sort_input &input, char **result, long result_size, bool keep_dup)
+  {
+    long record_count = 0;
+
+    if (result == NULL)
+      {
+	std::cout << "  ERROR: sort failed" << std::endl;
+	return false;
+      }
+    if (result_size != (long) input.keys.size ())
+      {
+	std::cout << "  ERROR: " << result_size << " keys sorted out of " << input.keys.size () << std::endl;
+	return false;
+      }
+
+    for (long i = 0; i < result_size; i++)
+      {
+	if (i > 0 && compare_records (&result[i - 1], &result[i], NULL) != DB_LT)
+	  {
+	    std::cout << "  ERROR: keys out of order at " << i << std::endl;
+	    return false;
+	  }
+	for (test_record *rec = reinterpret_cast<test_record *> (result[i]); rec != NULL; rec = rec->next)
+	  {
+	    if (rec->key != reinterpret_cast<test_record *> (result[i])->key)
+	      {
+		std::cout << "  ERROR: record chained to another key at " << i << std::endl;
+		return false;
+	      }
+	    record_count++;
+	  }
+      }
+
+    if (keep_dup && record_count != (long) input.records.size ())
+      {
+	std::cout << "  ERROR: " << record_count << " records kept out of " << input.records.size () << std::endl;
+	return false;
+      }
+
+    return true;
+  }
+
+  int
+  test_sort_correctness (void)
+  {
+    const long record_count = 100003;
+    const long min_run_size = 1024;
+    const int degrees[] = { 1, 2, 3, 4, 8 };
+    worker_pool pool (4);
+
+    for (int degree : degrees)
+      {
+	for (int keep_dup = 0; keep_dup <= 1; keep_dup++)
+	  {
+	    sort_input input (record_count, (int) record_count / 4);
+	    std::thread::id sorting_thread = std::this_thread::get_id ();
+	    std::atomic<int> leaf_count (0);
+	    std::atomic<int> worker_leaf_count (0);
+	    long result_size = 0;
+
+	    parallel_sort sorter (degree, min_run_size,
+				  [&] (THREAD_ENTRY *, char **vector, long size, char **buff, long *result_size)
+	    {
+	      leaf_count++;
+	      if (std::this_thread::get_id () != sorting_thread)
+		{
+		  worker_leaf_count++;
+		}
+	      return run_sort (vector, size, buff, result_size, keep_dup != 0);
+	    },
+	    compare_records, NULL, keep_dup ? append_record : NULL,
+	    [&pool] (const parallel_sort::task_func &task)
+	    {
+	      pool.push (task);
+	    });
+
+	    char **result = sorter.sort (NULL, input.buff.data (), input.vector.data (), record_count, &result_size);
+	    if (!check_result (input, result, result_size, keep_dup != 0))
+	      {
+		std::cout << "  degree " << degree << (keep_dup ? ", keep" : ", eliminate") << " duplicates" << std::endl;
+		return ER_FAILED;
+	      }
+	    if (leaf_count != sorter.get_degree ())
+	      {
+		std::cout << "  ERROR: " << leaf_count << " partitions sorted with degree " << sorter.get_degree ()
+			  << std::endl;
+		return ER_FAILED;
+	      }
+
+	    std::cout << "  degree " << sorter.get_degree () << (keep_dup ? ", keep" : ", eliminate")
+		      << " duplicates: " << worker_leaf_count << " of " << leaf_count << " partitions sorted by workers"
+		      << std::endl;
+	  }
+      }
+
+    return NO_ERROR;
+  }
+
+  int
+  test_sort_saturated_pool (void)
+  {
+    const long record_count = 100003;
+    const long min_run_size = 1024;
+    const int degree = 8;
+    std::vector<parallel_sort::task_func> stuck_tasks;
+    std::atomic<int> leaf_count (0);
+    long result_size = 0;
+    sort_input input (record_count, (int) record_count / 4);
+
+    {
+      parallel_sort sorter (degree, min_run_size,
+			    [&] (THREAD_ENTRY *, char **vector, long size, char **buff, long *result_size)
+      {
+	leaf_count++;
+	return run_sort (vector, size, buff, result_size, true);
+      },
+      compare_records, NULL, append_record,
+      [&stuck_tasks] (const parallel_sort::task_func &task)
+      {
+	stuck_tasks.push_back (task);
+      });
+
+      char **result = sorter.sort (NULL, input.buff.data (), input.vector.data (), record_count, &result_size);
+      if (!check_result (input, result, result_size, true))
+	{
+	  return ER_FAILED;
+	}
+    }
+
+    /* every node of every level is handed over, except the first one */
+    size_t handed_over_count = 0;
+    for (int node_count = degree; node_count >= 1; node_count /= 2)
+      {
+	handed_over_count += node_count - 1;
+      }
+    if (stuck_tasks.size () != handed_over_count)
+      {
+	std::cout << "  ERROR: " << stuck_tasks.size () << " tasks handed over" << std::endl;
+	return ER_FAILED;
+      }
+
+    /* the sort is over and the sorter is gone; the tasks must only release the shared state */
+    int leaves_before = leaf_count;
+    for (const parallel_sort::task_func &task : stuck_tasks)
+      {
+	task (NULL);
+      }
+    if (leaf_count != leaves_before || leaf_count != degree)
+      {
+	std::cout << "  ERROR: late tasks sorted partitions" << std::endl;
+	return ER_FAILED;
+      }
+
+    return NO_ERROR;
+  }
+
+  static const long RECORD_COUNTS[] = { 256 * 1024, 1024 * 1024, 4 * 1024 * 1024 };
+  test_common::string_collection step_names ("256K records", "1M records", "4M records");
+  enum
+  {
+    SCENARIO_PARALLEL,
+    SCENARIO_SERIAL
+  };
+  test_common::string_collection scenario_names ("parallel, degree 4", "serial");
+
+  int
+  test_sort_performance (void)
+  {
+    const long min_run_size = 16 * 1024;
+    const int degree = 4;
+    test_common::perf_compare compare_result (scenario_names, step_names);
+    worker_pool pool (degree);
+
+    for (size_t scenario = 0; scenario < scenario_names.get_count (); scenario++)
+      {
+	for (size_t step = 0; step < step_names.get_count (); step++)
+	  {
+	    long record_count = RECORD_COUNTS[step];
+	    long result_size = 0;
+	    sort_input input (record_count, 1 << 30);
+
+	    parallel_sort sorter (scenario == SCENARIO_PARALLEL ? degree : 1, min_run_size,
+				  [] (THREAD_ENTRY *, char **vector, long size, char **buff, long *result_size)
+	    {
+	      return run_sort (vector, size, buff, result_size, true);
+	    },
+	    compare_records, NULL, append_record,
+	    [&pool] (const parallel_sort::task_func &task)
+	    {
+	      pool.push (task);
+	    });
+
+	    test_common::us_timer timer;
+	    char **result = sorter.sort (NULL, input.buff.data (), input.vector.data (), record_count, &result_size);
+	    std::uint64_t elapsed_us = timer.time ().count ();
+	    compare_result.register_time (timer, scenario, step);
+
+	    if (!check_result (input, result, result_size, true))
+	      {
+		return ER_FAILED;
+	      }
+
+	    std::cout << "  " << scenario_names.get_name (scenario) << ", " << step_names.get_name (step) << ": "
+		      << elapsed_us / 1000 << " ms" << std::endl;
+	  }
+      }
+
+    std::cout << std::endl;
+    compare_result.print_results_and_warnings (std::cout);
+
+    return NO_ERROR;
+  }
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _TEST_PARALLEL_SORT_HPP_
+#define _TEST_PARALLEL_SORT_HPP_
+
+namespace test_parallel_sort
+{
+  /* sort random keys with degrees 1 to 8 on a worker pool, keeping and eliminating duplicates; check the order and
+   * that no record is lost */
+  int test_sort_correctness (void);
+
+  /* sort with a worker pool that never starts the tasks until the sort is over; check the sorting thread does all
+   * the work and late tasks exit */
+  int test_sort_saturated_pool (void);
+
+  /* time parallel sort against serial sort of growing arrays */
+  int test_sort_performance (void);
+}
+
+#endif // _TEST_PARALLEL_SORT_HPP_
@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "test_apply_dependency.hpp"
+
+#include "replication_apply_dependency.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace test_replication
+{
+  using cubreplication::apply_dependency_graph;
+  using key_vector = std::vector<apply_dependency_graph::key>;
+  using ticket_vector = std::vector<apply_dependency_graph::ticket>;
+
+  static bool
+  check_ready (const ticket_vector &ready, const ticket_vector &expected)
+  {
+    ticket_vector sorted_ready = ready;
+
+    std::sort (sorted_ready.begin (), sorted_ready.end ());
+    return sorted_ready == expected;
+  }
+
+#define CHECK_APPLY_DEPENDENCY(cond) \
+  if (!(cond)) \
+    { \
+      std::cout << "  check failed at line " << __LINE__ << ": " << #cond << std::endl; \
+      return 1; \
+    }
+
+  int
+  test_apply_dependency_order (void)
+  {
+    std::cout << "test_apply_dependency_order" << std::endl;
+
+    const key_vector no_keys;
+    ticket_vector ready;
+
+    // same row is applied in commit order, other rows do not wait
+    {
+      apply_dependency_graph graph;
+
+      CHECK_APPLY_DEPENDENCY (graph.add (1, { 10 }, no_keys, false));
+      CHECK_APPLY_DEPENDENCY (!graph.add (2, { 10, 20 }, no_keys, false));
+      CHECK_APPLY_DEPENDENCY (graph.add (3, { 30 }, no_keys, false));
+      CHECK_APPLY_DEPENDENCY (!graph.add (4, { 20 }, no_keys, false));
+      CHECK_APPLY_DEPENDENCY (graph.get_count () == 4);
+
+      ready.clear ();
+      graph.finish (3, ready);
+      CHECK_APPLY_DEPENDENCY (ready.empty ());
+      graph.finish (1, ready);
+      CHECK_APPLY_DEPENDENCY (check_ready (ready, { 2 }));
+      ready.clear ();
+      graph.finish (2, ready);
+      CHECK_APPLY_DEPENDENCY (check_ready (ready, { 4 }));
+      ready.clear ();
+      graph.finish (4, ready);
+      CHECK_APPLY_DEPENDENCY (ready.empty ());
+      CHECK_APPLY_DEPENDENCY (graph.is_empty ());
+
+      // finished keys do not order new transactions
+      CHECK_APPLY_DEPENDENCY (graph.add (5, { 10, 20, 30 }, no_keys, false));
+    }
+
+    // repeated keys wait once
+    {
+      apply_dependency_graph graph;
+
+      CHECK_APPLY_DEPENDENCY (graph.add (1, { 10, 20 }, no_keys, false));
+      CHECK_APPLY_DEPENDENCY (!graph.add (2, { 20, 10, 10, 20 }, no_keys, false));
+
+      ready.clear ();
+      graph.finish (1, ready);
+      CHECK_APPLY_DEPENDENCY (check_ready (ready, { 2 }));
+    }
+
+    // shared keys do not conflict with each other
+    {
+      apply_dependency_graph graph;
+
+      CHECK_APPLY_DEPENDENCY (graph.add (1, { 10 }, { 100 }, false));
+      CHECK_APPLY_DEPENDENCY (graph.add (2, { 20 }, { 100 }, false));
+      CHECK_APPLY_DEPENDENCY (!graph.add (3, { 100 }, no_keys, false));
+      CHECK_APPLY_DEPENDENCY (!graph.add (4, { 30 }, { 100 }, false));
+      // exclusive wins over shared of same transaction
+      CHECK_APPLY_DEPENDENCY (!graph.add (5, { 100 }, { 100 }, false));
+
+      ready.clear ();
+      graph.finish (2, ready);
+      CHECK_APPLY_DEPENDENCY (ready.empty ());
+      graph.finish (1, ready);
+      CHECK_APPLY_DEPENDENCY (check_ready (ready, { 3 }));
+      ready.clear ();
+      graph.finish (3, ready);
+      CHECK_APPLY_DEPENDENCY (check_ready (ready, { 4 }));
+      ready.clear ();
+      graph.finish (4, ready);
+      CHECK_APPLY_DEPENDENCY (check_ready (ready, { 5 }));
+    }
+
+    // barrier waits for everything before; everything after waits for barrier
+    {
+      apply_dependency_graph graph;
+
+      CHECK_APPLY_DEPENDENCY (graph.add (1, { 10 }, no_keys, false));
+      CHECK_APPLY_DEPENDENCY (graph.add (2, { 20 }, no_keys, false));
+      CHECK_APPLY_DEPENDENCY (!graph.add (3, no_keys, no_keys, true));
+      CHECK_APPLY_DEPENDENCY (!graph.add (4, { 30 }, no_keys, false));
+      CHECK_APPLY_DEPENDENCY (!graph.add (5, no_keys, no_keys, false));
+
+      ready.clear ();
+      graph.finish (1, ready);
+      CHECK_APPLY_DEPENDENCY (ready.empty ());
+      graph.finish (2, ready);
+      CHECK_APPLY_DEPENDENCY (check_ready (ready, { 3 }));
+      ready.clear ();
+      graph.finish (3, ready);
+      CHECK_APPLY_DEPENDENCY (check_ready (ready, { 4, 5 }));
+
+      // a barrier with nothing before starts immediately
+      apply_dependency_graph empty_graph;
+      CHECK_APPLY_DEPENDENCY (empty_graph.add (1, no_keys, no_keys, true));
+    }
+
+    return 0;
+  }
+
+  // random transactions applied in random order; each must start only after all conflicting transactions added
+  // before it have finished
+  int
+  test_apply_dependency_random (void)
+  {
+    std::cout << "test_apply_dependency_random" << std::endl;
+
+    struct transaction
+    {
+      key_vector m_exclusive;
+      key_vector m_shared;
+      bool m_is_barrier;
+      bool m_is_started;
+      bool m_is_finished;
+    };
+
+    const std::size_t TRAN_COUNT = 20000;
+    const std::size_t MAX_RUNNING = 16;
+    const apply_dependency_graph::key KEY_COUNT = 200;
+
+    std::mt19937 gen (7);
+    std::vector<transaction> trans (TRAN_COUNT);
+    apply_dependency_graph graph;
+    ticket_vector running;
+    ticket_vector ready;
+    std::size_t next_add = 0;
+    std::size_t finished_count = 0;
+    std::size_t max_running = 0;
+    std::set<std::size_t> unfinished;
+
+    for (transaction &tran : trans)
+      {
+	tran.m_is_barrier = gen () % 500 == 0;
+	for (std::size_t i = gen () % 4; i > 0; i--)
+	  {
+	    tran.m_exclusive.push_back (gen () % KEY_COUNT);
+	  }
+	for (std::size_t i = gen () % 3; i > 0; i--)
+	  {
+	    // few shared keys, some also used exclusive
+	    tran.m_shared.push_back (KEY_COUNT - 10 + gen () % 20);
+	  }
+	tran.m_is_started = false;
+	tran.m_is_finished = false;
+      }
+
+    auto conflicts = [&trans] (std::size_t earlier, std::size_t later)
+    {
+      const transaction &a = trans[earlier];
+      const transaction &b = trans[later];
+
+      if (a.m_is_barrier || b.m_is_barrier)
+	{
+	  return true;
+	}
+      for (apply_dependency_graph::key k : b.m_exclusive)
+	{
+	  if (std::find (a.m_exclusive.begin (), a.m_exclusive.end (), k) != a.m_exclusive.end ()
+	      || std::find (a.m_shared.begin (), a.m_shared.end (), k) != a.m_shared.end ())
+	    {
+	      return true;
+	    }
+	}
+      for (apply_dependency_graph::key k : b.m_shared)
+	{
+	  if (std::find (a.m_exclusive.begin (), a.m_exclusive.end (), k) != a.m_exclusive.end ())
+	    {
+	      return true;
+	    }
+	}
+      return false;
+    };
+
+    auto start = [&] (apply_dependency_graph::ticket tran) -> bool
+    {
+      for (std::size_t earlier : unfinished)
+	{
+	  if (earlier >= tran)
+	    {
+	      break;
+	    }
+	  if (conflicts (earlier, (std::size_t) tran))
+	    {
+	      std::cout << "  transaction " << tran << " started before " << earlier << std::endl;
+	      return false;
+	    }
+	}
+      trans[tran].m_is_started = true;
+      running.push_back (tran);
+      return true;
+    };
+
+    while (finished_count < TRAN_COUNT)
+      {
+	// add while dispatch limit allows
+	while (next_add < TRAN_COUNT && graph.get_count () < MAX_RUNNING * 8)
+	  {
+	    transaction &tran = trans[next_add];
+	    unfinished.insert (next_add);
+	    if (graph.add (next_add, tran.m_exclusive, tran.m_shared, tran.m_is_barrier))
+	      {
+		CHECK_APPLY_DEPENDENCY (start (next_add));
+	      }
+	    next_add++;
+	  }
+
+	CHECK_APPLY_DEPENDENCY (!running.empty ());
+	max_running = std::max (max_running, running.size ());
+
+	// finish a random running transaction
+	std::size_t pos = gen () % std::min (running.size (), MAX_RUNNING);
+	apply_dependency_graph::ticket done = running[pos];
+	running.erase (running.begin () + pos);
+
+	trans[done].m_is_finished = true;
+	unfinished.erase (done);
+	finished_count++;
+
+	ready.clear ();
+	graph.finish (done, ready);
+	for (apply_dependency_graph::ticket tran : ready)
+	  {
+	    CHECK_APPLY_DEPENDENCY (!trans[tran].m_is_started);
+	    CHECK_APPLY_DEPENDENCY (start (tran));
+	  }
+      }
+
+    CHECK_APPLY_DEPENDENCY (graph.is_empty ());
+    CHECK_APPLY_DEPENDENCY (running.empty ());
+    // independent transactions were ready together
+    CHECK_APPLY_DEPENDENCY (max_running > 1);
+
+    std::cout << "  max ready transactions: " << max_running << std::endl;
+    return 0;
+  }
+} // namespace test_replication
@@ -17,6 +17,7 @@
  *
  */
 
+#include "test_apply_dependency.hpp"
 #include "test_log_generator.hpp"
 #include <iostream>
 
@@ -52,6 +53,9 @@ int main ()
   test_module (global_error, test_replication::test_log_generator2);
 #endif
 
+  test_module (global_error, test_replication::test_apply_dependency_order);
+  test_module (global_error, test_replication::test_apply_dependency_random);
+
   /* add more tests here */
 
   return global_error;
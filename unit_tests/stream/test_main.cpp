@@ -59,6 +59,15 @@ int main ()
 
   test_module (global_error, test_stream::test_stream_file1, 1024, 1024 * 1024, 256 * 1024);
 
+  /* block compression; stream file with compressed volumes   file_size, desired_amount, buffer_size, codec */
+  test_module (global_error, test_stream::test_stream_compression);
+
+  test_module (global_error, test_stream::test_stream_file_compressed, 256 * 1024, 2 * 1024 * 1024, 100 * 1024,
+	       cubstream::COMPRESSION_LZO1X_1);
+
+  test_module (global_error, test_stream::test_stream_file_compressed, 16 * 1024, 512 * 1024, 1024,
+	       cubstream::COMPRESSION_LZO1X_999);
+
   /* MT test with multiple writers/readers and stream file: */
   test_module (global_error, test_stream::test_stream_file_mt,
 	       4,  /* pack_threads */
@@ -1362,6 +1362,245 @@ namespace test_stream
     return res;
   }
 
+  /* fills buffer with text like data, which compresses well */
+  static void
+  generate_compressible_data (char *buffer, size_t size)
+  {
+    static const char *words[] = { "insert ", "update ", "delete ", "t_orders ", "t_items ", "id = ", "name = " };
+
+    for (size_t i = 0; i < size;)
+      {
+	const char *word = words[std::rand () % (sizeof (words) / sizeof (words[0]))];
+
+	for (const char *c = word; *c != '\0' && i < size; c++, i++)
+	  {
+	    buffer[i] = *c;
+	  }
+	if (i < size && std::rand () % 4 == 0)
+	  {
+	    buffer[i++] = '0' + std::rand () % 10;
+	  }
+      }
+  }
+
+  static int
+  check_compressed_block (cubstream::block_compressor &compressor, const char *raw, size_t raw_size,
+			  size_t &block_size)
+  {
+    std::vector<char> block (cubstream::get_compressed_block_max_size (raw_size));
+    std::vector<char> decompressed (raw_size);
+    cubstream::compressed_block_header header;
+
+    block_size = compressor.compress (raw, raw_size, block.data ());
+    if (block_size > block.size ())
+      {
+	std::cout << "  block overflow: " << block_size << std::endl;
+	return -1;
+      }
+
+    if (!cubstream::read_compressed_block_header (block.data (), block_size, header)
+	|| header.m_raw_size != raw_size
+	|| header.m_stored_size != block_size - cubstream::COMPRESSED_BLOCK_HEADER_SIZE)
+      {
+	std::cout << "  invalid header for " << raw_size << " bytes" << std::endl;
+	return -1;
+      }
+    if (!cubstream::decompress_block (header, block.data () + cubstream::COMPRESSED_BLOCK_HEADER_SIZE,
+				      decompressed.data ())
+	|| std::memcmp (raw, decompressed.data (), raw_size) != 0)
+      {
+	std::cout << "  decompressed data does not match for " << raw_size << " bytes" << std::endl;
+	return -1;
+      }
+
+    if (header.m_codec != cubstream::COMPRESSION_NONE)
+      {
+	/* payload does not end where the header says */
+	header.m_stored_size--;
+	if (cubstream::decompress_block (header, block.data () + cubstream::COMPRESSED_BLOCK_HEADER_SIZE,
+					 decompressed.data ()))
+	  {
+	    std::cout << "  truncated payload not detected" << std::endl;
+	    return -1;
+	  }
+      }
+
+    return 0;
+  }
+
+  int test_stream_compression (void)
+  {
+    const cubstream::compression_codec codecs[] =
+    {
+      cubstream::COMPRESSION_NONE, cubstream::COMPRESSION_LZO1X_1, cubstream::COMPRESSION_LZO1X_999
+    };
+    const size_t sizes[] = { 1, 100, 4096, cubstream::COMPRESSED_BLOCK_MAX_RAW_SIZE };
+    const size_t max_size = cubstream::COMPRESSED_BLOCK_MAX_RAW_SIZE;
+    std::vector<char> compressible (max_size);
+    std::vector<char> random (max_size);
+    size_t block_size;
+
+    generate_compressible_data (compressible.data (), max_size);
+    for (size_t i = 0; i < max_size; i++)
+      {
+	random[i] = std::rand () % 256;
+      }
+
+    for (cubstream::compression_codec codec : codecs)
+      {
+	cubstream::block_compressor compressor (codec);
+
+	for (size_t size : sizes)
+	  {
+	    if (check_compressed_block (compressor, compressible.data (), size, block_size) != 0)
+	      {
+		return -1;
+	      }
+	    if (size == max_size)
+	      {
+		std::cout << "  codec " << codec << ": " << size << " bytes of text stored in " << block_size
+			  << " bytes" << std::endl;
+		if (codec != cubstream::COMPRESSION_NONE && block_size >= size / 2)
+		  {
+		    std::cout << "  text was not compressed" << std::endl;
+		    return -1;
+		  }
+	      }
+
+	    if (check_compressed_block (compressor, random.data (), size, block_size) != 0)
+	      {
+		return -1;
+	      }
+	    /* incompressible data is stored as is */
+	    if (block_size != cubstream::COMPRESSED_BLOCK_HEADER_SIZE + size)
+	      {
+		std::cout << "  random data stored in " << block_size << " bytes" << std::endl;
+		return -1;
+	      }
+	  }
+      }
+
+    /* corrupted headers */
+    cubstream::block_compressor compressor (cubstream::COMPRESSION_LZO1X_1);
+    std::vector<char> block (cubstream::get_compressed_block_max_size (max_size));
+    cubstream::compressed_block_header header;
+
+    block_size = compressor.compress (compressible.data (), max_size, block.data ());
+    if (cubstream::read_compressed_block_header (block.data (), cubstream::COMPRESSED_BLOCK_HEADER_SIZE - 1, header))
+      {
+	std::cout << "  short header not detected" << std::endl;
+	return -1;
+      }
+
+    const size_t corrupted_offsets[] =
+    {
+      0,  /* magic */
+      2,  /* codec */
+      4,  /* raw size */
+      8   /* stored size */
+    };
+    for (size_t offset : corrupted_offsets)
+      {
+	std::vector<char> corrupted (block.begin (), block.begin () + block_size);
+
+	corrupted[offset] = (char) 0xff;
+	if (cubstream::read_compressed_block_header (corrupted.data (), corrupted.size (), header))
+	  {
+	    std::cout << "  corrupted header byte " << offset << " not detected" << std::endl;
+	    return -1;
+	  }
+      }
+
+    return 0;
+  }
+
+  int test_stream_file_compressed (size_t file_size, size_t desired_amount, size_t buffer_size,
+				   cubstream::compression_codec codec)
+  {
+    int res = 0;
+    size_t stream_buffer_size = 1 * 1024 * 1024;
+
+    init_common_cubrid_modules ();
+
+    mts_dummy *my_stream = new mts_dummy (stream_buffer_size, 100);
+
+    my_stream->set_name ("my_test_stream");
+
+    /* path is current folder */
+    system ("mkdir test_stream_folder");
+
+    cubstream::stream_file *my_stream_file =
+	    new cubstream::stream_file (*my_stream, "test_stream_folder", file_size, 2);
+    my_stream_file->stop_daemon ();
+    my_stream_file->set_compression (codec);
+
+    std::cout << "  Writing compressed data to stream file, codec " << codec << std::endl;
+
+    cubstream::stream_position stream_pos = 0;
+    std::vector<char> written (desired_amount + buffer_size);
+
+    generate_compressible_data (written.data (), written.size ());
+
+    /* writing directly in stream file; the expected content is the same buffer */
+    while (stream_pos < desired_amount)
+      {
+	size_t amount = std::rand () % buffer_size;
+	amount = (amount == 0) ? 10 : amount;
+
+	my_stream->force_last_committed (stream_pos + amount);
+	my_stream_file->start_flush (stream_pos, amount);
+
+	res = my_stream_file->write (stream_pos, written.data () + stream_pos, amount);
+	if (res < 0)
+	  {
+	    assert (false);
+	    return res;
+	  }
+	stream_pos += amount;
+      }
+
+    std::vector<char> read_buffer (buffer_size);
+    const size_t read_count = 100;
+
+    /* read from volumes indexed while writing, then from volumes indexed by scanning files */
+    for (int pass = 0; pass < 2 && res == 0; pass++)
+      {
+	if (pass == 1)
+	  {
+	    /* closes volumes and forgets their index; compression setting is kept */
+	    my_stream_file->finalize ();
+	    my_stream_file->init ("test_stream_folder", stream_pos, file_size, 2);
+	    my_stream_file->stop_daemon ();
+	    my_stream_file->drop_volumes_to_pos (0, true);
+	  }
+
+	for (size_t i = 0; i < read_count; i++)
+	  {
+	    size_t amount = 1 + std::rand () % buffer_size;
+	    cubstream::stream_position read_pos = std::rand () % (stream_pos - amount);
+
+	    res = my_stream_file->read (read_pos, read_buffer.data (), amount);
+	    if (res != NO_ERROR)
+	      {
+		assert (false);
+		break;
+	      }
+	    if (std::memcmp (read_buffer.data (), written.data () + read_pos, amount) != 0)
+	      {
+		std::cout << "  read data does not match at " << read_pos << ", pass " << pass << std::endl;
+		res = -1;
+		break;
+	      }
+	  }
+      }
+
+    my_stream_file->drop_volumes_to_pos (stream_pos + my_stream_file->get_volume_size ());
+
+    delete my_stream_file;
+    delete my_stream;
+    return res;
+  }
+
   static const char OBJ_BYTE = 0x55;
   static const int OBJ_SIZE = 343;
 
@@ -23,6 +23,7 @@
 #include "packable_object.hpp"
 #include "multi_thread_stream.hpp"
 #include "stream_entry.hpp"
+#include "stream_compression.hpp"
 #include "thread_task.hpp"
 #include "thread_worker_pool.hpp"
 #include "thread_entry_task.hpp"
@@ -47,6 +48,11 @@ namespace test_stream
   int test_stream_file1 (size_t file_size, size_t desired_amount, size_t buffer_size);
   int test_stream_file2 (size_t stream_buffer_size, size_t file_size, size_t desired_amount);
 
+  /* testing of block compression and of stream file with compressed volumes */
+  int test_stream_compression (void);
+  int test_stream_file_compressed (size_t file_size, size_t desired_amount, size_t buffer_size,
+				   cubstream::compression_codec codec);
+
   int test_stream_file_mt (const int pack_threads,
                            const int unpack_threads,
                            const int read_bytes_threads,
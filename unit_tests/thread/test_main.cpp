@@ -1,12 +1,20 @@
 
 #include "test_worker_pool.hpp"
 #include "test_manager.hpp"
+#include "test_task_group.hpp"
 
 int
 main (int, char **)
 {
+  int err;
+
   (void) test_thread::test_worker_pool ();
+  err = test_thread::test_worker_pool_stealing ();
   (void) test_thread::test_manager ();
+  if (test_thread::test_task_group () != 0)
+    {
+      err = 1;
+    }
 
-  return 0;
+  return err;
 }
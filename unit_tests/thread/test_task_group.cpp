@@ -0,0 +1,800 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/*
+ * test_task_group.cpp - implementation for test thread task group
+ */
+
+#include "test_task_group.hpp"
+
+#include "thread_task_group.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace test_thread
+{
+  // context of the threads running tasks; the owner has its own
+  struct group_context
+  {
+    bool is_worker;
+  };
+
+  using test_task_group_type = cubthread::task_group<group_context>;
+
+  // a few threads running pushed tasks in order, each with its own context. the pool runs the tasks left in its queue
+  // before it is destroyed, so tasks may run after their group is gone
+  class group_pool
+  {
+    public:
+      explicit group_pool (std::size_t thread_count)
+	: m_stop (false)
+      {
+	for (std::size_t i = 0; i < thread_count; i++)
+	  {
+	    m_threads.emplace_back (&group_pool::run, this);
+	  }
+      }
+
+      ~group_pool ()
+      {
+	{
+	  std::unique_lock<std::mutex> ulock (m_mutex);
+	  m_stop = true;
+	}
+	m_cond.notify_all ();
+	for (std::thread &t : m_threads)
+	  {
+	    t.join ();
+	  }
+      }
+
+      void push (const test_task_group_type::task_func &task)
+      {
+	{
+	  std::unique_lock<std::mutex> ulock (m_mutex);
+	  m_tasks.push_back (task);
+	}
+	m_cond.notify_one ();
+      }
+
+    private:
+      void run ()
+      {
+	group_context context = { true };
+	std::unique_lock<std::mutex> ulock (m_mutex);
+
+	while (true)
+	  {
+	    m_cond.wait (ulock, [this] { return m_stop || !m_tasks.empty (); });
+	    if (m_tasks.empty ())
+	      {
+		return;
+	      }
+	    test_task_group_type::task_func task = m_tasks.front ();
+	    m_tasks.pop_front ();
+
+	    ulock.unlock ();
+	    task (context);
+	    ulock.lock ();
+	  }
+      }
+
+      std::mutex m_mutex;
+      std::condition_variable m_cond;
+      std::deque<test_task_group_type::task_func> m_tasks;
+      std::vector<std::thread> m_threads;
+      bool m_stop;
+  };
+
+  static int
+  test_all_run_once (void)
+  {
+    const std::size_t task_count = 10000;
+    group_context owner_context = { false };
+    std::unique_ptr<std::atomic<int>[]> counts (new std::atomic<int>[task_count]);
+    std::atomic<std::size_t> worker_run_count (0);
+    std::size_t worker_claimed_count;
+    group_pool pool (4);
+
+    for (std::size_t i = 0; i < task_count; i++)
+      {
+	counts[i] = 0;
+      }
+
+    {
+      test_task_group_type group ([&pool] (const test_task_group_type::task_func &task)
+      {
+	pool.push (task);
+      });
+
+      for (std::size_t i = 0; i < task_count; i++)
+	{
+	  group.hand_over ([&counts, &worker_run_count, i] (group_context &context)
+	  {
+	    ++counts[i];
+	    if (context.is_worker)
+	      {
+		++worker_run_count;
+	      }
+	  });
+	  if (i % 64 == 0)
+	    {
+	      // like the index loader when its queue grows too long
+	      (void) group.run_oldest_queued (owner_context);
+	    }
+	}
+      group.run_queued (owner_context);
+      group.wait_claimed ();
+
+      if (group.get_queued_count () != 0)
+	{
+	  std::cout << "  ERROR: " << group.get_queued_count () << " tasks still queued" << std::endl;
+	  return 1;
+	}
+      worker_claimed_count = group.get_worker_claimed_count ();
+    }
+
+    for (std::size_t i = 0; i < task_count; i++)
+      {
+	if (counts[i] != 1)
+	  {
+	    std::cout << "  ERROR: task " << i << " was executed " << counts[i] << " times" << std::endl;
+	    return 1;
+	  }
+      }
+    if (worker_run_count != worker_claimed_count)
+      {
+	std::cout << "  ERROR: " << worker_run_count << " tasks run by workers, " << worker_claimed_count
+		  << " claimed" << std::endl;
+	return 1;
+      }
+
+    std::cout << "  " << task_count << " tasks executed once, " << worker_claimed_count << " by workers" << std::endl;
+    return 0;
+  }
+
+  static int
+  test_saturated_pool (void)
+  {
+    const std::size_t task_count = 16;
+    group_context owner_context = { false };
+    group_context late_context = { true };
+    std::vector<test_task_group_type::task_func> stuck_tasks;
+    std::vector<int> counts (task_count, 0);
+    std::size_t cancelled;
+
+    // no worker ever starts; the owner runs half of the tasks and cancels the others
+    {
+      test_task_group_type group ([&stuck_tasks] (const test_task_group_type::task_func &task)
+      {
+	stuck_tasks.push_back (task);
+      });
+
+      for (std::size_t i = 0; i < task_count; i++)
+	{
+	  group.hand_over ([&counts, i] (group_context &)
+	  {
+	    counts[i]++;
+	  });
+	}
+      for (std::size_t i = 0; i < task_count / 2; i++)
+	{
+	  if (!group.run_oldest_queued (owner_context))
+	    {
+	      std::cout << "  ERROR: no queued task left after " << i << std::endl;
+	      return 1;
+	    }
+	}
+      cancelled = group.cancel_queued ();
+      group.wait_claimed ();
+
+      if (cancelled != task_count - task_count / 2 || group.run_oldest_queued (owner_context))
+	{
+	  std::cout << "  ERROR: " << cancelled << " tasks cancelled" << std::endl;
+	  return 1;
+	}
+    }
+
+    // the group is gone; the workers start at last and must not run anything
+    for (const test_task_group_type::task_func &task : stuck_tasks)
+      {
+	task (late_context);
+      }
+
+    for (std::size_t i = 0; i < task_count; i++)
+      {
+	if (counts[i] != (i < task_count / 2 ? 1 : 0))
+	  {
+	    std::cout << "  ERROR: task " << i << " was executed " << counts[i] << " times" << std::endl;
+	    return 1;
+	  }
+      }
+
+    std::cout << "  saturated pool: " << task_count / 2 << " tasks run by the owner, " << cancelled << " cancelled"
+	      << std::endl;
+    return 0;
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // parallel aggregate scan
+  //////////////////////////////////////////////////////////////////////////
+
+  const std::size_t SCAN_ROWS_PER_PAGE = 100;
+
+  struct scan_aggregate
+  {
+    std::int64_t count;
+    std::int64_t sum;
+    int min;
+    int max;
+
+    scan_aggregate ()
+      : count (0)
+      , sum (0)
+      , min (0)
+      , max (0)
+    {
+    }
+
+    void add (int value)
+    {
+      min = count == 0 ? value : std::min (min, value);
+      max = count == 0 ? value : std::max (max, value);
+      sum += value;
+      count++;
+    }
+
+    // like qdata_aggregate_accumulator_to_accumulator
+    void merge (const scan_aggregate &part)
+    {
+      if (part.count == 0)
+	{
+	  return;
+	}
+      min = count == 0 ? part.min : std::min (min, part.min);
+      max = count == 0 ? part.max : std::max (max, part.max);
+      sum += part.sum;
+      count += part.count;
+    }
+
+    bool operator== (const scan_aggregate &other) const
+    {
+      return count == other.count && sum == other.sum && min == other.min && max == other.max;
+    }
+  };
+
+  // like PARALLEL_SCAN, on the stack of the owner
+  struct scan_state
+  {
+    const std::vector<int> *rows;
+    std::size_t n_pages;
+    std::size_t chunk_size;
+    std::size_t error_page;		// a participant fails when it scans this page
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::size_t next_page;
+    int n_published;
+    bool merged;
+    bool has_error;
+
+    std::vector<std::unique_ptr<scan_aggregate>> partials;	// published partial aggregates of workers
+  };
+
+  static bool
+  scan_claim (scan_state &scan, std::size_t &first_page, std::size_t &n_pages)
+  {
+    std::unique_lock<std::mutex> ulock (scan.mutex);
+
+    if (scan.next_page >= scan.n_pages)
+      {
+	return false;
+      }
+    first_page = scan.next_page;
+    n_pages = std::min (scan.chunk_size, scan.n_pages - scan.next_page);
+    scan.next_page += n_pages;
+    return true;
+  }
+
+  // like qexec_parallel_scan_run
+  static bool
+  scan_run (scan_state &scan, scan_aggregate &aggregate)
+  {
+    std::size_t first_page, n_pages;
+
+    while (scan_claim (scan, first_page, n_pages))
+      {
+	for (std::size_t page = first_page; page < first_page + n_pages; page++)
+	  {
+	    if (page == scan.error_page)
+	      {
+		return false;
+	      }
+	    for (std::size_t row = page * SCAN_ROWS_PER_PAGE;
+		 row < std::min ((page + 1) * SCAN_ROWS_PER_PAGE, scan.rows->size ()); row++)
+	      {
+		aggregate.add ((*scan.rows)[row]);
+	      }
+	  }
+      }
+    return true;
+  }
+
+  // like qexec_parallel_scan_execute
+  static void
+  scan_execute (group_context &, scan_state *scan, std::size_t worker_index)
+  {
+    std::unique_ptr<scan_aggregate> partial (new scan_aggregate ());
+    bool is_ok = scan_run (*scan, *partial);
+
+    std::unique_lock<std::mutex> ulock (scan->mutex);
+    if (is_ok)
+      {
+	scan->partials[worker_index] = std::move (partial);
+      }
+    else
+      {
+	scan->has_error = true;
+	scan->next_page = scan->n_pages;
+      }
+    scan->n_published++;
+    scan->cond.notify_all ();
+
+    // the partial aggregate is private to the worker; it is freed once merged
+    scan->cond.wait (ulock, [scan] { return scan->merged; });
+    scan->partials[worker_index].reset ();
+  }
+
+  // like qexec_intprt_fnc_parallel; returns false on error
+  static bool
+  scan_parallel (const std::vector<int> &rows, std::size_t n_workers, std::size_t error_page,
+		 const test_task_group_type::push_func &push, scan_aggregate &result, std::size_t &worker_claimed)
+  {
+    scan_state scan;
+    bool is_ok;
+
+    scan.rows = &rows;
+    scan.n_pages = (rows.size () + SCAN_ROWS_PER_PAGE - 1) / SCAN_ROWS_PER_PAGE;
+    scan.chunk_size = std::max<std::size_t> (1, scan.n_pages / ((n_workers + 1) * 4));
+    scan.error_page = error_page;
+    scan.next_page = 0;
+    scan.n_published = 0;
+    scan.merged = false;
+    scan.has_error = false;
+    scan.partials.resize (n_workers);
+
+    {
+      test_task_group_type group (push);
+      int n_claimed;
+
+      for (std::size_t i = 0; i < n_workers; i++)
+	{
+	  group.hand_over (std::bind (scan_execute, std::placeholders::_1, &scan, i));
+	}
+
+      is_ok = scan_run (scan, result);
+      if (!is_ok)
+	{
+	  std::unique_lock<std::mutex> ulock (scan.mutex);
+	  scan.next_page = scan.n_pages;
+	}
+
+      n_claimed = (int) (n_workers - group.cancel_queued ());
+      {
+	std::unique_lock<std::mutex> ulock (scan.mutex);
+	scan.cond.wait (ulock, [&scan, n_claimed] { return scan.n_published == n_claimed; });
+      }
+
+      if (is_ok && !scan.has_error)
+	{
+	  for (const std::unique_ptr<scan_aggregate> &partial : scan.partials)
+	    {
+	      if (partial != NULL)
+		{
+		  result.merge (*partial);
+		}
+	    }
+	}
+
+      {
+	std::unique_lock<std::mutex> ulock (scan.mutex);
+	scan.merged = true;
+	scan.cond.notify_all ();
+      }
+      group.wait_claimed ();
+      worker_claimed = group.get_worker_claimed_count ();
+    }
+
+    return is_ok && !scan.has_error;
+  }
+
+  static int
+  test_parallel_scan (void)
+  {
+    const std::size_t row_count = 1000003;
+    const std::size_t no_error = static_cast<std::size_t> (-1);
+    std::vector<int> rows (row_count);
+    std::mt19937 gen (7);
+    std::uniform_int_distribution<int> dist (-1000000, 1000000);
+    scan_aggregate serial;
+
+    for (std::size_t i = 0; i < row_count; i++)
+      {
+	rows[i] = dist (gen);
+	serial.add (rows[i]);
+      }
+
+    // workers of a pool, including a pool with less threads than workers
+    const std::size_t pool_sizes[] = { 3, 1, 8 };
+    const std::size_t worker_counts[] = { 3, 7, 3 };
+    for (std::size_t step = 0; step < sizeof (pool_sizes) / sizeof (pool_sizes[0]); step++)
+      {
+	group_pool pool (pool_sizes[step]);
+	scan_aggregate result;
+	std::size_t worker_claimed = 0;
+
+	if (!scan_parallel (rows, worker_counts[step], no_error, [&pool] (const test_task_group_type::task_func &task)
+	{
+	  pool.push (task);
+	}, result, worker_claimed)
+	|| ! (result == serial))
+	  {
+	    std::cout << "  ERROR: parallel scan with " << worker_counts[step] << " workers on " << pool_sizes[step]
+		      << " threads differs from serial scan" << std::endl;
+	    return 1;
+	  }
+	std::cout << "  parallel scan: " << worker_claimed << " of " << worker_counts[step] << " workers scanned on "
+		  << pool_sizes[step] << " threads" << std::endl;
+      }
+
+    // no worker starts before the scan is over; they start after the state of the scan is gone
+    {
+      std::vector<test_task_group_type::task_func> stuck_tasks;
+      group_context late_context = { true };
+      scan_aggregate result;
+      std::size_t worker_claimed = 0;
+
+      if (!scan_parallel (rows, 3, no_error, [&stuck_tasks] (const test_task_group_type::task_func &task)
+      {
+	stuck_tasks.push_back (task);
+      }, result, worker_claimed)
+      || ! (result == serial) || worker_claimed != 0)
+	{
+	  std::cout << "  ERROR: parallel scan on a saturated pool differs from serial scan" << std::endl;
+	  return 1;
+	}
+      for (const test_task_group_type::task_func &task : stuck_tasks)
+	{
+	  task (late_context);
+	}
+    }
+
+    // a participant fails; the scan fails and every worker still frees its partial aggregate
+    {
+      group_pool pool (3);
+      scan_aggregate result;
+      std::size_t worker_claimed = 0;
+
+      if (scan_parallel (rows, 3, (row_count / SCAN_ROWS_PER_PAGE) / 2,
+			 [&pool] (const test_task_group_type::task_func &task)
+      {
+	pool.push (task);
+	}, result, worker_claimed))
+	{
+	  std::cout << "  ERROR: parallel scan did not fail" << std::endl;
+	  return 1;
+	}
+    }
+
+    std::cout << "  parallel scan: results equal serial scan" << std::endl;
+    return 0;
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // parallel leaf build
+  //////////////////////////////////////////////////////////////////////////
+
+  const std::size_t LEAF_KEYS_PER_PAGE = 50;
+  const std::size_t LEAF_RANGE_ITEMS = 5000;
+  const std::size_t LEAF_RANGES_PER_WORKER = 2;
+
+  struct leaf_page
+  {
+    std::vector<std::pair<int, int>> records;	// key and object count
+    int prev;
+    int next;
+  };
+
+  // like the pages of the index file; pages are allocated concurrently, like with file_alloc
+  struct leaf_file
+  {
+    std::vector<leaf_page> pages;
+    std::atomic<int> n_pages;
+
+    explicit leaf_file (std::size_t max_pages)
+      : pages (max_pages)
+      , n_pages (0)
+    {
+    }
+
+    int alloc ()
+    {
+      int page_id = n_pages++;
+      pages[page_id].prev = -1;
+      pages[page_id].next = -1;
+      return page_id;
+    }
+  };
+
+  // like BTREE_LOAD_RANGE
+  struct leaf_range
+  {
+    std::size_t begin;
+    std::size_t end;
+    int first_leaf;
+    int last_leaf;
+    std::size_t n_keys;
+    bool has_error;
+  };
+
+  // like btree_construct_leafs and btree_save_last_leafrec; a key with more than one object violates a unique index
+  static void
+  leaf_range_build (leaf_file &file, const std::vector<int> &items, bool is_unique, leaf_range &range)
+  {
+    int page_id = -1;
+
+    range.first_leaf = range.last_leaf = -1;
+    range.n_keys = 0;
+    range.has_error = false;
+
+    for (std::size_t i = range.begin; i < range.end; i++)
+      {
+	if (page_id >= 0 && file.pages[page_id].records.back ().first == items[i])
+	  {
+	    if (is_unique)
+	      {
+		range.has_error = true;
+		return;
+	      }
+	    file.pages[page_id].records.back ().second++;
+	    continue;
+	  }
+	if (page_id < 0 || file.pages[page_id].records.size () == LEAF_KEYS_PER_PAGE)
+	  {
+	    int new_page_id = file.alloc ();
+
+	    if (page_id < 0)
+	      {
+		range.first_leaf = new_page_id;
+	      }
+	    else
+	      {
+		file.pages[page_id].next = new_page_id;
+		file.pages[new_page_id].prev = page_id;
+	      }
+	    page_id = new_page_id;
+	  }
+	file.pages[page_id].records.push_back (std::make_pair (items[i], 1));
+	range.n_keys++;
+      }
+    range.last_leaf = page_id;
+  }
+
+  // like xbtree_load_index with a parallel leaf build; returns the first leaf, -1 on error
+  static int
+  leaf_build_parallel (leaf_file &file, const std::vector<int> &items, bool is_unique, std::size_t n_workers,
+		       const test_task_group_type::push_func &push, std::size_t &n_keys, std::size_t &worker_claimed)
+  {
+    group_context owner_context = { false };
+    std::deque<leaf_range> ranges;
+    int first_leaf = -1;
+    int prev_leaf = -1;
+
+    {
+      test_task_group_type group (push);
+      std::size_t begin = 0;
+
+      // like btree_load_leaves_put: a full range is closed before the first item of the next key
+      for (std::size_t i = 1; i <= items.size (); i++)
+	{
+	  if (i < items.size () && (i - begin < LEAF_RANGE_ITEMS || items[i] == items[i - 1]))
+	    {
+	      continue;
+	    }
+
+	  ranges.push_back ({ begin, i, -1, -1, 0, false });
+	  leaf_range &range = ranges.back ();
+	  begin = i;
+
+	  if (i == items.size ())
+	    {
+	      // the last range is built by the owner
+	      leaf_range_build (file, items, is_unique, range);
+	      break;
+	    }
+	  group.hand_over ([&file, &items, is_unique, &range] (group_context &)
+	  {
+	    leaf_range_build (file, items, is_unique, range);
+	  });
+	  while (group.get_queued_count () > n_workers * LEAF_RANGES_PER_WORKER)
+	    {
+	      (void) group.run_oldest_queued (owner_context);
+	    }
+	}
+      group.run_queued (owner_context);
+      group.wait_claimed ();
+      worker_claimed = group.get_worker_claimed_count ();
+    }
+
+    // like btree_load_leaves_link
+    n_keys = 0;
+    for (const leaf_range &range : ranges)
+      {
+	if (range.has_error)
+	  {
+	    return -1;
+	  }
+	n_keys += range.n_keys;
+	if (prev_leaf < 0)
+	  {
+	    first_leaf = range.first_leaf;
+	  }
+	else
+	  {
+	    file.pages[prev_leaf].next = range.first_leaf;
+	    file.pages[range.first_leaf].prev = prev_leaf;
+	  }
+	prev_leaf = range.last_leaf;
+      }
+    return first_leaf;
+  }
+
+  // the records of the leaf chain; false if a previous link is wrong
+  static bool
+  leaf_chain (const leaf_file &file, int first_leaf, std::vector<std::pair<int, int>> &records)
+  {
+    int prev = -1;
+
+    for (int page_id = first_leaf; page_id >= 0; page_id = file.pages[page_id].next)
+      {
+	if (file.pages[page_id].prev != prev)
+	  {
+	    return false;
+	  }
+	records.insert (records.end (), file.pages[page_id].records.begin (), file.pages[page_id].records.end ());
+	prev = page_id;
+      }
+    return true;
+  }
+
+  static int
+  test_parallel_leaf_build (void)
+  {
+    const std::size_t item_count = 200003;
+    std::vector<int> items (item_count);
+    std::vector<int> unique_items (item_count);
+    std::mt19937 gen (11);
+    std::uniform_int_distribution<int> dist (0, 50000);
+    std::vector<std::pair<int, int>> serial_records;
+    leaf_file serial_file (item_count);
+    leaf_range serial_range = { 0, item_count, -1, -1, 0, false };
+
+    // many duplicates, so ranges are often extended to the end of a key
+    for (std::size_t i = 0; i < item_count; i++)
+      {
+	items[i] = dist (gen);
+	unique_items[i] = (int) i;
+      }
+    std::sort (items.begin (), items.end ());
+
+    leaf_range_build (serial_file, items, false, serial_range);
+    (void) leaf_chain (serial_file, serial_range.first_leaf, serial_records);
+
+    const std::size_t pool_sizes[] = { 3, 1, 8, 0 };
+    for (std::size_t pool_size : pool_sizes)
+      {
+	std::unique_ptr<group_pool> pool (pool_size > 0 ? new group_pool (pool_size) : NULL);
+	std::vector<test_task_group_type::task_func> stuck_tasks;
+	leaf_file file (item_count);
+	std::vector<std::pair<int, int>> records;
+	std::size_t n_keys = 0, worker_claimed = 0;
+	int first_leaf;
+
+	// without threads, no worker starts before the build is over
+	test_task_group_type::push_func push = [&pool, &stuck_tasks] (const test_task_group_type::task_func &task)
+	{
+	  if (pool != NULL)
+	    {
+	      pool->push (task);
+	    }
+	  else
+	    {
+	      stuck_tasks.push_back (task);
+	    }
+	};
+
+	first_leaf = leaf_build_parallel (file, items, false, 3, push, n_keys, worker_claimed);
+	if (first_leaf < 0 || !leaf_chain (file, first_leaf, records) || records != serial_records
+	    || n_keys != serial_range.n_keys)
+	  {
+	    std::cout << "  ERROR: parallel leaf build on " << pool_size << " threads differs from serial build"
+		      << std::endl;
+	    return 1;
+	  }
+	for (const test_task_group_type::task_func &task : stuck_tasks)
+	  {
+	    group_context late_context = { true };
+	    task (late_context);
+	  }
+	std::cout << "  parallel leaf build: " << worker_claimed << " ranges built by workers on " << pool_size
+		  << " threads" << std::endl;
+      }
+
+    // a unique index: no violation, then a violation in the middle of a handed over range
+    {
+      group_pool pool (3);
+      leaf_file file (item_count);
+      std::size_t n_keys = 0, worker_claimed = 0;
+      test_task_group_type::push_func push = [&pool] (const test_task_group_type::task_func &task)
+      {
+	pool.push (task);
+      };
+
+      if (leaf_build_parallel (file, unique_items, true, 3, push, n_keys, worker_claimed) < 0 || n_keys != item_count)
+	{
+	  std::cout << "  ERROR: parallel leaf build of a unique index failed" << std::endl;
+	  return 1;
+	}
+      unique_items[LEAF_RANGE_ITEMS + 7] = unique_items[LEAF_RANGE_ITEMS + 6];
+
+      leaf_file file2 (item_count);
+      if (leaf_build_parallel (file2, unique_items, true, 3, push, n_keys, worker_claimed) >= 0)
+	{
+	  std::cout << "  ERROR: parallel leaf build did not find the unique violation" << std::endl;
+	  return 1;
+	}
+    }
+
+    std::cout << "  parallel leaf build: leaf chains equal serial build" << std::endl;
+    return 0;
+  }
+
+  int
+  test_task_group (void)
+  {
+    if (test_all_run_once () != 0 || test_saturated_pool () != 0 || test_parallel_scan () != 0
+	|| test_parallel_leaf_build () != 0)
+      {
+	return 1;
+      }
+    return 0;
+  }
+
+} // namespace test_thread
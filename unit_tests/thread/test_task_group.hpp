@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/*
+ * test_task_group.hpp - interface to test thread task group
+ */
+
+#ifndef _TEST_TASK_GROUP_HPP_
+#define _TEST_TASK_GROUP_HPP_
+
+namespace test_thread
+{
+
+  // every task runs once, on a worker or on the owner; a saturated pool never blocks the owner; late workers do
+  // nothing. then a parallel aggregate scan, run the way qexec_intprt_fnc_parallel runs it, and a parallel leaf build,
+  // run the way xbtree_load_index runs it, are checked against the serial results
+  int test_task_group (void);
+
+} // namespace test_thread
+
+#endif // _TEST_TASK_GROUP_HPP_
@@ -24,13 +24,19 @@
 #include "test_worker_pool.hpp"
 
 #include "test_output.hpp"
+#include "test_perf_compare.hpp"
 
 #include "thread_task.hpp"
 #include "thread_worker_pool.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
 
 namespace test_thread
 {
@@ -168,4 +174,260 @@ namespace test_thread
     return 0;
   }
 
+  //////////////////////////////////////////////////////////////////////////
+  // work stealing
+  //////////////////////////////////////////////////////////////////////////
+
+  using steady_clock = std::chrono::steady_clock;
+
+  // task that takes a given time, waiting like a transaction waits for pages or locks; records how long it waited
+  // between push and start
+  class timed_task : public cubthread::task<test_context>
+  {
+    public:
+      timed_task (std::chrono::microseconds duration, std::int64_t *wait_us, std::atomic<std::size_t> &done)
+	: m_push_time (steady_clock::now ())
+	, m_duration (duration)
+	, m_wait_us (wait_us)
+	, m_done (done)
+      {
+      }
+
+      void execute (context_type &context)
+      {
+	(void) context;  // suppress unused parameter
+
+	steady_clock::time_point start_time = steady_clock::now ();
+
+	*m_wait_us = std::chrono::duration_cast<std::chrono::microseconds> (start_time - m_push_time).count ();
+	std::this_thread::sleep_for (m_duration);
+	++m_done;
+      }
+
+    private:
+      steady_clock::time_point m_push_time;
+      std::chrono::microseconds m_duration;
+      std::int64_t *m_wait_us;
+      std::atomic<std::size_t> &m_done;
+  };
+
+  // counts its executions
+  class count_task : public cubthread::task<test_context>
+  {
+    public:
+      count_task (std::atomic<int> &count)
+	: m_count (count)
+      {
+      }
+
+      void execute (context_type &context)
+      {
+	(void) context;  // suppress unused parameter
+	++m_count;
+      }
+
+    private:
+      std::atomic<int> &m_count;
+  };
+
+  static bool
+  wait_for_done (const std::atomic<std::size_t> &done, std::size_t expected)
+  {
+    steady_clock::time_point deadline = steady_clock::now () + std::chrono::seconds (60);
+
+    while (done.load () < expected)
+      {
+	if (steady_clock::now () > deadline)
+	  {
+	    return false;
+	  }
+	std::this_thread::sleep_for (std::chrono::microseconds (100));
+      }
+    return true;
+  }
+
+  static int
+  test_stealing_executes_all (void)
+  {
+    const std::size_t pusher_count = 4;
+    const std::size_t task_count = 20000;      // per pusher
+    const std::size_t total_count = pusher_count * task_count;
+    test_context_manager ctx_mgr;
+    test_worker_pool_type pool (16, total_count, ctx_mgr, NULL, 4, false, false, std::chrono::seconds (5), true);
+    std::unique_ptr<std::atomic<int>[]> counts (new std::atomic<int>[total_count]);
+    std::vector<std::thread> pushers;
+    std::size_t executed = 0;
+    std::size_t i;
+
+    for (i = 0; i < total_count; i++)
+      {
+	counts[i] = 0;
+      }
+
+    // some pushers use round robin, others an affinity to one core
+    for (std::size_t p = 0; p < pusher_count; p++)
+      {
+	pushers.emplace_back ([&pool, &counts, p, task_count] ()
+	{
+	  for (std::size_t t = 0; t < task_count; t++)
+	    {
+	      if (p % 2 == 0)
+		{
+		  pool.execute (new count_task (counts[p * task_count + t]));
+		}
+	      else
+		{
+		  pool.execute_on_core (new count_task (counts[p * task_count + t]), 0);
+		}
+	    }
+	});
+      }
+    for (std::thread &th : pushers)
+      {
+	th.join ();
+      }
+
+    steady_clock::time_point deadline = steady_clock::now () + std::chrono::seconds (60);
+    while (true)
+      {
+	executed = 0;
+	for (i = 0; i < total_count; i++)
+	  {
+	    if (counts[i] != 0)
+	      {
+		executed++;
+	      }
+	  }
+	if (executed == total_count || steady_clock::now () > deadline)
+	  {
+	    break;
+	  }
+	std::this_thread::sleep_for (std::chrono::milliseconds (1));
+      }
+    pool.stop_execution ();
+
+    for (i = 0; i < total_count; i++)
+      {
+	if (counts[i] != 1)
+	  {
+	    std::cout << "  ERROR: task " << i << " was executed " << counts[i] << " times" << std::endl;
+	    return 1;
+	  }
+      }
+
+    std::cout << "  work stealing: " << total_count << " tasks executed once" << std::endl;
+    return 0;
+  }
+
+  enum
+  {
+    STEP_UNIFORM,
+    STEP_SKEWED,
+    STEP_ONE_CORE
+  };
+  test_common::string_collection stealing_step_names ("uniform", "skewed", "one core");
+
+  enum
+  {
+    SCENARIO_ROUND_ROBIN,
+    SCENARIO_WORK_STEALING
+  };
+  test_common::string_collection stealing_scenario_names ("round robin", "work stealing");
+
+  // push a burst of tasks and wait for them; outputs the waits of tasks
+  static bool
+  run_burst (bool work_stealing, std::size_t step, std::size_t task_count, std::vector<std::int64_t> &waits)
+  {
+    const std::size_t worker_count = 16;
+    const std::size_t core_count = 4;
+    test_context_manager ctx_mgr;
+    test_worker_pool_type pool (worker_count, task_count, ctx_mgr, NULL, core_count, false, true,
+				std::chrono::seconds (5), work_stealing);
+    std::atomic<std::size_t> done (0);
+    std::chrono::microseconds duration;
+    bool is_done;
+
+    waits.assign (task_count, 0);
+
+    for (std::size_t i = 0; i < task_count; i++)
+      {
+	switch (step)
+	  {
+	  case STEP_SKEWED:
+	    // one task of each round robin cycle is long; round robin always sends it to the same core
+	    duration = std::chrono::microseconds (i % worker_count == 0 ? 2000 : 50);
+	    pool.execute (new timed_task (duration, &waits[i], done));
+	    break;
+	  case STEP_ONE_CORE:
+	    // all tasks have an affinity to the same core, like requests of connections hashed to one core
+	    pool.execute_on_core (new timed_task (std::chrono::microseconds (100), &waits[i], done), 0);
+	    break;
+	  case STEP_UNIFORM:
+	  default:
+	    pool.execute (new timed_task (std::chrono::microseconds (100), &waits[i], done));
+	    break;
+	  }
+      }
+
+    is_done = wait_for_done (done, task_count);
+    pool.stop_execution ();
+    return is_done;
+  }
+
+  static std::int64_t
+  get_percentile (std::vector<std::int64_t> &sorted_values, std::size_t percent)
+  {
+    return sorted_values[(sorted_values.size () - 1) * percent / 100];
+  }
+
+  static int
+  test_stealing_performance (void)
+  {
+    const std::size_t task_count = 4000;
+    test_common::perf_compare compare_result (stealing_scenario_names, stealing_step_names);
+    std::vector<std::int64_t> waits;
+
+    std::cout << "  burst of " << task_count << " tasks on 16 workers in 4 cores" << std::endl;
+
+    for (std::size_t scenario = 0; scenario < stealing_scenario_names.get_count (); scenario++)
+      {
+	for (std::size_t step = 0; step < stealing_step_names.get_count (); step++)
+	  {
+	    test_common::us_timer timer;
+	    if (!run_burst (scenario == SCENARIO_WORK_STEALING, step, task_count, waits))
+	      {
+		std::cout << "  ERROR: tasks were not executed" << std::endl;
+		return 1;
+	      }
+	    std::uint64_t elapsed_us = timer.time ().count ();
+	    compare_result.register_time (timer, scenario, step);
+
+	    std::sort (waits.begin (), waits.end ());
+	    std::cout << "  " << stealing_scenario_names.get_name (scenario) << ", "
+		      << stealing_step_names.get_name (step) << ": "
+		      << (elapsed_us > 0 ? task_count * 1000 / elapsed_us : 0) << " tasks per millisecond, wait p50 "
+		      << get_percentile (waits, 50) << " us, p99 " << get_percentile (waits, 99) << " us, max "
+		      << waits.back () << " us" << std::endl;
+	  }
+      }
+
+    std::cout << std::endl;
+    compare_result.print_results_and_warnings (std::cout);
+
+    return 0;
+  }
+
+  int
+  test_worker_pool_stealing (void)
+  {
+    int err;
+
+    err = test_stealing_executes_all ();
+    if (err != 0)
+      {
+	return err;
+      }
+    return test_stealing_performance ();
+  }
+
 } // namespace test_thread
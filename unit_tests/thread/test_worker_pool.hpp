@@ -29,6 +29,9 @@ namespace test_thread
 
   int test_worker_pool (void);
 
+  // work stealing: check every task runs once, then compare throughput and wait latency with round robin cores
+  int test_worker_pool_stealing (void);
+
 } // namespace test_thread
 
 #endif // _TEST_WORKER_POOL_HPP_
@@ -12,6 +12,8 @@
 #include "connection_sr.h"
 #include "thread_manager.hpp"
 #include "mock_stream.hpp"
+#include "stream_compression.hpp"
+#include "system_parameter.h"
 
 #if !defined (WINDOWS)
 #include "tcp.h"
@@ -20,6 +22,7 @@
 #endif
 
 #include <chrono>
+#include <cstring>
 #include <iostream>
 #include <mutex>
 #include <thread>
@@ -42,6 +45,8 @@ static cubcomm::channel *producer_communication_channel, *consumer_communication
 static cubstream::transfer_sender *producer = NULL;
 static cubstream::transfer_receiver *consumer = NULL;
 static mock_stream *stream = NULL;
+/* sender compression; receiver reads the codec of each block */
+static cubstream::compression_codec compression = cubstream::COMPRESSION_LZO1X_1;
 
 static int init ();
 static int finish ();
@@ -170,6 +175,8 @@ static int init ()
   assert (producer_communication_channel->is_connection_alive () &&
 	  consumer_communication_channel->is_connection_alive ());
 
+  prm_set_integer_value (PRM_ID_REPL_STREAM_COMPRESSION, compression);
+
   stream = new mock_stream ();
   producer = new cubstream::transfer_sender (std::move (*producer_communication_channel), *stream);
   consumer = new cubstream::transfer_receiver (std::move (*consumer_communication_channel), *stream);
@@ -243,6 +250,19 @@ int main (int argc, char **argv)
 {
   int rc;
 
+  /* optional argument: none, lzo1x_1 or lzo1x_999 */
+  if (argc > 1)
+    {
+      if (std::strcmp (argv[1], "none") == 0)
+	{
+	  compression = cubstream::COMPRESSION_NONE;
+	}
+      else if (std::strcmp (argv[1], "lzo1x_999") == 0)
+	{
+	  compression = cubstream::COMPRESSION_LZO1X_999;
+	}
+    }
+
   std::cout << "Initializing...\n";
   rc = init ();
   if (rc != NO_ERROR)